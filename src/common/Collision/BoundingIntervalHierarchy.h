@@ -112,6 +112,22 @@ class TC_COMMON_API BIH
             delete[] dat.indices;
         }
         uint32 primCount() const { return uint32(objects.size()); }
+        std::size_t GetMemoryUsage() const { return (tree.capacity() + objects.capacity()) * sizeof(uint32); }
+
+        /// Recomputes clip planes and bounds for primitives that moved since build(), the split structure is kept.
+        /// Returns the summed surface area of all leaves, it grows as the hierarchy fits its primitives worse.
+        template <class BoundsFunc, class PrimArray>
+        float refit(PrimArray const& primitives, BoundsFunc& getBounds)
+        {
+            if (objects.empty())
+                return 0.0f;
+
+            float leafArea = 0.0f;
+            AABound nodeBounds;
+            refitNode(0, primitives, getBounds, nodeBounds, leafArea);
+            bounds = G3D::AABox(nodeBounds.lo, nodeBounds.hi);
+            return leafArea;
+        }
 
         template<typename RayCallback>
         void intersectRay(const G3D::Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst = false) const
@@ -391,6 +407,64 @@ class TC_COMMON_API BIH
         }
 
         void subdivide(int left, int right, std::vector<uint32> &tempTree, buildData &dat, AABound &gridBox, AABound &nodeBox, int nodeIndex, int depth, BuildStats &stats);
+
+        template <class BoundsFunc, class PrimArray>
+        void refitNode(uint32 node, PrimArray const& primitives, BoundsFunc& getBounds, AABound& nodeBounds, float& leafArea)
+        {
+            uint32 tn = tree[node];
+            uint32 axis = (tn & (3 << 30)) >> 30;
+            bool BVH2 = (tn & (1 << 29)) != 0;
+            uint32 offset = tn & ~(7 << 29);
+            if (!BVH2 && axis == 3)
+            {
+                // leaf, build() never creates empty ones
+                G3D::AABox box, primBox;
+                getBounds(primitives[objects[offset]], box);
+                for (uint32 i = 1; i < tree[node + 1]; ++i)
+                {
+                    getBounds(primitives[objects[offset + i]], primBox);
+                    box.merge(primBox);
+                }
+
+                nodeBounds.lo = box.low();
+                nodeBounds.hi = box.high();
+                leafArea += box.area();
+                return;
+            }
+
+            if (BVH2)
+            {
+                // empty space cut off around a single child
+                refitNode(offset, primitives, getBounds, nodeBounds, leafArea);
+                tree[node + 1] = floatToRawIntBits(nodeBounds.lo[axis]);
+                tree[node + 2] = floatToRawIntBits(nodeBounds.hi[axis]);
+                return;
+            }
+
+            // subdivide() marks missing children with infinite clip planes, their slots may belong to other nodes
+            bool hasLeft = intBitsToFloat(tree[node + 1]) != -G3D::finf();
+            bool hasRight = intBitsToFloat(tree[node + 2]) != G3D::finf();
+            AABound left, right;
+            if (hasLeft)
+            {
+                refitNode(offset, primitives, getBounds, left, leafArea);
+                tree[node + 1] = floatToRawIntBits(left.hi[axis]);
+            }
+
+            if (hasRight)
+            {
+                refitNode(offset + 3, primitives, getBounds, right, leafArea);
+                tree[node + 2] = floatToRawIntBits(right.lo[axis]);
+            }
+
+            if (hasLeft && hasRight)
+            {
+                nodeBounds.lo = left.lo.min(right.lo);
+                nodeBounds.hi = left.hi.max(right.hi);
+            }
+            else
+                nodeBounds = hasLeft ? left : right;
+        }
 };
 
 #endif // _BIH_H
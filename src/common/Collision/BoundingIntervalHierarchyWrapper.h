@@ -63,9 +63,27 @@ class BIHWrap
     G3D::Table<const T*, uint32> m_obj2Idx;
     G3D::Set<const T*> m_objects_to_push;
     int unbalanced_times;
+    int moved_times;
+    float built_leaf_area;
+
+    // a refitted hierarchy is rebuilt once its leaves cover this much more area than right after a build
+    static constexpr float REFIT_QUALITY_LIMIT = 2.0f;
+
+    void rebuild()
+    {
+        unbalanced_times = 0;
+        moved_times = 0;
+        m_objects.fastClear();
+        m_obj2Idx.getKeys(m_objects);
+        m_objects_to_push.getMembers(m_objects);
+        //assert that m_obj2Idx has all the keys
+
+        m_tree.build(m_objects, BoundsFunc::getBounds2);
+        built_leaf_area = m_tree.refit(m_objects, BoundsFunc::getBounds2);
+    }
 
 public:
-    BIHWrap() : unbalanced_times(0) { }
+    BIHWrap() : unbalanced_times(0), moved_times(0), built_leaf_area(0.0f) { }
 
     void insert(const T& obj)
     {
@@ -84,18 +102,28 @@ public:
             m_objects_to_push.remove(&obj);
     }
 
+    /// Bounds of an already inserted object changed, the hierarchy is refitted instead of rebuilt
+    void update(const T& obj)
+    {
+        if (m_objects_to_push.contains(&obj))
+            ++moved_times;
+    }
+
     void balance()
     {
-        if (unbalanced_times == 0)
+        if (unbalanced_times > 0)
+        {
+            rebuild();
             return;
+        }
 
-        unbalanced_times = 0;
-        m_objects.fastClear();
-        m_obj2Idx.getKeys(m_objects);
-        m_objects_to_push.getMembers(m_objects);
-        //assert that m_obj2Idx has all the keys
+        if (moved_times == 0)
+            return;
 
-        m_tree.build(m_objects, BoundsFunc::getBounds2);
+        moved_times = 0;
+        float leafArea = m_tree.refit(m_objects, BoundsFunc::getBounds2);
+        if (leafArea > built_leaf_area * REFIT_QUALITY_LIMIT)
+            rebuild();
     }
 
     template<typename RayCallback>
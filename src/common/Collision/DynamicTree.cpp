@@ -83,6 +83,12 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         ++unbalanced_times;
     }
 
+    void update(Model const& mdl)
+    {
+        base::update(mdl);
+        ++unbalanced_times;
+    }
+
     void balance()
     {
         base::balance();
@@ -124,6 +130,11 @@ void DynamicMapTree::remove(GameObjectModel const& mdl)
     impl->remove(mdl);
 }
 
+void DynamicMapTree::update(GameObjectModel const& mdl)
+{
+    impl->update(mdl);
+}
+
 bool DynamicMapTree::contains(GameObjectModel const& mdl) const
 {
     return impl->contains(mdl);
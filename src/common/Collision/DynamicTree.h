@@ -55,6 +55,8 @@ public:
 
     void insert(GameObjectModel const&);
     void remove(GameObjectModel const&);
+    // the model's bounds changed after GameObjectModel::UpdatePosition
+    void update(GameObjectModel const&);
     bool contains(GameObjectModel const&) const;
 
     void balance();
@@ -47,6 +47,16 @@ namespace VMAP
         ReadFromFileFailed
     };
 
+    // one segment of a batched line of sight check, in world coordinates
+    struct LineOfSightSegment
+    {
+        LineOfSightSegment(float x1, float y1, float z1, float x2, float y2, float z2) : X1(x1), Y1(y1), Z1(z1), X2(x2), Y2(y2), Z2(z2), InLineOfSight(true) { }
+
+        float X1, Y1, Z1;
+        float X2, Y2, Z2;
+        bool InLineOfSight;
+    };
+
     #define VMAP_INVALID_HEIGHT       -100000.0f            // for check
     #define VMAP_INVALID_HEIGHT_VALUE -200000.0f            // real assigned value in unknown height case
 
@@ -19,6 +19,8 @@
 #include "Errors.h"
 #include "Log.h"
 #include "MMapDefines.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <mutex>
 
 namespace MMAP
 {
@@ -106,8 +108,9 @@ namespace MMAP
         TC_LOG_DEBUG("maps", "MMAP:loadMapData: Loaded %04i.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, ++tileGeneration);
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
         itr->second = mmap_data;
         return true;
     }
@@ -194,15 +197,35 @@ namespace MMAP
 
         fseek(file, pos, SEEK_SET);
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
+        // map the tile copy on write, detour only writes poly links into it when the tile is added,
+        // vertex, detail mesh and bv tree pages stay shared with every other process using the same file
+        std::unique_ptr<boost::interprocess::mapped_region> mapping;
+        try
+        {
+            boost::interprocess::file_mapping fileMapping(fileName.c_str(), boost::interprocess::read_only);
+            mapping = std::make_unique<boost::interprocess::mapped_region>(fileMapping, boost::interprocess::copy_on_write, pos, fileHeader.size);
+        }
+        catch (boost::interprocess::interprocess_exception const& e)
+        {
+            TC_LOG_DEBUG("maps", "MMAP:loadMap: Could not map %s, reading it instead: %s", fileName.c_str(), e.what());
+        }
 
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
+        unsigned char* data = nullptr;
+        if (mapping)
+            data = static_cast<unsigned char*>(mapping->get_address());
+        else
         {
-            TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap %04u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
-            return false;
+            data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
+            ASSERT(data);
+
+            size_t result = fread(data, fileHeader.size, 1, file);
+            if (!result)
+            {
+                TC_LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap %04u%02i%02i.mmtile", mapId, x, y);
+                dtFree(data);
+                fclose(file);
+                return false;
+            }
         }
 
         fclose(file);
@@ -210,10 +233,16 @@ namespace MMAP
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        // mapped data is released together with its mapping once the tile is removed
+        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, mapping ? 0 : DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            if (mapping)
+                mmap->tileMappings[packedGridPos] = std::move(mapping);
+            mmap->tileGeneration = ++tileGeneration;
             ++loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %04i[%02i, %02i] into %04i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
@@ -221,7 +250,8 @@ namespace MMAP
         else
         {
             TC_LOG_ERROR("maps", "MMAP:loadMap: Could not load %04u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
+            if (!mapping)
+                dtFree(data);
             return false;
         }
     }
@@ -247,21 +277,10 @@ namespace MMAP
             return false;
 
         MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) != mmap->navMeshQueries.end())
-            return true;
+        std::lock_guard<std::mutex> lock(mmap->navMeshQueriesLock);
+        ++mmap->instanceCount;
 
-        // allocate mesh query
-        dtNavMeshQuery* query = dtAllocNavMeshQuery();
-        ASSERT(query);
-        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-        {
-            dtFreeNavMeshQuery(query);
-            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %04u instanceId %u", mapId, instanceId);
-            return false;
-        }
-
-        TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %04u instanceId %u", mapId, instanceId);
-        mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+        TC_LOG_DEBUG("maps", "MMAP:loadMapInstance: Registered instanceId %u for mapId %04u", instanceId, mapId);
         return true;
     }
 
@@ -298,6 +317,8 @@ namespace MMAP
             return false;
         }
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRefItr->second, nullptr, nullptr)))
         {
@@ -310,6 +331,8 @@ namespace MMAP
         else
         {
             mmap->loadedTileRefs.erase(tileRefItr);
+            mmap->tileMappings.erase(packedGridPos);
+            mmap->tileGeneration = ++tileGeneration;
             --loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %04i[%02i, %02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -338,6 +361,8 @@ namespace MMAP
             return false;
         }
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // unload all tiles from given map
         MMapData* mmap = itr->second;
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
@@ -372,18 +397,18 @@ namespace MMAP
         }
 
         MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        std::lock_guard<std::mutex> lock(mmap->navMeshQueriesLock);
+        if (!mmap->instanceCount)
         {
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %04u instanceId %u", mapId, instanceId);
+            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded instanceId %u of mapId %04u", instanceId, mapId);
             return false;
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
+        // no map updates can use the queries anymore
+        if (!--mmap->instanceCount)
+            mmap->FreeNavMeshQueries();
 
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
         TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %04u instanceId %u", mapId, instanceId);
-
         return true;
     }
 
@@ -396,16 +421,56 @@ namespace MMAP
         return itr->second->navMesh;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    uint32 MMapManager::GetTileGeneration(uint32 mapId) const
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return 0;
+
+        return itr->second->tileGeneration;
+    }
+
+    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
     {
         auto itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
             return nullptr;
 
-        auto queryItr = itr->second->navMeshQueries.find(instanceId);
-        if (queryItr == itr->second->navMeshQueries.end())
+        MMapData* mmap = itr->second;
+        std::thread::id const threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> lock(mmap->navMeshQueriesLock);
+        auto queryItr = mmap->navMeshQueries.find(threadId);
+        if (queryItr != mmap->navMeshQueries.end())
+            return queryItr->second;
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %04u", mapId);
             return nullptr;
+        }
+
+        TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %04u", mapId);
+        mmap->navMeshQueries.insert(NavMeshQuerySet::value_type(threadId, query));
+        return query;
+    }
+
+    uint32 MMapManager::getNavMeshQueryCount()
+    {
+        uint32 count = 0;
+        for (std::pair<uint32 const, MMapData*>& loadedMMap : loadedMMaps)
+        {
+            if (!loadedMMap.second)
+                continue;
+
+            std::lock_guard<std::mutex> lock(loadedMMap.second->navMeshQueriesLock);
+            count += uint32(loadedMMap.second->navMeshQueries.size());
+        }
 
-        return queryItr->second;
+        return count;
     }
 }
@@ -21,7 +21,13 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <boost/interprocess/mapped_region.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -29,26 +35,41 @@
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<uint32, std::unique_ptr<boost::interprocess::mapped_region>> MMapTileMappingSet;
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh, uint32 generation) : instanceCount(0), navMesh(mesh), tileGeneration(generation) { }
         ~MMapData()
         {
-            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
+            FreeNavMeshQueries();
 
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        void FreeNavMeshQueries()
+        {
+            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
+                dtFreeNavMeshQuery(i->second);
+
+            navMeshQueries.clear();
+        }
+
+        // dtNavMeshQuery is not thread safe, every thread updating instances of this map gets its own
+        // and shares it between all of those instances, so the node pools are bound by thread count instead of instance count
+        NavMeshQuerySet navMeshQueries;     // thread to query
+        std::mutex navMeshQueriesLock;
+        uint32 instanceCount;               // queries are freed once the last instance unloads
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+        MMapTileMappingSet tileMappings;    // maps [map grid coords] to the file mapping holding the tile data, if it was mapped
+
+        // changes every time a tile is added or removed, poly refs cached with an older value may be stale
+        std::atomic<uint32> tileGeneration;
     };
 
 
@@ -59,7 +80,7 @@ namespace MMAP
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), thread_safe_environment(true), tileGeneration(0) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
@@ -69,12 +90,20 @@ namespace MMAP
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // the returned [dtNavMeshQuery const*] belongs to the calling thread and must not be kept past the current update
+            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // unique over all maps and never reused, 0 if the map has no navmesh
+            uint32 GetTileGeneration(uint32 mapId) const;
+
+            // held exclusively while tiles are added to or removed from a navmesh
+            // threads querying a navmesh outside of its map update must hold it shared
+            std::shared_mutex& GetNavMeshLock() { return navMeshLock; }
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
+            uint32 getNavMeshQueryCount();
         private:
             bool loadMapData(std::string const& basePath, uint32 mapId);
             bool loadMapImpl(std::string const& basePath, uint32 mapId, int32 x, int32 y);
@@ -87,6 +116,8 @@ namespace MMAP
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
             bool thread_safe_environment;
+            std::atomic<uint32> tileGeneration;
+            std::shared_mutex navMeshLock;
 
             std::unordered_map<uint32, std::vector<uint32>> childMapData;
             std::unordered_map<uint32, uint32> parentMapData;
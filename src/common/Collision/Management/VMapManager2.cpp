@@ -25,6 +25,7 @@
 #include "WorldModel.h"
 #include <G3D/Vector3.h>
 #include "Log.h"
+#include "MemoryAccounting.h"
 #include "VMapDefinitions.h"
 #include "Errors.h"
 
@@ -35,13 +36,21 @@ namespace VMAP
     class ManagedModel
     {
         public:
-            ManagedModel() : iRefCount(0) { }
+            ManagedModel() : iRefCount(0), iMemoryUsage(0) { }
+            ~ManagedModel() { Trinity::MemoryAccounting::Released(Trinity::MemoryCategory::VMaps, iMemoryUsage); }
             WorldModel* getModel() { return &iModel; }
             void incRefCount() { ++iRefCount; }
             int decRefCount() { return --iRefCount; }
+            //! called once the model is loaded, the geometry does not change afterwards
+            void accountMemory()
+            {
+                iMemoryUsage = sizeof(ManagedModel) + iModel.GetMemoryUsage();
+                Trinity::MemoryAccounting::Allocated(Trinity::MemoryCategory::VMaps, iMemoryUsage);
+            }
         protected:
             WorldModel iModel;
             int iRefCount;
+            std::size_t iMemoryUsage;
     };
 
     bool readChunk(FILE* rf, char* dest, const char* compare, uint32 len)
@@ -233,6 +242,27 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, std::vector<LineOfSightSegment>& segments, ModelIgnoreFlags ignoreFlags)
+    {
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        for (LineOfSightSegment& segment : segments)
+        {
+            if (!segment.InLineOfSight)
+                continue;
+
+            Vector3 pos1 = convertPositionToInternalRep(segment.X1, segment.Y1, segment.Z1);
+            Vector3 pos2 = convertPositionToInternalRep(segment.X2, segment.Y2, segment.Z2);
+            if (pos1 != pos2)
+                segment.InLineOfSight = instanceTree->second->isInLineOfSight(pos1, pos2, ignoreFlags);
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -382,6 +412,7 @@ namespace VMAP
 
             worldmodel->getModel()->SetName(filename);
             worldmodel->getModel()->Flags = flags;
+            worldmodel->accountMemory();
 
             model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel*>(filename, worldmodel)).first;
         }
@@ -99,6 +99,8 @@ namespace VMAP
             void unloadSingleMap(uint32 mapId);
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override ;
+            // checks every segment against the same map tree, segments already out of line of sight are skipped
+            void isInLineOfSight(unsigned int mapId, std::vector<LineOfSightSegment>& segments, ModelIgnoreFlags ignoreFlags);
             /**
             fill the hit pos and return true, if an object was hit
             */
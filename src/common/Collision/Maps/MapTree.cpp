@@ -18,6 +18,7 @@
 #include "MapTree.h"
 #include "Errors.h"
 #include "Log.h"
+#include "MemoryAccounting.h"
 #include "Metric.h"
 #include "ModelInstance.h"
 #include "VMapDefinitions.h"
@@ -120,7 +121,7 @@ namespace VMAP
     }
 
     StaticMapTree::StaticMapTree(uint32 mapID, std::string const& basePath)
-        : iMapID(mapID), iTreeValues(nullptr), iNTreeValues(0), iBasePath(basePath)
+        : iMapID(mapID), iTreeValues(nullptr), iNTreeValues(0), iMemoryUsage(0), iBasePath(basePath)
     {
         if (iBasePath.length() > 0 && iBasePath[iBasePath.length() - 1] != '/' && iBasePath[iBasePath.length() - 1] != '\\')
         {
@@ -132,6 +133,7 @@ namespace VMAP
     //! Make sure to call unloadMap() to unregister acquired model references before destroying
     StaticMapTree::~StaticMapTree()
     {
+        Trinity::MemoryAccounting::Released(Trinity::MemoryCategory::VMaps, iMemoryUsage);
         delete[] iTreeValues;
     }
 
@@ -324,6 +326,8 @@ namespace VMAP
         {
             iNTreeValues = iTree.primCount();
             iTreeValues = new ModelInstance[iNTreeValues];
+            iMemoryUsage = iTree.GetMemoryUsage() + iNTreeValues * sizeof(ModelInstance);
+            Trinity::MemoryAccounting::Allocated(Trinity::MemoryCategory::VMaps, iMemoryUsage);
             result = LoadResult::Success;
         }
 
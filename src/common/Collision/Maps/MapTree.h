@@ -48,6 +48,7 @@ namespace VMAP
             BIH iTree;
             ModelInstance* iTreeValues; // the tree entries
             uint32 iNTreeValues;
+            std::size_t iMemoryUsage; // tree and tree entries, reported to MemoryAccounting
             std::unordered_map<uint32, uint32> iSpawnIndices;
 
             // Store all the map tile idents that are loaded for that map
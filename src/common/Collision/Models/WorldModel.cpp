@@ -31,16 +31,14 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(MeshTriangle const& tri, std::vector<Vector3>::const_iterator points, G3D::Ray const& ray, float& distance)
+    bool IntersectTriangle(GroupModel::PackedTriangle const& tri, G3D::Ray const& ray, float& distance)
     {
         static const float EPS = 1e-5f;
 
         // See RTR2 ch. 13.7 for the algorithm.
 
-        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
-        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
-        const Vector3 p(ray.direction().cross(e2));
-        const float a = e1.dot(p);
+        const Vector3 p(ray.direction().cross(tri.e2));
+        const float a = tri.e1.dot(p);
 
         if (std::fabs(a) < EPS) {
             // Determinant is ill-conditioned; abort early
@@ -48,7 +46,7 @@ namespace VMAP
         }
 
         const float f = 1.0f / a;
-        const Vector3 s(ray.origin() - points[tri.idx0]);
+        const Vector3 s(ray.origin() - tri.v0);
         const float u = f * s.dot(p);
 
         if ((u < 0.0f) || (u > 1.0f)) {
@@ -56,7 +54,7 @@ namespace VMAP
             return false;
         }
 
-        const Vector3 q(s.cross(e1));
+        const Vector3 q(s.cross(tri.e1));
         const float v = f * ray.direction().dot(q);
 
         if ((v < 0.0f) || ((u + v) > 1.0f)) {
@@ -64,7 +62,7 @@ namespace VMAP
             return false;
         }
 
-        const float t = f * e2.dot(q);
+        const float t = f * tri.e2.dot(q);
 
         if ((t > 0.0f) && (t < distance))
         {
@@ -81,6 +79,18 @@ namespace VMAP
         return false;
     }
 
+    void PackTriangles(std::vector<MeshTriangle> const& triangles, std::vector<Vector3> const& vertices, std::vector<GroupModel::PackedTriangle>& packed)
+    {
+        packed.resize(triangles.size());
+        for (std::size_t i = 0; i < triangles.size(); ++i)
+        {
+            MeshTriangle const& tri = triangles[i];
+            packed[i].v0 = vertices[tri.idx0];
+            packed[i].e1 = vertices[tri.idx1] - vertices[tri.idx0];
+            packed[i].e2 = vertices[tri.idx2] - vertices[tri.idx0];
+        }
+    }
+
     class TriBoundFunc
     {
         public:
@@ -218,6 +228,14 @@ namespace VMAP
                 (iFlags ? ((iTilesX + 1) * (iTilesY + 1) * sizeof(float) + iTilesX * iTilesY) : sizeof(float));
     }
 
+    std::size_t WmoLiquid::GetMemoryUsage() const
+    {
+        if (!iFlags)
+            return sizeof(float);
+
+        return (iTilesX + 1) * (iTilesY + 1) * sizeof(float) + iTilesX * iTilesY * sizeof(uint8);
+    }
+
     bool WmoLiquid::writeToFile(FILE* wf)
     {
         bool result = false;
@@ -289,7 +307,7 @@ namespace VMAP
 
     GroupModel::GroupModel(GroupModel const& other) :
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(nullptr)
+        vertices(other.vertices), triangles(other.triangles), packedTriangles(other.packedTriangles), meshTree(other.meshTree), iLiquid(nullptr)
     {
         if (other.iLiquid)
             iLiquid = new WmoLiquid(*other.iLiquid);
@@ -299,6 +317,7 @@ namespace VMAP
     {
         vertices.swap(vert);
         triangles.swap(tri);
+        PackTriangles(triangles, vertices, packedTriangles);
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
     }
@@ -357,6 +376,7 @@ namespace VMAP
         uint32 count = 0;
         triangles.clear();
         vertices.clear();
+        packedTriangles.clear();
         delete iLiquid;
         iLiquid = nullptr;
 
@@ -379,6 +399,7 @@ namespace VMAP
         if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
         if (result) triangles.resize(count);
         if (result && fread(&triangles[0], sizeof(MeshTriangle), count, rf) != count) result = false;
+        if (result) PackTriangles(triangles, vertices, packedTriangles);
 
         // read mesh BIH
         if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
@@ -394,15 +415,14 @@ namespace VMAP
 
     struct GModelRayCallback
     {
-        GModelRayCallback(std::vector<MeshTriangle> const& tris, const std::vector<Vector3> &vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) { }
+        GModelRayCallback(std::vector<GroupModel::PackedTriangle> const& tris):
+            triangles(tris.begin()), hit(false) { }
         bool operator()(G3D::Ray const& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/)
         {
-            hit = IntersectTriangle(triangles[entry], vertices, ray, distance) || hit;
+            hit = IntersectTriangle(triangles[entry], ray, distance) || hit;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        std::vector<GroupModel::PackedTriangle>::const_iterator triangles;
         bool hit;
     };
 
@@ -411,7 +431,7 @@ namespace VMAP
         if (triangles.empty())
             return false;
 
-        GModelRayCallback callback(triangles, vertices);
+        GModelRayCallback callback(packedTriangles);
         meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
     }
@@ -450,6 +470,19 @@ namespace VMAP
         liquid = iLiquid;
     }
 
+    std::size_t GroupModel::GetMemoryUsage() const
+    {
+        std::size_t usage = vertices.capacity() * sizeof(G3D::Vector3)
+            + triangles.capacity() * sizeof(MeshTriangle)
+            + packedTriangles.capacity() * sizeof(PackedTriangle)
+            + meshTree.GetMemoryUsage();
+
+        if (iLiquid)
+            usage += sizeof(WmoLiquid) + iLiquid->GetMemoryUsage();
+
+        return usage;
+    }
+
     // ===================== WorldModel ==================================
 
     void WorldModel::setGroupModels(std::vector<GroupModel>& models)
@@ -638,4 +671,13 @@ namespace VMAP
     {
         outGroupModels = groupModels;
     }
+
+    std::size_t WorldModel::GetMemoryUsage() const
+    {
+        std::size_t usage = groupModels.capacity() * sizeof(GroupModel) + groupTree.GetMemoryUsage() + name.capacity();
+        for (GroupModel const& groupModel : groupModels)
+            usage += groupModel.GetMemoryUsage();
+
+        return usage;
+    }
 }
@@ -56,6 +56,7 @@ namespace VMAP
             float *GetHeightStorage() { return iHeight; }
             uint8 *GetFlagsStorage() { return iFlags; }
             uint32 GetFileSize();
+            std::size_t GetMemoryUsage() const;
             bool writeToFile(FILE* wf);
             static bool readFromFile(FILE* rf, WmoLiquid* &liquid);
             void getPosInfo(uint32 &tilesX, uint32 &tilesY, G3D::Vector3 &corner) const;
@@ -92,12 +93,22 @@ namespace VMAP
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
             void getMeshData(std::vector<G3D::Vector3>& outVertices, std::vector<MeshTriangle>& outTriangles, WmoLiquid*& liquid);
+            std::size_t GetMemoryUsage() const;
+
+            //! triangle stored as first vertex and both edges, what the ray test needs without looking up vertices
+            struct PackedTriangle
+            {
+                G3D::Vector3 v0;
+                G3D::Vector3 e1;
+                G3D::Vector3 e2;
+            };
         protected:
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
             std::vector<G3D::Vector3> vertices;
             std::vector<MeshTriangle> triangles;
+            std::vector<PackedTriangle> packedTriangles;
             BIH meshTree;
             WmoLiquid* iLiquid;
     };
@@ -117,6 +128,8 @@ namespace VMAP
             bool writeFile(const std::string &filename);
             bool readFile(const std::string &filename);
             void getGroupModels(std::vector<GroupModel>& outGroupModels);
+            //! heap memory held by the loaded geometry, trees and liquids
+            std::size_t GetMemoryUsage() const;
             std::string const& GetName() const { return name; }
             void SetName(std::string newName) { name = std::move(newName); }
             uint32 Flags;
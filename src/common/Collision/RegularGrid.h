@@ -23,6 +23,7 @@
 #include <G3D/Ray.h>
 #include <G3D/BoundsTrait.h>
 #include <G3D/PositionTrait.h>
+#include <algorithm>
 #include <unordered_map>
 
 template<class Node>
@@ -89,6 +90,37 @@ public:
         memberTable.erase(&value);
     }
 
+    // value moved, if it still covers the same nodes they only refit their hierarchy
+    void update(const T& value)
+    {
+        G3D::AABox bounds;
+        BoundsFunc::getBounds(value, bounds);
+        Cell low = Cell::ComputeCell(bounds.low().x, bounds.low().y);
+        Cell high = Cell::ComputeCell(bounds.high().x, bounds.high().y);
+
+        auto members = Trinity::Containers::MapEqualRange(memberTable, &value);
+        bool sameNodes = low.isValid() && high.isValid()
+            && std::size_t(std::distance(members.begin(), members.end())) == std::size_t(high.x - low.x + 1) * (high.y - low.y + 1);
+        for (int x = low.x; sameNodes && x <= high.x; ++x)
+        {
+            for (int y = low.y; sameNodes && y <= high.y; ++y)
+            {
+                Node* node = nodes[x][y];
+                sameNodes = node && std::any_of(members.begin(), members.end(), [node](typename MemberTable::value_type const& p) { return p.second == node; });
+            }
+        }
+
+        if (!sameNodes)
+        {
+            remove(value);
+            insert(value);
+            return;
+        }
+
+        for (auto& p : members)
+            p.second->update(value);
+    }
+
     void balance()
     {
         for (int x = 0; x < CELL_NUMBER; ++x)
@@ -21,6 +21,7 @@
 #include "Util.h"
 #include <boost/property_tree/ini_parser.hpp>
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -33,6 +34,21 @@ namespace
     std::vector<std::string> _args;
     bpt::ptree _config;
     std::mutex _configLock;
+    std::atomic<bool> _loaded(false);
+
+    // function local so that ConfigValue objects with static storage duration can register before main
+    struct ConfigRegistry
+    {
+        std::mutex Lock;
+        std::vector<Trinity::ConfigValueBase*> Values;
+        std::vector<std::pair<std::string, std::function<void()>>> ReloadListeners;
+    };
+
+    ConfigRegistry& GetRegistry()
+    {
+        static ConfigRegistry registry;
+        return registry;
+    }
 
     bool LoadFile(std::string const& file, bpt::ptree& fullTree, std::string& error)
     {
@@ -62,18 +78,22 @@ namespace
 bool ConfigMgr::LoadInitial(std::string file, std::vector<std::string> args,
                             std::string& error)
 {
-    std::lock_guard<std::mutex> lock(_configLock);
+    {
+        std::lock_guard<std::mutex> lock(_configLock);
 
-    _filename = std::move(file);
-    _args = std::move(args);
+        _filename = std::move(file);
+        _args = std::move(args);
 
-    bpt::ptree fullTree;
-    if (!LoadFile(_filename, fullTree, error))
-        return false;
+        bpt::ptree fullTree;
+        if (!LoadFile(_filename, fullTree, error))
+            return false;
 
-    // Since we're using only one section per config file, we skip the section and have direct property access
-    _config = fullTree.begin()->second;
+        // Since we're using only one section per config file, we skip the section and have direct property access
+        _config = fullTree.begin()->second;
+        _loaded = true;
+    }
 
+    RefreshValues();
     return true;
 }
 
@@ -89,6 +109,7 @@ bool ConfigMgr::LoadAdditionalFile(std::string file, bool keepOnReload, std::str
     if (keepOnReload)
         _additonalFiles.emplace_back(std::move(file));
 
+    RefreshValues();
     return true;
 }
 
@@ -108,7 +129,23 @@ bool ConfigMgr::Reload(std::vector<std::string>& errors)
         if (!LoadAdditionalFile(additionalFile, false, error))
             errors.push_back(std::move(error));
 
-    return errors.empty();
+    if (!errors.empty())
+        return false;
+
+    std::vector<std::function<void()>> listeners;
+    {
+        ConfigRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Lock);
+        listeners.reserve(registry.ReloadListeners.size());
+        for (std::pair<std::string, std::function<void()>> const& listener : registry.ReloadListeners)
+            listeners.push_back(listener.second);
+    }
+
+    // called without holding the registry lock, listeners may register values of their own
+    for (std::function<void()> const& listener : listeners)
+        listener();
+
+    return true;
 }
 
 template<class T>
@@ -219,3 +256,46 @@ std::vector<std::string> ConfigMgr::GetKeysByString(std::string const& name)
 
     return keys;
 }
+
+void ConfigMgr::RegisterValue(Trinity::ConfigValueBase* value)
+{
+    ConfigRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    registry.Values.push_back(value);
+
+    // values declared after the config was loaded (function local statics) are parsed right away
+    if (_loaded)
+        value->Load();
+}
+
+void ConfigMgr::UnregisterValue(Trinity::ConfigValueBase* value)
+{
+    ConfigRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    registry.Values.erase(std::remove(registry.Values.begin(), registry.Values.end(), value), registry.Values.end());
+}
+
+void ConfigMgr::AddReloadListener(std::string name, std::function<void()> listener)
+{
+    ConfigRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    registry.ReloadListeners.emplace_back(std::move(name), std::move(listener));
+}
+
+void ConfigMgr::RemoveReloadListener(std::string const& name)
+{
+    ConfigRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    registry.ReloadListeners.erase(std::remove_if(registry.ReloadListeners.begin(), registry.ReloadListeners.end(), [&](std::pair<std::string, std::function<void()>> const& listener)
+    {
+        return listener.first == name;
+    }), registry.ReloadListeners.end());
+}
+
+void ConfigMgr::RefreshValues()
+{
+    ConfigRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    for (Trinity::ConfigValueBase* value : registry.Values)
+        value->Load();
+}
@@ -19,9 +19,18 @@
 #define CONFIG_H
 
 #include "Define.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+namespace Trinity
+{
+    class ConfigValueBase;
+}
+
 class TC_COMMON_API ConfigMgr
 {
     ConfigMgr() = default;
@@ -48,11 +57,120 @@ public:
     std::vector<std::string> const& GetArguments() const;
     std::vector<std::string> GetKeysByString(std::string const& name);
 
+    /// Typed values (see Trinity::ConfigValue) register themselves here and are parsed again after every (re)load
+    void RegisterValue(Trinity::ConfigValueBase* value);
+    void UnregisterValue(Trinity::ConfigValueBase* value);
+
+    /// Listeners are called in registration order after a successful Reload(), once all typed values were refreshed
+    void AddReloadListener(std::string name, std::function<void()> listener);
+    void RemoveReloadListener(std::string const& name);
+
 private:
+    void RefreshValues();
+
     template<class T>
     T GetValueDefault(std::string const& name, T def, bool quiet) const;
 };
 
 #define sConfigMgr ConfigMgr::instance()
 
+namespace Trinity
+{
+    class TC_COMMON_API ConfigValueBase
+    {
+    public:
+        explicit ConfigValueBase(std::string name) : _name(std::move(name)) { }
+        virtual ~ConfigValueBase() = default;
+
+        ConfigValueBase(ConfigValueBase const&) = delete;
+        ConfigValueBase& operator=(ConfigValueBase const&) = delete;
+
+        std::string const& GetName() const { return _name; }
+
+        virtual void Load() = 0;
+
+    private:
+        std::string _name;
+    };
+
+    /*
+     * Config key declared once with its type and default value.
+     * The value is parsed when the config is (re)loaded instead of on every access, reading it is a relaxed atomic load
+     * so handles can be used from map threads while the world thread reloads the config.
+     *
+     *     static Trinity::ConfigValue<bool> AllowSomething("Something.Allow", false);
+     *     if (AllowSomething) ...
+     */
+    template<class T>
+    class ConfigValue final : public ConfigValueBase
+    {
+        static_assert(std::is_same_v<T, bool> || std::is_same_v<T, int32> || std::is_same_v<T, int64> || std::is_same_v<T, float>,
+            "Unsupported config value type");
+
+    public:
+        ConfigValue(std::string name, T def) : ConfigValueBase(std::move(name)), _default(def), _value(def)
+        {
+            sConfigMgr->RegisterValue(this);
+        }
+
+        ~ConfigValue()
+        {
+            sConfigMgr->UnregisterValue(this);
+        }
+
+        T Get() const { return _value.load(std::memory_order_relaxed); }
+        operator T() const { return Get(); }
+
+        void Load() override
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                _value.store(sConfigMgr->GetBoolDefault(GetName(), _default), std::memory_order_relaxed);
+            else if constexpr (std::is_same_v<T, int32>)
+                _value.store(sConfigMgr->GetIntDefault(GetName(), _default), std::memory_order_relaxed);
+            else if constexpr (std::is_same_v<T, int64>)
+                _value.store(sConfigMgr->GetInt64Default(GetName(), _default), std::memory_order_relaxed);
+            else
+                _value.store(sConfigMgr->GetFloatDefault(GetName(), _default), std::memory_order_relaxed);
+        }
+
+    private:
+        T _default;
+        std::atomic<T> _value;
+    };
+
+    /// Strings cannot be read atomically, Get() returns a copy made under a lock
+    template<>
+    class ConfigValue<std::string> final : public ConfigValueBase
+    {
+    public:
+        ConfigValue(std::string name, std::string def) : ConfigValueBase(std::move(name)), _default(def), _value(std::move(def))
+        {
+            sConfigMgr->RegisterValue(this);
+        }
+
+        ~ConfigValue()
+        {
+            sConfigMgr->UnregisterValue(this);
+        }
+
+        std::string Get() const
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _value;
+        }
+
+        void Load() override
+        {
+            std::string value = sConfigMgr->GetStringDefault(GetName(), _default);
+            std::lock_guard<std::mutex> lock(_lock);
+            _value = std::move(value);
+        }
+
+    private:
+        std::string _default;
+        std::string _value;
+        mutable std::mutex _lock;
+    };
+}
+
 #endif
@@ -82,3 +82,27 @@ bool WorldPacketCrypt::EncryptSend(uint8* data, size_t length, Trinity::Crypto::
     ++_serverCounter;
     return true;
 }
+
+bool WorldPacketCrypt::EncryptSend(SendRequest const* requests, size_t count)
+{
+    if (!_initialized)
+    {
+        for (size_t i = 0; i < count; ++i)
+            memset(requests[i].Tag, 0, sizeof(Trinity::Crypto::AES::Tag));
+
+        _serverCounter += count;
+        return true;
+    }
+
+    WorldPacketCryptIV iv{ _serverCounter, 0x52565253 };
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!_serverEncrypt.Process(iv.Value, requests[i].Data, requests[i].Length, *reinterpret_cast<Trinity::Crypto::AES::Tag*>(requests[i].Tag)))
+            return false;
+
+        ++_serverCounter;
+        memcpy(iv.Value.data(), &_serverCounter, sizeof(uint64));
+    }
+
+    return true;
+}
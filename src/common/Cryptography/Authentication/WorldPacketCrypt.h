@@ -24,12 +24,21 @@
 class TC_COMMON_API WorldPacketCrypt
 {
 public:
+    struct SendRequest
+    {
+        uint8* Data;
+        size_t Length;
+        uint8* Tag;
+    };
+
     WorldPacketCrypt();
 
     void Init(Trinity::Crypto::AES::Key const& key);
     bool PeekDecryptRecv(uint8* data, size_t length);
     bool DecryptRecv(uint8* data, size_t length, Trinity::Crypto::AES::Tag& tag);
     bool EncryptSend(uint8* data, size_t length, Trinity::Crypto::AES::Tag& tag);
+    // encrypts consecutive outgoing packets in order, returns false on the first failure
+    bool EncryptSend(SendRequest const* requests, size_t count);
 
     bool IsInitialized() const { return _initialized; }
 
@@ -249,7 +249,8 @@ private:
     DB2FileLoadInfo const* _loadInfo;
     DB2Header const* _header;
     std::unique_ptr<uint8[]> _data;
-    uint8* _stringTable;
+    uint8 const* _records;
+    uint8 const* _stringTable;
     std::unique_ptr<DB2SectionHeader[]> _sections;
     std::unique_ptr<DB2ColumnMeta[]> _columnMeta;
     std::unique_ptr<std::unique_ptr<DB2PalletValue[]>[]> _palletValues;
@@ -328,6 +329,7 @@ DB2FileLoaderRegularImpl::DB2FileLoaderRegularImpl(char const* fileName, DB2File
     _fileName(fileName),
     _loadInfo(loadInfo),
     _header(header),
+    _records(nullptr),
     _stringTable(nullptr)
 {
 }
@@ -345,10 +347,26 @@ void DB2FileLoaderRegularImpl::LoadColumnData(std::unique_ptr<DB2SectionHeader[]
 
 bool DB2FileLoaderRegularImpl::LoadTableData(DB2FileSource* source, uint32 section)
 {
+    std::size_t recordsSize = std::size_t(_header->RecordSize) * _header->RecordCount;
+
+    // Files with a single section already store records followed by strings, exactly the layout we need
+    // read them in place when the source is memory mapped, the data following them in the file covers the 8 padding bytes
+    if (uint8 const* mappedData = source->GetMappedData(); mappedData && _header->SectionCount == 1 && !_records)
+    {
+        int64 position = source->GetPosition();
+        if (position + int64(recordsSize + _header->StringTableSize + 8) <= source->GetFileSize())
+        {
+            _records = mappedData + position;
+            _stringTable = _records + recordsSize;
+            return source->SetPosition(position + recordsSize + _header->StringTableSize);
+        }
+    }
+
     if (!_data)
     {
-        _data = std::make_unique<uint8[]>(_header->RecordSize * _header->RecordCount + _header->StringTableSize + 8);
-        _stringTable = &_data[_header->RecordSize * _header->RecordCount];
+        _data = std::make_unique<uint8[]>(recordsSize + _header->StringTableSize + 8);
+        _records = _data.get();
+        _stringTable = &_data[recordsSize];
     }
 
     uint32 sectionDataStart = 0;
@@ -362,7 +380,7 @@ bool DB2FileLoaderRegularImpl::LoadTableData(DB2FileSource* source, uint32 secti
     if (_sections[section].RecordCount && !source->Read(&_data[sectionDataStart], _header->RecordSize * _sections[section].RecordCount))
         return false;
 
-    if (_sections[section].StringTableSize && !source->Read(&_stringTable[sectionStringTableStart], _sections[section].StringTableSize))
+    if (_sections[section].StringTableSize && !source->Read(&_data[recordsSize + sectionStringTableStart], _sections[section].StringTableSize))
         return false;
 
     return true;
@@ -736,7 +754,7 @@ unsigned char const* DB2FileLoaderRegularImpl::GetRawRecordData(uint32 recordNum
     if (GetSection(section ? *section : GetRecordSection(recordNumber)).TactId)
         return nullptr;
 
-    return &_data[recordNumber * _header->RecordSize];
+    return &_records[recordNumber * _header->RecordSize];
 }
 
 uint32 DB2FileLoaderRegularImpl::RecordGetId(uint8 const* record, uint32 recordIndex) const
@@ -810,7 +828,7 @@ T DB2FileLoaderRegularImpl::RecordGetVarInt(uint8 const* record, uint32 field, u
         }
         case DB2ColumnCompression::CommonData:
         {
-            uint32 id = RecordGetId(record, (_data.get() - record) / _header->RecordSize);
+            uint32 id = RecordGetId(record, (_records - record) / _header->RecordSize);
             T value;
             auto valueItr = _commonValues[field].find(id);
             if (valueItr != _commonValues[field].end())
@@ -117,6 +117,10 @@ struct TC_COMMON_API DB2FileSource
     virtual char const* GetFileName() const = 0;
 
     virtual DB2EncryptedSectionHandling HandleEncryptedSection(DB2SectionHeader const& sectionHeader) const = 0;
+
+    // Returns entire file contents if the source is memory mapped, records are then read in place
+    // Mapped data must stay valid for as long as the loader is used
+    virtual uint8 const* GetMappedData() const { return nullptr; }
 };
 
 class TC_COMMON_API DB2Record
@@ -17,11 +17,21 @@
 
 #include "DB2FileSystemSource.h"
 #include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <cstring>
 
-DB2FileSystemSource::DB2FileSystemSource(std::string const& fileName)
+DB2FileSystemSource::DB2FileSystemSource(std::string const& fileName) : _fileName(fileName), _file(nullptr), _position(0)
 {
-    _fileName = fileName;
-    _file = fopen(_fileName.c_str(), "rb");
+    try
+    {
+        // the region keeps the pages mapped after the file mapping handle is closed
+        boost::interprocess::file_mapping file(_fileName.c_str(), boost::interprocess::read_only);
+        _mapping = boost::interprocess::mapped_region(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        _file = fopen(_fileName.c_str(), "rb");
+    }
 }
 
 DB2FileSystemSource::~DB2FileSystemSource()
@@ -32,26 +42,51 @@ DB2FileSystemSource::~DB2FileSystemSource()
 
 bool DB2FileSystemSource::IsOpen() const
 {
-    return _file != nullptr;
+    return _file != nullptr || _mapping.get_address() != nullptr;
 }
 
 bool DB2FileSystemSource::Read(void* buffer, std::size_t numBytes)
 {
+    if (!_file)
+    {
+        if (_position < 0 || std::size_t(_position) + numBytes > _mapping.get_size())
+            return false;
+
+        memcpy(buffer, GetMappedData() + _position, numBytes);
+        _position += numBytes;
+        return true;
+    }
+
     return fread(buffer, numBytes, 1, _file) == 1;
 }
 
 int64 DB2FileSystemSource::GetPosition() const
 {
+    if (!_file)
+        return _position;
+
     return ftell(_file);
 }
 
 bool DB2FileSystemSource::SetPosition(int64 position)
 {
+    if (!_file)
+    {
+        if (position < 0 || std::size_t(position) > _mapping.get_size())
+            return false;
+
+        _position = position;
+        return true;
+    }
+
     return fseek(_file, position, SEEK_SET) == 0;
 }
 
 int64 DB2FileSystemSource::GetFileSize() const
 {
+    if (!_file)
+        return _mapping.get_size();
+
     boost::system::error_code error;
     int64 size = boost::filesystem::file_size(_fileName, error);
     return !error ? size : 0;
@@ -66,3 +101,8 @@ DB2EncryptedSectionHandling DB2FileSystemSource::HandleEncryptedSection(DB2Secti
 {
     return DB2EncryptedSectionHandling::Skip;
 }
+
+uint8 const* DB2FileSystemSource::GetMappedData() const
+{
+    return static_cast<uint8 const*>(_mapping.get_address());
+}
@@ -19,6 +19,7 @@
 #define DB2FileSystemSource_h__
 
 #include "DB2FileLoader.h"
+#include <boost/interprocess/mapped_region.hpp>
 #include <string>
 
 struct TC_COMMON_API DB2FileSystemSource : public DB2FileSource
@@ -32,10 +33,13 @@ struct TC_COMMON_API DB2FileSystemSource : public DB2FileSource
     int64 GetFileSize() const override;
     char const* GetFileName() const override;
     DB2EncryptedSectionHandling HandleEncryptedSection(DB2SectionHeader const& sectionHeader) const override;
+    uint8 const* GetMappedData() const override;
 
 private:
     std::string _fileName;
-    FILE* _file;
+    FILE* _file;                                    // only used when the file cannot be memory mapped
+    boost::interprocess::mapped_region _mapping;    // read only mapping, pages are shared with every process loading the same file
+    int64 _position;
 };
 
 #endif // DB2FileSystemSource_h__
@@ -23,6 +23,7 @@
 #include "Log.h"
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
 
 IpLocationStore::IpLocationStore()
 {
@@ -34,7 +35,10 @@ IpLocationStore::~IpLocationStore()
 
 void IpLocationStore::Load()
 {
-    _ipLocationStore.clear();
+    _ipFrom.clear();
+    _ipTo.clear();
+    _ipCountry.clear();
+    _countries.clear();
     TC_LOG_INFO("server.loading", "Loading IP Location Database...");
 
     std::string databaseFilePath = sConfigMgr->GetStringDefault("IPLocationFile", "");
@@ -60,6 +64,16 @@ void IpLocationStore::Load()
     std::string countryCode;
     std::string countryName;
 
+    struct IpRange
+    {
+        uint32 IpFrom;
+        uint32 IpTo;
+        uint16 Country;
+    };
+
+    std::vector<IpRange> ranges;
+    std::unordered_map<std::string, uint16> countryIndexes;
+
     while (databaseFile.good())
     {
         // Read lines
@@ -85,29 +99,48 @@ void IpLocationStore::Load()
         // Convert country code to lowercase
         std::transform(countryCode.begin(), countryCode.end(), countryCode.begin(), ::tolower);
 
-        _ipLocationStore.emplace_back(uint32(atoul(ipFrom.c_str())), uint32(atoul(ipTo.c_str())), std::move(countryCode), std::move(countryName));
+        auto country = countryIndexes.try_emplace(countryCode, uint16(_countries.size()));
+        if (country.second)
+            _countries.emplace_back(std::move(countryCode), std::move(countryName));
+
+        ranges.push_back({ uint32(atoul(ipFrom.c_str())), uint32(atoul(ipTo.c_str())), country.first->second });
     }
 
-    std::sort(_ipLocationStore.begin(), _ipLocationStore.end(), [](IpLocationRecord const& a, IpLocationRecord const& b) { return a.IpFrom < b.IpFrom; });
-    ASSERT(std::is_sorted(_ipLocationStore.begin(), _ipLocationStore.end(), [](IpLocationRecord const& a, IpLocationRecord const& b) { return a.IpFrom < b.IpTo; }),
+    std::sort(ranges.begin(), ranges.end(), [](IpRange const& a, IpRange const& b) { return a.IpFrom < b.IpFrom; });
+    ASSERT(std::is_sorted(ranges.begin(), ranges.end(), [](IpRange const& a, IpRange const& b) { return a.IpFrom < b.IpTo; }),
         "Overlapping IP ranges detected in database file");
 
     databaseFile.close();
 
-    TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " ip location entries.", _ipLocationStore.size());
+    _ipFrom.reserve(ranges.size());
+    _ipTo.reserve(ranges.size());
+    _ipCountry.reserve(ranges.size());
+    for (IpRange const& range : ranges)
+    {
+        _ipFrom.push_back(range.IpFrom);
+        _ipTo.push_back(range.IpTo);
+        _ipCountry.push_back(range.Country);
+    }
+
+    TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " ip location entries for " SZFMTD " countries.", _ipTo.size(), _countries.size());
 }
 
 IpLocationRecord const* IpLocationStore::GetLocationRecord(std::string const& ipAddress) const
 {
-    uint32 ip = Trinity::Net::address_to_uint(Trinity::Net::make_address_v4(ipAddress));
-    auto itr = std::upper_bound(_ipLocationStore.begin(), _ipLocationStore.end(), ip, [](uint32 ip, IpLocationRecord const& loc) { return ip < loc.IpTo; });
-    if (itr == _ipLocationStore.end())
+    return GetLocationRecord(Trinity::Net::address_to_uint(Trinity::Net::make_address_v4(ipAddress)));
+}
+
+IpLocationRecord const* IpLocationStore::GetLocationRecord(uint32 ip) const
+{
+    auto itr = std::upper_bound(_ipTo.begin(), _ipTo.end(), ip);
+    if (itr == _ipTo.end())
         return nullptr;
 
-    if (ip < itr->IpFrom)
+    std::size_t index = std::distance(_ipTo.begin(), itr);
+    if (ip < _ipFrom[index])
         return nullptr;
 
-    return &(*itr);
+    return &_countries[_ipCountry[index]];
 }
 
 IpLocationStore* IpLocationStore::Instance()
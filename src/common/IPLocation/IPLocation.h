@@ -22,14 +22,13 @@
 #include <string>
 #include <vector>
 
+// one record per country, shared by all of its address ranges
 struct IpLocationRecord
 {
-    IpLocationRecord() : IpFrom(0), IpTo(0) { }
-    IpLocationRecord(uint32 ipFrom, uint32 ipTo, std::string countryCode, std::string countryName)
-        : IpFrom(ipFrom), IpTo(ipTo), CountryCode(std::move(countryCode)), CountryName(std::move(countryName)) { }
+    IpLocationRecord() { }
+    IpLocationRecord(std::string countryCode, std::string countryName)
+        : CountryCode(std::move(countryCode)), CountryName(std::move(countryName)) { }
 
-    uint32 IpFrom;
-    uint32 IpTo;
     std::string CountryCode;
     std::string CountryName;
 };
@@ -43,9 +42,14 @@ class TC_COMMON_API IpLocationStore
 
         void Load();
         IpLocationRecord const* GetLocationRecord(std::string const& ipAddress) const;
+        IpLocationRecord const* GetLocationRecord(uint32 ip) const;
 
     private:
-        std::vector<IpLocationRecord> _ipLocationStore;
+        // ranges sorted by start address, kept in separate arrays so the binary search only touches _ipTo
+        std::vector<uint32> _ipFrom;
+        std::vector<uint32> _ipTo;
+        std::vector<uint16> _ipCountry;
+        std::vector<IpLocationRecord> _countries;
 };
 
 #define sIPLocation IpLocationStore::Instance()
@@ -27,7 +27,11 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, Ap
     logfile(nullptr),
     _logDir(sLog->GetLogsDir()),
     _maxFileSize(0),
-    _fileSize(0)
+    _fileSize(0),
+    _flushSize(0),
+    _flushInterval(0),
+    _unflushedSize(0),
+    _lastFlushTime(std::chrono::steady_clock::now().time_since_epoch().count())
 {
     if (args.size() < 4)
         throw InvalidAppenderArgsException(Trinity::StringFormat("Log::CreateAppenderFromConfig: Missing file name for appender %s", name.c_str()));
@@ -55,6 +59,22 @@ AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, Ap
             throw InvalidAppenderArgsException(Trinity::StringFormat("Log::CreateAppenderFromConfig: Invalid size '%s' for appender %s", std::string(args[5]).c_str(), name.c_str()));
     }
 
+    if (6 < args.size())
+    {
+        if (Optional<uint32> size = Trinity::StringTo<uint32>(args[6]))
+            _flushSize = *size;
+        else
+            throw InvalidAppenderArgsException(Trinity::StringFormat("Log::CreateAppenderFromConfig: Invalid flush size '%s' for appender %s", std::string(args[6]).c_str(), name.c_str()));
+    }
+
+    if (7 < args.size())
+    {
+        if (Optional<uint32> interval = Trinity::StringTo<uint32>(args[7]))
+            _flushInterval = Milliseconds(*interval);
+        else
+            throw InvalidAppenderArgsException(Trinity::StringFormat("Log::CreateAppenderFromConfig: Invalid flush interval '%s' for appender %s", std::string(args[7]).c_str(), name.c_str()));
+    }
+
     _dynamicName = std::string::npos != _fileName.find("%s");
     _backup = (flags & APPENDER_FLAGS_MAKE_FILE_BACKUP) != 0;
 
@@ -92,10 +112,29 @@ void AppenderFile::_write(LogMessage const* message)
         return;
 
     fprintf(logfile, "%s%s\n", message->prefix.c_str(), message->text.c_str());
-    fflush(logfile);
+    if (ShouldFlush(message))
+        fflush(logfile);
     _fileSize += uint64(message->Size());
 }
 
+bool AppenderFile::ShouldFlush(LogMessage const* message)
+{
+    if (!_flushSize)
+        return true;
+
+    TimePoint::rep now = std::chrono::steady_clock::now().time_since_epoch().count();
+    uint32 unflushedSize = _unflushedSize.fetch_add(uint32(message->Size())) + uint32(message->Size());
+
+    // errors are flushed right away so that they are not lost if the process dies shortly after
+    if (message->level < LOG_LEVEL_ERROR && unflushedSize < _flushSize
+        && (_flushInterval <= 0ms || TimePoint::duration(now - _lastFlushTime.load()) < _flushInterval))
+        return false;
+
+    _unflushedSize = 0;
+    _lastFlushTime = now;
+    return true;
+}
+
 FILE* AppenderFile::OpenFile(std::string const& filename, std::string const& mode, bool backup)
 {
     std::string fullName(_logDir + filename);
@@ -111,7 +150,12 @@ FILE* AppenderFile::OpenFile(std::string const& filename, std::string const& mod
 
     if (FILE* ret = fopen(fullName.c_str(), mode.c_str()))
     {
+        // let stdio batch writes in a buffer large enough to hold everything written between two flushes
+        if (_flushSize && !_dynamicName)
+            setvbuf(ret, nullptr, _IOFBF, _flushSize + BUFSIZ);
+
         _fileSize = ftell(ret);
+        _unflushedSize = 0;
         return ret;
     }
 
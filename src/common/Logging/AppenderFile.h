@@ -19,6 +19,7 @@
 #define APPENDERFILE_H
 
 #include "Appender.h"
+#include "Duration.h"
 #include <atomic>
 
 class TC_COMMON_API AppenderFile : public Appender
@@ -34,6 +35,7 @@ class TC_COMMON_API AppenderFile : public Appender
     private:
         void CloseFile();
         void _write(LogMessage const* message) override;
+        bool ShouldFlush(LogMessage const* message);
         FILE* logfile;
         std::string _fileName;
         std::string _logDir;
@@ -41,6 +43,10 @@ class TC_COMMON_API AppenderFile : public Appender
         bool _backup;
         uint64 _maxFileSize;
         std::atomic<uint64> _fileSize;
+        uint32 _flushSize;
+        Milliseconds _flushInterval;
+        std::atomic<uint32> _unflushedSize;
+        std::atomic<TimePoint::rep> _lastFlushTime;
 };
 
 #endif
@@ -30,7 +30,7 @@
 #include <chrono>
 #include <sstream>
 
-Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
+Log::Log() : _loggerGeneration(1), AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -144,6 +144,8 @@ void Log::CreateLoggerFromConfigLine(std::string const& loggerName, std::string
         return;
     }
 
+    InvalidateLoggerCaches();
+
     std::unique_ptr<Logger>& logger = loggers[name];
     if (logger)
     {
@@ -212,6 +214,7 @@ void Log::ReadLoggersFromConfig()
         Logger* serverLogger = new Logger("server", LOG_LEVEL_INFO);
         serverLogger->addAppender(appender->getId(), appender);
         loggers["server"].reset(serverLogger);
+        InvalidateLoggerCaches();
     }
 }
 
@@ -254,12 +257,31 @@ Logger const* Log::GetLoggerByType(std::string const& type) const
     if (type == LOGGER_ROOT)
         return nullptr;
 
+    {
+        std::shared_lock<std::shared_mutex> lock(_parentLoggerCacheLock);
+        auto cached = _parentLoggerCache.find(type);
+        if (cached != _parentLoggerCache.end())
+            return cached->second;
+    }
+
     std::string parentLogger = LOGGER_ROOT;
     size_t found = type.find_last_of('.');
     if (found != std::string::npos)
         parentLogger = type.substr(0, found);
 
-    return GetLoggerByType(parentLogger);
+    Logger const* logger = GetLoggerByType(parentLogger);
+
+    std::unique_lock<std::shared_mutex> lock(_parentLoggerCacheLock);
+    _parentLoggerCache.emplace(type, logger);
+    return logger;
+}
+
+void Log::InvalidateLoggerCaches()
+{
+    std::unique_lock<std::shared_mutex> lock(_parentLoggerCacheLock);
+    _parentLoggerCache.clear();
+    // call sites compare against this, 0 is never a valid generation
+    _loggerGeneration.fetch_add(1, std::memory_order_acq_rel);
 }
 
 std::string Log::GetTimestampStr()
@@ -347,21 +369,39 @@ void Log::SetRealmId(uint32 id)
 
 void Log::Close()
 {
+    InvalidateLoggerCaches();
     loggers.clear();
     appenders.clear();
 }
 
 bool Log::ShouldLog(std::string const& type, LogLevel level) const
 {
-    // TODO: Use cache to store "Type.sub1.sub2": "Type" equivalence, should
-    // Speed up in cases where requesting "Type.sub1.sub2" but only configured
-    // Logger "Type"
-
     // Don't even look for a logger if the LogLevel is lower than lowest log levels across all loggers
     if (level < lowestLogLevel)
         return false;
 
+    return ShouldLog(GetLoggerByType(type), level);
+}
+
+bool Log::ShouldLog(LogCallSite& callSite, char const* type, LogLevel level) const
+{
+    if (level < lowestLogLevel)
+        return false;
+
+    // string literals keep their address, so a call site resolves its logger only once per configuration
+    uint32 generation = _loggerGeneration.load(std::memory_order_acquire);
+    if (callSite.Generation.load(std::memory_order_acquire) == generation && callSite.Type.load(std::memory_order_relaxed) == type)
+        return ShouldLog(callSite.ResolvedLogger.load(std::memory_order_relaxed), level);
+
     Logger const* logger = GetLoggerByType(type);
+    callSite.ResolvedLogger.store(logger, std::memory_order_relaxed);
+    callSite.Type.store(type, std::memory_order_relaxed);
+    callSite.Generation.store(generation, std::memory_order_release);
+    return ShouldLog(logger, level);
+}
+
+bool Log::ShouldLog(Logger const* logger, LogLevel level) const
+{
     if (!logger)
         return false;
 
@@ -384,6 +424,7 @@ void Log::Initialize(Trinity::Asio::IoContext* ioContext)
     }
 
     LoadFromConfig();
+    sConfigMgr->AddReloadListener("Log", [this]() { LoadFromConfig(); });
 }
 
 void Log::SetSynchronous()
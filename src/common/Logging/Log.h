@@ -22,7 +22,9 @@
 #include "AsioHacksFwd.h"
 #include "LogCommon.h"
 #include "StringFormat.h"
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -42,6 +44,14 @@ namespace Trinity
 
 typedef Appender*(*AppenderCreatorFn)(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<std::string_view> const& extraArgs);
 
+// Logger resolved by a single TC_LOG_* statement, valid while Generation matches the log configuration
+struct LogCallSite
+{
+    std::atomic<uint32> Generation{ 0 };
+    std::atomic<char const*> Type{ nullptr };
+    std::atomic<Logger const*> ResolvedLogger{ nullptr };
+};
+
 template <class AppenderImpl>
 Appender* CreateAppender(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<std::string_view> const& extraArgs)
 {
@@ -66,6 +76,8 @@ class TC_COMMON_API Log
         void LoadFromConfig();
         void Close();
         bool ShouldLog(std::string const& type, LogLevel level) const;
+        bool ShouldLog(LogCallSite& callSite, char const* type, LogLevel level) const;
+        bool ShouldLog(LogCallSite& /*callSite*/, std::string const& type, LogLevel level) const { return ShouldLog(type, level); }
         bool SetLogLevel(std::string const& name, int32 level, bool isLogger = true);
 
         template<typename Format, typename... Args>
@@ -104,6 +116,8 @@ class TC_COMMON_API Log
         void write(std::unique_ptr<LogMessage>&& msg) const;
 
         Logger const* GetLoggerByType(std::string const& type) const;
+        bool ShouldLog(Logger const* logger, LogLevel level) const;
+        void InvalidateLoggerCaches();
         Appender* GetAppenderByName(std::string_view name);
         uint8 NextAppenderId();
         void CreateAppenderFromConfig(std::string const& name);
@@ -117,6 +131,10 @@ class TC_COMMON_API Log
         std::unordered_map<uint8, AppenderCreatorFn> appenderFactory;
         std::unordered_map<uint8, std::unique_ptr<Appender>> appenders;
         std::unordered_map<std::string, std::unique_ptr<Logger>> loggers;
+        // "Type.sub1.sub2" -> nearest configured parent logger, resolved once instead of on every ShouldLog
+        mutable std::unordered_map<std::string, Logger const*> _parentLoggerCache;
+        mutable std::shared_mutex _parentLoggerCacheLock;
+        std::atomic<uint32> _loggerGeneration;
         uint8 AppenderId;
         LogLevel lowestLogLevel;
 
@@ -151,7 +169,8 @@ void check_args(std::string const&, ...);
 // This will catch format errors on build time
 #define TC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogCallSite callSite__;                              \
+            if (sLog->ShouldLog(callSite__, filterType__, level__))     \
             {                                                           \
                 if (false)                                              \
                     check_args(__VA_ARGS__);                            \
@@ -164,7 +183,8 @@ void check_args(std::string const&, ...);
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogCallSite callSite__;                              \
+            if (sLog->ShouldLog(callSite__, filterType__, level__))     \
                 LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
         } while (0)                                                     \
         __pragma(warning(pop))
@@ -0,0 +1,378 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HeapProfiler.h"
+#include "MemoryAccounting.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+// weak references, resolved only when the process is linked against (or preloads) an allocator providing them
+extern "C"
+{
+    int mallctl(char const* name, void* oldp, std::size_t* oldlenp, void* newp, std::size_t newlen) __attribute__((weak));
+    void HeapProfilerStart(char const* prefix) __attribute__((weak));
+    void HeapProfilerStop() __attribute__((weak));
+    void HeapProfilerDump(char const* reason) __attribute__((weak));
+}
+#endif
+
+namespace
+{
+    using Backend = Trinity::HeapProfiler::Backend;
+
+    struct Sample
+    {
+        std::size_t Size;
+        char const* Tag;
+    };
+
+    struct SampleShard
+    {
+        std::mutex Lock;
+        std::unordered_map<void*, Sample> Samples;
+    };
+
+    constexpr std::size_t ShardCount = 16;
+    constexpr uint32 FilterBits = 20;
+
+    std::atomic<Backend> RunningBackend{ Backend::None };
+    std::atomic<bool> SamplingHooksInstalled{ false };
+    std::atomic<uint32> SampleInterval{ 0 };    // 0 unless the sampling backend is running
+
+    // number of live samples per pointer hash, lets OnRelease skip the shard lock for (almost) every pointer that was not sampled
+    std::array<std::atomic<uint16>, std::size_t(1) << FilterBits> SampledFilter = { };
+
+    thread_local char const* ThreadTag = nullptr;
+    thread_local int64 BytesUntilSample = 0;
+    thread_local bool InHook = false;               // the shards allocate and free too
+
+    // never destroyed, memory may still be released by other threads during shutdown
+    std::array<SampleShard, ShardCount>& GetShards()
+    {
+        static std::array<SampleShard, ShardCount>* shards = new std::array<SampleShard, ShardCount>();
+        return *shards;
+    }
+
+    std::size_t HashPointer(void* ptr)
+    {
+        return std::size_t((uint64(reinterpret_cast<uintptr_t>(ptr)) * UI64LIT(0x9E3779B97F4A7C15)) >> (64 - FilterBits));
+    }
+
+    void ClearSamples()
+    {
+        for (SampleShard& shard : GetShards())
+        {
+            std::lock_guard<std::mutex> lock(shard.Lock);
+            InHook = true;
+            shard.Samples.clear();
+            InHook = false;
+        }
+
+        for (std::atomic<uint16>& count : SampledFilter)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    bool IsJemallocProfilingAvailable()
+    {
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+        bool enabled = false;
+        std::size_t size = sizeof(enabled);
+        return mallctl && mallctl("opt.prof", &enabled, &size, nullptr, 0) == 0 && enabled;
+#else
+        return false;
+#endif
+    }
+
+    bool IsTcmallocProfilingAvailable()
+    {
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+        return HeapProfilerStart && HeapProfilerStop && HeapProfilerDump;
+#else
+        return false;
+#endif
+    }
+
+    bool WriteSampledProfile(std::string const& fileName, uint32 interval, std::string& error)
+    {
+        std::map<std::pair<std::string_view, std::size_t>, uint64> sizes;
+        for (SampleShard& shard : GetShards())
+        {
+            std::lock_guard<std::mutex> lock(shard.Lock);
+            InHook = true;
+            for (std::pair<void* const, Sample> const& sample : shard.Samples)
+                ++sizes[{ sample.second.Tag, sample.second.Size }];
+            InHook = false;
+        }
+
+        std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            error = "could not open " + fileName;
+            return false;
+        }
+
+        file << "# heap profile, one sample every " << interval << " allocated bytes on average\n";
+        file << "# estimated live bytes / allocations per subsystem\n";
+        for (Trinity::HeapProfiler::TagStats const& stats : Trinity::HeapProfiler::GetSampledStats())
+            file << Trinity::StringFormat("%14llu %10llu  %s\n", (unsigned long long)stats.Bytes, (unsigned long long)stats.Allocations, stats.Tag);
+
+        // sizes of a leak or of bloat are usually what points at the type
+        std::vector<std::pair<std::pair<std::string_view, std::size_t>, uint64>> sorted(sizes.begin(), sizes.end());
+        std::sort(sorted.begin(), sorted.end(), [interval](auto const& left, auto const& right)
+        {
+            return left.second * std::max<uint64>(left.first.second, interval) > right.second * std::max<uint64>(right.first.second, interval);
+        });
+
+        file << "\n# top allocation sizes: samples, size, subsystem\n";
+        for (std::size_t i = 0; i < std::min<std::size_t>(sorted.size(), 100); ++i)
+            file << Trinity::StringFormat("%10llu %10zu  %s\n", (unsigned long long)sorted[i].second, sorted[i].first.second, std::string(sorted[i].first.first).c_str());
+
+        file << "\n# accounted memory (bytes)\n";
+        for (uint8 i = 0; i < uint8(Trinity::MemoryCategory::Max); ++i)
+        {
+            Trinity::MemoryCategory category = Trinity::MemoryCategory(i);
+            file << Trinity::StringFormat("%14lld  %s\n", (long long)Trinity::MemoryAccounting::GetBytes(category), Trinity::MemoryAccounting::GetName(category));
+        }
+
+        return bool(file);
+    }
+}
+
+Trinity::HeapProfiler::Backend Trinity::HeapProfiler::GetAvailableBackend()
+{
+    if (IsJemallocProfilingAvailable())
+        return Backend::Jemalloc;
+
+    if (IsTcmallocProfilingAvailable())
+        return Backend::Tcmalloc;
+
+    if (SamplingHooksInstalled.load(std::memory_order_relaxed))
+        return Backend::Sampling;
+
+    return Backend::None;
+}
+
+Trinity::HeapProfiler::Backend Trinity::HeapProfiler::GetRunningBackend()
+{
+    return RunningBackend.load(std::memory_order_relaxed);
+}
+
+char const* Trinity::HeapProfiler::GetBackendName(Backend backend)
+{
+    switch (backend)
+    {
+        case Backend::Jemalloc: return "jemalloc";
+        case Backend::Tcmalloc: return "tcmalloc";
+        case Backend::Sampling: return "sampling";
+        default:
+            break;
+    }
+
+    return "none";
+}
+
+bool Trinity::HeapProfiler::Start(uint32 sampleInterval, std::string const& dumpPrefix, std::string& error)
+{
+    if (GetRunningBackend() != Backend::None)
+    {
+        error = "heap profiling is already running";
+        return false;
+    }
+
+    sampleInterval = std::max(sampleInterval, 4096u);
+
+    Backend backend = GetAvailableBackend();
+    switch (backend)
+    {
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+        case Backend::Jemalloc:
+        {
+            // prof.reset drops the profile collected so far and takes the new sample rate as log2 of the interval
+            std::size_t lgSample = 0;
+            while ((std::size_t(2) << lgSample) <= sampleInterval)
+                ++lgSample;
+
+            bool active = true;
+            if (mallctl("prof.reset", nullptr, nullptr, &lgSample, sizeof(lgSample)) != 0
+                || mallctl("prof.active", nullptr, nullptr, &active, sizeof(active)) != 0)
+            {
+                error = "jemalloc refused to activate profiling";
+                return false;
+            }
+            break;
+        }
+        case Backend::Tcmalloc:
+            HeapProfilerStart(dumpPrefix.c_str());
+            break;
+#endif
+        case Backend::Sampling:
+            ClearSamples();
+            SampleInterval.store(sampleInterval, std::memory_order_relaxed);
+            break;
+        default:
+            error = "no heap profiler available, the allocator has no profiling support and operator new is not hooked";
+            return false;
+    }
+
+    RunningBackend.store(backend, std::memory_order_relaxed);
+    return true;
+}
+
+bool Trinity::HeapProfiler::Dump(std::string const& fileName, std::string& error)
+{
+    switch (GetRunningBackend())
+    {
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+        case Backend::Jemalloc:
+        {
+            char const* name = fileName.c_str();
+            if (mallctl("prof.dump", nullptr, nullptr, &name, sizeof(name)) != 0)
+            {
+                error = "jemalloc could not write " + fileName;
+                return false;
+            }
+            return true;
+        }
+        case Backend::Tcmalloc:
+            // tcmalloc names the file after the prefix given to Start
+            HeapProfilerDump("requested");
+            return true;
+#endif
+        case Backend::Sampling:
+            return WriteSampledProfile(fileName, SampleInterval.load(std::memory_order_relaxed), error);
+        default:
+            break;
+    }
+
+    error = "heap profiling is not running";
+    return false;
+}
+
+void Trinity::HeapProfiler::Stop()
+{
+    switch (RunningBackend.exchange(Backend::None, std::memory_order_relaxed))
+    {
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+        case Backend::Jemalloc:
+        {
+            bool active = false;
+            mallctl("prof.active", nullptr, nullptr, &active, sizeof(active));
+            break;
+        }
+        case Backend::Tcmalloc:
+            HeapProfilerStop();
+            break;
+#endif
+        case Backend::Sampling:
+            SampleInterval.store(0, std::memory_order_relaxed);
+            ClearSamples();
+            break;
+        default:
+            break;
+    }
+}
+
+std::vector<Trinity::HeapProfiler::TagStats> Trinity::HeapProfiler::GetSampledStats()
+{
+    uint64 interval = SampleInterval.load(std::memory_order_relaxed);
+    std::map<std::string_view, TagStats> tags;
+    for (SampleShard& shard : GetShards())
+    {
+        std::lock_guard<std::mutex> lock(shard.Lock);
+        InHook = true;
+        for (std::pair<void* const, Sample> const& sample : shard.Samples)
+        {
+            // an allocation of size bytes is sampled with probability size / interval (at most 1)
+            TagStats& stats = tags.try_emplace(sample.second.Tag, TagStats{ sample.second.Tag, 0, 0 }).first->second;
+            stats.Allocations += std::max<uint64>(interval / std::max<std::size_t>(sample.second.Size, 1), 1);
+            stats.Bytes += std::max<uint64>(sample.second.Size, interval);
+        }
+        InHook = false;
+    }
+
+    std::vector<TagStats> result;
+    result.reserve(tags.size());
+    for (std::pair<std::string_view const, TagStats> const& tag : tags)
+        result.push_back(tag.second);
+
+    std::sort(result.begin(), result.end(), [](TagStats const& left, TagStats const& right) { return left.Bytes > right.Bytes; });
+    return result;
+}
+
+void Trinity::HeapProfiler::SetSamplingHooksInstalled()
+{
+    SamplingHooksInstalled.store(true, std::memory_order_relaxed);
+}
+
+void Trinity::HeapProfiler::OnAllocation(void* ptr, std::size_t size)
+{
+    uint32 interval = SampleInterval.load(std::memory_order_relaxed);
+    if (!interval || !ptr)
+        return;
+
+    BytesUntilSample -= int64(size);
+    if (BytesUntilSample > 0 || InHook)
+        return;
+
+    BytesUntilSample = interval;
+
+    std::size_t hash = HashPointer(ptr);
+    SampleShard& shard = GetShards()[hash % ShardCount];
+    InHook = true;
+    {
+        std::lock_guard<std::mutex> lock(shard.Lock);
+        shard.Samples[ptr] = { size, ThreadTag ? ThreadTag : "other" };
+    }
+    InHook = false;
+
+    SampledFilter[hash].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Trinity::HeapProfiler::OnRelease(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    std::size_t hash = HashPointer(ptr);
+    if (!SampledFilter[hash].load(std::memory_order_relaxed) || InHook)
+        return;
+
+    SampleShard& shard = GetShards()[hash % ShardCount];
+    bool erased = false;
+    InHook = true;
+    {
+        std::lock_guard<std::mutex> lock(shard.Lock);
+        erased = shard.Samples.erase(ptr) != 0;
+    }
+    InHook = false;
+
+    if (erased)
+        SampledFilter[hash].fetch_sub(1, std::memory_order_relaxed);
+}
+
+char const*& Trinity::HeapProfiler::CurrentTag()
+{
+    return ThreadTag;
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_HEAPPROFILER_H
+#define TRINITY_HEAPPROFILER_H
+
+#include "Define.h"
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+    // On demand heap profiling of a running server (.debug heapprofile)
+    // Uses the profiler of the allocator when the process has one: jemalloc built with profiling support and started with
+    // MALLOC_CONF=prof:true,prof_active:false, or tcmalloc's heap profiler. Otherwise allocations made through operator new
+    // are sampled, which needs the executable to route them to OnAllocation/OnRelease (worldserver does)
+    class TC_COMMON_API HeapProfiler
+    {
+    public:
+        enum class Backend : uint8
+        {
+            None,
+            Jemalloc,
+            Tcmalloc,
+            Sampling
+        };
+
+        // estimated live allocations of one tag, sampling backend only
+        struct TagStats
+        {
+            char const* Tag;
+            uint64 Allocations;
+            uint64 Bytes;
+        };
+
+        static constexpr uint32 DefaultSampleInterval = 512 * 1024;
+
+        static Backend GetAvailableBackend();
+        static Backend GetRunningBackend();
+        static char const* GetBackendName(Backend backend);
+
+        // sampleInterval is the average number of allocated bytes between two samples (ignored by tcmalloc),
+        // dumpPrefix is only used by tcmalloc which names the dumps itself
+        static bool Start(uint32 sampleInterval, std::string const& dumpPrefix, std::string& error);
+        static bool Dump(std::string const& fileName, std::string& error);
+        static void Stop();
+
+        static std::vector<TagStats> GetSampledStats();
+
+        // called by the operator new/delete replacements of the executable
+        static void SetSamplingHooksInstalled();
+        static void OnAllocation(void* ptr, std::size_t size);
+        static void OnRelease(void* ptr);
+
+        // attributes allocations sampled on the current thread to a subsystem while alive, tag must be a string literal
+        class TC_COMMON_API Scope
+        {
+        public:
+            explicit Scope(char const* tag) : _previousTag(CurrentTag())
+            {
+                CurrentTag() = tag;
+            }
+
+            ~Scope()
+            {
+                CurrentTag() = _previousTag;
+            }
+
+            Scope(Scope const&) = delete;
+            Scope& operator=(Scope const&) = delete;
+
+        private:
+            char const* _previousTag;
+        };
+
+    private:
+        static char const*& CurrentTag();
+    };
+}
+
+#endif // TRINITY_HEAPPROFILER_H
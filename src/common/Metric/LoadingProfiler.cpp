@@ -0,0 +1,164 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadingProfiler.h"
+#include "Log.h"
+#include "MemoryAccounting.h"
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+    constexpr std::size_t MaxReportedSteps = 15;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct LoadingProfile
+    {
+        bool Active = false;
+        std::string Phase;
+        Clock::time_point PhaseStart;
+
+        std::string StepName;
+        Clock::time_point StepStart;
+        int64 StepStartBytes = 0;
+
+        std::vector<Trinity::LoadingProfiler::StepInfo> Steps;
+    };
+
+    std::mutex ProfileLock;
+    LoadingProfile Profile;
+
+    int64 GetAccountedBytes()
+    {
+        int64 bytes = 0;
+        for (uint8 i = 0; i < uint8(Trinity::MemoryCategory::Max); ++i)
+            bytes += Trinity::MemoryAccounting::GetBytes(Trinity::MemoryCategory(i));
+        return bytes;
+    }
+
+    void EndStep(Clock::time_point now)
+    {
+        if (Profile.StepName.empty())
+            return;
+
+        Profile.Steps.push_back({ std::move(Profile.StepName), std::chrono::duration_cast<Milliseconds>(now - Profile.StepStart),
+            GetAccountedBytes() - Profile.StepStartBytes });
+        Profile.StepName.clear();
+    }
+
+    void WriteJsonString(std::ostringstream& ss, std::string const& str)
+    {
+        ss << '"';
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+                ss << '\\' << c;
+            else if (uint8(c) >= 0x20)
+                ss << c;
+        }
+        ss << '"';
+    }
+}
+
+bool Trinity::LoadingProfiler::Begin(std::string phase)
+{
+    std::lock_guard<std::mutex> lock(ProfileLock);
+    if (Profile.Active)
+        return false;
+
+    Profile.Active = true;
+    Profile.Phase = std::move(phase);
+    Profile.PhaseStart = Clock::now();
+    Profile.StepName.clear();
+    Profile.Steps.clear();
+    return true;
+}
+
+void Trinity::LoadingProfiler::Step(std::string name)
+{
+    std::lock_guard<std::mutex> lock(ProfileLock);
+    if (!Profile.Active)
+        return;
+
+    Clock::time_point now = Clock::now();
+    EndStep(now);
+
+    Profile.StepName = std::move(name);
+    Profile.StepStart = now;
+    Profile.StepStartBytes = GetAccountedBytes();
+}
+
+std::vector<Trinity::LoadingProfiler::StepInfo> Trinity::LoadingProfiler::End(bool report)
+{
+    std::string phase;
+    Milliseconds total;
+    std::vector<StepInfo> steps;
+    {
+        std::lock_guard<std::mutex> lock(ProfileLock);
+        if (!Profile.Active)
+            return {};
+
+        Clock::time_point now = Clock::now();
+        EndStep(now);
+
+        Profile.Active = false;
+        phase = std::move(Profile.Phase);
+        total = std::chrono::duration_cast<Milliseconds>(now - Profile.PhaseStart);
+        steps = std::move(Profile.Steps);
+        Profile.Steps.clear();
+    }
+
+    std::stable_sort(steps.begin(), steps.end(), [](StepInfo const& left, StepInfo const& right) { return left.Duration > right.Duration; });
+
+    if (report)
+    {
+        TC_LOG_INFO("server.loading", "Loading profile of %s: " SI64FMTD " ms in " SZFMTD " steps, slowest steps:", phase.c_str(), int64(total.count()), steps.size());
+        for (std::size_t i = 0; i < steps.size() && i < MaxReportedSteps; ++i)
+            TC_LOG_INFO("server.loading", "%8" PRId64 " ms %10" PRId64 " bytes  %s", int64(steps[i].Duration.count()), steps[i].AccountedBytes, steps[i].Name.c_str());
+
+        std::string fileName = sLog->GetLogsDir() + phase + "_profile.json";
+        std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+        if (file)
+            file << ToJson(phase, total, steps);
+        else
+            TC_LOG_ERROR("server.loading", "Could not write loading profile to %s", fileName.c_str());
+    }
+
+    return steps;
+}
+
+std::string Trinity::LoadingProfiler::ToJson(std::string const& phase, Milliseconds total, std::vector<StepInfo> const& steps)
+{
+    std::ostringstream ss;
+    ss << "{\"phase\":";
+    WriteJsonString(ss, phase);
+    ss << ",\"total_ms\":" << total.count() << ",\"steps\":[";
+    for (std::size_t i = 0; i < steps.size(); ++i)
+    {
+        if (i)
+            ss << ',';
+
+        ss << "{\"name\":";
+        WriteJsonString(ss, steps[i].Name);
+        ss << ",\"ms\":" << steps[i].Duration.count() << ",\"accounted_bytes\":" << steps[i].AccountedBytes << '}';
+    }
+    ss << "]}\n";
+    return ss.str();
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LOADINGPROFILER_H
+#define TRINITY_LOADINGPROFILER_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+    // Attributes the time (and accounted memory, see MemoryAccounting) spent during startup or a reload to the steps of the loading code.
+    // A step lasts until the next one starts or the phase ends, steps started outside of a phase are ignored
+    class TC_COMMON_API LoadingProfiler
+    {
+    public:
+        struct StepInfo
+        {
+            std::string Name;
+            Milliseconds Duration;
+            int64 AccountedBytes;   // can be negative when the step freed memory
+        };
+
+        // starts a phase, does nothing when one is already running (a reload called from a bigger reload)
+        static bool Begin(std::string phase);
+        static void Step(std::string name);
+
+        // ends the phase and returns its steps, slowest first
+        // with report set the slowest steps are logged and all of them written to <logs dir>/<phase>_profile.json
+        static std::vector<StepInfo> End(bool report);
+
+        static std::string ToJson(std::string const& phase, Milliseconds total, std::vector<StepInfo> const& steps);
+    };
+}
+
+#endif // TRINITY_LOADINGPROFILER_H
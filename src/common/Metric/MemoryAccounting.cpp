@@ -0,0 +1,85 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryAccounting.h"
+#include "Metric.h"
+#include <array>
+#include <atomic>
+
+namespace
+{
+    // plain atomics instead of registry gauges, grids and sessions may still be freed after the metric registry is gone
+    std::array<std::atomic<int64>, std::size_t(Trinity::MemoryCategory::Max)> Counters = { };
+
+    std::atomic<int64>& GetCounter(Trinity::MemoryCategory category)
+    {
+        return Counters[std::size_t(category)];
+    }
+}
+
+void Trinity::MemoryAccounting::Allocated(MemoryCategory category, std::size_t bytes)
+{
+    GetCounter(category).fetch_add(int64(bytes), std::memory_order_relaxed);
+}
+
+void Trinity::MemoryAccounting::Released(MemoryCategory category, std::size_t bytes)
+{
+    GetCounter(category).fetch_sub(int64(bytes), std::memory_order_relaxed);
+}
+
+void Trinity::MemoryAccounting::Set(MemoryCategory category, std::size_t bytes)
+{
+    GetCounter(category).store(int64(bytes), std::memory_order_relaxed);
+}
+
+int64 Trinity::MemoryAccounting::GetBytes(MemoryCategory category)
+{
+    return GetCounter(category).load(std::memory_order_relaxed);
+}
+
+char const* Trinity::MemoryAccounting::GetName(MemoryCategory category)
+{
+    switch (category)
+    {
+        case MemoryCategory::Terrain:       return "terrain";
+        case MemoryCategory::VMaps:         return "vmaps";
+        case MemoryCategory::MMaps:         return "mmaps";
+        case MemoryCategory::ObjectMgr:     return "objectmgr";
+        case MemoryCategory::DB2Stores:     return "db2";
+        case MemoryCategory::Sessions:      return "sessions";
+        case MemoryCategory::UpdateData:    return "updatedata";
+        case MemoryCategory::AuctionHouse:  return "auctionhouse";
+        default:
+            break;
+    }
+
+    return "unknown";
+}
+
+void Trinity::MemoryAccounting::UpdateMetrics()
+{
+    static std::array<MetricGauge*, std::size_t(MemoryCategory::Max)> const gauges = []
+    {
+        std::array<MetricGauge*, std::size_t(MemoryCategory::Max)> result;
+        for (std::size_t i = 0; i < result.size(); ++i)
+            result[i] = &sMetric->GetGauge("memory_bytes", { TC_METRIC_TAG("category", GetName(MemoryCategory(i))) });
+        return result;
+    }();
+
+    for (std::size_t i = 0; i < gauges.size(); ++i)
+        gauges[i]->Set(GetBytes(MemoryCategory(i)));
+}
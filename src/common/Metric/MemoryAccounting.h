@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MEMORYACCOUNTING_H
+#define TRINITY_MEMORYACCOUNTING_H
+
+#include "Define.h"
+#include <cstddef>
+
+namespace Trinity
+{
+    enum class MemoryCategory : uint8
+    {
+        Terrain,        // height, area, liquid and hole data of loaded grids
+        VMaps,          // loaded models and map trees
+        MMaps,          // everything detour allocates (navmeshes, tiles that could not be mapped, queries)
+        ObjectMgr,      // estimated from the number of entries in the main world database stores
+        DB2Stores,      // index and record tables, strings are not included
+        Sessions,       // sessions and output queued on their sockets
+        UpdateData,     // object update blocks not sent yet
+        AuctionHouse,   // estimated from the number of auctions
+
+        Max
+    };
+
+    // Bytes used by the big consumers of the worldserver, either counted where the memory is allocated and freed
+    // or periodically set from container sizes. All functions are thread safe
+    class TC_COMMON_API MemoryAccounting
+    {
+    public:
+        static void Allocated(MemoryCategory category, std::size_t bytes);
+        static void Released(MemoryCategory category, std::size_t bytes);
+
+        // for categories that are estimated instead of counted
+        static void Set(MemoryCategory category, std::size_t bytes);
+
+        static int64 GetBytes(MemoryCategory category);
+        static char const* GetName(MemoryCategory category);
+
+        // copies every category into the memory_bytes gauge of the metric registry
+        static void UpdateMetrics();
+
+        // rough heap usage of a node based container (std::map, std::unordered_map, ...), memory owned by the elements is not included
+        template<class Container>
+        static std::size_t EstimateNodeContainer(Container const& container)
+        {
+            return container.size() * (sizeof(typename Container::value_type) + 3 * sizeof(void*));
+        }
+    };
+}
+
+#endif // TRINITY_MEMORYACCOUNTING_H
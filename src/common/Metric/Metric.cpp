@@ -19,20 +19,110 @@
 #include "Common.h"
 #include "Config.h"
 #include "DeadlineTimer.h"
+#include "IoContext.h"
+#include "IpAddress.h"
 #include "Log.h"
 #include "Strand.h"
 #include "Util.h"
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    class PrometheusScrapeConnection : public std::enable_shared_from_this<PrometheusScrapeConnection>
+    {
+    public:
+        explicit PrometheusScrapeConnection(boost::asio::ip::tcp::socket&& socket) : _socket(std::move(socket)) { }
+
+        void Start()
+        {
+            // the request itself is ignored, any GET returns the full exposition
+            boost::asio::async_read_until(_socket, _request, "\r\n\r\n",
+                [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+            {
+                if (error)
+                    return;
+
+                std::string body = sMetric->FormatPrometheus();
+                self->_response = "HTTP/1.1 200 OK\r\n"
+                    "Content-Type: text/plain; version=0.0.4\r\n"
+                    "Connection: close\r\n"
+                    "Content-Length: " + std::to_string(body.length()) + "\r\n\r\n" + body;
+
+                boost::asio::async_write(self->_socket, boost::asio::buffer(self->_response),
+                    [self](boost::system::error_code const& /*error*/, std::size_t /*transferred*/)
+                {
+                    boost::system::error_code ignored;
+                    self->_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                    self->_socket.close(ignored);
+                });
+            });
+        }
+
+    private:
+        boost::asio::ip::tcp::socket _socket;
+        boost::asio::streambuf _request;
+        std::string _response;
+    };
+
+    std::string FormatPrometheusLabelValue(std::string const& value)
+    {
+        std::string formatted;
+        formatted.reserve(value.length());
+        for (char c : value)
+        {
+            switch (c)
+            {
+                case '\\': formatted += "\\\\"; break;
+                case '"': formatted += "\\\""; break;
+                case '\n': formatted += "\\n"; break;
+                default: formatted += c; break;
+            }
+        }
+        return formatted;
+    }
+}
+
+struct Metric::PrometheusEndpoint : public std::enable_shared_from_this<Metric::PrometheusEndpoint>
+{
+    explicit PrometheusEndpoint(IoContextBaseNamespace::IoContextBase& ioContext) : IoContext(ioContext), Acceptor(ioContext), Socket(ioContext) { }
+
+    void AsyncAccept()
+    {
+        Acceptor.async_accept(Socket, [self = shared_from_this()](boost::system::error_code const& error)
+        {
+            if (error == boost::asio::error::operation_aborted || !self->Acceptor.is_open())
+                return;
+
+            if (!error)
+                std::make_shared<PrometheusScrapeConnection>(std::move(self->Socket))->Start();
+
+            self->Socket = boost::asio::ip::tcp::socket(self->IoContext);
+            self->AsyncAccept();
+        });
+    }
+
+    IoContextBaseNamespace::IoContextBase& IoContext;
+    boost::asio::ip::tcp::acceptor Acceptor;
+    boost::asio::ip::tcp::socket Socket;
+};
 
 void Metric::Initialize(std::string const& realmName, Trinity::Asio::IoContext& ioContext, std::function<void()> overallStatusLogger)
 {
     _dataStream = std::make_unique<boost::asio::ip::tcp::iostream>();
     _realmName = FormatInfluxDBTagValue(realmName);
+    _realmLabel = FormatPrometheusLabelValue(realmName);
+    _ioContext = &ioContext;
     _batchTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusLogger = overallStatusLogger;
     LoadFromConfigs();
+    sConfigMgr->AddReloadListener("Metric", [this]() { LoadFromConfigs(); });
 }
 
 bool Metric::Connect()
@@ -83,23 +173,32 @@ void Metric::LoadFromConfigs()
     if (_enabled && !previousValue)
     {
         std::string connectionInfo = sConfigMgr->GetStringDefault("Metric.ConnectionInfo", "");
-        if (connectionInfo.empty())
+        uint16 prometheusPort = uint16(sConfigMgr->GetIntDefault("Metric.Prometheus.Port", 0));
+        if (connectionInfo.empty() && !prometheusPort)
         {
             TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' not specified in configuration file.");
             return;
         }
 
-        std::vector<std::string_view> tokens = Trinity::Tokenize(connectionInfo, ';', true);
-        if (tokens.size() != 3)
+        // an empty connection info only serves the pull endpoint
+        _hostname.clear();
+        if (!connectionInfo.empty())
         {
-            TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' specified with wrong format in configuration file.");
-            return;
+            std::vector<std::string_view> tokens = Trinity::Tokenize(connectionInfo, ';', true);
+            if (tokens.size() != 3)
+            {
+                TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' specified with wrong format in configuration file.");
+                return;
+            }
+
+            _hostname.assign(tokens[0]);
+            _port.assign(tokens[1]);
+            _databaseName.assign(tokens[2]);
+            Connect();
         }
 
-        _hostname.assign(tokens[0]);
-        _port.assign(tokens[1]);
-        _databaseName.assign(tokens[2]);
-        Connect();
+        if (prometheusPort)
+            StartPrometheusEndpoint(sConfigMgr->GetStringDefault("Metric.Prometheus.BindIP", "127.0.0.1"), prometheusPort);
 
         ScheduleSend();
         ScheduleOverallStatusLog();
@@ -113,6 +212,9 @@ void Metric::Update()
         _overallStatusTimerTriggered = false;
         _overallStatusLogger();
     }
+
+    if (IsTracing() && std::chrono::steady_clock::now() >= _traceEndTime)
+        StopTrace();
 }
 
 bool Metric::ShouldLog(std::string const& category, int64 value) const
@@ -161,7 +263,7 @@ void Metric::SendBatch()
         switch (data->Type)
         {
             case METRIC_DATA_VALUE:
-                batchedData << "value=" << data->Value;
+                batchedData << "value=" << std::visit([](auto const& value) { return FormatInfluxDBValue(value); }, data->Value);
                 break;
             case METRIC_DATA_EVENT:
                 batchedData << "title=\"" << data->Title << "\",text=\"" << data->Text << "\"";
@@ -176,8 +278,13 @@ void Metric::SendBatch()
         delete data;
     }
 
-    // Check if there's any data to send
-    if (batchedData.tellp() == std::streampos(0))
+    if (!firstLoop)
+        batchedData << "\n";
+
+    WriteRegistryInfluxDB(batchedData, std::to_string(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count()));
+
+    // Check if there's any data to send, registered metrics are only scraped when no push database is configured
+    if (batchedData.tellp() == std::streampos(0) || _hostname.empty())
     {
         ScheduleSend();
         return;
@@ -226,6 +333,7 @@ void Metric::ScheduleSend()
     else
     {
         static_cast<boost::asio::ip::tcp::iostream&>(GetDataStream()).close();
+        StopPrometheusEndpoint();
         MetricData* data;
         // Clear the queue
         while (_queuedData.Dequeue(data))
@@ -233,6 +341,132 @@ void Metric::ScheduleSend()
     }
 }
 
+bool Metric::StartTrace(Seconds duration, std::string fileName)
+{
+    std::lock_guard<std::mutex> lock(_traceLock);
+    if (_tracing)
+        return false;
+
+    _traceEvents.clear();
+    _traceStartTime = std::chrono::steady_clock::now();
+    _traceEndTime = _traceStartTime + duration;
+    _traceFileName = std::move(fileName);
+    _tracing = true;
+    return true;
+}
+
+void Metric::RecordTraceEvent(std::string category, std::vector<MetricTag> tags, TimePoint start, TimePoint end)
+{
+    static std::atomic<uint32> NextThreadIndex(0);
+    thread_local uint32 const threadIndex = ++NextThreadIndex;
+
+    std::lock_guard<std::mutex> lock(_traceLock);
+    if (!_tracing || _traceEvents.size() >= MAX_TRACE_EVENTS)
+        return;
+
+    _traceEvents.push_back({ std::move(category), std::move(tags), start, end, threadIndex });
+}
+
+std::vector<MetricTraceEvent> Metric::CollectTrace()
+{
+    std::vector<MetricTraceEvent> events;
+    std::lock_guard<std::mutex> lock(_traceLock);
+    _tracing = false;
+    _traceFileName.clear();
+    events.swap(_traceEvents);
+    return events;
+}
+
+void Metric::StopTrace()
+{
+    std::vector<MetricTraceEvent> events;
+    std::string fileName;
+    TimePoint startTime;
+    {
+        std::lock_guard<std::mutex> lock(_traceLock);
+        if (!_tracing)
+            return;
+
+        _tracing = false;
+        events.swap(_traceEvents);
+        fileName = std::move(_traceFileName);
+        startTime = _traceStartTime;
+    }
+
+    TC_LOG_INFO("metric", "Metric trace finished with %u events, writing %s", uint32(events.size()), fileName.c_str());
+
+    // formatting a full trace takes a while, keep it off the world thread when possible
+    if (_ioContext)
+        Trinity::Asio::post(*_ioContext, [fileName, startTime, events]() { WriteTrace(fileName, startTime, events); });
+    else
+        WriteTrace(fileName, startTime, events);
+}
+
+void Metric::WriteTrace(std::string const& fileName, TimePoint startTime, std::vector<MetricTraceEvent> const& events)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        TC_LOG_ERROR("metric", "Metric::WriteTrace: Could not open %s for writing", fileName.c_str());
+        return;
+    }
+
+    auto writeString = [&file](std::string const& value)
+    {
+        file << '"';
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+                file << '\\' << c;
+            else if (uint8(c) < 0x20)
+                file << ' ';
+            else
+                file << c;
+        }
+        file << '"';
+    };
+
+    auto toMicroseconds = [startTime](TimePoint time)
+    {
+        return std::chrono::duration<double, std::micro>(time - startTime).count();
+    };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (MetricTraceEvent const& event : events)
+    {
+        if (!first)
+            file << ',';
+        first = false;
+
+        // scopes are named after their first tag when they have one ("world_update_time" + "Update sessions")
+        file << "\n{\"name\":";
+        writeString(event.Tags.empty() ? event.Category : event.Tags.front().second);
+        file << ",\"cat\":";
+        writeString(event.Category);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.ThreadIndex << ",\"ts\":" << toMicroseconds(event.Start)
+            << ",\"dur\":" << std::chrono::duration<double, std::micro>(event.End - event.Start).count();
+
+        if (!event.Tags.empty())
+        {
+            file << ",\"args\":{";
+            for (std::size_t i = 0; i < event.Tags.size(); ++i)
+            {
+                if (i)
+                    file << ',';
+                writeString(event.Tags[i].first);
+                file << ':';
+                writeString(event.Tags[i].second);
+            }
+            file << '}';
+        }
+
+        file << '}';
+    }
+
+    file << "\n]}\n";
+}
+
 void Metric::Unload()
 {
     // Send what's queued only if IoContext is stopped (so only on shutdown)
@@ -244,6 +478,189 @@ void Metric::Unload()
 
     _batchTimer->cancel();
     _overallStatusTimer->cancel();
+    StopPrometheusEndpoint();
+}
+
+MetricCounter& Metric::GetCounter(std::string const& name, std::vector<MetricTag> tags)
+{
+    std::lock_guard<std::mutex> lock(_registryLock);
+    std::unique_ptr<MetricCounter>& counter = _counters[{ name, std::move(tags) }];
+    if (!counter)
+        counter = std::make_unique<MetricCounter>();
+    return *counter;
+}
+
+MetricGauge& Metric::GetGauge(std::string const& name, std::vector<MetricTag> tags)
+{
+    std::lock_guard<std::mutex> lock(_registryLock);
+    std::unique_ptr<MetricGauge>& gauge = _gauges[{ name, std::move(tags) }];
+    if (!gauge)
+        gauge = std::make_unique<MetricGauge>();
+    return *gauge;
+}
+
+MetricHistogram& Metric::GetHistogram(std::string const& name, std::vector<int64> const& upperBounds, std::vector<MetricTag> tags)
+{
+    std::lock_guard<std::mutex> lock(_registryLock);
+    std::unique_ptr<MetricHistogram>& histogram = _histograms[{ name, std::move(tags) }];
+    if (!histogram)
+        histogram = std::make_unique<MetricHistogram>(upperBounds);
+    return *histogram;
+}
+
+void Metric::WriteRegistryInfluxDB(std::ostream& stream, std::string const& timestamp) const
+{
+    auto writeSeries = [&](std::string const& name, std::vector<MetricTag> const& tags, MetricTag const* extraTag)
+    {
+        stream << name;
+        if (!_realmName.empty())
+            stream << ",realm=" << _realmName;
+
+        for (MetricTag const& tag : tags)
+            stream << "," << tag.first << "=" << FormatInfluxDBTagValue(tag.second);
+
+        if (extraTag)
+            stream << "," << extraTag->first << "=" << extraTag->second;
+
+        stream << " value=";
+    };
+
+    std::lock_guard<std::mutex> lock(_registryLock);
+    for (auto const& [key, counter] : _counters)
+    {
+        writeSeries(key.first, key.second, nullptr);
+        stream << FormatInfluxDBValue(counter->GetValue()) << " " << timestamp << "\n";
+    }
+
+    for (auto const& [key, gauge] : _gauges)
+    {
+        writeSeries(key.first, key.second, nullptr);
+        stream << FormatInfluxDBValue(gauge->GetValue()) << " " << timestamp << "\n";
+    }
+
+    for (auto const& [key, histogram] : _histograms)
+    {
+        uint64 cumulative = 0;
+        for (std::size_t i = 0; i < histogram->GetBucketCount(); ++i)
+        {
+            cumulative += histogram->GetBucketValue(i);
+            MetricTag bound("le", i < histogram->GetUpperBounds().size() ? std::to_string(histogram->GetUpperBounds()[i]) : "inf");
+            writeSeries(key.first, key.second, &bound);
+            stream << FormatInfluxDBValue(cumulative) << " " << timestamp << "\n";
+        }
+
+        writeSeries(key.first + "_sum", key.second, nullptr);
+        stream << FormatInfluxDBValue(histogram->GetSum()) << " " << timestamp << "\n";
+    }
+}
+
+std::string Metric::FormatPrometheus() const
+{
+    std::ostringstream stream;
+    auto writeLabels = [&](std::vector<MetricTag> const& tags, MetricTag const* extraTag)
+    {
+        stream << "{realm=\"" << _realmLabel << '"';
+        for (MetricTag const& tag : tags)
+            stream << ',' << tag.first << "=\"" << FormatPrometheusLabelValue(tag.second) << '"';
+
+        if (extraTag)
+            stream << ',' << extraTag->first << "=\"" << extraTag->second << '"';
+
+        stream << "} ";
+    };
+
+    std::lock_guard<std::mutex> lock(_registryLock);
+    std::string const* lastName = nullptr;
+    auto writeType = [&](std::string const& name, char const* type)
+    {
+        if (!lastName || *lastName != name)
+            stream << "# TYPE " << name << ' ' << type << '\n';
+        lastName = &name;
+    };
+
+    for (auto const& [key, counter] : _counters)
+    {
+        writeType(key.first, "counter");
+        stream << key.first;
+        writeLabels(key.second, nullptr);
+        stream << counter->GetValue() << '\n';
+    }
+
+    lastName = nullptr;
+    for (auto const& [key, gauge] : _gauges)
+    {
+        writeType(key.first, "gauge");
+        stream << key.first;
+        writeLabels(key.second, nullptr);
+        stream << gauge->GetValue() << '\n';
+    }
+
+    lastName = nullptr;
+    for (auto const& [key, histogram] : _histograms)
+    {
+        writeType(key.first, "histogram");
+        uint64 cumulative = 0;
+        for (std::size_t i = 0; i < histogram->GetBucketCount(); ++i)
+        {
+            cumulative += histogram->GetBucketValue(i);
+            MetricTag bound("le", i < histogram->GetUpperBounds().size() ? std::to_string(histogram->GetUpperBounds()[i]) : "+Inf");
+            stream << key.first << "_bucket";
+            writeLabels(key.second, &bound);
+            stream << cumulative << '\n';
+        }
+
+        stream << key.first << "_sum";
+        writeLabels(key.second, nullptr);
+        stream << histogram->GetSum() << '\n';
+        stream << key.first << "_count";
+        writeLabels(key.second, nullptr);
+        stream << cumulative << '\n';
+    }
+
+    return stream.str();
+}
+
+void Metric::StartPrometheusEndpoint(std::string const& bindIp, uint16 port)
+{
+    if (_prometheusEndpoint || !_ioContext)
+        return;
+
+    boost::system::error_code errorCode;
+    boost::asio::ip::address address = Trinity::Net::make_address(bindIp, errorCode);
+    if (errorCode)
+    {
+        TC_LOG_ERROR("metric", "'Metric.Prometheus.BindIP' set to invalid address '%s'.", bindIp.c_str());
+        return;
+    }
+
+    std::shared_ptr<PrometheusEndpoint> endpoint = std::make_shared<PrometheusEndpoint>(*_ioContext);
+    boost::asio::ip::tcp::endpoint listenEndpoint(address, port);
+    endpoint->Acceptor.open(listenEndpoint.protocol(), errorCode);
+    if (!errorCode)
+        endpoint->Acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), errorCode);
+    if (!errorCode)
+        endpoint->Acceptor.bind(listenEndpoint, errorCode);
+    if (!errorCode)
+        endpoint->Acceptor.listen(boost::asio::socket_base::max_listen_connections, errorCode);
+
+    if (errorCode)
+    {
+        TC_LOG_ERROR("metric", "Failed to start Prometheus endpoint on %s:%u: %s", bindIp.c_str(), uint32(port), errorCode.message().c_str());
+        return;
+    }
+
+    endpoint->AsyncAccept();
+    _prometheusEndpoint = std::move(endpoint);
+}
+
+void Metric::StopPrometheusEndpoint()
+{
+    if (!_prometheusEndpoint)
+        return;
+
+    boost::system::error_code ignored;
+    _prometheusEndpoint->Acceptor.close(ignored);
+    _prometheusEndpoint.reset();
 }
 
 void Metric::ScheduleOverallStatusLog()
@@ -301,7 +718,7 @@ std::string Metric::FormatInfluxDBValue(std::chrono::nanoseconds value)
     return FormatInfluxDBValue(std::chrono::duration_cast<Milliseconds>(value).count());
 }
 
-Metric::Metric()
+Metric::Metric() : _tracing(false)
 {
 }
 
@@ -20,12 +20,18 @@
 
 #include "Define.h"
 #include "Duration.h"
+#include "MetricRegistry.h"
 #include "MPSCQueue.h"
+#include <atomic>
 #include <functional>
 #include <iosfwd>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 #include <utility>
 
@@ -46,6 +52,9 @@ enum MetricDataType
 
 typedef std::pair<std::string, std::string> MetricTag;
 
+// Raw logged value, only formatted when the batch is sent
+typedef std::variant<bool, int64, uint64, double, std::string, std::chrono::nanoseconds> MetricValue;
+
 struct MetricData
 {
     std::string Category;
@@ -54,13 +63,25 @@ struct MetricData
     std::vector<MetricTag> Tags;
 
     // LogValue-specific fields
-    std::string Value;
+    MetricValue Value;
 
     // LogEvent-specific fields
     std::string Title;
     std::string Text;
 };
 
+// Upper bound on the amount of scopes kept for a single trace; the rest of the window is dropped
+constexpr std::size_t MAX_TRACE_EVENTS = 1000000;
+
+struct MetricTraceEvent
+{
+    std::string Category;
+    std::vector<MetricTag> Tags;
+    TimePoint Start;
+    TimePoint End;
+    uint32 ThreadIndex;
+};
+
 class TC_COMMON_API Metric
 {
 private:
@@ -78,12 +99,52 @@ private:
     std::string _databaseName;
     std::function<void()> _overallStatusLogger;
     std::string _realmName;
+    std::string _realmLabel;
     std::unordered_map<std::string, int64> _thresholds;
+    Trinity::Asio::IoContext* _ioContext = nullptr;
+
+    typedef std::pair<std::string, std::vector<MetricTag>> RegistryKey;
+    mutable std::mutex _registryLock;
+    std::map<RegistryKey, std::unique_ptr<MetricCounter>> _counters;
+    std::map<RegistryKey, std::unique_ptr<MetricGauge>> _gauges;
+    std::map<RegistryKey, std::unique_ptr<MetricHistogram>> _histograms;
+
+    struct PrometheusEndpoint;
+    std::shared_ptr<PrometheusEndpoint> _prometheusEndpoint;
+
+    std::atomic<bool> _tracing;
+    std::mutex _traceLock;
+    std::vector<MetricTraceEvent> _traceEvents;
+    TimePoint _traceStartTime;
+    TimePoint _traceEndTime;
+    std::string _traceFileName;
 
     bool Connect();
     void SendBatch();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
+    void WriteRegistryInfluxDB(std::ostream& stream, std::string const& timestamp) const;
+    void StartPrometheusEndpoint(std::string const& bindIp, uint16 port);
+    void StopPrometheusEndpoint();
+    void StopTrace();
+    static void WriteTrace(std::string const& fileName, TimePoint startTime, std::vector<MetricTraceEvent> const& events);
+
+    template<class T>
+    static MetricValue MakeMetricValue(T value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return value;
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            return int64(value);
+        else if constexpr (std::is_integral_v<T>)
+            return uint64(value);
+        else if constexpr (std::is_floating_point_v<T>)
+            return double(value);
+        else if constexpr (std::is_convertible_v<T, std::string>)
+            return std::string(value);
+        else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(value);
+    }
 
     static std::string FormatInfluxDBValue(bool value);
     template <class T>
@@ -117,7 +178,7 @@ public:
         data->Category = category;
         data->Timestamp = system_clock::now();
         data->Type = METRIC_DATA_VALUE;
-        data->Value = FormatInfluxDBValue(value);
+        data->Value = MakeMetricValue(value);
         data->Tags = std::move(tags);
 
         _queuedData.Enqueue(data);
@@ -125,6 +186,21 @@ public:
 
     void LogEvent(std::string const& category, std::string const& title, std::string const& description);
 
+    // Registered metrics live until shutdown, callers are expected to keep the returned reference around
+    MetricCounter& GetCounter(std::string const& name, std::vector<MetricTag> tags = {});
+    MetricGauge& GetGauge(std::string const& name, std::vector<MetricTag> tags = {});
+    MetricHistogram& GetHistogram(std::string const& name, std::vector<int64> const& upperBounds, std::vector<MetricTag> tags = {});
+
+    /// Current state of all registered metrics in Prometheus text exposition format
+    std::string FormatPrometheus() const;
+
+    /// Records every timed scope for the given duration and writes them to fileName in Chrome trace event format
+    bool StartTrace(Seconds duration, std::string fileName);
+    /// Stops the current trace without writing it and returns the recorded events
+    std::vector<MetricTraceEvent> CollectTrace();
+    void RecordTraceEvent(std::string category, std::vector<MetricTag> tags, TimePoint start, TimePoint end);
+    bool IsTracing() const { return _tracing.load(std::memory_order_relaxed); }
+
     void Unload();
     bool IsEnabled() const { return _enabled; }
 };
@@ -138,13 +214,13 @@ class MetricStopWatch
 public:
     MetricStopWatch(LoggerType&& loggerFunc) :
         _logger(std::forward<LoggerType>(loggerFunc)),
-        _startTime(sMetric->IsEnabled() ? std::chrono::steady_clock::now() : TimePoint())
+        _startTime(sMetric->IsEnabled() || sMetric->IsTracing() ? std::chrono::steady_clock::now() : TimePoint())
     {
     }
 
     ~MetricStopWatch()
     {
-        if (sMetric->IsEnabled())
+        if (_startTime != TimePoint())
             _logger(_startTime);
     }
 
@@ -172,6 +248,7 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
 #define TC_METRIC_DETAILED_EVENT(category, title, description) ((void)0)
 #define TC_METRIC_DETAILED_TIMER(category, ...) ((void)0)
 #define TC_METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) ((void)0)
+#define TC_METRIC_TRACE_SCOPE(category, ...) ((void)0)
 #else
 #  if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
 #define TC_METRIC_EVENT(category, title, description)                  \
@@ -205,14 +282,27 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
 #define TC_METRIC_TIMER(category, ...)                                                                           \
         MetricStopWatch TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
         {                                                                                                        \
-            sMetric->LogValue(category, std::chrono::steady_clock::now() - start, { __VA_ARGS__ });              \
+            TimePoint end = std::chrono::steady_clock::now();                                                    \
+            if (sMetric->IsTracing())                                                                            \
+                sMetric->RecordTraceEvent(category, { __VA_ARGS__ }, start, end);                                \
+            if (sMetric->IsEnabled())                                                                            \
+                sMetric->LogValue(category, end - start, { __VA_ARGS__ });                                       \
+        });
+#define TC_METRIC_TRACE_SCOPE(category, ...)                                                                     \
+        MetricStopWatch TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
+        {                                                                                                        \
+            if (sMetric->IsTracing())                                                                            \
+                sMetric->RecordTraceEvent(category, { __VA_ARGS__ }, start, std::chrono::steady_clock::now());   \
         });
 #  if defined WITH_DETAILED_METRICS
 #define TC_METRIC_DETAILED_TIMER(category, ...)                                                                  \
         MetricStopWatch TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
         {                                                                                                        \
-            int64 duration = int64(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - start).count()); \
-            if (sMetric->ShouldLog(category, duration))                                                          \
+            TimePoint end = std::chrono::steady_clock::now();                                                    \
+            if (sMetric->IsTracing())                                                                            \
+                sMetric->RecordTraceEvent(category, { __VA_ARGS__ }, start, end);                                \
+            int64 duration = int64(std::chrono::duration_cast<Milliseconds>(end - start).count());               \
+            if (sMetric->IsEnabled() && sMetric->ShouldLog(category, duration))                                  \
                 sMetric->LogValue(category, duration, { __VA_ARGS__ });                                          \
         });
 #define TC_METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) TC_METRIC_TIMER(category, __VA_ARGS__)
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRIC_REGISTRY_H__
+#define METRIC_REGISTRY_H__
+
+#include "Define.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// Monotonically increasing value, safe to update from any thread
+class MetricCounter
+{
+public:
+    void Increment(uint64 value = 1) { _value.fetch_add(value, std::memory_order_relaxed); }
+    uint64 GetValue() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64> _value{ 0 };
+};
+
+/// Value that can go up and down, safe to update from any thread
+class MetricGauge
+{
+public:
+    void Set(int64 value) { _value.store(value, std::memory_order_relaxed); }
+    void Add(int64 value) { _value.fetch_add(value, std::memory_order_relaxed); }
+    int64 GetValue() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64> _value{ 0 };
+};
+
+/// Distribution of integer samples over fixed, inclusive upper bounds plus an unbounded overflow bucket
+class MetricHistogram
+{
+public:
+    explicit MetricHistogram(std::vector<int64> upperBounds) : _upperBounds(std::move(upperBounds)),
+        _buckets(std::make_unique<std::atomic<uint64>[]>(_upperBounds.size() + 1))
+    {
+        for (std::size_t i = 0; i <= _upperBounds.size(); ++i)
+            _buckets[i].store(0, std::memory_order_relaxed);
+    }
+
+    void Observe(int64 value)
+    {
+        std::size_t bucket = std::distance(_upperBounds.begin(), std::lower_bound(_upperBounds.begin(), _upperBounds.end(), value));
+        _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /// Adds samples that were already bucketed by the caller using the same bounds
+    void AddBucketCount(std::size_t bucket, uint64 count) { _buckets[std::min(bucket, _upperBounds.size())].fetch_add(count, std::memory_order_relaxed); }
+    void AddSum(int64 sum) { _sum.fetch_add(sum, std::memory_order_relaxed); }
+
+    std::vector<int64> const& GetUpperBounds() const { return _upperBounds; }
+    std::size_t GetBucketCount() const { return _upperBounds.size() + 1; }
+    uint64 GetBucketValue(std::size_t bucket) const { return _buckets[bucket].load(std::memory_order_relaxed); }
+    int64 GetSum() const { return _sum.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<int64> _upperBounds;
+    std::unique_ptr<std::atomic<uint64>[]> _buckets;
+    std::atomic<int64> _sum{ 0 };
+};
+
+#endif // METRIC_REGISTRY_H__
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InstrumentedMutex.h"
+#include "Metric.h"
+#include <map>
+#include <memory>
+
+#ifdef TRINITY_LOCK_PROFILING
+namespace
+{
+    // entries are never freed, mutexes may be destroyed during static destruction after anything else
+    std::mutex& GetEntriesLock()
+    {
+        static std::mutex* lock = new std::mutex();
+        return *lock;
+    }
+
+    std::map<std::string, std::unique_ptr<Trinity::LockProfiler::Entry>>& GetEntries()
+    {
+        static auto* entries = new std::map<std::string, std::unique_ptr<Trinity::LockProfiler::Entry>>();
+        return *entries;
+    }
+}
+
+Trinity::LockProfiler::Entry* Trinity::LockProfiler::Register(char const* name)
+{
+    std::lock_guard<std::mutex> lock(GetEntriesLock());
+    std::unique_ptr<Entry>& entry = GetEntries()[name];
+    if (!entry)
+        entry = std::make_unique<Entry>(name);
+
+    return entry.get();
+}
+#endif
+
+std::vector<Trinity::LockProfiler::Stats> Trinity::LockProfiler::GetStats()
+{
+    std::vector<Stats> stats;
+#ifdef TRINITY_LOCK_PROFILING
+    std::lock_guard<std::mutex> lock(GetEntriesLock());
+    stats.reserve(GetEntries().size());
+    for (auto const& [name, entry] : GetEntries())
+    {
+        stats.push_back({ name, entry->Acquisitions.load(std::memory_order_relaxed), entry->Contentions.load(std::memory_order_relaxed),
+            entry->WaitTime.load(std::memory_order_relaxed), entry->MaxWaitTime.load(std::memory_order_relaxed), entry->HoldTime.load(std::memory_order_relaxed) });
+    }
+#endif
+    return stats;
+}
+
+void Trinity::LockProfiler::Reset()
+{
+#ifdef TRINITY_LOCK_PROFILING
+    std::lock_guard<std::mutex> lock(GetEntriesLock());
+    for (auto const& [name, entry] : GetEntries())
+    {
+        entry->Acquisitions.store(0, std::memory_order_relaxed);
+        entry->Contentions.store(0, std::memory_order_relaxed);
+        entry->WaitTime.store(0, std::memory_order_relaxed);
+        entry->MaxWaitTime.store(0, std::memory_order_relaxed);
+        entry->HoldTime.store(0, std::memory_order_relaxed);
+    }
+#endif
+}
+
+void Trinity::LockProfiler::UpdateMetrics()
+{
+#ifdef TRINITY_LOCK_PROFILING
+    for (Stats const& stats : GetStats())
+    {
+        sMetric->GetGauge("lock_acquisitions", { TC_METRIC_TAG("lock", stats.Name) }).Set(int64(stats.Acquisitions));
+        sMetric->GetGauge("lock_contentions", { TC_METRIC_TAG("lock", stats.Name) }).Set(int64(stats.Contentions));
+        sMetric->GetGauge("lock_wait_ns", { TC_METRIC_TAG("lock", stats.Name) }).Set(int64(stats.WaitTime));
+        sMetric->GetGauge("lock_max_wait_ns", { TC_METRIC_TAG("lock", stats.Name) }).Set(int64(stats.MaxWaitTime));
+        sMetric->GetGauge("lock_hold_ns", { TC_METRIC_TAG("lock", stats.Name) }).Set(int64(stats.HoldTime));
+    }
+#endif
+}
@@ -0,0 +1,192 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_INSTRUMENTEDMUTEX_H
+#define TRINITY_INSTRUMENTEDMUTEX_H
+
+#include "Define.h"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#ifdef TRINITY_LOCK_PROFILING
+#include <chrono>
+#endif
+
+namespace Trinity
+{
+    // Lock contention statistics, aggregated per lock name (every InstanceSave player list shares one entry)
+    // Only collected when built with WITH_LOCK_PROFILING, otherwise the instrumented mutexes are plain std ones
+    class TC_COMMON_API LockProfiler
+    {
+    public:
+        struct Entry
+        {
+            explicit Entry(char const* name) : Name(name) { }
+
+            std::string const Name;
+            std::atomic<uint64> Acquisitions{ 0 };
+            std::atomic<uint64> Contentions{ 0 };   // lock() calls that had to wait, failed try_lock() calls
+            std::atomic<uint64> WaitTime{ 0 };      // nanoseconds
+            std::atomic<uint64> MaxWaitTime{ 0 };   // nanoseconds
+            std::atomic<uint64> HoldTime{ 0 };      // nanoseconds, exclusive ownership only
+        };
+
+        struct Stats
+        {
+            std::string Name;
+            uint64 Acquisitions;
+            uint64 Contentions;
+            uint64 WaitTime;
+            uint64 MaxWaitTime;
+            uint64 HoldTime;
+        };
+
+#ifdef TRINITY_LOCK_PROFILING
+        static constexpr bool IsEnabled() { return true; }
+        static Entry* Register(char const* name);
+#else
+        static constexpr bool IsEnabled() { return false; }
+#endif
+
+        static std::vector<Stats> GetStats();
+        static void Reset();
+
+        // copies every entry into the lock_* gauges of the metric registry
+        static void UpdateMetrics();
+    };
+
+#ifdef TRINITY_LOCK_PROFILING
+namespace Impl
+{
+    template<class Mutex>
+    class InstrumentedMutexBase
+    {
+        using Clock = std::chrono::steady_clock;
+
+    public:
+        explicit InstrumentedMutexBase(char const* name) : _entry(LockProfiler::Register(name)) { }
+
+        InstrumentedMutexBase(InstrumentedMutexBase const&) = delete;
+        InstrumentedMutexBase& operator=(InstrumentedMutexBase const&) = delete;
+
+        void lock()
+        {
+            if (!_mutex.try_lock())
+            {
+                Clock::time_point start = Clock::now();
+                _mutex.lock();
+                RecordWait(start);
+            }
+
+            _entry->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+            _lockedAt = Clock::now();
+        }
+
+        bool try_lock()
+        {
+            if (!_mutex.try_lock())
+            {
+                _entry->Contentions.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            _entry->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+            _lockedAt = Clock::now();
+            return true;
+        }
+
+        void unlock()
+        {
+            _entry->HoldTime.fetch_add(uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _lockedAt).count()), std::memory_order_relaxed);
+            _mutex.unlock();
+        }
+
+    protected:
+        void RecordWait(Clock::time_point start)
+        {
+            uint64 wait = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+            _entry->Contentions.fetch_add(1, std::memory_order_relaxed);
+            _entry->WaitTime.fetch_add(wait, std::memory_order_relaxed);
+
+            uint64 maxWait = _entry->MaxWaitTime.load(std::memory_order_relaxed);
+            while (wait > maxWait && !_entry->MaxWaitTime.compare_exchange_weak(maxWait, wait, std::memory_order_relaxed))
+                ;
+        }
+
+        Mutex _mutex;
+        LockProfiler::Entry* _entry;
+        Clock::time_point _lockedAt;
+    };
+}
+
+    class InstrumentedMutex : public Impl::InstrumentedMutexBase<std::mutex>
+    {
+    public:
+        explicit InstrumentedMutex(char const* name) : InstrumentedMutexBase(name) { }
+    };
+
+    class InstrumentedSharedMutex : public Impl::InstrumentedMutexBase<std::shared_mutex>
+    {
+    public:
+        explicit InstrumentedSharedMutex(char const* name) : InstrumentedMutexBase(name) { }
+
+        // shared owners are not timed, only their wait for a writer is
+        void lock_shared()
+        {
+            if (!_mutex.try_lock_shared())
+            {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                _mutex.lock_shared();
+                RecordWait(start);
+            }
+
+            _entry->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool try_lock_shared()
+        {
+            if (!_mutex.try_lock_shared())
+            {
+                _entry->Contentions.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            _entry->Acquisitions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        void unlock_shared() { _mutex.unlock_shared(); }
+    };
+#else
+    class InstrumentedMutex : public std::mutex
+    {
+    public:
+        explicit InstrumentedMutex(char const* /*name*/) { }
+    };
+
+    class InstrumentedSharedMutex : public std::shared_mutex
+    {
+    public:
+        explicit InstrumentedSharedMutex(char const* /*name*/) { }
+    };
+#endif
+}
+
+#endif // TRINITY_INSTRUMENTEDMUTEX_H
@@ -18,6 +18,7 @@
 #ifndef LOCKEDQUEUE_H
 #define LOCKEDQUEUE_H
 
+#include "InstrumentedMutex.h"
 #include <deque>
 #include <mutex>
 
@@ -25,7 +26,7 @@ template <class T, typename StorageType = std::deque<T> >
 class LockedQueue
 {
     //! Lock access to the queue.
-    std::mutex _lock;
+    Trinity::InstrumentedMutex _lock{ "LockedQueue" };
 
     //! Storage backing the queue.
     StorageType _queue;
@@ -60,14 +61,14 @@ public:
     template<class Iterator>
     void readd(Iterator begin, Iterator end)
     {
-        std::lock_guard<std::mutex> lock(_lock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_lock);
         _queue.insert(_queue.begin(), begin, end);
     }
 
     //! Gets the next result in the queue, if any.
     bool next(T& result)
     {
-        std::lock_guard<std::mutex> lock(_lock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_lock);
 
         if (_queue.empty())
             return false;
@@ -81,7 +82,7 @@ public:
     template<class Checker>
     bool next(T& result, Checker& check)
     {
-        std::lock_guard<std::mutex> lock(_lock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_lock);
 
         if (_queue.empty())
             return false;
@@ -110,7 +111,7 @@ public:
     //! Cancels the queue.
     void cancel()
     {
-        std::lock_guard<std::mutex> lock(_lock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_lock);
 
         _canceled = true;
     }
@@ -118,7 +119,7 @@ public:
     //! Checks if the queue is cancelled.
     bool cancelled()
     {
-        std::lock_guard<std::mutex> lock(_lock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_lock);
         return _canceled;
     }
 
@@ -137,14 +138,14 @@ public:
     ///! Calls pop_front of the queue
     void pop_front()
     {
-        std::lock_guard<std::mutex> lock(_lock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_lock);
         _queue.pop_front();
     }
 
     ///! Checks if we're empty or not with locks held
     bool empty()
     {
-        std::lock_guard<std::mutex> lock(_lock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_lock);
         return _queue.empty();
     }
 };
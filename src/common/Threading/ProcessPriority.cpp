@@ -16,7 +16,13 @@
  */
 
 #include "ProcessPriority.h"
+#include "Config.h"
 #include "Log.h"
+#include "StringConvert.h"
+#include "Util.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32 // Windows
 #include <Windows.h>
@@ -95,3 +101,72 @@ void SetProcessPriority(std::string const& logChannel, uint32 affinity, bool hig
     (void)highPriority;
 #endif
 }
+
+namespace
+{
+    // parses "0-3,8,10-11" into { 0, 1, 2, 3, 8, 10, 11 }
+    std::vector<uint32> ParseProcessorList(std::string const& list)
+    {
+        std::vector<uint32> processors;
+        for (std::string_view range : Trinity::Tokenize(list, ',', false))
+        {
+            std::vector<std::string_view> bounds = Trinity::Tokenize(range, '-', false);
+            Optional<uint32> first = bounds.empty() ? Optional<uint32>() : Trinity::StringTo<uint32>(bounds[0]);
+            Optional<uint32> last = bounds.size() == 2 ? Trinity::StringTo<uint32>(bounds[1]) : first;
+            if (!first || !last || bounds.size() > 2 || *first > *last)
+                return { };
+
+            for (uint32 processor = *first; processor <= *last; ++processor)
+                processors.push_back(processor);
+        }
+
+        return processors;
+    }
+}
+
+void SetCurrentThreadAffinity(std::string const& threadClassOption)
+{
+    std::string list = sConfigMgr->GetStringDefault(threadClassOption, "", true);
+    if (list.empty())
+        return;
+
+    std::vector<uint32> processors = ParseProcessorList(list);
+    if (processors.empty())
+    {
+        TC_LOG_ERROR("server", "%s: invalid processor list '%s', thread not pinned", threadClassOption.c_str(), list.c_str());
+        return;
+    }
+
+    uint32 processor;
+    {
+        static std::mutex threadCountersLock;
+        static std::unordered_map<std::string, std::size_t> threadCounters;
+
+        std::lock_guard<std::mutex> lock(threadCountersLock);
+        processor = processors[threadCounters[threadClassOption]++ % processors.size()];
+    }
+
+#ifdef _WIN32 // Windows
+
+    if (processor >= sizeof(DWORD_PTR) * 8 || !SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << processor))
+        TC_LOG_ERROR("server", "%s: can't pin thread to processor %u", threadClassOption.c_str(), processor);
+    else
+        TC_LOG_DEBUG("server", "%s: thread pinned to processor %u", threadClassOption.c_str(), processor);
+
+#elif defined(__linux__) // Linux
+
+    // memory first touched by this thread is then allocated from the NUMA node of that processor
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (processor < CPU_SETSIZE)
+        CPU_SET(processor, &mask);
+
+    if (processor >= CPU_SETSIZE || sched_setaffinity(0, sizeof(mask), &mask))
+        TC_LOG_ERROR("server", "%s: can't pin thread to processor %u, error: %s", threadClassOption.c_str(), processor, strerror(errno));
+    else
+        TC_LOG_DEBUG("server", "%s: thread pinned to processor %u", threadClassOption.c_str(), processor);
+
+#else
+    TC_LOG_ERROR("server", "%s: thread pinning is not supported on this platform (processor %u)", threadClassOption.c_str(), processor);
+#endif
+}
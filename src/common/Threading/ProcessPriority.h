@@ -26,4 +26,8 @@
 
 void TC_COMMON_API SetProcessPriority(std::string const& logChannel, uint32 affinity, bool highPriority);
 
+// Pins the calling thread to one processor out of the list in config option threadClassOption (for example "0-7,16-23")
+// Threads of the same class are spread round robin over the list, nothing is done when the option is empty
+void TC_COMMON_API SetCurrentThreadAffinity(std::string const& threadClassOption);
+
 #endif
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace Trinity
+{
+TaskGraph::TaskId TaskGraph::AddTask(std::string name, std::function<void()> task, std::initializer_list<TaskId> dependencies /*= {}*/)
+{
+    TaskId id = _tasks.size();
+    for (TaskId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "Task %s depends on a task that was not added yet", name.c_str());
+        _tasks[dependency].Dependents.push_back(id);
+    }
+
+    Task& newTask = _tasks.emplace_back();
+    newTask.Name = std::move(name);
+    newTask.Function = std::move(task);
+    newTask.PendingDependencies = uint32(dependencies.size());
+    return id;
+}
+
+void TaskGraph::Run(uint32 threadCount)
+{
+    // dependencies always point to earlier tasks so insertion order is a valid topological order
+    if (threadCount <= 1)
+    {
+        for (Task& task : _tasks)
+            task.Function();
+
+        _tasks.clear();
+        return;
+    }
+
+    std::mutex lock;
+    std::condition_variable condition;
+    std::queue<TaskId> ready;
+    std::size_t remaining = _tasks.size();
+
+    for (TaskId id = 0; id < _tasks.size(); ++id)
+        if (!_tasks[id].PendingDependencies)
+            ready.push(id);
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (remaining)
+        {
+            if (ready.empty())
+            {
+                condition.wait(guard);
+                continue;
+            }
+
+            TaskId id = ready.front();
+            ready.pop();
+
+            guard.unlock();
+            uint32 startTime = getMSTime();
+            _tasks[id].Function();
+            TC_LOG_DEBUG("misc", "TaskGraph: task '%s' finished in %u ms", _tasks[id].Name.c_str(), GetMSTimeDiffToNow(startTime));
+            guard.lock();
+
+            --remaining;
+            for (TaskId dependent : _tasks[id].Dependents)
+                if (!--_tasks[dependent].PendingDependencies)
+                    ready.push(dependent);
+
+            condition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (uint32 i = 1; i < std::min<std::size_t>(threadCount, _tasks.size()); ++i)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    _tasks.clear();
+}
+}
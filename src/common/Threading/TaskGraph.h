@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_TASK_GRAPH_H
+#define TRINITYCORE_TASK_GRAPH_H
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+/**
+    @class TaskGraph
+
+    @brief Runs a set of one-shot tasks on a pool of threads while respecting declared dependencies
+
+    Every task only starts after all tasks it depends on have finished. Tasks without a path
+    between them in the graph may run concurrently, so they must not touch the same data.
+    Dependencies can only refer to already added tasks, which keeps the graph acyclic.
+*/
+class TC_COMMON_API TaskGraph
+{
+public:
+    typedef std::size_t TaskId;
+
+    TaskGraph() = default;
+
+    TaskGraph(TaskGraph const&) = delete;
+    TaskGraph& operator=(TaskGraph const&) = delete;
+
+    TaskId AddTask(std::string name, std::function<void()> task, std::initializer_list<TaskId> dependencies = {});
+
+    //! Executes all tasks and blocks until they are finished. With threadCount <= 1 tasks run on the calling thread in the order they were added.
+    void Run(uint32 threadCount);
+
+private:
+    struct Task
+    {
+        std::string Name;
+        std::function<void()> Function;
+        std::vector<TaskId> Dependents;
+        uint32 PendingDependencies = 0;
+    };
+
+    std::vector<Task> _tasks;
+};
+}
+
+#endif // TRINITYCORE_TASK_GRAPH_H
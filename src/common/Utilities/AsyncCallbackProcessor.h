@@ -20,22 +20,62 @@
 
 #include "Define.h"
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+//! Counts results that arrived for callbacks of one AsyncCallbackProcessor since it last looked at them
+using AsyncCompletionListener = std::shared_ptr<std::atomic<uint32>>;
+
+//! Shared by an asynchronous operation and the callback waiting for its result.
+//! The thread producing the result notifies it, waking the processor that currently owns the callback.
+class AsyncCompletionSignal
+{
+public:
+    void Notify()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _completed = true;
+        if (_listener)
+            _listener->fetch_add(1, std::memory_order_release);
+    }
+
+    void Listen(AsyncCompletionListener listener)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _listener = std::move(listener);
+        if (_completed && _listener)
+            _listener->fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    std::mutex _lock;
+    bool _completed = false;
+    AsyncCompletionListener _listener;
+};
+
 //template <class T>
-//concept AsyncCallback = requires(T t) { { t.InvokeIfReady() } -> std::convertible_to<bool> };
+//concept AsyncCallback = requires(T t, AsyncCompletionListener const& listener)
+//{
+//    { t.InvokeIfReady() } -> std::convertible_to<bool>;
+//    { t.HasCompletionSignal() } -> std::convertible_to<bool>;
+//    t.SetCompletionListener(listener);
+//};
 
 template<typename T> // requires AsyncCallback<T>
 class AsyncCallbackProcessor
 {
 public:
-    AsyncCallbackProcessor() = default;
+    AsyncCallbackProcessor() : _completions(std::make_shared<std::atomic<uint32>>(0)) { }
     ~AsyncCallbackProcessor() = default;
 
     T& AddCallback(T&& query)
     {
         _callbacks.emplace_back(std::move(query));
-        return _callbacks.back();
+        T& callback = _callbacks.back();
+        callback.SetCompletionListener(_completions);
+        return callback;
     }
 
     void ProcessReadyCallbacks()
@@ -43,14 +83,29 @@ public:
         if (_callbacks.empty())
             return;
 
+        // no result arrived since the last pass, none of the callbacks can make progress
+        if (!_completions->exchange(0, std::memory_order_acquire))
+            return;
+
         std::vector<T> updateCallbacks{ std::move(_callbacks) };
+        bool keepPolling = false;
 
-        updateCallbacks.erase(std::remove_if(updateCallbacks.begin(), updateCallbacks.end(), [](T& callback)
+        updateCallbacks.erase(std::remove_if(updateCallbacks.begin(), updateCallbacks.end(), [&keepPolling](T& callback)
         {
-            return callback.InvokeIfReady();
+            if (callback.InvokeIfReady())
+                return true;
+
+            // nothing will wake us up for callbacks without a signal, look at them again next time
+            if (!callback.HasCompletionSignal())
+                keepPolling = true;
+
+            return false;
         }), updateCallbacks.end());
 
         _callbacks.insert(_callbacks.end(), std::make_move_iterator(updateCallbacks.begin()), std::make_move_iterator(updateCallbacks.end()));
+
+        if (keepPolling)
+            _completions->fetch_add(1, std::memory_order_relaxed);
     }
 
 private:
@@ -58,6 +113,7 @@ private:
     AsyncCallbackProcessor& operator=(AsyncCallbackProcessor const&) = delete;
 
     std::vector<T> _callbacks;
+    AsyncCompletionListener _completions;
 };
 
 #endif // AsyncCallbackProcessor_h__
@@ -17,6 +17,7 @@
 
 #include "EventMap.h"
 #include "Random.h"
+#include <algorithm>
 
 void EventMap::Reset()
 {
@@ -41,7 +42,7 @@ void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*=
     if (phase && phase <= 8)
         eventId |= (1 << (phase + 23));
 
-    _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    Insert(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds minTime, Milliseconds maxTime, uint32 group /*= 0*/, uint8 phase /*= 0*/)
@@ -62,7 +63,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::Repeat(Milliseconds time)
 {
-    _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+    Insert(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds minTime, Milliseconds maxTime)
@@ -74,17 +75,17 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        EventStore::iterator itr = _eventMap.begin();
+        EventStore::value_type const& next = _eventMap.back();
 
-        if (itr->first > _time)
+        if (next.first > _time)
             return 0;
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-            _eventMap.erase(itr);
+        else if (_phase && (next.second & 0xFF000000) && !((next.second >> 24) & _phase))
+            _eventMap.pop_back();
         else
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second; // include phase/group
-            _eventMap.erase(itr);
+            uint32 eventId = (next.second & 0x0000FFFF);
+            _lastEvent = next.second; // include phase/group
+            _eventMap.pop_back();
             return eventId;
         }
     }
@@ -97,13 +98,8 @@ void EventMap::DelayEvents(Milliseconds delay)
     if (Empty())
         return;
 
-    EventStore delayed = std::move(_eventMap);
-    for (EventStore::iterator itr = delayed.begin(); itr != delayed.end();)
-    {
-        EventStore::node_type node = delayed.extract(itr++);
-        node.key() = node.key() + delay;
-        _eventMap.insert(_eventMap.end(), std::move(node));
-    }
+    for (EventStore::value_type& event : _eventMap)
+        event.first += delay;
 }
 
 void EventMap::DelayEvents(Milliseconds delay, uint32 group)
@@ -113,18 +109,21 @@ void EventMap::DelayEvents(Milliseconds delay, uint32 group)
 
     EventStore delayed;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
+    // walk from the back to collect delayed events in execution order
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
         if (itr->second & (1 << (group + 15)))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            _eventMap.erase(itr++);
-        }
-        else
-            ++itr;
-    }
+            delayed.emplace_back(itr->first + delay, itr->second);
+
+    if (delayed.empty())
+        return;
+
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [group](EventStore::value_type const& event)
+    {
+        return (event.second & (1 << (group + 15))) != 0;
+    }), _eventMap.end());
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    for (EventStore::value_type const& event : delayed)
+        Insert(event.first, event.second);
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -132,13 +131,10 @@ void EventMap::CancelEvent(uint32 eventId)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [eventId](EventStore::value_type const& event)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return eventId == (event.second & 0x0000FFFF);
+    }), _eventMap.end());
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -146,20 +142,28 @@ void EventMap::CancelEventGroup(uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [group](EventStore::value_type const& event)
     {
-        if (itr->second & (1 << (group + 15)))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return (event.second & (1 << (group + 15))) != 0;
+    }), _eventMap.end());
 }
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<TimePoint const, uint32> const& itr : _eventMap)
-        if (eventId == (itr.second & 0x0000FFFF))
-            return std::chrono::duration_cast<Milliseconds>(itr.first - _time);
+    // search from the back to find the earliest occurrence
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == (itr->second & 0x0000FFFF))
+            return std::chrono::duration_cast<Milliseconds>(itr->first - _time);
 
     return Milliseconds::max();
 }
+
+void EventMap::Insert(TimePoint time, uint32 data)
+{
+    // first element not later than the new one, everything behind it executes before the new event
+    auto itr = std::lower_bound(_eventMap.begin(), _eventMap.end(), time, [](EventStore::value_type const& event, TimePoint value)
+    {
+        return event.first > value;
+    });
+    _eventMap.emplace(itr, time, data);
+}
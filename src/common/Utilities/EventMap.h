@@ -20,22 +20,28 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <boost/container/small_vector.hpp>
+#include <utility>
 
 class TC_COMMON_API EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * First: Time as TimePoint when the event should occur.
+    * Second: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
     * - Bit 16 - 23: Group
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
+    *
+    * Sorted by descending time, the next event to occur is at the back.
+    * Events with equal time are stored in reverse scheduling order so they
+    * still execute in the order they were scheduled. Typical scripts fit
+    * into the inline capacity and never allocate.
     */
-    typedef std::multimap<TimePoint, uint32> EventStore;
+    typedef boost::container::small_vector<std::pair<TimePoint, uint32>, 8> EventStore;
 
 public:
     EventMap() : _time(TimePoint::min()), _phase(0), _lastEvent(0) { }
@@ -248,9 +254,15 @@ private:
     */
     uint8 _phase;
 
+    /**
+    * @name Insert
+    * @brief Inserts event data after all events scheduled for the same or an earlier time.
+    */
+    void Insert(TimePoint time, uint32 data);
+
     /**
     * @name _eventMap
-    * @brief Internal event storage map. Contains the scheduled events.
+    * @brief Internal event storage. Contains the scheduled events.
     *
     * See typedef at the beginning of the class for more
     * details.
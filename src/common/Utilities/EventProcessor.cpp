@@ -17,6 +17,7 @@
 
 #include "EventProcessor.h"
 #include "Errors.h"
+#include <algorithm>
 
 void BasicEvent::ScheduleAbort()
 {
@@ -43,12 +44,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    std::multimap<uint64, BasicEvent*>::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front().ExecTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        std::pop_heap(m_events.begin(), m_events.end(), QueuedEventLater());
+        BasicEvent* event = m_events.back().Event;
+        m_events.pop_back();
 
         if (event->IsRunning())
         {
@@ -81,33 +82,40 @@ void EventProcessor::Update(uint32 p_time)
 
 void EventProcessor::KillAllEvents(bool force)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    // Abort handlers may queue new events, work on a detached copy of the queue
+    std::vector<QueuedEvent> events;
+    std::vector<QueuedEvent> kept;
+    do
     {
-        // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
-        {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
-        }
+        events.clear();
+        events.swap(m_events);
 
-        // Skip non-deletable events when we are
-        // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
+        for (QueuedEvent const& queued : events)
         {
-            ++itr;
-            continue;
-        }
+            // Abort events which weren't aborted already
+            if (!queued.Event->IsAborted())
+            {
+                queued.Event->SetAborted();
+                queued.Event->Abort(m_time);
+            }
 
-        delete itr->second;
+            // Skip non-deletable events when we are
+            // not forcing the event cancellation.
+            if (!force && !queued.Event->IsDeletable())
+            {
+                kept.push_back(queued);
+                continue;
+            }
 
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
-    }
+            delete queued.Event;
+        }
+    } while (force && !m_events.empty()); // Clear the whole container when forcing
 
-    if (force)
-        m_events.clear();
+    if (!kept.empty())
+    {
+        m_events.insert(m_events.end(), kept.begin(), kept.end());
+        std::make_heap(m_events.begin(), m_events.end(), QueuedEventLater());
+    }
 }
 
 void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_addtime)
@@ -115,19 +123,23 @@ void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_a
     if (set_addtime)
         event->m_addTime = m_time;
     event->m_execTime = e_time.count();
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time.count(), event));
+    QueueEvent(event, e_time.count());
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != event)
-            continue;
+    auto itr = std::find_if(m_events.begin(), m_events.end(), [event](QueuedEvent const& queued) { return queued.Event == event; });
+    if (itr == m_events.end())
+        return;
+
+    event->m_execTime = newTime.count();
+    m_events.erase(itr);
+    std::make_heap(m_events.begin(), m_events.end(), QueuedEventLater());
+    QueueEvent(event, newTime.count());
+}
 
-        event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime.count(), event));
-        break;
-    }
+void EventProcessor::QueueEvent(BasicEvent* event, uint64 execTime)
+{
+    m_events.push_back({ execTime, m_sequence++, event });
+    std::push_heap(m_events.begin(), m_events.end(), QueuedEventLater());
 }
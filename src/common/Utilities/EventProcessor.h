@@ -22,8 +22,8 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
 #include <type_traits>
+#include <vector>
 
 class EventProcessor;
 
@@ -94,7 +94,14 @@ using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::rem
 class TC_COMMON_API EventProcessor
 {
     public:
-        EventProcessor() : m_time(0) { }
+        struct QueuedEvent
+        {
+            uint64 ExecTime;
+            uint64 Sequence;                                // keeps events with equal ExecTime in the order they were added
+            BasicEvent* Event;
+        };
+
+        EventProcessor() : m_time(0), m_sequence(0) { }
         ~EventProcessor();
 
         void Update(uint32 p_time);
@@ -111,11 +118,26 @@ class TC_COMMON_API EventProcessor
         is_lambda_event<T> AddEventAtOffset(T&& event, Milliseconds offset, Milliseconds offset2) { AddEventAtOffset(new LambdaBasicEvent<T>(std::move(event)), offset, offset2); }
         void ModifyEventTime(BasicEvent* event, Milliseconds newTime);
         Milliseconds CalculateTime(Milliseconds t_offset) const { return Milliseconds(m_time) + t_offset; }
-        std::multimap<uint64, BasicEvent*> const& GetEvents() const { return m_events; }
+        // queued events in heap order (not sorted by execution time)
+        std::vector<QueuedEvent> const& GetEvents() const { return m_events; }
 
     protected:
+        struct QueuedEventLater
+        {
+            bool operator()(QueuedEvent const& left, QueuedEvent const& right) const
+            {
+                if (left.ExecTime != right.ExecTime)
+                    return left.ExecTime > right.ExecTime;
+                return left.Sequence > right.Sequence;
+            }
+        };
+
+        void QueueEvent(BasicEvent* event, uint64 execTime);
+
         uint64 m_time;
-        std::multimap<uint64, BasicEvent*> m_events;
+        uint64 m_sequence;
+        // binary min-heap on (ExecTime, Sequence), one contiguous allocation instead of a tree node per event
+        std::vector<QueuedEvent> m_events;
 };
 
 #endif
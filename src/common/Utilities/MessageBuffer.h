@@ -19,6 +19,7 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
+#include <array>
 #include <vector>
 #include <cstring>
 
@@ -26,6 +27,77 @@ class MessageBuffer
 {
     typedef std::vector<uint8>::size_type size_type;
 
+    // Recycles storage of buffers that went through the write queue
+    // Buffers are built and sent on the same network thread so pools are kept per thread and need no locking
+    class StoragePool
+    {
+    public:
+        static constexpr size_type MinPooledSize = 4096;
+        static constexpr size_type SizeClasses = 5;         // 4 KiB .. 64 KiB
+        static constexpr size_type MaxPooledPerClass = 32;
+
+        static StoragePool& Instance()
+        {
+            static thread_local StoragePool pool;
+            return pool;
+        }
+
+        std::vector<uint8> Acquire(size_type bytes)
+        {
+            size_type sizeClass = GetSizeClassForRequest(bytes);
+            if (sizeClass < SizeClasses && !_free[sizeClass].empty())
+            {
+                std::vector<uint8> storage = std::move(_free[sizeClass].back());
+                _free[sizeClass].pop_back();
+                storage.resize(bytes);
+                return storage;
+            }
+
+            std::vector<uint8> storage;
+            if (sizeClass < SizeClasses)
+                storage.reserve(MinPooledSize << sizeClass);
+
+            storage.resize(bytes);
+            return storage;
+        }
+
+        void Release(std::vector<uint8>&& storage)
+        {
+            size_type sizeClass = GetSizeClassForCapacity(storage.capacity());
+            if (sizeClass >= SizeClasses || _free[sizeClass].size() >= MaxPooledPerClass)
+                return;
+
+            storage.clear();
+            _free[sizeClass].push_back(std::move(storage));
+        }
+
+    private:
+        // smallest class that can hold the request
+        static size_type GetSizeClassForRequest(size_type bytes)
+        {
+            size_type sizeClass = 0;
+            while (sizeClass < SizeClasses && (MinPooledSize << sizeClass) < bytes)
+                ++sizeClass;
+
+            return sizeClass;
+        }
+
+        // largest class fully covered by the capacity
+        static size_type GetSizeClassForCapacity(size_type capacity)
+        {
+            if (capacity < MinPooledSize)
+                return SizeClasses;
+
+            size_type sizeClass = 0;
+            while (sizeClass + 1 < SizeClasses && (MinPooledSize << (sizeClass + 1)) <= capacity)
+                ++sizeClass;
+
+            return sizeClass;
+        }
+
+        std::array<std::vector<std::vector<uint8>>, SizeClasses> _free;
+    };
+
 public:
     MessageBuffer() : _wpos(0), _rpos(0), _storage()
     {
@@ -43,6 +115,23 @@ public:
 
     MessageBuffer(MessageBuffer&& right) : _wpos(right._wpos), _rpos(right._rpos), _storage(right.Move()) { }
 
+    //! Creates a buffer of initialSize bytes reusing storage from the calling thread's pool
+    static MessageBuffer FromPool(std::size_t initialSize)
+    {
+        MessageBuffer buffer(0);
+        buffer._storage = StoragePool::Instance().Acquire(initialSize);
+        return buffer;
+    }
+
+    //! Hands the storage back to the calling thread's pool, leaves the buffer empty
+    void ReturnToPool()
+    {
+        _wpos = 0;
+        _rpos = 0;
+        StoragePool::Instance().Release(std::move(_storage));
+        _storage = std::vector<uint8>();
+    }
+
     void Reset()
     {
         _wpos = 0;
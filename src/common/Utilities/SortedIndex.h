@@ -0,0 +1,130 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SORTEDINDEX_H
+#define TRINITY_SORTEDINDEX_H
+
+#include "Define.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace Trinity
+{
+namespace Impl
+{
+    /*
+     * Read only lookup table for data that is filled once at startup and then only queried (DB2 secondary indexes).
+     * Entries are appended unsorted with insert/emplace and Build() sorts them by key into one contiguous array,
+     * lookups are binary searches over it. Compared to std::unordered_map/multimap this drops the per element
+     * node allocation and all values of one key end up next to each other.
+     *
+     * Exposes the subset of the std map interface used with Trinity::Containers::MapGetValuePtr and MapEqualRange.
+     * Lookups before Build() are not allowed.
+     */
+    template<class Key, class Value, bool UniqueKeys>
+    class SortedIndexTable
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+        using iterator = const_iterator;
+
+        void insert(value_type const& value) { _entries.push_back(value); }
+
+        template<class... Args>
+        void emplace(Args&&... args) { _entries.emplace_back(std::forward<Args>(args)...); }
+
+        // sorts the entries by key, values of the same key keep their insertion order
+        // with unique keys only the value inserted last for each key is kept, like repeated map[key] = value assignments
+        void Build()
+        {
+            std::stable_sort(_entries.begin(), _entries.end(), [](value_type const& left, value_type const& right) { return left.first < right.first; });
+
+            if constexpr (UniqueKeys)
+            {
+                auto last = _entries.begin();
+                for (auto itr = _entries.begin(); itr != _entries.end(); ++itr)
+                {
+                    if (last != _entries.begin() && std::prev(last)->first == itr->first)
+                        *std::prev(last) = std::move(*itr);
+                    else
+                    {
+                        if (last != itr)
+                            *last = std::move(*itr);
+                        ++last;
+                    }
+                }
+
+                _entries.erase(last, _entries.end());
+            }
+
+            _entries.shrink_to_fit();
+        }
+
+        const_iterator begin() const { return _entries.begin(); }
+        const_iterator end() const { return _entries.end(); }
+
+        bool empty() const { return _entries.empty(); }
+        size_type size() const { return _entries.size(); }
+
+        const_iterator find(Key const& key) const
+        {
+            const_iterator itr = LowerBound(key);
+            return itr != _entries.end() && itr->first == key ? itr : _entries.end();
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(Key const& key) const
+        {
+            const_iterator first = LowerBound(key);
+            const_iterator last = first;
+            while (last != _entries.end() && last->first == key)
+                ++last;
+
+            return { first, last };
+        }
+
+        size_type count(Key const& key) const
+        {
+            std::pair<const_iterator, const_iterator> range = equal_range(key);
+            return size_type(std::distance(range.first, range.second));
+        }
+
+    private:
+        const_iterator LowerBound(Key const& key) const
+        {
+            return std::lower_bound(_entries.begin(), _entries.end(), key, [](value_type const& entry, Key const& value) { return entry.first < value; });
+        }
+
+        std::vector<value_type> _entries;
+    };
+}
+
+    /// Sorted replacement for std::unordered_map filled once at load, see Impl::SortedIndexTable
+    template<class Key, class Value>
+    using SortedIndex = Impl::SortedIndexTable<Key, Value, true>;
+
+    /// Sorted replacement for std::unordered_multimap filled once at load, see Impl::SortedIndexTable
+    template<class Key, class Value>
+    using SortedMultiIndex = Impl::SortedIndexTable<Key, Value, false>;
+}
+
+#endif // TRINITY_SORTEDINDEX_H
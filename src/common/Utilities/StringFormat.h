@@ -22,6 +22,9 @@
 
 namespace Trinity
 {
+    /// Stack buffer for formatting temporary strings (ad-hoc SQL, chat messages), only allocates when the result is longer
+    using FormatBuffer = fmt::basic_memory_buffer<char, 500>;
+
     /// Default TC string format function.
     template<typename Format, typename... Args>
     inline std::string StringFormat(Format&& fmt, Args&&... args)
@@ -37,6 +40,39 @@ namespace Trinity
         }
     }
 
+    /// Printf-style formatting like StringFormat, but into buffer instead of a new std::string.
+    /// Returns the null terminated result, valid until buffer is modified or destroyed.
+    template<typename Format, typename... Args>
+    inline char const* StringFormatTo(FormatBuffer& buffer, Format&& fmt, Args&&... args)
+    {
+        buffer.clear();
+        try
+        {
+            fmt::vprintf(buffer, fmt::to_string_view(fmt), fmt::basic_format_args<fmt::printf_context>(fmt::make_format_args<fmt::printf_context>(args...)));
+        }
+        catch (const fmt::format_error& formatError)
+        {
+            std::string error = "An error occurred formatting string \"" + std::string(fmt) + "\" : " + std::string(formatError.what());
+            buffer.clear();
+            buffer.append(error.data(), error.data() + error.size());
+        }
+
+        buffer.push_back('\0');
+        return buffer.data();
+    }
+
+    /// {}-style formatting into buffer with the format string checked at compile time, use as FormatTo(buffer, FMT_STRING("..."), args...)
+    /// Returns the null terminated result, valid until buffer is modified or destroyed.
+    template<typename Format, typename... Args>
+    inline char const* FormatTo(FormatBuffer& buffer, Format const& fmt, Args&&... args)
+    {
+        static_assert(fmt::is_compile_string<Format>::value, "Trinity::FormatTo requires a format string wrapped in FMT_STRING");
+        buffer.clear();
+        fmt::format_to(buffer, fmt, std::forward<Args>(args)...);
+        buffer.push_back('\0');
+        return buffer.data();
+    }
+
     /// Returns true if the given char pointer is null.
     inline bool IsFormatEmptyOrNull(char const* fmt)
     {
@@ -0,0 +1,181 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TIMINGWHEEL_H
+#define TRINITY_TIMINGWHEEL_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace Trinity
+{
+    /*
+     * Single level timing wheel used in place of a std::multimap<time, T> for timers that are scheduled and
+     * expired at high rates (map scripts). Scheduling is O(1): the element goes to the slot covering its due
+     * time, or to an overflow list when it is more than one revolution away. Overflow elements are moved into
+     * the wheel each time the cursor wraps, so every one of them is looked at once per revolution.
+     *
+     * Elements live in a pooled array reused through a free list, slots only hold indices into it.
+     * PopDue returns due elements ordered by due time, elements due at the same time keep their scheduling order.
+     */
+    template<class T, uint32 SlotMilliseconds = 10, uint32 SlotCount = 512>
+    class TimingWheel
+    {
+        static constexpr Milliseconds SlotDuration = Milliseconds(SlotMilliseconds);
+        static constexpr Milliseconds Revolution = Milliseconds(SlotMilliseconds * SlotCount);
+
+    public:
+        TimingWheel() : _cursor(0), _size(0), _nextSequence(0) { }
+
+        bool empty() const { return _size == 0; }
+        std::size_t size() const { return _size; }
+
+        void Schedule(T const& value, TimePoint now, Milliseconds delay)
+        {
+            // nothing pending, restart the wheel at the current time instead of walking through the idle period
+            if (!_size)
+            {
+                _cursor = 0;
+                _cursorTime = now;
+            }
+
+            uint32 index;
+            if (!_freeEntries.empty())
+            {
+                index = _freeEntries.back();
+                _freeEntries.pop_back();
+            }
+            else
+            {
+                index = uint32(_entries.size());
+                _entries.emplace_back();
+            }
+
+            Entry& entry = _entries[index];
+            entry.Value = value;
+            entry.Due = now + delay;
+            entry.Sequence = _nextSequence++;
+            ++_size;
+
+            Place(index);
+        }
+
+        // appends all elements due at or before now to due (cleared first), returns false if there are none
+        bool PopDue(TimePoint now, std::vector<T>& due)
+        {
+            due.clear();
+            if (!_size)
+                return false;
+
+            _dueEntries.clear();
+            for (;;)
+            {
+                std::vector<uint32>& slot = _slots[_cursor];
+                for (std::size_t i = 0; i < slot.size();)
+                {
+                    if (_entries[slot[i]].Due <= now)
+                    {
+                        _dueEntries.push_back(slot[i]);
+                        slot[i] = slot.back();
+                        slot.pop_back();
+                    }
+                    else
+                        ++i;
+                }
+
+                // the current slot still covers now, later slots are not due yet
+                if (_cursorTime + SlotDuration > now || _dueEntries.size() == _size)
+                    break;
+
+                _cursor = (_cursor + 1) % SlotCount;
+                _cursorTime += SlotDuration;
+                if (!_cursor)
+                    Cascade();
+            }
+
+            std::sort(_dueEntries.begin(), _dueEntries.end(), [this](uint32 left, uint32 right)
+            {
+                Entry const& l = _entries[left];
+                Entry const& r = _entries[right];
+                if (l.Due != r.Due)
+                    return l.Due < r.Due;
+                return l.Sequence < r.Sequence;
+            });
+
+            due.reserve(_dueEntries.size());
+            for (uint32 index : _dueEntries)
+            {
+                due.push_back(std::move(_entries[index].Value));
+                _entries[index].Value = T();
+                _freeEntries.push_back(index);
+            }
+
+            _size -= _dueEntries.size();
+            return !due.empty();
+        }
+
+    private:
+        struct Entry
+        {
+            T Value;
+            TimePoint Due;
+            uint64 Sequence = 0;
+        };
+
+        void Place(uint32 index)
+        {
+            Milliseconds offset = std::chrono::duration_cast<Milliseconds>(_entries[index].Due - _cursorTime);
+            if (offset < SlotDuration)                  // overdue elements go to the current slot too
+                _slots[_cursor].push_back(index);
+            else if (offset < Revolution)
+                _slots[(_cursor + uint32(offset / SlotDuration)) % SlotCount].push_back(index);
+            else
+                _overflow.push_back(index);
+        }
+
+        void Cascade()
+        {
+            for (std::size_t i = 0; i < _overflow.size();)
+            {
+                uint32 index = _overflow[i];
+                if (_entries[index].Due - _cursorTime < Revolution)
+                {
+                    _overflow[i] = _overflow.back();
+                    _overflow.pop_back();
+                    Place(index);
+                }
+                else
+                    ++i;
+            }
+        }
+
+        std::vector<Entry> _entries;
+        std::vector<uint32> _freeEntries;
+        std::array<std::vector<uint32>, SlotCount> _slots;
+        std::vector<uint32> _overflow;
+        std::vector<uint32> _dueEntries;
+        TimePoint _cursorTime;
+        uint32 _cursor;
+        std::size_t _size;
+        uint64 _nextSequence;
+    };
+}
+
+#endif // TRINITY_TIMINGWHEEL_H
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TRANSIENTOBJECTPOOL_H
+#define TRINITY_TRANSIENTOBJECTPOOL_H
+
+#include "Define.h"
+#include <array>
+#include <new>
+#include <vector>
+
+namespace Trinity
+{
+    // Recycles memory of short lived objects (spells, auras, summons, ...) that are created and destroyed at high rates by map threads
+    // Blocks are grouped in size classes and kept per thread so no locking is needed, a block freed on another thread
+    // than the one that allocated it simply ends up in the free list of the freeing thread
+    class TransientObjectPool
+    {
+    public:
+        static constexpr std::size_t Granularity = 64;
+        static constexpr std::size_t SizeClasses = 512;          // up to 32 KiB, creatures are close to 19 KiB
+        static constexpr std::size_t MaxPooledPerClass = 512;    // hard limit, checked on every release
+        static constexpr std::size_t RetainedPerClass = 128;     // kept by Trim()
+
+        TransientObjectPool() = default;
+        TransientObjectPool(TransientObjectPool const&) = delete;
+        TransientObjectPool& operator=(TransientObjectPool const&) = delete;
+
+        ~TransientObjectPool()
+        {
+            for (std::vector<void*>& blocks : _free)
+                for (void* block : blocks)
+                    ::operator delete(block);
+        }
+
+        static TransientObjectPool& Instance()
+        {
+            static thread_local TransientObjectPool pool;
+            return pool;
+        }
+
+        void* Allocate(std::size_t size)
+        {
+            std::size_t sizeClass = GetSizeClass(size);
+            if (sizeClass >= SizeClasses)
+                return ::operator new(size);
+
+            std::vector<void*>& blocks = _free[sizeClass];
+            if (blocks.empty())
+                return ::operator new((sizeClass + 1) * Granularity);
+
+            void* block = blocks.back();
+            blocks.pop_back();
+            return block;
+        }
+
+        void Deallocate(void* block, std::size_t size)
+        {
+            if (!block)
+                return;
+
+            std::size_t sizeClass = GetSizeClass(size);
+            if (sizeClass >= SizeClasses || _free[sizeClass].size() >= MaxPooledPerClass)
+            {
+                ::operator delete(block);
+                return;
+            }
+
+            _free[sizeClass].push_back(block);
+        }
+
+        // returns blocks above RetainedPerClass to the system allocator, called once per map update
+        // so that memory released in bursts (end of a boss fight) is not held forever
+        void Trim()
+        {
+            for (std::vector<void*>& blocks : _free)
+            {
+                while (blocks.size() > RetainedPerClass)
+                {
+                    ::operator delete(blocks.back());
+                    blocks.pop_back();
+                }
+            }
+        }
+
+    private:
+        static std::size_t GetSizeClass(std::size_t size)
+        {
+            return size ? (size - 1) / Granularity : 0;
+        }
+
+        std::array<std::vector<void*>, SizeClasses> _free;
+    };
+}
+
+// Routes new/delete of a class (and everything derived from it) through Trinity::TransientObjectPool
+// The class must have a virtual destructor when derived classes of different size are deleted through a base pointer
+#define TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED \
+    static void* operator new(std::size_t size) { return Trinity::TransientObjectPool::Instance().Allocate(size); } \
+    static void operator delete(void* block, std::size_t size) { Trinity::TransientObjectPool::Instance().Deallocate(block, size); }
+
+#endif // TRINITY_TRANSIENTOBJECTPOOL_H
@@ -291,6 +291,27 @@ std::string TimeToHumanReadable(time_t t)
     return std::string(buf);
 }
 
+uint64 GetCurrentThreadCpuTime()
+{
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+        return 0;
+
+    // FILETIME counts 100ns intervals
+    auto toMicroseconds = [](FILETIME const& fileTime) { return ((uint64(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime) / 10; };
+    return toMicroseconds(kernelTime) + toMicroseconds(userTime);
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec cpuTime;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime) != 0)
+        return 0;
+
+    return uint64(cpuTime.tv_sec) * 1000000 + uint64(cpuTime.tv_nsec) / 1000;
+#else
+    return 0;
+#endif
+}
+
 /// Check if the string is a valid ip address representation
 bool IsIPAddress(char const* ipaddress)
 {
@@ -62,6 +62,9 @@ TC_COMMON_API uint32 TimeStringToSecs(std::string const& timestring);
 TC_COMMON_API std::string TimeToTimestampStr(time_t t);
 TC_COMMON_API std::string TimeToHumanReadable(time_t t);
 
+// CPU time (user + kernel) consumed so far by the calling thread in microseconds, 0 where the platform cannot tell
+TC_COMMON_API uint64 GetCurrentThreadCpuTime();
+
 // Percentage calculation
 template <class T, class U>
 inline T CalculatePct(T base, U pct)
@@ -31,6 +31,7 @@
 #include "DatabaseLoader.h"
 #include "DeadlineTimer.h"
 #include "GitRevision.h"
+#include "IpBanCache.h"
 #include "IPLocation.h"
 #include "LoginRESTService.h"
 #include "MySQLThreading.h"
@@ -190,6 +191,10 @@ int main(int argc, char** argv)
 
     std::shared_ptr<void> sRealmListHandle(nullptr, [](void*) { sRealmList->Close(); });
 
+    sIpBanCache->Initialize(*ioContext, sConfigMgr->GetIntDefault("IpBanCacheUpdateDelay", 60));
+
+    std::shared_ptr<void> sIpBanCacheHandle(nullptr, [](void*) { sIpBanCache->Close(); });
+
     std::string bindIp = sConfigMgr->GetStringDefault("BindIP", "0.0.0.0");
 
     if (!sSessionMgr.StartNetwork(*ioContext, bindIp, bnport))
@@ -216,10 +221,14 @@ int main(int argc, char** argv)
     dbPingTimer->expires_from_now(boost::posix_time::minutes(dbPingInterval));
     dbPingTimer->async_wait(std::bind(&KeepDatabaseAliveHandler, std::weak_ptr<Trinity::Asio::DeadlineTimer>(dbPingTimer), dbPingInterval, std::placeholders::_1));
 
+    // With several bnetserver instances sharing one login database only one of them needs to clean up expired bans
     int32 banExpiryCheckInterval = sConfigMgr->GetIntDefault("BanExpiryCheckInterval", 60);
     std::shared_ptr<Trinity::Asio::DeadlineTimer> banExpiryCheckTimer = std::make_shared<Trinity::Asio::DeadlineTimer>(*ioContext);
-    banExpiryCheckTimer->expires_from_now(boost::posix_time::seconds(banExpiryCheckInterval));
-    banExpiryCheckTimer->async_wait(std::bind(&BanExpiryHandler, std::weak_ptr<Trinity::Asio::DeadlineTimer>(banExpiryCheckTimer), banExpiryCheckInterval, std::placeholders::_1));
+    if (banExpiryCheckInterval > 0)
+    {
+        banExpiryCheckTimer->expires_from_now(boost::posix_time::seconds(banExpiryCheckInterval));
+        banExpiryCheckTimer->async_wait(std::bind(&BanExpiryHandler, std::weak_ptr<Trinity::Asio::DeadlineTimer>(banExpiryCheckTimer), banExpiryCheckInterval, std::placeholders::_1));
+    }
 
 #if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
     std::shared_ptr<Trinity::Asio::DeadlineTimer> serviceStatusWatchTimer;
@@ -0,0 +1,148 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoginCryptoWorkerPool.h"
+#include "Log.h"
+#include <algorithm>
+
+LoginCryptoWorkerPool::~LoginCryptoWorkerPool()
+{
+    Stop();
+}
+
+void LoginCryptoWorkerPool::Start(uint32 threadCount, std::size_t maxQueuedHandshakes)
+{
+    _maxQueuedHandshakes = maxQueuedHandshakes;
+    _stopped = false;
+
+    for (uint32 i = 0; i < threadCount; ++i)
+        _workers.emplace_back(&LoginCryptoWorkerPool::WorkerThread, this);
+
+    if (threadCount)
+        TC_LOG_INFO("server.rest", "Started %u login crypto worker threads (max %u queued handshakes)", threadCount, uint32(maxQueuedHandshakes));
+}
+
+void LoginCryptoWorkerPool::Stop()
+{
+    if (_workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _stopped = true;
+        for (std::deque<std::function<void()>>& queue : _queues)
+            queue.clear();
+    }
+
+    _queueCondition.notify_all();
+
+    for (std::thread& worker : _workers)
+        worker.join();
+
+    _workers.clear();
+
+    TC_LOG_INFO("server.rest", "Login crypto workers stopped, peak queue depth %u, rejected %u handshakes", uint32(_peakQueueDepth), uint32(_rejectedTasks));
+}
+
+bool LoginCryptoWorkerPool::Enqueue(LoginCryptoPriority priority, std::function<void()> task)
+{
+    if (!IsEnabled())
+    {
+        task();
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        if (_stopped)
+            return false;
+
+        std::deque<std::function<void()>>& queue = _queues[size_t(priority)];
+        if (priority == LoginCryptoPriority::Handshake && _maxQueuedHandshakes && queue.size() >= _maxQueuedHandshakes)
+        {
+            ++_rejectedTasks;
+            return false;
+        }
+
+        queue.push_back(std::move(task));
+
+        std::size_t depth = 0;
+        for (std::deque<std::function<void()>> const& q : _queues)
+            depth += q.size();
+
+        _peakQueueDepth = std::max(_peakQueueDepth, depth);
+    }
+
+    _queueCondition.notify_one();
+    return true;
+}
+
+std::size_t LoginCryptoWorkerPool::GetQueueDepth(LoginCryptoPriority priority) const
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    return _queues[size_t(priority)].size();
+}
+
+std::size_t LoginCryptoWorkerPool::GetPeakQueueDepth() const
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    return _peakQueueDepth;
+}
+
+uint64 LoginCryptoWorkerPool::GetRejectedTaskCount() const
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    return _rejectedTasks;
+}
+
+void LoginCryptoWorkerPool::WorkerThread()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(_queueLock);
+            _queueCondition.wait(lock, [this]
+            {
+                if (_stopped)
+                    return true;
+
+                for (std::deque<std::function<void()>> const& queue : _queues)
+                    if (!queue.empty())
+                        return true;
+
+                return false;
+            });
+
+            if (_stopped)
+                return;
+
+            for (std::deque<std::function<void()>>& queue : _queues)
+            {
+                if (!queue.empty())
+                {
+                    task = std::move(queue.front());
+                    queue.pop_front();
+                    break;
+                }
+            }
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LoginCryptoWorkerPool_h__
+#define LoginCryptoWorkerPool_h__
+
+#include "Define.h"
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class LoginCryptoPriority
+{
+    Verification    = 0,    // password checks for clients that already completed the tls handshake
+    Handshake       = 1,    // tls handshakes of freshly accepted connections
+
+    Max
+};
+
+// Runs the cpu heavy parts of the login service (tls handshakes, password hashing) away from the
+// accept thread and the io_context threads.
+// Queued verifications are always served before queued handshakes and only handshakes are subject
+// to admission control - a connection that already got through the handshake is never dropped.
+class LoginCryptoWorkerPool
+{
+public:
+    LoginCryptoWorkerPool() : _maxQueuedHandshakes(0), _stopped(false), _peakQueueDepth(0), _rejectedTasks(0) { }
+    ~LoginCryptoWorkerPool();
+
+    LoginCryptoWorkerPool(LoginCryptoWorkerPool const&) = delete;
+    LoginCryptoWorkerPool& operator=(LoginCryptoWorkerPool const&) = delete;
+
+    // threadCount == 0 keeps running every task inline on the calling thread
+    void Start(uint32 threadCount, std::size_t maxQueuedHandshakes);
+    void Stop();
+
+    bool IsEnabled() const { return !_workers.empty(); }
+
+    // returns false if the task was rejected because the queue for its priority is full
+    bool Enqueue(LoginCryptoPriority priority, std::function<void()> task);
+
+    std::size_t GetQueueDepth(LoginCryptoPriority priority) const;
+    std::size_t GetPeakQueueDepth() const;
+    uint64 GetRejectedTaskCount() const;
+
+private:
+    void WorkerThread();
+
+    mutable std::mutex _queueLock;
+    std::condition_variable _queueCondition;
+    std::array<std::deque<std::function<void()>>, size_t(LoginCryptoPriority::Max)> _queues;
+    std::vector<std::thread> _workers;
+    std::size_t _maxQueuedHandshakes;
+    bool _stopped;
+
+    std::size_t _peakQueueDepth;
+    uint64 _rejectedTasks;
+};
+
+#endif // LoginCryptoWorkerPool_h__
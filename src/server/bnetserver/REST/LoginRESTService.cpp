@@ -21,6 +21,7 @@
 #include "CryptoRandom.h"
 #include "DatabaseEnv.h"
 #include "Errors.h"
+#include "IpBanCache.h"
 #include "IpNetwork.h"
 #include "ProtobufJSON.h"
 #include "Realm.h"
@@ -127,6 +128,10 @@ bool LoginRESTService::Start(Trinity::Asio::IoContext* ioContext)
 
     _loginTicketDuration = sConfigMgr->GetIntDefault("LoginREST.TicketDuration", 3600);
 
+    int32 cryptoThreads = sConfigMgr->GetIntDefault("LoginREST.CryptoThreads", 2);
+    int32 maxQueuedHandshakes = sConfigMgr->GetIntDefault("LoginREST.MaxQueuedHandshakes", 256);
+    _cryptoWorkers.Start(uint32(std::max(cryptoThreads, 0)), std::size_t(std::max(maxQueuedHandshakes, 0)));
+
     _thread = std::thread(std::bind(&LoginRESTService::Run, this));
     return true;
 }
@@ -135,6 +140,7 @@ void LoginRESTService::Stop()
 {
     _stopped = true;
     _thread.join();
+    _cryptoWorkers.Stop();
 }
 
 boost::asio::ip::tcp::endpoint const& LoginRESTService::GetAddressForClient(boost::asio::ip::address const& address) const
@@ -195,20 +201,27 @@ void LoginRESTService::Run()
             continue;   // ran into an accept timeout
 
         std::shared_ptr<AsyncRequest> soapClient = std::make_shared<AsyncRequest>(soapServer);
-        if (soap_ssl_accept(soapClient->GetClient()) != SOAP_OK)
+        bool queued = _cryptoWorkers.Enqueue(LoginCryptoPriority::Handshake, [this, soapClient]()
         {
-            TC_LOG_DEBUG("server.rest", "Failed SSL handshake from IP=%s", boost::asio::ip::address_v4(soapClient->GetClient()->ip).to_string().c_str());
-            continue;
-        }
+            if (soap_ssl_accept(soapClient->GetClient()) != SOAP_OK)
+            {
+                TC_LOG_DEBUG("server.rest", "Failed SSL handshake from IP=%s", boost::asio::ip::address_v4(soapClient->GetClient()->ip).to_string().c_str());
+                return;
+            }
 
-        TC_LOG_DEBUG("server.rest", "Accepted connection from IP=%s", boost::asio::ip::address_v4(soapClient->GetClient()->ip).to_string().c_str());
+            TC_LOG_DEBUG("server.rest", "Accepted connection from IP=%s", boost::asio::ip::address_v4(soapClient->GetClient()->ip).to_string().c_str());
 
-        Trinity::Asio::post(*_ioContext, [soapClient]()
-        {
-            soapClient->GetClient()->user = (void*)&soapClient; // this allows us to make a copy of pointer inside GET/POST handlers to increment reference count
-            soap_begin(soapClient->GetClient());
-            soap_begin_recv(soapClient->GetClient());
+            Trinity::Asio::post(*_ioContext, [soapClient]()
+            {
+                soapClient->GetClient()->user = (void*)&soapClient; // this allows us to make a copy of pointer inside GET/POST handlers to increment reference count
+                soap_begin(soapClient->GetClient());
+                soap_begin_recv(soapClient->GetClient());
+            });
         });
+
+        if (!queued)
+            TC_LOG_WARN("server.rest", "Dropped connection from IP=%s, %u handshakes already queued",
+                boost::asio::ip::address_v4(soapClient->GetClient()->ip).to_string().c_str(), uint32(_cryptoWorkers.GetQueueDepth(LoginCryptoPriority::Handshake)));
     }
 
     // and release the context handle here - soap does not own it so it should not free it on exit
@@ -340,11 +353,21 @@ int32 LoginRESTService::HandlePostLogin(std::shared_ptr<AsyncRequest> request)
     Utf8ToUpperOnlyLatin(login);
     Utf8ToUpperOnlyLatin(password);
 
+    // hashing happens on a crypto worker, the database part continues on the io_context
+    _cryptoWorkers.Enqueue(LoginCryptoPriority::Verification, [this, request, login, password]()
+    {
+        std::string sentPasswordHash = CalculateShaPassHash(login, password);
+        Trinity::Asio::post(*_ioContext, [this, request, login, sentPasswordHash]() { VerifyLogin(request, login, sentPasswordHash); });
+    });
+
+    return SOAP_OK;
+}
+
+void LoginRESTService::VerifyLogin(std::shared_ptr<AsyncRequest> request, std::string const& login, std::string const& sentPasswordHash)
+{
     LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_AUTHENTICATION);
     stmt->setString(0, login);
 
-    std::string sentPasswordHash = CalculateShaPassHash(login, password);
-
     request->SetCallback(std::make_unique<QueryCallback>(LoginDatabase.AsyncQuery(stmt)
         .WithChainingPreparedCallback([request, login, sentPasswordHash, this](QueryCallback& callback, PreparedQueryResult result)
     {
@@ -413,6 +436,7 @@ int32 LoginRESTService::HandlePostLogin(std::shared_ptr<AsyncRequest> request)
                         {
                             stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_IP_AUTO_BANNED);
                             stmt->setString(0, ip_address);
+                            sIpBanCache->AddBan(ip_address, banTime);
                         }
 
                         stmt->setUInt32(1, banTime);
@@ -434,8 +458,6 @@ int32 LoginRESTService::HandlePostLogin(std::shared_ptr<AsyncRequest> request)
     })));
 
     Trinity::Asio::post(*_ioContext, [this, request]() { HandleAsyncRequest(request); });
-
-    return SOAP_OK;
 }
 
 int32 LoginRESTService::HandlePostRefreshLoginTicket(std::shared_ptr<AsyncRequest> request)
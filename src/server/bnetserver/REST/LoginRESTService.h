@@ -22,6 +22,7 @@
 #include "IoContext.h"
 #include "IpAddress.h"
 #include "Login.pb.h"
+#include "LoginCryptoWorkerPool.h"
 #include "Session.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
@@ -65,6 +66,8 @@ private:
     int32 HandlePostLogin(std::shared_ptr<AsyncRequest> request);
     int32 HandlePostRefreshLoginTicket(std::shared_ptr<AsyncRequest> request);
 
+    void VerifyLogin(std::shared_ptr<AsyncRequest> request, std::string const& login, std::string const& sentPasswordHash);
+
     int32 SendResponse(soap* soapClient, google::protobuf::Message const& response);
 
     void HandleAsyncRequest(std::shared_ptr<AsyncRequest> request);
@@ -98,6 +101,7 @@ private:
 
     Trinity::Asio::IoContext* _ioContext;
     std::thread _thread;
+    LoginCryptoWorkerPool _cryptoWorkers;
     std::atomic<bool> _stopped;
     Battlenet::JSON::Login::FormInputs _formInputs;
     std::string _bindIP;
@@ -21,6 +21,7 @@
 #include "CryptoRandom.h"
 #include "DatabaseEnv.h"
 #include "Errors.h"
+#include "IpBanCache.h"
 #include "IPLocation.h"
 #include "QueryCallback.h"
 #include "LoginRESTService.h"
@@ -90,6 +91,12 @@ void Battlenet::Session::Start()
     TC_LOG_TRACE("session", "%s Accepted connection", GetClientInfo().c_str());
 
     // Verify that this IP is not in the ip_banned table
+    if (sIpBanCache->IsEnabled())
+    {
+        HandleIpBanCheck(sIpBanCache->IsBanned(ip_address));
+        return;
+    }
+
     LoginDatabase.Execute(LoginDatabase.GetPreparedStatement(LOGIN_DEL_EXPIRED_IP_BANS));
 
     LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_INFO);
@@ -100,9 +107,9 @@ void Battlenet::Session::Start()
 
 void Battlenet::Session::CheckIpCallback(PreparedQueryResult result)
 {
+    bool banned = false;
     if (result)
     {
-        bool banned = false;
         do
         {
             Field* fields = result->Fetch();
@@ -110,13 +117,18 @@ void Battlenet::Session::CheckIpCallback(PreparedQueryResult result)
                 banned = true;
 
         } while (result->NextRow());
+    }
 
-        if (banned)
-        {
-            TC_LOG_DEBUG("session", "%s tries to log in using banned IP!", GetClientInfo().c_str());
-            CloseSocket();
-            return;
-        }
+    HandleIpBanCheck(banned);
+}
+
+void Battlenet::Session::HandleIpBanCheck(bool banned)
+{
+    if (banned)
+    {
+        TC_LOG_DEBUG("session", "%s tries to log in using banned IP!", GetClientInfo().c_str());
+        CloseSocket();
+        return;
     }
 
     AsyncHandshake();
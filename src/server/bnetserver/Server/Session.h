@@ -165,6 +165,7 @@ namespace Battlenet
         void AsyncHandshake();
 
         void CheckIpCallback(PreparedQueryResult result);
+        void HandleIpBanCheck(bool banned);
 
         uint32 VerifyWebCredentials(std::string const& webCredentials, std::function<void(ServiceBase*, uint32, ::google::protobuf::Message const*)>& continuation);
 
@@ -25,8 +25,7 @@ bool Battlenet::SessionManager::StartNetwork(Trinity::Asio::IoContext& ioContext
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
-    _acceptor->SetSocketFactory(std::bind(&BaseSocketMgr::GetSocketForAccept, this));
-    _acceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
+    AsyncAcceptWithCallback<&OnSocketAccept>();
     return true;
 }
 
@@ -54,6 +54,11 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+
+        std::string const replicaString = sConfigMgr->GetStringDefault(name + "Database.ReplicaInfo", "");
+        if (!replicaString.empty())
+            pool.SetReplicaConnectionInfo(replicaString);
+
         if (uint32 error = pool.Open())
         {
             // Database does not exist
@@ -16,6 +16,8 @@
  */
 
 #include "DatabaseWorker.h"
+#include "MySQLConnection.h"
+#include "ProcessPriority.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
 
@@ -41,6 +43,8 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    SetCurrentThreadAffinity("ThreadAffinity.Database");
+
     for (;;)
     {
         SQLOperation* operation = nullptr;
@@ -50,9 +54,15 @@ void DatabaseWorker::WorkerThread()
         if (_cancelationToken || !operation)
             return;
 
+        _connection->RecordQueueWait(std::chrono::steady_clock::now() - operation->GetQueuedTime());
+
         operation->SetConnection(_connection);
         operation->call();
 
+        std::shared_ptr<AsyncCompletionSignal> completionSignal = operation->TakeCompletionSignal();
         delete operation;
+
+        if (completionSignal)
+            completionSignal->Notify();
     }
 }
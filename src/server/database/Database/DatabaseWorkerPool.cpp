@@ -24,6 +24,7 @@
 #include "Implementation/CharacterDatabase.h"
 #include "Implementation/HotfixDatabase.h"
 #include "Log.h"
+#include "Metric.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
 #include "ProducerConsumerQueue.h"
@@ -34,6 +35,7 @@
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
+#include <limits>
 #ifdef TRINITY_DEBUG
 #include <sstream>
 #include <boost/stacktrace.hpp>
@@ -54,8 +56,8 @@ class PingOperation : public SQLOperation
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _queue(new ProducerConsumerQueue<SQLOperation*>()),
-      _async_threads(0), _synch_threads(0)
+    : _nextAffinityKey(0), _coalescedWritesEnabled(false), _coalescedWriteCount(0), _reportedCoalescedWriteCount(0),
+    _async_threads(0), _synch_threads(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
     WPFatal(mysql_get_client_version() >= MIN_MYSQL_CLIENT_VERSION, "TrinityCore does not support MySQL versions below 5.1");
@@ -66,7 +68,14 @@ DatabaseWorkerPool<T>::DatabaseWorkerPool()
 template <class T>
 DatabaseWorkerPool<T>::~DatabaseWorkerPool()
 {
-    _queue->Cancel();
+    for (std::unique_ptr<ProducerConsumerQueue<SQLOperation*>>& queue : _queues)
+        queue->Cancel();
+
+    for (std::unique_ptr<ProducerConsumerQueue<SQLOperation*>>& queue : _replicaQueues)
+        queue->Cancel();
+
+    for (std::pair<std::pair<uint64, uint32> const, PreparedStatement<T>*>& write : _coalescedWrites)
+        delete write.second;
 }
 
 template <class T>
@@ -77,6 +86,21 @@ void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
 
     _async_threads = asyncThreads;
     _synch_threads = synchThreads;
+
+    //! Queues are created up front so operations enqueued before Open() are kept until their worker starts
+    _queues.clear();
+    for (uint8 i = 0; i < std::max<uint8>(asyncThreads, 1); ++i)
+        _queues.push_back(std::make_unique<ProducerConsumerQueue<SQLOperation*>>());
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetReplicaConnectionInfo(std::string const& infoString)
+{
+    _replicaConnectionInfo = std::make_unique<MySQLConnectionInfo>(infoString);
+
+    _replicaQueues.clear();
+    for (uint8 i = 0; i < std::max<uint8>(_async_threads, 1); ++i)
+        _replicaQueues.push_back(std::make_unique<ProducerConsumerQueue<SQLOperation*>>());
 }
 
 template <class T>
@@ -95,11 +119,22 @@ uint32 DatabaseWorkerPool<T>::Open()
 
     error = OpenConnections(IDX_SYNCH, _synch_threads);
 
+    if (!error && _replicaConnectionInfo)
+    {
+        TC_LOG_INFO("sql.driver", "Opening read replica connections of DatabasePool '%s' to %s.",
+            GetDatabaseName(), _replicaConnectionInfo->host.c_str());
+
+        error = OpenConnections(IDX_REPLICA_ASYNC, _async_threads);
+        if (!error)
+            error = OpenConnections(IDX_REPLICA_SYNCH, _synch_threads);
+    }
+
     if (!error)
     {
         TC_LOG_INFO("sql.driver", "DatabasePool '%s' opened successfully. " SZFMTD
                     " total connections running.", GetDatabaseName(),
-                    (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size()));
+                    (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size() +
+                     _connections[IDX_REPLICA_SYNCH].size() + _connections[IDX_REPLICA_ASYNC].size()));
     }
 
     return error;
@@ -112,16 +147,24 @@ void DatabaseWorkerPool<T>::Close()
 
     //! Closes the actualy MySQL connection.
     _connections[IDX_ASYNC].clear();
+    _connections[IDX_REPLICA_ASYNC].clear();
 
     TC_LOG_INFO("sql.driver", "Asynchronous connections on DatabasePool '%s' terminated. "
                 "Proceeding with synchronous connections.",
         GetDatabaseName());
 
+    //! Buffered writes are the latest values of their rows, write them before the synchronous connections go away
+    _coalescedWritesEnabled = false;
+    for (std::pair<std::pair<uint64, uint32> const, PreparedStatement<T>*>& write : _coalescedWrites)
+        DirectExecute(write.second);
+    _coalescedWrites.clear();
+
     //! Shut down the synchronous connections
     //! There's no need for locking the connection, because DatabaseWorkerPool<>::Close
     //! should only be called after any other thread tasks in the core have exited,
     //! meaning there can be no concurrent access at this point.
     _connections[IDX_SYNCH].clear();
+    _connections[IDX_REPLICA_SYNCH].clear();
 
     TC_LOG_INFO("sql.driver", "All connections on DatabasePool '%s' closed.", GetDatabaseName());
 }
@@ -167,6 +210,22 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
         }
     }
 
+    //! Remember which statements replicas accepted, so routing never has to look at a connection owned by another thread
+    _replicaStatementFlags.clear();
+    for (std::pair<InternalIndex, ConnectionFlags> replica : { std::make_pair(IDX_REPLICA_ASYNC, CONNECTION_ASYNC), std::make_pair(IDX_REPLICA_SYNCH, CONNECTION_SYNCH) })
+    {
+        if (_connections[replica.first].empty())
+            continue;
+
+        T* connection = _connections[replica.first].front().get();
+        if (_replicaStatementFlags.size() < connection->m_stmts.size())
+            _replicaStatementFlags.resize(connection->m_stmts.size());
+
+        for (size_t i = 0; i < connection->m_stmts.size(); ++i)
+            if (connection->m_stmts[i])
+                _replicaStatementFlags[i] |= replica.second;
+    }
+
     return true;
 }
 
@@ -190,7 +249,7 @@ QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= null
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 {
-    auto connection = GetFreeConnection();
+    auto connection = GetFreeConnection(IsReplicaStatement(stmt->GetIndex(), CONNECTION_SYNCH) ? IDX_REPLICA_SYNCH : IDX_SYNCH);
     PreparedResultSet* ret = connection->Query(stmt);
     connection->Unlock();
 
@@ -212,28 +271,44 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
     BasicStatementTask* task = new BasicStatementTask(sql, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultFuture result = task->GetFuture();
+    std::shared_ptr<AsyncCompletionSignal> signal = task->GetCompletionSignal();
     Enqueue(task);
-    return QueryCallback(std::move(result));
+    return QueryCallback(std::move(result), std::move(signal));
 }
 
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
 {
+    bool const replica = IsReplicaStatement(stmt->GetIndex(), CONNECTION_ASYNC);
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
-    return QueryCallback(std::move(result));
+    std::shared_ptr<AsyncCompletionSignal> signal = task->GetCompletionSignal();
+    if (replica)
+        EnqueueReplica(task);
+    else
+        Enqueue(task);
+    return QueryCallback(std::move(result), std::move(signal));
 }
 
 template <class T>
 SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(SQLQueryHolder<T>* holder)
 {
+    //! The holder can only go to a replica when all of its statements may run there
+    bool replica = !_replicaQueues.empty();
+    for (std::pair<PreparedStatementBase*, PreparedQueryResult> const& query : holder->m_queries)
+        if (query.first && !IsReplicaStatement(query.first->GetIndex(), CONNECTION_ASYNC))
+            replica = false;
+
     SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
-    return result;
+    std::shared_ptr<AsyncCompletionSignal> signal = task->GetCompletionSignal();
+    if (replica)
+        EnqueueReplica(task);
+    else
+        Enqueue(task);
+    return SQLQueryHolderCallback(std::move(result), std::move(signal));
 }
 
 template <class T>
@@ -244,6 +319,12 @@ SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 
 template <class T>
 void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
+{
+    CommitTransaction(std::move(transaction), NextAffinityKey());
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction, uint64 affinityKey)
 {
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -262,11 +343,17 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // TRINITY_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    Enqueue(new TransactionTask(transaction), affinityKey);
 }
 
 template <class T>
 TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction<T> transaction)
+{
+    return AsyncCommitTransaction(std::move(transaction), NextAffinityKey());
+}
+
+template <class T>
+TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction<T> transaction, uint64 affinityKey)
 {
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -287,8 +374,9 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
 
     TransactionWithResultTask* task = new TransactionWithResultTask(transaction);
     TransactionFuture result = task->GetFuture();
-    Enqueue(task);
-    return TransactionCallback(std::move(result));
+    std::shared_ptr<AsyncCompletionSignal> signal = task->GetCompletionSignal();
+    Enqueue(task, affinityKey);
+    return TransactionCallback(std::move(result), std::move(signal));
 }
 
 template <class T>
@@ -343,26 +431,148 @@ template <class T>
 void DatabaseWorkerPool<T>::KeepAlive()
 {
     //! Ping synchronous connections
-    for (auto& connection : _connections[IDX_SYNCH])
+    for (InternalIndex type : { IDX_SYNCH, IDX_REPLICA_SYNCH })
     {
-        if (connection->LockIfReady())
+        for (auto& connection : _connections[type])
         {
-            connection->Ping();
-            connection->Unlock();
+            if (connection->LockIfReady())
+            {
+                connection->Ping();
+                connection->Unlock();
+            }
         }
     }
 
-    //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
-    //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
-    //! as the sole purpose is to prevent connections from idling.
+    //! Every async worker thread owns its queue, send 1 ping operation request to each of them
     auto const count = _connections[IDX_ASYNC].size();
     for (uint8 i = 0; i < count; ++i)
-        Enqueue(new PingOperation);
+        Enqueue(new PingOperation, i);
+
+    for (std::unique_ptr<ProducerConsumerQueue<SQLOperation*>>& queue : _replicaQueues)
+        queue->Push(new PingOperation);
+}
+
+template <class T>
+std::vector<SQLExecutionStatsData> DatabaseWorkerPool<T>::GetStatementStats() const
+{
+    std::vector<SQLExecutionStatsData> stats;
+    for (std::vector<std::unique_ptr<T>> const& connections : _connections)
+    {
+        for (std::unique_ptr<T> const& connection : connections)
+        {
+            if (stats.size() < connection->m_statementStatsSize)
+                stats.resize(connection->m_statementStatsSize);
+
+            for (std::size_t i = 0; i < connection->m_statementStatsSize; ++i)
+                stats[i].Merge(connection->m_statementStats[i].Load());
+        }
+    }
+
+    return stats;
+}
+
+template <class T>
+SQLExecutionStatsData DatabaseWorkerPool<T>::GetQueueWaitStats() const
+{
+    SQLExecutionStatsData stats;
+    for (InternalIndex type : { IDX_ASYNC, IDX_REPLICA_ASYNC })
+        for (std::unique_ptr<T> const& connection : _connections[type])
+            stats.Merge(connection->m_queueWaitStats.Load());
+
+    return stats;
+}
+
+template <class T>
+std::size_t DatabaseWorkerPool<T>::GetQueueSize() const
+{
+    std::size_t size = 0;
+    for (std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> const& queue : _queues)
+        size += queue->Size();
+
+    for (std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> const& queue : _replicaQueues)
+        size += queue->Size();
+
+    return size;
+}
+
+template <class T>
+std::string DatabaseWorkerPool<T>::GetPreparedStatementString(uint32 index) const
+{
+    for (std::vector<std::unique_ptr<T>> const& connections : _connections)
+        for (std::unique_ptr<T> const& connection : connections)
+            if (index < connection->m_stmts.size() && connection->m_stmts[index])
+                return connection->GetStatementQueryString(index);
+
+    return "";
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ReportStatistics()
+{
+    if (!sMetric->IsEnabled())
+        return;
+
+    // inclusive integer bounds matching SQLExecutionStats::GetLatencyBucket: bucket N ends at 2^N - 1 us
+    static std::vector<int64> const latencyBounds = []()
+    {
+        std::vector<int64> bounds;
+        for (std::size_t i = 0; i < SQL_LATENCY_BUCKET_COUNT - 1; ++i)
+            bounds.push_back((int64(1) << i) - 1);
+        return bounds;
+    }();
+
+    auto reportLatency = [](MetricHistogram& histogram, SQLExecutionStatsData const& current, SQLExecutionStatsData const& reported)
+    {
+        for (std::size_t i = 0; i < SQL_LATENCY_BUCKET_COUNT; ++i)
+            if (current.LatencyBuckets[i] > reported.LatencyBuckets[i])
+                histogram.AddBucketCount(i, current.LatencyBuckets[i] - reported.LatencyBuckets[i]);
+
+        histogram.AddSum(int64(current.TotalMicroseconds - reported.TotalMicroseconds));
+    };
+
+    std::string database = GetDatabaseName();
+
+    std::vector<SQLExecutionStatsData> stats = GetStatementStats();
+    _reportedStatementStats.resize(stats.size());
+    for (std::size_t i = 0; i < stats.size(); ++i)
+    {
+        SQLExecutionStatsData const& current = stats[i];
+        SQLExecutionStatsData& reported = _reportedStatementStats[i];
+        if (current.Count == reported.Count)
+            continue;
+
+        std::vector<MetricTag> tags = { TC_METRIC_TAG("database", database), TC_METRIC_TAG("statement", std::to_string(i)) };
+        sMetric->GetCounter("db_statement_count", tags).Increment(current.Count - reported.Count);
+        sMetric->GetCounter("db_statement_rows", tags).Increment(current.Rows - reported.Rows);
+        reportLatency(sMetric->GetHistogram("db_statement_latency", latencyBounds, tags), current, reported);
+        reported = current;
+    }
+
+    SQLExecutionStatsData queueWait = GetQueueWaitStats();
+    if (queueWait.Count != _reportedQueueWaitStats.Count)
+    {
+        reportLatency(sMetric->GetHistogram("db_queue_wait", latencyBounds, { TC_METRIC_TAG("database", database) }), queueWait, _reportedQueueWaitStats);
+        _reportedQueueWaitStats = queueWait;
+    }
+
+    sMetric->GetGauge("db_queue_size", { TC_METRIC_TAG("database", database) }).Set(int64(GetQueueSize()));
+
+    uint64 coalescedWrites = GetCoalescedWriteCount();
+    if (coalescedWrites != _reportedCoalescedWriteCount)
+    {
+        sMetric->GetCounter("db_coalesced_writes", { TC_METRIC_TAG("database", database) }).Increment(coalescedWrites - _reportedCoalescedWriteCount);
+        _reportedCoalescedWriteCount = coalescedWrites;
+    }
 }
 
 template <class T>
 uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConnections)
 {
+    if (type == IDX_ASYNC)
+        ASSERT(numConnections <= _queues.size());
+    else if (type == IDX_REPLICA_ASYNC)
+        ASSERT(numConnections <= _replicaQueues.size());
+
     for (uint8 i = 0; i < numConnections; ++i)
     {
         // Create the connection
@@ -370,14 +580,21 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
             switch (type)
             {
             case IDX_ASYNC:
-                return std::make_unique<T>(_queue.get(), *_connectionInfo);
+                return std::make_unique<T>(_queues[i].get(), *_connectionInfo);
             case IDX_SYNCH:
                 return std::make_unique<T>(*_connectionInfo);
+            case IDX_REPLICA_ASYNC:
+                return std::make_unique<T>(_replicaQueues[i].get(), *_replicaConnectionInfo);
+            case IDX_REPLICA_SYNCH:
+                return std::make_unique<T>(*_replicaConnectionInfo);
             default:
                 ABORT();
             }
         }();
 
+        if (type == IDX_REPLICA_ASYNC || type == IDX_REPLICA_SYNCH)
+            connection->SetReadReplica();
+
         if (uint32 error = connection->Open())
         {
             // Failed to open a connection or invalid version, abort and cleanup
@@ -411,11 +628,23 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 template <class T>
 void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
 {
-    _queue->Push(op);
+    Enqueue(op, NextAffinityKey());
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, uint64 affinityKey)
+{
+    _queues[affinityKey % _queues.size()]->Push(op);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::EnqueueReplica(SQLOperation* op)
+{
+    _replicaQueues[NextAffinityKey() % _replicaQueues.size()]->Push(op);
 }
 
 template <class T>
-T* DatabaseWorkerPool<T>::GetFreeConnection()
+T* DatabaseWorkerPool<T>::GetFreeConnection(InternalIndex type /*= IDX_SYNCH*/)
 {
 #ifdef TRINITY_DEBUG
     if (_warnSyncQueries)
@@ -427,12 +656,12 @@ T* DatabaseWorkerPool<T>::GetFreeConnection()
 #endif
 
     uint8 i = 0;
-    auto const num_cons = _connections[IDX_SYNCH].size();
+    auto const num_cons = _connections[type].size();
     T* connection = nullptr;
     //! Block forever until a connection is free
     for (;;)
     {
-        connection = _connections[IDX_SYNCH][i++ % num_cons].get();
+        connection = _connections[type][i++ % num_cons].get();
         //! Must be matched with t->Unlock() or you will get deadlocks
         if (connection->LockIfReady())
             break;
@@ -464,6 +693,65 @@ void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
     Enqueue(task);
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, uint64 affinityKey)
+{
+    PreparedStatementTask* task = new PreparedStatementTask(stmt);
+    Enqueue(task, affinityKey);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ExecuteCoalesced(PreparedStatement<T>* stmt, uint64 rowKey)
+{
+    if (!_coalescedWritesEnabled.load(std::memory_order_relaxed))
+    {
+        Execute(stmt, rowKey);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_coalescedWritesLock);
+    PreparedStatement<T>*& buffered = _coalescedWrites[{ rowKey, stmt->GetIndex() }];
+    if (buffered)
+    {
+        delete buffered;
+        _coalescedWriteCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    buffered = stmt;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::FlushCoalescedWrites()
+{
+    std::lock_guard<std::mutex> lock(_coalescedWritesLock);
+    EnqueueCoalescedWrites(_coalescedWrites.begin(), _coalescedWrites.end());
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::FlushCoalescedWrites(uint64 rowKey)
+{
+    std::lock_guard<std::mutex> lock(_coalescedWritesLock);
+    EnqueueCoalescedWrites(_coalescedWrites.lower_bound({ rowKey, 0 }), _coalescedWrites.upper_bound({ rowKey, std::numeric_limits<uint32>::max() }));
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetCoalescedWritesEnabled(bool enabled)
+{
+    _coalescedWritesEnabled = enabled;
+    if (!enabled)
+        FlushCoalescedWrites();
+}
+
+template <class T>
+template <class Iterator>
+void DatabaseWorkerPool<T>::EnqueueCoalescedWrites(Iterator begin, Iterator end)
+{
+    for (Iterator itr = begin; itr != end; ++itr)
+        Execute(itr->second, itr->first.first);
+
+    _coalescedWrites.erase(begin, end);
+}
+
 template <class T>
 void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
 {
@@ -20,9 +20,14 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "SQLExecutionStats.h"
 #include "StringFormat.h"
 #include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 template <typename T>
@@ -39,6 +44,8 @@ class DatabaseWorkerPool
         {
             IDX_ASYNC,
             IDX_SYNCH,
+            IDX_REPLICA_ASYNC,
+            IDX_REPLICA_SYNCH,
             IDX_SIZE
         };
 
@@ -50,6 +57,10 @@ class DatabaseWorkerPool
 
         void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
 
+        //! Opens the same amount of connections to a read replica, statements prepared with CONNECTION_READ_REPLICA
+        //! are executed there while everything else stays on the primary. Must be called after SetConnectionInfo.
+        void SetReplicaConnectionInfo(std::string const& infoString);
+
         uint32 Open();
 
         void Close();
@@ -78,13 +89,34 @@ class DatabaseWorkerPool
             if (Trinity::IsFormatEmptyOrNull(sql))
                 return;
 
-            Execute(Trinity::StringFormat(std::forward<Format>(sql), std::forward<Args>(args)...).c_str());
+            Trinity::FormatBuffer buffer;
+            Execute(Trinity::StringFormatTo(buffer, std::forward<Format>(sql), std::forward<Args>(args)...));
         }
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
         void Execute(PreparedStatement<T>* stmt);
 
+        //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
+        //! Operations sharing the same affinity key (e.g. account id or character guid) are executed in order on the same connection.
+        //! Statement must be prepared with CONNECTION_ASYNC flag.
+        void Execute(PreparedStatement<T>* stmt, uint64 affinityKey);
+
+        //! Buffers a one-way SQL operation in prepared statement format that overwrites a single row identified by rowKey
+        //! (a guid, an instance id, ...). A statement with the same index and row key buffered later replaces it, so a row
+        //! updated many times until the next flush is only written once. Flushed statements use rowKey as affinity key.
+        //! Statement must be prepared with CONNECTION_ASYNC flag and must not depend on the current values of the row.
+        void ExecuteCoalesced(PreparedStatement<T>* stmt, uint64 rowKey);
+
+        //! Enqueues every buffered statement, called periodically by the world update.
+        void FlushCoalescedWrites();
+
+        //! Enqueues the buffered statements of one row, use before the row is read back or written by other means.
+        void FlushCoalescedWrites(uint64 rowKey);
+
+        //! Statements are only buffered while enabled, disabling flushes the buffer.
+        void SetCoalescedWritesEnabled(bool enabled);
+
         /**
             Direct synchronous one-way statement methods.
         */
@@ -101,7 +133,8 @@ class DatabaseWorkerPool
             if (Trinity::IsFormatEmptyOrNull(sql))
                 return;
 
-            DirectExecute(Trinity::StringFormat(std::forward<Format>(sql), std::forward<Args>(args)...).c_str());
+            Trinity::FormatBuffer buffer;
+            DirectExecute(Trinity::StringFormatTo(buffer, std::forward<Format>(sql), std::forward<Args>(args)...));
         }
 
         //! Directly executes a one-way SQL operation in prepared statement format, that will block the calling thread until finished.
@@ -124,7 +157,8 @@ class DatabaseWorkerPool
             if (Trinity::IsFormatEmptyOrNull(sql))
                 return QueryResult(nullptr);
 
-            return Query(Trinity::StringFormat(std::forward<Format>(sql), std::forward<Args>(args)...).c_str(), conn);
+            Trinity::FormatBuffer buffer;
+            return Query(Trinity::StringFormatTo(buffer, std::forward<Format>(sql), std::forward<Args>(args)...), conn);
         }
 
         //! Directly executes an SQL query in string format -with variable args- that will block the calling thread until finished.
@@ -135,7 +169,8 @@ class DatabaseWorkerPool
             if (Trinity::IsFormatEmptyOrNull(sql))
                 return QueryResult(nullptr);
 
-            return Query(Trinity::StringFormat(std::forward<Format>(sql), std::forward<Args>(args)...).c_str());
+            Trinity::FormatBuffer buffer;
+            return Query(Trinity::StringFormatTo(buffer, std::forward<Format>(sql), std::forward<Args>(args)...));
         }
 
         //! Directly executes an SQL query in prepared format that will block the calling thread until finished.
@@ -173,10 +208,20 @@ class DatabaseWorkerPool
         //! were appended to the transaction will be respected during execution.
         void CommitTransaction(SQLTransaction<T> transaction);
 
+        //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
+        //! were appended to the transaction will be respected during execution.
+        //! Transactions sharing the same affinity key (e.g. account id or character guid) are committed in order on the same connection.
+        void CommitTransaction(SQLTransaction<T> transaction, uint64 affinityKey);
+
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
         TransactionCallback AsyncCommitTransaction(SQLTransaction<T> transaction);
 
+        //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
+        //! were appended to the transaction will be respected during execution.
+        //! Transactions sharing the same affinity key (e.g. account id or character guid) are committed in order on the same connection.
+        TransactionCallback AsyncCommitTransaction(SQLTransaction<T> transaction, uint64 affinityKey);
+
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
         void DirectCommitTransaction(SQLTransaction<T>& transaction);
@@ -206,6 +251,30 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        /**
+            Statistics
+        */
+
+        //! Execution statistics of every prepared statement summed over all connections, indexed by PreparedStatementIndex.
+        std::vector<SQLExecutionStatsData> GetStatementStats() const;
+
+        //! Time asynchronous operations spent queued before a worker thread picked them up.
+        SQLExecutionStatsData GetQueueWaitStats() const;
+
+        //! Number of operations waiting in the asynchronous queues.
+        std::size_t GetQueueSize() const;
+
+        //! Number of buffered statements replaced by a later one before reaching the database.
+        uint64 GetCoalescedWriteCount() const { return _coalescedWriteCount.load(std::memory_order_relaxed); }
+
+        //! Returns the SQL of a prepared statement, empty if it is not prepared on any connection.
+        std::string GetPreparedStatementString(uint32 index) const;
+
+        //! Sends statistics gathered since the previous call to Metric.
+        void ReportStatistics();
+
+        char const* GetDatabaseName() const;
+
         void WarnAboutSyncQueries([[maybe_unused]] bool warn)
         {
 #ifdef TRINITY_DEBUG
@@ -218,19 +287,48 @@ class DatabaseWorkerPool
 
         unsigned long EscapeString(char* to, char const* from, unsigned long length);
 
+        //! Pushes the operation to the queue of the next async connection in round-robin order.
         void Enqueue(SQLOperation* op);
 
+        //! Pushes the operation to the queue of the async connection owning the given affinity key.
+        void Enqueue(SQLOperation* op, uint64 affinityKey);
+
+        uint64 NextAffinityKey() { return _nextAffinityKey.fetch_add(1, std::memory_order_relaxed); }
+
+        //! Removes the buffered statements in [begin, end) and enqueues them, _coalescedWritesLock must be held.
+        template <class Iterator>
+        void EnqueueCoalescedWrites(Iterator begin, Iterator end);
+
+        //! Pushes a read only operation to the queue of the next async replica connection.
+        void EnqueueReplica(SQLOperation* op);
+
+        //! Whether the statement was prepared on replica connections of the given type (CONNECTION_ASYNC or CONNECTION_SYNCH).
+        bool IsReplicaStatement(uint32 index, uint8 type) const
+        {
+            return index < _replicaStatementFlags.size() && (_replicaStatementFlags[index] & type) != 0;
+        }
+
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
-        T* GetFreeConnection();
-
-        char const* GetDatabaseName() const;
+        T* GetFreeConnection(InternalIndex type = IDX_SYNCH);
 
-        //! Queue shared by async worker threads.
-        std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+        //! One queue per async worker thread, indexed by affinity key modulo queue count.
+        std::vector<std::unique_ptr<ProducerConsumerQueue<SQLOperation*>>> _queues;
+        std::vector<std::unique_ptr<ProducerConsumerQueue<SQLOperation*>>> _replicaQueues;
+        std::atomic<uint64> _nextAffinityKey;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
+        std::unique_ptr<MySQLConnectionInfo> _replicaConnectionInfo;
         std::vector<uint8> _preparedStatementSize;
+        std::vector<uint8> _replicaStatementFlags;
+        std::vector<SQLExecutionStatsData> _reportedStatementStats;
+        SQLExecutionStatsData _reportedQueueWaitStats;
+        //! Buffered single row writes keyed by (row key, statement index).
+        std::map<std::pair<uint64, uint32>, PreparedStatement<T>*> _coalescedWrites;
+        std::mutex _coalescedWritesLock;
+        std::atomic<bool> _coalescedWritesEnabled;
+        std::atomic<uint64> _coalescedWriteCount;
+        uint64 _reportedCoalescedWriteCount;
         uint8 _async_threads, _synch_threads;
 #ifdef TRINITY_DEBUG
         static inline thread_local bool _warnSyncQueries = false;
@@ -30,6 +30,11 @@
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
 
+/// Most rows merged into one multi-row statement, larger runs are split into power of two chunks to bound the number of prepared variants
+#define MAX_COALESCED_STATEMENT_ROWS 64
+/// MySQL protocol limit of placeholders in a single prepared statement
+#define MAX_PREPARED_STATEMENT_PARAMS 65535
+
 MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 {
     std::vector<std::string_view> tokens = Trinity::Tokenize(infoString, ';', true);
@@ -48,6 +53,7 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 }
 
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
+m_statementStatsSize(0),
 m_reconnecting(false),
 m_prepareError(false),
 m_queue(nullptr),
@@ -56,6 +62,7 @@ m_connectionInfo(connInfo),
 m_connectionFlags(CONNECTION_SYNCH) { }
 
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
+m_statementStatsSize(0),
 m_reconnecting(false),
 m_prepareError(false),
 m_queue(queue),
@@ -76,6 +83,7 @@ void MySQLConnection::Close()
     // Stop the worker thread before the statements are cleared
     m_worker.reset();
 
+    m_coalescedStmts.clear();
     m_stmts.clear();
 
     if (m_Mysql)
@@ -182,10 +190,31 @@ uint32 MySQLConnection::Open()
 
 bool MySQLConnection::PrepareStatements()
 {
+    // multi-row variants are prepared lazily and belong to the previous connection when reconnecting
+    m_coalescedStmts.clear();
     DoPrepareStatements();
+
+    // statement count never changes, keep statistics across reconnects (they may be read concurrently by the pool)
+    if (!m_statementStats)
+    {
+        m_statementStatsSize = m_stmts.size();
+        m_statementStats = std::make_unique<SQLExecutionStats[]>(m_statementStatsSize);
+    }
+
     return !m_prepareError;
 }
 
+void MySQLConnection::RecordStatementStats(uint32 index, std::chrono::steady_clock::time_point start, uint64 rows)
+{
+    if (index < m_statementStatsSize)
+        m_statementStats[index].Record(std::chrono::steady_clock::now() - start, rows);
+}
+
+std::string MySQLConnection::GetStatementQueryString(uint32 index) const
+{
+    return m_stmts[index]->getQueryString();
+}
+
 bool MySQLConnection::Execute(char const* sql)
 {
     if (!m_Mysql)
@@ -229,6 +258,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
     if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
     {
@@ -256,6 +286,8 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
 
     TC_LOG_DEBUG("sql.sql", "[%u ms] SQL(p): %s", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString().c_str());
 
+    RecordStatementStats(index, start, mysql_stmt_affected_rows(msql_STMT));
+
     m_mStmt->ClearParameters();
     return true;
 }
@@ -403,7 +435,22 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
             {
                 PreparedStatementBase* stmt = data.element.stmt;
                 ASSERT(stmt);
-                if (!Execute(stmt))
+
+                auto last = std::next(itr);
+                while (last != queries.end() && last->type == SQL_ELEMENT_PREPARED && last->element.stmt->GetIndex() == stmt->GetIndex())
+                    ++last;
+
+                bool executed;
+                uint32 count = uint32(std::distance(itr, last));
+                if (count > 1 && IsCoalescable(stmt->GetIndex()))
+                {
+                    executed = ExecuteCoalesced(&*itr, count);
+                    itr = std::prev(last);
+                }
+                else
+                    executed = Execute(stmt);
+
+                if (!executed)
                 {
                     TC_LOG_WARN("sql.sql", "Transaction aborted. %u queries not executed.", (uint32)queries.size());
                     int errorCode = GetLastError();
@@ -437,6 +484,153 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
     return 0;
 }
 
+bool MySQLConnection::ExecuteCoalesced(SQLElementData const* elements, uint32 count)
+{
+    if (!m_Mysql)
+        return false;
+
+    uint32 index = elements[0].element.stmt->GetIndex();
+    uint32 rowParams = std::max<uint32>(GetPreparedStatement(index)->GetParameterCount(), 1);
+    uint32 maxRows = std::min<uint32>(MAX_COALESCED_STATEMENT_ROWS, MAX_PREPARED_STATEMENT_PARAMS / rowParams);
+
+    std::vector<PreparedStatementBase*> rows;
+    rows.reserve(std::min(count, maxRows));
+    for (uint32 offset = 0; offset < count;)
+    {
+        // largest power of two chunk that fits in the remaining rows
+        uint32 chunk = 1;
+        while (chunk * 2 <= std::min(count - offset, maxRows))
+            chunk *= 2;
+
+        MySQLPreparedStatement* m_mStmt = chunk > 1 ? GetCoalescedStatement(index, chunk) : nullptr;
+        if (!m_mStmt)
+        {
+            if (!Execute(elements[offset].element.stmt))
+                return false;
+
+            ++offset;
+            continue;
+        }
+
+        rows.clear();
+        for (uint32 i = 0; i < chunk; ++i)
+            rows.push_back(elements[offset + i].element.stmt);
+
+        m_mStmt->BindParameters(rows.data(), chunk);
+
+        MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
+        MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
+
+        uint32 _s = getMSTime();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        if (mysql_stmt_bind_param(msql_STMT, msql_BIND) || mysql_stmt_execute(msql_STMT))
+        {
+            uint32 lErrno = mysql_errno(m_Mysql);
+            TC_LOG_ERROR("sql.sql", "SQL(p): %s (%u rows)\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), chunk, lErrno, mysql_stmt_error(msql_STMT));
+
+            m_mStmt->ClearParameters();
+
+            if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+                return ExecuteCoalesced(elements + offset, count - offset);       // Try again
+
+            return false;
+        }
+
+        TC_LOG_DEBUG("sql.sql", "[%u ms] SQL(p): %s (%u rows)", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString().c_str(), chunk);
+
+        RecordStatementStats(index, start, mysql_stmt_affected_rows(msql_STMT));
+
+        m_mStmt->ClearParameters();
+        offset += chunk;
+    }
+
+    return true;
+}
+
+bool MySQLConnection::IsCoalescable(uint32 index)
+{
+    auto itr = m_coalescedStmts.find(index);
+    if (itr != m_coalescedStmts.end())
+        return itr->second != nullptr;
+
+    std::unique_ptr<CoalescedStatement>& coalesced = m_coalescedStmts[index];
+    MySQLPreparedStatement* stmt = GetPreparedStatement(index);
+    if (!stmt)
+        return false;
+
+    // only plain "INSERT/REPLACE ... VALUES (...)" statements that end with their single value tuple can take more rows
+    std::string const& sql = stmt->m_queryString;
+    std::string upperSql = sql;
+    strToUpper(upperSql);
+    if (upperSql.compare(0, 6, "INSERT") != 0 && upperSql.compare(0, 7, "REPLACE") != 0)
+        return false;
+
+    std::size_t values = upperSql.rfind("VALUES");
+    std::size_t end = sql.find_last_not_of(" \t\r\n;");
+    if (values == std::string::npos || end == std::string::npos || sql[end] != ')')
+        return false;
+
+    std::size_t open = sql.find_first_not_of(" \t\r\n", values + 6);
+    if (open == std::string::npos || sql[open] != '(')
+        return false;
+
+    int32 depth = 0;
+    for (std::size_t i = open; i <= end; ++i)
+    {
+        if (sql[i] == '(')
+            ++depth;
+        else if (sql[i] == ')' && --depth == 0 && i != end)
+            return false;   // something follows the value tuple, ON DUPLICATE KEY UPDATE or a second tuple
+    }
+
+    coalesced = std::make_unique<CoalescedStatement>();
+    coalesced->Prefix = sql.substr(0, open);
+    coalesced->Values = sql.substr(open, end - open + 1);
+    return true;
+}
+
+MySQLPreparedStatement* MySQLConnection::GetCoalescedStatement(uint32 index, uint32 rows)
+{
+    std::unique_ptr<CoalescedStatement>& coalesced = m_coalescedStmts[index];
+    ASSERT(coalesced);
+
+    std::unique_ptr<MySQLPreparedStatement>& ret = coalesced->Statements[rows];
+    if (ret)
+        return ret.get();
+
+    std::string sql = coalesced->Prefix;
+    sql.reserve(sql.length() + (coalesced->Values.length() + 1) * rows);
+    for (uint32 i = 0; i < rows; ++i)
+    {
+        if (i)
+            sql += ',';
+        sql += coalesced->Values;
+    }
+
+    MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
+    if (!stmt)
+    {
+        TC_LOG_ERROR("sql.sql", "In mysql_stmt_init() id: %u (%u rows), sql: \"%s\"", index, rows, sql.c_str());
+        TC_LOG_ERROR("sql.sql", "%s", mysql_error(m_Mysql));
+        coalesced.reset();
+        return nullptr;
+    }
+
+    if (mysql_stmt_prepare(stmt, sql.c_str(), static_cast<unsigned long>(sql.size())))
+    {
+        TC_LOG_ERROR("sql.sql", "In mysql_stmt_prepare() id: %u (%u rows), sql: \"%s\"", index, rows, sql.c_str());
+        TC_LOG_ERROR("sql.sql", "%s", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        // fall back to executing this statement row by row from now on
+        coalesced.reset();
+        return nullptr;
+    }
+
+    ret = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(stmt), std::move(sql));
+    return ret.get();
+}
+
 size_t MySQLConnection::EscapeString(char* to, const char* from, size_t length)
 {
     return mysql_real_escape_string(m_Mysql, to, from, length);
@@ -484,7 +678,8 @@ void MySQLConnection::PrepareStatement(uint32 index, std::string const& sql, Con
     // Check if specified query should be prepared on this connection
     // i.e. don't prepare async statements on synchronous connections
     // to save memory that will not be used.
-    if (!(m_connectionFlags & flags))
+    // Read replicas only get statements that were explicitly flagged as safe to run there.
+    if (!(m_connectionFlags & flags & CONNECTION_BOTH) || ((m_connectionFlags & CONNECTION_READ_REPLICA) && !(flags & CONNECTION_READ_REPLICA)))
     {
         m_stmts[index].reset();
         return;
@@ -518,6 +713,7 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatementBase* stmt)
     uint64 rowCount = 0;
     uint32 fieldCount = 0;
 
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     if (!_Query(stmt, &mysqlStmt, &result, &rowCount, &fieldCount))
         return nullptr;
 
@@ -525,7 +721,11 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatementBase* stmt)
     {
         mysql_next_result(m_Mysql);
     }
-    return new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+
+    // includes transferring the result set to the client
+    PreparedResultSet* resultSet = new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+    RecordStatementStats(stmt->GetIndex(), start, resultSet->GetRowCount());
+    return resultSet;
 }
 
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
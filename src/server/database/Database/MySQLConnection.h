@@ -20,10 +20,13 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "InstrumentedMutex.h"
+#include "SQLExecutionStats.h"
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 template <typename T>
@@ -32,12 +35,19 @@ class ProducerConsumerQueue;
 class DatabaseWorker;
 class MySQLPreparedStatement;
 class SQLOperation;
+struct SQLElementData;
 
 enum ConnectionFlags
 {
     CONNECTION_ASYNC = 0x1,
     CONNECTION_SYNCH = 0x2,
-    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH
+    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH,
+
+    //! Statement only reads and tolerates replication lag, it is also prepared on read replica connections
+    CONNECTION_READ_REPLICA = 0x4,
+    CONNECTION_ASYNC_REPLICA = CONNECTION_ASYNC | CONNECTION_READ_REPLICA,
+    CONNECTION_SYNCH_REPLICA = CONNECTION_SYNCH | CONNECTION_READ_REPLICA,
+    CONNECTION_BOTH_REPLICA = CONNECTION_BOTH | CONNECTION_READ_REPLICA
 };
 
 struct TC_DATABASE_API MySQLConnectionInfo
@@ -83,6 +93,9 @@ class TC_DATABASE_API MySQLConnection
 
         uint32 GetLastError();
 
+        //! Called by the worker thread of asynchronous connections before executing each operation
+        void RecordQueueWait(std::chrono::steady_clock::duration wait) { m_queueWaitStats.Record(wait, 0); }
+
     protected:
         /// Tries to acquire lock. If lock is acquired by another thread
         /// the calling parent will just try another connection
@@ -95,23 +108,45 @@ class TC_DATABASE_API MySQLConnection
         MySQLPreparedStatement* GetPreparedStatement(uint32 index);
         void PrepareStatement(uint32 index, std::string const& sql, ConnectionFlags flags);
 
+        /// Executes consecutive transaction elements of the same INSERT/REPLACE statement as multi-row statements
+        bool ExecuteCoalesced(SQLElementData const* elements, uint32 count);
+        bool IsCoalescable(uint32 index);
+        MySQLPreparedStatement* GetCoalescedStatement(uint32 index, uint32 rows);
+
+        void RecordStatementStats(uint32 index, std::chrono::steady_clock::time_point start, uint64 rows);
+        std::string GetStatementQueryString(uint32 index) const;
+
+        //! Only statements flagged with CONNECTION_READ_REPLICA will be prepared on this connection
+        void SetReadReplica() { m_connectionFlags = ConnectionFlags(m_connectionFlags | CONNECTION_READ_REPLICA); }
+
         virtual void DoPrepareStatements() = 0;
 
         typedef std::vector<std::unique_ptr<MySQLPreparedStatement>> PreparedStatementContainer;
 
+        struct CoalescedStatement
+        {
+            std::string Prefix;                 //! Query up to the VALUES tuple
+            std::string Values;                 //! Value tuple repeated once per row
+            std::unordered_map<uint32, std::unique_ptr<MySQLPreparedStatement>> Statements;  //! Prepared variants by row count
+        };
+
         PreparedStatementContainer           m_stmts;         //! PreparedStatements storage
+        std::unordered_map<uint32, std::unique_ptr<CoalescedStatement>> m_coalescedStmts;  //! Multi-row variants by statement index, null if the statement cannot be coalesced
+        std::unique_ptr<SQLExecutionStats[]> m_statementStats;      //! Execution statistics by prepared statement index, allocated once
+        std::size_t                          m_statementStatsSize;
+        SQLExecutionStats                    m_queueWaitStats;      //! Time async operations waited before this connection picked them up
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
 
-        ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
+        ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue owned by this asynchronous connection.
         std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
         MySQLHandle*          m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
         ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
-        std::mutex            m_Mutex;
+        Trinity::InstrumentedMutex m_Mutex{ "MySQLConnection" };
 
         MySQLConnection(MySQLConnection const& right) = delete;
         MySQLConnection& operator=(MySQLConnection const& right) = delete;
@@ -63,20 +63,29 @@ MySQLPreparedStatement::~MySQLPreparedStatement()
 
 void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 {
-    m_stmt = stmt;     // Cross reference them for debug output
+    BindParameters(&stmt, 1);
+}
+
+//- Binds the parameters of consecutive rows of a multi-row statement, each row takes the parameters of one statement
+void MySQLPreparedStatement::BindParameters(PreparedStatementBase* const* stmts, uint32 count)
+{
+    m_stmt = stmts[0];     // Cross reference them for debug output
 
-    uint8 pos = 0;
-    for (PreparedStatementData const& data : stmt->GetParameters())
+    uint32 pos = 0;
+    for (uint32 i = 0; i < count; ++i)
     {
-        std::visit([&](auto&& param)
+        for (PreparedStatementData const& data : stmts[i]->GetParameters())
         {
-            SetParameter(pos, param);
-        }, data.data);
-        ++pos;
+            std::visit([&](auto&& param)
+            {
+                SetParameter(pos, param);
+            }, data.data);
+            ++pos;
+        }
     }
 #ifdef _DEBUG
     if (pos < m_paramCount)
-        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement %u did not bind all allocated parameters", stmt->GetIndex());
+        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement %u did not bind all allocated parameters", m_stmt->GetIndex());
 #endif
 }
 
@@ -92,14 +101,14 @@ void MySQLPreparedStatement::ClearParameters()
     }
 }
 
-static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 paramCount)
+static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint32 index, uint32 paramCount)
 {
     TC_LOG_ERROR("sql.driver", "Attempted to bind parameter %u%s on a PreparedStatement %u (statement has only %u parameters)", uint32(index) + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
     return false;
 }
 
 //- Bind on mysql level
-void MySQLPreparedStatement::AssertValidIndex(uint8 index)
+void MySQLPreparedStatement::AssertValidIndex(uint32 index)
 {
     ASSERT(index < m_paramCount || ParamenterIndexAssertFail(m_stmt->GetIndex(), index, m_paramCount));
 
@@ -107,7 +116,7 @@ void MySQLPreparedStatement::AssertValidIndex(uint8 index)
         TC_LOG_ERROR("sql.sql", "[ERROR] Prepared Statement (id: %u) trying to bind value on already bound index (%u).", m_stmt->GetIndex(), index);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::nullptr_t)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -121,13 +130,13 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
     param->length = nullptr;
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, bool value)
+void MySQLPreparedStatement::SetParameter(uint32 index, bool value)
 {
     SetParameter(index, uint8(value ? 1 : 0));
 }
 
 template<typename T>
-void MySQLPreparedStatement::SetParameter(uint8 index, T value)
+void MySQLPreparedStatement::SetParameter(uint32 index, T value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -144,7 +153,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, T value)
     memcpy(param->buffer, &value, len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::string const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -161,7 +170,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
     memcpy(param->buffer, value.c_str(), len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::vector<uint8> const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
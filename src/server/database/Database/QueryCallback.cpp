@@ -105,16 +105,18 @@ private:
 };
 
 // Not using initialization lists to work around segmentation faults when compiling with clang without precompiled headers
-QueryCallback::QueryCallback(std::future<QueryResult>&& result)
+QueryCallback::QueryCallback(std::future<QueryResult>&& result, std::shared_ptr<AsyncCompletionSignal> signal /*= nullptr*/)
 {
     _isPrepared = false;
     Construct(_string, std::move(result));
+    _signal = std::move(signal);
 }
 
-QueryCallback::QueryCallback(std::future<PreparedQueryResult>&& result)
+QueryCallback::QueryCallback(std::future<PreparedQueryResult>&& result, std::shared_ptr<AsyncCompletionSignal> signal /*= nullptr*/)
 {
     _isPrepared = true;
     Construct(_prepared, std::move(result));
+    _signal = std::move(signal);
 }
 
 QueryCallback::QueryCallback(QueryCallback&& right)
@@ -122,6 +124,8 @@ QueryCallback::QueryCallback(QueryCallback&& right)
     _isPrepared = right._isPrepared;
     ConstructActiveMember(this);
     MoveFrom(this, std::move(right));
+    _signal = std::move(right._signal);
+    _listener = std::move(right._listener);
     _callbacks = std::move(right._callbacks);
 }
 
@@ -136,6 +140,8 @@ QueryCallback& QueryCallback::operator=(QueryCallback&& right)
             ConstructActiveMember(this);
         }
         MoveFrom(this, std::move(right));
+        _signal = std::move(right._signal);
+        _listener = std::move(right._listener);
         _callbacks = std::move(right._callbacks);
     }
     return *this;
@@ -173,6 +179,16 @@ QueryCallback&& QueryCallback::WithChainingPreparedCallback(std::function<void(Q
 void QueryCallback::SetNextQuery(QueryCallback&& next)
 {
     MoveFrom(this, std::move(next));
+    _signal = std::move(next._signal);
+    if (_signal && _listener)
+        _signal->Listen(_listener);
+}
+
+void QueryCallback::SetCompletionListener(AsyncCompletionListener const& listener)
+{
+    _listener = listener;
+    if (_signal)
+        _signal->Listen(_listener);
 }
 
 bool QueryCallback::InvokeIfReady()
@@ -19,6 +19,7 @@
 #define _QUERY_CALLBACK_H
 
 #include "Define.h"
+#include "AsyncCallbackProcessor.h"
 #include "DatabaseEnvFwd.h"
 #include <functional>
 #include <future>
@@ -29,8 +30,8 @@
 class TC_DATABASE_API QueryCallback
 {
 public:
-    explicit QueryCallback(QueryResultFuture&& result);
-    explicit QueryCallback(PreparedQueryResultFuture&& result);
+    explicit QueryCallback(QueryResultFuture&& result, std::shared_ptr<AsyncCompletionSignal> signal = nullptr);
+    explicit QueryCallback(PreparedQueryResultFuture&& result, std::shared_ptr<AsyncCompletionSignal> signal = nullptr);
     QueryCallback(QueryCallback&& right);
     QueryCallback& operator=(QueryCallback&& right);
     ~QueryCallback();
@@ -47,6 +48,10 @@ public:
     // returns true when completed
     bool InvokeIfReady();
 
+    // Wakes the listener when the result of the current query in the chain arrives
+    void SetCompletionListener(AsyncCompletionListener const& listener);
+    bool HasCompletionSignal() const { return _signal != nullptr; }
+
 private:
     QueryCallback(QueryCallback const& right) = delete;
     QueryCallback& operator=(QueryCallback const& right) = delete;
@@ -61,6 +66,8 @@ private:
         PreparedQueryResultFuture _prepared;
     };
     bool _isPrepared;
+    std::shared_ptr<AsyncCompletionSignal> _signal;
+    AsyncCompletionListener _listener;
 
     struct QueryCallbackData;
     std::queue<QueryCallbackData, std::list<QueryCallbackData>> _callbacks;
@@ -22,6 +22,7 @@
 
 class TC_DATABASE_API SQLQueryHolderBase
 {
+    template <class T> friend class DatabaseWorkerPool;
     friend class SQLQueryHolderTask;
     private:
         std::vector<std::pair<PreparedStatementBase*, PreparedQueryResult>> m_queries;
@@ -66,7 +67,7 @@ class TC_DATABASE_API SQLQueryHolderTask : public SQLOperation
 class TC_DATABASE_API SQLQueryHolderCallback
 {
 public:
-    SQLQueryHolderCallback(QueryResultHolderFuture&& future) : m_future(std::move(future)) { }
+    SQLQueryHolderCallback(QueryResultHolderFuture&& future, std::shared_ptr<AsyncCompletionSignal> signal = nullptr) : m_future(std::move(future)), m_signal(std::move(signal)) { }
     SQLQueryHolderCallback(SQLQueryHolderCallback&&) = default;
 
     SQLQueryHolderCallback& operator=(SQLQueryHolderCallback&&) = default;
@@ -78,7 +79,16 @@ public:
 
     bool InvokeIfReady();
 
+    void SetCompletionListener(AsyncCompletionListener const& listener)
+    {
+        if (m_signal)
+            m_signal->Listen(listener);
+    }
+
+    bool HasCompletionSignal() const { return m_signal != nullptr; }
+
     QueryResultHolderFuture m_future;
+    std::shared_ptr<AsyncCompletionSignal> m_signal;
     std::function<void(SQLQueryHolderBase*)> m_callback;
 };
 
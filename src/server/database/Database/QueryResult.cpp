@@ -74,6 +74,22 @@ static uint32 SizeForType(MYSQL_FIELD* field)
     }
 }
 
+static bool IsVariableLengthType(enum_field_types type)
+{
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+            return true;
+        default:
+            return false;
+    }
+}
+
 DatabaseFieldTypes MysqlTypeToFieldType(enum_field_types type)
 {
     switch (type)
@@ -168,7 +184,8 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotPosition(0)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -179,13 +196,29 @@ _fields(fields)
     }
 }
 
+ResultSet::ResultSet(std::vector<QueryResultFieldMetadata>&& fieldMetadata, uint64 rowCount, std::shared_ptr<std::vector<char> const> snapshot, std::size_t rowDataOffset) :
+_fieldMetadata(std::move(fieldMetadata)),
+_rowCount(rowCount),
+_fieldCount(uint32(_fieldMetadata.size())),
+_result(nullptr),
+_fields(nullptr),
+_snapshot(std::move(snapshot)),
+_snapshotPosition(rowDataOffset)
+{
+    _currentRow = new Field[_fieldCount];
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currentRow[i].SetMetadata(&_fieldMetadata[i]);
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
 m_fieldCount(fieldCount),
 m_rBind(nullptr),
 m_stmt(stmt),
-m_metadataResult(result)
+m_metadataResult(result),
+m_variableDataBlockSize(0),
+m_variableDataBlockUsed(0)
 {
     if (!m_metadataResult)
         return;
@@ -221,12 +254,17 @@ m_metadataResult(result)
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
     //- This is where we prepare the buffer based on metadata
+    //- Fixed size columns are fetched directly into one contiguous buffer (one stride per row)
+    //- Variable length columns are bound with an empty buffer and fetched separately into the packed arena,
+    //- so their storage is sized by each value instead of by the longest value in the column
     MySQLField* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(m_metadataResult));
     m_fieldMetadata.resize(m_fieldCount);
+    std::vector<bool> isVariableLength(m_fieldCount, false);
     std::size_t rowSize = 0;
     for (uint32 i = 0; i < m_fieldCount; ++i)
     {
-        uint32 size = SizeForType(&field[i]);
+        isVariableLength[i] = IsVariableLengthType(field[i].type);
+        uint32 size = isVariableLength[i] ? 0 : SizeForType(&field[i]);
         rowSize += size;
 
         InitializeDatabaseFieldMetadata(&m_fieldMetadata[i], &field[i], i);
@@ -239,10 +277,13 @@ m_metadataResult(result)
         m_rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
     }
 
-    char* dataBuffer = new char[rowSize * m_rowCount];
+    m_fixedData = std::make_unique<char[]>(rowSize * m_rowCount);
     for (uint32 i = 0, offset = 0; i < m_fieldCount; ++i)
     {
-        m_rBind[i].buffer = dataBuffer + offset;
+        if (isVariableLength[i])
+            continue;
+
+        m_rBind[i].buffer = m_fixedData.get() + offset;
         offset += m_rBind[i].buffer_length;
     }
 
@@ -262,45 +303,42 @@ m_metadataResult(result)
     {
         for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetMetadata(&m_fieldMetadata[fIndex]);
+            Field& value = m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex];
+            value.SetMetadata(&m_fieldMetadata[fIndex]);
 
-            unsigned long buffer_length = m_rBind[fIndex].buffer_length;
             unsigned long fetched_length = *m_rBind[fIndex].length;
-            if (!*m_rBind[fIndex].is_null)
+            if (*m_rBind[fIndex].is_null)
             {
-                void* buffer = m_stmt->bind[fIndex].buffer;
-                switch (m_rBind[fIndex].buffer_type)
+                value.SetByteValue(nullptr, fetched_length);
+                continue;
+            }
+
+            if (isVariableLength[fIndex])
+            {
+                // allocate one extra byte so the value is always null-terminated for Field::GetCString
+                char* buffer = AllocateVariableData(fetched_length + 1);
+                if (fetched_length)
                 {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                        // warning - the string will not be null-terminated if there is no space for it in the buffer
-                        // when mysql_stmt_fetch returned MYSQL_DATA_TRUNCATED
-                        // we cannot blindly null-terminate the data either as it may be retrieved as binary blob and not specifically a string
-                        // in this case using Field::GetCString will result in garbage
-                        // TODO: remove Field::GetCString and use std::string_view in C++17
-                        if (fetched_length < buffer_length)
-                            *((char*)buffer + fetched_length) = '\0';
-                        break;
-                    default:
-                        break;
+                    MySQLBind column;
+                    memset(&column, 0, sizeof(MySQLBind));
+                    column.buffer_type = m_rBind[fIndex].buffer_type;
+                    column.buffer = buffer;
+                    column.buffer_length = fetched_length;
+                    column.is_unsigned = m_rBind[fIndex].is_unsigned;
+                    if (mysql_stmt_fetch_column(m_stmt, &column, fIndex, 0))
+                        TC_LOG_WARN("sql.sql", "%s:mysql_stmt_fetch_column, cannot fetch column %u. Error: %s", __FUNCTION__, fIndex, mysql_stmt_error(m_stmt));
                 }
+                buffer[fetched_length] = '\0';
 
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                    (char const*)buffer,
-                    fetched_length);
-
-                // move buffer pointer to next part
-                m_stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
+                value.SetByteValue(buffer, fetched_length);
             }
             else
             {
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                    nullptr,
-                    *m_rBind[fIndex].length);
+                void* buffer = m_stmt->bind[fIndex].buffer;
+                value.SetByteValue((char const*)buffer, fetched_length);
+
+                // move buffer pointer to next part
+                m_stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
             }
         }
         m_rowPosition++;
@@ -325,6 +363,9 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshot)
+        return NextSnapshotRow();
+
     if (!_result)
         return false;
 
@@ -349,6 +390,35 @@ bool ResultSet::NextRow()
     return true;
 }
 
+bool ResultSet::NextSnapshotRow()
+{
+    //- Snapshot rows are stored as uint32 length followed by the text of the value and a null terminator (see ResultSnapshotStore)
+    //- The buffer layout was validated when the snapshot was loaded
+    if (_snapshotPosition >= _snapshot->size())
+    {
+        CleanUp();
+        return false;
+    }
+
+    char const* data = _snapshot->data();
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        uint32 length;
+        memcpy(&length, data + _snapshotPosition, sizeof(length));
+        _snapshotPosition += sizeof(length);
+        if (length == NullSnapshotValueLength)
+        {
+            _currentRow[i].SetStructuredValue(nullptr, 0);
+            continue;
+        }
+
+        _currentRow[i].SetStructuredValue(data + _snapshotPosition, length);
+        _snapshotPosition += length + 1;
+    }
+
+    return true;
+}
+
 bool PreparedResultSet::NextRow()
 {
     /// Only updates the m_rowPosition so upper level code knows in which element
@@ -378,6 +448,8 @@ void ResultSet::CleanUp()
         _currentRow = nullptr;
     }
 
+    _snapshot.reset();
+
     if (_result)
     {
         mysql_free_result(_result);
@@ -392,12 +464,25 @@ void PreparedResultSet::CleanUp()
 
     if (m_rBind)
     {
-        delete[](char*)m_rBind->buffer;
         delete[] m_rBind;
         m_rBind = nullptr;
     }
 }
 
+char* PreparedResultSet::AllocateVariableData(std::size_t size)
+{
+    if (m_variableData.empty() || m_variableDataBlockUsed + size > m_variableDataBlockSize)
+    {
+        m_variableDataBlockSize = std::max(size, VariableDataBlockSize);
+        m_variableDataBlockUsed = 0;
+        m_variableData.push_back(std::make_unique<char[]>(m_variableDataBlockSize));
+    }
+
+    char* data = m_variableData.back().get() + m_variableDataBlockUsed;
+    m_variableDataBlockUsed += size;
+    return data;
+}
+
 Field const& ResultSet::operator[](std::size_t index) const
 {
     ASSERT(index < _fieldCount);
@@ -416,3 +501,19 @@ Field const& PreparedResultSet::operator[](std::size_t index) const
     ASSERT(index < m_fieldCount);
     return m_rows[uint32(m_rowPosition) * m_fieldCount + index];
 }
+
+PreparedResultSet::RowIterator& PreparedResultSet::RowIterator::operator++()
+{
+    _row += _fieldCount;
+    return *this;
+}
+
+PreparedResultSet::RowIterator PreparedResultSet::begin() const
+{
+    return RowIterator(m_rows.data(), m_fieldCount);
+}
+
+PreparedResultSet::RowIterator PreparedResultSet::end() const
+{
+    return RowIterator(m_rows.data() + m_rows.size(), m_fieldCount);
+}
@@ -20,12 +20,15 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
 #include <vector>
 
 class TC_DATABASE_API ResultSet
 {
     public:
         ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+        //! Reads rows stored by ResultSnapshotStore, field values reference the snapshot buffer directly
+        ResultSet(std::vector<QueryResultFieldMetadata>&& fieldMetadata, uint64 rowCount, std::shared_ptr<std::vector<char> const> snapshot, std::size_t rowDataOffset);
         ~ResultSet();
 
         bool NextRow();
@@ -35,6 +38,9 @@ class TC_DATABASE_API ResultSet
         Field* Fetch() const { return _currentRow; }
         Field const& operator[](std::size_t index) const;
 
+        //! Length marker of NULL values in snapshot row data
+        static constexpr uint32 NullSnapshotValueLength = 0xFFFFFFFF;
+
     protected:
         std::vector<QueryResultFieldMetadata> _fieldMetadata;
         uint64 _rowCount;
@@ -42,9 +48,14 @@ class TC_DATABASE_API ResultSet
         uint32 _fieldCount;
 
     private:
+        friend class ResultSnapshotStore;
+
         void CleanUp();
+        bool NextSnapshotRow();
         MySQLResult* _result;
         MySQLField* _fields;
+        std::shared_ptr<std::vector<char> const> _snapshot;
+        std::size_t _snapshotPosition;
 
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
@@ -63,6 +74,24 @@ class TC_DATABASE_API PreparedResultSet
         Field* Fetch() const;
         Field const& operator[](std::size_t index) const;
 
+        class RowIterator
+        {
+            public:
+                RowIterator(Field const* row, uint32 fieldCount) : _row(row), _fieldCount(fieldCount) { }
+
+                Field const* operator*() const { return _row; }
+                RowIterator& operator++();
+                bool operator!=(RowIterator const& right) const { return _row != right._row; }
+
+            private:
+                Field const* _row;
+                uint32 _fieldCount;
+        };
+
+        //! Iterates all rows independently of the NextRow() cursor: for (Field const* fields : *result)
+        RowIterator begin() const;
+        RowIterator end() const;
+
     protected:
         std::vector<QueryResultFieldMetadata> m_fieldMetadata;
         std::vector<Field> m_rows;
@@ -75,7 +104,15 @@ class TC_DATABASE_API PreparedResultSet
         MySQLStmt* m_stmt;
         MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
 
+        static constexpr std::size_t VariableDataBlockSize = 64 * 1024;
+
+        std::unique_ptr<char[]> m_fixedData;                     ///< Fixed size columns of all rows, one stride per row
+        std::vector<std::unique_ptr<char[]>> m_variableData;     ///< Packed string and blob values, referenced by Field
+        std::size_t m_variableDataBlockSize;
+        std::size_t m_variableDataBlockUsed;
+
         void CleanUp();
+        char* AllocateVariableData(std::size_t size);
         bool _NextRow();
 
         PreparedResultSet(PreparedResultSet const& right) = delete;
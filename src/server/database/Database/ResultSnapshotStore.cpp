@@ -0,0 +1,267 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ResultSnapshotStore.h"
+#include "CryptoHash.h"
+#include "Field.h"
+#include "Log.h"
+#include "QueryResult.h"
+#include "Util.h"
+#include <boost/filesystem/operations.hpp>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+uint32 const SnapshotMagic = 0x53524354; // TCRS
+uint32 const SnapshotVersion = 1;
+
+class SnapshotWriter
+{
+public:
+    explicit SnapshotWriter(std::vector<char>& data) : _data(data) { }
+
+    template<typename T>
+    void Write(T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        char const* bytes = reinterpret_cast<char const*>(&value);
+        _data.insert(_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    //! Strings are always followed by a null terminator so they can be referenced in place
+    void WriteString(char const* str, uint32 length)
+    {
+        Write(length);
+        _data.insert(_data.end(), str, str + length);
+        _data.push_back('\0');
+    }
+
+    void WriteString(char const* str) { WriteString(str ? str : "", str ? uint32(strlen(str)) : 0); }
+
+private:
+    std::vector<char>& _data;
+};
+
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(std::vector<char> const& data) : _data(data), _position(0) { }
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        if (_data.size() - _position < sizeof(T))
+            return false;
+
+        memcpy(&value, _data.data() + _position, sizeof(T));
+        _position += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(char const*& str, uint32& length)
+    {
+        if (!Read(length) || length == ResultSet::NullSnapshotValueLength || _data.size() - _position < std::size_t(length) + 1)
+            return false;
+
+        str = _data.data() + _position;
+        _position += length + 1;
+        return true;
+    }
+
+    bool ReadString(char const*& str)
+    {
+        uint32 length;
+        return ReadString(str, length);
+    }
+
+    //! Field values are strings that may be NULL
+    bool SkipValue()
+    {
+        uint32 length;
+        if (!Read(length))
+            return false;
+
+        if (length == ResultSet::NullSnapshotValueLength)
+            return true;
+
+        if (_data.size() - _position < std::size_t(length) + 1)
+            return false;
+
+        _position += length + 1;
+        return true;
+    }
+
+    std::size_t GetPosition() const { return _position; }
+    bool IsAtEnd() const { return _position == _data.size(); }
+
+private:
+    std::vector<char> const& _data;
+    std::size_t _position;
+};
+}
+
+ResultSnapshotStore* ResultSnapshotStore::instance()
+{
+    static ResultSnapshotStore instance;
+    return &instance;
+}
+
+void ResultSnapshotStore::Initialize(std::string const& directory, std::string const& versionKey)
+{
+    boost::system::error_code error;
+    boost::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        TC_LOG_ERROR("sql.driver", "ResultSnapshotStore: cannot create snapshot directory %s (%s), snapshots are disabled.", directory.c_str(), error.message().c_str());
+        return;
+    }
+
+    _directory = directory;
+    _versionKey = versionKey;
+}
+
+void ResultSnapshotStore::Close()
+{
+    _directory.clear();
+    _versionKey.clear();
+}
+
+std::string ResultSnapshotStore::GetPath(char const* sql) const
+{
+    return (boost::filesystem::path(_directory) / (ByteArrayToHexStr(Trinity::Crypto::SHA1::GetDigestOf(sql)) + ".snapshot")).string();
+}
+
+QueryResult ResultSnapshotStore::Load(char const* sql) const
+{
+    std::ifstream file(GetPath(sql), std::ios::in | std::ios::binary);
+    if (!file)
+        return QueryResult(nullptr);
+
+    std::shared_ptr<std::vector<char>> data = std::make_shared<std::vector<char>>();
+    file.seekg(0, std::ios::end);
+    data->resize(std::size_t(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    if (!file.read(data->data(), data->size()))
+        return QueryResult(nullptr);
+
+    return Parse(std::move(data), sql);
+}
+
+QueryResult ResultSnapshotStore::Parse(std::shared_ptr<std::vector<char>> data, char const* sql) const
+{
+    SnapshotReader reader(*data);
+
+    uint32 magic, version;
+    if (!reader.Read(magic) || magic != SnapshotMagic || !reader.Read(version) || version != SnapshotVersion)
+        return QueryResult(nullptr);
+
+    char const* versionKey;
+    char const* query;
+    if (!reader.ReadString(versionKey) || _versionKey != versionKey || !reader.ReadString(query) || strcmp(query, sql) != 0)
+        return QueryResult(nullptr);
+
+    uint32 fieldCount;
+    uint64 rowCount;
+    if (!reader.Read(fieldCount) || !reader.Read(rowCount) || !fieldCount || !rowCount)
+        return QueryResult(nullptr);
+
+    std::vector<QueryResultFieldMetadata> metadata(fieldCount);
+    for (QueryResultFieldMetadata& field : metadata)
+    {
+        uint8 type;
+        if (!reader.Read(type) || !reader.Read(field.Index)
+            || !reader.ReadString(field.TableName) || !reader.ReadString(field.TableAlias)
+            || !reader.ReadString(field.Name) || !reader.ReadString(field.Alias) || !reader.ReadString(field.TypeName))
+            return QueryResult(nullptr);
+
+        field.Type = DatabaseFieldTypes(type);
+    }
+
+    // validate all rows once so ResultSet can walk them without bounds checks
+    std::size_t rowDataOffset = reader.GetPosition();
+    for (uint64 row = 0; row < rowCount; ++row)
+        for (uint32 field = 0; field < fieldCount; ++field)
+            if (!reader.SkipValue())
+                return QueryResult(nullptr);
+
+    if (!reader.IsAtEnd())
+        return QueryResult(nullptr);
+
+    QueryResult result = std::make_shared<ResultSet>(std::move(metadata), rowCount, std::move(data), rowDataOffset);
+    result->NextRow();
+    return result;
+}
+
+QueryResult ResultSnapshotStore::Store(char const* sql, QueryResult result) const
+{
+    if (!result)
+        return result;
+
+    std::shared_ptr<std::vector<char>> data = std::make_shared<std::vector<char>>();
+    SnapshotWriter writer(*data);
+    writer.Write(SnapshotMagic);
+    writer.Write(SnapshotVersion);
+    writer.WriteString(_versionKey.c_str(), uint32(_versionKey.length()));
+    writer.WriteString(sql);
+    writer.Write(result->GetFieldCount());
+    writer.Write(result->GetRowCount());
+
+    for (QueryResultFieldMetadata const& field : result->_fieldMetadata)
+    {
+        writer.Write(uint8(field.Type));
+        writer.Write(field.Index);
+        writer.WriteString(field.TableName);
+        writer.WriteString(field.TableAlias);
+        writer.WriteString(field.Name);
+        writer.WriteString(field.Alias);
+        writer.WriteString(field.TypeName);
+    }
+
+    do
+    {
+        Field* fields = result->Fetch();
+        for (uint32 i = 0; i < result->GetFieldCount(); ++i)
+        {
+            if (fields[i].IsNull())
+                writer.Write(ResultSet::NullSnapshotValueLength);
+            else
+                writer.WriteString(fields[i].data.value, fields[i].data.length);
+        }
+    } while (result->NextRow());
+
+    std::string path = GetPath(sql);
+    std::string temporaryPath = path + ".tmp";
+    bool written;
+    {
+        std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        written = bool(file.write(data->data(), data->size()));
+    }
+
+    boost::system::error_code error;
+    if (written)
+        boost::filesystem::rename(temporaryPath, path, error);
+
+    if (!written || error)
+    {
+        TC_LOG_ERROR("sql.driver", "ResultSnapshotStore: cannot write snapshot %s.", path.c_str());
+        boost::filesystem::remove(temporaryPath, error);
+    }
+
+    // the original result set was consumed while writing, hand out rows from the in-memory snapshot instead
+    return Parse(std::move(data), sql);
+}
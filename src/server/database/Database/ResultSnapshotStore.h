@@ -0,0 +1,78 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _RESULTSNAPSHOTSTORE_H
+#define _RESULTSNAPSHOTSTORE_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include "DatabaseWorkerPool.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+    @class ResultSnapshotStore
+
+    @brief Caches results of large ad hoc startup queries in versioned binary files
+
+    A snapshot is written after a query was successfully executed and served on the next start
+    instead of querying the database, as long as the version key (built from the applied database
+    updates) did not change. Snapshot rows keep the text representation of the MySQL client library
+    so Field behaves exactly like for results coming from the database.
+*/
+class TC_DATABASE_API ResultSnapshotStore
+{
+    public:
+        static ResultSnapshotStore* instance();
+
+        //! Enables snapshots stored in directory. versionKey must change whenever database content changes.
+        void Initialize(std::string const& directory, std::string const& versionKey);
+
+        //! Disables snapshots, following queries always go to the database (used once startup is done so reloads see live data)
+        void Close();
+
+        bool IsEnabled() const { return !_directory.empty(); }
+
+        //! Executes an ad hoc query, serving it from its snapshot when possible and writing the snapshot otherwise
+        template<class T>
+        QueryResult Query(DatabaseWorkerPool<T>& database, char const* sql)
+        {
+            if (!IsEnabled())
+                return database.Query(sql);
+
+            if (QueryResult result = Load(sql))
+                return result;
+
+            return Store(sql, database.Query(sql));
+        }
+
+    private:
+        ResultSnapshotStore() = default;
+
+        std::string GetPath(char const* sql) const;
+        QueryResult Load(char const* sql) const;
+        QueryResult Store(char const* sql, QueryResult result) const;
+        QueryResult Parse(std::shared_ptr<std::vector<char>> data, char const* sql) const;
+
+        std::string _directory;
+        std::string _versionKey;
+};
+
+#define sResultSnapshotStore ResultSnapshotStore::instance()
+
+#endif
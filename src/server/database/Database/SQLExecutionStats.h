@@ -0,0 +1,96 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SQLEXECUTIONSTATS_H
+#define _SQLEXECUTIONSTATS_H
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+//! Log2 microsecond latency buckets, bucket N holds values up to 2^N - 1 us and the last one everything above
+#define SQL_LATENCY_BUCKET_COUNT 21
+
+//! Plain copy of SQLExecutionStats, also used to aggregate several connections
+struct SQLExecutionStatsData
+{
+    uint64 Count = 0;
+    uint64 Rows = 0;
+    uint64 TotalMicroseconds = 0;
+    uint64 MaxMicroseconds = 0;
+    std::array<uint64, SQL_LATENCY_BUCKET_COUNT> LatencyBuckets = { };
+
+    void Merge(SQLExecutionStatsData const& other)
+    {
+        Count += other.Count;
+        Rows += other.Rows;
+        TotalMicroseconds += other.TotalMicroseconds;
+        MaxMicroseconds = std::max(MaxMicroseconds, other.MaxMicroseconds);
+        for (std::size_t i = 0; i < SQL_LATENCY_BUCKET_COUNT; ++i)
+            LatencyBuckets[i] += other.LatencyBuckets[i];
+    }
+};
+
+//! Statistics of one statement on one connection. Written only by the thread owning the connection,
+//! atomics allow other threads to read them at any time.
+struct SQLExecutionStats
+{
+    std::atomic<uint64> Count{ 0 };
+    std::atomic<uint64> Rows{ 0 };
+    std::atomic<uint64> TotalMicroseconds{ 0 };
+    std::atomic<uint64> MaxMicroseconds{ 0 };
+    std::array<std::atomic<uint64>, SQL_LATENCY_BUCKET_COUNT> LatencyBuckets = { };
+
+    static std::size_t GetLatencyBucket(uint64 microseconds)
+    {
+        std::size_t bucket = 0;
+        while (microseconds && bucket < SQL_LATENCY_BUCKET_COUNT - 1)
+        {
+            microseconds >>= 1;
+            ++bucket;
+        }
+
+        return bucket;
+    }
+
+    void Record(std::chrono::steady_clock::duration elapsed, uint64 rows)
+    {
+        uint64 microseconds = uint64(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+        Count.fetch_add(1, std::memory_order_relaxed);
+        Rows.fetch_add(rows, std::memory_order_relaxed);
+        TotalMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+        if (microseconds > MaxMicroseconds.load(std::memory_order_relaxed))
+            MaxMicroseconds.store(microseconds, std::memory_order_relaxed);
+        LatencyBuckets[GetLatencyBucket(microseconds)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SQLExecutionStatsData Load() const
+    {
+        SQLExecutionStatsData data;
+        data.Count = Count.load(std::memory_order_relaxed);
+        data.Rows = Rows.load(std::memory_order_relaxed);
+        data.TotalMicroseconds = TotalMicroseconds.load(std::memory_order_relaxed);
+        data.MaxMicroseconds = MaxMicroseconds.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < SQL_LATENCY_BUCKET_COUNT; ++i)
+            data.LatencyBuckets[i] = LatencyBuckets[i].load(std::memory_order_relaxed);
+        return data;
+    }
+};
+
+#endif
@@ -19,7 +19,9 @@
 #define _SQLOPERATION_H
 
 #include "Define.h"
+#include "AsyncCallbackProcessor.h"
 #include "DatabaseEnvFwd.h"
+#include <chrono>
 
 //- Union that holds element data
 union SQLElementUnion
@@ -54,7 +56,7 @@ class MySQLConnection;
 class TC_DATABASE_API SQLOperation
 {
     public:
-        SQLOperation(): m_conn(nullptr) { }
+        SQLOperation(): m_conn(nullptr), m_queuedTime(std::chrono::steady_clock::now()) { }
         virtual ~SQLOperation() { }
 
         virtual int call()
@@ -65,9 +67,25 @@ class TC_DATABASE_API SQLOperation
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! Operations are enqueued right after being created, used to measure time spent waiting for a connection
+        std::chrono::steady_clock::time_point GetQueuedTime() const { return m_queuedTime; }
+
+        //! Signal notified by the worker thread after the operation was executed, must be requested before enqueueing
+        std::shared_ptr<AsyncCompletionSignal> GetCompletionSignal()
+        {
+            if (!m_completionSignal)
+                m_completionSignal = std::make_shared<AsyncCompletionSignal>();
+            return m_completionSignal;
+        }
+
+        std::shared_ptr<AsyncCompletionSignal> TakeCompletionSignal() { return std::move(m_completionSignal); }
+
         MySQLConnection* m_conn;
 
     private:
+        std::chrono::steady_clock::time_point m_queuedTime;
+        std::shared_ptr<AsyncCompletionSignal> m_completionSignal;
+
         SQLOperation(SQLOperation const& right) = delete;
         SQLOperation& operator=(SQLOperation const& right) = delete;
 };
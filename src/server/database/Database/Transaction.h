@@ -43,7 +43,8 @@ class TC_DATABASE_API TransactionBase
         template<typename Format, typename... Args>
         void PAppend(Format&& sql, Args&&... args)
         {
-            Append(Trinity::StringFormat(std::forward<Format>(sql), std::forward<Args>(args)...).c_str());
+            Trinity::FormatBuffer buffer;
+            Append(Trinity::StringFormatTo(buffer, std::forward<Format>(sql), std::forward<Args>(args)...));
         }
 
         std::size_t GetSize() const { return m_queries.size(); }
@@ -104,7 +105,7 @@ protected:
 class TC_DATABASE_API TransactionCallback
 {
 public:
-    TransactionCallback(TransactionFuture&& future) : m_future(std::move(future)) { }
+    TransactionCallback(TransactionFuture&& future, std::shared_ptr<AsyncCompletionSignal> signal = nullptr) : m_future(std::move(future)), m_signal(std::move(signal)) { }
     TransactionCallback(TransactionCallback&&) = default;
 
     TransactionCallback& operator=(TransactionCallback&&) = default;
@@ -116,7 +117,16 @@ public:
 
     bool InvokeIfReady();
 
+    void SetCompletionListener(AsyncCompletionListener const& listener)
+    {
+        if (m_signal)
+            m_signal->Listen(listener);
+    }
+
+    bool HasCompletionSignal() const { return m_signal != nullptr; }
+
     TransactionFuture m_future;
+    std::shared_ptr<AsyncCompletionSignal> m_signal;
     std::function<void(bool)> m_callback;
 };
 
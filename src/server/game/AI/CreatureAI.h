@@ -23,6 +23,7 @@
 #include "ObjectDefines.h"
 #include "Optional.h"
 #include "QuestDef.h"
+#include "TransientObjectPool.h"
 #include "UnitAI.h"
 
 class AreaBoundary;
@@ -82,6 +83,8 @@ class TC_GAME_API CreatureAI : public UnitAI
 
         virtual ~CreatureAI();
 
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
         // Gets the id of the AI (script id)
         uint32 GetId() const { return _scriptId; }
 
@@ -217,7 +217,7 @@ class TC_GAME_API SmartAI : public CreatureAI
         uint32 _escortState;
         uint32 _escortNPCFlags;
         uint32 _escortInvokerCheckTimer;
-        WaypointPath _path;
+        WaypointPath const* _path;
         uint32 _currentWaypointNode;
         bool _waypointReached;
         uint32 _waypointPauseTimer;
@@ -24,6 +24,7 @@
 #include "DB2Stores.h"
 #include "GameEventMgr.h"
 #include "GameObject.h"
+#include "GameTime.h"
 #include "GossipDef.h"
 #include "GridNotifiersImpl.h"
 #include "Group.h"
@@ -64,6 +65,7 @@ SmartScript::SmartScript()
     mCurrentPriority = 0;
     mEventSortingRequired = false;
     mNestedEventsCounter = 0;
+    mEventIndexDirty = false;
 }
 
 SmartScript::~SmartScript()
@@ -243,15 +245,20 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
     }
     else
     {
-        for (SmartScriptHolder& event : mEvents)
+        // mEvents is only changed outside of event processing, so the index can't be rebuilt by a nested call
+        if (mEventIndexDirty)
+            RebuildEventIndex();
+
+        auto range = std::equal_range(mEventIndex.begin(), mEventIndex.end(), std::make_pair(uint32(e), 0u), [](std::pair<uint32, uint32> const& left, std::pair<uint32, uint32> const& right)
         {
-            SMART_EVENT eventType = SMART_EVENT(event.GetEventType());
-            if (eventType == SMART_EVENT_LINK)//special handling
-                continue;
+            return left.first < right.first;
+        });
 
-            if (eventType == e)
-                if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
-                    ProcessEvent(event, unit, var0, var1, bvar, spell, gob, varString);
+        for (auto itr = range.first; itr != range.second; ++itr)
+        {
+            SmartScriptHolder& event = mEvents[itr->second];
+            if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
+                ProcessEvent(event, unit, var0, var1, bvar, spell, gob, varString);
         }
     }
 
@@ -2812,8 +2819,8 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
                 break;
             }
 
-            ObjectVector units;
-            GetWorldObjectsInDist(units, static_cast<float>(e.target.unitRange.maxDist));
+            ObjectVector& units = _worldObjectSearchBuffer;
+            GetWorldObjectsInDist(units, static_cast<float>(e.target.unitRange.maxDist), GRID_MAP_TYPE_MASK_CREATURE);
 
             for (WorldObject* unit : units)
             {
@@ -2833,8 +2840,8 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_CREATURE_DISTANCE:
         {
-            ObjectVector units;
-            GetWorldObjectsInDist(units, static_cast<float>(e.target.unitDistance.dist));
+            ObjectVector& units = _worldObjectSearchBuffer;
+            GetWorldObjectsInDist(units, static_cast<float>(e.target.unitDistance.dist), GRID_MAP_TYPE_MASK_CREATURE);
 
             for (WorldObject* unit : units)
             {
@@ -2854,8 +2861,8 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
         {
-            ObjectVector units;
-            GetWorldObjectsInDist(units, static_cast<float>(e.target.goDistance.dist));
+            ObjectVector& units = _worldObjectSearchBuffer;
+            GetWorldObjectsInDist(units, static_cast<float>(e.target.goDistance.dist), GRID_MAP_TYPE_MASK_GAMEOBJECT);
 
             for (WorldObject* unit : units)
             {
@@ -2886,8 +2893,8 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
                 break;
             }
 
-            ObjectVector units;
-            GetWorldObjectsInDist(units, static_cast<float>(e.target.goRange.maxDist));
+            ObjectVector& units = _worldObjectSearchBuffer;
+            GetWorldObjectsInDist(units, static_cast<float>(e.target.goRange.maxDist), GRID_MAP_TYPE_MASK_GAMEOBJECT);
 
             for (WorldObject* unit : units)
             {
@@ -2935,8 +2942,8 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_PLAYER_RANGE:
         {
-            ObjectVector units;
-            GetWorldObjectsInDist(units, static_cast<float>(e.target.playerRange.maxDist));
+            ObjectVector& units = _worldObjectSearchBuffer;
+            GetWorldObjectsInDist(units, static_cast<float>(e.target.playerRange.maxDist), GRID_MAP_TYPE_MASK_PLAYER);
 
             if (!units.empty() && baseObject)
                 for (WorldObject* unit : units)
@@ -2946,8 +2953,8 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_PLAYER_DISTANCE:
         {
-            ObjectVector units;
-            GetWorldObjectsInDist(units, static_cast<float>(e.target.playerDistance.dist));
+            ObjectVector& units = _worldObjectSearchBuffer;
+            GetWorldObjectsInDist(units, static_cast<float>(e.target.playerDistance.dist), GRID_MAP_TYPE_MASK_PLAYER);
 
             for (WorldObject* unit : units)
                 if (IsPlayer(unit))
@@ -3119,15 +3126,42 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
     }
 }
 
-void SmartScript::GetWorldObjectsInDist(ObjectVector& targets, float dist) const
+void SmartScript::GetWorldObjectsInDist(ObjectVector& targets, float dist, uint32 mapTypeMask) const
 {
+    targets.clear();
+
     WorldObject* obj = GetBaseObjectOrPlayerTrigger();
     if (!obj)
         return;
 
+    WorldObjectSearchCache& cache = _worldObjectSearchCache;
+    if (cache.GameTimeMS == GameTime::GetGameTimeMS() && cache.Origin == obj->GetGUID() && cache.OriginPosition == obj->GetPosition()
+        && cache.Dist == dist && cache.MapTypeMask == mapTypeMask)
+    {
+        for (ObjectGuid const& guid : cache.Objects)
+            if (WorldObject* object = ObjectAccessor::GetWorldObject(*obj, guid))
+                targets.push_back(object);
+        return;
+    }
+
     Trinity::AllWorldObjectsInRange u_check(obj, dist);
-    Trinity::WorldObjectListSearcher<Trinity::AllWorldObjectsInRange> searcher(obj, targets, u_check);
-    Cell::VisitAllObjects(obj, searcher, dist);
+    Trinity::WorldObjectListSearcher<Trinity::AllWorldObjectsInRange> searcher(obj, targets, u_check, mapTypeMask);
+    // players are only stored in world containers and gameobjects only in grid containers
+    if (!(mapTypeMask & ~GRID_MAP_TYPE_MASK_PLAYER))
+        Cell::VisitWorldObjects(obj, searcher, dist);
+    else if (!(mapTypeMask & ~GRID_MAP_TYPE_MASK_GAMEOBJECT))
+        Cell::VisitGridObjects(obj, searcher, dist);
+    else
+        Cell::VisitAllObjects(obj, searcher, dist);
+
+    cache.GameTimeMS = GameTime::GetGameTimeMS();
+    cache.Origin = obj->GetGUID();
+    cache.OriginPosition = obj->GetPosition();
+    cache.Dist = dist;
+    cache.MapTypeMask = mapTypeMask;
+    cache.Objects.clear();
+    for (WorldObject* object : targets)
+        cache.Objects.push_back(object->GetGUID());
 }
 
 void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob, std::string const& varString)
@@ -3884,6 +3918,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(installevent);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        mEventIndexDirty = true;
     }
 }
 
@@ -3996,6 +4031,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     {
         SortEvents(mEvents);
         mEventSortingRequired = false;
+        mEventIndexDirty = true;
     }
 
     for (SmartScriptHolder& mEvent : mEvents)
@@ -4060,6 +4096,23 @@ void SmartScript::SortEvents(SmartAIEventList& events)
     std::sort(events.begin(), events.end());
 }
 
+void SmartScript::RebuildEventIndex()
+{
+    mEventIndex.clear();
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        SMART_EVENT eventType = SMART_EVENT(mEvents[i].GetEventType());
+        if (eventType == SMART_EVENT_LINK)//special handling
+            continue;
+
+        mEventIndex.emplace_back(eventType, i);
+    }
+
+    // keeps mEvents order within each event type
+    std::sort(mEventIndex.begin(), mEventIndex.end());
+    mEventIndexDirty = false;
+}
+
 void SmartScript::RaisePriority(SmartScriptHolder& e)
 {
     e.timer = 1;
@@ -4125,6 +4178,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back(scriptholder);//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    mEventIndexDirty = true;
 }
 
 void SmartScript::GetScript()
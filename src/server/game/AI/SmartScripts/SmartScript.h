@@ -19,6 +19,7 @@
 #define TRINITY_SMARTSCRIPT_H
 
 #include "Define.h"
+#include "Position.h"
 #include "SmartScriptMgr.h"
 
 class AreaTrigger;
@@ -51,7 +52,7 @@ class TC_GAME_API SmartScript
         void ProcessAction(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr, std::string const& varString = "");
         void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr, std::string const& varString = "");
         void GetTargets(ObjectVector& targets, SmartScriptHolder const& e, WorldObject* invoker = nullptr) const;
-        void GetWorldObjectsInDist(ObjectVector& objects, float dist) const;
+        void GetWorldObjectsInDist(ObjectVector& objects, float dist, uint32 mapTypeMask) const;
         void InstallTemplate(SmartScriptHolder const& e);
         static SmartScriptHolder CreateSmartEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask);
         void AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 target_param4, uint32 phaseMask);
@@ -107,6 +108,7 @@ class TC_GAME_API SmartScript
         bool IsInPhase(uint32 p) const;
 
         void SortEvents(SmartAIEventList& events);
+        void RebuildEventIndex();
         void RaisePriority(SmartScriptHolder& e);
 
         SmartAIEventList mEvents;
@@ -138,11 +140,30 @@ class TC_GAME_API SmartScript
         bool mEventSortingRequired;
         uint32 mNestedEventsCounter;
 
+        // (event type, position in mEvents) pairs sorted by type, lets ProcessEventsFor visit only matching events
+        std::vector<std::pair<uint32, uint32>> mEventIndex;
+        bool mEventIndexDirty;
+
         // Max number of nested ProcessEventsFor() calls to avoid infinite loops
         static constexpr uint32 MAX_NESTED_EVENTS = 10;
 
         ObjectVectorMap _storedTargets;
 
+        // last GetWorldObjectsInDist result, reused by searches with the same parameters during the same world update
+        // guids are stored instead of pointers because objects can be removed from the map between two searches
+        struct WorldObjectSearchCache
+        {
+            uint32 GameTimeMS = 0;
+            ObjectGuid Origin;
+            Position OriginPosition;
+            float Dist = 0.0f;
+            uint32 MapTypeMask = 0;
+            std::vector<ObjectGuid> Objects;
+        };
+
+        mutable WorldObjectSearchCache _worldObjectSearchCache;
+        mutable ObjectVector _worldObjectSearchBuffer;      // reused by range target types instead of a new vector per search
+
         SMARTAI_TEMPLATE mTemplate;
         void InstallEvents();
 
@@ -23,6 +23,7 @@
 #include "DB2Stores.h"
 #include "DatabaseEnv.h"
 #include "GameEventMgr.h"
+#include "GridDefines.h"
 #include "InstanceScript.h"
 #include "Log.h"
 #include "MovementDefines.h"
@@ -71,6 +72,10 @@ void SmartWaypointMgr::LoadFromDB()
         float y = fields[3].GetFloat();
         float z = fields[4].GetFloat();
 
+        // normalized once here, paths are shared by all creatures using them
+        Trinity::NormalizeMapCoord(x);
+        Trinity::NormalizeMapCoord(y);
+
         if (lastEntry != entry)
         {
             lastId = 1;
@@ -225,11 +225,18 @@ void RBACData::CalculateNewPermissions()
     TC_LOG_TRACE("rbac", "RBACData::CalculateNewPermissions [Id: %u Name: %s]", GetId(), GetName().c_str());
 
     // Get the list of granted permissions
-    _globalPerms = GetGrantedPermissions();
-    ExpandPermissions(_globalPerms);
+    RBACPermissionContainer permissions = GetGrantedPermissions();
+    ExpandPermissions(permissions);
     RBACPermissionContainer revoked = GetDeniedPermissions();
     ExpandPermissions(revoked);
-    RemovePermissions(_globalPerms, revoked);
+    RemovePermissions(permissions, revoked);
+
+    _globalPerms.clear();
+    if (!permissions.empty())
+        _globalPerms.resize(*permissions.rbegin() + 1);
+
+    for (uint32 permission : permissions)
+        _globalPerms.set(permission);
 }
 
 void RBACData::AddPermissions(RBACPermissionContainer const& permsFrom, RBACPermissionContainer& permsTo)
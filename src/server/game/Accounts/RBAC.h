@@ -42,6 +42,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <boost/dynamic_bitset.hpp>
 #include <string>
 #include <set>
 #include <map>
@@ -872,12 +873,10 @@ class TC_GAME_API RBACData
          */
         bool HasPermission(uint32 permission) const
         {
-            return _globalPerms.find(permission) != _globalPerms.end();
+            return permission < _globalPerms.size() && _globalPerms.test(permission);
         }
 
         // Functions enabled to be used by command system
-        /// Returns all the granted permissions (after computation)
-        RBACPermissionContainer const& GetPermissions() const { return _globalPerms; }
         /// Returns all the granted permissions
         RBACPermissionContainer const& GetGrantedPermissions() const { return _grantedPerms; }
         /// Returns all the denied permissions
@@ -1049,7 +1048,7 @@ class TC_GAME_API RBACData
         uint8 _secLevel;                                   ///> Account SecurityLevel
         RBACPermissionContainer _grantedPerms;             ///> Granted permissions
         RBACPermissionContainer _deniedPerms;              ///> Denied permissions
-        RBACPermissionContainer _globalPerms;              ///> Calculated permissions
+        boost::dynamic_bitset<uint32> _globalPerms;        ///> Calculated permissions, indexed by permission id
 };
 
 }
@@ -1042,9 +1042,9 @@ void GuildAchievementMgr::SendPacket(WorldPacket const* data) const
     _owner->BroadcastPacket(data);
 }
 
-CriteriaList const& GuildAchievementMgr::GetCriteriaByType(CriteriaType type, uint32 /*asset*/) const
+CriteriaList const& GuildAchievementMgr::GetCriteriaByType(CriteriaType type, uint32 asset) const
 {
-    return sCriteriaMgr->GetGuildCriteriaByType(type);
+    return sCriteriaMgr->GetGuildCriteriaByType(type, asset);
 }
 
 std::string PlayerAchievementMgr::GetOwnerInfo() const
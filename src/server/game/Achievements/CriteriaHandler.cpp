@@ -4283,18 +4283,97 @@ inline bool IsCriteriaTypeStoredByAsset(CriteriaType type)
     }
     return false;
 }
+
+// types rejected by CriteriaHandler::RequirementsSatisfied when a non zero miscValue1 differs from the criteria asset
+// an update for an asset without criteria does not need to look at the other criteria of these types
+inline bool IsCriteriaAssetRequired(CriteriaType type)
+{
+    switch (type)
+    {
+        case CriteriaType::KillCreature:
+        case CriteriaType::SkillRaised:
+        case CriteriaType::KilledByCreature:
+        case CriteriaType::CompleteQuest:
+        case CriteriaType::BeSpellTarget:
+        case CriteriaType::CastSpell:
+        case CriteriaType::TrackedWorldStateUIModified:
+        case CriteriaType::PVPKillInArea:
+        case CriteriaType::LearnOrKnowSpell:
+        case CriteriaType::AcquireItem:
+        case CriteriaType::AchieveSkillStep:
+        case CriteriaType::UseItem:
+        case CriteriaType::LootItem:
+        case CriteriaType::ReputationGained:
+        case CriteriaType::EquipItemInSlot:
+        case CriteriaType::DeliverKillingBlowToClass:
+        case CriteriaType::DeliverKillingBlowToRace:
+        case CriteriaType::DoEmote:
+        case CriteriaType::EquipItem:
+        case CriteriaType::UseGameobject:
+        case CriteriaType::GainAura:
+        case CriteriaType::CatchFishInFishingHole:
+        case CriteriaType::LearnSpellFromSkillLine:
+        case CriteriaType::LandTargetedSpellOnTarget:
+        case CriteriaType::LearnTradeskillSkillLine:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+CriteriaList const EmptyCriteriaList;
 }
 
 CriteriaList const& CriteriaMgr::GetPlayerCriteriaByType(CriteriaType type, uint32 asset) const
+{
+    return GetCriteriaByTypeAndAsset(_criteriasByType, _criteriasByAsset, type, asset);
+}
+
+CriteriaList const& CriteriaMgr::GetCriteriaByTypeAndAsset(CriteriaList const* criteriasByType, CriteriaListByAsset const* criteriasByAsset, CriteriaType type, uint32 asset)
 {
     if (asset && IsCriteriaTypeStoredByAsset(type))
     {
-        auto itr = _criteriasByAsset[size_t(type)].find(asset);
-        if (itr != _criteriasByAsset[size_t(type)].end())
+        auto itr = criteriasByAsset[size_t(type)].find(asset);
+        if (itr != criteriasByAsset[size_t(type)].end())
             return itr->second;
+
+        if (IsCriteriaAssetRequired(type))
+            return EmptyCriteriaList;
     }
 
-    return _criteriasByType[size_t(type)];
+    return criteriasByType[size_t(type)];
+}
+
+void CriteriaMgr::AddCriteriaByType(CriteriaList* criteriasByType, CriteriaListByAsset* criteriasByAsset, Criteria const* criteria)
+{
+    CriteriaEntry const* criteriaEntry = criteria->Entry;
+    criteriasByType[criteriaEntry->Type].push_back(criteria);
+    if (!IsCriteriaTypeStoredByAsset(CriteriaType(criteriaEntry->Type)))
+        return;
+
+    if (CriteriaType(criteriaEntry->Type) != CriteriaType::RevealWorldMapOverlay)
+    {
+        criteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
+        return;
+    }
+
+    WorldMapOverlayEntry const* worldOverlayEntry = sWorldMapOverlayStore.LookupEntry(criteriaEntry->Asset.WorldMapOverlayID);
+    if (!worldOverlayEntry)
+        return;
+
+    for (uint8 j = 0; j < MAX_WORLD_MAP_OVERLAY_AREA_IDX; ++j)
+    {
+        if (worldOverlayEntry->AreaID[j])
+        {
+            bool valid = true;
+            for (uint8 i = 0; i < j; ++i)
+                if (worldOverlayEntry->AreaID[j] == worldOverlayEntry->AreaID[i])
+                    valid = false;
+            if (valid)
+                criteriasByAsset[criteriaEntry->Type][worldOverlayEntry->AreaID[j]].push_back(criteria);
+        }
+    }
 }
 
 //==========================================================
@@ -4467,49 +4546,25 @@ void CriteriaMgr::LoadCriteriaList()
         if (criteria->FlagsCu & (CRITERIA_FLAG_CU_PLAYER | CRITERIA_FLAG_CU_ACCOUNT))
         {
             ++criterias;
-            _criteriasByType[criteriaEntry->Type].push_back(criteria);
-            if (IsCriteriaTypeStoredByAsset(CriteriaType(criteriaEntry->Type)))
-            {
-                if (CriteriaType(criteriaEntry->Type) != CriteriaType::RevealWorldMapOverlay)
-                    _criteriasByAsset[criteriaEntry->Type][criteriaEntry->Asset.ID].push_back(criteria);
-                else
-                {
-                    WorldMapOverlayEntry const* worldOverlayEntry = sWorldMapOverlayStore.LookupEntry(criteriaEntry->Asset.WorldMapOverlayID);
-                    if (!worldOverlayEntry)
-                        break;
-
-                    for (uint8 j = 0; j < MAX_WORLD_MAP_OVERLAY_AREA_IDX; ++j)
-                    {
-                        if (worldOverlayEntry->AreaID[j])
-                        {
-                            bool valid = true;
-                            for (uint8 i = 0; i < j; ++i)
-                                if (worldOverlayEntry->AreaID[j] == worldOverlayEntry->AreaID[i])
-                                    valid = false;
-                            if (valid)
-                                _criteriasByAsset[criteriaEntry->Type][worldOverlayEntry->AreaID[j]].push_back(criteria);
-                        }
-                    }
-                }
-            }
+            AddCriteriaByType(_criteriasByType, _criteriasByAsset, criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_GUILD)
         {
             ++guildCriterias;
-            _guildCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            AddCriteriaByType(_guildCriteriasByType, _guildCriteriasByAsset, criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_SCENARIO)
         {
             ++scenarioCriterias;
-            _scenarioCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            AddCriteriaByType(_scenarioCriteriasByType, _scenarioCriteriasByAsset, criteria);
         }
 
         if (criteria->FlagsCu & CRITERIA_FLAG_CU_QUEST_OBJECTIVE)
         {
             ++questObjectiveCriterias;
-            _questObjectiveCriteriasByType[criteriaEntry->Type].push_back(criteria);
+            AddCriteriaByType(_questObjectiveCriteriasByType, _questObjectiveCriteriasByAsset, criteria);
         }
 
         if (criteriaEntry->StartTimer)
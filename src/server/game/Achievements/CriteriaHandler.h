@@ -324,19 +324,19 @@ public:
 
     CriteriaList const& GetPlayerCriteriaByType(CriteriaType type, uint32 asset) const;
 
-    CriteriaList const& GetGuildCriteriaByType(CriteriaType type) const
+    CriteriaList const& GetGuildCriteriaByType(CriteriaType type, uint32 asset) const
     {
-        return _guildCriteriasByType[size_t(type)];
+        return GetCriteriaByTypeAndAsset(_guildCriteriasByType, _guildCriteriasByAsset, type, asset);
     }
 
-    CriteriaList const& GetScenarioCriteriaByType(CriteriaType type) const
+    CriteriaList const& GetScenarioCriteriaByType(CriteriaType type, uint32 asset) const
     {
-        return _scenarioCriteriasByType[size_t(type)];
+        return GetCriteriaByTypeAndAsset(_scenarioCriteriasByType, _scenarioCriteriasByAsset, type, asset);
     }
 
-    CriteriaList const& GetQuestObjectiveCriteriaByType(CriteriaType type) const
+    CriteriaList const& GetQuestObjectiveCriteriaByType(CriteriaType type, uint32 asset) const
     {
-        return _questObjectiveCriteriasByType[size_t(type)];
+        return GetCriteriaByTypeAndAsset(_questObjectiveCriteriasByType, _questObjectiveCriteriasByAsset, type, asset);
     }
 
     CriteriaTreeList const* GetCriteriaTreesByCriteria(uint32 criteriaId) const
@@ -397,6 +397,9 @@ public:
     ModifierTreeNode const* GetModifierTree(uint32 modifierTreeId) const;
 
 private:
+    static CriteriaList const& GetCriteriaByTypeAndAsset(CriteriaList const* criteriasByType, CriteriaListByAsset const* criteriasByAsset, CriteriaType type, uint32 asset);
+    static void AddCriteriaByType(CriteriaList* criteriasByType, CriteriaListByAsset* criteriasByAsset, Criteria const* criteria);
+
     CriteriaDataMap _criteriaDataMap;
 
     std::unordered_map<uint32, CriteriaTree*> _criteriaTrees;
@@ -409,8 +412,11 @@ private:
     CriteriaList _criteriasByType[size_t(CriteriaType::Count)];
     CriteriaListByAsset _criteriasByAsset[size_t(CriteriaType::Count)];
     CriteriaList _guildCriteriasByType[size_t(CriteriaType::Count)];
+    CriteriaListByAsset _guildCriteriasByAsset[size_t(CriteriaType::Count)];
     CriteriaList _scenarioCriteriasByType[size_t(CriteriaType::Count)];
+    CriteriaListByAsset _scenarioCriteriasByAsset[size_t(CriteriaType::Count)];
     CriteriaList _questObjectiveCriteriasByType[size_t(CriteriaType::Count)];
+    CriteriaListByAsset _questObjectiveCriteriasByAsset[size_t(CriteriaType::Count)];
 
     CriteriaList _criteriasByTimedType[size_t(CriteriaStartEvent::Count)];
     std::unordered_map<int32, CriteriaList> _criteriasByFailEvent[size_t(CriteriaFailEvent::Count)];
@@ -30,6 +30,7 @@
 #include "Language.h"
 #include "Log.h"
 #include "Mail.h"
+#include "MemoryAccounting.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -373,6 +374,13 @@ public:
 
     void AddItem(T const* item)
     {
+        // full and sorting after everything kept, would be popped right after insertion
+        if (!_items.empty() && _items.size() >= _maxResults + _offset && _sorter(_items.back(), item))
+        {
+            _hasMoreResults = true;
+            return;
+        }
+
         auto where = std::lower_bound(_items.begin(), _items.end(), item, std::cref(_sorter));
 
         _items.insert(where, item);
@@ -401,7 +409,8 @@ private:
     bool _hasMoreResults;
 };
 
-AuctionHouseMgr::AuctionHouseMgr() : mHordeAuctions(6), mAllianceAuctions(2), mNeutralAuctions(1), mGoblinAuctions(7), _replicateIdGenerator(0)
+AuctionHouseMgr::AuctionHouseMgr() : mHordeAuctions(6), mAllianceAuctions(2), mNeutralAuctions(1), mGoblinAuctions(7), _replicateIdGenerator(0),
+    _hasPendingExpiredAuctions(false)
 {
     _playerThrottleObjectsCleanupTime = GameTime::Now() + Hours(1);
 }
@@ -458,6 +467,14 @@ Item* AuctionHouseMgr::GetAItem(ObjectGuid itemGuid)
     return Trinity::Containers::MapGetValuePtr(_itemsByGuid, itemGuid);
 }
 
+std::size_t AuctionHouseMgr::GetMemoryUsage() const
+{
+    // items are counted with their object size only, update field data they own is not included
+    return mHordeAuctions.GetMemoryUsage() + mAllianceAuctions.GetMemoryUsage() + mNeutralAuctions.GetMemoryUsage() + mGoblinAuctions.GetMemoryUsage()
+        + Trinity::MemoryAccounting::EstimateNodeContainer(_itemsByGuid) + _itemsByGuid.size() * sizeof(Item)
+        + Trinity::MemoryAccounting::EstimateNodeContainer(_pendingAuctionsByPlayer);
+}
+
 uint64 AuctionHouseMgr::GetCommodityAuctionDeposit(ItemTemplate const* item, Minutes time, uint32 quantity)
 {
     uint32 sellPrice = item->GetSellPrice();
@@ -745,6 +762,10 @@ void AuctionHouseMgr::PendingAuctionProcess(Player* player)
 
 void AuctionHouseMgr::UpdatePendingAuctions()
 {
+    // continue expiring auctions left over by the last Update in smaller steps
+    if (_hasPendingExpiredAuctions)
+        ExpireAuctions();
+
     for (auto itr = _pendingAuctionsByPlayer.begin(); itr != _pendingAuctionsByPlayer.end();)
     {
         ObjectGuid playerGUID = itr->first;
@@ -791,6 +812,8 @@ void AuctionHouseMgr::Update()
     mNeutralAuctions.Update();
     mGoblinAuctions.Update();
 
+    ExpireAuctions();
+
     TimePoint now = GameTime::Now();
     if (now >= _playerThrottleObjectsCleanupTime)
     {
@@ -806,6 +829,16 @@ void AuctionHouseMgr::Update()
     }
 }
 
+void AuctionHouseMgr::ExpireAuctions()
+{
+    uint32 maxExpiredAuctions = sWorld->getIntConfig(CONFIG_AUCTION_MAX_EXPIRED_PER_UPDATE);
+    bool finished = true;
+    for (AuctionHouseObject* auctionHouse : { &mHordeAuctions, &mAllianceAuctions, &mNeutralAuctions, &mGoblinAuctions })
+        finished = auctionHouse->ExpireAuctions(maxExpiredAuctions) && finished;
+
+    _hasPendingExpiredAuctions = !finished;
+}
+
 uint32 AuctionHouseMgr::GenerateReplicationId()
 {
     return ++_replicateIdGenerator;
@@ -880,6 +913,20 @@ uint32 AuctionHouseObject::GetAuctionHouseId() const
     return _auctionHouse->ID;
 }
 
+std::size_t AuctionHouseObject::GetMemoryUsage() const
+{
+    using Trinity::MemoryAccounting;
+
+    return MemoryAccounting::EstimateNodeContainer(_itemsByAuctionId)
+        + MemoryAccounting::EstimateNodeContainer(_auctionsByEndTime)
+        + MemoryAccounting::EstimateNodeContainer(_soldItemsById)
+        + MemoryAccounting::EstimateNodeContainer(_buckets)
+        + MemoryAccounting::EstimateNodeContainer(_commodityQuotes)
+        + MemoryAccounting::EstimateNodeContainer(_playerOwnedAuctions)
+        + MemoryAccounting::EstimateNodeContainer(_playerBidderAuctions)
+        + MemoryAccounting::EstimateNodeContainer(_replicateThrottleMap);
+}
+
 AuctionPosting* AuctionHouseObject::GetAuction(uint32 auctionId)
 {
     return Trinity::Containers::MapGetValuePtr(_itemsByAuctionId, auctionId);
@@ -1023,6 +1070,7 @@ void AuctionHouseObject::AddAuction(CharacterDatabaseTransaction trans, AuctionP
         _playerBidderAuctions.emplace(bidder, auction.Id);
 
     AuctionPosting* addedAuction = &(_itemsByAuctionId[auction.Id] = std::move(auction));
+    _auctionsByEndTime.emplace(addedAuction->EndTime, addedAuction->Id);
 
     WorldPackets::AuctionHouse::AuctionSortDef priceSort{ AuctionHouseSortOrder::Price, false };
     AuctionPosting::Sorter insertSorter(LOCALE_enUS, &priceSort, 1);
@@ -1105,17 +1153,24 @@ void AuctionHouseObject::RemoveAuction(CharacterDatabaseTransaction trans, Aucti
     for (ObjectGuid bidder : auction->BidderHistory)
         Trinity::Containers::MultimapErasePair(_playerBidderAuctions, bidder, auction->Id);
 
+    _auctionsByEndTime.erase({ auction->EndTime, auction->Id });
+
     if (auctionItr)
         *auctionItr = _itemsByAuctionId.erase(*auctionItr);
     else
         _itemsByAuctionId.erase(auction->Id);
 }
 
+void AuctionHouseObject::SetAuctionEndTime(AuctionPosting* auction, SystemTimePoint endTime)
+{
+    _auctionsByEndTime.erase({ auction->EndTime, auction->Id });
+    auction->EndTime = endTime;
+    _auctionsByEndTime.emplace(auction->EndTime, auction->Id);
+}
+
 void AuctionHouseObject::Update()
 {
-    SystemTimePoint curTime = GameTime::GetSystemTime();
     TimePoint curTimeSteady = GameTime::Now();
-    ///- Handle expired auctions
 
     // Clear expired throttled players
     for (auto itr = _replicateThrottleMap.begin(); itr != _replicateThrottleMap.end();)
@@ -1133,21 +1188,26 @@ void AuctionHouseObject::Update()
         else
             ++itr;
     }
+}
 
-    if (_itemsByAuctionId.empty())
-        return;
+bool AuctionHouseObject::ExpireAuctions(uint32 maxCount)
+{
+    ///- filter auctions expired on next update
+    SystemTimePoint expireBefore = GameTime::GetSystemTime() + 1min;
+    if (_auctionsByEndTime.empty() || _auctionsByEndTime.begin()->first > expireBefore)
+        return true;
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
 
-    for (auto it = _itemsByAuctionId.begin(); it != _itemsByAuctionId.end();)
+    uint32 expiredCount = 0;
+    while (!_auctionsByEndTime.empty() && _auctionsByEndTime.begin()->first <= expireBefore)
     {
-        AuctionPosting* auction = &it->second;
-        ///- filter auctions expired on next update
-        if (auction->EndTime > curTime + 1min)
-        {
-            ++it;
-            continue;
-        }
+        if (maxCount && expiredCount >= maxCount)
+            break;
+
+        AuctionPosting* auction = GetAuction(_auctionsByEndTime.begin()->second);
+        ASSERT(auction);
+        ++expiredCount;
 
         ///- Either cancel the auction if there was no bidder
         if (auction->Bidder.IsEmpty())
@@ -1167,18 +1227,20 @@ void AuctionHouseObject::Update()
         }
 
         ///- In any case clear the auction
-        RemoveAuction(trans, auction, &it);
+        RemoveAuction(trans, auction);
     }
 
     // Run DB changes
     CharacterDatabase.CommitTransaction(trans);
+
+    return _auctionsByEndTime.empty() || _auctionsByEndTime.begin()->first > expireBefore;
 }
 
 void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player* player,
     std::wstring const& name, uint8 minLevel, uint8 maxLevel, EnumFlag<AuctionHouseFilterMask> filters, Optional<AuctionSearchClassFilters> const& classFilters,
     uint8 const* knownPetBits, std::size_t knownPetBitsCount, uint8 maxKnownPetLevel, uint32 offset, WorldPackets::AuctionHouse::AuctionSortDef const* sorts, std::size_t sortCount)
 {
-    std::unordered_set<uint32> knownAppearanceIds;
+    boost::dynamic_bitset<uint32> knownAppearanceIds;
     boost::dynamic_bitset<uint8> knownPetSpecies;
     // prepare uncollected filter for more efficient searches
     if (filters.HasFlag(AuctionHouseFilterMask::UncollectedOnly))
@@ -1189,23 +1251,12 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
             knownPetSpecies.resize(sBattlePetSpeciesStore.GetNumRows());
     }
 
-    AuctionsResultBuilder<AuctionsBucketData> builder(offset, player->GetSession()->GetSessionDbcLocale(), sorts, sortCount, AuctionHouseResultLimits::Browse);
+    LocaleConstant locale = player->GetSession()->GetSessionDbcLocale();
+    AuctionsResultBuilder<AuctionsBucketData> builder(offset, locale, sorts, sortCount, AuctionHouseResultLimits::Browse);
 
     for (std::pair<AuctionsBucketKey const, AuctionsBucketData> const& bucket : _buckets)
     {
         AuctionsBucketData const* bucketData = &bucket.second;
-        if (!name.empty())
-        {
-            if (filters.HasFlag(AuctionHouseFilterMask::ExactMatch))
-            {
-                if (bucketData->FullName[player->GetSession()->GetSessionDbcLocale()] != name)
-                    continue;
-            }
-            else
-                if (bucketData->FullName[player->GetSession()->GetSessionDbcLocale()].find(name) == std::wstring::npos)
-                    continue;
-        }
-
         if (minLevel && bucketData->RequiredLevel < minLevel)
             continue;
 
@@ -1234,6 +1285,19 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
             }
         }
 
+        // string search only after the cheap numeric filters
+        if (!name.empty())
+        {
+            if (filters.HasFlag(AuctionHouseFilterMask::ExactMatch))
+            {
+                if (bucketData->FullName[locale] != name)
+                    continue;
+            }
+            else
+                if (bucketData->FullName[locale].find(name) == std::wstring::npos)
+                    continue;
+        }
+
         if (filters.HasFlag(AuctionHouseFilterMask::UncollectedOnly))
         {
             // appearances - by ItemAppearanceId, not ItemModifiedAppearanceId
@@ -1244,7 +1308,7 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
                 {
                     if (ItemModifiedAppearanceEntry const* itemModifiedAppearance = sItemModifiedAppearanceStore.LookupEntry(bucketAppearance.first))
                     {
-                        if (knownAppearanceIds.find(itemModifiedAppearance->ItemAppearanceID) == knownAppearanceIds.end())
+                        if (itemModifiedAppearance->ItemAppearanceID >= knownAppearanceIds.size() || !knownAppearanceIds.test(itemModifiedAppearance->ItemAppearanceID))
                         {
                             hasAll = false;
                             break;
@@ -1539,6 +1603,7 @@ void AuctionHouseObject::BuildReplicate(WorldPackets::AuctionHouse::AuctionRepli
         return;
 
     auto itr = _itemsByAuctionId.upper_bound(cursor);
+    replicateResponse.Items.reserve(std::min<std::size_t>(count, _itemsByAuctionId.size()));
     for (; itr != _itemsByAuctionId.end(); ++itr)
     {
         AuctionPosting const& auction = itr->second;
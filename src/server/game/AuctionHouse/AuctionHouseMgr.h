@@ -284,6 +284,9 @@ public:
 
     uint32 GetAuctionHouseId() const;
 
+    // estimated from the number of auctions, buckets and quotes
+    std::size_t GetMemoryUsage() const;
+
     std::map<uint32, AuctionPosting>::iterator GetAuctionsBegin() { return _itemsByAuctionId.begin(); }
     std::map<uint32, AuctionPosting>::iterator GetAuctionsEnd() { return _itemsByAuctionId.end(); }
 
@@ -293,8 +296,14 @@ public:
 
     void RemoveAuction(CharacterDatabaseTransaction trans, AuctionPosting* auction, std::map<uint32, AuctionPosting>::iterator* auctionItr = nullptr);
 
+    // EndTime of postings must only be changed through this function to keep the expiration queue ordered
+    void SetAuctionEndTime(AuctionPosting* auction, SystemTimePoint endTime);
+
     void Update();
 
+    // expires at most maxCount (0 - no limit) auctions ending before the next Update, returns false if some were left for later
+    bool ExpireAuctions(uint32 maxCount);
+
     void BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player* player,
         std::wstring const& name, uint8 minLevel, uint8 maxLevel, EnumFlag<AuctionHouseFilterMask> filters, Optional<AuctionSearchClassFilters> const& classFilters,
         uint8 const* knownPetBits, std::size_t knownPetBitsCount, uint8 maxKnownPetLevel,
@@ -331,6 +340,7 @@ private:
     AuctionHouseEntry const* _auctionHouse;
 
     std::map<uint32, AuctionPosting> _itemsByAuctionId; // ordered for replicate
+    std::set<std::pair<SystemTimePoint, uint32>> _auctionsByEndTime; // expiration queue
     std::unordered_map<uint32, AuctionPosting> _soldItemsById;
     std::map<AuctionsBucketKey, AuctionsBucketData> _buckets; // ordered for search by itemid only
     std::unordered_map<ObjectGuid, CommodityQuote> _commodityQuotes;
@@ -357,6 +367,8 @@ class TC_GAME_API AuctionHouseMgr
 
         Item* GetAItem(ObjectGuid itemGuid);
 
+        std::size_t GetMemoryUsage() const;
+
         static std::string BuildItemAuctionMailSubject(AuctionMailType type, AuctionPosting const* auction);
         static std::string BuildCommodityAuctionMailSubject(AuctionMailType type, uint32 itemId, uint32 itemCount);
         static std::string BuildAuctionMailSubject(uint32 itemId, AuctionMailType type, uint32 auctionId, uint32 itemCount, uint32 battlePetSpeciesId,
@@ -386,6 +398,7 @@ class TC_GAME_API AuctionHouseMgr
         AuctionThrottleResult CheckThrottle(Player* player, bool addonTainted, AuctionCommand command = AuctionCommand::SellItem);
 
     private:
+        void ExpireAuctions();
 
         AuctionHouseObject mHordeAuctions;
         AuctionHouseObject mAllianceAuctions;
@@ -419,6 +432,8 @@ class TC_GAME_API AuctionHouseMgr
 
         std::unordered_map<ObjectGuid, PlayerThrottleObject> _playerThrottleObjects;
         TimePoint _playerThrottleObjectsCleanupTime;
+
+        bool _hasPendingExpiredAuctions;
 };
 
 #define sAuctionMgr AuctionHouseMgr::instance()
@@ -31,6 +31,7 @@
 #include "Util.h"
 #include "World.h"
 #include "WorldSession.h"
+#include <map>
 
 namespace BattlePets
 {
@@ -220,6 +221,11 @@ void BattlePetMgr::LoadFromDB(PreparedQueryResult pets, PreparedQueryResult slot
 {
     if (pets)
     {
+        _pets.reserve(pets->GetRowCount());
+
+        // counted here instead of calling HasMaxPetCount for each row, that walks every pet loaded so far
+        std::map<std::pair<uint32 /*species*/, ObjectGuid /*owner*/>, uint8> petCounts;
+
         do
         {
             Field* fields = pets->Fetch();
@@ -245,7 +251,8 @@ void BattlePetMgr::LoadFromDB(PreparedQueryResult pets, PreparedQueryResult slot
                     }
                 }
 
-                if (HasMaxPetCount(speciesEntry, ownerGuid))
+                uint8& petCount = petCounts[std::make_pair(species, ownerGuid)];
+                if (petCount >= GetMaxPetCountPerSpecies(speciesEntry))
                 {
                     if (ownerGuid.IsEmpty())
                         TC_LOG_ERROR("misc", "Battlenet account with id %u has more than maximum battle pets of species %u", _owner->GetBattlenetAccountId(), species);
@@ -286,6 +293,7 @@ void BattlePetMgr::LoadFromDB(PreparedQueryResult pets, PreparedQueryResult slot
                 pet.SaveInfo = BATTLE_PET_UNCHANGED;
                 pet.CalculateStats();
                 _pets[pet.PacketInfo.Guid.GetCounter()] = std::move(pet);
+                ++petCount;
             }
         } while (pets->NextRow());
     }
@@ -305,14 +313,20 @@ void BattlePetMgr::LoadFromDB(PreparedQueryResult pets, PreparedQueryResult slot
             i++;
         } while (slots->NextRow());
     }
+    else
+        _slotsChanged = true;
 }
 
 void BattlePetMgr::SaveToDB(LoginDatabaseTransaction trans)
 {
     LoginDatabasePreparedStatement* stmt = nullptr;
 
-    for (auto itr = _pets.begin(); itr != _pets.end();)
+    for (uint64 petGuid : _petsToSave)
     {
+        auto itr = _pets.find(petGuid);
+        if (itr == _pets.end())
+            continue;
+
         switch (itr->second.SaveInfo)
         {
             case BATTLE_PET_NEW:
@@ -354,7 +368,6 @@ void BattlePetMgr::SaveToDB(LoginDatabaseTransaction trans)
                 }
 
                 itr->second.SaveInfo = BATTLE_PET_UNCHANGED;
-                ++itr;
                 break;
             case BATTLE_PET_CHANGED:
                 stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BATTLE_PETS);
@@ -385,7 +398,6 @@ void BattlePetMgr::SaveToDB(LoginDatabaseTransaction trans)
                 }
 
                 itr->second.SaveInfo = BATTLE_PET_UNCHANGED;
-                ++itr;
                 break;
             case BATTLE_PET_REMOVED:
                 stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_BATTLE_PET_DECLINED_NAME);
@@ -397,14 +409,18 @@ void BattlePetMgr::SaveToDB(LoginDatabaseTransaction trans)
                 stmt->setUInt64(1, itr->first);
                 trans->Append(stmt);
 
-                itr = _pets.erase(itr);
+                _pets.erase(itr);
                 break;
             default:
-                ++itr;
                 break;
         }
     }
 
+    _petsToSave.clear();
+
+    if (!_slotsChanged)
+        return;
+
     stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_BATTLE_PET_SLOTS);
     stmt->setUInt32(0, _owner->GetBattlenetAccountId());
     trans->Append(stmt);
@@ -418,6 +434,8 @@ void BattlePetMgr::SaveToDB(LoginDatabaseTransaction trans)
         stmt->setBool(3, slot.Locked);
         trans->Append(stmt);
     }
+
+    _slotsChanged = false;
 }
 
 BattlePet* BattlePetMgr::GetPet(ObjectGuid guid)
@@ -425,6 +443,14 @@ BattlePet* BattlePetMgr::GetPet(ObjectGuid guid)
     return Trinity::Containers::MapGetValuePtr(_pets, guid.GetCounter());
 }
 
+void BattlePetMgr::SetPetChanged(BattlePet* pet)
+{
+    if (pet->SaveInfo == BATTLE_PET_UNCHANGED)
+        pet->SaveInfo = BATTLE_PET_CHANGED;
+
+    _petsToSave.insert(pet->PacketInfo.Guid.GetCounter());
+}
+
 void BattlePetMgr::AddPet(uint32 species, uint32 display, uint16 breed, BattlePetBreedQuality quality, uint16 level /*= 1*/)
 {
     BattlePetSpeciesEntry const* battlePetSpecies = sBattlePetSpeciesStore.LookupEntry(species);
@@ -458,6 +484,7 @@ void BattlePetMgr::AddPet(uint32 species, uint32 display, uint16 breed, BattlePe
 
     pet.SaveInfo = BATTLE_PET_NEW;
 
+    _petsToSave.insert(pet.PacketInfo.Guid.GetCounter());
     _pets[pet.PacketInfo.Guid.GetCounter()] = std::move(pet);
 
     std::vector<std::reference_wrapper<BattlePet>> updates;
@@ -478,6 +505,7 @@ void BattlePetMgr::RemovePet(ObjectGuid guid)
         return;
 
     pet->SaveInfo = BATTLE_PET_REMOVED;
+    _petsToSave.insert(guid.GetCounter());
 }
 
 void BattlePetMgr::ClearFanfare(ObjectGuid guid)
@@ -488,8 +516,7 @@ void BattlePetMgr::ClearFanfare(ObjectGuid guid)
 
     pet->PacketInfo.Flags &= ~AsUnderlyingType(BattlePetDbFlags::FanfareNeeded);
 
-    if (pet->SaveInfo != BATTLE_PET_NEW)
-        pet->SaveInfo = BATTLE_PET_CHANGED;
+    SetPetChanged(pet);
 }
 
 void BattlePetMgr::ModifyName(ObjectGuid guid, std::string const& name, std::unique_ptr<DeclinedName> declinedName)
@@ -506,8 +533,7 @@ void BattlePetMgr::ModifyName(ObjectGuid guid, std::string const& name, std::uni
 
     pet->DeclinedName = std::move(declinedName);
 
-    if (pet->SaveInfo != BATTLE_PET_NEW)
-        pet->SaveInfo = BATTLE_PET_CHANGED;
+    SetPetChanged(pet);
 
     // Update the timestamp if the battle pet is summoned
     if (Creature* summonedBattlePet = _owner->GetPlayer()->GetSummonedBattlePet())
@@ -543,11 +569,14 @@ uint8 BattlePetMgr::GetPetCount(BattlePetSpeciesEntry const* battlePetSpecies, O
     }));
 }
 
-bool BattlePetMgr::HasMaxPetCount(BattlePetSpeciesEntry const* battlePetSpecies, ObjectGuid ownerGuid) const
+uint8 BattlePetMgr::GetMaxPetCountPerSpecies(BattlePetSpeciesEntry const* battlePetSpecies)
 {
-    uint8 maxPetsPerSpecies = battlePetSpecies->GetFlags().HasFlag(BattlePetSpeciesFlags::LegacyAccountUnique) ? 1 : DEFAULT_MAX_BATTLE_PETS_PER_SPECIES;
+    return battlePetSpecies->GetFlags().HasFlag(BattlePetSpeciesFlags::LegacyAccountUnique) ? 1 : DEFAULT_MAX_BATTLE_PETS_PER_SPECIES;
+}
 
-    return GetPetCount(battlePetSpecies, ownerGuid) >= maxPetsPerSpecies;
+bool BattlePetMgr::HasMaxPetCount(BattlePetSpeciesEntry const* battlePetSpecies, ObjectGuid ownerGuid) const
+{
+    return GetPetCount(battlePetSpecies, ownerGuid) >= GetMaxPetCountPerSpecies(battlePetSpecies);
 }
 
 uint32 BattlePetMgr::GetPetUniqueSpeciesCount() const
@@ -560,6 +589,15 @@ uint32 BattlePetMgr::GetPetUniqueSpeciesCount() const
     return speciesIds.size();
 }
 
+void BattlePetMgr::SetSlotPet(BattlePetSlot slot, BattlePet const* pet)
+{
+    if (slot >= BattlePetSlot::Count)
+        return;
+
+    _slots[AsUnderlyingType(slot)].Pet = pet->PacketInfo;
+    _slotsChanged = true;
+}
+
 void BattlePetMgr::UnlockSlot(BattlePetSlot slot)
 {
     if (slot >= BattlePetSlot::Count)
@@ -570,6 +608,7 @@ void BattlePetMgr::UnlockSlot(BattlePetSlot slot)
         return;
 
     _slots[slotIndex].Locked = false;
+    _slotsChanged = true;
 
     WorldPackets::BattlePet::PetBattleSlotUpdates updates;
     updates.Slots.push_back(_slots[slotIndex]);
@@ -665,8 +704,7 @@ void BattlePetMgr::ChangeBattlePetQuality(ObjectGuid guid, BattlePetBreedQuality
     pet->CalculateStats();
     pet->PacketInfo.Health = pet->PacketInfo.MaxHealth;
 
-    if (pet->SaveInfo != BATTLE_PET_NEW)
-        pet->SaveInfo = BATTLE_PET_CHANGED;
+    SetPetChanged(pet);
 
     std::vector<std::reference_wrapper<BattlePet>> updates;
     updates.push_back(std::ref(*pet));
@@ -728,8 +766,7 @@ void BattlePetMgr::GrantBattlePetExperience(ObjectGuid guid, uint16 xp, BattlePe
     pet->CalculateStats();
     pet->PacketInfo.Health = pet->PacketInfo.MaxHealth;
 
-    if (pet->SaveInfo != BATTLE_PET_NEW)
-        pet->SaveInfo = BATTLE_PET_CHANGED;
+    SetPetChanged(pet);
 
     std::vector<std::reference_wrapper<BattlePet>> updates;
     updates.push_back(std::ref(*pet));
@@ -779,8 +816,7 @@ void BattlePetMgr::GrantBattlePetLevel(ObjectGuid guid, uint16 grantedLevels)
     pet->CalculateStats();
     pet->PacketInfo.Health = pet->PacketInfo.MaxHealth;
 
-    if (pet->SaveInfo != BATTLE_PET_NEW)
-        pet->SaveInfo = BATTLE_PET_CHANGED;
+    SetPetChanged(pet);
 
     std::vector<std::reference_wrapper<BattlePet>> updates;
     updates.push_back(std::ref(*pet));
@@ -809,8 +845,7 @@ void BattlePetMgr::HealBattlePetsPct(uint8 pct)
             pet.second.PacketInfo.Health += CalculatePct(pet.second.PacketInfo.MaxHealth, pct);
             // don't allow Health to be greater than MaxHealth
             pet.second.PacketInfo.Health = std::min(pet.second.PacketInfo.Health, pet.second.PacketInfo.MaxHealth);
-            if (pet.second.SaveInfo != BATTLE_PET_NEW)
-                pet.second.SaveInfo = BATTLE_PET_CHANGED;
+            SetPetChanged(&pet.second);
             updates.push_back(std::ref(pet.second));
         }
 
@@ -858,6 +893,7 @@ void BattlePetMgr::SendJournal()
     WorldPackets::BattlePet::BattlePetJournal battlePetJournal;
     battlePetJournal.Trap = _trapLevel;
     battlePetJournal.HasJournalLock = _hasJournalLock;
+    battlePetJournal.Pets.reserve(_pets.size());
 
     for (auto& pet : _pets)
         if (pet.second.SaveInfo != BATTLE_PET_REMOVED)
@@ -22,6 +22,7 @@
 #include "DatabaseEnvFwd.h"
 #include "EnumFlag.h"
 #include <unordered_map>
+#include <unordered_set>
 
 struct BattlePetSpeciesEntry;
 
@@ -159,6 +160,7 @@ public:
     void SaveToDB(LoginDatabaseTransaction trans);
 
     BattlePet* GetPet(ObjectGuid guid);
+    void SetPetChanged(BattlePet* pet);
     void AddPet(uint32 species, uint32 display, uint16 breed, BattlePetBreedQuality quality, uint16 level = 1);
     void RemovePet(ObjectGuid guid);
     void ClearFanfare(ObjectGuid guid);
@@ -170,6 +172,7 @@ public:
     uint32 GetPetUniqueSpeciesCount() const;
 
     WorldPackets::BattlePet::BattlePetSlot* GetSlot(BattlePetSlot slot) { return slot < BattlePetSlot::Count ? &_slots[size_t(slot)] : nullptr; }
+    void SetSlotPet(BattlePetSlot slot, BattlePet const* pet);
     void UnlockSlot(BattlePetSlot slot);
 
     WorldSession* GetOwner() const { return _owner; }
@@ -203,8 +206,11 @@ private:
     bool _hasJournalLock = false;
     uint16 _trapLevel = 0;
     std::unordered_map<uint64 /*battlePetGuid*/, BattlePet> _pets;
+    std::unordered_set<uint64 /*battlePetGuid*/> _petsToSave; // pets with SaveInfo != BATTLE_PET_UNCHANGED
     std::vector<WorldPackets::BattlePet::BattlePetSlot> _slots;
+    bool _slotsChanged = false;
 
+    static uint8 GetMaxPetCountPerSpecies(BattlePetSpeciesEntry const* battlePetSpecies);
     static void LoadAvailablePetBreeds();
     static void LoadDefaultPetQualities();
 };
@@ -1010,15 +1010,16 @@ bool BfCapturePoint::Update(uint32 diff)
             }
         }
 
-        std::list<Player*> players;
+        std::vector<Player*> players;
+        players.reserve(m_activePlayers[TEAM_ALLIANCE].size() + m_activePlayers[TEAM_HORDE].size());
         Trinity::AnyPlayerInObjectRangeCheck checker(capturePoint, radius);
         Trinity::PlayerListSearcher<Trinity::AnyPlayerInObjectRangeCheck> searcher(capturePoint, players, checker);
         Cell::VisitWorldObjects(capturePoint, searcher, radius);
 
-        for (std::list<Player*>::iterator itr = players.begin(); itr != players.end(); ++itr)
-            if ((*itr)->IsOutdoorPvPActive())
-                if (m_activePlayers[(*itr)->GetTeamId()].insert((*itr)->GetGUID()).second)
-                    HandlePlayerEnter(*itr);
+        for (Player* player : players)
+            if (player->IsOutdoorPvPActive())
+                if (m_activePlayers[player->GetTeamId()].insert(player->GetGUID()).second)
+                    HandlePlayerEnter(player);
     }
 
     // get the difference of numbers
@@ -1109,10 +1110,16 @@ bool BfCapturePoint::Update(uint32 diff)
 
 void BfCapturePoint::SendUpdateWorldState(uint32 field, uint32 value)
 {
+    // serialized once for everyone in the area
+    WorldPackets::WorldState::UpdateWorldState worldstate;
+    worldstate.VariableID = field;
+    worldstate.Value = value;
+    WorldPacket const* packet = worldstate.Write();
+
     for (uint8 team = 0; team < PVP_TEAMS_COUNT; ++team)
         for (GuidSet::iterator itr = m_activePlayers[team].begin(); itr != m_activePlayers[team].end(); ++itr)  // send to all players present in the area
             if (Player* player = ObjectAccessor::FindPlayer(*itr))
-                player->SendUpdateWorldState(field, value);
+                player->SendDirectMessage(packet);
 }
 
 void BfCapturePoint::SendObjectiveComplete(uint32 id, ObjectGuid guid)
@@ -145,6 +145,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, PVPDiffi
     ginfo->ArenaMatchmakerRating     = MatchmakerRating;
     ginfo->OpponentsTeamRating       = 0;
     ginfo->OpponentsMatchmakerRating = 0;
+    ginfo->BracketId                 = bracketId;
 
     ginfo->Players.clear();
 
@@ -155,6 +156,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, PVPDiffi
     if (ginfo->Team == HORDE)
         index++;
     TC_LOG_DEBUG("bg.battleground", "Adding Group to BattlegroundQueue bgTypeId : %u, bracket_id : %u, index : %u", m_queueId.BattlemasterListId, bracketId, index);
+    ginfo->QueueGroupType = index;
 
     uint32 lastOnlineTime = GameTime::GetGameTimeMS();
 
@@ -192,6 +194,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, PVPDiffi
     //add GroupInfo to m_QueuedGroups
     {
         m_QueuedGroups[bracketId][index].push_back(ginfo);
+        AddToQueuedTotals(ginfo);
 
         //announce to world, this code needs mutex
         if (!m_queueId.Rated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -199,17 +202,10 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, PVPDiffi
             if (Battleground* bg = sBattlegroundMgr->GetBattlegroundTemplate(BattlegroundTypeId(m_queueId.BattlemasterListId)))
             {
                 uint32 MinPlayers = bg->GetMinPlayersPerTeam();
-                uint32 qHorde = 0;
-                uint32 qAlliance = 0;
+                uint32 qHorde = m_QueuedTotals[bracketId].Players[BG_QUEUE_NORMAL_HORDE];
+                uint32 qAlliance = m_QueuedTotals[bracketId].Players[BG_QUEUE_NORMAL_ALLIANCE];
                 uint32 q_min_level = bracketEntry->MinLevel;
                 uint32 q_max_level = bracketEntry->MaxLevel;
-                GroupsQueueType::const_iterator itr;
-                for (itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qAlliance += (*itr)->Players.size();
-                for (itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qHorde += (*itr)->Players.size();
 
                 // Show queue status to player only (when joining queue)
                 if (sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_PLAYERONLY))
@@ -280,6 +276,38 @@ uint32 BattlegroundQueue::GetAverageQueueWaitTime(GroupQueueInfo* ginfo, Battleg
         return 0;
 }
 
+// must be called when a group not invited yet enters m_QueuedGroups or changes (after the change)
+void BattlegroundQueue::AddToQueuedTotals(GroupQueueInfo const* ginfo)
+{
+    if (ginfo->IsInvitedToBGInstanceGUID)
+        return;
+
+    QueuedTotals& totals = m_QueuedTotals[ginfo->BracketId];
+    totals.Players[ginfo->QueueGroupType] += ginfo->Players.size();
+    ++totals.Groups[ginfo->QueueGroupType];
+    totals.ChangedSinceRatedScan = true;
+}
+
+// must be called when a group not invited yet leaves m_QueuedGroups, is invited or changes (before the change)
+void BattlegroundQueue::RemoveFromQueuedTotals(GroupQueueInfo const* ginfo)
+{
+    if (ginfo->IsInvitedToBGInstanceGUID)
+        return;
+
+    QueuedTotals& totals = m_QueuedTotals[ginfo->BracketId];
+    totals.Players[ginfo->QueueGroupType] -= ginfo->Players.size();
+    --totals.Groups[ginfo->QueueGroupType];
+    totals.ChangedSinceRatedScan = true;
+}
+
+// the caller moves the group to m_QueuedGroups[ginfo->BracketId][groupType]
+void BattlegroundQueue::SetQueueGroupType(GroupQueueInfo* ginfo, uint8 groupType)
+{
+    RemoveFromQueuedTotals(ginfo);
+    ginfo->QueueGroupType = groupType;
+    AddToQueuedTotals(ginfo);
+}
+
 //remove player from queue and from group info, if group info is empty then remove it too
 void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
 {
@@ -299,32 +327,12 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     }
 
     GroupQueueInfo* group = itr->second.GroupInfo;
-    GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
+    uint32 index = group->QueueGroupType;
 
-    uint32 index = (group->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
-
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
-    {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += PVP_TEAMS_COUNT)
-        {
-            GroupsQueueType::iterator k = m_QueuedGroups[bracket_id_tmp][j].begin();
-            for (; k != m_QueuedGroups[bracket_id_tmp][j].end(); ++k)
-            {
-                if ((*k) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = k;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
+    // the group knows in which list it is queued, only that one has to be searched
+    GroupsQueueType::iterator group_itr = std::find(m_QueuedGroups[group->BracketId][index].begin(), m_QueuedGroups[group->BracketId][index].end(), group);
+    if (group_itr != m_QueuedGroups[group->BracketId][index].end())
+        bracket_id = group->BracketId;
 
     //player can't be in queue without group, but just in case
     if (bracket_id == -1)
@@ -342,7 +350,12 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove player queue info from group queue info
     std::map<ObjectGuid, PlayerQueueInfo*>::iterator pitr = group->Players.find(guid);
     if (pitr != group->Players.end())
+    {
+        RemoveFromQueuedTotals(group);
         group->Players.erase(pitr);
+        if (!group->Players.empty())
+            AddToQueuedTotals(group);
+    }
 
     // if invited to bg, and should decrease invited count, then do it
     if (decreaseInvitedCount && group->IsInvitedToBGInstanceGUID)
@@ -435,6 +448,7 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
     {
         // not yet invited
         // set invitation
+        RemoveFromQueuedTotals(ginfo);
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
         BattlegroundTypeId bgTypeId = bg->GetTypeID();
         BattlegroundQueueTypeId bgQueueTypeId = bg->GetQueueId();
@@ -599,7 +613,7 @@ void BattlegroundQueue::FillPlayersToBG(Battleground* bg, BattlegroundBracketId
 bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint32 MinPlayersPerTeam, uint32 MaxPlayersPerTeam)
 {
     //check match
-    if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() && !m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty())
+    if (m_QueuedTotals[bracket_id].Groups[BG_QUEUE_PREMADE_ALLIANCE] && m_QueuedTotals[bracket_id].Groups[BG_QUEUE_PREMADE_HORDE])
     {
         //start premade match
         //if groups aren't invited
@@ -644,6 +658,7 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
             if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
             {
                 //we must insert group to normal queue and erase pointer from premade queue
+                SetQueueGroupType(*itr, BG_QUEUE_NORMAL_ALLIANCE + i);
                 m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
             }
@@ -656,6 +671,12 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
 // this method tries to create battleground or arena with MinPlayersPerTeam against MinPlayersPerTeam
 bool BattlegroundQueue::CheckNormalMatch(Battleground* /*bg_template*/, BattlegroundBracketId bracket_id, uint32 minPlayers, uint32 maxPlayers)
 {
+    // neither team can fill a selection pool, nothing to start (same faction skirmishes need one full pool as well)
+    if (!sBattlegroundMgr->isTesting()
+        && m_QueuedTotals[bracket_id].Players[BG_QUEUE_NORMAL_ALLIANCE] < minPlayers
+        && m_QueuedTotals[bracket_id].Players[BG_QUEUE_NORMAL_HORDE] < minPlayers)
+        return false;
+
     GroupsQueueType::const_iterator itr_team[PVP_TEAMS_COUNT];
     for (uint32 i = 0; i < PVP_TEAMS_COUNT; i++)
     {
@@ -739,6 +760,7 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
         //set correct team
         (*itr)->Team = otherTeamId;
         //add team to other queue
+        SetQueueGroupType(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeam);
         m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + otherTeam].push_front(*itr);
         //remove team from old queue
         GroupsQueueType::iterator itr2 = itr_team;
@@ -755,6 +777,32 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     return true;
 }
 
+bool BattlegroundQueue::CanSkipRatedArenaScan(BattlegroundBracketId bracket_id) const
+{
+    QueuedTotals const& totals = m_QueuedTotals[bracket_id];
+    if (totals.ChangedSinceRatedScan)
+        return false;
+
+    return !totals.NextRatedScanTime || int32(totals.NextRatedScanTime - GameTime::GetGameTimeMS()) > 0;
+}
+
+// remembers that the rated arena queue was scanned with the current content and when the next team starts ignoring ratings
+void BattlegroundQueue::ScheduleNextRatedArenaScan(BattlegroundBracketId bracket_id, int32 discardTime)
+{
+    QueuedTotals& totals = m_QueuedTotals[bracket_id];
+    totals.ChangedSinceRatedScan = false;
+    totals.NextRatedScanTime = 0;
+
+    uint32 firstRatedJoinTime = 0;
+    for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
+        for (GroupQueueInfo const* ginfo : m_QueuedGroups[bracket_id][i])
+            if (!ginfo->IsInvitedToBGInstanceGUID && (int32)ginfo->JoinTime >= discardTime && (!firstRatedJoinTime || ginfo->JoinTime < firstRatedJoinTime))
+                firstRatedJoinTime = ginfo->JoinTime;
+
+    if (firstRatedJoinTime)
+        totals.NextRatedScanTime = firstRatedJoinTime + sBattlegroundMgr->GetRatingDiscardTimer() + 1;
+}
+
 void BattlegroundQueue::UpdateEvents(uint32 diff)
 {
     m_events.Update(diff);
@@ -767,11 +815,17 @@ should be called from Battleground::RemovePlayer function in some cases
 */
 void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundBracketId bracket_id, uint32 arenaRating)
 {
-    //if no players in queue - do nothing
-    if (m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].empty())
+    //if no players waiting for an invitation in queue - do nothing
+    QueuedTotals const& totals = m_QueuedTotals[bracket_id];
+    if (!totals.Groups[BG_QUEUE_PREMADE_ALLIANCE] &&
+        !totals.Groups[BG_QUEUE_PREMADE_HORDE] &&
+        !totals.Groups[BG_QUEUE_NORMAL_ALLIANCE] &&
+        !totals.Groups[BG_QUEUE_NORMAL_HORDE])
+        return;
+
+    // automatic rated arena updates only have to look at the queue when it changed or ratings of a waiting team stop counting
+    bool automaticRatedArenaUpdate = m_queueId.Rated && m_queueId.TeamSize && !arenaRating;
+    if (automaticRatedArenaUpdate && CanSkipRatedArenaScan(bracket_id))
         return;
 
     // battleground with free slot for player should be always in the beggining of the queue
@@ -789,7 +843,8 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundBra
             m_SelectionPools[TEAM_HORDE].Init();
 
             // call a function that does the job for us
-            FillPlayersToBG(bg, bracket_id);
+            if (totals.Players[BG_QUEUE_NORMAL_ALLIANCE] || totals.Players[BG_QUEUE_NORMAL_HORDE])
+                FillPlayersToBG(bg, bracket_id);
 
             // now everything is set, invite players
             for (GroupsQueueType::const_iterator citr = m_SelectionPools[TEAM_ALLIANCE].SelectedGroups.begin(); citr != m_SelectionPools[TEAM_ALLIANCE].SelectedGroups.end(); ++citr)
@@ -918,6 +973,13 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundBra
         // this has to be signed value - when the server starts, this value would be negative and thus overflow
         int32 discardTime = GameTime::GetGameTimeMS() - sBattlegroundMgr->GetRatingDiscardTimer();
 
+        // a match needs two teams waiting for an invitation
+        if (totals.Groups[BG_QUEUE_PREMADE_ALLIANCE] + totals.Groups[BG_QUEUE_PREMADE_HORDE] < 2)
+            return;
+
+        if (automaticRatedArenaUpdate)
+            ScheduleNextRatedArenaScan(bracket_id, discardTime);
+
         // we need to find 2 teams which will play next game
         GroupsQueueType::iterator itr_teams[PVP_TEAMS_COUNT];
         uint8 found = 0;
@@ -981,11 +1043,13 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundBra
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
             if (aTeam->Team != ALLIANCE)
             {
+                SetQueueGroupType(aTeam, BG_QUEUE_PREMADE_ALLIANCE);
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
             }
             if (hTeam->Team != HORDE)
             {
+                SetQueueGroupType(hTeam, BG_QUEUE_PREMADE_HORDE);
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
             }
@@ -49,6 +49,8 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  ArenaMatchmakerRating;                          // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
     uint32  OpponentsMatchmakerRating;                      // for rated arena matches
+    BattlegroundBracketId BracketId;                        // bracket the group is queued in
+    uint8   QueueGroupType;                                 // BattlegroundQueueGroupTypes, list of BattlegroundQueue::m_QueuedGroups holding the group
 };
 
 enum BattlegroundQueueGroupTypes
@@ -122,6 +124,17 @@ class TC_GAME_API BattlegroundQueue
 
         //one selection pool for horde, other one for alliance
         SelectionPool m_SelectionPools[PVP_TEAMS_COUNT];
+
+        // running totals of the groups waiting for an invitation, updated on every queue change
+        // so updates can tell whether walking m_QueuedGroups can find anything
+        struct QueuedTotals
+        {
+            uint32 Players[BG_QUEUE_GROUP_TYPES_COUNT] = { };
+            uint32 Groups[BG_QUEUE_GROUP_TYPES_COUNT] = { };
+            bool ChangedSinceRatedScan = true;
+            uint32 NextRatedScanTime = 0;                   // game time (ms) when a waiting team starts ignoring ratings, rescan then even if nothing changed
+        };
+        QueuedTotals m_QueuedTotals[MAX_BATTLEGROUND_BRACKETS];
         uint32 GetPlayersInQueue(TeamId id);
 
         BattlegroundQueueTypeId const GetQueueId() const { return m_queueId; }
@@ -130,6 +143,11 @@ class TC_GAME_API BattlegroundQueue
         BattlegroundQueueTypeId m_queueId;
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+        void AddToQueuedTotals(GroupQueueInfo const* ginfo);
+        void RemoveFromQueuedTotals(GroupQueueInfo const* ginfo);
+        void SetQueueGroupType(GroupQueueInfo* ginfo, uint8 groupType);
+        bool CanSkipRatedArenaScan(BattlegroundBracketId bracket_id) const;
+        void ScheduleNextRatedArenaScan(BattlegroundBracketId bracket_id, int32 discardTime);
         uint32 m_WaitTimes[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
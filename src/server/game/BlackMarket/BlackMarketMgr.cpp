@@ -33,6 +33,7 @@
 #include "StringConvert.h"
 #include "World.h"
 #include "WorldSession.h"
+#include <limits>
 #include <sstream>
 
 BlackMarketMgr::BlackMarketMgr()
@@ -144,22 +145,32 @@ void BlackMarketMgr::LoadAuctions()
 
 void BlackMarketMgr::Update(bool updateTime)
 {
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     time_t now = GameTime::GetGameTime();
+    if (updateTime)
+    {
+        for (BlackMarketEntryMap::iterator itr = _auctions.begin(); itr != _auctions.end(); ++itr)
+            itr->second->Update(now);
+
+        _lastUpdate = now;
+    }
+    // expiration times only change when a bid is placed, which calls Update(true)
+    else if (now < _nextCompletionTime)
+        return;
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    _nextCompletionTime = std::numeric_limits<time_t>::max();
     for (BlackMarketEntryMap::iterator itr = _auctions.begin(); itr != _auctions.end(); ++itr)
     {
         BlackMarketEntry* entry = itr->second;
+        if (!entry->GetBidder() || entry->GetMailSent())
+            continue;
 
-        if (entry->IsCompleted() && entry->GetBidder())
+        if (entry->IsCompleted())
             SendAuctionWonMail(entry, trans);
-
-        if (updateTime)
-            entry->Update(now);
+        else
+            _nextCompletionTime = std::min(_nextCompletionTime, entry->GetExpirationTime());
     }
 
-    if (updateTime)
-        _lastUpdate = now;
-
     CharacterDatabase.CommitTransaction(trans);
 }
 
@@ -253,6 +264,7 @@ void BlackMarketMgr::BuildItemsResponse(WorldPackets::BlackMarket::BlackMarketRe
 void BlackMarketMgr::AddAuction(BlackMarketEntry* auction)
 {
     _auctions[auction->GetMarketId()] = auction;
+    _nextCompletionTime = time_t(0);
 }
 
 void BlackMarketMgr::AddTemplate(BlackMarketTemplate* templ)
@@ -397,7 +409,7 @@ bool BlackMarketTemplate::LoadFromDB(Field* fields)
 
 void BlackMarketEntry::Update(time_t newTimeOfUpdate)
 {
-    _secondsRemaining = _secondsRemaining - (newTimeOfUpdate - sBlackMarketMgr->GetLastUpdate());
+    _secondsRemaining = uint32(std::max<time_t>(_secondsRemaining - (newTimeOfUpdate - sBlackMarketMgr->GetLastUpdate()), 0));
 }
 
 BlackMarketTemplate const* BlackMarketEntry::GetTemplate() const
@@ -407,7 +419,7 @@ BlackMarketTemplate const* BlackMarketEntry::GetTemplate() const
 
 uint32 BlackMarketEntry::GetSecondsRemaining() const
 {
-    return _secondsRemaining - (GameTime::GetGameTime() - sBlackMarketMgr->GetLastUpdate());
+    return uint32(std::max<time_t>(_secondsRemaining - (GameTime::GetGameTime() - sBlackMarketMgr->GetLastUpdate()), 0));
 }
 
 time_t BlackMarketEntry::GetExpirationTime() const
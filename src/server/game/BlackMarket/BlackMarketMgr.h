@@ -154,6 +154,7 @@ class TC_GAME_API BlackMarketMgr
       BlackMarketEntryMap _auctions;
       BlackMarketTemplateMap _templates;
       time_t _lastUpdate = time_t(0);
+      time_t _nextCompletionTime = time_t(0); // earliest expiration of an auction with a bidder still waiting for its mail
 };
 
 #define sBlackMarketMgr BlackMarketMgr::Instance()
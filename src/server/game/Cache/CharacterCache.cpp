@@ -24,12 +24,28 @@
 #include "Timer.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <string_view>
 #include <unordered_map>
 
 namespace
 {
     std::unordered_map<ObjectGuid, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+    // keys view the Name of the entry they point to, entries must leave the index before their name changes
+    std::unordered_map<std::string_view, CharacterCacheEntry*> _characterCacheByNameStore;
+
+    void AddToNameStore(CharacterCacheEntry& entry)
+    {
+        // erase first, assignment through an existing key would keep viewing the previous owner's name
+        _characterCacheByNameStore.erase(entry.Name);
+        _characterCacheByNameStore.emplace(entry.Name, &entry);
+    }
+
+    void RemoveFromNameStore(CharacterCacheEntry const& entry)
+    {
+        auto itr = _characterCacheByNameStore.find(entry.Name);
+        if (itr != _characterCacheByNameStore.end() && itr->second == &entry)
+            _characterCacheByNameStore.erase(itr);
+    }
 }
 
 CharacterCache::CharacterCache()
@@ -69,6 +85,7 @@ CharacterCache* CharacterCache::instance()
 
 void CharacterCache::LoadCharacterCacheStorage()
 {
+    _characterCacheByNameStore.clear();
     _characterCacheStore.clear();
     uint32 oldMSTime = getMSTime();
 
@@ -79,6 +96,9 @@ void CharacterCache::LoadCharacterCacheStorage()
         return;
     }
 
+    _characterCacheStore.reserve(result->GetRowCount());
+    _characterCacheByNameStore.reserve(result->GetRowCount());
+
     do
     {
         Field* fields = result->Fetch();
@@ -95,6 +115,7 @@ Modifying functions
 void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted)
 {
     CharacterCacheEntry& data = _characterCacheStore[guid];
+    RemoveFromNameStore(data);
     data.Guid = guid;
     data.Name = name;
     data.AccountId = accountId;
@@ -108,13 +129,17 @@ void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accou
     data.IsDeleted = isDeleted;
 
     // Fill Name to Guid Store
-    _characterCacheByNameStore[name] = &data;
+    AddToNameStore(data);
 }
 
-void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name)
+void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& /*name*/)
 {
-    _characterCacheStore.erase(guid);
-    _characterCacheByNameStore.erase(name);
+    auto itr = _characterCacheStore.find(guid);
+    if (itr == _characterCacheStore.end())
+        return;
+
+    RemoveFromNameStore(itr->second);
+    _characterCacheStore.erase(itr);
 }
 
 void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string const& name, Optional<uint8> gender /*= {}*/, Optional<uint8> race /*= {}*/)
@@ -123,8 +148,9 @@ void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string con
     if (itr == _characterCacheStore.end())
         return;
 
-    std::string oldName = itr->second.Name;
+    RemoveFromNameStore(itr->second);
     itr->second.Name = name;
+    AddToNameStore(itr->second);
 
     if (gender)
         itr->second.Sex = *gender;
@@ -135,10 +161,6 @@ void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string con
     WorldPackets::Misc::InvalidatePlayer invalidatePlayer;
     invalidatePlayer.Guid = guid;
     sWorld->SendGlobalMessage(invalidatePlayer.Write());
-
-    // Correct name -> pointer storage
-    _characterCacheByNameStore.erase(oldName);
-    _characterCacheByNameStore[name] = &itr->second;
 }
 
 void CharacterCache::UpdateCharacterGender(ObjectGuid const& guid, uint8 gender)
@@ -196,7 +218,11 @@ void CharacterCache::UpdateCharacterInfoDeleted(ObjectGuid const& guid, bool del
     itr->second.IsDeleted = deleted;
 
     if (name)
+    {
+        RemoveFromNameStore(itr->second);
         itr->second.Name = *name;
+        AddToNameStore(itr->second);
+    }
 }
 
 
@@ -18,6 +18,7 @@
 #include "CalendarMgr.h"
 #include "CalendarPackets.h"
 #include "CharacterCache.h"
+#include "Containers.h"
 #include "DatabaseEnv.h"
 #include "GameTime.h"
 #include "Guild.h"
@@ -91,6 +92,7 @@ void CalendarMgr::LoadFromDB()
 
             CalendarEvent* calendarEvent = new CalendarEvent(eventID, ownerGUID, guildID, type, textureID, date, flags, title, description, lockDate);
             _events.insert(calendarEvent);
+            IndexEvent(calendarEvent);
 
             _maxEventId = std::max(_maxEventId, eventID);
 
@@ -119,6 +121,7 @@ void CalendarMgr::LoadFromDB()
 
             CalendarInvite* invite = new CalendarInvite(inviteId, eventId, invitee, senderGUID, responseTime, status, rank, note);
             _invites[eventId].push_back(invite);
+            IndexInvite(invite);
 
             _maxInviteId = std::max(_maxInviteId, inviteId);
 
@@ -137,9 +140,57 @@ void CalendarMgr::LoadFromDB()
             _freeInviteIds.push_back(i);
 }
 
+void CalendarMgr::IndexEvent(CalendarEvent* calendarEvent)
+{
+    _eventsById[calendarEvent->GetEventId()] = calendarEvent;
+    _eventDateIndex[calendarEvent->GetEventId()] = _eventsByDate.emplace(calendarEvent->GetDate(), calendarEvent);
+    if (calendarEvent->GetGuildId())
+        _guildEvents[calendarEvent->GetGuildId()].insert(calendarEvent);
+}
+
+void CalendarMgr::UnindexEvent(CalendarEvent* calendarEvent)
+{
+    _eventsById.erase(calendarEvent->GetEventId());
+
+    auto dateItr = _eventDateIndex.find(calendarEvent->GetEventId());
+    if (dateItr != _eventDateIndex.end())
+    {
+        _eventsByDate.erase(dateItr->second);
+        _eventDateIndex.erase(dateItr);
+    }
+
+    auto guildItr = _guildEvents.find(calendarEvent->GetGuildId());
+    if (guildItr != _guildEvents.end())
+    {
+        guildItr->second.erase(calendarEvent);
+        if (guildItr->second.empty())
+            _guildEvents.erase(guildItr);
+    }
+}
+
+void CalendarMgr::IndexInvite(CalendarInvite* invite)
+{
+    _invitesById[invite->GetInviteId()] = invite;
+    _playerInvites[invite->GetInviteeGUID()].push_back(invite);
+}
+
+void CalendarMgr::UnindexInvite(CalendarInvite* invite)
+{
+    _invitesById.erase(invite->GetInviteId());
+
+    auto playerItr = _playerInvites.find(invite->GetInviteeGUID());
+    if (playerItr != _playerInvites.end())
+    {
+        playerItr->second.erase(std::remove(playerItr->second.begin(), playerItr->second.end(), invite), playerItr->second.end());
+        if (playerItr->second.empty())
+            _playerInvites.erase(playerItr);
+    }
+}
+
 void CalendarMgr::AddEvent(CalendarEvent* calendarEvent, CalendarSendEventType sendType)
 {
     _events.insert(calendarEvent);
+    IndexEvent(calendarEvent);
     UpdateEvent(calendarEvent);
     SendCalendarEvent(calendarEvent->GetOwnerGUID(), *calendarEvent, sendType);
 }
@@ -155,6 +206,7 @@ void CalendarMgr::AddInvite(CalendarEvent* calendarEvent, CalendarInvite* invite
     if (!calendarEvent->IsGuildAnnouncement())
     {
         _invites[invite->GetEventId()].push_back(invite);
+        IndexInvite(invite);
         UpdateInvite(invite, trans);
     }
 }
@@ -199,6 +251,7 @@ void CalendarMgr::RemoveEvent(CalendarEvent* calendarEvent, ObjectGuid remover)
         if (!remover.IsEmpty() && invite->GetInviteeGUID() != remover)
             mail.SendMailTo(trans, MailReceiver(invite->GetInviteeGUID().GetCounter()), calendarEvent, MAIL_CHECK_MASK_COPIED);
 
+        UnindexInvite(invite);
         delete invite;
     }
 
@@ -210,6 +263,7 @@ void CalendarMgr::RemoveEvent(CalendarEvent* calendarEvent, ObjectGuid remover)
     CharacterDatabase.CommitTransaction(trans);
 
     _events.erase(calendarEvent);
+    UnindexEvent(calendarEvent);
     delete calendarEvent;
 }
 
@@ -244,12 +298,21 @@ void CalendarMgr::RemoveInvite(uint64 inviteId, uint64 eventId, ObjectGuid /*rem
     //    MailDraft(calendarEvent->BuildCalendarMailSubject(remover), calendarEvent->BuildCalendarMailBody())
     //        .SendMailTo(trans, MailReceiver((*itr)->GetInvitee()), calendarEvent, MAIL_CHECK_MASK_COPIED);
 
+    UnindexInvite(*itr);
     delete *itr;
     _invites[eventId].erase(itr);
 }
 
 void CalendarMgr::UpdateEvent(CalendarEvent* calendarEvent)
 {
+    // date may have been changed by the caller
+    auto dateItr = _eventDateIndex.find(calendarEvent->GetEventId());
+    if (dateItr != _eventDateIndex.end() && dateItr->second->first != calendarEvent->GetDate())
+    {
+        _eventsByDate.erase(dateItr->second);
+        dateItr->second = _eventsByDate.emplace(calendarEvent->GetDate(), calendarEvent);
+    }
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CALENDAR_EVENT);
     stmt->setUInt64(0, calendarEvent->GetEventId());
     stmt->setUInt64(1, calendarEvent->GetOwnerGUID().GetCounter());
@@ -279,13 +342,8 @@ void CalendarMgr::UpdateInvite(CalendarInvite* invite, CharacterDatabaseTransact
 
 void CalendarMgr::RemoveAllPlayerEventsAndInvites(ObjectGuid guid)
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end();)
-    {
-        CalendarEvent* event = *itr;
-        ++itr;
-        if (event->GetOwnerGUID() == guid)
-            RemoveEvent(event, ObjectGuid::Empty); // don't send mail if removing a character
-    }
+    for (CalendarEvent* event : GetEventsCreatedBy(guid, true))
+        RemoveEvent(event, ObjectGuid::Empty); // don't send mail if removing a character
 
     CalendarInviteStore playerInvites = GetPlayerInvites(guid);
     for (CalendarInviteStore::const_iterator itr = playerInvites.begin(); itr != playerInvites.end(); ++itr)
@@ -294,9 +352,10 @@ void CalendarMgr::RemoveAllPlayerEventsAndInvites(ObjectGuid guid)
 
 void CalendarMgr::RemovePlayerGuildEventsAndSignups(ObjectGuid guid, ObjectGuid::LowType guildId)
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->GetOwnerGUID() == guid && ((*itr)->IsGuildEvent() || (*itr)->IsGuildAnnouncement()))
-            RemoveEvent((*itr)->GetEventId(), guid);
+    // RemoveEvent modifies _events, iterate over a copy
+    for (CalendarEvent* event : GetEventsCreatedBy(guid, true))
+        if (event->IsGuildEvent() || event->IsGuildAnnouncement())
+            RemoveEvent(event, guid);
 
     CalendarInviteStore playerInvites = GetPlayerInvites(guid);
     for (CalendarInviteStore::const_iterator itr = playerInvites.begin(); itr != playerInvites.end(); ++itr)
@@ -307,9 +366,8 @@ void CalendarMgr::RemovePlayerGuildEventsAndSignups(ObjectGuid guid, ObjectGuid:
 
 CalendarEvent* CalendarMgr::GetEvent(uint64 eventId) const
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->GetEventId() == eventId)
-            return *itr;
+    if (CalendarEvent* calendarEvent = Trinity::Containers::MapGetValuePtr(_eventsById, eventId))
+        return calendarEvent;
 
     TC_LOG_DEBUG("calendar", "CalendarMgr::GetEvent: [" UI64FMTD "] not found!", eventId);
     return nullptr;
@@ -317,10 +375,8 @@ CalendarEvent* CalendarMgr::GetEvent(uint64 eventId) const
 
 CalendarInvite* CalendarMgr::GetInvite(uint64 inviteId) const
 {
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteId() == inviteId)
-                return *itr2;
+    if (CalendarInvite* invite = Trinity::Containers::MapGetValuePtr(_invitesById, inviteId))
+        return invite;
 
     TC_LOG_DEBUG("calendar", "CalendarMgr::GetInvite: [" UI64FMTD "] not found!", inviteId);
     return nullptr;
@@ -366,13 +422,9 @@ void CalendarMgr::DeleteOldEvents()
 {
     time_t oldEventsTime = GameTime::GetGameTime() - CALENDAR_OLD_EVENTS_DELETION_TIME;
 
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end();)
-    {
-        CalendarEvent* event = *itr;
-        ++itr;
-        if (event->GetDate() < oldEventsTime)
-            RemoveEvent(event, ObjectGuid::Empty);
-    }
+    // oldest events first, RemoveEvent drops them from the index
+    while (!_eventsByDate.empty() && _eventsByDate.begin()->first < oldEventsTime)
+        RemoveEvent(_eventsByDate.begin()->second, ObjectGuid::Empty);
 }
 
 CalendarEventStore CalendarMgr::GetEventsCreatedBy(ObjectGuid guid, bool includeGuildEvents)
@@ -392,10 +444,13 @@ CalendarEventStore CalendarMgr::GetGuildEvents(ObjectGuid::LowType guildId)
     if (!guildId)
         return result;
 
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->IsGuildEvent() || (*itr)->IsGuildAnnouncement())
-            if ((*itr)->GetGuildId() == guildId)
-                result.insert(*itr);
+    auto itr = _guildEvents.find(guildId);
+    if (itr == _guildEvents.end())
+        return result;
+
+    for (CalendarEvent* calendarEvent : itr->second)
+        if (calendarEvent->IsGuildEvent() || calendarEvent->IsGuildAnnouncement())
+            result.insert(calendarEvent);
 
     return result;
 }
@@ -404,17 +459,18 @@ CalendarEventStore CalendarMgr::GetPlayerEvents(ObjectGuid guid)
 {
     CalendarEventStore events;
 
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteeGUID() == guid)
-                if (CalendarEvent* event = GetEvent(itr->first)) // NULL check added as attempt to fix #11512
-                    events.insert(event);
+    auto inviteItr = _playerInvites.find(guid);
+    if (inviteItr != _playerInvites.end())
+        for (CalendarInvite const* invite : inviteItr->second)
+            if (CalendarEvent* event = GetEvent(invite->GetEventId())) // NULL check added as attempt to fix #11512
+                events.insert(event);
 
     if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
-        if (player->GetGuildId())
-            for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-                if ((*itr)->GetGuildId() == player->GetGuildId())
-                    events.insert(*itr);
+    {
+        auto guildItr = _guildEvents.find(player->GetGuildId());
+        if (guildItr != _guildEvents.end())
+            events.insert(guildItr->second.begin(), guildItr->second.end());
+    }
 
     return events;
 }
@@ -426,14 +482,11 @@ CalendarInviteStore const& CalendarMgr::GetEventInvites(uint64 eventId)
 
 CalendarInviteStore CalendarMgr::GetPlayerInvites(ObjectGuid guid)
 {
-    CalendarInviteStore invites;
-
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteeGUID() == guid)
-                invites.push_back(*itr2);
+    auto itr = _playerInvites.find(guid);
+    if (itr == _playerInvites.end())
+        return CalendarInviteStore();
 
-    return invites;
+    return itr->second;
 }
 
 uint32 CalendarMgr::GetPlayerNumPending(ObjectGuid guid)
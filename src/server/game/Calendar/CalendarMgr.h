@@ -24,6 +24,7 @@
 #include <deque>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 class WorldPacket;
@@ -290,6 +291,19 @@ class TC_GAME_API CalendarMgr
         CalendarEventStore _events;
         CalendarEventInviteStore _invites;
 
+        // lookup indices over _events and _invites, kept up to date by Index*/Unindex* helpers
+        std::unordered_map<uint64, CalendarEvent*> _eventsById;
+        std::unordered_map<uint64, CalendarInvite*> _invitesById;
+        std::unordered_map<ObjectGuid, CalendarInviteStore> _playerInvites;
+        std::unordered_map<ObjectGuid::LowType, CalendarEventStore> _guildEvents;
+        std::multimap<time_t, CalendarEvent*> _eventsByDate;
+        std::unordered_map<uint64, std::multimap<time_t, CalendarEvent*>::iterator> _eventDateIndex;
+
+        void IndexEvent(CalendarEvent* calendarEvent);
+        void UnindexEvent(CalendarEvent* calendarEvent);
+        void IndexInvite(CalendarInvite* invite);
+        void UnindexInvite(CalendarInvite* invite);
+
         std::deque<uint64> _freeEventIds;
         std::deque<uint64> _freeInviteIds;
         uint64 _maxEventId;
@@ -204,6 +204,7 @@ void Channel::JoinChannel(Player* player, std::string const& pass)
         _nextActivityUpdateTime = 0; // force activity update on next channel tick
 
     PlayerInfo& playerInfo = _playersStore[guid];
+    playerInfo.SetPlayer(player);
     playerInfo.SetInvisible(!player->isGMVisible());
 
     /*
@@ -614,7 +615,7 @@ void Channel::List(Player const* player)
     list._Members.reserve(_playersStore.size());
     for (PlayerContainer::value_type const& i : _playersStore)
     {
-        Player* member = ObjectAccessor::FindConnectedPlayer(i.first);
+        Player* member = i.second.GetPlayer();
 
         // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
         // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
@@ -982,7 +983,7 @@ void Channel::SendToAll(Builder& builder, ObjectGuid const& guid, ObjectGuid con
     Trinity::LocalizedDo<Builder> localizer(builder);
 
     for (PlayerContainer::value_type const& i : _playersStore)
-        if (Player* player = ObjectAccessor::FindConnectedPlayer(i.first))
+        if (Player* player = i.second.GetPlayer())
             if (guid.IsEmpty() || !player->GetSocial()->HasIgnore(guid, accountGuid))
                 localizer(player);
 }
@@ -994,7 +995,7 @@ void Channel::SendToAllButOne(Builder& builder, ObjectGuid const& who) const
 
     for (PlayerContainer::value_type const& i : _playersStore)
         if (i.first != who)
-            if (Player* player = ObjectAccessor::FindConnectedPlayer(i.first))
+            if (Player* player = i.second.GetPlayer())
                 localizer(player);
 }
 
@@ -1014,7 +1015,7 @@ void Channel::SendToAllWithAddon(Builder& builder, std::string const& addonPrefi
     Trinity::LocalizedDo<Builder> localizer(builder);
 
     for (PlayerContainer::value_type const& i : _playersStore)
-        if (Player* player = ObjectAccessor::FindConnectedPlayer(i.first))
+        if (Player* player = i.second.GetPlayer())
             if (player->GetSession()->IsAddonRegistered(addonPrefix) && (guid.IsEmpty() || !player->GetSocial()->HasIgnore(guid, accountGuid)))
                 localizer(player);
 }
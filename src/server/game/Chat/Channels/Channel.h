@@ -136,6 +136,10 @@ class TC_GAME_API Channel
         bool IsInvisible() const { return _invisible; }
         void SetInvisible(bool on) { _invisible = on; }
 
+        // members leave all channels on logout (Player::CleanupChannels), so this is valid while in _playersStore
+        Player* GetPlayer() const { return _player; }
+        void SetPlayer(Player* player) { _player = player; }
+
         inline bool HasFlag(uint8 flag) const { return (_flags & flag) != 0; }
         inline void SetFlag(uint8 flag) { _flags |= flag; }
         inline void RemoveFlag(uint8 flag) { _flags &= ~flag; }
@@ -168,6 +172,7 @@ class TC_GAME_API Channel
         }
 
     private:
+        Player* _player = nullptr;
         uint8 _flags = MEMBER_FLAG_NONE;
         bool _invisible = false;
     };
@@ -36,6 +36,7 @@
 #include "World.h"
 #include "WorldSession.h"
 #include <boost/algorithm/string/replace.hpp>
+#include <algorithm>
 #include <sstream>
 
 Player* ChatHandler::GetPlayer() { return m_session ? m_session->GetPlayer() : nullptr; }
@@ -227,37 +228,25 @@ void ChatHandler::SendSysMessage(uint32 entry)
 bool ChatHandler::ExecuteCommandInTable(std::vector<ChatCommand> const& table, const char* text, std::string const& fullcmd)
 {
     char const* oldtext = text;
-    std::string cmd = "";
+    char const* cmdEnd = text;
+    while (*cmdEnd != ' ' && *cmdEnd != '\0')
+        ++cmdEnd;
 
-    while (*text != ' ' && *text != '\0')
-    {
-        cmd += *text;
-        ++text;
-    }
+    // hasStringAbbr stops at the first space, the command token is matched in place
+    std::string_view cmd(text, cmdEnd - text);
 
+    text = cmdEnd;
     while (*text == ' ') ++text;
 
+    // an exact match takes priority over every command the token is an abbreviation of
+    bool hasExactMatch = std::any_of(table.begin(), table.end(), [cmd](ChatCommand const& command) { return std::string_view(command.Name) == cmd; });
+
     for (uint32 i = 0; i < table.size(); ++i)
     {
-        if (!hasStringAbbr(table[i].Name, cmd.c_str()))
+        if (!hasStringAbbr(table[i].Name, oldtext))
             continue;
 
-        bool match = false;
-        if (strlen(table[i].Name) > cmd.length())
-        {
-            for (uint32 j = 0; j < table.size(); ++j)
-            {
-                if (!hasStringAbbr(table[j].Name, cmd.c_str()))
-                    continue;
-
-                if (strcmp(table[j].Name, cmd.c_str()) == 0)
-                {
-                    match = true;
-                    break;
-                }
-            }
-        }
-        if (match)
+        if (hasExactMatch && strlen(table[i].Name) > cmd.length())
             continue;
 
         // select subcommand from child commands list
@@ -56,7 +56,8 @@ class TC_GAME_API ChatHandler
         template<typename... Args>
         void PSendSysMessage(const char* fmt, Args&&... args)
         {
-            SendSysMessage(Trinity::StringFormat(fmt, std::forward<Args>(args)...).c_str());
+            Trinity::FormatBuffer buffer;
+            SendSysMessage(Trinity::StringFormatTo(buffer, fmt, std::forward<Args>(args)...));
         }
 
         template<typename... Args>
@@ -28,6 +28,7 @@
 #include "StringFormat.h"
 #include "World.h"
 #include "advstd.h"
+#include <unordered_map>
 
 using namespace Trinity::Hyperlinks;
 
@@ -699,48 +700,86 @@ static bool ValidateLinkInfo(HyperlinkInfo const& info)
     return false;
 }
 
-// Validates all hyperlinks and control sequences contained in str
-bool Trinity::Hyperlinks::CheckAllLinks(std::string_view str)
+namespace
 {
-    // Step 1: Disallow all control sequences except ||, |H, |h, |c and |r
+    // Links that passed validation on this thread, chat spam (trade channel) repeats the same few links over and over
+    // Only successes are kept, a cached link is never rejected later unless the severity setting changes
+    class ValidLinkCache
     {
-        std::string_view::size_type pos = 0;
-        while ((pos = str.find('|', pos)) != std::string::npos)
+    public:
+        static constexpr std::size_t MaxSize = 1024;
+
+        bool Contains(std::string_view link, int32 severity)
         {
-            ++pos;
-            if (pos == str.length())
-                return false;
-            char next = str[pos];
-            if (next == 'H' || next == 'h' || next == 'c' || next == 'r' || next == '|')
-                ++pos;
-            else
+            if (severity != _severity)
+            {
+                _links.clear();
+                _severity = severity;
                 return false;
+            }
+
+            auto range = _links.equal_range(std::hash<std::string_view>()(link));
+            for (auto itr = range.first; itr != range.second; ++itr)
+                if (itr->second == link)
+                    return true;
+
+            return false;
         }
-    }
 
-    // Step 2: Parse all link sequences
-    // They look like this: |c<color>|H<linktag>:<linkdata>|h[<linktext>]|h|r
+        void Add(std::string_view link)
+        {
+            if (_links.size() >= MaxSize)
+                _links.clear();
+
+            _links.emplace(std::hash<std::string_view>()(link), std::string(link));
+        }
+
+    private:
+        std::unordered_multimap<std::size_t, std::string> _links;
+        int32 _severity = 0;
+    };
+
+    thread_local ValidLinkCache ValidLinks;
+}
+
+// Validates all hyperlinks and control sequences contained in str
+bool Trinity::Hyperlinks::CheckAllLinks(std::string_view str)
+{
+    // Single pass over all control sequences, the only ones allowed outside of links are escaped pipes (||)
+    // Links look like this: |c<color>|H<linktag>:<linkdata>|h[<linktext>]|h|r
     // - <color> is 8 hex characters AARRGGBB
     // - <linktag> is arbitrary length [a-z_]
     // - <linkdata> is arbitrary length, no | contained
     // - <linktext> is printable
+    int32 const severity = static_cast<int32>(sWorld->getIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY));
+    std::string_view::size_type pos;
+    while ((pos = str.find('|')) != std::string_view::npos)
     {
-        std::string::size_type pos;
-        while ((pos = str.find('|')) != std::string::npos)
+        if (pos + 1 == str.length())
+            return false;
+
+        if (str[pos + 1] == '|') // this is an escaped pipe character (||)
         {
-            if (str[pos + 1] == '|') // this is an escaped pipe character (||)
-            {
-                str = str.substr(pos + 2);
-                continue;
-            }
+            str.remove_prefix(pos + 2);
+            continue;
+        }
 
-            HyperlinkInfo info = ParseSingleHyperlink(str.substr(pos));
-            if (!info || !ValidateLinkInfo(info))
+        str.remove_prefix(pos);
+        HyperlinkInfo info = ParseSingleHyperlink(str);
+        if (!info)
+            return false;
+
+        std::string_view link = str.substr(0, str.length() - info.tail.length());
+        if (!ValidLinks.Contains(link, severity))
+        {
+            if (!ValidateLinkInfo(info))
                 return false;
 
-            // tag is fine, find the next one
-            str = info.tail;
+            ValidLinks.Add(link);
         }
+
+        // tag is fine, find the next one
+        str = info.tail;
     }
 
     // all tags are valid
@@ -18,7 +18,10 @@
 #include "CombatManager.h"
 #include "Creature.h"
 #include "CreatureAI.h"
+#include "GameTime.h"
+#include "Map.h"
 #include "Player.h"
+#include <algorithm>
 
 /*static*/ bool CombatManager::CanBeginCombat(Unit const* a, Unit const* b)
 {
@@ -84,17 +87,15 @@ void CombatReference::EndCombat()
     delete this;
 }
 
-bool PvPCombatReference::Update(uint32 tdiff)
+PvPCombatReference::PvPCombatReference(Unit* first, Unit* second) : CombatReference(first, second, true),
+    _expireTime(GameTime::Now() + Milliseconds(PVP_COMBAT_TIMEOUT))
 {
-    if (_combatTimer <= tdiff)
-        return false;
-    _combatTimer -= tdiff;
-    return true;
 }
 
 void PvPCombatReference::Refresh()
 {
-    _combatTimer = PVP_COMBAT_TIMEOUT;
+    // the expiry scheduled on the map is not moved, it reschedules itself when it finds the new time
+    _expireTime = GameTime::Now() + Milliseconds(PVP_COMBAT_TIMEOUT);
 
     bool needFirstAI = false, needSecondAI = false;
     if (_suppressFirst)
@@ -128,20 +129,29 @@ CombatManager::~CombatManager()
     ASSERT(_pvpRefs.empty(), "CombatManager::~CombatManager - %s: we still have %zu PvP combat references, one of them is with %s", _owner->GetGUID().ToString().c_str(), _pvpRefs.size(), _pvpRefs.begin()->first.ToString().c_str());
 }
 
-void CombatManager::Update(uint32 tdiff)
+void CombatManager::ProcessPvPCombatExpiry(ObjectGuid const& other, PvPCombatReference const* ref)
 {
-    auto it = _pvpRefs.begin(), end = _pvpRefs.end();
-    while (it != end)
+    auto it = _pvpRefs.find(other);
+    if (it == _pvpRefs.end() || it->second != ref) // combat already ended
+        return;
+
+    if (ref->GetExpireTime() > GameTime::Now()) // refreshed since it was scheduled
     {
-        PvPCombatReference* const ref = it->second;
-        if (ref->first == _owner && !ref->Update(tdiff)) // only update if we're the first unit involved (otherwise double decrement)
-        {
-            it = _pvpRefs.erase(it), end = _pvpRefs.end(); // remove it from our refs first to prevent invalidation
-            ref->EndCombat(); // this will remove it from the other side
-        }
-        else
-            ++it;
+        _owner->GetMap()->SchedulePvPCombatExpiry(ref);
+        return;
     }
+
+    it->second->EndCombat();
+}
+
+void CombatManager::RefreshDistantCombatPartners(float range)
+{
+    _distantCombatPartners.clear();
+    _distantCombatPartnersDirty = false;
+    for (auto const& pair : _pveRefs)
+        if (Creature* unit = pair.second->GetOther(_owner)->ToCreature())
+            if (unit->GetMapId() == _owner->GetMapId() && !unit->IsWithinDistInMap(_owner, range, false))
+                _distantCombatPartners.push_back(unit);
 }
 
 bool CombatManager::HasPvECombatWithPlayers() const
@@ -198,6 +208,9 @@ bool CombatManager::SetInCombatWith(Unit* who)
     PutReference(who->GetGUID(), ref);
     who->GetCombatManager().PutReference(_owner->GetGUID(), ref);
 
+    if (ref->_isPvP)
+        _owner->GetMap()->SchedulePvPCombatExpiry(static_cast<PvPCombatReference*>(ref));
+
     // now, sequencing is important - first we update the combat state, which will set both units in combat and do non-AI combat start stuff
     bool const needSelfAI  = UpdateOwnerCombatState();
     bool const needOtherAI = who->GetCombatManager().UpdateOwnerCombatState();
@@ -322,6 +335,7 @@ void CombatManager::PutReference(ObjectGuid const& guid, CombatReference* ref)
         auto& inMap = _pveRefs[guid];
         ASSERT(!inMap, "Duplicate combat state at %p being inserted for %s vs %s - memory leak!", ref, _owner->GetGUID().ToString().c_str(), guid.ToString().c_str());
         inMap = ref;
+        _distantCombatPartnersDirty = true;
     }
 }
 
@@ -330,7 +344,17 @@ void CombatManager::PurgeReference(ObjectGuid const& guid, bool pvp)
     if (pvp)
         _pvpRefs.erase(guid);
     else
+    {
         _pveRefs.erase(guid);
+
+        // partners are only valid while in combat with us, drop them right away
+        auto itr = std::find_if(_distantCombatPartners.begin(), _distantCombatPartners.end(), [&guid](Creature const* unit) { return unit->GetGUID() == guid; });
+        if (itr != _distantCombatPartners.end())
+        {
+            *itr = _distantCombatPartners.back();
+            _distantCombatPartners.pop_back();
+        }
+    }
 }
 
 bool CombatManager::UpdateOwnerCombatState() const
@@ -19,9 +19,12 @@
 #define TRINITY_COMBATMANAGER_H
 
 #include "Common.h"
+#include "Duration.h"
 #include "ObjectGuid.h"
 #include <unordered_map>
+#include <vector>
 
+class Creature;
 class Unit;
 
 /********************************************************************************************************************************************************\
@@ -48,6 +51,10 @@ class Unit;
  * Note that (threat => combat) is a strong guarantee provided in conjunction with ThreatManager. Thus:                                                 *
  *  - Ending combat between two units will also delete any threat references that may exist between them.                                               *
  *  - Adding threat will also create a combat reference between the units if one doesn't exist yet.                                                     *
+ *                                                                                                                                                      *
+ * PvP combat references time out PVP_COMBAT_TIMEOUT after their last refresh. The timeout is not ticked per reference: the map of .first keeps one     *
+ * scheduled expiry per reference (Map::SchedulePvPCombatExpiry) and hands it back to CombatManager::ProcessPvPCombatExpiry when it is due, which       *
+ * either ends the combat or schedules it again if the reference was refreshed in the meantime.                                                         *
 \********************************************************************************************************************************************************/
 
 // Please check Game/Combat/CombatManager.h for documentation on how this class works!
@@ -79,14 +86,15 @@ struct TC_GAME_API PvPCombatReference : public CombatReference
     void SuppressFor(Unit* who);
     bool IsSuppressedFor(Unit const* who) const { return (who == first) ? _suppressFirst : _suppressSecond; }
 
+    TimePoint GetExpireTime() const { return _expireTime; }
+
 private:
-    PvPCombatReference(Unit* first, Unit* second) : CombatReference(first, second, true) { }
+    PvPCombatReference(Unit* first, Unit* second);
 
-    bool Update(uint32 tdiff);
     void Refresh();
     void Suppress(Unit* who) { (who == first ? _suppressFirst : _suppressSecond) = true; }
 
-    uint32 _combatTimer = PVP_COMBAT_TIMEOUT;
+    TimePoint _expireTime;
     bool _suppressFirst = false;
     bool _suppressSecond = false;
 
@@ -99,9 +107,8 @@ class TC_GAME_API CombatManager
     public:
         static bool CanBeginCombat(Unit const* a, Unit const* b);
 
-        CombatManager(Unit* owner) : _owner(owner) { }
+        CombatManager(Unit* owner) : _owner(owner), _distantCombatPartnersDirty(false) { }
         ~CombatManager();
-        void Update(uint32 tdiff); // called from Unit::Update
 
         Unit* GetOwner() const { return _owner; }
         bool HasCombat() const { return HasPvECombat() || HasPvPCombat(); }
@@ -125,6 +132,15 @@ class TC_GAME_API CombatManager
         void EndAllPvPCombat();
         void EndAllCombat() { EndAllPvECombat(); EndAllPvPCombat(); }
 
+        // called by the map when the expiry scheduled for ref (with us as ref->first) is due
+        void ProcessPvPCombatExpiry(ObjectGuid const& other, PvPCombatReference const* ref);
+
+        // creatures in PvE combat with the owner that were farther than range away at the last refresh, the map keeps them updated
+        // entries are removed as soon as combat with them ends, new combat partners are only picked up by the next refresh
+        std::vector<Creature*> const& GetDistantCombatPartners() const { return _distantCombatPartners; }
+        bool HasNewCombatPartners() const { return _distantCombatPartnersDirty; }
+        void RefreshDistantCombatPartners(float range);
+
         CombatManager(CombatManager const&) = delete;
         CombatManager& operator=(CombatManager const&) = delete;
 
@@ -136,7 +152,8 @@ class TC_GAME_API CombatManager
         Unit* const _owner;
         std::unordered_map<ObjectGuid, CombatReference*> _pveRefs;
         std::unordered_map<ObjectGuid, PvPCombatReference*> _pvpRefs;
-
+        std::vector<Creature*> _distantCombatPartners;
+        bool _distantCombatPartnersDirty;
 
     friend struct CombatReference;
     friend struct PvPCombatReference;
@@ -36,18 +36,26 @@ void ThreatReference::AddThreat(float amount)
 {
     if (amount == 0.0f)
         return;
-    _baseAmount = std::max<float>(_baseAmount + amount, 0.0f);
-    if (amount > 0.0f)
-        HeapNotifyIncreased();
-    else
-        HeapNotifyDecreased();
     _mgr._needClientUpdate = true;
+    // increases can never be clamped, so they are summed up and applied to the heap later
+    if (amount > 0.0f)
+    {
+        if (_pendingAmount == 0.0f)
+            _mgr._pendingThreatRefs.push_back(this);
+        _pendingAmount += amount;
+        return;
+    }
+
+    ApplyPendingThreat();
+    _baseAmount = std::max<float>(_baseAmount + amount, 0.0f);
+    HeapNotifyDecreased();
 }
 
 void ThreatReference::ScaleThreat(float factor)
 {
     if (factor == 1.0f)
         return;
+    ApplyPendingThreat();
     _baseAmount *= factor;
     if (factor > 1.0f)
         HeapNotifyIncreased();
@@ -56,6 +64,16 @@ void ThreatReference::ScaleThreat(float factor)
     _mgr._needClientUpdate = true;
 }
 
+void ThreatReference::ApplyPendingThreat()
+{
+    if (_pendingAmount == 0.0f)
+        return;
+    // stays queued in _mgr._pendingThreatRefs, skipped there as nothing is pending anymore
+    _baseAmount += _pendingAmount;
+    _pendingAmount = 0.0f;
+    HeapNotifyIncreased();
+}
+
 void ThreatReference::UpdateOffline()
 {
     bool const shouldBeOffline = ShouldBeOffline();
@@ -190,6 +208,7 @@ void ThreatManager::Update(uint32 tdiff)
 {
     if (!CanHaveThreatList() || IsThreatListEmpty(true))
         return;
+    ApplyPendingThreat();
     if (_updateTimer <= tdiff)
     {
         UpdateVictim();
@@ -251,6 +270,7 @@ float ThreatManager::GetThreat(Unit const* who, bool includeOffline) const
 
 std::vector<ThreatReference*> ThreatManager::GetModifiableThreatList()
 {
+    ApplyPendingThreat();
     std::vector<ThreatReference*> list;
     list.reserve(_myThreatListEntries.size());
     for (auto it = _sortedThreatList.ordered_begin(), end = _sortedThreatList.ordered_end(); it != end; ++it)
@@ -421,6 +441,7 @@ void ThreatManager::MatchUnitThreatToHighestThreat(Unit* target)
     if (_sortedThreatList.empty())
         return;
 
+    ApplyPendingThreat();
     auto it = _sortedThreatList.ordered_begin(), end = _sortedThreatList.ordered_end();
     ThreatReference const* highest = *it;
     if (!highest->IsAvailable())
@@ -533,6 +554,7 @@ ThreatReference const* ThreatManager::ReselectVictim()
     if (_sortedThreatList.empty())
         return nullptr;
 
+    ApplyPendingThreat();
     for (auto const& pair : _myThreatListEntries)
         pair.second->UpdateOffline(); // AI notifies are processed in ::UpdateVictim caller
 
@@ -583,6 +605,13 @@ ThreatReference const* ThreatManager::ReselectVictim()
     return nullptr;
 }
 
+void ThreatManager::ApplyPendingThreat() const
+{
+    for (ThreatReference* ref : _pendingThreatRefs)
+        ref->ApplyPendingThreat();
+    _pendingThreatRefs.clear();
+}
+
 void ThreatManager::ProcessAIUpdates()
 {
     CreatureAI* ai = ASSERT_NOTNULL(_owner->ToCreature())->AI();
@@ -600,7 +629,7 @@ void ThreatManager::ProcessAIUpdates()
         return a->_online < b->_online;
     if (a->_taunted != b->_taunted) // taunt state precedence (TAUNT > NONE > DETAUNT)
         return a->_taunted < b->_taunted;
-    return (a->GetThreat()*aWeight < b->GetThreat());
+    return (a->GetSortedThreat()*aWeight < b->GetSortedThreat());
 }
 
 /*static*/ float ThreatManager::CalculateModifiedThreat(float threat, Unit const* victim, SpellInfo const* spell)
@@ -816,6 +845,8 @@ void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid)
     ThreatReference* ref = it->second;
     _myThreatListEntries.erase(it);
     _sortedThreatList.erase(ref->_handle);
+    if (!_pendingThreatRefs.empty())
+        _pendingThreatRefs.erase(std::remove(_pendingThreatRefs.begin(), _pendingThreatRefs.end(), ref), _pendingThreatRefs.end());
 
     if (_fixateRef == ref)
         _fixateRef = nullptr;
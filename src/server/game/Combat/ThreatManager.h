@@ -122,7 +122,7 @@ class TC_GAME_API ThreatManager
         // slightly slower than GetUnsorted, but, well...sorted - only use it if you need the sorted property, of course
         // this iterator pair will invalidate on any modification (even indirect) of the threat list; spell casts and similar can all induce this!
         // note: current tank is NOT guaranteed to be the first entry in this list - check GetLastVictim separately if you want that!
-        Trinity::IteratorPair<threat_list_heap::ordered_iterator> GetSortedThreatList() const { return { _sortedThreatList.ordered_begin(), _sortedThreatList.ordered_end() }; }
+        Trinity::IteratorPair<threat_list_heap::ordered_iterator> GetSortedThreatList() const { ApplyPendingThreat(); return { _sortedThreatList.ordered_begin(), _sortedThreatList.ordered_end() }; }
         // slowest of the three threat list getters (by far), but lets you modify the threat references - this is also sorted
         std::vector<ThreatReference*> GetModifiableThreatList();
 
@@ -198,9 +198,14 @@ class TC_GAME_API ThreatManager
 
         bool _needClientUpdate;
         uint32 _updateTimer;
-        threat_list_heap _sortedThreatList;
+        mutable threat_list_heap _sortedThreatList; // reordered lazily, see ApplyPendingThreat
         std::unordered_map<ObjectGuid, ThreatReference*> _myThreatListEntries;
 
+        // threat increases (damage, healing) are only accumulated on the reference and moved into the heap in bulk,
+        // once per owner update or before anything needs the sorted list - a whole AoE pull no longer costs one heap update per hit
+        void ApplyPendingThreat() const;
+        mutable std::vector<ThreatReference*> _pendingThreatRefs;
+
         // AI notifies are delayed to ensure we are in a consistent state before we call out to arbitrary logic
         // threat references might register themselves here when ::UpdateOffline() is called - MAKE SURE THIS IS PROCESSED JUST BEFORE YOU EXIT THREATMANAGER LOGIC
         void ProcessAIUpdates();
@@ -257,7 +262,7 @@ class TC_GAME_API ThreatReference
 
         Creature* GetOwner() const { return _owner; }
         Unit* GetVictim() const { return _victim; }
-        float GetThreat() const { return std::max<float>(_baseAmount + (float)_tempModifier, 0.0f); }
+        float GetThreat() const { return std::max<float>(_baseAmount + _pendingAmount + (float)_tempModifier, 0.0f); }
         OnlineState GetOnlineState() const { return _online; }
         bool IsOnline() const { return (_online >= ONLINE_STATE_ONLINE); }
         bool IsAvailable() const { return (_online > ONLINE_STATE_OFFLINE); }
@@ -279,7 +284,7 @@ class TC_GAME_API ThreatReference
 
         ThreatReference(ThreatManager* mgr, Unit* victim) :
             _owner(reinterpret_cast<Creature*>(mgr->_owner)), _mgr(*mgr), _victim(victim),
-            _baseAmount(0.0f), _tempModifier(0), _taunted(TAUNT_STATE_NONE)
+            _baseAmount(0.0f), _pendingAmount(0.0f), _tempModifier(0), _taunted(TAUNT_STATE_NONE)
         {
             _online = ONLINE_STATE_OFFLINE;
         }
@@ -289,6 +294,9 @@ class TC_GAME_API ThreatReference
         bool ShouldBeOffline() const;
         bool ShouldBeSuppressed() const;
         void UpdateTauntState(TauntState state = TAUNT_STATE_NONE);
+        // threat the heap is currently sorted by, excludes _pendingAmount
+        float GetSortedThreat() const { return std::max<float>(_baseAmount + (float)_tempModifier, 0.0f); }
+        void ApplyPendingThreat();
         Creature* const _owner;
         ThreatManager& _mgr;
         void HeapNotifyIncreased() { _mgr._sortedThreatList.increase(_handle); }
@@ -296,6 +304,7 @@ class TC_GAME_API ThreatReference
         Unit* const _victim;
         OnlineState _online;
         float _baseAmount;
+        float _pendingAmount; // positive threat added since the last ThreatManager::ApplyPendingThreat
         int32 _tempModifier; // Temporary effects (auras with SPELL_AURA_MOD_TOTAL_THREAT) - set from victim's threatmanager in ThreatManager::UpdateMyTempModifiers
         TauntState _taunted;
         ThreatManager::threat_list_heap::handle_type _handle;
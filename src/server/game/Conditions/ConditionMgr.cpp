@@ -50,6 +50,7 @@
 #include "SpellMgr.h"
 #include "World.h"
 #include "WorldSession.h"
+#include <boost/container/small_vector.hpp>
 #include <random>
 #include <sstream>
 
@@ -883,19 +884,28 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> elseGroupStore;
+    // lists rarely use more than a few else groups, keep their state on the stack instead of a std::map
+    struct ElseGroupState
+    {
+        uint32 ElseGroup;
+        bool Passed;
+    };
+
+    boost::container::small_vector<ElseGroupState, 4> elseGroupStore;
     for (Condition const* condition : conditions)
     {
         TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList %s val1: %u", condition->ToString().c_str(), condition->ConditionValue1);
         if (condition->isLoaded())
         {
             //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = elseGroupStore.find(condition->ElseGroup);
+            auto itr = std::find_if(elseGroupStore.begin(), elseGroupStore.end(), [condition](ElseGroupState const& state)
+            {
+                return state.ElseGroup == condition->ElseGroup;
+            });
             //! If not found, add an entry in the store and set to true (placeholder)
             if (itr == elseGroupStore.end())
-                elseGroupStore[condition->ElseGroup] = true;
-            else if (!(*itr).second) //! If another condition in this group was unmatched before this, don't bother checking (the group is false anyway)
+                itr = elseGroupStore.insert(elseGroupStore.end(), { condition->ElseGroup, true });
+            else if (!itr->Passed) //! If another condition in this group was unmatched before this, don't bother checking (the group is false anyway)
                 continue;
 
             if (condition->ReferenceId)//handle reference
@@ -904,7 +914,7 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
                 if (ref != ConditionReferenceStore.end())
                 {
                     if (!IsObjectMeetToConditionList(sourceInfo, ref->second))
-                        elseGroupStore[condition->ElseGroup] = false;
+                        itr->Passed = false;
                 }
                 else
                 {
@@ -916,15 +926,12 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
             else //handle normal condition
             {
                 if (!condition->Meets(sourceInfo))
-                    elseGroupStore[condition->ElseGroup] = false;
+                    itr->Passed = false;
             }
         }
     }
-    for (std::map<uint32, bool>::const_iterator i = elseGroupStore.begin(); i != elseGroupStore.end(); ++i)
-        if (i->second)
-            return true;
 
-    return false;
+    return std::any_of(elseGroupStore.begin(), elseGroupStore.end(), [](ElseGroupState const& state) { return state.Passed; });
 }
 
 bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object, ConditionContainer const& conditions) const
@@ -54,6 +54,45 @@ namespace
     typedef std::unordered_map<uint32, DisableData> DisableTypeMap;
 
     std::array<DisableTypeMap, MAX_DISABLE_TYPES> m_DisableMap;
+
+    // one bit per entry id of each type, most lookups are for entries that are not disabled and stop at the bit test
+    // types with entries above MaxFilteredEntry (none in practice) are looked up in m_DisableMap directly
+    struct DisableTypeFilter
+    {
+        static constexpr uint32 MaxFilteredEntry = 1 << 24;
+
+        std::vector<uint64> Bits;
+        bool Enabled = false;
+
+        void Build(DisableTypeMap const& disables)
+        {
+            Bits.clear();
+            Enabled = std::all_of(disables.begin(), disables.end(), [](DisableTypeMap::value_type const& disable) { return disable.first < MaxFilteredEntry; });
+            if (!Enabled)
+                return;
+
+            for (DisableTypeMap::value_type const& disable : disables)
+            {
+                std::size_t word = disable.first / 64;
+                if (word >= Bits.size())
+                    Bits.resize(word + 1);
+                Bits[word] |= UI64LIT(1) << (disable.first % 64);
+            }
+
+            Bits.shrink_to_fit();
+        }
+
+        bool MayBeDisabled(uint32 entry) const
+        {
+            if (!Enabled)
+                return true;
+
+            std::size_t word = entry / 64;
+            return word < Bits.size() && (Bits[word] & (UI64LIT(1) << (entry % 64))) != 0;
+        }
+    };
+
+    std::array<DisableTypeFilter, MAX_DISABLE_TYPES> m_DisableFilter;
 }
 
 void LoadDisables()
@@ -62,7 +101,10 @@ void LoadDisables()
 
     // reload case
     for (std::size_t i = 0; i < m_DisableMap.size(); ++i)
+    {
         m_DisableMap[i].clear();
+        m_DisableFilter[i].Build(m_DisableMap[i]);
+    }
 
     QueryResult result = WorldDatabase.Query("SELECT sourceType, entry, flags, params_0, params_1 FROM disables");
 
@@ -250,6 +292,9 @@ void LoadDisables()
     }
     while (result->NextRow());
 
+    for (std::size_t i = 0; i < m_DisableMap.size(); ++i)
+        m_DisableFilter[i].Build(m_DisableMap[i]);
+
     TC_LOG_INFO("server.loading", ">> Loaded %u disables in %u ms", total_count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -279,13 +324,15 @@ void CheckQuestDisables()
         ++itr;
     }
 
+    m_DisableFilter[DISABLE_TYPE_QUEST].Build(m_DisableMap[DISABLE_TYPE_QUEST]);
+
     TC_LOG_INFO("server.loading", ">> Checked " SZFMTD " quest disables in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
 bool IsDisabledFor(DisableType type, uint32 entry, WorldObject const* ref, uint8 flags /*= 0*/)
 {
     ASSERT(type < MAX_DISABLE_TYPES);
-    if (m_DisableMap[type].empty())
+    if (!m_DisableFilter[type].MayBeDisabled(entry))
         return false;
 
     DisableTypeMap::iterator itr = m_DisableMap[type].find(entry);
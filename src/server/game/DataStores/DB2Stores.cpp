@@ -16,6 +16,7 @@
  */
 
 #include "DB2Stores.h"
+#include "ByteBuffer.h"
 #include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DB2LoadInfo.h"
@@ -23,16 +24,21 @@
 #include "ItemTemplate.h"
 #include "IteratorPair.h"
 #include "Log.h"
+#include "MemoryAccounting.h"
 #include "ObjectDefines.h"
 #include "Random.h"
 #include "Regex.h"
+#include "SortedIndex.h"
+#include "TaskGraph.h"
 #include "Timer.h"
 #include "Util.h"
 #include "World.h"
 #include <boost/filesystem/operations.hpp>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <numeric>
+#include <shared_mutex>
 #include <sstream>
 #include <cctype>
 
@@ -363,17 +369,17 @@ typedef ChrSpecializationEntry const* ChrSpecializationByIndexContainer[MAX_CLAS
 typedef std::unordered_map<uint32 /*curveID*/, std::vector<CurvePointEntry const*>> CurvePointsContainer;
 typedef std::map<std::tuple<uint32, uint8, uint8, uint8>, EmotesTextSoundEntry const*> EmotesTextSoundContainer;
 typedef std::unordered_map<uint32, std::vector<uint32>> FactionTeamContainer;
-typedef std::unordered_map<uint32, HeirloomEntry const*> HeirloomItemsContainer;
+typedef Trinity::SortedIndex<uint32, HeirloomEntry const*> HeirloomItemsContainer;
 typedef std::unordered_map<uint32 /*glyphPropertiesId*/, std::vector<uint32>> GlyphBindableSpellsContainer;
 typedef std::unordered_map<uint32 /*glyphPropertiesId*/, std::vector<uint32>> GlyphRequiredSpecsContainer;
 typedef std::unordered_map<uint32 /*bonusListId*/, DB2Manager::ItemBonusList> ItemBonusListContainer;
 typedef std::unordered_map<int16, uint32> ItemBonusListLevelDeltaContainer;
-typedef std::unordered_multimap<uint32 /*itemId*/, uint32 /*bonusTreeId*/> ItemToBonusTreeContainer;
+typedef Trinity::SortedMultiIndex<uint32 /*itemId*/, uint32 /*bonusTreeId*/> ItemToBonusTreeContainer;
 typedef std::unordered_map<uint32 /*itemId*/, ItemChildEquipmentEntry const*> ItemChildEquipmentContainer;
 typedef std::array<ItemClassEntry const*, 19> ItemClassByOldEnumContainer;
 typedef std::unordered_map<uint32, std::vector<ItemLimitCategoryConditionEntry const*>> ItemLimitCategoryConditionContainer;
 typedef std::set<ItemLevelSelectorQualityEntry const*, ItemLevelSelectorQualityEntryComparator> ItemLevelSelectorQualities;
-typedef std::unordered_map<uint32 /*itemId | appearanceMod << 24*/, ItemModifiedAppearanceEntry const*> ItemModifiedAppearanceByItemContainer;
+typedef Trinity::SortedIndex<uint32 /*itemId | appearanceMod << 24*/, ItemModifiedAppearanceEntry const*> ItemModifiedAppearanceByItemContainer;
 typedef std::unordered_map<uint32, std::set<ItemBonusTreeNodeEntry const*>> ItemBonusTreeContainer;
 typedef std::unordered_map<uint32, std::vector<ItemSetSpellEntry const*>> ItemSetSpellContainer;
 typedef std::unordered_map<uint32, std::vector<ItemSpecOverrideEntry const*>> ItemSpecOverridesContainer;
@@ -384,7 +390,7 @@ typedef std::array<std::vector<Trinity::wregex>, TOTAL_LOCALES + 1> NameValidati
 typedef std::unordered_map<uint32, std::vector<uint32>> PhaseGroupContainer;
 typedef std::array<PowerTypeEntry const*, MAX_POWERS> PowerTypesContainer;
 typedef std::unordered_map<uint32, std::pair<std::vector<QuestPackageItemEntry const*>, std::vector<QuestPackageItemEntry const*>>> QuestPackageItemContainer;
-typedef std::unordered_multimap<uint32, SkillRaceClassInfoEntry const*> SkillRaceClassInfoContainer;
+typedef Trinity::SortedMultiIndex<uint32, SkillRaceClassInfoEntry const*> SkillRaceClassInfoContainer;
 typedef std::unordered_map<uint32, std::vector<SpecializationSpellsEntry const*>> SpecializationSpellsContainer;
 typedef std::unordered_map<uint32, std::vector<SpellPowerEntry const*>> SpellPowerContainer;
 typedef std::unordered_map<uint32, std::unordered_map<uint32, std::vector<SpellPowerEntry const*>>> SpellPowerDifficultyContainer;
@@ -412,12 +418,15 @@ namespace
     std::array<HotfixBlobMap, TOTAL_LOCALES> _hotfixBlob;
     std::unordered_multimap<uint32 /*tableHash*/, AllowedHotfixOptionalData> _allowedHotfixOptionalData;
     std::array<std::map<HotfixBlobKey, std::vector<DB2Manager::HotfixOptionalData>>, TOTAL_LOCALES> _hotfixOptionalData;
+    std::array<HotfixBlobMap, TOTAL_LOCALES> _serializedHotfixRecords;
+    std::shared_mutex _serializedHotfixRecordsLock;
+    std::atomic<uint32> _hotfixGeneration;
 
     AreaGroupMemberContainer _areaGroupMembers;
     ArtifactPowersContainer _artifactPowers;
     ArtifactPowerLinksContainer _artifactPowerLinks;
     ArtifactPowerRanksContainer _artifactPowerRanks;
-    std::unordered_map<uint32 /*itemId*/, AzeriteEmpoweredItemEntry const*> _azeriteEmpoweredItems;
+    Trinity::SortedIndex<uint32 /*itemId*/, AzeriteEmpoweredItemEntry const*> _azeriteEmpoweredItems;
     std::unordered_map<std::pair<uint32 /*azeriteEssenceId*/, uint32 /*rank*/>, AzeriteEssencePowerEntry const*> _azeriteEssencePowersByIdAndRank;
     std::vector<AzeriteItemMilestonePowerEntry const*> _azeriteItemMilestonePowers;
     std::array<AzeriteItemMilestonePowerEntry const*, MAX_AZERITE_ESSENCE_SLOT> _azeriteItemMilestonePowerByEssenceSlot;
@@ -433,7 +442,7 @@ namespace
     std::unordered_map<std::pair<uint8 /*race*/, uint8/*gender*/>, std::vector<ChrCustomizationOptionEntry const*>> _chrCustomizationOptionsByRaceAndGender;
     std::unordered_map<uint32 /*chrCustomizationReqId*/, std::unordered_map<uint32 /*chrCustomizationOptionId*/, std::vector<uint32>>> _chrCustomizationRequiredChoices;
     ChrSpecializationByIndexContainer _chrSpecializationsByIndex;
-    std::unordered_multimap<uint32, CurrencyContainerEntry const*> _currencyContainers;
+    Trinity::SortedMultiIndex<uint32, CurrencyContainerEntry const*> _currencyContainers;
     CurvePointsContainer _curvePoints;
     EmotesTextSoundContainer _emoteTextSounds;
     std::unordered_map<std::pair<uint32 /*level*/, int32 /*expansion*/>, ExpectedStatEntry const*> _expectedStatsByLevel;
@@ -458,12 +467,12 @@ namespace
     std::vector<JournalTierEntry const*> _journalTiersByIndex;
     DB2Manager::MapDifficultyContainer _mapDifficulties;
     std::unordered_map<uint32, DB2Manager::MapDifficultyConditionsContainer> _mapDifficultyConditions;
-    std::unordered_map<uint32, MountEntry const*> _mountsBySpellId;
+    Trinity::SortedIndex<uint32, MountEntry const*> _mountsBySpellId;
     MountCapabilitiesByTypeContainer _mountCapabilitiesByType;
     MountDisplaysCointainer _mountDisplays;
     NameGenContainer _nameGenData;
     NameValidationRegexContainer _nameValidators;
-    std::unordered_map<uint32, ParagonReputationEntry const*> _paragonReputations;
+    Trinity::SortedIndex<uint32, ParagonReputationEntry const*> _paragonReputations;
     PhaseGroupContainer _phasesByGroup;
     PowerTypesContainer _powerTypes;
     std::unordered_map<uint32, uint8> _pvpItemBonus;
@@ -483,7 +492,7 @@ namespace
     std::unordered_map<int32, std::vector<SpellVisualMissileEntry const*>> _spellVisualMissilesBySet;
     TalentsByPosition _talentsByPosition;
     ToyItemIdsContainer _toys;
-    std::unordered_map<uint32, TransmogIllusionEntry const*> _transmogIllusionsByEnchantmentId;
+    Trinity::SortedIndex<uint32, TransmogIllusionEntry const*> _transmogIllusionsByEnchantmentId;
     std::unordered_map<uint32, std::vector<TransmogSetEntry const*>> _transmogSetsByItemModifiedAppearance;
     std::unordered_map<uint32, std::vector<TransmogSetItemEntry const*>> _transmogSetItemsByTransmogSet;
     std::unordered_map<int32, UiMapBounds> _uiMapBounds;
@@ -498,7 +507,7 @@ namespace
 template<typename T>
 constexpr std::size_t GetCppRecordSize(DB2Storage<T> const&) { return sizeof(T); }
 
-void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::string>& errlist, StorageMap& stores, DB2StorageBase* storage, std::string const& db2Path,
+void LoadDB2(std::bitset<TOTAL_LOCALES> const& availableDb2Locales, std::vector<std::string>& errlist, DB2StorageBase* storage, std::string const& db2Path,
     LocaleConstant defaultLocale, std::size_t cppRecordSize)
 {
     // validate structure
@@ -579,8 +588,47 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
     for (LocaleConstant i = LOCALE_koKR; i < TOTAL_LOCALES; i = LocaleConstant(i + 1))
         if (availableDb2Locales[i])
             storage->LoadStringsFromDB(i);
+}
+
+struct DB2LoadTask
+{
+    DB2StorageBase* Storage;
+    std::size_t CppRecordSize;
+};
+
+// every store reads its own files and hotfix tables, so they are loaded concurrently
+// errors are collected per store and exceptions rethrown on the calling thread once all stores finished
+void LoadDB2Stores(std::vector<DB2LoadTask> const& tasks, std::bitset<TOTAL_LOCALES> const& availableDb2Locales, std::vector<std::string>& errlist,
+    std::string const& db2Path, LocaleConstant defaultLocale)
+{
+    std::vector<std::vector<std::string>> taskErrors(tasks.size());
+    std::vector<std::exception_ptr> taskExceptions(tasks.size());
+
+    Trinity::TaskGraph loaders;
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        loaders.AddTask(tasks[i].Storage->GetFileName(), [&, i]
+        {
+            try
+            {
+                LoadDB2(availableDb2Locales, taskErrors[i], tasks[i].Storage, db2Path, defaultLocale, tasks[i].CppRecordSize);
+            }
+            catch (...)
+            {
+                taskExceptions[i] = std::current_exception();
+            }
+        });
+    }
 
-    stores[storage->GetTableHash()] = storage;
+    loaders.Run(sWorld->getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        if (taskExceptions[i])
+            std::rethrow_exception(taskExceptions[i]);
+
+        errlist.insert(errlist.end(), taskErrors[i].begin(), taskErrors[i].end());
+    }
 }
 
 DB2Manager& DB2Manager::Instance()
@@ -614,7 +662,9 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     if (!availableDb2Locales[defaultLocale])
         return 0;
 
-#define LOAD_DB2(store) LoadDB2(availableDb2Locales, loadErrors, _stores, &store, db2Path, defaultLocale, GetCppRecordSize(store))
+    std::vector<DB2LoadTask> loadTasks;
+
+#define LOAD_DB2(store) loadTasks.push_back({ &store, GetCppRecordSize(store) })
 
     LOAD_DB2(sAchievementStore);
     LOAD_DB2(sAchievementCategoryStore);
@@ -912,6 +962,11 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
 
 #undef LOAD_DB2
 
+    LoadDB2Stores(loadTasks, availableDb2Locales, loadErrors, db2Path, defaultLocale);
+
+    for (DB2LoadTask const& loadTask : loadTasks)
+        _stores[loadTask.Storage->GetTableHash()] = loadTask.Storage;
+
     // error checks
     if (!loadErrors.empty())
     {
@@ -952,7 +1007,9 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
         _artifactPowerRanks[std::pair<uint32, uint8>{ artifactPowerRank->ArtifactPowerID, artifactPowerRank->RankIndex }] = artifactPowerRank;
 
     for (AzeriteEmpoweredItemEntry const* azeriteEmpoweredItem : sAzeriteEmpoweredItemStore)
-        _azeriteEmpoweredItems[azeriteEmpoweredItem->ItemID] = azeriteEmpoweredItem;
+        _azeriteEmpoweredItems.emplace(azeriteEmpoweredItem->ItemID, azeriteEmpoweredItem);
+
+    _azeriteEmpoweredItems.Build();
 
     for (AzeriteEssencePowerEntry const* azeriteEssencePower : sAzeriteEssencePowerStore)
         _azeriteEssencePowersByIdAndRank[std::pair<uint32, uint32>{ azeriteEssencePower->AzeriteEssenceID, azeriteEssencePower->Tier }] = azeriteEssencePower;
@@ -1127,6 +1184,8 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     for (CurrencyContainerEntry const* currencyContainer : sCurrencyContainerStore)
         _currencyContainers.emplace(currencyContainer->CurrencyTypesID, currencyContainer);
 
+    _currencyContainers.Build();
+
     for (CurvePointEntry const* curvePoint : sCurvePointStore)
         if (sCurveStore.LookupEntry(curvePoint->CurveID))
             _curvePoints[curvePoint->CurveID].push_back(curvePoint);
@@ -1158,7 +1217,9 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     }
 
     for (HeirloomEntry const* heirloom : sHeirloomStore)
-        _heirlooms[heirloom->ItemID] = heirloom;
+        _heirlooms.emplace(heirloom->ItemID, heirloom);
+
+    _heirlooms.Build();
 
     for (GlyphBindableSpellEntry const* glyphBindableSpell : sGlyphBindableSpellStore)
         _glyphBindableSpells[glyphBindableSpell->GlyphPropertiesID].push_back(glyphBindableSpell->SpellID);
@@ -1200,9 +1261,11 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     for (ItemModifiedAppearanceEntry const* appearanceMod : sItemModifiedAppearanceStore)
     {
         ASSERT(appearanceMod->ItemID <= 0xFFFFFF);
-        _itemModifiedAppearancesByItem[appearanceMod->ItemID | (appearanceMod->ItemAppearanceModifierID << 24)] = appearanceMod;
+        _itemModifiedAppearancesByItem.emplace(appearanceMod->ItemID | (appearanceMod->ItemAppearanceModifierID << 24), appearanceMod);
     }
 
+    _itemModifiedAppearancesByItem.Build();
+
     for (ItemSetSpellEntry const* itemSetSpell : sItemSetSpellStore)
         _itemSetSpells[itemSetSpell->ItemSetID].push_back(itemSetSpell);
 
@@ -1212,6 +1275,8 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     for (ItemXBonusTreeEntry const* itemBonusTreeAssignment : sItemXBonusTreeStore)
         _itemToBonusTree.insert({ itemBonusTreeAssignment->ItemID, itemBonusTreeAssignment->ItemBonusTreeID });
 
+    _itemToBonusTree.Build();
+
     for (auto&& kvp : _azeriteEmpoweredItems)
         LoadAzeriteEmpoweredItemUnlockMappings(azeriteUnlockMappings, kvp.first);
 
@@ -1236,7 +1301,9 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
             _mapDifficultyConditions[mapDifficultyCondition->MapDifficultyID].emplace_back(mapDifficultyCondition->ID, playerCondition);
 
     for (MountEntry const* mount : sMountStore)
-        _mountsBySpellId[mount->SourceSpellID] = mount;
+        _mountsBySpellId.emplace(mount->SourceSpellID, mount);
+
+    _mountsBySpellId.Build();
 
     for (MountTypeXCapabilityEntry const* mountTypeCapability : sMountTypeXCapabilityStore)
         _mountCapabilitiesByType[mountTypeCapability->MountTypeID].insert(mountTypeCapability);
@@ -1293,7 +1360,9 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
 
     for (ParagonReputationEntry const* paragonReputation : sParagonReputationStore)
         if (sFactionStore.HasRecord(paragonReputation->FactionID))
-            _paragonReputations[paragonReputation->FactionID] = paragonReputation;
+            _paragonReputations.emplace(paragonReputation->FactionID, paragonReputation);
+
+    _paragonReputations.Build();
 
     for (PhaseXPhaseGroupEntry const* group : sPhaseXPhaseGroupStore)
         if (PhaseEntry const* phase = sPhaseStore.LookupEntry(group->PhaseID))
@@ -1356,6 +1425,8 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
         if (sSkillLineStore.LookupEntry(entry->SkillID))
             _skillRaceClassInfoBySkill.insert(SkillRaceClassInfoContainer::value_type(entry->SkillID, entry));
 
+    _skillRaceClassInfoBySkill.Build();
+
     for (SoulbindConduitRankEntry const* soulbindConduitRank : sSoulbindConduitRankStore)
         _soulbindConduitRanks[{ soulbindConduitRank->SoulbindConduitID, soulbindConduitRank->RankIndex }] = soulbindConduitRank;
 
@@ -1408,7 +1479,9 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
         _toys.insert(toy->ItemID);
 
     for (TransmogIllusionEntry const* transmogIllusion : sTransmogIllusionStore)
-        _transmogIllusionsByEnchantmentId[transmogIllusion->SpellItemEnchantmentID] = transmogIllusion;
+        _transmogIllusionsByEnchantmentId.emplace(transmogIllusion->SpellItemEnchantmentID, transmogIllusion);
+
+    _transmogIllusionsByEnchantmentId.Build();
 
     for (TransmogSetItemEntry const* transmogSetItem : sTransmogSetItemStore)
     {
@@ -1557,6 +1630,13 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
         }
     }
 
+    // stores only change through hotfixes after this point, they are not accounted again
+    std::size_t memoryUsage = 0;
+    for (std::pair<uint32 const, DB2StorageBase*> const& store : _stores)
+        memoryUsage += store.second->GetMemoryUsage();
+
+    Trinity::MemoryAccounting::Set(Trinity::MemoryCategory::DB2Stores, memoryUsage);
+
     TC_LOG_INFO("server.loading", ">> Initialized " SZFMTD " DB2 data stores in %u ms", _stores.size(), GetMSTimeDiffToNow(oldMSTime));
 
     return availableDb2Locales.to_ulong();
@@ -1623,6 +1703,8 @@ void DB2Manager::LoadHotfixData()
             if (DB2StorageBase* store = Trinity::Containers::MapGetValuePtr(_stores, itr->first.first))
                 store->EraseRecord(itr->first.second);
 
+    InvalidateSerializedHotfixes();
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " hotfix records in %u ms", _hotfixData.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1670,6 +1752,8 @@ void DB2Manager::LoadHotfixBlob(uint32 localeMask)
         hotfixBlobCount++;
     } while (result->NextRow());
 
+    InvalidateSerializedHotfixes();
+
     TC_LOG_INFO("server.loading", ">> Loaded %d hotfix blob records in %u ms", hotfixBlobCount, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1752,6 +1836,8 @@ void DB2Manager::LoadHotfixOptionalData(uint32 localeMask)
         hotfixOptionalDataCount++;
     } while (result->NextRow());
 
+    InvalidateSerializedHotfixes();
+
     TC_LOG_INFO("server.loading", ">> Loaded %d hotfix optional data records in %u ms", hotfixOptionalDataCount, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1779,6 +1865,46 @@ std::vector<DB2Manager::HotfixOptionalData> const* DB2Manager::GetHotfixOptional
     return Trinity::Containers::MapGetValuePtr(_hotfixOptionalData[locale], std::make_pair(tableHash, recordId));
 }
 
+std::vector<uint8> const* DB2Manager::GetSerializedHotfixRecord(uint32 tableHash, int32 recordId, LocaleConstant locale) const
+{
+    ASSERT(IsValidLocale(locale), "Locale %u is invalid locale", uint32(locale));
+
+    DB2StorageBase const* storage = GetStorage(tableHash);
+    if (!storage || !storage->HasRecord(uint32(recordId)))
+        return nullptr;
+
+    HotfixBlobKey key = std::make_pair(tableHash, recordId);
+    {
+        std::shared_lock<std::shared_mutex> lock(_serializedHotfixRecordsLock);
+        if (std::vector<uint8> const* record = Trinity::Containers::MapGetValuePtr(_serializedHotfixRecords[locale], key))
+            return record;
+    }
+
+    ByteBuffer buffer;
+    storage->WriteRecord(uint32(recordId), locale, buffer);
+    if (std::vector<HotfixOptionalData> const* optionalDataEntries = GetHotfixOptionalData(tableHash, recordId, locale))
+    {
+        for (HotfixOptionalData const& optionalData : *optionalDataEntries)
+        {
+            buffer << uint32(optionalData.Key);
+            buffer.append(optionalData.Data.data(), optionalData.Data.size());
+        }
+    }
+
+    std::vector<uint8> record;
+    if (!buffer.empty())
+        record.assign(buffer.contents(), buffer.contents() + buffer.size());
+
+    // map nodes are never moved, the pointer stays valid until hotfixes are loaded again
+    std::unique_lock<std::shared_mutex> lock(_serializedHotfixRecordsLock);
+    return &_serializedHotfixRecords[locale].emplace(key, std::move(record)).first->second;
+}
+
+uint32 DB2Manager::GetHotfixGeneration() const
+{
+    return _hotfixGeneration;
+}
+
 uint32 DB2Manager::GetEmptyAnimStateID() const
 {
     return sAnimationDataStore.GetNumRows();
@@ -1792,6 +1918,16 @@ void DB2Manager::InsertNewHotfix(uint32 tableHash, uint32 recordId)
     hotfixRecord.ID.PushID = ++_maxHotfixId;
     hotfixRecord.ID.UniqueID = rand32();
     _hotfixData[hotfixRecord.ID.PushID].push_back(hotfixRecord);
+    InvalidateSerializedHotfixes();
+}
+
+void DB2Manager::InvalidateSerializedHotfixes()
+{
+    std::unique_lock<std::shared_mutex> lock(_serializedHotfixRecordsLock);
+    for (HotfixBlobMap& records : _serializedHotfixRecords)
+        records.clear();
+
+    ++_hotfixGeneration;
 }
 
 std::vector<uint32> DB2Manager::GetAreasForGroup(uint32 areaGroupId) const
@@ -2035,7 +2171,7 @@ char const* DB2Manager::GetCreatureFamilyPetName(uint32 petfamily, LocaleConstan
 
 CurrencyContainerEntry const* DB2Manager::GetCurrencyContainerForCurrencyQuantity(uint32 currencyId, int32 quantity) const
 {
-    for (std::pair<uint32 const, CurrencyContainerEntry const*> const& p : Trinity::Containers::MapEqualRange(_currencyContainers, currencyId))
+    for (std::pair<uint32, CurrencyContainerEntry const*> const& p : Trinity::Containers::MapEqualRange(_currencyContainers, currencyId))
         if (quantity >= p.second->MinAmount && (!p.second->MaxAmount || quantity <= p.second->MaxAmount))
             return p.second;
 
@@ -363,6 +363,11 @@ public:
     HotfixContainer const& GetHotfixData() const;
     std::vector<uint8> const* GetHotfixBlobData(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
     std::vector<HotfixOptionalData> const* GetHotfixOptionalData(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
+    /// Record from a loaded store followed by its optional data, as sent in hotfix responses. Serialized once per locale,
+    /// nullptr if there is no store for tableHash or it does not have the record
+    std::vector<uint8> const* GetSerializedHotfixRecord(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
+    /// Changes every time hotfix data is loaded, responses built from an older generation are stale
+    uint32 GetHotfixGeneration() const;
 
     uint32 GetEmptyAnimStateID() const;
     std::vector<uint32> GetAreasForGroup(uint32 areaGroupId) const;
@@ -472,6 +477,7 @@ public:
 private:
     friend class DB2HotfixGeneratorBase;
     void InsertNewHotfix(uint32 tableHash, uint32 recordId);
+    void InvalidateSerializedHotfixes();
     int32 _maxHotfixId = 0;
 };
 
@@ -198,92 +198,74 @@ TC_GAME_API extern GameTable<GtXpEntry>                             sXpGameTable
 
 TC_GAME_API void LoadGameTables(std::string const& dataPath);
 
+// Column lookups are done through tables of pointers to members indexed by class instead of switches,
+// stat and rating updates call them for every recalculation
 template<class T>
-inline float GetGameTableColumnForClass(T const* row, int32 class_)
+struct GameTableClassColumns
 {
-    switch (class_)
+    static constexpr float T::* Columns[MAX_CLASSES] =
     {
-        case CLASS_WARRIOR:
-            return row->Warrior;
-        case CLASS_PALADIN:
-            return row->Paladin;
-        case CLASS_HUNTER:
-            return row->Hunter;
-        case CLASS_ROGUE:
-            return row->Rogue;
-        case CLASS_PRIEST:
-            return row->Priest;
-        case CLASS_DEATH_KNIGHT:
-            return row->DeathKnight;
-        case CLASS_SHAMAN:
-            return row->Shaman;
-        case CLASS_MAGE:
-            return row->Mage;
-        case CLASS_WARLOCK:
-            return row->Warlock;
-        case CLASS_MONK:
-            return row->Monk;
-        case CLASS_DRUID:
-            return row->Druid;
-        case CLASS_DEMON_HUNTER:
-            return row->DemonHunter;
-        default:
-            break;
-    }
+        nullptr,            // CLASS_NONE
+        &T::Warrior,
+        &T::Paladin,
+        &T::Hunter,
+        &T::Rogue,
+        &T::Priest,
+        &T::DeathKnight,
+        &T::Shaman,
+        &T::Mage,
+        &T::Warlock,
+        &T::Monk,
+        &T::Druid,
+        &T::DemonHunter
+    };
+};
+
+template<class T>
+inline float GetGameTableColumnForClass(T const* row, int32 class_)
+{
+    if (uint32(class_) >= MAX_CLASSES || !GameTableClassColumns<T>::Columns[class_])
+        return 0.0f;
 
-    return 0.0f;
+    return row->*GameTableClassColumns<T>::Columns[class_];
 }
 
+// negative "classes" select the item, consumable, gem, ... columns
+constexpr int32 SPELL_SCALING_MIN_CLASS = -9;
+
+constexpr float GtSpellScalingEntry::* SpellScalingColumns[MAX_CLASSES - SPELL_SCALING_MIN_CLASS] =
+{
+    &GtSpellScalingEntry::DamageSecondary,      // -9
+    &GtSpellScalingEntry::DamageReplaceStat,    // -8
+    &GtSpellScalingEntry::Item,                 // -7
+    &GtSpellScalingEntry::Health,               // -6
+    &GtSpellScalingEntry::Gem3,                 // -5
+    &GtSpellScalingEntry::Gem2,                 // -4
+    &GtSpellScalingEntry::Gem1,                 // -3
+    &GtSpellScalingEntry::Consumable,           // -2
+    &GtSpellScalingEntry::Item,                 // -1
+    nullptr,                                    // CLASS_NONE
+    &GtSpellScalingEntry::Warrior,
+    &GtSpellScalingEntry::Paladin,
+    &GtSpellScalingEntry::Hunter,
+    &GtSpellScalingEntry::Rogue,
+    &GtSpellScalingEntry::Priest,
+    &GtSpellScalingEntry::DeathKnight,
+    &GtSpellScalingEntry::Shaman,
+    &GtSpellScalingEntry::Mage,
+    &GtSpellScalingEntry::Warlock,
+    &GtSpellScalingEntry::Monk,
+    &GtSpellScalingEntry::Druid,
+    &GtSpellScalingEntry::DemonHunter
+};
+
 inline float GetSpellScalingColumnForClass(GtSpellScalingEntry const* row, int32 class_)
 {
-    switch (class_)
-    {
-        case CLASS_WARRIOR:
-            return row->Warrior;
-        case CLASS_PALADIN:
-            return row->Paladin;
-        case CLASS_HUNTER:
-            return row->Hunter;
-        case CLASS_ROGUE:
-            return row->Rogue;
-        case CLASS_PRIEST:
-            return row->Priest;
-        case CLASS_DEATH_KNIGHT:
-            return row->DeathKnight;
-        case CLASS_SHAMAN:
-            return row->Shaman;
-        case CLASS_MAGE:
-            return row->Mage;
-        case CLASS_WARLOCK:
-            return row->Warlock;
-        case CLASS_MONK:
-            return row->Monk;
-        case CLASS_DRUID:
-            return row->Druid;
-        case CLASS_DEMON_HUNTER:
-            return row->DemonHunter;
-        case -1:
-        case -7:
-            return row->Item;
-        case -2:
-            return row->Consumable;
-        case -3:
-            return row->Gem1;
-        case -4:
-            return row->Gem2;
-        case -5:
-            return row->Gem3;
-        case -6:
-            return row->Health;
-        case -8:
-            return row->DamageReplaceStat;
-        case -9:
-            return row->DamageSecondary;
-        default:
-            break;
-    }
+    uint32 index = uint32(class_ - SPELL_SCALING_MIN_CLASS);
+    if (index >= std::size(SpellScalingColumns) || !SpellScalingColumns[index])
+        return 0.0f;
 
-    return 0.0f;
+    return row->*SpellScalingColumns[index];
 }
 
 inline float GetBattlePetXPPerLevel(GtBattlePetXPEntry const* row)
@@ -26,9 +26,21 @@
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <list>
+#include <mutex>
 
-typedef std::vector<FlyByCamera> FlyByCameraCollection;
-std::unordered_map<uint32, FlyByCameraCollection> sFlyByCameraStore;
+namespace
+{
+    // number of camera sets kept in memory, a cinematic uses one or two of them
+    constexpr std::size_t MaxCachedCameras = 64;
+
+    boost::filesystem::path sCamerasPath;
+
+    // most recently used camera sets at the front, failed loads are cached as nullptr so that missing files are not reopened
+    std::list<std::pair<uint32, std::shared_ptr<FlyByCameraCollection const>>> sFlyByCameraCache;
+    std::unordered_map<uint32, decltype(sFlyByCameraCache)::iterator> sFlyByCameraCacheIndex;
+    std::mutex sFlyByCameraCacheLock;
+}
 
 // Convert the geomoetry from a spline value, to an actual WoW XYZ
 G3D::Vector3 translateLocation(G3D::Vector4 const* dbcLocation, G3D::Vector3 const* basePosition, G3D::Vector3 const* splineVector)
@@ -50,11 +62,10 @@ G3D::Vector3 translateLocation(G3D::Vector4 const* dbcLocation, G3D::Vector3 con
 }
 
 // Number of cameras not used. Multiple cameras never used in 7.1.5
-bool readCamera(M2Camera const* cam, uint32 buffSize, M2Header const* header, CinematicCameraEntry const* dbcentry)
+bool readCamera(M2Camera const* cam, uint32 buffSize, M2Header const* header, CinematicCameraEntry const* dbcentry, FlyByCameraCollection& cameras)
 {
     char const* buffer = reinterpret_cast<char const*>(header);
 
-    FlyByCameraCollection cameras;
     FlyByCameraCollection targetcam;
 
     G3D::Vector4 dbcData;
@@ -169,104 +180,118 @@ bool readCamera(M2Camera const* cam, uint32 buffSize, M2Header const* header, Ci
         }
     }
 
-    sFlyByCameraStore[dbcentry->ID] = cameras;
     return true;
 }
 
-TC_GAME_API void LoadM2Cameras(std::string const& dataPath)
+std::shared_ptr<FlyByCameraCollection const> loadCameraFile(CinematicCameraEntry const* cameraEntry)
 {
-    sFlyByCameraStore.clear();
-    TC_LOG_INFO("server.loading", ">> Loading Cinematic Camera files");
+    boost::filesystem::path filename = sCamerasPath / Trinity::StringFormat("FILE%08X.xxx", cameraEntry->FileDataID);
 
-    boost::filesystem::path camerasPath = boost::filesystem::path(dataPath) / "cameras";
+    // Convert to native format
+    filename.make_preferred();
 
-    uint32 oldMSTime = getMSTime();
-    for (CinematicCameraEntry const* cameraEntry : sCinematicCameraStore)
-    {
-        boost::filesystem::path filename = camerasPath / Trinity::StringFormat("FILE%08X.xxx", cameraEntry->FileDataID);
+    std::ifstream m2file(filename.string().c_str(), std::ios::in | std::ios::binary);
+    if (!m2file.is_open())
+        return nullptr;
 
-        // Convert to native format
-        filename.make_preferred();
+    // Get file size
+    m2file.seekg(0, std::ios::end);
+    std::streamoff fileSize = m2file.tellg();
 
-        std::ifstream m2file(filename.string().c_str(), std::ios::in | std::ios::binary);
-        if (!m2file.is_open())
-            continue;
+    // Reject if not at least the size of the header
+    if (static_cast<uint32>(fileSize) < sizeof(M2Header) + 4)
+    {
+        TC_LOG_ERROR("misc", "Camera file %s is damaged. File is smaller than header size", filename.string().c_str());
+        return nullptr;
+    }
 
-        // Get file size
-        m2file.seekg(0, std::ios::end);
-        std::streamoff fileSize = m2file.tellg();
+    // Read 4 bytes (signature)
+    m2file.seekg(0, std::ios::beg);
+    char fileCheck[5];
+    m2file.read(fileCheck, 4);
+    fileCheck[4] = '\0';
 
-        // Reject if not at least the size of the header
-        if (static_cast<uint32>(fileSize) < sizeof(M2Header) + 4)
-        {
-            TC_LOG_ERROR("server.loading", "Camera file %s is damaged. File is smaller than header size", filename.string().c_str());
-            m2file.close();
-            continue;
-        }
+    // Check file has correct magic (MD21)
+    if (strcmp(fileCheck, "MD21"))
+    {
+        TC_LOG_ERROR("misc", "Camera file %s is damaged. File identifier not found.", filename.string().c_str());
+        return nullptr;
+    }
 
-        // Read 4 bytes (signature)
-        m2file.seekg(0, std::ios::beg);
-        char fileCheck[5];
-        m2file.read(fileCheck, 4);
-        fileCheck[4] = '\0';
+    // Now we have a good file, read it all into a vector of char's, then close the file.
+    std::vector<char> buffer(fileSize);
+    m2file.seekg(0, std::ios::beg);
+    if (!m2file.read(buffer.data(), fileSize))
+        return nullptr;
 
-        // Check file has correct magic (MD21)
-        if (strcmp(fileCheck, "MD21"))
-        {
-            TC_LOG_ERROR("server.loading", "Camera file %s is damaged. File identifier not found.", filename.string().c_str());
-            m2file.close();
-            continue;
-        }
+    m2file.close();
 
-        // Now we have a good file, read it all into a vector of char's, then close the file.
-        std::vector<char> buffer(fileSize);
-        m2file.seekg(0, std::ios::beg);
-        if (!m2file.read(buffer.data(), fileSize))
+    uint32 m2start = 0;
+    char const* ptr = buffer.data();
+    while (m2start + 4 < buffer.size() && memcmp(ptr, "MD20", 4) != 0)
+    {
+        ++m2start;
+        ++ptr;
+        if (m2start + sizeof(M2Header) > buffer.size())
         {
-            m2file.close();
-            continue;
+            TC_LOG_ERROR("misc", "Camera file %s is damaged. File is smaller than header size.", filename.string().c_str());
+            return nullptr;
         }
-        m2file.close();
+    }
 
-        bool fileValid = true;
-        uint32 m2start = 0;
-        char const* ptr = buffer.data();
-        while (m2start + 4 < buffer.size() && memcmp(ptr, "MD20", 4) != 0)
-        {
-            ++m2start;
-            ++ptr;
-            if (m2start + sizeof(M2Header) > buffer.size())
-            {
-                fileValid = false;
-                break;
-            }
-        }
+    // Read header
+    M2Header const* header = reinterpret_cast<M2Header const*>(buffer.data() + m2start);
 
-        if (!fileValid)
-        {
-            TC_LOG_ERROR("server.loading", "Camera file %s is damaged. File is smaller than header size.", filename.string().c_str());
-            continue;
-        }
+    if (m2start + header->ofsCameras + sizeof(M2Camera) > static_cast<uint32>(fileSize))
+    {
+        TC_LOG_ERROR("misc", "Camera file %s is damaged. Camera references position beyond file end", filename.string().c_str());
+        return nullptr;
+    }
 
-        // Read header
-        M2Header const* header = reinterpret_cast<M2Header const*>(buffer.data() + m2start);
+    // Get camera(s) - Main header, then dump them.
+    M2Camera const* cam = reinterpret_cast<M2Camera const*>(buffer.data() + m2start + header->ofsCameras);
+    std::shared_ptr<FlyByCameraCollection> cameras = std::make_shared<FlyByCameraCollection>();
+    if (!readCamera(cam, fileSize - m2start, header, cameraEntry, *cameras))
+    {
+        TC_LOG_ERROR("misc", "Camera file %s is damaged. Camera references position beyond file end", filename.string().c_str());
+        return nullptr;
+    }
 
-        if (m2start + header->ofsCameras + sizeof(M2Camera) > static_cast<uint32>(fileSize))
-        {
-            TC_LOG_ERROR("server.loading", "Camera file %s is damaged. Camera references position beyond file end", filename.string().c_str());
-            continue;
-        }
+    cameras->shrink_to_fit();
+    return cameras;
+}
 
-        // Get camera(s) - Main header, then dump them.
-        M2Camera const* cam = reinterpret_cast<M2Camera const*>(buffer.data() + m2start + header->ofsCameras);
-        if (!readCamera(cam, fileSize - m2start, header, cameraEntry))
-            TC_LOG_ERROR("server.loading", "Camera file %s is damaged. Camera references position beyond file end", filename.string().c_str());
-    }
+TC_GAME_API void LoadM2Cameras(std::string const& dataPath)
+{
+    std::lock_guard<std::mutex> lock(sFlyByCameraCacheLock);
+    sFlyByCameraCache.clear();
+    sFlyByCameraCacheIndex.clear();
+    sCamerasPath = boost::filesystem::path(dataPath) / "cameras";
 
-    TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " cinematic waypoint sets in %u ms", sFlyByCameraStore.size(), GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Cinematic camera files will be loaded on demand from %s", sCamerasPath.string().c_str());
 }
 
-std::vector<FlyByCamera> const* GetFlyByCameras(uint32 cinematicCameraId)
+std::shared_ptr<FlyByCameraCollection const> GetFlyByCameras(uint32 cinematicCameraId)
 {
-    return Trinity::Containers::MapGetValuePtr(sFlyByCameraStore, cinematicCameraId);
+    std::lock_guard<std::mutex> lock(sFlyByCameraCacheLock);
+    auto itr = sFlyByCameraCacheIndex.find(cinematicCameraId);
+    if (itr != sFlyByCameraCacheIndex.end())
+    {
+        sFlyByCameraCache.splice(sFlyByCameraCache.begin(), sFlyByCameraCache, itr->second);
+        return itr->second->second;
+    }
+
+    std::shared_ptr<FlyByCameraCollection const> cameras;
+    if (CinematicCameraEntry const* cameraEntry = sCinematicCameraStore.LookupEntry(cinematicCameraId))
+        cameras = loadCameraFile(cameraEntry);
+
+    sFlyByCameraCache.emplace_front(cinematicCameraId, cameras);
+    sFlyByCameraCacheIndex[cinematicCameraId] = sFlyByCameraCache.begin();
+    if (sFlyByCameraCache.size() > MaxCachedCameras)
+    {
+        sFlyByCameraCacheIndex.erase(sFlyByCameraCache.back().first);
+        sFlyByCameraCache.pop_back();
+    }
+
+    return cameras;
 }
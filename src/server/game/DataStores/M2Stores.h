@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "Position.h"
+#include <memory>
 #include <vector>
 
 struct FlyByCamera
@@ -28,8 +29,12 @@ struct FlyByCamera
     Position locations;
 };
 
+typedef std::vector<FlyByCamera> FlyByCameraCollection;
+
+// Camera files are parsed on first use and kept in a small LRU cache, cinematics are rare compared to the number of camera files
 TC_GAME_API void LoadM2Cameras(std::string const& dataPath);
 
-TC_GAME_API std::vector<FlyByCamera> const* GetFlyByCameras(uint32 cinematicCameraId);
+// Returned data stays valid for as long as the caller holds on to it, even if it gets evicted from the cache
+TC_GAME_API std::shared_ptr<FlyByCameraCollection const> GetFlyByCameras(uint32 cinematicCameraId);
 
 #endif
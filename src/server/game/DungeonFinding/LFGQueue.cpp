@@ -19,6 +19,7 @@
 #include "Containers.h"
 #include "GameTime.h"
 #include "Group.h"
+#include "Hash.h"
 #include "LFGQueue.h"
 #include "LFGMgr.h"
 #include "Log.h"
@@ -27,30 +28,6 @@
 namespace lfg
 {
 
-/**
-   Given a list of guids returns the concatenation using | as delimiter
-
-   @param[in]     check list of guids
-   @returns Concatenated string
-*/
-std::string ConcatenateGuids(GuidList const& check)
-{
-    if (check.empty())
-        return "";
-
-    // need the guids in order to avoid duplicates
-    GuidSet guids(check.begin(), check.end());
-
-    std::ostringstream o;
-
-    GuidSet::const_iterator it = guids.begin();
-    o << it->ToHexString();
-    for (++it; it != guids.end(); ++it)
-        o << '|' << it->ToHexString();
-
-    return o.str();
-}
-
 char const* GetCompatibleString(LfgCompatibility compatibles)
 {
     switch (compatibles)
@@ -81,9 +58,113 @@ char const* GetCompatibleString(LfgCompatibility compatibles)
 }
 
 LfgQueueData::LfgQueueData() : joinTime(GameTime::GetGameTime()), tanks(LFG_TANKS_NEEDED),
-healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED)
+healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), queueSlot(0), fixedTanks(0), fixedHealers(0), fixedDamage(0), hasNoRole(false)
 { }
 
+std::size_t LfgCompatibleKey::GetHash() const
+{
+    std::size_t hashVal = 0;
+    for (uint8 i = 0; i < size; ++i)
+        Trinity::hash_combine(hashVal, slots[i]);
+
+    return hashVal;
+}
+
+/**
+   Given a list of guids returns the key of their compatibility in the cache
+
+   @param[in]     check list of guids
+   @returns Sorted queue slots of the guids, empty key if one of them is not queued
+*/
+LfgCompatibleKey LFGQueue::GetCompatibleKey(GuidList const& check) const
+{
+    LfgCompatibleKey key;
+    if (check.size() > LfgCompatibleKey::MaxEntries)
+        return key;
+
+    for (ObjectGuid const& guid : check)
+    {
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end())
+            return LfgCompatibleKey();
+
+        key.slots[key.size++] = itQueue->second.queueSlot;
+    }
+
+    // need the slots in order to avoid duplicates
+    std::sort(key.slots.begin(), key.slots.begin() + key.size);
+    key.size = uint8(std::unique(key.slots.begin(), key.slots.begin() + key.size) - key.slots.begin());
+    return key;
+}
+
+/**
+   Given a compatibility cache key returns the concatenation of the guids using | as delimiter, for logging
+*/
+std::string LFGQueue::GetCompatibleKeyString(LfgCompatibleKey const& key) const
+{
+    std::ostringstream o;
+    for (uint8 i = 0; i < key.size; ++i)
+    {
+        if (i)
+            o << '|';
+        o << QueueSlotGuids[key.slots[i]].ToHexString();
+    }
+
+    return o.str();
+}
+
+uint32 LFGQueue::AllocateQueueSlot(ObjectGuid guid)
+{
+    if (!FreeQueueSlots.empty())
+    {
+        uint32 slot = FreeQueueSlots.back();
+        FreeQueueSlots.pop_back();
+        QueueSlotGuids[slot] = guid;
+        return slot;
+    }
+
+    QueueSlotGuids.push_back(guid);
+    CompatibleKeysBySlot.emplace_back();
+    return uint32(QueueSlotGuids.size() - 1);
+}
+
+/// The slot must have been removed from compatibles before, keys are matched by slot and not by guid
+void LFGQueue::FreeQueueSlot(uint32 slot)
+{
+    QueueSlotGuids[slot].Clear();
+    FreeQueueSlots.push_back(slot);
+}
+
+/**
+   Cheap check done before trying all role assignments of a group: players that selected a single role
+   can only take that role and players without a role make every group incompatible
+
+   @param[in]     check List of queued guids
+   @return false if LFGMgr::CheckGroupRoles can not succeed for these queue entries
+*/
+bool LFGQueue::CanHaveCompatibleRoles(GuidList const& check) const
+{
+    uint8 tanks = 0;
+    uint8 healers = 0;
+    uint8 damage = 0;
+    for (ObjectGuid const& guid : check)
+    {
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end())
+            continue;
+
+        LfgQueueData const& queueData = itQueue->second;
+        if (queueData.hasNoRole)
+            return false;
+
+        tanks += queueData.fixedTanks;
+        healers += queueData.fixedHealers;
+        damage += queueData.fixedDamage;
+    }
+
+    return tanks <= LFG_TANKS_NEEDED && healers <= LFG_HEALERS_NEEDED && damage <= LFG_DPS_NEEDED;
+}
+
 std::string LFGQueue::GetDetailedMatchRoles(GuidList const& check) const
 {
     if (check.empty())
@@ -140,25 +221,23 @@ void LFGQueue::RemoveFromQueue(ObjectGuid guid)
 {
     RemoveFromNewQueue(guid);
     RemoveFromCurrentQueue(guid);
-    RemoveFromCompatibles(guid);
 
-    std::string sguid = guid.ToHexString();
+    LfgQueueDataContainer::iterator itDelete = QueueDataStore.find(guid);
+    if (itDelete == QueueDataStore.end())
+        return;
+
+    uint32 slot = itDelete->second.queueSlot;
+    RemoveFromCompatibles(slot);
 
-    LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
     for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
-        if (itr->first != guid)
+        if (itr != itDelete && itr->second.bestCompatible.Contains(slot))
         {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
-            {
-                itr->second.bestCompatible.clear();
-                FindBestCompatibleInQueue(itr);
-            }
+            itr->second.bestCompatible = LfgCompatibleKey();
+            FindBestCompatibleInQueue(itr);
         }
-        else
-            itDelete = itr;
 
-    if (itDelete != QueueDataStore.end())
-        QueueDataStore.erase(itDelete);
+    FreeQueueSlot(slot);
+    QueueDataStore.erase(itDelete);
 }
 
 void LFGQueue::AddToNewQueue(ObjectGuid guid)
@@ -188,7 +267,32 @@ void LFGQueue::RemoveFromCurrentQueue(ObjectGuid guid)
 
 void LFGQueue::AddQueueData(ObjectGuid guid, time_t joinTime, LfgDungeonSet const& dungeons, LfgRolesMap const& rolesMap)
 {
-    QueueDataStore[guid] = LfgQueueData(joinTime, dungeons, rolesMap);
+    LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
+    uint32 slot = itQueue != QueueDataStore.end() ? itQueue->second.queueSlot : AllocateQueueSlot(guid);
+
+    LfgQueueData& queueData = QueueDataStore[guid] = LfgQueueData(joinTime, dungeons, rolesMap);
+    queueData.queueSlot = slot;
+    for (LfgRolesMap::const_iterator itRoles = rolesMap.begin(); itRoles != rolesMap.end(); ++itRoles)
+    {
+        switch (itRoles->second & ~PLAYER_ROLE_LEADER)
+        {
+            case PLAYER_ROLE_NONE:
+                queueData.hasNoRole = true;
+                break;
+            case PLAYER_ROLE_TANK:
+                ++queueData.fixedTanks;
+                break;
+            case PLAYER_ROLE_HEALER:
+                ++queueData.fixedHealers;
+                break;
+            case PLAYER_ROLE_DAMAGE:
+                ++queueData.fixedDamage;
+                break;
+            default:
+                break;
+        }
+    }
+
     AddToQueue(guid);
 }
 
@@ -196,7 +300,11 @@ void LFGQueue::RemoveQueueData(ObjectGuid guid)
 {
     LfgQueueDataContainer::iterator it = QueueDataStore.find(guid);
     if (it != QueueDataStore.end())
+    {
+        RemoveFromCompatibles(it->second.queueSlot);
+        FreeQueueSlot(it->second.queueSlot);
         QueueDataStore.erase(it);
+    }
 }
 
 void LFGQueue::UpdateWaitTimeAvg(int32 waitTime, uint32 dungeonId)
@@ -228,47 +336,85 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 }
 
 /**
-   Remove from cached compatible dungeons any entry that contains the given guid
+   Remove from cached compatible dungeons any entry that contains the given queue slot
 
-   @param[in]     guid Guid to remove from compatible cache
+   @param[in]     slot Queue slot to remove from compatible cache
 */
-void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
+void LFGQueue::RemoveFromCompatibles(uint32 slot)
 {
-    std::string strGuid = guid.ToHexString();
+    TC_LOG_DEBUG("lfg.queue.data.compatibles.remove", "Removing %s", QueueSlotGuids[slot].ToString().c_str());
+
+    // keys also listed for the other slots they contain are dropped from those lists by IndexCompatibleKey
+    std::vector<LfgCompatibleKey>& keys = CompatibleKeysBySlot[slot];
+    for (LfgCompatibleKey const& key : keys)
+        CompatibleMapStore.erase(key);
+
+    keys.clear();
+}
 
-    TC_LOG_DEBUG("lfg.queue.data.compatibles.remove", "Removing %s", guid.ToString().c_str());
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
+/**
+   Lists a newly cached key for every queue slot it contains, so removing a queue entry only looks at its own keys
+
+   @param[in]     key Key just added to the compatible cache
+*/
+void LFGQueue::IndexCompatibleKey(LfgCompatibleKey const& key)
+{
+    for (uint8 i = 0; i < key.size; ++i)
     {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
+        std::vector<LfgCompatibleKey>& keys = CompatibleKeysBySlot[key.slots[i]];
+
+        // before growing, forget keys removed along with another slot and keys listed twice (removed then cached again)
+        if (keys.size() >= 64 && keys.size() == keys.capacity())
+        {
+            keys.erase(std::remove_if(keys.begin(), keys.end(), [this](LfgCompatibleKey const& listed)
+            {
+                return CompatibleMapStore.find(listed) == CompatibleMapStore.end();
+            }), keys.end());
+
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        }
+
+        keys.push_back(key);
     }
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted queue slots of the guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibleKey const& key, LfgCompatibility compatibles)
 {
-    LfgCompatibilityData& data = CompatibleMapStore[key];
-    data.compatibility = compatibles;
+    if (key.IsEmpty())
+        return;
+
+    std::pair<LfgCompatibleContainer::iterator, bool> result = CompatibleMapStore.try_emplace(key);
+    result.first->second.compatibility = compatibles;
+    if (result.second)
+        IndexCompatibleKey(key);
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibleKey const& key, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    if (key.IsEmpty())
+        return;
+
+    std::pair<LfgCompatibleContainer::iterator, bool> result = CompatibleMapStore.try_emplace(key, data);
+    if (result.second)
+        IndexCompatibleKey(key);
+    else
+        result.first->second = data;
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted queue slots of the guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibleKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -277,7 +423,7 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCompatibleKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -320,8 +466,8 @@ uint8 LFGQueue::FindGroups()
 */
 LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    LfgCompatibleKey key = GetCompatibleKey(check);
+    LfgCompatibility compatibles = GetCompatibles(key);
 
     TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s): %s - all(%s)", GetDetailedMatchRoles(check).c_str(), GetCompatibleString(compatibles), GetDetailedMatchRoles(all).c_str());
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
@@ -330,7 +476,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s) compatibles (cached) changed from bad states to match", GetDetailedMatchRoles(check).c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -358,7 +504,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
+    LfgCompatibleKey key = GetCompatibleKey(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -381,8 +527,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) child %s not compatibles", strGuids.c_str(), GetDetailedMatchRoles(check).c_str());
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) child %s not compatibles", GetCompatibleKeyString(key).c_str(), GetDetailedMatchRoles(check).c_str());
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -426,28 +572,35 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = itQueue->second.roles;
         LFGMgr::CheckGroupRoles(data.roles);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) More than one Lfggroup (%u)", GetDetailedMatchRoles(check).c_str(), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > MAX_GROUP_SIZE)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Too many players (%u)", GetDetailedMatchRoles(check).c_str(), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
     // If it's single group no need to check for duplicate players, ignores, bad roles or bad dungeons as it's been checked before joining
     if (check.size() > 1)
     {
+        if (!CanHaveCompatibleRoles(check))
+        {
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Roles not compatible, too many players queued for a single role", GetDetailedMatchRoles(check).c_str());
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
+            return LFG_INCOMPATIBLES_NO_ROLES;
+        }
+
         for (GuidList::const_iterator it = check.begin(); it != check.end(); ++it)
         {
             LfgRolesMap const& roles = QueueDataStore[(*it)].roles;
@@ -469,7 +622,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) not compatible, %u players are ignoring each other", GetDetailedMatchRoles(check).c_str(), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
@@ -481,7 +634,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
                 o << ", " << it->first.ToHexString() << ": " << GetRolesString(it->second);
 
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Roles not compatible%s", GetDetailedMatchRoles(check).c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -501,7 +654,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (proposalDungeons.empty())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) No compatible dungeons%s", GetDetailedMatchRoles(check).c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -522,9 +675,9 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = proposalRoles;
 
         for (GuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -535,7 +688,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     if (!sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Group MATCH but can't create proposal!", GetDetailedMatchRoles(check).c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -577,7 +730,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     sLFGMgr->AddProposal(proposal);
 
     TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) MATCH! Group formed", GetDetailedMatchRoles(check).c_str());
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -619,7 +772,7 @@ void LFGQueue::UpdateQueueTimers(uint8 queueId, time_t currTime)
                 break;
         }
 
-        if (queueinfo.bestCompatible.empty())
+        if (queueinfo.bestCompatible.IsEmpty())
             FindBestCompatibleInQueue(itQueue);
 
         LfgQueueStatusData queueData(queueId, dungeonId, waitTime, wtAvg, wtTank, wtHealer, wtDps, queuedTime, queueinfo.tanks, queueinfo.healers, queueinfo.dps);
@@ -673,7 +826,7 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
         {
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility);
+            o << "(" << GetCompatibleKeyString(itr->first) << "): " << GetCompatibleString(itr->second.compatibility);
             if (!itr->second.roles.empty())
             {
                 o << " (";
@@ -696,30 +849,24 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg.queue.compatibles.find", "%s", itrQueue->first.ToString().c_str());
-    std::string sguid = itrQueue->first.ToHexString();
 
-    for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
-        {
+    for (LfgCompatibleKey const& key : CompatibleKeysBySlot[itrQueue->second.queueSlot])
+    {
+        LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.find(key);
+        if (itr != CompatibleMapStore.end() && itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
             UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
-        }
+    }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibleKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.size <= queueData.bestCompatible.size)
         return;
 
     TC_LOG_DEBUG("lfg.queue.compatibles.update", "Changed (%s) to (%s) as best compatible group for %s",
-        queueData.bestCompatible.c_str(), key.c_str(), itrQueue->first.ToString().c_str());
+        GetCompatibleKeyString(queueData.bestCompatible).c_str(), GetCompatibleKeyString(key).c_str(), itrQueue->first.ToString().c_str());
 
     queueData.bestCompatible = key;
     queueData.tanks = LFG_TANKS_NEEDED;
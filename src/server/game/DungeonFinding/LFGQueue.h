@@ -19,7 +19,11 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <algorithm>
+#include <array>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace lfg
 {
@@ -38,6 +42,36 @@ enum LfgCompatibility
     LFG_COMPATIBLES_MATCH                                  // Must be the last one
 };
 
+/// Key of the compatibility cache: sorted queue slots (see LFGQueue::AllocateQueueSlot) of the checked queue entries
+struct LfgCompatibleKey
+{
+    static constexpr uint8 MaxEntries = LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED;
+
+    LfgCompatibleKey() : slots(), size(0) { }
+
+    bool IsEmpty() const { return size == 0; }
+    bool Contains(uint32 slot) const { return std::find(slots.begin(), slots.begin() + size, slot) != slots.begin() + size; }
+    std::size_t GetHash() const;
+
+    bool operator==(LfgCompatibleKey const& right) const
+    {
+        return size == right.size && std::equal(slots.begin(), slots.begin() + size, right.slots.begin());
+    }
+
+    bool operator<(LfgCompatibleKey const& right) const
+    {
+        return std::lexicographical_compare(slots.begin(), slots.begin() + size, right.slots.begin(), right.slots.begin() + right.size);
+    }
+
+    std::array<uint32, MaxEntries> slots;
+    uint8 size;
+};
+
+struct LfgCompatibleKeyHash
+{
+    std::size_t operator()(LfgCompatibleKey const& key) const { return key.GetHash(); }
+};
+
 struct LfgCompatibilityData
 {
     LfgCompatibilityData(): compatibility(LFG_COMPATIBILITY_PENDING) { }
@@ -56,7 +90,7 @@ struct LfgQueueData
 
     LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, LfgRolesMap const& _roles):
         joinTime(_joinTime), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED),
-        dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles)
+        dps(LFG_DPS_NEEDED), dungeons(_dungeons), roles(_roles), queueSlot(0), fixedTanks(0), fixedHealers(0), fixedDamage(0), hasNoRole(false)
         { }
 
     time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
@@ -65,7 +99,12 @@ struct LfgQueueData
     uint8 dps;                                             ///< Dps needed
     LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
     LfgRolesMap roles;                                     ///< Selected Player Role/s
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgCompatibleKey bestCompatible;                       ///< Best compatible combination of people queued
+    uint32 queueSlot;                                      ///< Index of this entry in compatibility keys
+    uint8 fixedTanks;                                      ///< Players queued only as tank
+    uint8 fixedHealers;                                    ///< Players queued only as healer
+    uint8 fixedDamage;                                     ///< Players queued only as damage
+    bool hasNoRole;                                        ///< A player without any role selected
 };
 
 struct LfgWaitTime
@@ -76,7 +115,7 @@ struct LfgWaitTime
 };
 
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
+typedef std::unordered_map<LfgCompatibleKey, LfgCompatibilityData, LfgCompatibleKeyHash> LfgCompatibleContainer;
 typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -113,20 +152,27 @@ class TC_GAME_API LFGQueue
     private:
         void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
 
+        uint32 AllocateQueueSlot(ObjectGuid guid);
+        void FreeQueueSlot(uint32 slot);
+        LfgCompatibleKey GetCompatibleKey(GuidList const& check) const;
+        std::string GetCompatibleKeyString(LfgCompatibleKey const& key) const;
+        bool CanHaveCompatibleRoles(GuidList const& check) const;
+        void IndexCompatibleKey(LfgCompatibleKey const& key);
+
         void AddToNewQueue(ObjectGuid guid);
         void AddToCurrentQueue(ObjectGuid guid);
         void AddToFrontCurrentQueue(ObjectGuid guid);
         void RemoveFromNewQueue(ObjectGuid guid);
         void RemoveFromCurrentQueue(ObjectGuid guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
-        void RemoveFromCompatibles(ObjectGuid guid);
+        void SetCompatibles(LfgCompatibleKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibleKey const& key);
+        void RemoveFromCompatibles(uint32 slot);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCompatibleKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData* GetCompatibilityData(LfgCompatibleKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibleKey const& key, LfgRolesMap const& roles);
 
         LfgCompatibility FindNewGroups(GuidList& check, GuidList& all);
         LfgCompatibility CheckCompatibility(GuidList check);
@@ -134,6 +180,9 @@ class TC_GAME_API LFGQueue
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
         LfgCompatibleContainer CompatibleMapStore;         ///< Compatible dungeons
+        std::vector<std::vector<LfgCompatibleKey>> CompatibleKeysBySlot; ///< Cached keys each queue slot is part of, may hold stale or duplicate keys
+        std::vector<ObjectGuid> QueueSlotGuids;            ///< Queue entry owning each slot
+        std::vector<uint32> FreeQueueSlots;                ///< Slots released by entries that left the queue
 
         LfgWaitTimesContainer waitTimesAvgStore;           ///< Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          ///< Average wait time to find a group queuing as tank
@@ -448,9 +448,9 @@ void AreaTrigger::SearchUnitInPolygon(std::vector<Unit*>& targetList)
 
     targetList.erase(std::remove_if(targetList.begin(), targetList.end(), [this, minZ, maxZ](Unit* unit) -> bool
     {
-        return !CheckIsInPolygon2D(unit)
-            || unit->GetPositionZ() < minZ
-            || unit->GetPositionZ() > maxZ;
+        return unit->GetPositionZ() < minZ
+            || unit->GetPositionZ() > maxZ
+            || !CheckIsInPolygon2D(unit);
     }), targetList.end());
 }
 
@@ -471,16 +471,35 @@ void AreaTrigger::SearchUnitInCylinder(std::vector<Unit*>& targetList)
 
 void AreaTrigger::HandleUnitEnterExit(std::vector<Unit*> const& newTargetList)
 {
-    GuidUnorderedSet exitUnits(std::move(_insideUnits));
-
+    // _insideUnits is updated in place, units staying inside do not touch it
     std::vector<Unit*> enteringUnits;
+    std::vector<ObjectGuid> newTargetGuids;
+    newTargetGuids.reserve(newTargetList.size());
 
     for (Unit* unit : newTargetList)
     {
-        if (exitUnits.erase(unit->GetGUID()) == 0) // erase(key_type) returns number of elements erased
+        newTargetGuids.push_back(unit->GetGUID());
+        if (_insideUnits.insert(unit->GetGUID()).second)
             enteringUnits.push_back(unit);
+    }
 
-        _insideUnits.insert(unit->GetGUID());
+    std::sort(newTargetGuids.begin(), newTargetGuids.end());
+    newTargetGuids.erase(std::unique(newTargetGuids.begin(), newTargetGuids.end()), newTargetGuids.end());
+
+    // every new target is inside now, anything more has left
+    std::vector<ObjectGuid> exitUnits;
+    if (_insideUnits.size() > newTargetGuids.size())
+    {
+        for (auto itr = _insideUnits.begin(); itr != _insideUnits.end();)
+        {
+            if (!std::binary_search(newTargetGuids.begin(), newTargetGuids.end(), *itr))
+            {
+                exitUnits.push_back(*itr);
+                itr = _insideUnits.erase(itr);
+            }
+            else
+                ++itr;
+        }
     }
 
     // Handle after _insideUnits have been reinserted so we can use GetInsideUnits() in hooks
@@ -565,14 +584,25 @@ void AreaTrigger::UpdatePolygonOrientation()
     float angleSin = std::sin(newOrientation);
     float angleCos = std::cos(newOrientation);
 
+    float minX = std::numeric_limits<float>::max(), minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest(), maxY = std::numeric_limits<float>::lowest();
+
     // This is needed to rotate the vertices, following orientation
     for (Position& vertice : _polygonVertices)
     {
         float x = vertice.GetPositionX() * angleCos - vertice.GetPositionY() * angleSin;
         float y = vertice.GetPositionY() * angleCos + vertice.GetPositionX() * angleSin;
         vertice.Relocate(x, y);
+
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
     }
 
+    _polygonBoundsMin.Relocate(minX, minY);
+    _polygonBoundsMax.Relocate(maxX, maxY);
+
     _previousCheckOrientation = newOrientation;
 }
 
@@ -581,6 +611,13 @@ bool AreaTrigger::CheckIsInPolygon2D(Position const* pos) const
     float testX = pos->GetPositionX();
     float testY = pos->GetPositionY();
 
+    // cheap rejection of points outside of the bounding box of the polygon
+    float relativeX = testX - GetPositionX();
+    float relativeY = testY - GetPositionY();
+    if (relativeX < _polygonBoundsMin.GetPositionX() || relativeX > _polygonBoundsMax.GetPositionX()
+        || relativeY < _polygonBoundsMin.GetPositionY() || relativeY > _polygonBoundsMax.GetPositionY())
+        return false;
+
     //this method uses the ray tracing algorithm to determine if the point is in the polygon
     bool locatedInPolygon = false;
 
@@ -21,6 +21,7 @@
 #include "Object.h"
 #include "MapObject.h"
 #include "AreaTriggerTemplate.h"
+#include "TransientObjectPool.h"
 
 class AuraEffect;
 class AreaTriggerAI;
@@ -44,6 +45,8 @@ class TC_GAME_API AreaTrigger : public WorldObject, public GridObject<AreaTrigge
         AreaTrigger();
         ~AreaTrigger();
 
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
     protected:
         void BuildValuesCreate(ByteBuffer* data, Player const* target) const override;
         void BuildValuesUpdate(ByteBuffer* data, Player const* target) const override;
@@ -160,6 +163,8 @@ class TC_GAME_API AreaTrigger : public WorldObject, public GridObject<AreaTrigge
         Position _rollPitchYaw;
         Position _targetRollPitchYaw;
         std::vector<Position> _polygonVertices;
+        Position _polygonBoundsMin;                         // 2D bounding box of _polygonVertices, relative to the areatrigger
+        Position _polygonBoundsMax;
         std::unique_ptr<::Movement::Spline<int32>> _spline;
 
         bool _reachedDestination;
@@ -85,6 +85,12 @@ bool VendorItem::IsGoldRequired(ItemTemplate const* pProto) const
     return pProto->HasFlag(ITEM_FLAG2_DONT_IGNORE_BUY_PRICE) || !ExtendedCost;
 }
 
+void VendorItemData::AddItem(VendorItem vItem)
+{
+    m_visibilityMasks.push_back(GetVisibilityMask(vItem));
+    m_items.emplace_back(std::move(vItem));
+}
+
 bool VendorItemData::RemoveItem(uint32 item_id, uint8 type)
 {
     auto newEnd = std::remove_if(m_items.begin(), m_items.end(), [=](VendorItem const& vendorItem)
@@ -94,9 +100,48 @@ bool VendorItemData::RemoveItem(uint32 item_id, uint8 type)
 
     bool found = newEnd != m_items.end();
     m_items.erase(newEnd, m_items.end());
+
+    if (found)
+    {
+        m_visibilityMasks.clear();
+        for (VendorItem const& vendorItem : m_items)
+            m_visibilityMasks.push_back(GetVisibilityMask(vendorItem));
+    }
+
     return found;
 }
 
+void VendorItemData::GetSlotsVisibleTo(uint32 classMask, uint32 team, std::vector<uint64>& slots) const
+{
+    uint32 teamMask = team == ALLIANCE ? VENDOR_SLOT_ALLIANCE : VENDOR_SLOT_HORDE;
+    slots.assign((m_visibilityMasks.size() + 63) / 64, 0);
+    for (std::size_t i = 0; i < m_visibilityMasks.size(); ++i)
+        slots[i / 64] |= uint64((m_visibilityMasks[i] & classMask) != 0 && (m_visibilityMasks[i] & teamMask) != 0) << (i % 64);
+}
+
+uint32 VendorItemData::GetVisibilityMask(VendorItem const& vItem)
+{
+    uint32 mask = CLASSMASK_ALL_PLAYABLE | VENDOR_SLOT_ALLIANCE | VENDOR_SLOT_HORDE;
+    if (vItem.Type != ITEM_VENDOR_TYPE_ITEM)
+        return mask;
+
+    ItemTemplate const* itemTemplate = sObjectMgr->GetItemTemplate(vItem.item);
+    if (!itemTemplate)
+        return mask;
+
+    // class restrictions only hide items that cannot be traded to another class
+    if (itemTemplate->GetBonding() == BIND_ON_ACQUIRE)
+        mask &= itemTemplate->GetAllowableClass() | VENDOR_SLOT_ALLIANCE | VENDOR_SLOT_HORDE;
+
+    if (itemTemplate->HasFlag(ITEM_FLAG2_FACTION_HORDE))
+        mask &= ~VENDOR_SLOT_ALLIANCE;
+
+    if (itemTemplate->HasFlag(ITEM_FLAG2_FACTION_ALLIANCE))
+        mask &= ~VENDOR_SLOT_HORDE;
+
+    return mask;
+}
+
 VendorItem const* VendorItemData::FindItemCostPair(uint32 item_id, uint32 extendedCost, uint8 type) const
 {
     for (VendorItem const& vendorItem : m_items)
@@ -306,7 +351,8 @@ Creature::Creature(bool isWorldObject): Unit(isWorldObject), MapObject(), m_grou
     m_corpseRemoveTime(0), m_respawnTime(0), m_respawnDelay(300), m_corpseDelay(60), m_wanderDistance(0.0f), m_boundaryCheckTime(2500), m_combatPulseTime(0), m_combatPulseDelay(0), m_reactState(REACT_AGGRESSIVE),
     m_defaultMovementType(IDLE_MOTION_TYPE), m_spawnId(UI64LIT(0)), m_equipmentId(0), m_originalEquipmentId(0), m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false), m_cannotReachTarget(false), m_cannotReachTimer(0),
     m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL), m_originalEntry(0), m_homePosition(), m_transportHomePosition(), m_creatureInfo(nullptr), m_creatureData(nullptr), _waypointPathId(0), _currentWaypointNodeInfo(0, 0),
-    m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false), _lastDamagedTime(0),
+    m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false),
+    _lowUpdateRateDiff(0), _lowUpdateRateCheckTimer(0), _lowUpdateRateActive(false), _lastDamagedTime(0),
     _regenerateHealth(true), _regenerateHealthLock(false)
 {
     m_regenTimer = CREATURE_REGEN_INTERVAL;
@@ -382,6 +428,35 @@ void Creature::SearchFormation()
         sFormationMgr->AddCreatureToGroup(formationInfo->LeaderSpawnId, this);
 }
 
+bool Creature::CanUseLowUpdateRate() const
+{
+    // anything that may be observed or driven by someone keeps the full update rate
+    if (m_deathState != ALIVE || GetMap()->Instanceable() || isActiveObject())
+        return false;
+
+    if (IsEngaged() || IsInEvadeMode() || HasUnitState(UNIT_STATE_CASTING))
+        return false;
+
+    if (IsSummon() || IsPet() || IsCharmed() || !GetCharmerOrOwnerGUID().IsEmpty())
+        return false;
+
+    if (IsVehicle() || GetVehicle() || GetTransport())
+        return false;
+
+    return true;
+}
+
+bool Creature::HasPlayerInLowUpdateRateRange() const
+{
+    float const range = sWorld->getFloatConfig(CONFIG_CREATURE_LOW_UPDATE_RATE_DISTANCE);
+
+    Player* player = nullptr;
+    Trinity::AnyPlayerInObjectRangeCheck checker(this, range, false);
+    Trinity::PlayerSearcher<Trinity::AnyPlayerInObjectRangeCheck> searcher(this, player, checker);
+    Cell::VisitWorldObjects(this, searcher, range);
+    return player != nullptr;
+}
+
 bool Creature::IsFormationLeader() const
 {
     if (!m_formation)
@@ -706,6 +781,30 @@ void Creature::Update(uint32 diff)
         AI()->JustAppeared();
     }
 
+    if (uint32 lowUpdateRateInterval = sWorld->getIntConfig(CONFIG_CREATURE_LOW_UPDATE_RATE_INTERVAL))
+    {
+        if (CanUseLowUpdateRate())
+        {
+            if (_lowUpdateRateCheckTimer <= diff)
+            {
+                _lowUpdateRateCheckTimer = CREATURE_LOW_UPDATE_RATE_CHECK_INTERVAL;
+                _lowUpdateRateActive = !HasPlayerInLowUpdateRateRange();
+            }
+            else
+                _lowUpdateRateCheckTimer -= diff;
+        }
+        else
+            _lowUpdateRateActive = false;
+
+        // accumulate the elapsed time so timers, regeneration and movement catch up in one step
+        _lowUpdateRateDiff += diff;
+        if (_lowUpdateRateActive && _lowUpdateRateDiff < lowUpdateRateInterval)
+            return;
+
+        diff = _lowUpdateRateDiff;
+        _lowUpdateRateDiff = 0;
+    }
+
     UpdateMovementFlags();
 
     switch (m_deathState)
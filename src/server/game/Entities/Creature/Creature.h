@@ -25,6 +25,7 @@
 #include "Duration.h"
 #include "Loot.h"
 #include "MapObject.h"
+#include "TransientObjectPool.h"
 #include <list>
 
 class CreatureAI;
@@ -70,6 +71,9 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
     public:
         explicit Creature(bool isWorldObject = false);
 
+        // also covers summons, pets and vehicles, creatures are created and destroyed on every (re)spawn and grid (un)load
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -436,6 +440,13 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         bool m_triggerJustAppeared;
         bool m_respawnCompatibilityMode;
 
+        /* Low update rate for creatures away from players */
+        bool CanUseLowUpdateRate() const;
+        bool HasPlayerInLowUpdateRateRange() const;
+        uint32 _lowUpdateRateDiff;       // ms accumulated since the last full update
+        uint32 _lowUpdateRateCheckTimer; // ms until player proximity is re-evaluated
+        bool _lowUpdateRateActive;
+
         /* Spell focus system */
         void ReacquireSpellFocusTarget();
         struct
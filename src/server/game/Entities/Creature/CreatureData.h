@@ -362,6 +362,7 @@ struct TC_GAME_API CreatureMovementData
 const uint32 CREATURE_REGEN_INTERVAL = 2 * IN_MILLISECONDS;
 const uint32 PET_FOCUS_REGEN_INTERVAL = 4 * IN_MILLISECONDS;
 const uint32 CREATURE_NOPATH_EVADE_TIME = 5 * IN_MILLISECONDS;
+const uint32 CREATURE_LOW_UPDATE_RATE_CHECK_INTERVAL = 1 * IN_MILLISECONDS;
 
 const uint8 MAX_KILL_CREDIT = 2;
 const uint32 MAX_CREATURE_MODELS = 4;
@@ -652,6 +653,13 @@ struct VendorItemData
 {
     std::vector<VendorItem> m_items;
 
+    // per slot, the classes (low 16 bits) and teams (VENDOR_SLOT_ALLIANCE/HORDE) allowed to see the item,
+    // built from the item template when the item is added so vendor lists do not look it up on every open
+    std::vector<uint32> m_visibilityMasks;
+
+    static constexpr uint32 VENDOR_SLOT_ALLIANCE = 0x10000;
+    static constexpr uint32 VENDOR_SLOT_HORDE    = 0x20000;
+
     VendorItem const* GetItem(uint32 slot) const
     {
         if (slot >= m_items.size())
@@ -661,16 +669,19 @@ struct VendorItemData
     }
     bool Empty() const { return m_items.empty(); }
     uint32 GetItemCount() const { return uint32(m_items.size()); }
-    void AddItem(VendorItem vItem)
-    {
-        m_items.emplace_back(std::move(vItem));
-    }
+    void AddItem(VendorItem vItem);
     bool RemoveItem(uint32 item_id, uint8 type);
     VendorItem const* FindItemCostPair(uint32 item_id, uint32 extendedCost, uint8 type) const;
+    // one bit per slot, set when a player of that class and team can see it
+    void GetSlotsVisibleTo(uint32 classMask, uint32 team, std::vector<uint64>& slots) const;
     void Clear()
     {
         m_items.clear();
+        m_visibilityMasks.clear();
     }
+
+private:
+    static uint32 GetVisibilityMask(VendorItem const& vItem);
 };
 
 #endif // CreatureData_h__
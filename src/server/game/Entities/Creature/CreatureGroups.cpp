@@ -24,6 +24,7 @@
 #include "Map.h"
 #include "MotionMaster.h"
 #include "MovementGenerator.h"
+#include "MoveSpline.h"
 #include "ObjectMgr.h"
 
 #define MAX_DESYNC 5.0f
@@ -189,7 +190,8 @@ void FormationMgr::AddFormationMember(ObjectGuid::LowType spawnId, float followA
     _creatureGroupMap.emplace(spawnId, std::move(member));
 }
 
-CreatureGroup::CreatureGroup(ObjectGuid::LowType leaderSpawnId) : _leader(nullptr), _members(), _leaderSpawnId(leaderSpawnId), _formed(false), _engaging(false)
+CreatureGroup::CreatureGroup(ObjectGuid::LowType leaderSpawnId) : _leader(nullptr), _members(), _leaderSpawnId(leaderSpawnId), _formed(false), _engaging(false),
+    _predictionSplineId(0)
 {
 }
 
@@ -295,6 +297,21 @@ void CreatureGroup::LeaderStartedMoving()
     }
 }
 
+Position const& CreatureGroup::GetPredictedLeaderPosition(float travelDist, float relativeAngle)
+{
+    ASSERT(_leader);
+
+    if (_predictionSplineId != _leader->movespline->GetId() || _predictionLeaderPosition != _leader->GetPosition())
+    {
+        _predictionSplineId = _leader->movespline->GetId();
+        _predictionLeaderPosition = _leader->GetPosition();
+        _predictedLeaderPosition = _leader->GetPosition();
+        _leader->MovePositionToFirstCollision(_predictedLeaderPosition, travelDist, relativeAngle);
+    }
+
+    return _predictedLeaderPosition;
+}
+
 bool CreatureGroup::CanLeaderStartMoving() const
 {
     for (std::unordered_map<Creature*, FormationInfo*>::value_type const& pair : _members)
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "ObjectGuid.h"
+#include "Position.h"
 #include <unordered_map>
 #include <map>
 
@@ -35,7 +36,6 @@ enum GroupAIFlags
 class Creature;
 class CreatureGroup;
 class Unit;
-struct Position;
 
 struct FormationInfo
 {
@@ -76,6 +76,11 @@ class TC_GAME_API CreatureGroup
         bool _formed;
         bool _engaging;
 
+        // see GetPredictedLeaderPosition
+        uint32 _predictionSplineId;
+        Position _predictionLeaderPosition;
+        Position _predictedLeaderPosition;
+
     public:
         //Group cannot be created empty
         explicit CreatureGroup(ObjectGuid::LowType leaderSpawnId);
@@ -93,6 +98,9 @@ class TC_GAME_API CreatureGroup
         void FormationReset(bool dismiss);
 
         void LeaderStartedMoving();
+        // leader position travelDist ahead on its current spline, every member launching a formation move needs it
+        // so it is computed (with its collision and height checks) once until the leader moves or starts another spline
+        Position const& GetPredictedLeaderPosition(float travelDist, float relativeAngle);
         void MemberEngagingTarget(Creature* member, Unit* target);
         bool CanLeaderStartMoving() const;
 };
@@ -85,34 +85,36 @@ uint32 GossipMenu::AddMenuItem(int32 menuItemId, GossipOptionIcon icon, std::str
 void GossipMenu::AddMenuItem(uint32 menuId, uint32 menuItemId, uint32 sender, uint32 action)
 {
     /// Find items for given menu id.
-    GossipMenuItemsMapBounds bounds = sObjectMgr->GetGossipMenuItemsMapBounds(menuId);
+    GossipMenuItemsCompiledList const* menuItems = sObjectMgr->GetCompiledGossipMenuItems(menuId);
     /// Return if there are none.
-    if (bounds.first == bounds.second)
+    if (!menuItems)
         return;
 
     /// Iterate over each of them.
-    for (GossipMenuItemsContainer::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+    for (GossipMenuItemsCompiled const& compiled : *menuItems)
     {
+        GossipMenuItems const& menuItem = *compiled.Item;
+
         /// Find the one with the given menu item id.
-        if (itr->second.OptionID != menuItemId)
+        if (menuItem.OptionID != menuItemId)
             continue;
 
         /// Store texts for localization.
         std::string strOptionText, strBoxText;
-        BroadcastTextEntry const* optionBroadcastText = sBroadcastTextStore.LookupEntry(itr->second.OptionBroadcastTextID);
-        BroadcastTextEntry const* boxBroadcastText = sBroadcastTextStore.LookupEntry(itr->second.BoxBroadcastTextID);
+        BroadcastTextEntry const* optionBroadcastText = compiled.OptionBroadcastText;
+        BroadcastTextEntry const* boxBroadcastText = compiled.BoxBroadcastText;
 
         /// OptionText
         if (optionBroadcastText)
             strOptionText = DB2Manager::GetBroadcastTextValue(optionBroadcastText, GetLocale());
         else
-            strOptionText = itr->second.OptionText;
+            strOptionText = menuItem.OptionText;
 
         /// BoxText
         if (boxBroadcastText)
             strBoxText = DB2Manager::GetBroadcastTextValue(boxBroadcastText, GetLocale());
         else
-            strBoxText = itr->second.BoxText;
+            strBoxText = menuItem.BoxText;
 
         /// Check need of localization.
         if (GetLocale() != DEFAULT_LOCALE)
@@ -133,8 +135,8 @@ void GossipMenu::AddMenuItem(uint32 menuId, uint32 menuItemId, uint32 sender, ui
         }
 
         /// Add menu item with existing method. Menu item id -1 is also used in ADD_GOSSIP_ITEM macro.
-        uint32 newOptionId = AddMenuItem(-1, itr->second.OptionIcon, strOptionText, sender, action, strBoxText, itr->second.BoxMoney, itr->second.BoxCoded);
-        AddGossipMenuItemData(newOptionId, itr->second.ActionMenuID, itr->second.ActionPoiID);
+        uint32 newOptionId = AddMenuItem(-1, menuItem.OptionIcon, strOptionText, sender, action, strBoxText, menuItem.BoxMoney, menuItem.BoxCoded);
+        AddGossipMenuItemData(newOptionId, menuItem.ActionMenuID, menuItem.ActionPoiID);
     }
 }
 
@@ -20,6 +20,7 @@
 #include "Creature.h"
 #include "Log.h"
 #include "NPCPackets.h"
+#include "ObjectMgr.h"
 #include "Player.h"
 #include "SpellInfo.h"
 #include "SpellMgr.h"
@@ -35,6 +36,21 @@ namespace Trainer
     Trainer::Trainer(uint32 id, Type type, std::string greeting, std::vector<Spell> spells) : _id(id), _type(type), _spells(std::move(spells))
     {
         _greeting[DEFAULT_LOCALE] = std::move(greeting);
+
+        for (uint8 race = RACE_HUMAN; race < MAX_RACES; ++race)
+        {
+            for (uint8 playerClass = CLASS_WARRIOR; playerClass < MAX_CLASSES; ++playerClass)
+            {
+                if (!sObjectMgr->GetPlayerInfo(race, playerClass))
+                    continue;
+
+                std::vector<uint64>& mask = _raceClassSpellMasks[uint16(race << 8 | playerClass)];
+                mask.resize((_spells.size() + 63) / 64);
+                for (std::size_t i = 0; i < _spells.size(); ++i)
+                    if (Player::IsSpellFitByClassAndRace(_spells[i].SpellId, race, playerClass))
+                        mask[i / 64] |= UI64LIT(1) << (i % 64);
+            }
+        }
     }
 
     void Trainer::SendSpells(Creature const* npc, Player* player, LocaleConstant locale) const
@@ -49,7 +65,7 @@ namespace Trainer
         trainerList.Spells.reserve(_spells.size());
         for (Spell const& trainerSpell : _spells)
         {
-            if (!player->IsSpellFitByClassAndRace(trainerSpell.SpellId))
+            if (!IsSpellFitByClassAndRace(player, &trainerSpell))
                 continue;
 
             if (!sConditionMgr->IsObjectMeetingTrainerSpellConditions(_id, trainerSpell.SpellId, player))
@@ -168,13 +184,23 @@ namespace Trainer
         return true;
     }
 
+    bool Trainer::IsSpellFitByClassAndRace(Player const* player, Spell const* trainerSpell) const
+    {
+        auto itr = _raceClassSpellMasks.find(uint16(player->GetRace() << 8 | player->GetClass()));
+        if (itr == _raceClassSpellMasks.end())
+            return player->IsSpellFitByClassAndRace(trainerSpell->SpellId);
+
+        std::size_t index = trainerSpell - _spells.data();
+        return (itr->second[index / 64] >> (index % 64)) & 1;
+    }
+
     SpellState Trainer::GetSpellState(Player const* player, Spell const* trainerSpell) const
     {
         if (player->HasSpell(trainerSpell->SpellId))
             return SpellState::Known;
 
         // check race/class requirement
-        if (!player->IsSpellFitByClassAndRace(trainerSpell->SpellId))
+        if (!IsSpellFitByClassAndRace(player, trainerSpell))
             return SpellState::Unavailable;
 
         // check skill requirement
@@ -21,6 +21,7 @@
 #include "Common.h"
 #include <array>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Creature;
@@ -72,6 +73,7 @@ namespace Trainer
 
     private:
         Spell const* GetSpell(uint32 spellId) const;
+        bool IsSpellFitByClassAndRace(Player const* player, Spell const* trainerSpell) const;
         bool CanTeachSpell(Player const* player, Spell const* trainerSpell) const;
         SpellState GetSpellState(Player const* player, Spell const* trainerSpell) const;
         void SendTeachFailure(Creature const* npc, Player const* player, uint32 spellId, FailReason reason) const;
@@ -84,6 +86,10 @@ namespace Trainer
         Type _type;
         std::vector<Spell> _spells;
         std::array<std::string, TOTAL_LOCALES> _greeting;
+
+        // Player::IsSpellFitByClassAndRace only depends on race and class, its result for every spell is computed once
+        // per playable combination (key race << 8 | class), bit i set when _spells[i] fits
+        std::unordered_map<uint16, std::vector<uint64>> _raceClassSpellMasks;
     };
 }
 
@@ -20,6 +20,7 @@
 
 #include "Object.h"
 #include "MapObject.h"
+#include "TransientObjectPool.h"
 
 class Unit;
 class Aura;
@@ -38,6 +39,8 @@ class TC_GAME_API DynamicObject : public WorldObject, public GridObject<DynamicO
         DynamicObject(bool isWorldObject);
         ~DynamicObject();
 
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
     protected:
         void BuildValuesCreate(ByteBuffer* data, Player const* target) const override;
         void BuildValuesUpdate(ByteBuffer* data, Player const* target) const override;
@@ -60,6 +63,7 @@ class TC_GAME_API DynamicObject : public WorldObject, public GridObject<DynamicO
         void RemoveAura();
         void SetCasterViewpoint();
         void RemoveCasterViewpoint();
+        bool IsCasterViewpoint() const { return _isViewpoint; }
         Unit* GetCaster() const { return _caster; }
         uint32 GetFaction() const override;
         void BindToCaster();
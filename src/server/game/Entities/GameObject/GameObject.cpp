@@ -46,6 +46,7 @@
 #include "ScriptMgr.h"
 #include "SpellMgr.h"
 #include "Transport.h"
+#include "ViewerDependentValues.h"
 #include "World.h"
 #include <G3D/Box.h>
 #include <G3D/CoordinateFrame.h>
@@ -132,6 +133,8 @@ GameObject::GameObject() : WorldObject(false), MapObject(),
     m_usetimes = 0;
     m_spellId = 0;
     m_cooldownTime = 0;
+    m_trapSearchUntil = 0;
+    m_trapSearchPending = true;
     m_prevGoState = GO_STATE_ACTIVE;
     m_goInfo = nullptr;
     m_goData = nullptr;
@@ -742,7 +745,11 @@ void GameObject::Update(uint32 diff)
                 if (goInfo->type == GAMEOBJECT_TYPE_TRAP)
                 {
                     if (GameTime::GetGameTimeMS() < m_cooldownTime)
+                    {
+                        // units already standing in the trap when it is armed again do not relocate
+                        m_trapSearchPending = true;
                         break;
+                    }
 
                     // Type 2 (bomb) does not need to be triggered by a unit and despawns after casting its spell.
                     if (goInfo->trap.charges == 2)
@@ -752,18 +759,15 @@ void GameObject::Update(uint32 diff)
                     }
 
                     // Type 0 despawns after being triggered, type 1 does not.
-                    /// @todo This is activation radius. Casting radius must be selected from spell data.
-                    float radius;
-                    if (!goInfo->trap.radius)
-                    {
-                        // Battleground traps: data2 == 0 && data5 == 3
-                        if (goInfo->trap.cooldown != 3)
-                            break;
+                    float radius = GetTrapActivationRadius();
+                    if (!radius)
+                        break;
 
-                        radius = 3.f;
-                    }
-                    else
-                        radius = goInfo->trap.radius / 2.f;
+                    // nobody moved close to the trap since the last search, see WakeTrapSearch
+                    if (!m_trapSearchPending && GameTime::GetGameTimeMS() >= m_trapSearchUntil)
+                        break;
+
+                    m_trapSearchPending = false;
 
                     // Pointer to appropriate target if found any
                     Unit* target = nullptr;
@@ -2562,9 +2566,53 @@ void GameObject::SetDestructibleState(GameObjectDestructibleState state, WorldOb
     }
 }
 
+float GameObject::GetTrapActivationRadius() const
+{
+    GameObjectTemplate const* goInfo = GetGOInfo();
+    if (goInfo->type != GAMEOBJECT_TYPE_TRAP)
+        return 0.f;
+
+    /// @todo This is activation radius. Casting radius must be selected from spell data.
+    if (!goInfo->trap.radius)
+    {
+        // Battleground traps: data2 == 0 && data5 == 3
+        if (goInfo->trap.cooldown != 3)
+            return 0.f;
+
+        return 3.f;
+    }
+
+    return goInfo->trap.radius / 2.f;
+}
+
+void GameObject::WakeTrapSearch(Unit const* unit)
+{
+    if (GetGoType() != GAMEOBJECT_TYPE_TRAP)
+        return;
+
+    // environmental traps only look for players
+    if (GetOwnerGUID().IsEmpty() && unit->GetTypeId() != TYPEID_PLAYER)
+        return;
+
+    float radius = GetTrapActivationRadius();
+    if (!radius)
+        return;
+
+    // the next notify for this unit comes one visibility notify period later at the earliest,
+    // stay awake for two of them and accept every unit that can reach the trap meanwhile
+    uint32 wakeDuration = uint32(std::max(GetMap()->GetVisibilityNotifyPeriod(), 1)) * 2;
+    float speed = std::max(unit->GetSpeed(MOVE_RUN), unit->GetSpeed(MOVE_FLIGHT));
+    if (!IsWithinDist(unit, radius + speed * wakeDuration / IN_MILLISECONDS))
+        return;
+
+    m_trapSearchUntil = GameTime::GetGameTimeMS() + wakeDuration;
+}
+
 void GameObject::SetLootState(LootState state, Unit* unit)
 {
     m_lootState = state;
+    if (state == GO_READY)
+        m_trapSearchPending = true;
     if (unit)
         m_lootStateUnitGUID = unit->GetGUID();
     else
@@ -2828,6 +2876,31 @@ void GameObject::BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::Object
     data->AddUpdateBlock(buffer);
 }
 
+bool GameObject::HasViewerDependentChanges() const
+{
+    if (m_values.HasChanged(TYPEID_OBJECT) && m_objectData->HasChanged(&UF::ObjectData::DynamicFlags))
+        return true;
+
+    if (m_values.HasChanged(TYPEID_GAMEOBJECT))
+    {
+        if (m_gameObjectData->HasChanged(&UF::GameObjectData::Flags)
+            || m_gameObjectData->HasChanged(&UF::GameObjectData::State)
+            || m_gameObjectData->HasChanged(&UF::GameObjectData::Level))
+            return true;
+    }
+
+    return false;
+}
+
+bool GameObject::GetViewerDependentCreateValues(Player const* target, std::vector<uint32>& values) const
+{
+    values.push_back(UF::ViewerDependentValue<UF::ObjectData::DynamicFlagsTag>::GetValue(&*m_objectData, this, target));
+    values.push_back(UF::ViewerDependentValue<UF::GameObjectData::FlagsTag>::GetValue(&*m_gameObjectData, this, target));
+    values.push_back(uint32(UF::ViewerDependentValue<UF::GameObjectData::StateTag>::GetValue(&*m_gameObjectData, this, target)));
+    values.push_back(uint32(UF::ViewerDependentValue<UF::GameObjectData::LevelTag>::GetValue(&*m_gameObjectData, this, target)));
+    return true;
+}
+
 void GameObject::ClearUpdateMask(bool remove)
 {
     m_values.ClearChangesMask(&GameObject::m_gameObjectData);
@@ -2897,9 +2970,8 @@ void GameObject::UpdateModelPosition()
 
     if (GetMap()->ContainsGameObjectModel(*m_model))
     {
-        GetMap()->RemoveGameObjectModel(*m_model);
         m_model->UpdatePosition();
-        GetMap()->InsertGameObjectModel(*m_model);
+        GetMap()->UpdateGameObjectModel(*m_model);
     }
 }
 
@@ -92,6 +92,8 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
     public:
         void BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
             UF::GameObjectData::Mask const& requestedGameObjectMask, Player const* target) const;
+        bool HasViewerDependentChanges() const override;
+        bool GetViewerDependentCreateValues(Player const* target, std::vector<uint32>& values) const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
@@ -197,6 +199,10 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         // Note: unit is only used when s = GO_ACTIVATED
         void SetLootState(LootState s, Unit* unit = nullptr);
 
+        // Traps only search for targets after a unit moved or changed visibility close to them and when they are armed again
+        float GetTrapActivationRadius() const;
+        void WakeTrapSearch(Unit const* unit);
+
         uint16 GetLootMode() const { return m_LootMode; }
         bool HasLootMode(uint16 lootMode) const { return (m_LootMode & lootMode) != 0; }
         void SetLootMode(uint16 lootMode) { m_LootMode = lootMode; }
@@ -336,6 +342,8 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         time_t      m_restockTime;
         time_t      m_cooldownTime;                         // used as internal reaction delay time store (not state change reaction).
                                                             // For traps this: spell casting cooldown, for doors/buttons: reset time.
+        uint32      m_trapSearchUntil;                      // (ms game time) traps search for targets every update until then
+        bool        m_trapSearchPending;                    // trap searches at least once more, set when armed
         GOState     m_prevGoState;                          // What state to set whenever resetting
 
         GuidSet m_SkillupList;
@@ -0,0 +1,356 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GUIDHASHCONTAINERS_H
+#define TRINITY_GUIDHASHCONTAINERS_H
+
+#include "ObjectGuid.h"
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Trinity
+{
+namespace Impl
+{
+    struct GuidSetKeyOf
+    {
+        static ObjectGuid const& Get(ObjectGuid const& value) { return value; }
+    };
+
+    struct GuidMapKeyOf
+    {
+        template<class T>
+        static ObjectGuid const& Get(std::pair<ObjectGuid, T> const& value) { return value.first; }
+    };
+
+    /*
+     * Open addressing hash table keyed by ObjectGuid, used in place of std::unordered_map/set for the
+     * containers looked up on every visibility update and accessor call.
+     *
+     * Values are stored in one flat array next to an array of control bytes holding either the state of
+     * the slot (empty/deleted) or 7 bits of the hash of its key, so probing compares one byte per slot and
+     * only touches the 16 byte guid when those bits match. Capacity is a power of two, probing is linear.
+     *
+     * Erase leaves a tombstone instead of moving elements: iterators (and references) to other elements stay
+     * valid and `itr = container.erase(itr)` loops work like with std containers. Inserting may rehash,
+     * which invalidates every iterator and reference - unlike std::unordered_map, references do not survive
+     * a rehash, hold values (pointers) and not references to them across inserts.
+     */
+    template<class Value, class KeyOf, bool ConstIterators>
+    class GuidHashTable
+    {
+        static constexpr uint8 CtrlEmpty = 0x80;
+        static constexpr uint8 CtrlDeleted = 0xFE;
+        static constexpr std::size_t MinCapacity = 16;
+
+    public:
+        using key_type = ObjectGuid;
+        using value_type = Value;
+        using size_type = std::size_t;
+
+        template<bool Const>
+        class Iterator
+        {
+            friend class GuidHashTable;
+            using Table = std::conditional_t<Const, GuidHashTable const, GuidHashTable>;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, Value const&, Value&>;
+            using pointer = std::conditional_t<Const, Value const*, Value*>;
+
+            Iterator() : _table(nullptr), _index(0) { }
+            Iterator(Table* table, std::size_t index) : _table(table), _index(index) { }
+
+            template<bool OtherConst, std::enable_if_t<Const && !OtherConst, int> = 0>
+            Iterator(Iterator<OtherConst> const& other) : _table(other._table), _index(other._index) { }
+
+            reference operator*() const { return _table->_slots[_index]; }
+            pointer operator->() const { return &_table->_slots[_index]; }
+
+            Iterator& operator++()
+            {
+                _index = _table->NextFull(_index + 1);
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator itr = *this;
+                ++*this;
+                return itr;
+            }
+
+            template<bool OtherConst>
+            bool operator==(Iterator<OtherConst> const& right) const { return _index == right._index; }
+            template<bool OtherConst>
+            bool operator!=(Iterator<OtherConst> const& right) const { return _index != right._index; }
+
+        private:
+            template<bool> friend class Iterator;
+
+            Table* _table;
+            std::size_t _index;
+        };
+
+        using const_iterator = Iterator<true>;
+        using iterator = std::conditional_t<ConstIterators, const_iterator, Iterator<false>>;
+
+        GuidHashTable() : _size(0), _deleted(0) { }
+
+        iterator begin() { return iterator(Iterator<false>(this, NextFull(0))); }
+        iterator end() { return iterator(Iterator<false>(this, _ctrl.size())); }
+        const_iterator begin() const { return const_iterator(this, NextFull(0)); }
+        const_iterator end() const { return const_iterator(this, _ctrl.size()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        bool empty() const { return _size == 0; }
+        size_type size() const { return _size; }
+        size_type capacity() const { return _ctrl.size(); }
+
+        void clear()
+        {
+            if (!_size && !_deleted)
+                return;
+
+            for (std::size_t i = 0; i < _ctrl.size(); ++i)
+            {
+                if (IsFull(_ctrl[i]))
+                    _slots[i] = Value();
+                _ctrl[i] = CtrlEmpty;
+            }
+
+            _size = 0;
+            _deleted = 0;
+        }
+
+        void reserve(size_type count)
+        {
+            std::size_t capacity = CapacityFor(count);
+            if (capacity > _ctrl.size())
+                Rehash(capacity);
+        }
+
+        iterator find(ObjectGuid const& key)
+        {
+            return iterator(Iterator<false>(this, Find(key)));
+        }
+
+        const_iterator find(ObjectGuid const& key) const
+        {
+            return const_iterator(this, Find(key));
+        }
+
+        size_type count(ObjectGuid const& key) const { return Find(key) != _ctrl.size() ? 1 : 0; }
+        bool contains(ObjectGuid const& key) const { return Find(key) != _ctrl.size(); }
+
+        size_type erase(ObjectGuid const& key)
+        {
+            std::size_t index = Find(key);
+            if (index == _ctrl.size())
+                return 0;
+
+            EraseAt(index);
+            return 1;
+        }
+
+        iterator erase(const_iterator itr)
+        {
+            EraseAt(itr._index);
+            return iterator(Iterator<false>(this, NextFull(itr._index + 1)));
+        }
+
+    protected:
+        // returns the slot of key, inserting a default constructed value for it when missing
+        std::pair<std::size_t, bool> FindOrPrepareInsert(ObjectGuid const& key)
+        {
+            std::size_t hash = key.GetHash();
+            std::size_t existing = Find(key, hash);
+            if (existing != _ctrl.size())
+                return { existing, false };
+
+            if ((_size + _deleted + 1) * 8 > _ctrl.size() * 7)
+                Rehash(CapacityFor(_size + 1));
+
+            std::size_t index = FindInsertSlot(hash);
+            if (_ctrl[index] == CtrlDeleted)
+                --_deleted;
+
+            _ctrl[index] = H2(hash);
+            ++_size;
+            return { index, true };
+        }
+
+        Value& SlotAt(std::size_t index) { return _slots[index]; }
+
+        iterator MakeIterator(std::size_t index) { return iterator(Iterator<false>(this, index)); }
+
+    private:
+        static bool IsFull(uint8 ctrl) { return (ctrl & 0x80) == 0; }
+        static uint8 H2(std::size_t hash) { return uint8(hash >> (sizeof(std::size_t) * 8 - 7)); }
+
+        // keeps the load factor (tombstones included) below 7/8
+        static std::size_t CapacityFor(std::size_t count)
+        {
+            std::size_t capacity = MinCapacity;
+            while (count * 8 > capacity * 7)
+                capacity *= 2;
+            return capacity;
+        }
+
+        std::size_t NextFull(std::size_t index) const
+        {
+            while (index < _ctrl.size() && !IsFull(_ctrl[index]))
+                ++index;
+            return index;
+        }
+
+        std::size_t Find(ObjectGuid const& key) const
+        {
+            return Find(key, key.GetHash());
+        }
+
+        std::size_t Find(ObjectGuid const& key, std::size_t hash) const
+        {
+            if (!_size)
+                return _ctrl.size();
+
+            std::size_t mask = _ctrl.size() - 1;
+            uint8 h2 = H2(hash);
+            for (std::size_t index = hash & mask; ; index = (index + 1) & mask)
+            {
+                uint8 ctrl = _ctrl[index];
+                if (ctrl == CtrlEmpty)
+                    return _ctrl.size();
+
+                if (ctrl == h2 && KeyOf::Get(_slots[index]) == key)
+                    return index;
+            }
+        }
+
+        std::size_t FindInsertSlot(std::size_t hash) const
+        {
+            std::size_t mask = _ctrl.size() - 1;
+            std::size_t index = hash & mask;
+            while (IsFull(_ctrl[index]))
+                index = (index + 1) & mask;
+            return index;
+        }
+
+        void EraseAt(std::size_t index)
+        {
+            _slots[index] = Value();
+            --_size;
+
+            // a slot followed by an empty one ends every probe sequence passing through it, no tombstone needed
+            if (_ctrl[(index + 1) & (_ctrl.size() - 1)] == CtrlEmpty)
+                _ctrl[index] = CtrlEmpty;
+            else
+            {
+                _ctrl[index] = CtrlDeleted;
+                ++_deleted;
+            }
+        }
+
+        void Rehash(std::size_t capacity)
+        {
+            std::vector<uint8> oldCtrl(capacity, CtrlEmpty);
+            std::vector<Value> oldSlots(capacity);
+            oldCtrl.swap(_ctrl);
+            oldSlots.swap(_slots);
+            _deleted = 0;
+
+            for (std::size_t i = 0; i < oldCtrl.size(); ++i)
+            {
+                if (!IsFull(oldCtrl[i]))
+                    continue;
+
+                std::size_t hash = KeyOf::Get(oldSlots[i]).GetHash();
+                std::size_t index = FindInsertSlot(hash);
+                _ctrl[index] = H2(hash);
+                _slots[index] = std::move(oldSlots[i]);
+            }
+        }
+
+        std::vector<uint8> _ctrl;
+        std::vector<Value> _slots;
+        std::size_t _size;
+        std::size_t _deleted;
+    };
+}
+
+    /// Drop-in replacement for std::unordered_set<ObjectGuid> (GuidUnorderedSet), see Impl::GuidHashTable for iterator rules
+    class GuidHashSet : public Impl::GuidHashTable<ObjectGuid, Impl::GuidSetKeyOf, true>
+    {
+    public:
+        std::pair<iterator, bool> insert(ObjectGuid const& key)
+        {
+            std::pair<std::size_t, bool> result = FindOrPrepareInsert(key);
+            if (result.second)
+                SlotAt(result.first) = key;
+
+            return { MakeIterator(result.first), result.second };
+        }
+
+        std::pair<iterator, bool> emplace(ObjectGuid const& key) { return insert(key); }
+    };
+
+    /// Drop-in replacement for std::unordered_map<ObjectGuid, T>, see Impl::GuidHashTable for iterator rules
+    /// value_type is std::pair<ObjectGuid, T> (the key is not const, do not modify it through iterators)
+    template<class T>
+    class GuidHashMap : public Impl::GuidHashTable<std::pair<ObjectGuid, T>, Impl::GuidMapKeyOf, false>
+    {
+        using Base = Impl::GuidHashTable<std::pair<ObjectGuid, T>, Impl::GuidMapKeyOf, false>;
+
+    public:
+        using mapped_type = T;
+        using typename Base::iterator;
+
+        T& operator[](ObjectGuid const& key)
+        {
+            std::pair<std::size_t, bool> result = this->FindOrPrepareInsert(key);
+            std::pair<ObjectGuid, T>& slot = this->SlotAt(result.first);
+            if (result.second)
+                slot.first = key;
+
+            return slot.second;
+        }
+
+        template<class... Args>
+        std::pair<iterator, bool> emplace(ObjectGuid const& key, Args&&... args)
+        {
+            std::pair<std::size_t, bool> result = this->FindOrPrepareInsert(key);
+            if (result.second)
+            {
+                std::pair<ObjectGuid, T>& slot = this->SlotAt(result.first);
+                slot.first = key;
+                slot.second = T(std::forward<Args>(args)...);
+            }
+
+            return { this->MakeIterator(result.first), result.second };
+        }
+
+        std::pair<iterator, bool> insert(std::pair<ObjectGuid, T> const& value) { return emplace(value.first, value.second); }
+    };
+}
+
+#endif // TRINITY_GUIDHASHCONTAINERS_H
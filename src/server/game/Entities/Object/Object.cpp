@@ -185,10 +185,59 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
     buf << uint8(objectType);
 
     BuildMovementUpdate(&buf, flags, target);
-    BuildValuesCreate(&buf, target);
+    BuildValuesCreateForPlayer(&buf, target);
     data->AddUpdateBlock(buf);
 }
 
+// values create blocks serialized for earlier receivers of the current field values
+struct ValuesCreateBlockCache
+{
+    static constexpr std::size_t MaxBlocks = 4;
+
+    struct Block
+    {
+        UF::UpdateFieldFlag Flags;
+        std::vector<uint32> ViewerDependentValues;
+        ByteBuffer Data;
+    };
+
+    std::vector<Block> Blocks;
+};
+
+void Object::BuildValuesCreateForPlayer(ByteBuffer* data, Player const* target) const
+{
+    // owners receive private fields (and players their own active player data), never share those
+    UF::UpdateFieldFlag flags = GetUpdateFieldFlagsFor(target);
+    std::vector<uint32> viewerDependentValues;
+    if ((flags & UF::UpdateFieldFlag::Owner) != UF::UpdateFieldFlag::None || !GetViewerDependentCreateValues(target, viewerDependentValues))
+    {
+        BuildValuesCreate(data, target);
+        return;
+    }
+
+    if (!m_valuesCreateBlockCache)
+        m_valuesCreateBlockCache = std::make_unique<ValuesCreateBlockCache>();
+
+    std::vector<ValuesCreateBlockCache::Block>& blocks = m_valuesCreateBlockCache->Blocks;
+    auto block = std::find_if(blocks.begin(), blocks.end(), [&](ValuesCreateBlockCache::Block const& cached)
+    {
+        return cached.Flags == flags && cached.ViewerDependentValues == viewerDependentValues;
+    });
+
+    if (block == blocks.end())
+    {
+        // mostly one block per viewer class, a full cache means the values differ for nearly every receiver
+        if (blocks.size() >= ValuesCreateBlockCache::MaxBlocks)
+            blocks.erase(blocks.begin());
+
+        ByteBuffer buffer(0x200, ByteBuffer::Reserve{});
+        BuildValuesCreate(&buffer, target);
+        block = blocks.insert(blocks.end(), { flags, std::move(viewerDependentValues), std::move(buffer) });
+    }
+
+    data->append(block->Data);
+}
+
 void Object::SendUpdateToPlayer(Player* player)
 {
     // send create update to player
@@ -743,6 +792,10 @@ void Object::BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag /*f
 
 void Object::AddToObjectUpdateIfNeeded()
 {
+    // every update field setter ends up here, cached create blocks no longer match the field values
+    if (m_valuesCreateBlockCache)
+        m_valuesCreateBlockCache->Blocks.clear();
+
     if (m_inWorld && !m_objectUpdated)
         m_objectUpdated = AddToObjectUpdate();
 }
@@ -759,7 +812,13 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+// values update blocks serialized for one object during a single BuildUpdate, keyed by receiver flags
+struct ValuesUpdateBlockCache
+{
+    std::vector<std::pair<UF::UpdateFieldFlag, ByteBuffer>> Blocks;
+};
+
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -770,7 +829,34 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (!cache)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    // owners receive private fields (and players their own active player data), never share those
+    UF::UpdateFieldFlag flags = GetUpdateFieldFlagsFor(player);
+    if ((flags & UF::UpdateFieldFlag::Owner) != UF::UpdateFieldFlag::None)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    auto block = std::find_if(cache->Blocks.begin(), cache->Blocks.end(), [flags](std::pair<UF::UpdateFieldFlag, ByteBuffer> const& cached)
+    {
+        return cached.first == flags;
+    });
+
+    if (block == cache->Blocks.end())
+    {
+        ByteBuffer buf = PrepareValuesUpdateBuffer();
+        BuildValuesUpdate(&buf, player);
+        cache->Blocks.emplace_back(flags, std::move(buf));
+        block = std::prev(cache->Blocks.end());
+    }
+
+    iter->second.AddUpdateBlock(block->second);
 }
 
 std::string Object::GetDebugInfo() const
@@ -818,6 +904,7 @@ void MovementInfo::OutDebug()
 WorldObject::WorldObject(bool isWorldObject) : Object(), WorldLocation(), LastUsedScriptID(0),
 m_movementInfo(), m_name(), m_isActive(false), m_isFarVisible(false), m_isWorldObject(isWorldObject), m_zoneScript(nullptr),
 m_transport(nullptr), m_zoneId(0), m_areaId(0), m_staticFloorZ(VMAP_INVALID_HEIGHT), m_outdoors(false), m_liquidStatus(LIQUID_MAP_NO_WATER),
+_terrainStatusMap(nullptr), _terrainStatusTerrainMapId(0), _terrainStatusCollisionHeight(0.0f),
 m_currMap(nullptr), m_InstanceId(0), _dbPhase(0), m_notifyflags(0)
 {
     m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE | GHOST_VISIBILITY_GHOST);
@@ -904,9 +991,24 @@ void WorldObject::CleanupsBeforeDelete(bool /*finalCleanup*/)
 
 void WorldObject::UpdatePositionData()
 {
-    PositionFullTerrainStatus data;
-    GetMap()->GetFullTerrainStatusForPosition(_phaseShift, GetPositionX(), GetPositionY(), GetPositionZ(), data, map_liquidHeaderTypeFlags::AllLiquids, GetCollisionHeight());
-    ProcessPositionDataChanged(data);
+    Map* map = GetMap();
+    float collisionHeight = GetCollisionHeight();
+    uint32 terrainMapId = PhasingHandler::GetTerrainMapId(_phaseShift, map, GetPositionX(), GetPositionY());
+
+    // turning in place or tiny corrections reuse the last query, its area, floor and liquid cannot have changed meaningfully
+    if (!_terrainStatus || _terrainStatusMap != map || _terrainStatusTerrainMapId != terrainMapId || _terrainStatusCollisionHeight != collisionHeight
+        || GetExactDistSq(_terrainStatusPosition) > TERRAIN_STATUS_CACHE_DISTANCE * TERRAIN_STATUS_CACHE_DISTANCE
+        || Trinity::ComputeCellCoord(GetPositionX(), GetPositionY()) != Trinity::ComputeCellCoord(_terrainStatusPosition.GetPositionX(), _terrainStatusPosition.GetPositionY()))
+    {
+        _terrainStatus = std::make_unique<PositionFullTerrainStatus>();
+        map->GetFullTerrainStatusForPosition(_phaseShift, GetPositionX(), GetPositionY(), GetPositionZ(), *_terrainStatus, map_liquidHeaderTypeFlags::AllLiquids, collisionHeight);
+        _terrainStatusPosition.Relocate(GetPositionX(), GetPositionY(), GetPositionZ());
+        _terrainStatusMap = map;
+        _terrainStatusTerrainMapId = terrainMapId;
+        _terrainStatusCollisionHeight = collisionHeight;
+    }
+
+    ProcessPositionDataChanged(*_terrainStatus);
 }
 
 void WorldObject::ProcessPositionDataChanged(PositionFullTerrainStatus const& data)
@@ -1095,6 +1197,40 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks che
     if (!IsInMap(obj))
         return false;
 
+    VMAP::LineOfSightSegment segment = GetLineOfSightSegmentTo(obj);
+    return GetMap()->isInLineOfSight(GetPhaseShift(), segment.X1, segment.Y1, segment.Z1, segment.X2, segment.Y2, segment.Z2, checks, ignoreFlags);
+}
+
+std::vector<bool> WorldObject::IsWithinLOSInMap(std::vector<WorldObject const*> const& targets, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    std::vector<bool> results(targets.size(), false);
+    std::vector<VMAP::LineOfSightSegment> segments;
+    std::vector<std::size_t> segmentIndexes;
+    segments.reserve(targets.size());
+    segmentIndexes.reserve(targets.size());
+
+    for (std::size_t i = 0; i < targets.size(); ++i)
+    {
+        if (!IsInMap(targets[i]))
+            continue;
+
+        segments.push_back(GetLineOfSightSegmentTo(targets[i]));
+        segmentIndexes.push_back(i);
+    }
+
+    if (segments.empty())
+        return results;
+
+    GetMap()->isInLineOfSight(GetPhaseShift(), segments, checks, ignoreFlags);
+
+    for (std::size_t i = 0; i < segments.size(); ++i)
+        results[segmentIndexes[i]] = segments[i].InLineOfSight;
+
+    return results;
+}
+
+VMAP::LineOfSightSegment WorldObject::GetLineOfSightSegmentTo(WorldObject const* obj) const
+{
     float ox, oy, oz;
     if (obj->GetTypeId() == TYPEID_PLAYER)
     {
@@ -1113,7 +1249,7 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks che
     else
         GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, x, y, z);
 
-    return GetMap()->isInLineOfSight(GetPhaseShift(), x, y, z, ox, oy, oz, checks, ignoreFlags);
+    return VMAP::LineOfSightSegment(x, y, z, ox, oy, oz);
 }
 
 void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const
@@ -1663,16 +1799,21 @@ void WorldObject::SendMessageToSet(WorldPacket const* data, Player const* skippe
 
 struct CombatLogSender
 {
-    WorldPackets::CombatLog::CombatLogServerPacket const* i_message;
+    WorldPackets::CombatLog::CombatLogServerPacket* i_message;
+    bool i_written;
 
     explicit CombatLogSender(WorldPackets::CombatLog::CombatLogServerPacket* msg)
-        : i_message(msg)
-    {
-        msg->Write();
-    }
+        : i_message(msg), i_written(false) { }
 
-    void operator()(Player const* player) const
+    void operator()(Player const* player)
     {
+        // serialized once, on first receiver - most fights between creatures have nobody watching
+        if (!i_written)
+        {
+            i_message->Write();
+            i_written = true;
+        }
+
         if (player->IsAdvancedCombatLoggingEnabled())
             player->SendDirectMessage(i_message->GetFullLogPacket());
         else
@@ -1687,8 +1828,12 @@ void WorldObject::SendCombatLogMessage(WorldPackets::CombatLog::CombatLogServerP
     if (Player const* self = ToPlayer())
         combatLogSender(self);
 
-    Trinity::MessageDistDeliverer<CombatLogSender> notifier(this, combatLogSender, GetVisibilityRange());
-    Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
+    float range = GetVisibilityRange();
+    if (float combatLogRange = sWorld->getFloatConfig(CONFIG_LISTEN_RANGE_COMBAT_LOG))
+        range = std::min(range, combatLogRange);
+
+    Trinity::MessageDistDeliverer<CombatLogSender> notifier(this, combatLogSender, range);
+    Cell::VisitWorldObjects(this, notifier, range);
 }
 
 void WorldObject::SetMap(Map* map)
@@ -1716,6 +1861,7 @@ void WorldObject::ResetMap()
     if (IsWorldObject())
         m_currMap->RemoveWorldObject(this);
     m_currMap = nullptr;
+    _terrainStatusMap = nullptr;
     //maybe not for corpse
     //m_mapId = 0;
     //m_InstanceId = 0;
@@ -3468,7 +3614,9 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     GuidSet plr_list;
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
+    ValuesUpdateBlockCache i_blockCache;
+    bool i_shareBlocks;
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj), i_shareBlocks(!obj.HasViewerDependentChanges()) { }
     void Visit(PlayerMapType &m)
     {
         Player* source = nullptr;
@@ -3525,12 +3673,12 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_shareBlocks ? &i_blockCache : nullptr);
             plr_list.insert(player->GetGUID());
         }
     }
 
-    template<class SKIP> void Visit(GridRefManager<SKIP> &) { }
+    template<class SKIP> void Visit(GridObjectContainer<SKIP> &) { }
 };
 
 void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
@@ -21,8 +21,7 @@
 #include "Common.h"
 #include "Duration.h"
 #include "EventProcessor.h"
-#include "GridReference.h"
-#include "GridRefManager.h"
+#include "GridObjectContainer.h"
 #include "ModelIgnoreFlags.h"
 #include "MovementInfo.h"
 #include "ObjectDefines.h"
@@ -34,6 +33,7 @@
 #include "SpellDefines.h"
 #include "UpdateFields.h"
 #include <list>
+#include <memory>
 #include <unordered_map>
 
 class AreaTrigger;
@@ -64,8 +64,15 @@ class ZoneScript;
 struct FactionTemplateEntry;
 struct PositionFullTerrainStatus;
 struct QuaternionData;
+struct ValuesCreateBlockCache;
+struct ValuesUpdateBlockCache;
 enum ZLiquidStatus : uint32;
 
+namespace VMAP
+{
+    struct LineOfSightSegment;
+}
+
 namespace WorldPackets
 {
     namespace CombatLog
@@ -193,7 +200,15 @@ class TC_GAME_API Object
         bool IsDestroyedObject() const { return m_isDestroyedObject; }
         void SetDestroyedObject(bool destroyed) { m_isDestroyedObject = destroyed; }
         virtual void BuildUpdate(UpdateDataMapType&) { }
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateBlockCache* cache = nullptr) const;
+
+        // true if pending changes contain fields whose value depends on the receiver (ViewerDependentValues.h)
+        // values update blocks can only be shared between receivers when this returns false
+        virtual bool HasViewerDependentChanges() const { return true; }
+
+        // collects the receiver dependent values BuildValuesCreate writes for target, create blocks are reused
+        // between receivers with equal update field flags and equal values. false if the block can never be reused
+        virtual bool GetViewerDependentCreateValues(Player const* /*target*/, std::vector<uint32>& /*values*/) const { return false; }
 
         inline bool IsPlayer() const { return GetTypeId() == TYPEID_PLAYER; }
         static Player* ToPlayer(Object* o) { return o ? o->ToPlayer() : nullptr; }
@@ -374,6 +389,7 @@ class TC_GAME_API Object
         void BuildMovementUpdate(ByteBuffer* data, CreateObjectBits flags, Player* target) const;
         virtual UF::UpdateFieldFlag GetUpdateFieldFlagsFor(Player const* target) const;
         virtual void BuildValuesCreate(ByteBuffer* data, Player const* target) const = 0;
+        void BuildValuesCreateForPlayer(ByteBuffer* data, Player const* target) const;
         virtual void BuildValuesUpdate(ByteBuffer* data, Player const* target) const = 0;
 
     public:
@@ -397,6 +413,9 @@ class TC_GAME_API Object
         bool m_isNewObject;
         bool m_isDestroyedObject;
 
+        // values create blocks serialized for previous receivers, dropped whenever an update field changes
+        mutable std::unique_ptr<ValuesCreateBlockCache> m_valuesCreateBlockCache;
+
         Object(Object const& right) = delete;
         Object& operator=(Object const& right) = delete;
 };
@@ -408,10 +427,15 @@ class GridObject
         virtual ~GridObject() { }
 
         bool IsInGrid() const { return _gridRef.isValid(); }
-        void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
+        void AddToGrid(GridObjectContainer<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
         void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+#ifdef TRINITY_DENSE_GRID_STORAGE
+        void UpdateGridPosition() { _gridRef.updatePosition(); }
+#else
+        void UpdateGridPosition() { }
+#endif
     private:
-        GridReference<T> _gridRef;
+        GridObjectReference<T> _gridRef;
 };
 
 template <class T_VALUES, class T_FLAGS, class FLAG_TYPE, size_t ARRAY_SIZE>
@@ -520,6 +544,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        // same as IsWithinLOSInMap for every object in targets, checked as one batch
+        std::vector<bool> IsWithinLOSInMap(std::vector<WorldObject const*> const& targets, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
         bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
@@ -749,6 +775,13 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool m_outdoors;
         ZLiquidStatus m_liquidStatus;
 
+        // last GetFullTerrainStatusForPosition result and where it was queried, see UpdatePositionData
+        std::unique_ptr<PositionFullTerrainStatus> _terrainStatus;
+        Position _terrainStatusPosition;
+        Map const* _terrainStatusMap;
+        uint32 _terrainStatusTerrainMapId;
+        float _terrainStatusCollisionHeight;
+
         //these functions are used mostly for Relocate() and Corpse/Player specific stuff...
         //use them ONLY in LoadFromDB()/Create() funcs and nowhere else!
         //mapId/instanceId should be set in SetMap() function!
@@ -775,6 +808,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         std::unique_ptr<SmoothPhasing> _smoothPhasing;
 
         virtual bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D, bool incOwnRadius = true, bool incTargetRadius = true) const;
+        VMAP::LineOfSightSegment GetLineOfSightSegmentTo(WorldObject const* obj) const;
 
         bool CanNeverSee(WorldObject const* obj) const;
         virtual bool CanAlwaysSee(WorldObject const* /*obj*/) const { return false; }
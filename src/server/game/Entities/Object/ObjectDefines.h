@@ -25,6 +25,7 @@
 #define ATTACK_DISTANCE                 5.0f
 #define INSPECT_DISTANCE                28.0f
 #define TRADE_DISTANCE                  11.11f
+#define TERRAIN_STATUS_CACHE_DISTANCE   0.2f                    // moves shorter than this reuse the last terrain status query
 #define MAX_VISIBILITY_DISTANCE         SIZE_OF_GRIDS           // max distance for visible objects
 #define SIGHT_RANGE_UNIT                50.0f
 #define VISIBILITY_DISTANCE_GIGANTIC    400.0f
@@ -18,7 +18,6 @@
 #include "ObjectGuid.h"
 #include "ByteBuffer.h"
 #include "Errors.h"
-#include "Hash.h"
 #include "Log.h"
 #include "Realm.h"
 #include "Util.h"
@@ -506,14 +505,6 @@ ObjectGuid ObjectGuid::FromString(std::string const& guidString)
     return Info.Parse(guidString);
 }
 
-std::size_t ObjectGuid::GetHash() const
-{
-    std::size_t hashVal = 0;
-    Trinity::hash_combine(hashVal, _data[0]);
-    Trinity::hash_combine(hashVal, _data[1]);
-    return hashVal;
-}
-
 std::vector<uint8> ObjectGuid::GetRawValue() const
 {
     std::vector<uint8> raw(16);
@@ -337,7 +337,15 @@ class TC_GAME_API ObjectGuid
         std::string ToString() const;
         std::string ToHexString() const;
         static ObjectGuid FromString(std::string const& guidString);
-        std::size_t GetHash() const;
+
+        // multiplicative mix of both halves, the high bits of the result are as good as the low ones
+        // (GuidHashSet/GuidHashMap use both), unlike std::hash<uint64> which is the identity on most implementations
+        std::size_t GetHash() const
+        {
+            uint64 hash = (_data[0] ^ (_data[1] * UI64LIT(0x9E3779B97F4A7C15))) * UI64LIT(0xBF58476D1CE4E5B9);
+            hash ^= hash >> 31;
+            return std::size_t(hash ^ (hash >> 32));
+        }
 
         template<HighGuid type> static std::enable_if_t<ObjectGuidTraits<type>::Format::value == ObjectGuidFormatType::Null, ObjectGuid> Create() { return ObjectGuidFactory::CreateNull(); }
         template<HighGuid type> static std::enable_if_t<ObjectGuidTraits<type>::Format::value == ObjectGuidFormatType::Uniq, ObjectGuid> Create(ObjectGuid::LowType id) { return ObjectGuidFactory::CreateUniq(id); }
@@ -17,10 +17,16 @@
 
 #include "UpdateData.h"
 #include "Errors.h"
+#include "MemoryAccounting.h"
 #include "WorldPacket.h"
 #include "Opcodes.h"
 
-UpdateData::UpdateData(uint32 map) : m_map(map), m_blockCount(0) { }
+UpdateData::UpdateData(uint32 map) : m_map(map), m_blockCount(0), m_accountedBytes(0) { }
+
+UpdateData::~UpdateData()
+{
+    Trinity::MemoryAccounting::Released(Trinity::MemoryCategory::UpdateData, m_accountedBytes);
+}
 
 void UpdateData::AddDestroyObject(ObjectGuid guid)
 {
@@ -41,6 +47,9 @@ void UpdateData::AddUpdateBlock(ByteBuffer const& block)
 {
     m_data.append(block);
     ++m_blockCount;
+
+    Trinity::MemoryAccounting::Allocated(Trinity::MemoryCategory::UpdateData, m_data.size() - m_accountedBytes);
+    m_accountedBytes = m_data.size();
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -70,6 +79,9 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
 void UpdateData::Clear()
 {
+    Trinity::MemoryAccounting::Released(Trinity::MemoryCategory::UpdateData, m_accountedBytes);
+    m_accountedBytes = 0;
+
     m_data.clear();
     m_destroyGUIDs.clear();
     m_outOfRangeGUIDs.clear();
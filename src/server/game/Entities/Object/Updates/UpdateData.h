@@ -39,9 +39,11 @@ class UpdateData
         UpdateData(uint32 map);
         UpdateData(UpdateData&& right) : m_map(right.m_map), m_blockCount(right.m_blockCount),
             m_outOfRangeGUIDs(std::move(right.m_outOfRangeGUIDs)),
-            m_data(std::move(right.m_data))
+            m_data(std::move(right.m_data)), m_accountedBytes(right.m_accountedBytes)
         {
+            right.m_accountedBytes = 0;
         }
+        ~UpdateData();
 
         void AddDestroyObject(ObjectGuid guid);
         void AddOutOfRangeGUID(GuidSet& guids);
@@ -59,6 +61,7 @@ class UpdateData
         GuidSet m_destroyGUIDs;
         GuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
+        std::size_t m_accountedBytes;                       // size of m_data reported to MemoryAccounting
 
         UpdateData(UpdateData const& right) = delete;
         UpdateData& operator=(UpdateData const& right) = delete;
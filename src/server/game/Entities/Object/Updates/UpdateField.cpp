@@ -24,8 +24,7 @@ void UF::WriteDynamicFieldUpdateMask(std::size_t size, std::vector<uint32> const
     if (size > 32)
     {
         if (data.HasUnfinishedBitPack())
-            for (std::size_t block = 0; block < size / 32; ++block)
-                data.WriteBits(updateMask[block], 32);
+            data.WriteBits(updateMask.data(), size / 32, 32);
         else
             for (std::size_t block = 0; block < size / 32; ++block)
                 data << uint32(updateMask[block]);
@@ -576,6 +576,22 @@ namespace UF
             _changesMask.Reset(Bit);
         }
 
+        template<typename Derived, typename T, uint32 BlockBit, uint32 Bit>
+        bool HasChanged(UpdateField<T, BlockBit, Bit>(Derived::*)) const
+        {
+            static_assert(std::is_base_of<Base, Derived>::value, "Given field argument must belong to the same structure as this HasChangesMask");
+
+            return _changesMask[Bit];
+        }
+
+        template<typename Derived, typename T, std::size_t Size, uint32 Bit, uint32 FirstElementBit>
+        bool HasChanged(UpdateFieldArray<T, Size, Bit, FirstElementBit>(Derived::*)) const
+        {
+            static_assert(std::is_base_of<Base, Derived>::value, "Given field argument must belong to the same structure as this HasChangesMask");
+
+            return _changesMask[Bit];
+        }
+
         Mask const& GetChangesMask() const { return _changesMask; }
 
     protected:
@@ -588,10 +604,13 @@ namespace UF
         template<typename T, uint32 BlockBit, uint32 Bit>
         void ClearChangesMask(UpdateField<T, BlockBit, Bit>&, std::false_type) { }
 
+        // nested structures are only modified through ModifyValue, which always marks their bit in the parent
+        // so structures without their bit set have nothing to clear
         template<typename T, uint32 BlockBit, uint32 Bit>
         void ClearChangesMask(UpdateField<T, BlockBit, Bit>& field, std::true_type)
         {
-            field._value.ClearChangesMask();
+            if (_changesMask[Bit])
+                field._value.ClearChangesMask();
         }
 
         template<typename T, std::size_t Size, uint32 Bit, uint32 FirstElementBit>
@@ -606,8 +625,13 @@ namespace UF
         template<typename T, std::size_t Size, uint32 Bit, uint32 FirstElementBit>
         void ClearChangesMask(UpdateFieldArray<T, Size, Bit, FirstElementBit>& field, std::true_type)
         {
-            for (uint32 i = 0; i < Size; ++i)
-                field._values[i].ClearChangesMask();
+            if (!_changesMask[Bit])
+                return;
+
+            _changesMask.ForEachSetBit(FirstElementBit, Size, [&](uint32 index)
+            {
+                field._values[index].ClearChangesMask();
+            });
         }
 
         template<typename T, uint32 BlockBit, uint32 Bit>
@@ -623,8 +647,17 @@ namespace UF
         template<typename T, uint32 BlockBit, uint32 Bit>
         void ClearChangesMask(DynamicUpdateField<T, BlockBit, Bit>& field, std::true_type)
         {
-            for (uint32 i = 0; i < field._values.size(); ++i)
-                field._values[i].ClearChangesMask();
+            if (!_changesMask[Bit])
+                return;
+
+            for (std::size_t block = 0; block < field._updateMask.size(); ++block)
+            {
+                UpdateMaskHelpers::ForEachSetBit(field._updateMask[block], uint32(block * 32), [&](uint32 index)
+                {
+                    if (index < field._values.size())
+                        field._values[index].ClearChangesMask();
+                });
+            }
         }
 
         template<typename T, uint32 BlockBit, uint32 Bit>
@@ -639,7 +672,7 @@ namespace UF
         template<typename T, uint32 BlockBit, uint32 Bit>
         void ClearChangesMask(OptionalUpdateField<T, BlockBit, Bit>& field, std::true_type)
         {
-            if (field.has_value())
+            if (_changesMask[Bit] && field.has_value())
                 field._value->ClearChangesMask();
         }
 
@@ -663,6 +696,10 @@ namespace UF
         template<typename Derived, typename T, uint32 BlockBit, uint32 Bit>
         void ClearChangesMask(UpdateField<T, BlockBit, Bit>(Derived::* field))
         {
+            // every ModifyValue sets this bit, nothing else in the data block can be dirty without it
+            if (!_changesMask[Bit])
+                return;
+
             _changesMask.Reset(Bit);
             (static_cast<Derived*>(_owner)->*field)._value.ClearChangesMask();
         }
@@ -20,11 +20,34 @@
 
 #include "Define.h"
 #include <algorithm>
+#if TRINITY_COMPILER == TRINITY_COMPILER_MICROSOFT
+#include <intrin.h>
+#endif
 
 namespace UpdateMaskHelpers
 {
     inline constexpr std::size_t GetBlockIndex(std::size_t bit) { return bit / 32u; }
     inline constexpr uint32 GetBlockFlag(std::size_t bit) { return 1u << (bit % 32u); }
+
+    // value must not be 0
+    inline uint32 GetLowestSetBit(uint32 value)
+    {
+#if TRINITY_COMPILER == TRINITY_COMPILER_MICROSOFT
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return uint32(index);
+#else
+        return uint32(__builtin_ctz(value));
+#endif
+    }
+
+    // calls callback with the index of every set bit of block, lowest first
+    template<typename Callback>
+    inline void ForEachSetBit(uint32 block, uint32 firstBit, Callback&& callback)
+    {
+        for (; block; block &= block - 1)
+            callback(firstBit + GetLowestSetBit(block));
+    }
 }
 
 template<uint32 Bits>
@@ -60,6 +83,23 @@ public:
         return (_blocks[index / 32] & (1 << (index % 32))) != 0;
     }
 
+    // calls callback with the offset from first of every set bit in [first, first + count), skipping empty blocks
+    template<typename Callback>
+    void ForEachSetBit(uint32 first, uint32 count, Callback&& callback) const
+    {
+        uint32 end = first + count;
+        for (uint32 blockIndex = first / 32; blockIndex < BlockCount && blockIndex * 32 < end; ++blockIndex)
+        {
+            uint32 block = _blocks[blockIndex];
+            if (blockIndex == first / 32)
+                block &= 0xFFFFFFFF << (first % 32);
+            if ((blockIndex + 1) * 32 > end)
+                block &= 0xFFFFFFFF >> ((blockIndex + 1) * 32 - end);
+
+            UpdateMaskHelpers::ForEachSetBit(block, blockIndex * 32 - first, callback);
+        }
+    }
+
     bool IsAnySet() const
     {
         return std::any_of(std::begin(_blocksMask), std::end(_blocksMask), [](uint32 blockMask)
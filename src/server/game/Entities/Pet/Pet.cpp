@@ -458,6 +458,14 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petEntry, uint32 petnumber, bool c
 }
 
 void Pet::SavePetToDB(PetSaveMode mode)
+{
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    SavePetToDB(mode, trans);
+    // same connection as the owner's saves, see Player::SaveToDB
+    CharacterDatabase.CommitTransaction(trans, GetOwnerGUID().GetCounter());
+}
+
+void Pet::SavePetToDB(PetSaveMode mode, CharacterDatabaseTransaction trans)
 {
     if (!GetEntry())
         return;
@@ -487,7 +495,6 @@ void Pet::SavePetToDB(PetSaveMode mode)
     uint32 curhealth = GetHealth();
     uint32 curmana = GetPower(POWER_MANA);
 
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     // save auras before possibly removing them
     _SaveAuras(trans);
 
@@ -501,13 +508,11 @@ void Pet::SavePetToDB(PetSaveMode mode)
 
     _SaveSpells(trans);
     GetSpellHistory()->SaveToDB<Pet>(trans);
-    CharacterDatabase.CommitTransaction(trans);
 
     // current/stable/not_in_slot
     if (mode != PET_SAVE_AS_DELETED)
     {
         ObjectGuid::LowType ownerLowGUID = GetOwnerGUID().GetCounter();
-        trans = CharacterDatabase.BeginTransaction();
         // remove current data
 
         CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_PET_BY_ID);
@@ -539,14 +544,12 @@ void Pet::SavePetToDB(PetSaveMode mode)
         stmt->setUInt8(15, getPetType());
         stmt->setUInt16(16, GetSpecialization());
         trans->Append(stmt);
-
-        CharacterDatabase.CommitTransaction(trans);
     }
     // delete
     else
     {
         RemoveAllAuras();
-        DeleteFromDB(m_charmInfo->GetPetNumber());
+        DeleteFromDB(m_charmInfo->GetPetNumber(), trans);
     }
 }
 
@@ -572,7 +575,12 @@ void Pet::FillPetInfo(PetStable::PetInfo* petInfo) const
 void Pet::DeleteFromDB(uint32 petNumber)
 {
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    DeleteFromDB(petNumber, trans);
+    CharacterDatabase.CommitTransaction(trans);
+}
 
+void Pet::DeleteFromDB(uint32 petNumber, CharacterDatabaseTransaction trans)
+{
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_PET_BY_ID);
     stmt->setUInt32(0, petNumber);
     trans->Append(stmt);
@@ -600,8 +608,6 @@ void Pet::DeleteFromDB(uint32 petNumber)
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PET_SPELL_CHARGES);
     stmt->setUInt32(0, petNumber);
     trans->Append(stmt);
-
-    CharacterDatabase.CommitTransaction(trans);
 }
 
 void Pet::setDeathState(DeathState s)                       // overwrite virtual Creature::setDeathState and Unit::setDeathState
@@ -32,7 +32,6 @@ CinematicMgr::CinematicMgr(Player* playerref)
     m_activeCinematic = nullptr;
     m_activeCinematicCameraIndex = -1;
     m_cinematicLength = 0;
-    m_cinematicCamera = nullptr;
     m_remoteSightPosition = Position(0.0f, 0.0f, 0.0f);
     m_CinematicObject = nullptr;
 }
@@ -53,11 +52,11 @@ void CinematicMgr::NextCinematicCamera()
     if (!cinematicCameraId)
         return;
 
-    if (std::vector<FlyByCamera> const* flyByCameras = GetFlyByCameras(cinematicCameraId))
+    if (std::shared_ptr<FlyByCameraCollection const> flyByCameras = GetFlyByCameras(cinematicCameraId))
     {
         // Initialize diff, and set camera
         m_cinematicDiff = 0;
-        m_cinematicCamera = flyByCameras;
+        m_cinematicCamera = std::move(flyByCameras);
 
         if (!m_cinematicCamera->empty())
         {
@@ -55,7 +55,7 @@ protected:
     CinematicSequencesEntry const* m_activeCinematic;
      int32      m_activeCinematicCameraIndex;
     uint32      m_cinematicLength;
-    std::vector<FlyByCamera> const* m_cinematicCamera;
+    std::shared_ptr<std::vector<FlyByCamera> const> m_cinematicCamera;
     Position    m_remoteSightPosition;
     TempSummon* m_CinematicObject;
 };
@@ -828,13 +828,16 @@ std::unordered_set<ObjectGuid> CollectionMgr::GetItemsProvidingTemporaryAppearan
     return std::unordered_set<ObjectGuid>();
 }
 
-std::unordered_set<uint32> CollectionMgr::GetAppearanceIds() const
+boost::dynamic_bitset<uint32> CollectionMgr::GetAppearanceIds() const
 {
-    std::unordered_set<uint32> appearances;
+    boost::dynamic_bitset<uint32> appearances(sItemAppearanceStore.GetNumRows());
     std::size_t id = _appearances->find_first();
     while (id != boost::dynamic_bitset<uint32>::npos)
     {
-        appearances.insert(sItemModifiedAppearanceStore.AssertEntry(id)->ItemAppearanceID);
+        uint32 appearanceId = sItemModifiedAppearanceStore.AssertEntry(id)->ItemAppearanceID;
+        if (appearanceId < appearances.size())
+            appearances.set(appearanceId);
+
         id = _appearances->find_next(id);
     }
 
@@ -135,8 +135,8 @@ public:
     // returns pair<hasAppearance, isTemporary>
     std::pair<bool, bool> HasItemAppearance(uint32 itemModifiedAppearanceId) const;
     std::unordered_set<ObjectGuid> GetItemsProvidingTemporaryAppearance(uint32 itemModifiedAppearanceId) const;
-    // returns ItemAppearance::ID, not ItemModifiedAppearance::ID
-    std::unordered_set<uint32> GetAppearanceIds() const;
+    // returns ItemAppearance::ID, not ItemModifiedAppearance::ID, as a bitset indexed by id
+    boost::dynamic_bitset<uint32> GetAppearanceIds() const;
 
     enum class FavoriteAppearanceState
     {
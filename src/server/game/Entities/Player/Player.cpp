@@ -169,11 +169,15 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
     m_zoneUpdateId = uint32(-1);
     m_zoneUpdateTimer = 0;
 
+    m_enchantTime = 0;
+
     m_areaUpdateId = 0;
     m_team = 0;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
     m_customizationsChanged = false;
+    m_voidStorageChanged = false;
+    m_CUFProfilesChanged = false;
 
     memset(m_items, 0, sizeof(Item*)*PLAYER_SLOTS_COUNT);
 
@@ -343,7 +347,9 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
     for (uint8 i = 0; i < MAX_CUF_PROFILES; ++i)
         _CUFProfiles[i] = nullptr;
 
-    m_groupUpdateTimer.Reset(5000);
+    // spread the periodic updates of players logging in at the same time over different ticks
+    for (uint8 i = 0; i < MAX_PERIODIC_UPDATES; ++i)
+        m_periodicUpdateElapsed[i] = urand(0, PeriodicUpdates[i].Interval - 1);
 
     _advancedCombatLoggingEnabled = false;
 
@@ -954,8 +960,6 @@ void Player::Update(uint32 p_time)
 
     CheckDuelDistance(now);
 
-    UpdateAfkReport(now);
-
     if (GetCombatManager().HasPvPCombat())
         if (Aura* aura = GetAura(SPELL_PVP_RULES_ENABLED))
             if (!aura->IsPermanent())
@@ -1187,27 +1191,7 @@ void Player::Update(uint32 p_time)
             m_deathTimer -= p_time;
     }
 
-    UpdateEnchantTime(p_time);
-    UpdateHomebindTime(p_time);
-
-    if (!_instanceResetTimes.empty())
-    {
-        for (InstanceTimeMap::iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end();)
-        {
-            if (itr->second < now)
-                _instanceResetTimes.erase(itr++);
-            else
-                ++itr;
-        }
-    }
-
-    // group update
-    m_groupUpdateTimer.Update(p_time);
-    if (m_groupUpdateTimer.Passed())
-    {
-        SendUpdateToOutOfRangeGroupMembers();
-        m_groupUpdateTimer.Reset(5000);
-    }
+    UpdatePeriodic(p_time);
 
     Pet* pet = GetPet();
     if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityRange()) && !pet->isPossessed())
@@ -1232,6 +1216,39 @@ void Player::Update(uint32 p_time)
         TeleportTo(m_teleport_dest, m_teleport_options);
 }
 
+Player::PeriodicUpdateInfo const Player::PeriodicUpdates[MAX_PERIODIC_UPDATES] =
+{
+    { 1 * IN_MILLISECONDS, [](Player* player, uint32 diff) { player->UpdateEnchantTime(diff); } },
+    { 1 * IN_MILLISECONDS, [](Player* player, uint32 diff) { player->UpdateHomebindTime(diff); } },
+    { 1 * IN_MILLISECONDS, [](Player* player, uint32 /*diff*/)
+    {
+        time_t now = GameTime::GetGameTime();
+        for (InstanceTimeMap::iterator itr = player->_instanceResetTimes.begin(); itr != player->_instanceResetTimes.end();)
+        {
+            if (itr->second < now)
+                player->_instanceResetTimes.erase(itr++);
+            else
+                ++itr;
+        }
+    } },
+    { 1 * IN_MILLISECONDS, [](Player* player, uint32 /*diff*/) { player->UpdateAfkReport(GameTime::GetGameTime()); } },
+    { 5 * IN_MILLISECONDS, [](Player* player, uint32 /*diff*/) { player->SendUpdateToOutOfRangeGroupMembers(); } }
+};
+
+void Player::UpdatePeriodic(uint32 diff)
+{
+    for (uint8 i = 0; i < MAX_PERIODIC_UPDATES; ++i)
+    {
+        m_periodicUpdateElapsed[i] += diff;
+        if (m_periodicUpdateElapsed[i] < PeriodicUpdates[i].Interval)
+            continue;
+
+        uint32 elapsed = m_periodicUpdateElapsed[i];
+        m_periodicUpdateElapsed[i] = 0;
+        PeriodicUpdates[i].Handler(this, elapsed);
+    }
+}
+
 void Player::setDeathState(DeathState s)
 {
     bool oldIsAlive = IsAlive();
@@ -3909,7 +3926,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
                 do
                 {
                     uint32 petguidlow = (*resultPets)[0].GetUInt32();
-                    Pet::DeleteFromDB(petguidlow);
+                    Pet::DeleteFromDB(petguidlow, trans);
                 } while (resultPets->NextRow());
             }
 
@@ -5083,79 +5100,49 @@ void Player::GetDodgeFromAgility(float &/*diminishing*/, float &/*nondiminishing
     //nondiminishing = 100.0f * (dodge_base[pclass-1] + base_agility * dodgeRatio->ratio * crit_to_dodge[pclass-1]);
 }
 
+// indexed by CombatRating
+constexpr float GtCombatRatingsEntry::* CombatRatingColumns[MAX_COMBAT_RATING] =
+{
+    &GtCombatRatingsEntry::Amplify,
+    &GtCombatRatingsEntry::DefenseSkill,
+    &GtCombatRatingsEntry::Dodge,
+    &GtCombatRatingsEntry::Parry,
+    &GtCombatRatingsEntry::Block,
+    &GtCombatRatingsEntry::HitMelee,
+    &GtCombatRatingsEntry::HitRanged,
+    &GtCombatRatingsEntry::HitSpell,
+    &GtCombatRatingsEntry::CritMelee,
+    &GtCombatRatingsEntry::CritRanged,
+    &GtCombatRatingsEntry::CritSpell,
+    &GtCombatRatingsEntry::Corruption,
+    &GtCombatRatingsEntry::CorruptionResistance,
+    &GtCombatRatingsEntry::Speed,
+    &GtCombatRatingsEntry::ResilienceCritTaken,
+    &GtCombatRatingsEntry::ResiliencePlayerDamage,
+    &GtCombatRatingsEntry::Lifesteal,
+    &GtCombatRatingsEntry::HasteMelee,
+    &GtCombatRatingsEntry::HasteRanged,
+    &GtCombatRatingsEntry::HasteSpell,
+    &GtCombatRatingsEntry::Avoidance,
+    &GtCombatRatingsEntry::Sturdiness,
+    &GtCombatRatingsEntry::Unused7,
+    &GtCombatRatingsEntry::Expertise,
+    &GtCombatRatingsEntry::ArmorPenetration,
+    &GtCombatRatingsEntry::Mastery,
+    &GtCombatRatingsEntry::PvPPower,
+    &GtCombatRatingsEntry::Cleave,
+    &GtCombatRatingsEntry::VersatilityDamageDone,
+    &GtCombatRatingsEntry::VersatilityHealingDone,
+    &GtCombatRatingsEntry::VersatilityDamageTaken,
+    &GtCombatRatingsEntry::Unused12
+};
+
 inline float GetGameTableColumnForCombatRating(GtCombatRatingsEntry const* row, uint32 rating)
 {
-    switch (rating)
-    {
-        case CR_AMPLIFY:
-            return row->Amplify;
-        case CR_DEFENSE_SKILL:
-            return row->DefenseSkill;
-        case CR_DODGE:
-            return row->Dodge;
-        case CR_PARRY:
-            return row->Parry;
-        case CR_BLOCK:
-            return row->Block;
-        case CR_HIT_MELEE:
-            return row->HitMelee;
-        case CR_HIT_RANGED:
-            return row->HitRanged;
-        case CR_HIT_SPELL:
-            return row->HitSpell;
-        case CR_CRIT_MELEE:
-            return row->CritMelee;
-        case CR_CRIT_RANGED:
-            return row->CritRanged;
-        case CR_CRIT_SPELL:
-            return row->CritSpell;
-        case CR_CORRUPTION:
-            return row->Corruption;
-        case CR_CORRUPTION_RESISTANCE:
-            return row->CorruptionResistance;
-        case CR_SPEED:
-            return row->Speed;
-        case CR_RESILIENCE_CRIT_TAKEN:
-            return row->ResilienceCritTaken;
-        case CR_RESILIENCE_PLAYER_DAMAGE:
-            return row->ResiliencePlayerDamage;
-        case CR_LIFESTEAL:
-            return row->Lifesteal;
-        case CR_HASTE_MELEE:
-            return row->HasteMelee;
-        case CR_HASTE_RANGED:
-            return row->HasteRanged;
-        case CR_HASTE_SPELL:
-            return row->HasteSpell;
-        case CR_AVOIDANCE:
-            return row->Avoidance;
-        case CR_STURDINESS:
-            return row->Sturdiness;
-        case CR_UNUSED_7:
-            return row->Unused7;
-        case CR_EXPERTISE:
-            return row->Expertise;
-        case CR_ARMOR_PENETRATION:
-            return row->ArmorPenetration;
-        case CR_MASTERY:
-            return row->Mastery;
-        case CR_PVP_POWER:
-            return row->PvPPower;
-        case CR_CLEAVE:
-            return row->Cleave;
-        case CR_VERSATILITY_DAMAGE_DONE:
-            return row->VersatilityDamageDone;
-        case CR_VERSATILITY_HEALING_DONE:
-            return row->VersatilityHealingDone;
-        case CR_VERSATILITY_DAMAGE_TAKEN:
-            return row->VersatilityDamageTaken;
-        case CR_UNUSED_12:
-            return row->Unused12;
-        default:
-            break;
-    }
+    if (rating >= MAX_COMBAT_RATING)
+        return 1.0f;
 
-    return 1.0f;
+    return row->*CombatRatingColumns[rating];
 }
 
 float Player::GetRatingMultiplier(CombatRating cr) const
@@ -6140,6 +6127,11 @@ void Player::SendDirectMessage(WorldPacket const* data) const
     m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(WorldPacket&& data) const
+{
+    m_session->SendPacket(std::move(data));
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId) const
 {
     WorldPackets::Misc::TriggerCinematic packet;
@@ -7220,6 +7212,7 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
     m_zoneUpdateTimer = ZONE_UPDATE_INTERVAL;
 
     GetMap()->UpdatePlayerZoneStats(oldZone, newZone);
+    sWorld->UpdateSessionZone(GetSession(), oldZone, newZone);
 
     // call leave script hooks immedately (before updating flags)
     if (oldZone != newZone)
@@ -7547,6 +7540,8 @@ void Player::_ApplyItemBonuses(Item* item, uint8 slot, bool apply)
     if (GtCombatRatingsMultByILvl const* ratingMult = sCombatRatingsMultByILvlGameTable.GetRow(itemLevel))
         combatRatingMultiplier = GetIlvlStatMultiplier(ratingMult, proto->GetInventoryType());
 
+    // items usually modify several stats, recalculate each of them (and what derives from them) once
+    BeginStatUpdateBatch();
     for (uint8 i = 0; i < MAX_ITEM_PROTO_STATS; ++i)
     {
         int32 statType = item->GetItemStatType(i);
@@ -7784,6 +7779,7 @@ void Player::_ApplyItemBonuses(Item* item, uint8 slot, bool apply)
         if (proto->GetClass() == ITEM_CLASS_ARMOR && proto->GetSubClass() == ITEM_SUBCLASS_ARMOR_SHIELD)
             SetUpdateFieldValue(m_values.ModifyValue(&Player::m_activePlayerData).ModifyValue(&UF::ActivePlayerData::ShieldBlock), apply ? int32(armor * 2.5f) : 0);
     }
+    EndStatUpdateBatch();
 
     WeaponAttackType attType = Player::GetAttackBySlot(slot, proto->GetInventoryType());
     if (attType != MAX_ATTACK)
@@ -10044,6 +10040,16 @@ uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
         location |= ItemSearchLocation::Bank;
 
     uint32 count = 0;
+    if (!countGems)
+    {
+        if (std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_itemsByEntry, item))
+            for (Item* pItem : *items)
+                if (pItem != skipItem && IsItemInSearchLocation(pItem, location))
+                    count += pItem->GetCount();
+
+        return count;
+    }
+
     ForEachItem(location, [&count, item, skipItem, countGems](Item* pItem)
     {
         if (pItem != skipItem)
@@ -10092,18 +10098,11 @@ std::vector<Item*> Player::GetCraftingReagentItemsToDeposit()
 
 Item* Player::GetItemByGuid(ObjectGuid guid) const
 {
-    Item* result = nullptr;
-    ForEachItem(ItemSearchLocation::Everywhere, [&result, guid](Item* item)
-    {
-        if (item->GetGUID() == guid)
-        {
-            result = item;
-            return ItemSearchCallbackResult::Stop;
-        }
+    auto itr = m_itemsByGuid.find(guid);
+    if (itr == m_itemsByGuid.end() || !IsItemInSearchLocation(itr->second, ItemSearchLocation::Everywhere))
+        return nullptr;
 
-        return ItemSearchCallbackResult::Continue;
-    });
-    return result;
+    return itr->second;
 }
 
 Item* Player::GetItemByPos(uint16 pos) const
@@ -10399,17 +10398,22 @@ bool Player::HasItemCount(uint32 item, uint32 count, bool inBankAlso) const
     if (inBankAlso)
         location |= ItemSearchLocation::Bank;
 
+    std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_itemsByEntry, item);
+    if (!items)
+        return false;
+
     uint32 currentCount = 0;
-    return !ForEachItem(location, [item, count, &currentCount](Item* pItem)
+    for (Item* pItem : *items)
     {
-        if (pItem->GetEntry() == item && !pItem->IsInTrade())
+        if (!pItem->IsInTrade() && IsItemInSearchLocation(pItem, location))
         {
             currentCount += pItem->GetCount();
             if (currentCount >= count)
-                return ItemSearchCallbackResult::Stop;
+                return true;
         }
-        return ItemSearchCallbackResult::Continue;
-    });
+    }
+
+    return false;
 }
 
 bool Player::HasItemOrGemWithIdEquipped(uint32 item, uint32 count, uint8 except_slot) const
@@ -12187,6 +12191,8 @@ Item* Player::_StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool
         else
             pBag->StoreItem(slot, pItem, update);
 
+        AddItemToIndex(pItem);
+
         if (IsInWorld() && update)
         {
             pItem->AddToWorld();
@@ -12541,6 +12547,7 @@ void Player::VisualizeItem(uint8 slot, Item* pItem)
     pItem->SetOwnerGUID(GetGUID());
     pItem->SetSlot(slot);
     pItem->SetContainer(nullptr);
+    AddItemToIndex(pItem);
 
     if (slot < EQUIPMENT_SLOT_END)
         SetVisibleItemSlot(slot, pItem);
@@ -12625,6 +12632,8 @@ void Player::RemoveItem(uint8 bag, uint8 slot, bool update)
         else if (Bag* pBag = GetBagByPos(bag))
             pBag->RemoveItem(slot, update);
 
+        RemoveItemFromIndex(pItem, pItem->GetEntry());
+
         pItem->SetContainedIn(ObjectGuid::Empty);
         // pItem->SetUInt64Value(ITEM_FIELD_OWNER, 0); not clear owner at remove (it will be set at store). This used in mail and auction code
         pItem->SetSlot(NULL_SLOT);
@@ -12760,6 +12769,8 @@ void Player::DestroyItem(uint8 bag, uint8 slot, bool update)
         else if (Bag* pBag = GetBagByPos(bag))
             pBag->RemoveItem(slot, update);
 
+        RemoveItemFromIndex(pItem, pItem->GetEntry());
+
         // Delete rolled money / loot from db.
         // MUST be done before RemoveFromWorld() or GetTemplate() fails
         if (pProto->HasFlag(ITEM_FLAG_HAS_LOOT))
@@ -13095,18 +13106,12 @@ void Player::DestroyConjuredItems(bool update)
 
 Item* Player::GetItemByEntry(uint32 entry, ItemSearchLocation where /*= ItemSearchLocation::Default */) const
 {
-    Item* result = nullptr;
-    ForEachItem(where, [&result, entry](Item* item)
-    {
-        if (item->GetEntry() == entry)
-        {
-            result = item;
-            return ItemSearchCallbackResult::Stop;
-        }
+    if (std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_itemsByEntry, entry))
+        for (Item* item : *items)
+            if (IsItemInSearchLocation(item, where))
+                return item;
 
-        return ItemSearchCallbackResult::Continue;
-    });
-    return result;
+    return nullptr;
 }
 
 std::vector<Item*> Player::GetItemListByEntry(uint32 entry, bool inBankAlso) const
@@ -13116,16 +13121,78 @@ std::vector<Item*> Player::GetItemListByEntry(uint32 entry, bool inBankAlso) con
         location |= ItemSearchLocation::Bank;
 
     std::vector<Item*> itemList = std::vector<Item*>();
-    ForEachItem(location, [&itemList, entry](Item* item)
-    {
-        if (item->GetEntry() == entry)
-            itemList.push_back(item);
+    if (std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_itemsByEntry, entry))
+        for (Item* item : *items)
+            if (IsItemInSearchLocation(item, location))
+                itemList.push_back(item);
 
-        return ItemSearchCallbackResult::Continue;
-    });
     return itemList;
 }
 
+void Player::UpdateItemEntryIndex(Item* item, uint32 oldEntry)
+{
+    if (!m_itemsByGuid.contains(item->GetGUID()))
+        return;
+
+    RemoveItemFromIndex(item, oldEntry);
+    AddItemToIndex(item);
+}
+
+void Player::AddItemToIndex(Item* item)
+{
+    if (m_itemsByGuid.emplace(item->GetGUID(), item).second)
+        m_itemsByEntry[item->GetEntry()].push_back(item);
+}
+
+void Player::RemoveItemFromIndex(Item* item, uint32 entry)
+{
+    if (!m_itemsByGuid.erase(item->GetGUID()))
+        return;
+
+    auto itr = m_itemsByEntry.find(entry);
+    if (itr == m_itemsByEntry.end())
+        return;
+
+    auto itemItr = std::find(itr->second.begin(), itr->second.end(), item);
+    if (itemItr != itr->second.end())
+        itr->second.erase(itemItr);
+
+    if (itr->second.empty())
+        m_itemsByEntry.erase(itr);
+}
+
+// same slots as ForEachItem
+bool Player::IsItemInSearchLocation(Item const* item, EnumFlag<ItemSearchLocation> location) const
+{
+    uint8 bag = item->GetBagSlot();
+    uint8 slot = item->GetSlot();
+    if (bag == INVENTORY_SLOT_BAG_0)
+    {
+        if (slot < EQUIPMENT_SLOT_END)
+            return location.HasFlag(ItemSearchLocation::Equipment);
+
+        if ((slot >= INVENTORY_SLOT_BAG_START && slot < INVENTORY_SLOT_ITEM_START + GetInventorySlotCount())
+            || (slot >= CHILD_EQUIPMENT_SLOT_START && slot < CHILD_EQUIPMENT_SLOT_END))
+            return location.HasFlag(ItemSearchLocation::Inventory);
+
+        if (slot >= BANK_SLOT_ITEM_START && slot < BANK_SLOT_BAG_END)
+            return location.HasFlag(ItemSearchLocation::Bank);
+
+        if (slot >= REAGENT_SLOT_START && slot < REAGENT_SLOT_END)
+            return location.HasFlag(ItemSearchLocation::ReagentBank);
+
+        return false;
+    }
+
+    if (bag >= INVENTORY_SLOT_BAG_START && bag < INVENTORY_SLOT_BAG_END)
+        return location.HasFlag(ItemSearchLocation::Inventory);
+
+    if (bag >= BANK_SLOT_BAG_START && bag < BANK_SLOT_BAG_END)
+        return location.HasFlag(ItemSearchLocation::Bank);
+
+    return false;
+}
+
 void Player::DestroyItemCount(Item* pItem, uint32 &count, bool update)
 {
     if (!pItem)
@@ -13941,27 +14008,34 @@ void Player::UpdateItemDuration(uint32 time, bool realtimeonly)
     }
 }
 
+static bool EnchantDurationExpiresLater(EnchantDuration const& left, EnchantDuration const& right)
+{
+    return left.expireTime > right.expireTime;
+}
+
+bool Player::IsEnchantmentDurationStale(EnchantDuration const& enchantDuration) const
+{
+    uint32 enchantId = enchantDuration.item->GetEnchantmentId(enchantDuration.slot);
+    return !enchantId || enchantId != enchantDuration.enchantId;
+}
+
 void Player::UpdateEnchantTime(uint32 time)
 {
-    for (EnchantDurationList::iterator itr = m_enchantDuration.begin(), next; itr != m_enchantDuration.end(); itr = next)
+    m_enchantTime += time;
+
+    // only the expired durations are looked at, the heap keeps the next one to expire in front
+    while (!m_enchantDuration.empty() && m_enchantDuration.front().expireTime <= m_enchantTime)
     {
-        ASSERT(itr->item);
-        next = itr;
-        if (!itr->item->GetEnchantmentId(itr->slot))
-        {
-            next = m_enchantDuration.erase(itr);
-        }
-        else if (itr->leftduration <= time)
-        {
-            ApplyEnchantment(itr->item, itr->slot, false, false);
-            itr->item->ClearEnchantment(itr->slot);
-            next = m_enchantDuration.erase(itr);
-        }
-        else if (itr->leftduration > time)
-        {
-            itr->leftduration -= time;
-            ++next;
-        }
+        std::pop_heap(m_enchantDuration.begin(), m_enchantDuration.end(), EnchantDurationExpiresLater);
+        EnchantDuration expired = m_enchantDuration.back();
+        m_enchantDuration.pop_back();
+
+        ASSERT(expired.item);
+        if (IsEnchantmentDurationStale(expired))
+            continue;
+
+        ApplyEnchantment(expired.item, expired.slot, false, false);
+        expired.item->ClearEnchantment(expired.slot);
     }
 }
 
@@ -13980,56 +14054,71 @@ void Player::AddEnchantmentDurations(Item* item)
 
 void Player::RemoveEnchantmentDurations(Item* item)
 {
-    for (EnchantDurationList::iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end();)
+    auto end = std::remove_if(m_enchantDuration.begin(), m_enchantDuration.end(), [&](EnchantDuration const& enchantDuration)
     {
-        if (itr->item == item)
-        {
-            // save duration in item
-            item->SetEnchantmentDuration(EnchantmentSlot(itr->slot), itr->leftduration, this);
-            itr = m_enchantDuration.erase(itr);
-        }
-        else
-            ++itr;
+        if (enchantDuration.item != item)
+            return false;
+
+        // save duration in item
+        if (!IsEnchantmentDurationStale(enchantDuration))
+            item->SetEnchantmentDuration(enchantDuration.slot, GetEnchantmentLeftDuration(enchantDuration), this);
+        return true;
+    });
+
+    if (end != m_enchantDuration.end())
+    {
+        m_enchantDuration.erase(end, m_enchantDuration.end());
+        std::make_heap(m_enchantDuration.begin(), m_enchantDuration.end(), EnchantDurationExpiresLater);
     }
 }
 
 void Player::RemoveEnchantmentDurationsReferences(Item* item)
 {
-    for (EnchantDurationList::iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end();)
+    auto end = std::remove_if(m_enchantDuration.begin(), m_enchantDuration.end(), [item](EnchantDuration const& enchantDuration)
     {
-        if (itr->item == item)
-            itr = m_enchantDuration.erase(itr);
-        else
-            ++itr;
+        return enchantDuration.item == item;
+    });
+
+    if (end != m_enchantDuration.end())
+    {
+        m_enchantDuration.erase(end, m_enchantDuration.end());
+        std::make_heap(m_enchantDuration.begin(), m_enchantDuration.end(), EnchantDurationExpiresLater);
     }
 }
 
 void Player::RemoveArenaEnchantments(EnchantmentSlot slot)
 {
     // remove enchantments from equipped items first to clean up the m_enchantDuration list
-    for (EnchantDurationList::iterator itr = m_enchantDuration.begin(), next; itr != m_enchantDuration.end(); itr = next)
+    EnchantDurationList removed;
+    auto end = std::remove_if(m_enchantDuration.begin(), m_enchantDuration.end(), [&](EnchantDuration const& enchantDuration)
     {
-        next = itr;
-        if (itr->slot == slot)
-        {
-            if (itr->item && itr->item->GetEnchantmentId(slot))
-            {
-                // Poisons and DK runes are enchants which are allowed on arenas
-                if (sSpellMgr->IsArenaAllowedEnchancment(itr->item->GetEnchantmentId(slot)))
-                {
-                    ++next;
-                    continue;
-                }
-                // remove from stats
-                ApplyEnchantment(itr->item, slot, false, false);
-                // remove visual
-                itr->item->ClearEnchantment(slot);
-            }
-            // remove from update list
-            next = m_enchantDuration.erase(itr);
-        }
-        else
-            ++next;
+        if (enchantDuration.slot != slot)
+            return false;
+
+        // Poisons and DK runes are enchants which are allowed on arenas
+        if (!IsEnchantmentDurationStale(enchantDuration) && sSpellMgr->IsArenaAllowedEnchancment(enchantDuration.enchantId))
+            return false;
+
+        removed.push_back(enchantDuration);
+        return true;
+    });
+
+    if (end != m_enchantDuration.end())
+    {
+        // remove from update list
+        m_enchantDuration.erase(end, m_enchantDuration.end());
+        std::make_heap(m_enchantDuration.begin(), m_enchantDuration.end(), EnchantDurationExpiresLater);
+    }
+
+    for (EnchantDuration const& enchantDuration : removed)
+    {
+        if (IsEnchantmentDurationStale(enchantDuration))
+            continue;
+
+        // remove from stats
+        ApplyEnchantment(enchantDuration.item, slot, false, false);
+        // remove visual
+        enchantDuration.item->ClearEnchantment(slot);
     }
 
     // remove enchants from inventory items
@@ -14063,15 +14152,18 @@ void Player::AddEnchantmentDuration(Item* item, EnchantmentSlot slot, uint32 dur
     {
         if (itr->item == item && itr->slot == slot)
         {
-            itr->item->SetEnchantmentDuration(itr->slot, itr->leftduration, this);
+            if (!IsEnchantmentDurationStale(*itr))
+                itr->item->SetEnchantmentDuration(itr->slot, GetEnchantmentLeftDuration(*itr), this);
             m_enchantDuration.erase(itr);
+            std::make_heap(m_enchantDuration.begin(), m_enchantDuration.end(), EnchantDurationExpiresLater);
             break;
         }
     }
     if (duration > 0)
     {
         GetSession()->SendItemEnchantTimeUpdate(GetGUID(), item->GetGUID(), slot, uint32(duration/1000));
-        m_enchantDuration.push_back(EnchantDuration(item, slot, duration));
+        m_enchantDuration.emplace_back(item, slot, item->GetEnchantmentId(slot), m_enchantTime + duration);
+        std::push_heap(m_enchantDuration.begin(), m_enchantDuration.end(), EnchantDurationExpiresLater);
     }
 }
 
@@ -14485,8 +14577,9 @@ void Player::UpdateSkillEnchantments(uint16 skill_id, uint16 curr_value, uint16
 
 void Player::SendEnchantmentDurations()
 {
-    for (EnchantDurationList::const_iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end(); ++itr)
-        GetSession()->SendItemEnchantTimeUpdate(GetGUID(), itr->item->GetGUID(), itr->slot, uint32(itr->leftduration) / 1000);
+    for (EnchantDuration const& enchantDuration : m_enchantDuration)
+        if (!IsEnchantmentDurationStale(enchantDuration))
+            GetSession()->SendItemEnchantTimeUpdate(GetGUID(), enchantDuration.item->GetGUID(), enchantDuration.slot, GetEnchantmentLeftDuration(enchantDuration) / 1000);
 }
 
 void Player::SendItemDurations()
@@ -14543,11 +14636,11 @@ void Player::PrepareGossipMenu(WorldObject* source, uint32 menuId /*= 0*/, bool
 
     menu->GetGossipMenu().SetMenuId(menuId);
 
-    GossipMenuItemsMapBounds menuItemBounds = sObjectMgr->GetGossipMenuItemsMapBounds(menuId);
+    GossipMenuItemsCompiledList const* menuItems = sObjectMgr->GetCompiledGossipMenuItems(menuId);
 
     // if default menuId and no menu options exist for this, use options from default options
-    if (menuItemBounds.first == menuItemBounds.second && menuId == GetDefaultGossipMenuForSource(source))
-        menuItemBounds = sObjectMgr->GetGossipMenuItemsMapBounds(0);
+    if (!menuItems && menuId == GetDefaultGossipMenuForSource(source))
+        menuItems = sObjectMgr->GetCompiledGossipMenuItems(0);
 
     uint64 npcflags = 0;
 
@@ -14561,18 +14654,25 @@ void Player::PrepareGossipMenu(WorldObject* source, uint32 menuId /*= 0*/, bool
         if (showQuests && source->ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_QUESTGIVER)
             PrepareQuestMenu(source->GetGUID());
 
-    for (GossipMenuItemsContainer::const_iterator itr = menuItemBounds.first; itr != menuItemBounds.second; ++itr)
+    if (!menuItems)
+        return;
+
+    ConditionSourceInfo conditionSource(this, source);
+    LocaleConstant locale = GetSession()->GetSessionDbLocaleIndex();
+
+    for (GossipMenuItemsCompiled const& compiled : *menuItems)
     {
-        if (!sConditionMgr->IsObjectMeetToConditions(this, source, itr->second.Conditions))
+        GossipMenuItems const& menuItem = *compiled.Item;
+        if (!sConditionMgr->IsObjectMeetToConditions(conditionSource, menuItem.Conditions))
             continue;
 
         bool canTalk = true;
         if (Creature* creature = source->ToCreature())
         {
-            if (!(itr->second.OptionNpcFlag & npcflags))
+            if (!(menuItem.OptionNpcFlag & npcflags))
                 continue;
 
-            switch (itr->second.OptionType)
+            switch (menuItem.OptionType)
             {
                 case GOSSIP_OPTION_ARMORER:
                     canTalk = false;                       // added in special mode
@@ -14615,18 +14715,18 @@ void Player::PrepareGossipMenu(WorldObject* source, uint32 menuId /*= 0*/, bool
                 case GOSSIP_OPTION_TRANSMOGRIFIER:
                     break;                                  // no checks
                 case GOSSIP_OPTION_OUTDOORPVP:
-                    if (!sOutdoorPvPMgr->CanTalkTo(this, creature, itr->second))
+                    if (!sOutdoorPvPMgr->CanTalkTo(this, creature, menuItem))
                         canTalk = false;
                     break;
                 default:
-                    TC_LOG_ERROR("sql.sql", "Creature entry %u has unknown gossip option %u for menu %u.", creature->GetEntry(), itr->second.OptionType, itr->second.MenuID);
+                    TC_LOG_ERROR("sql.sql", "Creature entry %u has unknown gossip option %u for menu %u.", creature->GetEntry(), menuItem.OptionType, menuItem.MenuID);
                     canTalk = false;
                     break;
             }
         }
         else if (GameObject* go = source->ToGameObject())
         {
-            switch (itr->second.OptionType)
+            switch (menuItem.OptionType)
             {
                 case GOSSIP_OPTION_GOSSIP:
                     if (go->GetGoType() != GAMEOBJECT_TYPE_QUESTGIVER && go->GetGoType() != GAMEOBJECT_TYPE_GOOBER)
@@ -14641,39 +14741,38 @@ void Player::PrepareGossipMenu(WorldObject* source, uint32 menuId /*= 0*/, bool
         if (canTalk)
         {
             std::string strOptionText, strBoxText;
-            BroadcastTextEntry const* optionBroadcastText = sBroadcastTextStore.LookupEntry(itr->second.OptionBroadcastTextID);
-            BroadcastTextEntry const* boxBroadcastText = sBroadcastTextStore.LookupEntry(itr->second.BoxBroadcastTextID);
-            LocaleConstant locale = GetSession()->GetSessionDbLocaleIndex();
+            BroadcastTextEntry const* optionBroadcastText = compiled.OptionBroadcastText;
+            BroadcastTextEntry const* boxBroadcastText = compiled.BoxBroadcastText;
 
             if (optionBroadcastText)
                 strOptionText = DB2Manager::GetBroadcastTextValue(optionBroadcastText, locale, GetGender());
             else
-                strOptionText = itr->second.OptionText;
+                strOptionText = menuItem.OptionText;
 
             if (boxBroadcastText)
                 strBoxText = DB2Manager::GetBroadcastTextValue(boxBroadcastText, locale, GetGender());
             else
-                strBoxText = itr->second.BoxText;
+                strBoxText = menuItem.BoxText;
 
             if (locale != DEFAULT_LOCALE)
             {
                 if (!optionBroadcastText)
                 {
                     /// Find localizations from database.
-                    if (GossipMenuItemsLocale const* gossipMenuLocale = sObjectMgr->GetGossipMenuItemsLocale(menuId, itr->second.OptionID))
+                    if (GossipMenuItemsLocale const* gossipMenuLocale = sObjectMgr->GetGossipMenuItemsLocale(menuId, menuItem.OptionID))
                         ObjectMgr::GetLocaleString(gossipMenuLocale->OptionText, locale, strOptionText);
                 }
 
                 if (!boxBroadcastText)
                 {
                     /// Find localizations from database.
-                    if (GossipMenuItemsLocale const* gossipMenuLocale = sObjectMgr->GetGossipMenuItemsLocale(menuId, itr->second.OptionID))
+                    if (GossipMenuItemsLocale const* gossipMenuLocale = sObjectMgr->GetGossipMenuItemsLocale(menuId, menuItem.OptionID))
                         ObjectMgr::GetLocaleString(gossipMenuLocale->BoxText, locale, strBoxText);
                 }
             }
 
-            menu->GetGossipMenu().AddMenuItem(itr->second.OptionID, itr->second.OptionIcon, strOptionText, 0, itr->second.OptionType, strBoxText, itr->second.BoxMoney, itr->second.BoxCoded);
-            menu->GetGossipMenu().AddGossipMenuItemData(itr->second.OptionID, itr->second.ActionMenuID, itr->second.ActionPoiID);
+            menu->GetGossipMenu().AddMenuItem(menuItem.OptionID, menuItem.OptionIcon, strOptionText, 0, menuItem.OptionType, strBoxText, menuItem.BoxMoney, menuItem.BoxCoded);
+            menu->GetGossipMenu().AddGossipMenuItemData(menuItem.OptionID, menuItem.ActionMenuID, menuItem.ActionPoiID);
         }
     }
 }
@@ -17021,6 +17120,7 @@ void Player::CurrencyChanged(uint32 currencyId, int32 change)
 void Player::UpdateQuestObjectiveProgress(QuestObjectiveType objectiveType, int32 objectId, int64 addCount, ObjectGuid victimGuid)
 {
     bool anyObjectiveChangedCompletionState = false;
+    bool anyObjectiveUpdated = false;
 
     for (QuestObjectiveStatusMap::value_type const& objectiveItr : Trinity::Containers::MapEqualRange(m_questObjectiveStatus, { objectiveType, objectId }))
     {
@@ -17039,6 +17139,7 @@ void Player::UpdateQuestObjectiveProgress(QuestObjectiveType objectiveType, int3
         bool objectiveWasComplete = IsQuestObjectiveComplete(logSlot, quest, objective);
         if (!objectiveWasComplete || addCount < 0)
         {
+            anyObjectiveUpdated = true;
             bool objectiveIsNowComplete = false;
             if (objective.IsStoringValue())
             {
@@ -17128,7 +17229,9 @@ void Player::UpdateQuestObjectiveProgress(QuestObjectiveType objectiveType, int3
     if (anyObjectiveChangedCompletionState)
         UpdateVisibleGameobjectsOrSpellClicks();
 
-    PhasingHandler::OnConditionChange(this);
+    // a kill or use credit that matched no objective changed nothing phase conditions can check
+    if (anyObjectiveUpdated || !QuestObjective::IsProgressedByCreditOnly(objectiveType))
+        PhasingHandler::OnConditionChange(this);
 }
 
 bool Player::HasQuestForItem(uint32 itemid) const
@@ -19380,6 +19483,7 @@ void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mail
 
     if (mailsResult)
     {
+        mailById.reserve(mailsResult->GetRowCount());
         do
         {
             Field* fields = mailsResult->Fetch();
@@ -20352,8 +20456,9 @@ void Player::SaveToDB(bool create /*=false*/)
 
     SaveToDB(loginTransaction, trans, create);
 
-    CharacterDatabase.CommitTransaction(trans);
-    LoginDatabase.CommitTransaction(loginTransaction);
+    // keep consecutive saves of the same character ordered on one connection
+    CharacterDatabase.CommitTransaction(trans, GetGUID().GetCounter());
+    LoginDatabase.CommitTransaction(loginTransaction, GetSession()->GetAccountId());
 }
 
 void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDatabaseTransaction trans, bool create /* = false */)
@@ -20747,7 +20852,7 @@ void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDataba
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
-        pet->SavePetToDB(PET_SAVE_AS_CURRENT);
+        pet->SavePetToDB(PET_SAVE_AS_CURRENT, trans);
 }
 
 // fast save function for item/money cheating preventing - save only inventory and money state
@@ -20857,6 +20962,8 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans)
     stmt->setUInt64(0, GetGUID().GetCounter());
     trans->Append(stmt);
 
+    // effects are appended after all auras so that consecutive inserts of each table can be coalesced
+    std::vector<CharacterDatabasePreparedStatement*> effectStatements;
     uint8 index;
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -20898,10 +21005,13 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans)
                 stmt->setUInt8(index++, effect->GetEffIndex());
                 stmt->setInt32(index++, effect->GetAmount());
                 stmt->setInt32(index++, effect->GetBaseAmount());
-                trans->Append(stmt);
+                effectStatements.push_back(stmt);
             }
         }
     }
+
+    for (CharacterDatabasePreparedStatement* effectStmt : effectStatements)
+        trans->Append(effectStmt);
 }
 
 void Player::_SaveInventory(CharacterDatabaseTransaction trans)
@@ -20959,8 +21069,9 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
     }
 
     // update enchantment durations
-    for (EnchantDurationList::iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end(); ++itr)
-        itr->item->SetEnchantmentDuration(itr->slot, itr->leftduration, this);
+    for (EnchantDuration const& enchantDuration : m_enchantDuration)
+        if (!IsEnchantmentDurationStale(enchantDuration))
+            enchantDuration.item->SetEnchantmentDuration(enchantDuration.slot, GetEnchantmentLeftDuration(enchantDuration), this);
 
     // if no changes
     if (m_itemUpdateQueue.empty())
@@ -21040,6 +21151,11 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
 
 void Player::_SaveVoidStorage(CharacterDatabaseTransaction trans)
 {
+    if (!m_voidStorageChanged)
+        return;
+
+    m_voidStorageChanged = false;
+
     CharacterDatabasePreparedStatement* stmt = nullptr;
 
     for (uint8 i = 0; i < VOID_STORAGE_MAX_SLOT; ++i)
@@ -21076,6 +21192,11 @@ void Player::_SaveVoidStorage(CharacterDatabaseTransaction trans)
 
 void Player::_SaveCUFProfiles(CharacterDatabaseTransaction trans)
 {
+    if (!m_CUFProfilesChanged)
+        return;
+
+    m_CUFProfilesChanged = false;
+
     CharacterDatabasePreparedStatement* stmt;
     for (uint8 i = 0; i < MAX_CUF_PROFILES; ++i)
     {
@@ -21440,16 +21561,20 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement* stmt;
 
-    for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
+    // all deletes go first so that the inserts below form one run that can be coalesced
+    for (PlayerSpellMap::value_type const& spell : m_spells)
     {
-        if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
+        if (spell.second.state == PLAYERSPELL_REMOVED || spell.second.state == PLAYERSPELL_CHANGED)
         {
             stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_BY_SPELL);
-            stmt->setUInt32(0, itr->first);
+            stmt->setUInt32(0, spell.first);
             stmt->setUInt64(1, GetGUID().GetCounter());
             trans->Append(stmt);
         }
+    }
 
+    for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
+    {
         // add only changed/new not dependent spells
         if (!itr->second.dependent && (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED))
         {
@@ -24082,13 +24207,13 @@ bool Player::IsVisibleGloballyFor(Player const* u) const
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, T* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Trinity::GuidHashSet& s64, T* target, std::set<Unit*>& /*v*/)
 {
     s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, GameObject* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Trinity::GuidHashSet& s64, GameObject* target, std::set<Unit*>& /*v*/)
 {
     // @HACK: This is to prevent objects like deeprun tram from disappearing when player moves far from its spawn point while riding it
     // But exclude stoppable elevators from this hack - they would be teleporting from one end to another
@@ -24099,14 +24224,14 @@ inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, GameObject* target,
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Creature* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Trinity::GuidHashSet& s64, Creature* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Player* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Trinity::GuidHashSet& s64, Player* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
@@ -25293,8 +25418,12 @@ Player* Player::GetTrader() const
 
 bool Player::IsSpellFitByClassAndRace(uint32 spell_id) const
 {
-    uint8 race  = GetRace();
-    uint32 classmask = GetClassMask();
+    return IsSpellFitByClassAndRace(spell_id, GetRace(), GetClass());
+}
+
+bool Player::IsSpellFitByClassAndRace(uint32 spell_id, uint8 race, uint8 playerClass)
+{
+    uint32 classmask = 1 << (playerClass - 1);
 
     SkillLineAbilityMapBounds bounds = sSpellMgr->GetSkillLineAbilityMapBounds(spell_id);
     if (bounds.first == bounds.second)
@@ -25311,7 +25440,7 @@ bool Player::IsSpellFitByClassAndRace(uint32 spell_id) const
             continue;
 
         // skip wrong class and race skill saved in SkillRaceClassInfo.dbc
-        if (!sDB2Manager.GetSkillRaceClassInfo(_spell_idx->second->SkillLine, GetRace(), GetClass()))
+        if (!sDB2Manager.GetSkillRaceClassInfo(_spell_idx->second->SkillLine, race, playerClass))
             continue;
 
         return true;
@@ -27596,10 +27725,20 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
         GetGlyphs(spec).push_back(glyphId);
 
     } while (result->NextRow());
+
+    for (uint8 spec = 0; spec < MAX_SPECIALIZATIONS; ++spec)
+        _specializationInfo.SavedGlyphs[spec] = GetGlyphs(spec);
 }
 
-void Player::_SaveGlyphs(CharacterDatabaseTransaction trans) const
+void Player::_SaveGlyphs(CharacterDatabaseTransaction trans)
 {
+    bool changed = false;
+    for (uint8 spec = 0; spec < MAX_SPECIALIZATIONS && !changed; ++spec)
+        changed = GetGlyphs(spec) != _specializationInfo.SavedGlyphs[spec];
+
+    if (!changed)
+        return;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
     stmt->setUInt64(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -27617,6 +27756,8 @@ void Player::_SaveGlyphs(CharacterDatabaseTransaction trans) const
 
             trans->Append(stmt);
         }
+
+        _specializationInfo.SavedGlyphs[spec] = GetGlyphs(spec);
     }
 }
 
@@ -27643,34 +27784,56 @@ void Player::_LoadPvpTalents(PreparedQueryResult result)
                     AddPvpTalent(talent, (*result)[4].GetUInt8(), slot);
         while (result->NextRow());
     }
+
+    for (uint8 group = 0; group < MAX_SPECIALIZATIONS; ++group)
+        _specializationInfo.SavedPvpTalents[group] = GetPvpTalentMap(group);
 }
 
 void Player::_SaveTalents(CharacterDatabaseTransaction trans)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT);
-    stmt->setUInt64(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    CharacterDatabasePreparedStatement* stmt;
 
-    for (uint8 group = 0; group < MAX_SPECIALIZATIONS; ++group)
+    bool talentsChanged = false;
+    for (uint8 group = 0; group < MAX_SPECIALIZATIONS && !talentsChanged; ++group)
+        for (PlayerTalentMap::value_type const& talent : *GetTalentMap(group))
+            if (talent.second != PLAYERSPELL_UNCHANGED)
+                talentsChanged = true;
+
+    if (talentsChanged)
     {
-        PlayerTalentMap* talents = GetTalentMap(group);
-        for (auto itr = talents->begin(); itr != talents->end();)
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT);
+        stmt->setUInt64(0, GetGUID().GetCounter());
+        trans->Append(stmt);
+
+        for (uint8 group = 0; group < MAX_SPECIALIZATIONS; ++group)
         {
-            if (itr->second == PLAYERSPELL_REMOVED)
+            PlayerTalentMap* talents = GetTalentMap(group);
+            for (auto itr = talents->begin(); itr != talents->end();)
             {
-                itr = talents->erase(itr);
-                continue;
-            }
+                if (itr->second == PLAYERSPELL_REMOVED)
+                {
+                    itr = talents->erase(itr);
+                    continue;
+                }
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_TALENT);
-            stmt->setUInt64(0, GetGUID().GetCounter());
-            stmt->setUInt32(1, itr->first);
-            stmt->setUInt8(2, group);
-            trans->Append(stmt);
-            ++itr;
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_TALENT);
+                stmt->setUInt64(0, GetGUID().GetCounter());
+                stmt->setUInt32(1, itr->first);
+                stmt->setUInt8(2, group);
+                trans->Append(stmt);
+                itr->second = PLAYERSPELL_UNCHANGED;
+                ++itr;
+            }
         }
     }
 
+    bool pvpTalentsChanged = false;
+    for (uint8 group = 0; group < MAX_SPECIALIZATIONS && !pvpTalentsChanged; ++group)
+        pvpTalentsChanged = GetPvpTalentMap(group) != _specializationInfo.SavedPvpTalents[group];
+
+    if (!pvpTalentsChanged)
+        return;
+
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_PVP_TALENT);
     stmt->setUInt64(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -27686,6 +27849,7 @@ void Player::_SaveTalents(CharacterDatabaseTransaction trans)
         stmt->setUInt32(4, talents[3]);
         stmt->setUInt8(5, group);
         trans->Append(stmt);
+        _specializationInfo.SavedPvpTalents[group] = talents;
     }
 }
 
@@ -28327,6 +28491,7 @@ uint8 Player::AddVoidStorageItem(VoidStorageItem&& item)
     }
 
     _voidStorageItems[slot] = new VoidStorageItem(std::move(item));
+    m_voidStorageChanged = true;
     return slot;
 }
 
@@ -28340,6 +28505,7 @@ void Player::DeleteVoidStorageItem(uint8 slot)
 
     delete _voidStorageItems[slot];
     _voidStorageItems[slot] = nullptr;
+    m_voidStorageChanged = true;
 }
 
 bool Player::SwapVoidStorageItem(uint8 oldSlot, uint8 newSlot)
@@ -28348,6 +28514,7 @@ bool Player::SwapVoidStorageItem(uint8 oldSlot, uint8 newSlot)
         return false;
 
     std::swap(_voidStorageItems[newSlot], _voidStorageItems[oldSlot]);
+    m_voidStorageChanged = true;
     return true;
 }
 
@@ -24,6 +24,7 @@
 #include "DBCEnums.h"
 #include "EquipmentSet.h"
 #include "GroupReference.h"
+#include "GuidHashContainers.h"
 #include "Hash.h"
 #include "ItemDefines.h"
 #include "ItemEnchantmentMgr.h"
@@ -426,16 +427,17 @@ struct Runes
 
 struct EnchantDuration
 {
-    EnchantDuration() : item(nullptr), slot(MAX_ENCHANTMENT_SLOT), leftduration(0) { }
-    EnchantDuration(Item* _item, EnchantmentSlot _slot, uint32 _leftduration) : item(_item), slot(_slot),
-        leftduration(_leftduration){ ASSERT(item); }
+    EnchantDuration() : item(nullptr), slot(MAX_ENCHANTMENT_SLOT), enchantId(0), expireTime(0) { }
+    EnchantDuration(Item* _item, EnchantmentSlot _slot, uint32 _enchantId, uint64 _expireTime) : item(_item), slot(_slot),
+        enchantId(_enchantId), expireTime(_expireTime) { ASSERT(item); }
 
     Item* item;
     EnchantmentSlot slot;
-    uint32 leftduration;
+    uint32 enchantId;                                       // enchant the duration was started for, entries of removed or replaced enchants are dropped at expiry
+    uint64 expireTime;                                      // on Player::m_enchantTime
 };
 
-typedef std::list<EnchantDuration> EnchantDurationList;
+typedef std::vector<EnchantDuration> EnchantDurationList;   // min-heap on expireTime
 typedef std::list<Item*> ItemDurationList;
 
 enum DrunkenState
@@ -1091,15 +1093,20 @@ enum TalentLearnResult
 
 struct TC_GAME_API SpecializationInfo
 {
-    SpecializationInfo() : PvpTalents(), ResetTalentsCost(0), ResetTalentsTime(0), ActiveGroup(0)
+    SpecializationInfo() : PvpTalents(), SavedPvpTalents(), ResetTalentsCost(0), ResetTalentsTime(0), ActiveGroup(0)
     {
         for (PlayerPvpTalentMap& pvpTalents : PvpTalents)
             pvpTalents.fill(0);
+        for (PlayerPvpTalentMap& pvpTalents : SavedPvpTalents)
+            pvpTalents.fill(0);
     }
 
     PlayerTalentMap Talents[MAX_SPECIALIZATIONS];
     PlayerPvpTalentMap PvpTalents[MAX_SPECIALIZATIONS];
     std::vector<uint32> Glyphs[MAX_SPECIALIZATIONS];
+    // last state written to the database, pvp talents and glyphs are only saved again when they differ
+    PlayerPvpTalentMap SavedPvpTalents[MAX_SPECIALIZATIONS];
+    std::vector<uint32> SavedGlyphs[MAX_SPECIALIZATIONS];
     uint32 ResetTalentsCost;
     time_t ResetTalentsTime;
     uint8 ActiveGroup;
@@ -1347,6 +1354,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         Item* GetItemByGuid(ObjectGuid guid) const;
         Item* GetItemByEntry(uint32 entry, ItemSearchLocation where = ItemSearchLocation::Default) const;
         std::vector<Item*> GetItemListByEntry(uint32 entry, bool inBankAlso = false) const;
+        void UpdateItemEntryIndex(Item* item, uint32 oldEntry);   // must be called after changing the entry of an item stored by this player
         Item* GetItemByPos(uint16 pos) const;
         Item* GetItemByPos(uint8 bag, uint8 slot) const;
         Item* GetUseableItemByPos(uint8 bag, uint8 slot) const;
@@ -1675,8 +1683,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void AddTimedQuest(uint32 questId) { m_timedquests.insert(questId); }
         void RemoveTimedQuest(uint32 questId) { m_timedquests.erase(questId); }
 
-        void SaveCUFProfile(uint8 id, std::nullptr_t) { _CUFProfiles[id] = nullptr; } ///> Empties a CUF profile at position 0-4
-        void SaveCUFProfile(uint8 id, std::unique_ptr<CUFProfile> profile) { _CUFProfiles[id] = std::move(profile); } ///> Replaces a CUF profile at position 0-4
+        void SaveCUFProfile(uint8 id, std::nullptr_t) { _CUFProfiles[id] = nullptr; m_CUFProfilesChanged = true; } ///> Empties a CUF profile at position 0-4
+        void SaveCUFProfile(uint8 id, std::unique_ptr<CUFProfile> profile) { _CUFProfiles[id] = std::move(profile); m_CUFProfilesChanged = true; } ///> Replaces a CUF profile at position 0-4
         CUFProfile* GetCUFProfile(uint8 id) const { return _CUFProfiles[id].get(); } ///> Retrieves a CUF profile at position 0-4
         uint8 GetCUFProfilesCount() const
         {
@@ -1788,6 +1796,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         bool HasActiveSpell(uint32 spell) const;            // show in spellbook
         SpellInfo const* GetCastSpellInfo(SpellInfo const* spellInfo) const override;
         bool IsSpellFitByClassAndRace(uint32 spell_id) const;
+        static bool IsSpellFitByClassAndRace(uint32 spell_id, uint8 race, uint8 playerClass);
         bool HandlePassiveSpellLearn(SpellInfo const* spellInfo);
 
         void SendProficiency(ItemClass itemClass, uint32 itemSubclassMask) const;
@@ -2328,6 +2337,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void SendInitWorldStates(uint32 zoneId, uint32 areaId);
         void SendUpdateWorldState(uint32 variable, uint32 value, bool hidden = false) const;
         void SendDirectMessage(WorldPacket const* data) const;
+        void SendDirectMessage(WorldPacket&& data) const;
         void SendBGWeekendWorldStates() const;
         void SendBattlefieldWorldStates() const;
 
@@ -2443,7 +2453,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         uint8 GetStartLevel(uint8 race, uint8 playerClass, Optional<int32> characterTemplateId) const;
 
         // currently visible objects at player client
-        GuidUnorderedSet m_clientGUIDs;
+        Trinity::GuidHashSet m_clientGUIDs;
         GuidUnorderedSet m_visibleTransports;
 
         bool HaveAtClient(Object const* u) const;
@@ -2888,7 +2898,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void _SaveStoredAuraTeleportLocations(CharacterDatabaseTransaction trans);
         void _SaveEquipmentSets(CharacterDatabaseTransaction trans);
         void _SaveBGData(CharacterDatabaseTransaction trans);
-        void _SaveGlyphs(CharacterDatabaseTransaction trans) const;
+        void _SaveGlyphs(CharacterDatabaseTransaction trans);
         void _SaveTalents(CharacterDatabaseTransaction trans);
         void _SaveStats(CharacterDatabaseTransaction trans) const;
         void _SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans);
@@ -2914,6 +2924,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         uint32 m_team;
         uint32 m_nextSave;
         bool m_customizationsChanged;
+        bool m_voidStorageChanged;
+        bool m_CUFProfilesChanged;
         time_t m_speakTime;
         uint32 m_speakCount;
         Difficulty m_dungeonDifficulty;
@@ -2926,6 +2938,14 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         Item* m_items[PLAYER_SLOTS_COUNT];
         uint32 m_currentBuybackSlot;
 
+        // every item in a slot searched by ForEachItem (buyback excluded), maintained by _StoreItem, EquipItem, RemoveItem and DestroyItem
+        std::unordered_map<uint32, std::vector<Item*>> m_itemsByEntry;
+        Trinity::GuidHashMap<Item*> m_itemsByGuid;
+
+        void AddItemToIndex(Item* item);
+        void RemoveItemFromIndex(Item* item, uint32 entry);
+        bool IsItemInSearchLocation(Item const* item, EnumFlag<ItemSearchLocation> location) const;
+
         PlayerCurrenciesMap _currencyStorage;
 
         /**
@@ -2984,6 +3004,9 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         SpellModContainer m_spellMods[MAX_SPELLMOD][SPELLMOD_END];
 
         EnchantDurationList m_enchantDuration;
+        uint64 m_enchantTime;                               // (ms) advanced by UpdateEnchantTime, enchant durations only run down while it is called
+        uint32 GetEnchantmentLeftDuration(EnchantDuration const& enchantDuration) const { return uint32(std::max(enchantDuration.expireTime, m_enchantTime) - m_enchantTime); }
+        bool IsEnchantmentDurationStale(EnchantDuration const& enchantDuration) const;
         ItemDurationList m_itemDuration;
         GuidUnorderedSet m_itemSoulboundTradeable;
 
@@ -3059,7 +3082,28 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         std::array<std::unique_ptr<CUFProfile>, MAX_CUF_PROFILES> _CUFProfiles;
 
-        TimeTracker m_groupUpdateTimer;
+        // housekeeping that does not need to run every tick, order must match PeriodicUpdates
+        enum PeriodicUpdate : uint8
+        {
+            PERIODIC_UPDATE_ENCHANT_TIME,
+            PERIODIC_UPDATE_HOMEBIND_TIME,
+            PERIODIC_UPDATE_INSTANCE_RESET_TIMES,
+            PERIODIC_UPDATE_AFK_REPORT,
+            PERIODIC_UPDATE_OUT_OF_RANGE_GROUP_MEMBERS,
+            MAX_PERIODIC_UPDATES
+        };
+
+        struct PeriodicUpdateInfo
+        {
+            uint32 Interval;
+            void(*Handler)(Player* player, uint32 diff);    // diff is the time elapsed since the previous call
+        };
+
+        static PeriodicUpdateInfo const PeriodicUpdates[MAX_PERIODIC_UPDATES];
+
+        void UpdatePeriodic(uint32 diff);
+
+        std::array<uint32, MAX_PERIODIC_UPDATES> m_periodicUpdateElapsed;
 
     private:
         // internal common parts for CanStore/StoreItem functions
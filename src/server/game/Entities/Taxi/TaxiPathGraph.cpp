@@ -89,7 +89,7 @@ void TaxiPathGraph::AddVerticeAndEdgeFromNodeInfo(TaxiNodesEntry const* from, Ta
         TaxiPathNodeList const& nodes = sTaxiPathNodesByPath[pathId];
         if (nodes.size() < 2)
         {
-            edges.push_back(std::make_pair(edge(fromVertexID, toVertexID), EdgeCost{ to, 0xFFFF }));
+            edges.push_back(std::make_pair(edge(fromVertexID, toVertexID), EdgeCost{ toVertexID, 0xFFFF }));
             return;
         }
 
@@ -124,7 +124,7 @@ void TaxiPathGraph::AddVerticeAndEdgeFromNodeInfo(TaxiNodesEntry const* from, Ta
         if (dist > 0xFFFF)
             dist = 0xFFFF;
 
-        edges.push_back(std::make_pair(edge(fromVertexID, toVertexID), EdgeCost{ to, dist }));
+        edges.push_back(std::make_pair(edge(fromVertexID, toVertexID), EdgeCost{ toVertexID, dist }));
     }
 }
 
@@ -147,21 +147,10 @@ std::size_t TaxiPathGraph::GetCompleteNodeRoute(TaxiNodesEntry const* from, Taxi
     else
     {
         shortestPath.clear();
-        std::vector<vertex_descriptor> p(boost::num_vertices(m_graph));
-        std::vector<uint32> d(boost::num_vertices(m_graph));
-
-        boost::dijkstra_shortest_paths(m_graph, GetVertexIDFromNodeID(from),
-            boost::predecessor_map(boost::make_iterator_property_map(p.begin(), boost::get(boost::vertex_index, m_graph)))
-            .distance_map(boost::make_iterator_property_map(d.begin(), boost::get(boost::vertex_index, m_graph)))
-            .vertex_index_map(boost::get(boost::vertex_index, m_graph))
-            .distance_compare(std::less<uint32>())
-            .distance_combine(boost::closed_plus<uint32>())
-            .distance_inf(std::numeric_limits<uint32>::max())
-            .distance_zero(0)
-            .visitor(boost::dijkstra_visitor<boost::null_visitor>())
-            .weight_map(boost::make_transform_value_property_map(
-                [player](EdgeCost const& edgeCost) { return edgeCost.EvaluateDistance(player); },
-                boost::get(boost::edge_weight, m_graph))));
+
+        // the route only depends on which nodes the player can use, players sharing that set share the tree
+        std::shared_ptr<RouteTree const> tree = GetRouteTree(GetVertexIDFromNodeID(from), GetUsableVertices(player));
+        std::vector<vertex_descriptor> const& p = tree->Predecessors;
 
         // found a path to the goal
         for (vertex_descriptor v = GetVertexIDFromNodeID(to); ; v = p[v])
@@ -223,15 +212,66 @@ TaxiPathGraph::vertex_descriptor TaxiPathGraph::CreateVertexFromFromNodeInfoIfNe
     return itr->second;
 }
 
-uint32 TaxiPathGraph::EdgeCost::EvaluateDistance(Player const* player) const
+std::vector<bool> TaxiPathGraph::GetUsableVertices(Player const* player) const
 {
     uint32 requireFlag = (player->GetTeam() == ALLIANCE) ? TAXI_NODE_FLAG_ALLIANCE : TAXI_NODE_FLAG_HORDE;
-    if (!(To->Flags & requireFlag))
-        return std::numeric_limits<uint16>::max();
+    std::vector<bool> usableVertices(m_nodesByVertex.size());
+    for (std::size_t i = 0; i < m_nodesByVertex.size(); ++i)
+    {
+        TaxiNodesEntry const* node = m_nodesByVertex[i];
+        if (!(node->Flags & requireFlag))
+            continue;
+
+        if (PlayerConditionEntry const* condition = sPlayerConditionStore.LookupEntry(node->ConditionID))
+            if (!sConditionMgr->IsPlayerMeetingCondition(player, condition))
+                continue;
+
+        usableVertices[i] = true;
+    }
+
+    return usableVertices;
+}
 
-    if (PlayerConditionEntry const* condition = sPlayerConditionStore.LookupEntry(To->ConditionID))
-        if (!sConditionMgr->IsPlayerMeetingCondition(player, condition))
-            return std::numeric_limits<uint16>::max();
+std::shared_ptr<TaxiPathGraph::RouteTree const> TaxiPathGraph::GetRouteTree(vertex_descriptor from, std::vector<bool>&& usableVertices)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_routeTreesLock);
+        auto itr = std::find_if(m_routeTrees.begin(), m_routeTrees.end(), [&](std::shared_ptr<RouteTree const> const& tree)
+        {
+            return tree->From == from && tree->UsableVertices == usableVertices;
+        });
+
+        if (itr != m_routeTrees.end())
+        {
+            m_routeTrees.splice(m_routeTrees.begin(), m_routeTrees, itr);
+            return m_routeTrees.front();
+        }
+    }
 
-    return Distance;
+    std::shared_ptr<RouteTree> tree = std::make_shared<RouteTree>();
+    tree->From = from;
+    tree->UsableVertices = std::move(usableVertices);
+    tree->Predecessors.resize(boost::num_vertices(m_graph));
+    std::vector<uint32> d(boost::num_vertices(m_graph));
+
+    std::vector<bool> const& usable = tree->UsableVertices;
+    boost::dijkstra_shortest_paths(m_graph, from,
+        boost::predecessor_map(boost::make_iterator_property_map(tree->Predecessors.begin(), boost::get(boost::vertex_index, m_graph)))
+        .distance_map(boost::make_iterator_property_map(d.begin(), boost::get(boost::vertex_index, m_graph)))
+        .vertex_index_map(boost::get(boost::vertex_index, m_graph))
+        .distance_compare(std::less<uint32>())
+        .distance_combine(boost::closed_plus<uint32>())
+        .distance_inf(std::numeric_limits<uint32>::max())
+        .distance_zero(0)
+        .visitor(boost::dijkstra_visitor<boost::null_visitor>())
+        .weight_map(boost::make_transform_value_property_map(
+            [&usable](EdgeCost const& edgeCost) -> uint32 { return usable[edgeCost.ToVertex] ? edgeCost.Distance : std::numeric_limits<uint16>::max(); },
+            boost::get(boost::edge_weight, m_graph))));
+
+    std::lock_guard<std::mutex> lock(m_routeTreesLock);
+    m_routeTrees.push_front(tree);
+    if (m_routeTrees.size() > MaxCachedRouteTrees)
+        m_routeTrees.pop_back();
+
+    return tree;
 }
@@ -22,6 +22,9 @@
 #include "Define.h"
 #include "DBCEnums.h"
 #include <boost/graph/adjacency_list.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -38,18 +41,27 @@ public:
     void GetReachableNodesMask(TaxiNodesEntry const* from, TaxiMask* mask);
 
 private:
+    typedef boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS>::vertex_descriptor vertex_descriptor;
     struct EdgeCost
     {
-        TaxiNodesEntry const* To;
+        vertex_descriptor ToVertex;
         uint32 Distance;
-        uint32 EvaluateDistance(Player const* player) const;
     };
     typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::property<boost::vertex_index_t, uint32>, boost::property<boost::edge_weight_t, EdgeCost>> Graph;
     typedef boost::property_map<Graph, boost::edge_weight_t>::type WeightMap;
-    typedef Graph::vertex_descriptor vertex_descriptor;
     typedef Graph::edge_descriptor edge_descriptor;
     typedef std::pair<vertex_descriptor, vertex_descriptor> edge;
 
+    // Shortest path tree from one vertex, valid for every player that can use exactly the same set of nodes
+    struct RouteTree
+    {
+        vertex_descriptor From;
+        std::vector<bool> UsableVertices;
+        std::vector<vertex_descriptor> Predecessors;
+    };
+
+    static constexpr std::size_t MaxCachedRouteTrees = 64;
+
     TaxiPathGraph() { }
     ~TaxiPathGraph() { }
 
@@ -57,11 +69,17 @@ private:
     vertex_descriptor GetVertexIDFromNodeID(TaxiNodesEntry const* node);
     uint32 GetNodeIDFromVertexID(vertex_descriptor vertexID);
     vertex_descriptor CreateVertexFromFromNodeInfoIfNeeded(TaxiNodesEntry const* node);
+    std::vector<bool> GetUsableVertices(Player const* player) const;
+    std::shared_ptr<RouteTree const> GetRouteTree(vertex_descriptor from, std::vector<bool>&& usableVertices);
 
     Graph m_graph;
     std::vector<TaxiNodesEntry const*> m_nodesByVertex;
     std::unordered_map<uint32, vertex_descriptor> m_verticesByNode;
 
+    // most recently used first, flights are requested from map threads
+    std::list<std::shared_ptr<RouteTree const>> m_routeTrees;
+    std::mutex m_routeTreesLock;
+
     TaxiPathGraph(TaxiPathGraph const&) = delete;
     TaxiPathGraph& operator=(TaxiPathGraph const&) = delete;
 };
@@ -697,6 +697,19 @@ void Transport::DelayedTeleportTransport()
 
 void Transport::UpdatePassengerPositions(PassengerSet& passengers)
 {
+    if (passengers.empty())
+        return;
+
+    // every passenger is moved by the same transport position, rotate them all with one sin/cos pair
+    float transX, transY, transZ, transO;
+    GetPosition(transX, transY, transZ, transO);
+    float transCos = std::cos(transO);
+    float transSin = std::sin(transO);
+    auto calculatePassengerPosition = [&](float& x, float& y, float& z, float& o)
+    {
+        TransportBase::CalculatePassengerPosition(x, y, z, &o, transX, transY, transZ, transO, transCos, transSin);
+    };
+
     for (PassengerSet::iterator itr = passengers.begin(); itr != passengers.end(); ++itr)
     {
         WorldObject* passenger = *itr;
@@ -714,7 +727,7 @@ void Transport::UpdatePassengerPositions(PassengerSet& passengers)
         // as if regular movement occurred
         float x, y, z, o;
         passenger->m_movementInfo.transport.pos.GetPosition(x, y, z, o);
-        CalculatePassengerPosition(x, y, z, &o);
+        calculatePassengerPosition(x, y, z, o);
         switch (passenger->GetTypeId())
         {
             case TYPEID_UNIT:
@@ -722,7 +735,7 @@ void Transport::UpdatePassengerPositions(PassengerSet& passengers)
                 Creature* creature = passenger->ToCreature();
                 GetMap()->CreatureRelocation(creature, x, y, z, o, false);
                 creature->GetTransportHomePosition(x, y, z, o);
-                CalculatePassengerPosition(x, y, z, &o);
+                calculatePassengerPosition(x, y, z, o);
                 creature->SetHomePosition(x, y, z, o);
                 break;
             }
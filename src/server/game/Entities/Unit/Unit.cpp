@@ -82,6 +82,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "VehiclePackets.h"
+#include "ViewerDependentValues.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -303,6 +304,7 @@ Unit::Unit(bool isWorldObject) :
     WorldObject(isWorldObject), m_lastSanctuaryTime(0), LastCharmerGUID(), movespline(new Movement::MoveSpline()),
     m_ControlledByPlayer(false), m_AutoRepeatFirstCast(false), m_procDeep(0), m_transformSpell(0),
     m_removedAurasCount(0), m_interruptMask(SpellAuraInterruptFlags::None), m_interruptMask2(SpellAuraInterruptFlags2::None),
+    m_procAurasGeneration(sSpellMgr->GetSpellProcsGeneration()),
     m_unitMovedByMe(nullptr), m_playerMovingMe(nullptr), m_charmer(nullptr), m_charmed(nullptr),
     i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_vehicle(nullptr),
     m_vehicleKit(nullptr), m_unitTypeMask(UNIT_MASK_NONE), m_Diminishing(), m_combatManager(this),
@@ -341,6 +343,8 @@ Unit::Unit(bool isWorldObject) :
     m_auraUpdateIterator = m_ownedAuras.end();
 
     m_canModifyStats = false;
+    m_pendingUnitModUpdates = 0;
+    m_statUpdateBatchDepth = 0;
 
     for (uint8 i = 0; i < UNIT_MOD_END; ++i)
     {
@@ -455,8 +459,6 @@ void Unit::Update(uint32 p_time)
     // Having this would prevent spells from being proced, so let's crash
     ASSERT(!m_procDeep);
 
-    m_combatManager.Update(p_time);
-
     // not implemented before 3.0.2
     if (uint32 base_att = getAttackTimer(BASE_ATTACK))
         setAttackTimer(BASE_ATTACK, (p_time >= base_att ? 0 : base_att - p_time));
@@ -3195,8 +3197,10 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
         AddInterruptMask(aurSpellInfo->AuraInterruptFlags, aurSpellInfo->AuraInterruptFlags2);
     }
 
+    AddProcAura(aurApp);
+
     if (AuraStateType aState = aura->GetSpellInfo()->GetAuraState())
-        m_auraStateAuras.insert(AuraStateAurasMap::value_type(aState, aurApp));
+        m_auraStateAuras[aState].push_back(aurApp);
 
     aura->_ApplyForTarget(this, caster, aurApp);
     return aurApp;
@@ -3290,24 +3294,19 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
         UpdateInterruptMask();
     }
 
+    m_procAuras.erase(std::remove_if(m_procAuras.begin(), m_procAuras.end(), [aurApp](AuraProcIndexEntry const& entry)
+    {
+        return entry.Application == aurApp;
+    }), m_procAuras.end());
+
     bool auraStateFound = false;
     AuraStateType auraState = aura->GetSpellInfo()->GetAuraState();
     if (auraState)
     {
-        bool canBreak = false;
         // Get mask of all aurastates from remaining auras
-        for (AuraStateAurasMap::iterator itr = m_auraStateAuras.lower_bound(auraState); itr != m_auraStateAuras.upper_bound(auraState) && !(auraStateFound && canBreak);)
-        {
-            if (itr->second == aurApp)
-            {
-                m_auraStateAuras.erase(itr);
-                itr = m_auraStateAuras.lower_bound(auraState);
-                canBreak = true;
-                continue;
-            }
-            auraStateFound = true;
-            ++itr;
-        }
+        std::vector<AuraApplication*>& auraStateAuras = m_auraStateAuras[auraState];
+        auraStateAuras.erase(std::remove(auraStateAuras.begin(), auraStateAuras.end(), aurApp), auraStateAuras.end());
+        auraStateFound = !auraStateAuras.empty();
     }
 
     aurApp->_Remove();
@@ -3409,6 +3408,8 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
 
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
+
     if (apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
@@ -4697,103 +4698,161 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(Aur
     return modifier;
 }
 
+template<typename T, typename Calculator>
+T Unit::GetCachedAuraModifier(AuraType auraType, AuraModifierCacheKind kind, uint32 miscKey, Calculator const& calculate) const
+{
+    // nothing to aggregate, don't bother creating an entry
+    if (m_modAuras[auraType].empty())
+        return calculate();
+
+    std::vector<AuraModifierCacheEntry>& entries = m_auraModifierCache[auraType];
+    for (AuraModifierCacheEntry const& entry : entries)
+        if (entry.Kind == kind && entry.MiscKey == miscKey)
+            return T(entry.Value);
+
+    T value = calculate();
+    entries.push_back({ kind, miscKey, double(value) });
+    return value;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auraType) const
 {
-    return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_TOTAL, 0, [&]()
+    {
+        return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auraType) const
 {
-    return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<float>(auraType, AURA_MODIFIER_CACHE_MULTIPLIER, 0, [&]()
+    {
+        return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_MAX_POSITIVE, 0, [&]()
+    {
+        return GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_MAX_NEGATIVE, 0, [&]()
+    {
+        return GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_TOTAL_BY_MISC_MASK, miscMask, [&]()
     {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
+        return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+        {
+            if ((aurEff->GetMiscValue() & miscMask) != 0)
+                return true;
+            return false;
+        });
     });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<float>(auraType, AURA_MODIFIER_CACHE_MULTIPLIER_BY_MISC_MASK, miscMask, [&]()
     {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
+        return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+        {
+            if ((aurEff->GetMiscValue() & miscMask) != 0)
+                return true;
+            return false;
+        });
     });
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscMask, AuraEffect const* except /*= nullptr*/) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscMask, except](AuraEffect const* aurEff) -> bool
+    auto calculate = [&]()
     {
-        if (except != aurEff && (aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
-    });
+        return GetMaxPositiveAuraModifier(auraType, [miscMask, except](AuraEffect const* aurEff) -> bool
+        {
+            if (except != aurEff && (aurEff->GetMiscValue() & miscMask) != 0)
+                return true;
+            return false;
+        });
+    };
+
+    if (except)
+        return calculate();
+
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MISC_MASK, miscMask, calculate);
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MISC_MASK, miscMask, [&]()
     {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
+        return GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+        {
+            if ((aurEff->GetMiscValue() & miscMask) != 0)
+                return true;
+            return false;
+        });
     });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_TOTAL_BY_MISC_VALUE, uint32(miscValue), [&]()
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<float>(auraType, AURA_MODIFIER_CACHE_MULTIPLIER_BY_MISC_VALUE, uint32(miscValue), [&]()
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MISC_VALUE, uint32(miscValue), [&]()
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MISC_VALUE, uint32(miscValue), [&]()
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
@@ -5697,10 +5756,20 @@ void Unit::ModifyAuraState(AuraStateType flag, bool apply)
 uint32 Unit::BuildAuraStateUpdateForTarget(Unit const* target) const
 {
     uint32 auraStates = *m_unitData->AuraState & ~(PER_CASTER_AURA_STATE_MASK);
-    for (AuraStateAurasMap::const_iterator itr = m_auraStateAuras.begin(); itr != m_auraStateAuras.end(); ++itr)
-        if ((1 << (itr->first - 1)) & PER_CASTER_AURA_STATE_MASK)
-            if (itr->second->GetBase()->GetCasterGUID() == target->GetGUID())
-                auraStates |= (1 << (itr->first - 1));
+    for (uint32 auraState = AURA_STATE_NONE + 1; auraState < MAX_AURA_STATE; ++auraState)
+    {
+        if (!((1 << (auraState - 1)) & PER_CASTER_AURA_STATE_MASK))
+            continue;
+
+        for (AuraApplication const* aurApp : m_auraStateAuras[auraState])
+        {
+            if (aurApp->GetBase()->GetCasterGUID() == target->GetGUID())
+            {
+                auraStates |= (1 << (auraState - 1));
+                break;
+            }
+        }
+    }
 
     return auraStates;
 }
@@ -5719,9 +5788,8 @@ bool Unit::HasAuraState(AuraStateType flag, SpellInfo const* spellProto, Unit co
         // If aura with aurastate by caster not found return false
         if ((1 << (flag - 1)) & PER_CASTER_AURA_STATE_MASK)
         {
-            AuraStateAurasMapBounds range = m_auraStateAuras.equal_range(flag);
-            for (AuraStateAurasMap::const_iterator itr = range.first; itr != range.second; ++itr)
-                if (itr->second->GetBase()->GetCasterGUID() == Caster->GetGUID())
+            for (AuraApplication const* aurApp : m_auraStateAuras[flag])
+                if (aurApp->GetBase()->GetCasterGUID() == Caster->GetGUID())
                     return true;
             return false;
         }
@@ -8659,6 +8727,80 @@ void Unit::UpdateUnitMod(UnitMods unitMod)
     if (!CanModifyStats())
         return;
 
+    if (m_statUpdateBatchDepth)
+    {
+        m_pendingUnitModUpdates |= UI64LIT(1) << unitMod;
+        return;
+    }
+
+    RecalculateUnitMod(unitMod);
+}
+
+// UnitMods that recalculating unitMod recalculates as well, they are not recalculated again when flushing a stat update batch
+static uint64 GetUnitModsRecalculatedWith(Unit const* unit, UnitMods unitMod)
+{
+    auto mask = [](std::initializer_list<UnitMods> unitMods)
+    {
+        uint64 result = 0;
+        for (UnitMods mod : unitMods)
+            result |= UI64LIT(1) << mod;
+        return result;
+    };
+
+    // every UpdateAttackPowerAndDamage implementation updates weapon damage
+    switch (unitMod)
+    {
+        case UNIT_MOD_ATTACK_POWER:        return mask({ UNIT_MOD_DAMAGE_MAINHAND });
+        case UNIT_MOD_ATTACK_POWER_RANGED: return mask({ UNIT_MOD_DAMAGE_RANGED });
+        default:
+            break;
+    }
+
+    if (!unit->IsPlayer())
+        return 0;
+
+    // Player::UpdateStats always updates armor, which updates melee attack power
+    switch (unitMod)
+    {
+        case UNIT_MOD_STAT_STRENGTH:
+        case UNIT_MOD_STAT_INTELLECT:
+        case UNIT_MOD_ARMOR:
+            return mask({ UNIT_MOD_ARMOR, UNIT_MOD_ATTACK_POWER, UNIT_MOD_DAMAGE_MAINHAND });
+        case UNIT_MOD_STAT_AGILITY:
+            return mask({ UNIT_MOD_ARMOR, UNIT_MOD_ATTACK_POWER, UNIT_MOD_DAMAGE_MAINHAND, UNIT_MOD_ATTACK_POWER_RANGED, UNIT_MOD_DAMAGE_RANGED });
+        case UNIT_MOD_STAT_STAMINA:
+            return mask({ UNIT_MOD_HEALTH, UNIT_MOD_ARMOR, UNIT_MOD_ATTACK_POWER, UNIT_MOD_DAMAGE_MAINHAND });
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+void Unit::EndStatUpdateBatch()
+{
+    ASSERT(m_statUpdateBatchDepth);
+    if (--m_statUpdateBatchDepth)
+        return;
+
+    uint64 pending = std::exchange(m_pendingUnitModUpdates, 0);
+    if (!CanModifyStats())
+        return;
+
+    // UnitMods are ordered so that everything derived from a value comes after it (stats, health and power, armor, attack power, damage)
+    for (uint8 i = 0; pending && i < UNIT_MOD_END; ++i)
+    {
+        uint64 bit = UI64LIT(1) << i;
+        if (!(pending & bit))
+            continue;
+
+        pending &= ~(bit | GetUnitModsRecalculatedWith(this, UnitMods(i)));
+        RecalculateUnitMod(UnitMods(i));
+    }
+}
+
+void Unit::RecalculateUnitMod(UnitMods unitMod)
+{
     switch (unitMod)
     {
         case UNIT_MOD_STAT_STRENGTH:
@@ -9718,6 +9860,30 @@ void Unit::ProcSkillsAndReactives(bool isVictim, Unit* procTarget, uint32 typeMa
     }
 }
 
+void Unit::AddProcAura(AuraApplication* aurApp)
+{
+    SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(aurApp->GetBase()->GetSpellInfo());
+    if (!procEntry)
+        return;
+
+    // keep procs triggering in the same order as m_appliedAuras
+    uint32 spellId = aurApp->GetBase()->GetId();
+    auto itr = std::upper_bound(m_procAuras.begin(), m_procAuras.end(), spellId, [](uint32 id, AuraProcIndexEntry const& entry)
+    {
+        return id < entry.Application->GetBase()->GetId();
+    });
+    m_procAuras.insert(itr, { aurApp, procEntry->ProcFlags });
+}
+
+void Unit::RebuildProcAuraIndex()
+{
+    m_procAuras.clear();
+    for (AuraApplicationMap::value_type const& pair : m_appliedAuras)
+        AddProcAura(pair.second);
+
+    m_procAurasGeneration = sSpellMgr->GetSpellProcsGeneration();
+}
+
 void Unit::GetProcAurasTriggeredOnEvent(AuraApplicationProcContainer& aurasTriggeringProc, AuraApplicationList* procAuras, ProcEventInfo& eventInfo)
 {
     TimePoint now = GameTime::Now();
@@ -9738,12 +9904,22 @@ void Unit::GetProcAurasTriggeredOnEvent(AuraApplicationProcContainer& aurasTrigg
     // or generate one on our own
     else
     {
-        for (AuraApplicationMap::iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+        // spell_proc was reloaded, cached proc flags may be outdated
+        if (m_procAurasGeneration != sSpellMgr->GetSpellProcsGeneration())
+            RebuildProcAuraIndex();
+
+        // only auras with spell proc entry can trigger proc, skip ones that can't match this event type at all
+        // indexed loop - proc check and prepare scripts may apply or remove auras
+        for (std::size_t i = 0; i < m_procAuras.size(); ++i)
         {
-            if (uint32 procEffectMask = itr->second->GetBase()->GetProcEffectMask(itr->second, eventInfo, now))
+            if (!(eventInfo.GetTypeMask() & m_procAuras[i].ProcFlags))
+                continue;
+
+            AuraApplication* aurApp = m_procAuras[i].Application;
+            if (uint32 procEffectMask = aurApp->GetBase()->GetProcEffectMask(aurApp, eventInfo, now))
             {
-                itr->second->GetBase()->PrepareProcToTrigger(itr->second, eventInfo, now);
-                aurasTriggeringProc.emplace_back(procEffectMask, itr->second);
+                aurApp->GetBase()->PrepareProcToTrigger(aurApp, eventInfo, now);
+                aurasTriggeringProc.emplace_back(procEffectMask, aurApp);
             }
         }
     }
@@ -11497,13 +11673,13 @@ void Unit::SetAuraStack(uint32 spellId, Unit* target, uint32 stack)
 void Unit::CancelSpellMissiles(uint32 spellId, bool reverseMissile /*= false*/)
 {
     bool hasMissile = false;
-    for (std::pair<uint64 const, BasicEvent*> const& itr : m_Events.GetEvents())
+    for (EventProcessor::QueuedEvent const& queued : m_Events.GetEvents())
     {
-        if (Spell const* spell = Spell::ExtractSpellFromEvent(itr.second))
+        if (Spell const* spell = Spell::ExtractSpellFromEvent(queued.Event))
         {
             if (spell->GetSpellInfo()->Id == spellId)
             {
-                itr.second->ScheduleAbort();
+                queued.Event->ScheduleAbort();
                 hasMissile = true;
             }
         }
@@ -13099,6 +13275,38 @@ void Unit::BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::
     data->AddUpdateBlock(buffer);
 }
 
+bool Unit::HasViewerDependentChanges() const
+{
+    if (m_values.HasChanged(TYPEID_OBJECT) && m_objectData->HasChanged(&UF::ObjectData::DynamicFlags))
+        return true;
+
+    if (m_values.HasChanged(TYPEID_UNIT))
+    {
+        if (m_unitData->HasChanged(&UF::UnitData::DisplayID)
+            || m_unitData->HasChanged(&UF::UnitData::NpcFlags)
+            || m_unitData->HasChanged(&UF::UnitData::FactionTemplate)
+            || m_unitData->HasChanged(&UF::UnitData::Flags)
+            || m_unitData->HasChanged(&UF::UnitData::AuraState)
+            || m_unitData->HasChanged(&UF::UnitData::PvpFlags))
+            return true;
+    }
+
+    return false;
+}
+
+bool Unit::GetViewerDependentCreateValues(Player const* target, std::vector<uint32>& values) const
+{
+    values.push_back(UF::ViewerDependentValue<UF::ObjectData::DynamicFlagsTag>::GetValue(&*m_objectData, this, target));
+    values.push_back(uint32(UF::ViewerDependentValue<UF::UnitData::DisplayIDTag>::GetValue(&*m_unitData, this, target)));
+    for (uint32 i = 0; i < m_unitData->NpcFlags.size(); ++i)
+        values.push_back(UF::ViewerDependentValue<UF::UnitData::NpcFlagsTag>::GetValue(&*m_unitData, i, this, target));
+    values.push_back(uint32(UF::ViewerDependentValue<UF::UnitData::FactionTemplateTag>::GetValue(&*m_unitData, this, target)));
+    values.push_back(UF::ViewerDependentValue<UF::UnitData::FlagsTag>::GetValue(&*m_unitData, this, target));
+    values.push_back(UF::ViewerDependentValue<UF::UnitData::AuraStateTag>::GetValue(&*m_unitData, this, target));
+    values.push_back(UF::ViewerDependentValue<UF::UnitData::PvpFlagsTag>::GetValue(&*m_unitData, this, target));
+    return true;
+}
+
 void Unit::DestroyForPlayer(Player* target) const
 {
     if (Battleground* bg = target->GetBattleground())
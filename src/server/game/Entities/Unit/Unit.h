@@ -208,6 +208,7 @@ enum UnitMods
 };
 
 static_assert(UNIT_MOD_POWER_END - UNIT_MOD_POWER_START == MAX_POWERS, "UnitMods powers section does not match Powers enum!");
+static_assert(UNIT_MOD_END <= 64, "UnitMods must fit in Unit::m_pendingUnitModUpdates!");
 
 enum BaseModGroup
 {
@@ -755,8 +756,7 @@ class TC_GAME_API Unit : public WorldObject
         typedef std::pair<AuraApplicationMap::const_iterator, AuraApplicationMap::const_iterator> AuraApplicationMapBounds;
         typedef std::pair<AuraApplicationMap::iterator, AuraApplicationMap::iterator> AuraApplicationMapBoundsNonConst;
 
-        typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
-        typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
+        typedef std::array<std::vector<AuraApplication*>, MAX_AURA_STATE> AuraStateAurasMap;
 
         typedef std::list<AuraEffect*> AuraEffectList;
         typedef std::list<Aura*> AuraList;
@@ -1451,6 +1451,8 @@ class TC_GAME_API Unit : public WorldObject
         float GetTotalAuraMultiplierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const;
         int32 GetMaxPositiveAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const;
         int32 GetMaxNegativeAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const;
+        // drops cached GetTotalAuraModifier family results, must be called whenever an effect of this type is added, removed or changes amount
+        void InvalidateAuraModifierCache(AuraType auraType) { m_auraModifierCache.erase(auraType); }
 
         void InitStatBuffMods();
         void UpdateStatBuffMod(Stats stat);
@@ -1552,6 +1554,10 @@ class TC_GAME_API Unit : public WorldObject
 
         void UpdateUnitMod(UnitMods unitMod);
 
+        // UpdateUnitMod calls between Begin and End only mark the UnitMods as modified, each of them is recalculated once by the outermost End
+        void BeginStatUpdateBatch() { ++m_statUpdateBatchDepth; }
+        void EndStatUpdateBatch();
+
         // only players have item requirements
         virtual bool CheckAttackFitToAuraRequirement(WeaponAttackType /*attackType*/, AuraEffect const* /*aurEff*/) const { return true; }
 
@@ -1870,6 +1876,8 @@ class TC_GAME_API Unit : public WorldObject
         void BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag flags, Player const* target) const override;
         void BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
             UF::UnitData::Mask const& requestedUnitMask, Player const* target) const;
+        bool HasViewerDependentChanges() const override;
+        bool GetViewerDependentCreateValues(Player const* target, std::vector<uint32>& values) const override;
 
     protected:
         void DestroyForPlayer(Player* target) const override;
@@ -1915,16 +1923,60 @@ class TC_GAME_API Unit : public WorldObject
         uint32 m_removedAurasCount;
 
         AuraEffectList m_modAuras[TOTAL_AURAS];
+
+        enum AuraModifierCacheKind : uint8
+        {
+            AURA_MODIFIER_CACHE_TOTAL,
+            AURA_MODIFIER_CACHE_MULTIPLIER,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE,
+            AURA_MODIFIER_CACHE_TOTAL_BY_MISC_MASK,
+            AURA_MODIFIER_CACHE_MULTIPLIER_BY_MISC_MASK,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MISC_MASK,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MISC_MASK,
+            AURA_MODIFIER_CACHE_TOTAL_BY_MISC_VALUE,
+            AURA_MODIFIER_CACHE_MULTIPLIER_BY_MISC_VALUE,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MISC_VALUE,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MISC_VALUE
+        };
+
+        struct AuraModifierCacheEntry
+        {
+            AuraModifierCacheKind Kind;
+            uint32 MiscKey;
+            double Value;                          // wide enough to hold both int32 modifiers and float multipliers exactly
+        };
+
+        template<typename T, typename Calculator>
+        T GetCachedAuraModifier(AuraType auraType, AuraModifierCacheKind kind, uint32 miscKey, Calculator const& calculate) const;
+
+        mutable std::unordered_map<uint32, std::vector<AuraModifierCacheEntry>> m_auraModifierCache; // aggregates of m_modAuras by AuraType, see InvalidateAuraModifierCache
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
         EnumFlag<SpellAuraInterruptFlags> m_interruptMask;
         EnumFlag<SpellAuraInterruptFlags2> m_interruptMask2;
 
+        struct AuraProcIndexEntry
+        {
+            AuraApplication* Application;
+            uint32 ProcFlags;
+        };
+
+        void AddProcAura(AuraApplication* aurApp);
+        void RebuildProcAuraIndex();
+
+        std::vector<AuraProcIndexEntry> m_procAuras; // applied auras with spell_proc entry, in m_appliedAuras order
+        uint32 m_procAurasGeneration;
+
+        void RecalculateUnitMod(UnitMods unitMod);
+
         float m_auraFlatModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_FLAT_END];
         float m_auraPctModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_PCT_END];
         float m_weaponDamage[MAX_ATTACK][2];
         bool m_canModifyStats;
+        uint64 m_pendingUnitModUpdates;                     // bit per UnitMods modified inside a stat update batch
+        uint32 m_statUpdateBatchDepth;
 
         VisibleAuraContainer m_visibleAuras;
         boost::container::flat_set<AuraApplication*, VisibleAuraSlotCompare> m_visibleAurasToUpdate;
@@ -553,16 +553,24 @@ void Vehicle::RelocatePassengers()
     std::vector<std::pair<Unit*, Position>> seatRelocation;
     seatRelocation.reserve(Seats.size());
 
+    float baseX, baseY, baseZ, baseO;
+    GetBase()->GetPosition(baseX, baseY, baseZ, baseO);
+    float const baseCos = std::cos(baseO);
+    float const baseSin = std::sin(baseO);
+
     // not sure that absolute position calculation is correct, it must depend on vehicle pitch angle
     for (SeatMap::const_iterator itr = Seats.begin(); itr != Seats.end(); ++itr)
     {
+        if (itr->second.Passenger.Guid.IsEmpty())
+            continue;
+
         if (Unit* passenger = ObjectAccessor::GetUnit(*GetBase(), itr->second.Passenger.Guid))
         {
             ASSERT(passenger->IsInWorld());
 
             float px, py, pz, po;
             passenger->m_movementInfo.transport.pos.GetPosition(px, py, pz, po);
-            CalculatePassengerPosition(px, py, pz, &po);
+            TransportBase::CalculatePassengerPosition(px, py, pz, &po, baseX, baseY, baseZ, baseO, baseCos, baseSin);
 
             seatRelocation.emplace_back(passenger, Position(px, py, pz, po));
         }
@@ -162,13 +162,19 @@ public:
     virtual void CalculatePassengerOffset(float& x, float& y, float& z, float* o = nullptr) const = 0;
 
     static void CalculatePassengerPosition(float& x, float& y, float& z, float* o, float transX, float transY, float transZ, float transO)
+    {
+        CalculatePassengerPosition(x, y, z, o, transX, transY, transZ, transO, std::cos(transO), std::sin(transO));
+    }
+
+    /// Same as above with cos and sin of transO already computed, for transforming many passengers by the same transport position
+    static void CalculatePassengerPosition(float& x, float& y, float& z, float* o, float transX, float transY, float transZ, float transO, float transCos, float transSin)
     {
         float inx = x, iny = y, inz = z;
         if (o)
             *o = Position::NormalizeOrientation(transO + *o);
 
-        x = transX + inx * std::cos(transO) - iny * std::sin(transO);
-        y = transY + iny * std::cos(transO) + inx * std::sin(transO);
+        x = transX + inx * transCos - iny * transSin;
+        y = transY + iny * transCos + inx * transSin;
         z = transZ + inz;
     }
 
@@ -421,6 +421,8 @@ void GameEventMgr::LoadFromDB()
 
                 GuidList& crelist = mGameEventCreatureGuids[internal_event_id];
                 crelist.push_back(guid);
+                if (event_id > 0)
+                    mCreatureGuidEvents[guid].push_back(event_id);
 
                 ++count;
             }
@@ -471,6 +473,8 @@ void GameEventMgr::LoadFromDB()
 
                 GuidList& golist = mGameEventGameobjectGuids[internal_event_id];
                 golist.push_back(guid);
+                if (event_id > 0)
+                    mGameObjectGuidEvents[guid].push_back(event_id);
 
                 ++count;
             }
@@ -1227,19 +1231,28 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
-    for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
+    // spawns are grouped by map so every map is looked up only once per event
+    std::unordered_map<uint32, std::vector<std::pair<ObjectGuid::LowType, CreatureData const*>>> creaturesByMap;
+    for (ObjectGuid::LowType spawnId : mGameEventCreatureGuids[internal_event_id])
     {
         // Add to correct cell
-        if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
+        if (CreatureData const* data = sObjectMgr->GetCreatureData(spawnId))
         {
             sObjectMgr->AddCreatureToGrid(data);
+            creaturesByMap[data->mapId].emplace_back(spawnId, data);
+        }
+    }
 
+    for (auto const& [mapId, creatures] : creaturesByMap)
+    {
+        Map* map = sMapMgr->CreateBaseMap(mapId);
+        for (auto const& [spawnId, data] : creatures)
+        {
             // Spawn if necessary (loaded grids only)
-            Map* map = sMapMgr->CreateBaseMap(data->mapId);
-            map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, *itr);
+            map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, spawnId);
             // We use spawn coords to spawn
-            if (map && !map->Instanceable() && map->IsGridLoaded(data->spawnPoint))
-                Creature::CreateCreatureFromDB(*itr, map);
+            if (!map->Instanceable() && map->IsGridLoaded(data->spawnPoint))
+                Creature::CreateCreatureFromDB(spawnId, map);
         }
     }
 
@@ -1250,20 +1263,29 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
-    for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
+    std::unordered_map<uint32, std::vector<std::pair<ObjectGuid::LowType, GameObjectData const*>>> gameobjectsByMap;
+    for (ObjectGuid::LowType spawnId : mGameEventGameobjectGuids[internal_event_id])
     {
         // Add to correct cell
-        if (GameObjectData const* data = sObjectMgr->GetGameObjectData(*itr))
+        if (GameObjectData const* data = sObjectMgr->GetGameObjectData(spawnId))
         {
             sObjectMgr->AddGameobjectToGrid(data);
+            gameobjectsByMap[data->mapId].emplace_back(spawnId, data);
+        }
+    }
+
+    for (auto const& [mapId, gameobjects] : gameobjectsByMap)
+    {
+        // this base map checked as non-instanced and then only existed
+        Map* map = sMapMgr->CreateBaseMap(mapId);
+        for (auto const& [spawnId, data] : gameobjects)
+        {
             // Spawn if necessary (loaded grids only)
-            // this base map checked as non-instanced and then only existed
-            Map* map = sMapMgr->CreateBaseMap(data->mapId);
-            map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, *itr);
+            map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, spawnId);
             // We use current coords to unspawn, not spawn coords since creature can have changed grid
-            if (map && !map->Instanceable() && map->IsGridLoaded(data->spawnPoint))
+            if (!map->Instanceable() && map->IsGridLoaded(data->spawnPoint))
             {
-                if (GameObject* go = GameObject::CreateGameObjectFromDB(*itr, map, false))
+                if (GameObject* go = GameObject::CreateGameObjectFromDB(spawnId, map, false))
                 {
                     /// @todo find out when it is add to map
                     if (go->isSpawnedByDefault())
@@ -1298,28 +1320,36 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
-    for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> creaturesByMap;
+    for (ObjectGuid::LowType spawnId : mGameEventCreatureGuids[internal_event_id])
     {
         // check if it's needed by another event, if so, don't remove
-        if (event_id > 0 && hasCreatureActiveEventExcept(*itr, event_id))
+        if (event_id > 0 && hasCreatureActiveEventExcept(spawnId, event_id))
             continue;
         // Remove the creature from grid
-        if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
+        if (CreatureData const* data = sObjectMgr->GetCreatureData(spawnId))
         {
             sObjectMgr->RemoveCreatureFromGrid(data);
+            creaturesByMap[data->mapId].push_back(spawnId);
+        }
+    }
 
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr](Map* map)
+    for (auto const& [mapId, spawnIds] : creaturesByMap)
+    {
+        sMapMgr->DoForAllMapsWithMapId(mapId, [&spawnIds = spawnIds](Map* map)
+        {
+            for (ObjectGuid::LowType spawnId : spawnIds)
             {
-                map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, *itr);
-                auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = creatureBounds.first; itr2 != creatureBounds.second;)
+                map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, spawnId);
+                auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(spawnId);
+                for (auto itr = creatureBounds.first; itr != creatureBounds.second;)
                 {
-                    Creature* creature = itr2->second;
-                    ++itr2;
+                    Creature* creature = itr->second;
+                    ++itr;
                     creature->AddObjectToRemoveList();
                 }
-            });
-        }
+            }
+        });
     }
 
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventGameobjectGuids.size()))
@@ -1329,28 +1359,36 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
-    for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> gameobjectsByMap;
+    for (ObjectGuid::LowType spawnId : mGameEventGameobjectGuids[internal_event_id])
     {
         // check if it's needed by another event, if so, don't remove
-        if (event_id >0 && hasGameObjectActiveEventExcept(*itr, event_id))
+        if (event_id > 0 && hasGameObjectActiveEventExcept(spawnId, event_id))
             continue;
         // Remove the gameobject from grid
-        if (GameObjectData const* data = sObjectMgr->GetGameObjectData(*itr))
+        if (GameObjectData const* data = sObjectMgr->GetGameObjectData(spawnId))
         {
             sObjectMgr->RemoveGameobjectFromGrid(data);
+            gameobjectsByMap[data->mapId].push_back(spawnId);
+        }
+    }
 
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr](Map* map)
+    for (auto const& [mapId, spawnIds] : gameobjectsByMap)
+    {
+        sMapMgr->DoForAllMapsWithMapId(mapId, [&spawnIds = spawnIds](Map* map)
+        {
+            for (ObjectGuid::LowType spawnId : spawnIds)
             {
-                map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, *itr);
-                auto gameobjectBounds = map->GetGameObjectBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = gameobjectBounds.first; itr2 != gameobjectBounds.second;)
+                map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, spawnId);
+                auto gameobjectBounds = map->GetGameObjectBySpawnIdStore().equal_range(spawnId);
+                for (auto itr = gameobjectBounds.first; itr != gameobjectBounds.second;)
                 {
-                    GameObject* go = itr2->second;
-                    ++itr2;
+                    GameObject* go = itr->second;
+                    ++itr;
                     go->AddObjectToRemoveList();
                 }
-            });
-        }
+            }
+        });
     }
 
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventPoolIds.size()))
@@ -1452,34 +1490,26 @@ bool GameEventMgr::hasGameObjectQuestActiveEventExcept(uint32 quest_id, uint16 e
 }
 bool GameEventMgr::hasCreatureActiveEventExcept(ObjectGuid::LowType creature_id, uint16 event_id)
 {
-    for (ActiveEvents::iterator e_itr = m_ActiveEvents.begin(); e_itr != m_ActiveEvents.end(); ++e_itr)
-    {
-        if ((*e_itr) != event_id)
-        {
-            int32 internal_event_id = mGameEvent.size() + (*e_itr) - 1;
-            for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin();
-                itr != mGameEventCreatureGuids[internal_event_id].end();
-                ++ itr)
-                if (*itr == creature_id)
-                    return true;
-        }
-    }
+    auto itr = mCreatureGuidEvents.find(creature_id);
+    if (itr == mCreatureGuidEvents.end())
+        return false;
+
+    for (uint16 otherEventId : itr->second)
+        if (otherEventId != event_id && IsActiveEvent(otherEventId))
+            return true;
+
     return false;
 }
 bool GameEventMgr::hasGameObjectActiveEventExcept(ObjectGuid::LowType go_id, uint16 event_id)
 {
-    for (ActiveEvents::iterator e_itr = m_ActiveEvents.begin(); e_itr != m_ActiveEvents.end(); ++e_itr)
-    {
-        if ((*e_itr) != event_id)
-        {
-            int32 internal_event_id = mGameEvent.size() + (*e_itr) - 1;
-            for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin();
-                itr != mGameEventGameobjectGuids[internal_event_id].end();
-                ++ itr)
-                if (*itr == go_id)
-                    return true;
-        }
-    }
+    auto itr = mGameObjectGuidEvents.find(go_id);
+    if (itr == mGameObjectGuidEvents.end())
+        return false;
+
+    for (uint16 otherEventId : itr->second)
+        if (otherEventId != event_id && IsActiveEvent(otherEventId))
+            return true;
+
     return false;
 }
 
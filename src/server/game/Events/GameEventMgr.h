@@ -168,6 +168,8 @@ class TC_GAME_API GameEventMgr
         GameEventBattlegroundMap mGameEventBattlegroundHolidays;
         QuestIdToEventConditionMap mQuestToEventConditions;
         GameEventNPCFlagMap mGameEventNPCFlags;
+        std::unordered_map<ObjectGuid::LowType, std::vector<uint16>> mCreatureGuidEvents;      // positive events spawning the creature
+        std::unordered_map<ObjectGuid::LowType, std::vector<uint16>> mGameObjectGuidEvents;    // positive events spawning the gameobject
         ActiveEvents m_ActiveEvents;
         bool isSystemInit;
 
@@ -24,12 +24,13 @@
 #include "ObjectGridLoader.h"
 #include "Player.h"
 #include "World.h"
+#include <map>
 
 class GarrisonGridLoader
 {
 public:
     GarrisonGridLoader(NGridType* grid, GarrisonMap* map, Cell const& cell)
-        : i_cell(cell), i_grid(grid), i_map(map), i_garrison(map->GetGarrison()), i_gameObjects(0), i_creatures(0)
+        : i_cell(cell), i_grid(grid), i_map(map), i_garrison(map->GetGarrison()), i_plots(nullptr), i_gameObjects(0), i_creatures(0)
     { }
 
     void Visit(GameObjectMapType& m);
@@ -38,13 +39,14 @@ public:
     void LoadN();
 
     template<class T> static void SetObjectCell(T* obj, CellCoord const& cellCoord);
-    template<class T> void Visit(GridRefManager<T>& /*m*/) { }
+    template<class T> void Visit(GridObjectContainer<T>& /*m*/) { }
 
 private:
     Cell i_cell;
     NGridType* i_grid;
     GarrisonMap* i_map;
     Garrison* i_garrison;
+    std::vector<Garrison::Plot*> const* i_plots;
     uint32 i_gameObjects;
     uint32 i_creatures;
 };
@@ -53,19 +55,30 @@ void GarrisonGridLoader::LoadN()
 {
     if (i_garrison)
     {
-        i_cell.data.Part.cell_y = 0;
-        for (uint32 x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
+        // only visit the cells holding a plot of this grid instead of all of them
+        std::map<std::pair<uint32 /*cell_x*/, uint32 /*cell_y*/>, std::vector<Garrison::Plot*>> plotsByCell;
+        for (Garrison::Plot* plot : i_garrison->GetPlots())
         {
-            i_cell.data.Part.cell_x = x;
-            for (uint32 y = 0; y < MAX_NUMBER_OF_CELLS; ++y)
-            {
-                i_cell.data.Part.cell_y = y;
-
-                //Load creatures and game objects
-                TypeContainerVisitor<GarrisonGridLoader, GridTypeMapContainer> visitor(*this);
-                i_grid->VisitGrid(x, y, visitor);
-            }
+            Position const& spawn = plot->PacketInfo.PlotPos.Pos;
+            Cell plotCell(spawn.GetPositionX(), spawn.GetPositionY());
+            if (plotCell.DiffGrid(i_cell))
+                continue;
+
+            plotsByCell[std::make_pair(plotCell.CellX(), plotCell.CellY())].push_back(plot);
         }
+
+        for (auto const& [cell, plots] : plotsByCell)
+        {
+            i_cell.data.Part.cell_x = cell.first;
+            i_cell.data.Part.cell_y = cell.second;
+            i_plots = &plots;
+
+            //Load creatures and game objects
+            TypeContainerVisitor<GarrisonGridLoader, GridTypeMapContainer> visitor(*this);
+            i_grid->VisitGrid(cell.first, cell.second, visitor);
+        }
+
+        i_plots = nullptr;
     }
 
     TC_LOG_DEBUG("maps", "%u GameObjects and %u Creatures loaded for grid %u on map %u", i_gameObjects, i_creatures, i_grid->GetGridId(), i_map->GetId());
@@ -73,16 +86,11 @@ void GarrisonGridLoader::LoadN()
 
 void GarrisonGridLoader::Visit(GameObjectMapType& m)
 {
-    std::vector<Garrison::Plot*> plots = i_garrison->GetPlots();
-    if (!plots.empty())
+    if (i_plots)
     {
         CellCoord cellCoord = i_cell.GetCellCoord();
-        for (Garrison::Plot* plot : plots)
+        for (Garrison::Plot* plot : *i_plots)
         {
-            Position const& spawn = plot->PacketInfo.PlotPos.Pos;
-            if (cellCoord != Trinity::ComputeCellCoord(spawn.GetPositionX(), spawn.GetPositionY()))
-                continue;
-
             GameObject* go = plot->CreateGameObject(i_map, i_garrison->GetFaction());
             if (!go)
                 continue;
@@ -27,8 +27,58 @@
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "Player.h"
+#include "TaskGraph.h"
 #include "Transport.h"
 #include "World.h"
+#include <array>
+#include <atomic>
+
+namespace
+{
+    // Readers only touch the shard assigned to their thread so concurrent lookups from map threads
+    // do not bounce a single reader count between cores, writers take every shard
+    constexpr std::size_t HASH_MAP_HOLDER_LOCK_SHARDS = 8;
+
+    struct alignas(64) HashMapHolderLockShard
+    {
+        Trinity::InstrumentedSharedMutex Lock{ "HashMapHolder" };
+    };
+
+    template<class T>
+    std::array<HashMapHolderLockShard, HASH_MAP_HOLDER_LOCK_SHARDS>& GetLockShards()
+    {
+        static std::array<HashMapHolderLockShard, HASH_MAP_HOLDER_LOCK_SHARDS> _shards;
+        return _shards;
+    }
+
+    std::size_t GetThreadLockShard()
+    {
+        static std::atomic<std::size_t> _nextShard(0);
+        thread_local std::size_t const shard = _nextShard.fetch_add(1, std::memory_order_relaxed) % HASH_MAP_HOLDER_LOCK_SHARDS;
+        return shard;
+    }
+
+    template<class T>
+    class HashMapHolderWriteLock
+    {
+    public:
+        HashMapHolderWriteLock()
+        {
+            for (HashMapHolderLockShard& shard : GetLockShards<T>())
+                shard.Lock.lock();
+        }
+
+        ~HashMapHolderWriteLock()
+        {
+            auto& shards = GetLockShards<T>();
+            for (auto itr = shards.rbegin(); itr != shards.rend(); ++itr)
+                itr->Lock.unlock();
+        }
+
+        HashMapHolderWriteLock(HashMapHolderWriteLock const&) = delete;
+        HashMapHolderWriteLock& operator=(HashMapHolderWriteLock const&) = delete;
+    };
+}
 
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
@@ -37,7 +87,7 @@ void HashMapHolder<T>::Insert(T* o)
         || std::is_same<Transport, T>::value,
         "Only Player and Transport can be registered in global HashMapHolder");
 
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
+    HashMapHolderWriteLock<T> lock;
 
     GetContainer()[o->GetGUID()] = o;
 }
@@ -45,7 +95,7 @@ void HashMapHolder<T>::Insert(T* o)
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
+    HashMapHolderWriteLock<T> lock;
 
     GetContainer().erase(o->GetGUID());
 }
@@ -53,7 +103,7 @@ void HashMapHolder<T>::Remove(T* o)
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
+    std::shared_lock<Trinity::InstrumentedSharedMutex> lock(GetLockShards<T>()[GetThreadLockShard()].Lock);
 
     typename MapType::iterator itr = GetContainer().find(guid);
     return (itr != GetContainer().end()) ? itr->second : nullptr;
@@ -67,10 +117,10 @@ auto HashMapHolder<T>::GetContainer() -> MapType&
 }
 
 template<class T>
-std::shared_mutex* HashMapHolder<T>::GetLock()
+Trinity::InstrumentedSharedMutex* HashMapHolder<T>::GetLock()
 {
-    static std::shared_mutex _lock;
-    return &_lock;
+    // writers hold all shards, so any single shard is enough for a shared lock
+    return &GetLockShards<T>()[GetThreadLockShard()].Lock;
 }
 
 template class TC_GAME_API HashMapHolder<Player>;
@@ -296,11 +346,28 @@ HashMapHolder<Player>::MapType const& ObjectAccessor::GetPlayers()
 
 void ObjectAccessor::SaveAllPlayers()
 {
-    std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+    // players of different maps are saved concurrently, like the periodic saves done by map threads
+    // called from the world thread while maps are not updated, so no player can be removed before the save finished
+    std::unordered_map<Map*, std::vector<Player*>> playersByMap;
+    {
+        std::shared_lock<Trinity::InstrumentedSharedMutex> lock(*HashMapHolder<Player>::GetLock());
+
+        HashMapHolder<Player>::MapType const& m = GetPlayers();
+        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+            playersByMap[itr->second->IsInWorld() ? itr->second->GetMap() : nullptr].push_back(itr->second);
+    }
+
+    Trinity::TaskGraph saves;
+    for (auto& [map, players] : playersByMap)
+    {
+        saves.AddTask(map ? std::to_string(map->GetId()) : "not in world", [players = std::move(players)]
+        {
+            for (Player* player : players)
+                player->SaveToDB();
+        });
+    }
 
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-        itr->second->SaveToDB();
+    saves.Run(sWorld->getIntConfig(CONFIG_NUMTHREADS));
 }
 
 template<>
@@ -18,6 +18,8 @@
 #ifndef TRINITY_OBJECTACCESSOR_H
 #define TRINITY_OBJECTACCESSOR_H
 
+#include "GuidHashContainers.h"
+#include "InstrumentedMutex.h"
 #include "ObjectGuid.h"
 #include <shared_mutex>
 #include <unordered_map>
@@ -45,7 +47,7 @@ class TC_GAME_API HashMapHolder
 
 public:
 
-    typedef std::unordered_map<ObjectGuid, T*> MapType;
+    typedef Trinity::GuidHashMap<T*> MapType;
 
     static void Insert(T* o);
 
@@ -55,7 +57,7 @@ public:
 
     static MapType& GetContainer();
 
-    static std::shared_mutex* GetLock();
+    static Trinity::InstrumentedSharedMutex* GetLock();
 };
 
 namespace ObjectAccessor
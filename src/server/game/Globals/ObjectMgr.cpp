@@ -42,6 +42,7 @@
 #include "LootMgr.h"
 #include "Mail.h"
 #include "MapManager.h"
+#include "MemoryAccounting.h"
 #include "MotionMaster.h"
 #include "MovementTypedefs.h"
 #include "ObjectAccessor.h"
@@ -53,6 +54,7 @@
 #include "QuestDef.h"
 #include "Random.h"
 #include "ReputationMgr.h"
+#include "ResultSnapshotStore.h"
 #include "ScriptMgr.h"
 #include "ScriptReloadMgr.h"
 #include "SpellInfo.h"
@@ -239,6 +241,32 @@ ObjectMgr::~ObjectMgr()
 {
 }
 
+std::size_t ObjectMgr::GetMemoryUsage() const
+{
+    using Trinity::MemoryAccounting;
+
+    std::size_t usage = MemoryAccounting::EstimateNodeContainer(_creatureTemplateStore)
+        + MemoryAccounting::EstimateNodeContainer(_creatureDataStore)
+        + MemoryAccounting::EstimateNodeContainer(_creatureAddonStore)
+        + MemoryAccounting::EstimateNodeContainer(_creatureLocaleStore)
+        + MemoryAccounting::EstimateNodeContainer(_gameObjectTemplateStore)
+        + MemoryAccounting::EstimateNodeContainer(_gameObjectDataStore)
+        + MemoryAccounting::EstimateNodeContainer(_gameObjectLocaleStore)
+        + MemoryAccounting::EstimateNodeContainer(_spawnGroupDataStore)
+        + MemoryAccounting::EstimateNodeContainer(_itemTemplateStore)
+        + MemoryAccounting::EstimateNodeContainer(_questTemplates)
+        + MemoryAccounting::EstimateNodeContainer(_questTemplateLocaleStore)
+        + MemoryAccounting::EstimateNodeContainer(_npcTextStore)
+        + MemoryAccounting::EstimateNodeContainer(_gossipMenusStore)
+        + MemoryAccounting::EstimateNodeContainer(_gossipMenuItemsStore)
+        + MemoryAccounting::EstimateNodeContainer(_gossipMenuItemsCompiledStore) + _gossipMenuItemsStore.size() * sizeof(GossipMenuItemsCompiled)
+        + MemoryAccounting::EstimateNodeContainer(_pageTextStore);
+
+    // every spawn is also referenced from the cell guid sets of its map
+    usage += (_creatureDataStore.size() + _gameObjectDataStore.size()) * (sizeof(ObjectGuid::LowType) + 3 * sizeof(void*));
+    return usage;
+}
+
 void ObjectMgr::AddLocaleString(std::string&& value, LocaleConstant localeConstant, std::vector<std::string>& data)
 {
     if (!value.empty())
@@ -2081,7 +2109,7 @@ void ObjectMgr::LoadCreatures()
     uint32 oldMSTime = getMSTime();
 
     //                                               0              1   2    3           4           5           6            7        8             9              10
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
+    QueryResult result = sResultSnapshotStore->Query(WorldDatabase, "SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
     //   11               12         13       14            15                 16          17           18                19                   20                    21
         "currentwaypoint, curhealth, curmana, MovementType, spawnDifficulties, eventEntry, poolSpawnId, creature.npcflag, creature.unit_flags, creature.unit_flags2, creature.unit_flags3, "
     //   22                     23                      24                25                   26                       27
@@ -2471,7 +2499,7 @@ void ObjectMgr::LoadGameObjects()
     uint32 oldMSTime = getMSTime();
 
     //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
+    QueryResult result = sResultSnapshotStore->Query(WorldDatabase, "SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
     //   7          8          9          10         11             12            13     14                 15          16
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnDifficulties, eventEntry, poolSpawnId, "
     //   17             18       19          20              21
@@ -6107,6 +6135,51 @@ PageText const* ObjectMgr::GetPageText(uint32 pageEntry)
     return nullptr;
 }
 
+WorldPacket const* ObjectMgr::GetPageTextQueryData(uint32 pageEntry, LocaleConstant locale) const
+{
+    if (locale != LOCALE_enUS)
+        if (WorldPacket const* queryData = Trinity::Containers::MapGetValuePtr(_pageTextQueryData[locale], pageEntry))
+            return queryData;
+
+    return Trinity::Containers::MapGetValuePtr(_pageTextQueryData[LOCALE_enUS], pageEntry);
+}
+
+WorldPacket ObjectMgr::BuildPageTextQueryData(uint32 pageEntry, LocaleConstant locale) const
+{
+    WorldPackets::Query::QueryPageTextResponse response;
+    response.PageTextID = pageEntry;
+
+    uint32 pageID = pageEntry;
+    while (pageID)
+    {
+        PageTextContainer::const_iterator itr = _pageTextStore.find(pageID);
+        if (itr == _pageTextStore.end())
+            break;
+
+        PageText const& pageText = itr->second;
+
+        WorldPackets::Query::QueryPageTextResponse::PageTextInfo page;
+        page.ID = pageID;
+        page.NextPageID = pageText.NextPageID;
+        page.Text = pageText.Text;
+        page.PlayerConditionID = pageText.PlayerConditionID;
+        page.Flags = pageText.Flags;
+
+        if (locale != LOCALE_enUS)
+            if (PageTextLocale const* pageTextLocale = GetPageTextLocale(pageID))
+                ObjectMgr::GetLocaleString(pageTextLocale->Text, locale, page.Text);
+
+        response.Pages.push_back(page);
+        pageID = pageText.NextPageID;
+    }
+
+    response.Allow = !response.Pages.empty();
+
+    response.Write();
+    response.ShrinkToFit();
+    return response.Move();
+}
+
 void ObjectMgr::LoadPageTextLocales()
 {
     uint32 oldMSTime = getMSTime();
@@ -6300,6 +6373,35 @@ NpcText const* ObjectMgr::GetNpcText(uint32 Text_ID) const
     return nullptr;
 }
 
+WorldPacket const* ObjectMgr::GetNpcTextQueryData(uint32 textID) const
+{
+    return Trinity::Containers::MapGetValuePtr(_npcTextQueryData, textID);
+}
+
+WorldPacket ObjectMgr::BuildNpcTextQueryData(uint32 textID) const
+{
+    WorldPackets::Query::QueryNPCTextResponse response;
+    response.TextID = textID;
+
+    if (NpcText const* npcText = GetNpcText(textID))
+    {
+        for (uint8 i = 0; i < MAX_NPC_TEXT_OPTIONS; ++i)
+        {
+            response.Probabilities[i] = npcText->Data[i].Probability;
+            response.BroadcastTextID[i] = npcText->Data[i].BroadcastTextID;
+            if (!response.Allow && npcText->Data[i].BroadcastTextID)
+                response.Allow = true;
+        }
+    }
+
+    if (!response.Allow)
+        TC_LOG_ERROR("sql.sql", "HandleNpcTextQueryOpcode: no BroadcastTextID found for text %u in `npc_text table`", textID);
+
+    response.Write();
+    response.ShrinkToFit();
+    return response.Move();
+}
+
 void ObjectMgr::LoadNPCText()
 {
     uint32 oldMSTime = getMSTime();
@@ -9554,6 +9656,7 @@ void ObjectMgr::LoadGossipMenuItems()
 {
     uint32 oldMSTime = getMSTime();
 
+    _gossipMenuItemsCompiledStore.clear();
     _gossipMenuItemsStore.clear();
 
     QueryResult result = WorldDatabase.Query(
@@ -9623,6 +9726,15 @@ void ObjectMgr::LoadGossipMenuItems()
         _gossipMenuItemsStore.insert(GossipMenuItemsContainer::value_type(gMenuItem.MenuID, gMenuItem));
     } while (result->NextRow());
 
+    // multimap nodes never move, the compiled lists can point into them until the next reload
+    for (GossipMenuItemsContainer::value_type const& menuItem : _gossipMenuItemsStore)
+    {
+        GossipMenuItemsCompiled& compiled = _gossipMenuItemsCompiledStore[menuItem.first].emplace_back();
+        compiled.Item = &menuItem.second;
+        compiled.OptionBroadcastText = sBroadcastTextStore.LookupEntry(menuItem.second.OptionBroadcastTextID);
+        compiled.BoxBroadcastText = sBroadcastTextStore.LookupEntry(menuItem.second.BoxBroadcastTextID);
+    }
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " gossip_menu_option entries in %u ms", _gossipMenuItemsStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -10768,6 +10880,43 @@ void ObjectMgr::InitializeQueriesData(QueryDataGroup mask)
         for (auto& poiPair : _questPOIStore)
             poiPair.second.InitializeQueryData();
 
+    // Initialize Query data for npc texts, texts without any broadcast text are left to the uncached path
+    if (mask & QUERY_DATA_NPC_TEXTS)
+    {
+        _npcTextQueryData.clear();
+        for (auto const& npcTextPair : _npcTextStore)
+            if (std::any_of(std::begin(npcTextPair.second.Data), std::end(npcTextPair.second.Data), [](NpcTextData const& data) { return data.BroadcastTextID != 0; }))
+                _npcTextQueryData[npcTextPair.first] = BuildNpcTextQueryData(npcTextPair.first);
+    }
+
+    // Initialize Query data for page texts, localized responses are only built for chains that have a translation
+    if (mask & QUERY_DATA_PAGE_TEXTS)
+    {
+        for (auto& queryData : _pageTextQueryData)
+            queryData.clear();
+
+        for (auto const& pageTextPair : _pageTextStore)
+        {
+            _pageTextQueryData[LOCALE_enUS][pageTextPair.first] = BuildPageTextQueryData(pageTextPair.first, LOCALE_enUS);
+
+            for (uint8 loc = LOCALE_enUS + 1; loc < TOTAL_LOCALES; ++loc)
+            {
+                bool hasTranslation = false;
+                for (uint32 pageID = pageTextPair.first; pageID && !hasTranslation;)
+                {
+                    if (PageTextLocale const* pageTextLocale = GetPageTextLocale(pageID))
+                        hasTranslation = pageTextLocale->Text.size() > loc && !pageTextLocale->Text[loc].empty();
+
+                    PageTextContainer::const_iterator itr = _pageTextStore.find(pageID);
+                    pageID = itr != _pageTextStore.end() ? itr->second.NextPageID : 0;
+                }
+
+                if (hasTranslation)
+                    _pageTextQueryData[loc][pageTextPair.first] = BuildPageTextQueryData(pageTextPair.first, LocaleConstant(loc));
+            }
+        }
+    }
+
     TC_LOG_INFO("server.loading", ">> Initialized query cache data in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -47,6 +47,7 @@ class Vehicle;
 class Map;
 enum class GossipOptionIcon : uint8;
 struct AccessRequirement;
+struct BroadcastTextEntry;
 struct DeclinedName;
 struct DungeonEncounterEntry;
 struct FactionEntry;
@@ -777,6 +778,18 @@ typedef std::multimap<uint32, GossipMenuItems> GossipMenuItemsContainer;
 typedef std::pair<GossipMenuItemsContainer::const_iterator, GossipMenuItemsContainer::const_iterator> GossipMenuItemsMapBounds;
 typedef std::pair<GossipMenuItemsContainer::iterator, GossipMenuItemsContainer::iterator> GossipMenuItemsMapBoundsNonConst;
 
+// gossip_menu_option rows of one menu stored contiguously with their broadcast texts already looked up,
+// rebuilt by LoadGossipMenuItems (conditions are still read from the row so condition reloads need no rebuild)
+struct GossipMenuItemsCompiled
+{
+    GossipMenuItems const* Item;
+    BroadcastTextEntry const* OptionBroadcastText;
+    BroadcastTextEntry const* BoxBroadcastText;
+};
+
+typedef std::vector<GossipMenuItemsCompiled> GossipMenuItemsCompiledList;
+typedef std::unordered_map<uint32, GossipMenuItemsCompiledList> GossipMenuItemsCompiledContainer;
+
 struct QuestPOIBlobPoint
 {
     int32 X;
@@ -1050,6 +1063,8 @@ enum QueryDataGroup
     QUERY_DATA_ITEMS = 0x04,
     QUERY_DATA_QUESTS = 0x08,
     QUERY_DATA_POIS = 0x10,
+    QUERY_DATA_NPC_TEXTS = 0x20,
+    QUERY_DATA_PAGE_TEXTS = 0x40,
 
     QUERY_DATA_ALL = 0xFF
 };
@@ -1210,6 +1225,8 @@ class TC_GAME_API ObjectMgr
         }
 
         NpcText const* GetNpcText(uint32 textID) const;
+        WorldPacket const* GetNpcTextQueryData(uint32 textID) const;
+        WorldPacket BuildNpcTextQueryData(uint32 textID) const;
         QuestGreeting const* GetQuestGreeting(TypeID type, uint32 id) const;
         QuestGreetingLocale const* GetQuestGreetingLocale(TypeID type, uint32 id) const;
 
@@ -1362,6 +1379,8 @@ class TC_GAME_API ObjectMgr
 
         void LoadPageTexts();
         PageText const* GetPageText(uint32 pageEntry);
+        WorldPacket const* GetPageTextQueryData(uint32 pageEntry, LocaleConstant locale) const;
+        WorldPacket BuildPageTextQueryData(uint32 pageEntry, LocaleConstant locale) const;
 
         void LoadPlayerInfo();
         void LoadPetLevelInfo();
@@ -1527,6 +1546,9 @@ class TC_GAME_API ObjectMgr
             return &itr->second;
         }
         GameObjectDataContainer const& GetAllGameObjectData() const { return _gameObjectDataStore; }
+
+        // estimated from the number of entries of the biggest stores, see Trinity::MemoryAccounting
+        std::size_t GetMemoryUsage() const;
         GameObjectData const* GetGameObjectData(ObjectGuid::LowType spawnId) const
         {
             GameObjectDataContainer::const_iterator itr = _gameObjectDataStore.find(spawnId);
@@ -1681,6 +1703,13 @@ class TC_GAME_API ObjectMgr
             return _gossipMenuItemsStore.equal_range(uiMenuId);
         }
 
+        GossipMenuItemsCompiledList const* GetCompiledGossipMenuItems(uint32 menuId) const
+        {
+            auto itr = _gossipMenuItemsCompiledStore.find(menuId);
+            if (itr == _gossipMenuItemsCompiledStore.end()) return nullptr;
+            return &itr->second;
+        }
+
         // for wintergrasp only
         GraveyardContainer GraveyardStore;
 
@@ -1793,6 +1822,7 @@ class TC_GAME_API ObjectMgr
         TavernAreaTriggerContainer _tavernAreaTriggerStore;
         GameObjectForQuestContainer _gameObjectForQuestStore;
         NpcTextContainer _npcTextStore;
+        std::unordered_map<uint32, WorldPacket> _npcTextQueryData;
         QuestGreetingContainer _questGreetingStore;
         QuestGreetingLocaleContainer _questGreetingLocaleStore;
         AreaTriggerContainer _areaTriggerStore;
@@ -1807,6 +1837,7 @@ class TC_GAME_API ObjectMgr
 
         GossipMenusContainer _gossipMenusStore;
         GossipMenuItemsContainer _gossipMenuItemsStore;
+        GossipMenuItemsCompiledContainer _gossipMenuItemsCompiledStore;
         PointOfInterestContainer _pointsOfInterestStore;
 
         QuestPOIContainer _questPOIStore;
@@ -1839,6 +1870,8 @@ class TC_GAME_API ObjectMgr
         LocaleConstant DBCLocaleIndex;
 
         PageTextContainer _pageTextStore;
+        // non-enUS locales only hold page chains that actually have a translation, lookups fall back to enUS
+        std::array<std::unordered_map<uint32, WorldPacket>, TOTAL_LOCALES> _pageTextQueryData;
         InstanceTemplateContainer _instanceTemplateStore;
 
     public:
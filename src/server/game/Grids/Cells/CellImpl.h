@@ -78,6 +78,7 @@ inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T,
     //maybe it is better to just return when radius <= 0.0f?
     if (radius <= 0.0f)
     {
+        GridSearchAreaScope noArea(nullptr);
         map.Visit(*this, visitor);
         return;
     }
@@ -85,6 +86,10 @@ inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T,
     if (radius > SIZE_OF_GRIDS)
         radius = SIZE_OF_GRIDS;
 
+    //searchers skip objects of the visited cells that are known to be out of this circle
+    GridSearchArea searchArea{ x_off, y_off, radius };
+    GridSearchAreaScope searchAreaScope(&searchArea);
+
     //lets calculate object coord offsets from cell borders.
     CellArea area = Cell::CalculateCellArea(x_off, y_off, radius);
     //if radius fits inside standing cell
@@ -28,7 +28,7 @@
 #include <vector>
 #include "Define.h"
 #include "Dynamic/TypeList.h"
-#include "GridRefManager.h"
+#include "GridObjectContainer.h"
 
 /*
  * @class ContainerMapList is a mulit-type container for map elements
@@ -39,7 +39,7 @@ template<class OBJECT>
 struct ContainerMapList
 {
     //std::map<OBJECT_HANDLE, OBJECT *> _element;
-    GridRefManager<OBJECT> _element;
+    GridObjectContainer<OBJECT> _element;
 };
 
 template<>
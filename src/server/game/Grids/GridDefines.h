@@ -62,14 +62,14 @@ typedef TYPELIST_4(Player, Creature/*pets*/, Corpse/*resurrectable*/, DynamicObj
 typedef TYPELIST_7(GameObject, Creature/*except pets*/, DynamicObject, Corpse/*Bones*/, AreaTrigger, SceneObject, Conversation) AllGridObjectTypes;
 typedef TYPELIST_8(Creature, GameObject, DynamicObject, Pet, Corpse, AreaTrigger, SceneObject, Conversation) AllMapStoredObjectTypes;
 
-typedef GridRefManager<Corpse>          CorpseMapType;
-typedef GridRefManager<Creature>        CreatureMapType;
-typedef GridRefManager<DynamicObject>   DynamicObjectMapType;
-typedef GridRefManager<GameObject>      GameObjectMapType;
-typedef GridRefManager<Player>          PlayerMapType;
-typedef GridRefManager<AreaTrigger>     AreaTriggerMapType;
-typedef GridRefManager<SceneObject>     SceneObjectMapType;
-typedef GridRefManager<Conversation>    ConversationMapType;
+typedef GridObjectContainer<Corpse>          CorpseMapType;
+typedef GridObjectContainer<Creature>        CreatureMapType;
+typedef GridObjectContainer<DynamicObject>   DynamicObjectMapType;
+typedef GridObjectContainer<GameObject>      GameObjectMapType;
+typedef GridObjectContainer<Player>          PlayerMapType;
+typedef GridObjectContainer<AreaTrigger>     AreaTriggerMapType;
+typedef GridObjectContainer<SceneObject>     SceneObjectMapType;
+typedef GridObjectContainer<Conversation>    ConversationMapType;
 
 enum GridMapTypeMask
 {
@@ -0,0 +1,294 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRIDOBJECTCONTAINER_H
+#define TRINITY_GRIDOBJECTCONTAINER_H
+
+#include "GridRefManager.h"
+#include "GridReference.h"
+
+#ifdef TRINITY_DENSE_GRID_STORAGE
+
+#include "Errors.h"
+#include <algorithm>
+#include <vector>
+
+template<class OBJECT>
+class DenseGridReference;
+
+/*
+ * Circle set by Cell::Visit for the duration of a radius limited visit. Searchers use it to skip
+ * objects of the visited cells whose mirrored position is clearly out of range without touching them.
+ */
+struct GridSearchArea
+{
+    // added to the search radius (and the mirrored combat reach of the candidate) to cover positions
+    // that changed without going through a Map relocation function since the last refresh
+    static constexpr float StalePositionMargin = 10.0f;
+
+    float X;
+    float Y;
+    float Radius;
+
+    static GridSearchArea const*& Current()
+    {
+        static thread_local GridSearchArea const* current = nullptr;
+        return current;
+    }
+};
+
+class GridSearchAreaScope
+{
+    public:
+        explicit GridSearchAreaScope(GridSearchArea const* area) : _previous(GridSearchArea::Current()) { GridSearchArea::Current() = area; }
+        ~GridSearchAreaScope() { GridSearchArea::Current() = _previous; }
+
+        GridSearchAreaScope(GridSearchAreaScope const&) = delete;
+        GridSearchAreaScope& operator=(GridSearchAreaScope const&) = delete;
+
+    private:
+        GridSearchArea const* _previous;
+};
+
+/*
+ * Stores the objects of a cell in a contiguous array instead of a linked list of GridReferences.
+ * Removal swaps the last object into the freed slot; every object keeps its slot index in its
+ * DenseGridReference so removal stays O(1).
+ *
+ * Next to the objects the container mirrors their 2D position and combat reach in separate arrays,
+ * refreshed by GridObject::UpdateGridPosition, so range searches can reject candidates by walking
+ * three float arrays instead of dereferencing every object.
+ *
+ * Iteration is index based and stays valid while objects are added to (appended, visited
+ * later in the same pass) or removed from the container. Like with the linked list, an object
+ * removed during a visit may cause another one to be skipped in that pass.
+ */
+template<class OBJECT>
+class DenseGridRefManager
+{
+    friend class DenseGridReference<OBJECT>;
+
+    public:
+        struct Slot
+        {
+            OBJECT* GetSource() const { return _source; }
+
+            OBJECT* _source;
+            DenseGridReference<OBJECT>* _reference;
+        };
+
+        class iterator
+        {
+            public:
+                iterator(DenseGridRefManager* container, std::size_t index, GridSearchArea const* area = nullptr) : _container(container), _index(index), _area(area)
+                {
+                    SkipOutOfArea();
+                }
+
+                Slot& operator*() const { return _container->_slots[_index]; }
+                Slot* operator->() const { return &_container->_slots[_index]; }
+
+                iterator& operator++()
+                {
+                    ++_index;
+                    SkipOutOfArea();
+                    return *this;
+                }
+
+                // positions past the end compare equal to end() even after the container shrunk
+                bool operator==(iterator const& right) const { return Clamp(_index) == Clamp(right._index); }
+                bool operator!=(iterator const& right) const { return !(*this == right); }
+
+            private:
+                std::size_t Clamp(std::size_t index) const { return std::min(index, _container->_slots.size()); }
+
+                void SkipOutOfArea()
+                {
+                    if (!_area)
+                        return;
+
+                    while (_index < _container->_slots.size() && !_container->IsInArea(_index, *_area))
+                        ++_index;
+                }
+
+                DenseGridRefManager* _container;
+                std::size_t _index;
+                GridSearchArea const* _area;
+        };
+
+        DenseGridRefManager() = default;
+        DenseGridRefManager(DenseGridRefManager const&) = delete;
+        DenseGridRefManager& operator=(DenseGridRefManager const&) = delete;
+
+        ~DenseGridRefManager()
+        {
+            for (Slot& slot : _slots)
+                slot._reference->_container = nullptr;
+        }
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, _slots.size()); }
+
+        /// only visits objects whose mirrored position may be inside area
+        iterator begin(GridSearchArea const* area) { return iterator(this, 0, area); }
+
+        bool isEmpty() const { return _slots.empty(); }
+        uint32 getSize() const { return uint32(_slots.size()); }
+
+    private:
+        bool IsInArea(std::size_t slot, GridSearchArea const& area) const
+        {
+            float dx = _positionX[slot] - area.X;
+            float dy = _positionY[slot] - area.Y;
+            float maxDist = area.Radius + _reach[slot] + GridSearchArea::StalePositionMargin;
+            return dx * dx + dy * dy <= maxDist * maxDist;
+        }
+
+        void Add(DenseGridReference<OBJECT>* reference, OBJECT* source)
+        {
+            reference->_container = this;
+            reference->_slot = _slots.size();
+            _slots.push_back({ source, reference });
+            _positionX.push_back(0.0f);
+            _positionY.push_back(0.0f);
+            _reach.push_back(0.0f);
+            UpdatePosition(reference->_slot);
+        }
+
+        void Remove(DenseGridReference<OBJECT>* reference)
+        {
+            std::size_t slot = reference->_slot;
+            ASSERT(slot < _slots.size() && _slots[slot]._reference == reference);
+
+            if (slot + 1 != _slots.size())
+            {
+                _slots[slot] = _slots.back();
+                _positionX[slot] = _positionX.back();
+                _positionY[slot] = _positionY.back();
+                _reach[slot] = _reach.back();
+                _slots[slot]._reference->_slot = slot;
+            }
+
+            _slots.pop_back();
+            _positionX.pop_back();
+            _positionY.pop_back();
+            _reach.pop_back();
+            reference->_container = nullptr;
+        }
+
+        void UpdatePosition(std::size_t slot)
+        {
+            OBJECT const* source = _slots[slot]._source;
+            _positionX[slot] = source->GetPositionX();
+            _positionY[slot] = source->GetPositionY();
+            _reach[slot] = source->GetCombatReach();
+        }
+
+        std::vector<Slot> _slots;
+        std::vector<float> _positionX;
+        std::vector<float> _positionY;
+        std::vector<float> _reach;
+};
+
+template<class OBJECT>
+class DenseGridReference
+{
+    friend class DenseGridRefManager<OBJECT>;
+
+    public:
+        DenseGridReference() : _container(nullptr), _slot(0) { }
+        ~DenseGridReference() { unlink(); }
+
+        DenseGridReference(DenseGridReference const&) = delete;
+        DenseGridReference& operator=(DenseGridReference const&) = delete;
+
+        void link(DenseGridRefManager<OBJECT>* container, OBJECT* source)
+        {
+            ASSERT(container);
+            unlink();
+            container->Add(this, source);
+        }
+
+        void unlink()
+        {
+            if (_container)
+                _container->Remove(this);
+        }
+
+        /// refreshes the position mirrored in the container
+        void updatePosition()
+        {
+            if (_container)
+                _container->UpdatePosition(_slot);
+        }
+
+        bool isValid() const { return _container != nullptr; }
+
+    private:
+        DenseGridRefManager<OBJECT>* _container;
+        std::size_t _slot;
+};
+
+namespace Trinity
+{
+    /// first object of a cell a searcher has to look at, skips objects out of the area of the current Cell::Visit
+    template<class OBJECT>
+    typename DenseGridRefManager<OBJECT>::iterator SearchBegin(DenseGridRefManager<OBJECT>& container)
+    {
+        return container.begin(GridSearchArea::Current());
+    }
+}
+
+template<class OBJECT>
+using GridObjectContainer = DenseGridRefManager<OBJECT>;
+
+template<class OBJECT>
+using GridObjectReference = DenseGridReference<OBJECT>;
+
+#else
+
+template<class OBJECT>
+using GridObjectContainer = GridRefManager<OBJECT>;
+
+template<class OBJECT>
+using GridObjectReference = GridReference<OBJECT>;
+
+struct GridSearchArea
+{
+    float X;
+    float Y;
+    float Radius;
+};
+
+class GridSearchAreaScope
+{
+    public:
+        explicit GridSearchAreaScope(GridSearchArea const* /*area*/) { }
+};
+
+namespace Trinity
+{
+    template<class OBJECT>
+    typename GridRefManager<OBJECT>::iterator SearchBegin(GridRefManager<OBJECT>& container)
+    {
+        return container.begin();
+    }
+}
+
+#endif
+
+#endif // TRINITY_GRIDOBJECTCONTAINER_H
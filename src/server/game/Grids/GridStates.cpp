@@ -56,7 +56,8 @@ void RemovalState::Update(Map& map, NGridType& grid, GridInfo& info, uint32 diff
     if (!info.getUnloadLock())
     {
         info.UpdateTimeTracker(diff);
-        if (info.getTimeTracker().Passed() && !map.UnloadGrid(grid, false))
+        // budget used up by other grids, retried on the next update as the timer stays passed
+        if (info.getTimeTracker().Passed() && map.HasGridUnloadBudget() && !map.UnloadGrid(grid, false))
         {
             TC_LOG_DEBUG("maps", "Grid[%u, %u] for map %u differed unloading due to players or active objects nearby", grid.getX(), grid.getY(), map.GetId());
             map.ResetGridExpiry(grid);
@@ -43,9 +43,12 @@ public:
     void ResetTimeTracker(time_t interval) { i_timer.Reset(interval); }
     void UpdateTimeTracker(time_t diff) { i_timer.Update(diff); }
     PeriodicTimer& getRelocationTimer() { return vis_Update; }
+    uint8 getExpiryScale() const { return i_expiryScale; }
+    void setExpiryScale(uint8 scale) { i_expiryScale = scale; }
 private:
     TimeTracker i_timer;
     PeriodicTimer vis_Update;
+    uint8 i_expiryScale;                                    // grid expiry multiplier, raised for grids reloaded right after being unloaded
 
     uint16 i_unloadActiveLockCount : 16;                    // lock from active object spawn points (prevent clone loading)
     bool   i_unloadExplicitLock    : 1;                     // explicit manual lock or config setting
@@ -109,6 +112,8 @@ class NGrid
         void decUnloadActiveLock() { i_GridInfo.decUnloadActiveLock(); }
         void ResetTimeTracker(time_t interval) { i_GridInfo.ResetTimeTracker(interval); }
         void UpdateTimeTracker(time_t diff) { i_GridInfo.UpdateTimeTracker(diff); }
+        uint8 GetExpiryScale() const { return i_GridInfo.getExpiryScale(); }
+        void SetExpiryScale(uint8 scale) { i_GridInfo.setExpiryScale(scale); }
 
         /*
         template<class SPECIFIC_OBJECT> void AddWorldObject(const uint32 x, const uint32 y, SPECIFIC_OBJECT *obj)
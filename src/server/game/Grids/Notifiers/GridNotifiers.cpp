@@ -26,17 +26,39 @@
 
 using namespace Trinity;
 
+void VisibleNotifier::Visit(GameObjectMapType &m)
+{
+    for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        GameObject* go = iter->GetSource();
+
+        i_visitedGuids.push_back(go->GetGUID());
+
+        i_player.UpdateVisibilityOf(go, i_data, i_visibleNow);
+
+        go->WakeTrapSearch(&i_player);
+    }
+}
+
 void VisibleNotifier::SendToSelf()
 {
+    // comparing against the sorted list of visited objects avoids copying the whole client guid set on every notify
+    std::sort(i_visitedGuids.begin(), i_visitedGuids.end());
+    auto isVisited = [this](ObjectGuid const& guid)
+    {
+        return std::binary_search(i_visitedGuids.begin(), i_visitedGuids.end(), guid);
+    };
+
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
+    std::vector<ObjectGuid> passengerGuids;
     if (Transport* transport = i_player.GetTransport())
     {
         for (Transport::PassengerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
         {
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            if (!isVisited((*itr)->GetGUID()) && i_player.m_clientGUIDs.count((*itr)->GetGUID()))
             {
-                vis_guids.erase((*itr)->GetGUID());
+                passengerGuids.push_back((*itr)->GetGUID());
 
                 switch ((*itr)->GetTypeId())
                 {
@@ -61,7 +83,14 @@ void VisibleNotifier::SendToSelf()
         }
     }
 
-    for (auto it = vis_guids.begin(); it != vis_guids.end(); ++it)
+    std::sort(passengerGuids.begin(), passengerGuids.end());
+
+    std::vector<ObjectGuid> outOfRangeGuids;
+    for (ObjectGuid const& guid : i_player.m_clientGUIDs)
+        if (!isVisited(guid) && !std::binary_search(passengerGuids.begin(), passengerGuids.end(), guid))
+            outOfRangeGuids.push_back(guid);
+
+    for (auto it = outOfRangeGuids.begin(); it != outOfRangeGuids.end(); ++it)
     {
         i_player.m_clientGUIDs.erase(*it);
         i_data.AddOutOfRangeGUID(*it);
@@ -137,7 +166,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* player = iter->GetSource();
 
-        vis_guids.erase(player->GetGUID());
+        i_visitedGuids.push_back(player->GetGUID());
 
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
@@ -156,7 +185,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature* c = iter->GetSource();
 
-        vis_guids.erase(c->GetGUID());
+        i_visitedGuids.push_back(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
@@ -193,6 +222,15 @@ void CreatureRelocationNotifier::Visit(CreatureMapType &m)
     }
 }
 
+void CreatureRelocationNotifier::Visit(GameObjectMapType &m)
+{
+    if (!i_creature.IsAlive())
+        return;
+
+    for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        iter->GetSource()->WakeTrapSearch(&i_creature);
+}
+
 void DelayedUnitRelocation::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -241,6 +279,12 @@ void AIRelocationNotifier::Visit(CreatureMapType &m)
     }
 }
 
+void AIRelocationNotifier::Visit(GameObjectMapType &m)
+{
+    for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        iter->GetSource()->WakeTrapSearch(&i_unit);
+}
+
 /*
 void
 MessageDistDeliverer::VisitObject(Player* player)
@@ -253,11 +297,20 @@ MessageDistDeliverer::VisitObject(Player* player)
 */
 
 template<class T>
-void ObjectUpdater::Visit(GridRefManager<T> &m)
+void ObjectUpdater::Visit(GridObjectContainer<T> &m)
 {
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->GetSource()->IsInWorld())
-            iter->GetSource()->Update(i_timeDiff);
+    for (typename GridObjectContainer<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        T* obj = iter->GetSource();
+        if (!obj->IsInWorld())
+            continue;
+
+        obj->Update(i_timeDiff);
+
+        // picks up position and combat reach changes made without going through Map relocation functions
+        if (obj->IsInGrid())
+            obj->UpdateGridPosition();
+    }
 }
 
 bool AnyDeadUnitObjectInRangeCheck::operator()(Player* u)
@@ -40,10 +40,11 @@ namespace Trinity
         Player &i_player;
         UpdateData i_data;
         std::set<Unit*> i_visibleNow;
-        GuidUnorderedSet vis_guids;
+        std::vector<ObjectGuid> i_visitedGuids;             // everything the client knows about but was not visited went out of range
 
-        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs) { }
-        template<class T> void Visit(GridRefManager<T> &m);
+        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()) { i_visitedGuids.reserve(player.m_clientGUIDs.size()); }
+        template<class T> void Visit(GridObjectContainer<T> &m);
+        void Visit(GameObjectMapType &m);
         void SendToSelf(void);
     };
 
@@ -52,7 +53,7 @@ namespace Trinity
         IteratorPair<WorldObject**> i_objects;
 
         explicit VisibleChangesNotifier(IteratorPair<WorldObject**> objects) : i_objects(objects) { }
-        template<class T> void Visit(GridRefManager<T> &) { }
+        template<class T> void Visit(GridObjectContainer<T> &) { }
         void Visit(PlayerMapType &);
         void Visit(CreatureMapType &);
         void Visit(DynamicObjectMapType &);
@@ -62,7 +63,7 @@ namespace Trinity
     {
         PlayerRelocationNotifier(Player &player) : VisibleNotifier(player) { }
 
-        template<class T> void Visit(GridRefManager<T> &m) { VisibleNotifier::Visit(m); }
+        template<class T> void Visit(GridObjectContainer<T> &m) { VisibleNotifier::Visit(m); }
         void Visit(CreatureMapType &);
         void Visit(PlayerMapType &);
     };
@@ -71,9 +72,10 @@ namespace Trinity
     {
         Creature &i_creature;
         CreatureRelocationNotifier(Creature &c) : i_creature(c) { }
-        template<class T> void Visit(GridRefManager<T> &) { }
+        template<class T> void Visit(GridObjectContainer<T> &) { }
         void Visit(CreatureMapType &);
         void Visit(PlayerMapType &);
+        void Visit(GameObjectMapType &);
     };
 
     struct TC_GAME_API DelayedUnitRelocation
@@ -84,7 +86,7 @@ namespace Trinity
         const float i_radius;
         DelayedUnitRelocation(Cell &c, CellCoord &pair, Map &map, float radius) :
             i_map(map), cell(c), p(pair), i_radius(radius) { }
-        template<class T> void Visit(GridRefManager<T> &) { }
+        template<class T> void Visit(GridObjectContainer<T> &) { }
         void Visit(CreatureMapType &);
         void Visit(PlayerMapType   &);
     };
@@ -94,8 +96,9 @@ namespace Trinity
         Unit &i_unit;
         bool isCreature;
         explicit AIRelocationNotifier(Unit &unit) : i_unit(unit), isCreature(unit.GetTypeId() == TYPEID_UNIT)  { }
-        template<class T> void Visit(GridRefManager<T> &) { }
+        template<class T> void Visit(GridObjectContainer<T> &) { }
         void Visit(CreatureMapType &);
+        void Visit(GameObjectMapType &);
     };
 
     struct GridUpdater
@@ -104,9 +107,9 @@ namespace Trinity
         uint32 i_timeDiff;
         GridUpdater(GridType &grid, uint32 diff) : i_grid(grid), i_timeDiff(diff) { }
 
-        template<class T> void updateObjects(GridRefManager<T> &m)
+        template<class T> void updateObjects(GridObjectContainer<T> &m)
         {
-            for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+            for (typename GridObjectContainer<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
                 iter->GetSource()->Update(i_timeDiff);
         }
 
@@ -164,7 +167,7 @@ namespace Trinity
         void Visit(PlayerMapType &m) const;
         void Visit(CreatureMapType &m) const;
         void Visit(DynamicObjectMapType &m) const;
-        template<class SKIP> void Visit(GridRefManager<SKIP> &) const { }
+        template<class SKIP> void Visit(GridObjectContainer<SKIP> &) const { }
 
         void SendPacket(Player const* player) const
         {
@@ -194,7 +197,7 @@ namespace Trinity
         void Visit(PlayerMapType &m) const;
         void Visit(CreatureMapType &m) const;
         void Visit(DynamicObjectMapType &m) const;
-        template<class SKIP> void Visit(GridRefManager<SKIP> &) const { }
+        template<class SKIP> void Visit(GridObjectContainer<SKIP> &) const { }
 
         void SendPacket(Player const* player) const
         {
@@ -210,7 +213,7 @@ namespace Trinity
     {
         uint32 i_timeDiff;
         explicit ObjectUpdater(const uint32 diff) : i_timeDiff(diff) { }
-        template<class T> void Visit(GridRefManager<T> &m);
+        template<class T> void Visit(GridObjectContainer<T> &m);
         void Visit(PlayerMapType &) { }
         void Visit(CorpseMapType &) { }
     };
@@ -265,7 +268,7 @@ namespace Trinity
         void Visit(SceneObjectMapType &m);
         void Visit(ConversationMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Check>
@@ -288,7 +291,7 @@ namespace Trinity
         void Visit(SceneObjectMapType &m);
         void Visit(ConversationMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Check>
@@ -312,7 +315,7 @@ namespace Trinity
         void Visit(SceneObjectMapType &m);
         void Visit(ConversationMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Do>
@@ -396,7 +399,7 @@ namespace Trinity
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // Gameobject searchers
@@ -413,7 +416,7 @@ namespace Trinity
 
         void Visit(GameObjectMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // Last accepted by Check GO if any (Check can change requirements at each call)
@@ -429,7 +432,7 @@ namespace Trinity
 
         void Visit(GameObjectMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Check>
@@ -445,7 +448,7 @@ namespace Trinity
 
         void Visit(GameObjectMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Functor>
@@ -461,7 +464,7 @@ namespace Trinity
                     _func(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
 
     private:
         Functor& _func;
@@ -484,7 +487,7 @@ namespace Trinity
         void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // Last accepted by Check Unit if any (Check can change requirements at each call)
@@ -501,7 +504,7 @@ namespace Trinity
         void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // All accepted by Check units if any
@@ -519,7 +522,7 @@ namespace Trinity
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // Creature searchers
@@ -536,7 +539,7 @@ namespace Trinity
 
         void Visit(CreatureMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // Last accepted by Check Creature if any (Check can change requirements at each call)
@@ -552,7 +555,7 @@ namespace Trinity
 
         void Visit(CreatureMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Check>
@@ -568,7 +571,7 @@ namespace Trinity
 
         void Visit(CreatureMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Do>
@@ -587,7 +590,7 @@ namespace Trinity
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // Player searchers
@@ -604,7 +607,7 @@ namespace Trinity
 
         void Visit(PlayerMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Check>
@@ -620,7 +623,7 @@ namespace Trinity
 
         void Visit(PlayerMapType &m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Check>
@@ -636,7 +639,7 @@ namespace Trinity
 
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Do>
@@ -655,7 +658,7 @@ namespace Trinity
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     template<class Do>
@@ -675,7 +678,7 @@ namespace Trinity
                     i_do(itr->GetSource());
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        template<class NOT_INTERESTED> void Visit(GridObjectContainer<NOT_INTERESTED> &) { }
     };
 
     // CHECKS && DO classes
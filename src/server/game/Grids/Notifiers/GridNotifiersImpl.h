@@ -28,11 +28,11 @@
 #include "WorldSession.h"
 
 template<class T>
-inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
+inline void Trinity::VisibleNotifier::Visit(GridObjectContainer<T> &m)
 {
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (typename GridObjectContainer<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        vis_guids.erase(iter->GetSource()->GetGUID());
+        i_visitedGuids.push_back(iter->GetSource()->GetGUID());
         i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
     }
 }
@@ -69,6 +69,10 @@ void Trinity::MessageDistDeliverer<PacketSender>::Visit(CreatureMapType& m) cons
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* target = iter->GetSource();
+        // creatures only matter for the players sharing their vision, check that before the more expensive phase and range checks
+        if (!target->HasSharedVision())
+            continue;
+
         if (!target->IsInPhase(i_source))
             continue;
 
@@ -76,13 +80,10 @@ void Trinity::MessageDistDeliverer<PacketSender>::Visit(CreatureMapType& m) cons
             continue;
 
         // Send packet to all who are sharing the creature's vision
-        if (target->HasSharedVision())
-        {
-            SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
-            for (; i != target->GetSharedVisionList().end(); ++i)
-                if ((*i)->m_seer == target)
-                    SendPacket(*i);
-        }
+        SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
+        for (; i != target->GetSharedVisionList().end(); ++i)
+            if ((*i)->m_seer == target)
+                SendPacket(*i);
     }
 }
 
@@ -92,6 +93,9 @@ void Trinity::MessageDistDeliverer<PacketSender>::Visit(DynamicObjectMapType& m)
     for (DynamicObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         DynamicObject* target = iter->GetSource();
+        if (!target->IsCasterViewpoint())
+            continue;
+
         if (!target->IsInPhase(i_source))
             continue;
 
@@ -140,6 +144,10 @@ void Trinity::MessageDistDelivererToHostile<PacketSender>::Visit(CreatureMapType
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* target = iter->GetSource();
+        // creatures only matter for the players sharing their vision, check that before the more expensive phase and range checks
+        if (!target->HasSharedVision())
+            continue;
+
         if (!target->IsInPhase(i_source))
             continue;
 
@@ -147,13 +155,10 @@ void Trinity::MessageDistDelivererToHostile<PacketSender>::Visit(CreatureMapType
             continue;
 
         // Send packet to all who are sharing the creature's vision
-        if (target->HasSharedVision())
-        {
-            SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
-            for (; i != target->GetSharedVisionList().end(); ++i)
-                if ((*i)->m_seer == target)
-                    SendPacket(*i);
-        }
+        SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
+        for (; i != target->GetSharedVisionList().end(); ++i)
+            if ((*i)->m_seer == target)
+                SendPacket(*i);
     }
 }
 
@@ -163,6 +168,9 @@ void Trinity::MessageDistDelivererToHostile<PacketSender>::Visit(DynamicObjectMa
     for (DynamicObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         DynamicObject* target = iter->GetSource();
+        if (!target->IsCasterViewpoint())
+            continue;
+
         if (!target->IsInPhase(i_source))
             continue;
 
@@ -193,7 +201,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(GameObjectMapType &m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -216,7 +224,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -239,7 +247,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -262,7 +270,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(CorpseMapType &m)
     if (i_object)
         return;
 
-    for (CorpseMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CorpseMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -285,7 +293,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(DynamicObjectMapType &m)
     if (i_object)
         return;
 
-    for (DynamicObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (DynamicObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -308,7 +316,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(AreaTriggerMapType &m)
     if (i_object)
         return;
 
-    for (AreaTriggerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (AreaTriggerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -331,7 +339,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(SceneObjectMapType &m)
     if (i_object)
         return;
 
-    for (SceneObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (SceneObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -354,7 +362,7 @@ void Trinity::WorldObjectSearcher<Check>::Visit(ConversationMapType &m)
     if (i_object)
         return;
 
-    for (ConversationMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (ConversationMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -373,7 +381,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(GameObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -389,7 +397,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(PlayerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -405,7 +413,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(CreatureMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -421,7 +429,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(CorpseMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
 
-    for (CorpseMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CorpseMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -437,7 +445,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(DynamicObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
 
-    for (DynamicObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (DynamicObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -453,7 +461,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(AreaTriggerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_AREATRIGGER))
         return;
 
-    for (AreaTriggerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (AreaTriggerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -469,7 +477,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(SceneObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_SCENEOBJECT))
         return;
 
-    for (SceneObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (SceneObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -485,7 +493,7 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(ConversationMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CONVERSATION))
         return;
 
-    for (ConversationMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (ConversationMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -501,7 +509,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(PlayerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -512,7 +520,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CreatureMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -523,7 +531,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CorpseMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
 
-    for (CorpseMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CorpseMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -534,7 +542,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(GameObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -545,7 +553,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
 
-    for (DynamicObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (DynamicObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -556,7 +564,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(AreaTriggerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_AREATRIGGER))
         return;
 
-    for (AreaTriggerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (AreaTriggerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -567,7 +575,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(SceneObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_SCENEOBJECT))
         return;
 
-    for (SceneObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (SceneObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -578,7 +586,7 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(ConversationMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CONVERSATION))
         return;
 
-    for (ConversationMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (ConversationMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
 }
@@ -592,7 +600,7 @@ void Trinity::GameObjectSearcher<Check>::Visit(GameObjectMapType &m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -608,7 +616,7 @@ void Trinity::GameObjectSearcher<Check>::Visit(GameObjectMapType &m)
 template<class Check>
 void Trinity::GameObjectLastSearcher<Check>::Visit(GameObjectMapType &m)
 {
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -621,7 +629,7 @@ void Trinity::GameObjectLastSearcher<Check>::Visit(GameObjectMapType &m)
 template<class Check>
 void Trinity::GameObjectListSearcher<Check>::Visit(GameObjectMapType &m)
 {
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (GameObjectMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (itr->GetSource()->IsInPhase(_searcher))
             if (i_check(itr->GetSource()))
                 Insert(itr->GetSource());
@@ -636,7 +644,7 @@ void Trinity::UnitSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -656,7 +664,7 @@ void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -672,7 +680,7 @@ void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -685,7 +693,7 @@ void Trinity::UnitLastSearcher<Check>::Visit(CreatureMapType &m)
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -698,7 +706,7 @@ void Trinity::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (itr->GetSource()->IsInPhase(_searcher))
             if (i_check(itr->GetSource()))
                 Insert(itr->GetSource());
@@ -707,7 +715,7 @@ void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (itr->GetSource()->IsInPhase(_searcher))
             if (i_check(itr->GetSource()))
                 Insert(itr->GetSource());
@@ -722,7 +730,7 @@ void Trinity::CreatureSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -738,7 +746,7 @@ void Trinity::CreatureSearcher<Check>::Visit(CreatureMapType &m)
 template<class Check>
 void Trinity::CreatureLastSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -751,7 +759,7 @@ void Trinity::CreatureLastSearcher<Check>::Visit(CreatureMapType &m)
 template<class Check>
 void Trinity::CreatureListSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (CreatureMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (itr->GetSource()->IsInPhase(_searcher))
             if (i_check(itr->GetSource()))
                 Insert(itr->GetSource());
@@ -760,7 +768,7 @@ void Trinity::CreatureListSearcher<Check>::Visit(CreatureMapType &m)
 template<class Check>
 void Trinity::PlayerListSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
         if (itr->GetSource()->IsInPhase(_searcher))
             if (i_check(itr->GetSource()))
                 Insert(itr->GetSource());
@@ -773,7 +781,7 @@ void Trinity::PlayerSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
@@ -789,7 +797,7 @@ void Trinity::PlayerSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::PlayerLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    for (PlayerMapType::iterator itr = Trinity::SearchBegin(m); itr != m.end(); ++itr)
     {
         if (!itr->GetSource()->IsInPhase(_searcher))
             continue;
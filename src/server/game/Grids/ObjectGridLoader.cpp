@@ -33,6 +33,7 @@
 #include "SceneObject.h"
 #include "World.h"
 #include "ScriptMgr.h"
+#include <algorithm>
 
 void ObjectGridEvacuator::Visit(CreatureMapType &m)
 {
@@ -74,7 +75,7 @@ class ObjectWorldLoader
 
         void Visit(CorpseMapType &m);
 
-        template<class T> void Visit(GridRefManager<T>&) { }
+        template<class T> void Visit(GridObjectContainer<T>&) { }
 
     private:
         Cell i_cell;
@@ -100,7 +101,7 @@ template<> void ObjectGridLoaderBase::SetObjectCell(GameObject* obj, CellCoord c
 }
 
 template <class T>
-void AddObjectHelper(CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map* /*map*/, T *obj)
+void AddObjectHelper(CellCoord &cell, GridObjectContainer<T> &m, uint32 &count, Map* /*map*/, T *obj)
 {
     obj->AddToGrid(m);
     ObjectGridLoader::SetObjectCell(obj, cell);
@@ -121,18 +122,27 @@ void AddObjectHelper(CellCoord &cell, CreatureMapType &m, uint32 &count, Map* ma
 }
 
 template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridRefManager<T>& m, uint32& count, Map* map, uint32 phaseId = 0, Optional<ObjectGuid> phaseOwner = {})
+void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridObjectContainer<T>& m, uint32& count, Map* map, uint32 phaseId = 0, Optional<ObjectGuid> phaseOwner = {})
 {
-    for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
+    // First resolve the spawn data of the whole cell and drop everything that is not spawned (respawn timer, inactive spawn group),
+    // then create the remaining objects grouped by entry so that consecutive spawns hit the same template, addon and model data
+    // not reused between calls, creating an object can load a neighbouring grid
+    std::vector<SpawnData const*> spawns;
+    spawns.reserve(guid_set.size());
+    for (ObjectGuid::LowType guid : guid_set)
     {
-        // Don't spawn at all if there's a respawn timer
-        ObjectGuid::LowType guid = *i_guid;
-        if (!map->ShouldBeSpawnedOnGridLoad<T>(guid))
-            continue;
+        SpawnData const* data = ASSERT_NOTNULL(sObjectMgr->GetSpawnData(SpawnData::TypeFor<T>, guid));
+        if (map->ShouldBeSpawnedOnGridLoad(data))
+            spawns.push_back(data);
+    }
 
+    std::stable_sort(spawns.begin(), spawns.end(), [](SpawnData const* left, SpawnData const* right) { return left->id < right->id; });
+
+    for (SpawnData const* data : spawns)
+    {
         T* obj = new T;
         //TC_LOG_INFO("misc", "DEBUG: LoadHelper from table: %s for (guid: " UI64FMTD ") Loading", table, guid);
-        if (!obj->LoadFromDB(guid, map, false, phaseOwner.has_value() /*allowDuplicate*/))
+        if (!obj->LoadFromDB(data->spawnId, map, false, phaseOwner.has_value() /*allowDuplicate*/))
         {
             delete obj;
             continue;
@@ -251,11 +261,11 @@ void PersonalPhaseGridLoader::Load(uint32 phaseId)
 }
 
 template<class T>
-void ObjectGridUnloader::Visit(GridRefManager<T> &m)
+void ObjectGridUnloader::Visit(GridObjectContainer<T> &m)
 {
     while (!m.isEmpty())
     {
-        T *obj = m.getFirst()->GetSource();
+        T *obj = m.begin()->GetSource();
         //Some creatures may summon other temp summons in CleanupsBeforeDelete()
         //So we need this even after cleaner (maybe we can remove cleaner)
         //Example: Flame Leviathan Turret 33139 is summoned when a creature is deleted
@@ -279,9 +289,9 @@ void ObjectGridStoper::Visit(CreatureMapType &m)
 }
 
 template<class T>
-void ObjectGridCleaner::Visit(GridRefManager<T> &m)
+void ObjectGridCleaner::Visit(GridObjectContainer<T> &m)
 {
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (typename GridObjectContainer<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         iter->GetSource()->SetDestroyedObject(true);
         iter->GetSource()->CleanupsBeforeDelete();
@@ -99,7 +99,7 @@ class TC_GAME_API ObjectGridStoper
 {
     public:
         void Visit(CreatureMapType &m);
-        template<class T> void Visit(GridRefManager<T> &) { }
+        template<class T> void Visit(GridObjectContainer<T> &) { }
 };
 
 //Move the foreign creatures back to respawn positions before unloading the NGrid
@@ -108,14 +108,14 @@ class TC_GAME_API ObjectGridEvacuator
     public:
         void Visit(CreatureMapType &m);
         void Visit(GameObjectMapType &m);
-        template<class T> void Visit(GridRefManager<T> &) { }
+        template<class T> void Visit(GridObjectContainer<T> &) { }
 };
 
 //Clean up and remove from world
 class ObjectGridCleaner
 {
     public:
-        template<class T> void Visit(GridRefManager<T> &);
+        template<class T> void Visit(GridObjectContainer<T> &);
 };
 
 //Delete objects before deleting NGrid
@@ -123,6 +123,6 @@ class ObjectGridUnloader
 {
     public:
         void Visit(CorpseMapType& /*m*/) { }    // corpses are deleted with Map
-        template<class T> void Visit(GridRefManager<T> &m);
+        template<class T> void Visit(GridObjectContainer<T> &m);
 };
 #endif
@@ -1502,30 +1502,27 @@ void Group::SendTargetIconList(WorldSession* session, int8 partyIndex)
 
 void Group::SendUpdate()
 {
+    // member list, loot and difficulty settings are the same for everyone, only build them once
+    WorldPackets::Party::PartyUpdate partyUpdate;
+    BuildPartyUpdate(partyUpdate);
+
     for (member_witerator witr = m_memberSlots.begin(); witr != m_memberSlots.end(); ++witr)
-        SendUpdateToPlayer(witr->guid, &(*witr));
+        SendPartyUpdateToPlayer(partyUpdate, witr->guid);
 }
 
 void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
 {
-    Player* player = ObjectAccessor::FindConnectedPlayer(playerGUID);
-
-    if (!player || !player->GetSession() || player->GetGroup() != this)
-        return;
-
     // if MemberSlot wasn't provided
-    if (!slot)
-    {
-        member_witerator witr = _getMemberWSlot(playerGUID);
-
-        if (witr == m_memberSlots.end()) // if there is no MemberSlot for such a player
-            return;
-
-        slot = &(*witr);
-    }
+    if (!slot && _getMemberWSlot(playerGUID) == m_memberSlots.end()) // if there is no MemberSlot for such a player
+        return;
 
     WorldPackets::Party::PartyUpdate partyUpdate;
+    BuildPartyUpdate(partyUpdate);
+    SendPartyUpdateToPlayer(partyUpdate, slot ? slot->guid : playerGUID);
+}
 
+void Group::BuildPartyUpdate(WorldPackets::Party::PartyUpdate& partyUpdate) const
+{
     partyUpdate.PartyFlags = m_groupFlags;
     partyUpdate.PartyIndex = m_groupCategory;
     partyUpdate.PartyType = IsCreated() ? GROUP_TYPE_NORMAL : GROUP_TYPE_NONE;
@@ -1533,18 +1530,12 @@ void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
     partyUpdate.PartyGUID = m_guid;
     partyUpdate.LeaderGUID = m_leaderGuid;
 
-    partyUpdate.SequenceNum = player->NextGroupUpdateSequenceNumber(m_groupCategory);
-
-    partyUpdate.MyIndex = -1;
-    uint8 index = 0;
-    for (member_citerator citr = m_memberSlots.begin(); citr != m_memberSlots.end(); ++citr, ++index)
+    partyUpdate.PlayerList.reserve(m_memberSlots.size());
+    for (member_citerator citr = m_memberSlots.begin(); citr != m_memberSlots.end(); ++citr)
     {
-        if (slot->guid == citr->guid)
-            partyUpdate.MyIndex = index;
-
         Player* member = ObjectAccessor::FindConnectedPlayer(citr->guid);
 
-        WorldPackets::Party::PartyPlayerInfo playerInfos;
+        WorldPackets::Party::PartyPlayerInfo& playerInfos = partyUpdate.PlayerList.emplace_back();
 
         playerInfos.GUID = citr->guid;
         playerInfos.Name = citr->name;
@@ -1557,8 +1548,6 @@ void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
         playerInfos.Subgroup = citr->group;         // groupid
         playerInfos.Flags = citr->flags;            // See enum GroupMemberFlags
         playerInfos.RolesAssigned = citr->roles;    // Lfg Roles
-
-        partyUpdate.PlayerList.push_back(playerInfos);
     }
 
     if (GetMembersCount() > 1)
@@ -1575,6 +1564,26 @@ void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
         partyUpdate.DifficultySettings->RaidDifficultyID = m_raidDifficulty;
         partyUpdate.DifficultySettings->LegacyRaidDifficultyID = m_legacyRaidDifficulty;
     }
+}
+
+void Group::SendPartyUpdateToPlayer(WorldPackets::Party::PartyUpdate& partyUpdate, ObjectGuid playerGUID)
+{
+    Player* player = ObjectAccessor::FindConnectedPlayer(playerGUID);
+
+    if (!player || !player->GetSession() || player->GetGroup() != this)
+        return;
+
+    partyUpdate.SequenceNum = player->NextGroupUpdateSequenceNumber(m_groupCategory);
+
+    partyUpdate.MyIndex = -1;
+    for (std::size_t i = 0; i < partyUpdate.PlayerList.size(); ++i)
+    {
+        if (partyUpdate.PlayerList[i].GUID == playerGUID)
+        {
+            partyUpdate.MyIndex = int32(i);
+            break;
+        }
+    }
 
     // LfgInfos
     if (isLFGGroup())
@@ -1599,6 +1608,8 @@ void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
         partyUpdate.LfgInfos->MyKickVoteCount = 0;
     }
 
+    // the packet is reused for every member, drop the previous recipient's serialization
+    partyUpdate.Clear();
     player->SendDirectMessage(partyUpdate.Write());
 }
 
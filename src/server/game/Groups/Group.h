@@ -47,6 +47,11 @@ namespace WorldPackets
     {
         struct LootItemData;
     }
+
+    namespace Party
+    {
+        class PartyUpdate;
+    }
 }
 
 #define MAX_GROUP_SIZE      5
@@ -433,6 +438,8 @@ class TC_GAME_API Group
         void SubGroupCounterIncrease(uint8 subgroup);
         void SubGroupCounterDecrease(uint8 subgroup);
         void ToggleGroupMemberFlag(member_witerator slot, uint8 flag, bool apply);
+        void BuildPartyUpdate(WorldPackets::Party::PartyUpdate& partyUpdate) const;
+        void SendPartyUpdateToPlayer(WorldPackets::Party::PartyUpdate& partyUpdate, ObjectGuid playerGUID);
 
         MemberSlotList      m_memberSlots;
         GroupRefManager     m_memberMgr;
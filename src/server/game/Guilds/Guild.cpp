@@ -1239,6 +1239,12 @@ void Guild::SaveToDB()
     CharacterDatabase.CommitTransaction(trans);
 }
 
+void Guild::_InvalidateRosterCache()
+{
+    for (std::unique_ptr<WorldPacket>& cachedRoster : m_rosterCache)
+        cachedRoster.reset();
+}
+
 void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
 {
     if (Member* member = GetMember(player->GetGUID()))
@@ -1258,7 +1264,7 @@ void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
                 TC_LOG_ERROR("guild", "Guild::UpdateMemberData: Called with incorrect DATAID %u (value %u)", dataid, value);
                 return;
         }
-        //HandleRoster();
+        _InvalidateRosterCache();
     }
 }
 
@@ -1269,6 +1275,8 @@ void Guild::OnPlayerStatusChange(Player* player, uint32 flag, bool state)
         if (state)
             member->AddFlag(flag);
         else member->RemFlag(flag);
+
+        _InvalidateRosterCache();
     }
 }
 
@@ -1293,6 +1301,18 @@ bool Guild::SetName(std::string_view name)
 
 void Guild::HandleRoster(WorldSession* session)
 {
+    bool sendOfficerNote = _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE);
+    TimePoint now = GameTime::Now();
+
+    // roster requests come in bursts after guild events, share one serialized packet between them
+    std::unique_ptr<WorldPacket>& cachedRoster = m_rosterCache[sendOfficerNote];
+    if (cachedRoster && m_rosterCacheExpireTime[sendOfficerNote] > now)
+    {
+        TC_LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [%s] (cached)", session->GetPlayerInfo().c_str());
+        session->SendPacket(cachedRoster.get());
+        return;
+    }
+
     WorldPackets::Guild::GuildRoster roster;
 
     roster.NumAccounts = int32(m_accountsNumber);
@@ -1301,7 +1321,6 @@ void Guild::HandleRoster(WorldSession* session)
 
     roster.MemberData.reserve(m_members.size());
 
-    bool sendOfficerNote = _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE);
     for (auto const& [guid, member] : m_members)
     {
         WorldPackets::Guild::GuildRosterMemberData& memberData = roster.MemberData.emplace_back();
@@ -1334,8 +1353,11 @@ void Guild::HandleRoster(WorldSession* session)
     roster.WelcomeText = m_motd;
     roster.InfoText = m_info;
 
+    cachedRoster = std::make_unique<WorldPacket>(*roster.Write());
+    m_rosterCacheExpireTime[sendOfficerNote] = now + GUILD_ROSTER_CACHE_DURATION;
+
     TC_LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [%s]", session->GetPlayerInfo().c_str());
-    session->SendPacket(roster.Write());
+    session->SendPacket(cachedRoster.get());
 }
 
 void Guild::SendQueryResponse(WorldSession* session, ObjectGuid const& playerGuid)
@@ -1440,6 +1462,7 @@ void Guild::HandleSetMOTD(WorldSession* session, std::string_view motd)
     else
     {
         m_motd = motd;
+        _InvalidateRosterCache();
 
         sScriptMgr->OnGuildMOTDChanged(this, m_motd);
 
@@ -1461,6 +1484,7 @@ void Guild::HandleSetInfo(WorldSession* session, std::string_view info)
     if (_HasRankRight(session->GetPlayer(), GR_RIGHT_MODIFY_GUILD_INFO))
     {
         m_info = info;
+        _InvalidateRosterCache();
 
         sScriptMgr->OnGuildInfoChanged(this, m_info);
 
@@ -1532,6 +1556,7 @@ void Guild::HandleSetNewGuildMaster(WorldSession* session, std::string_view name
 
     _SetLeader(trans, *newGuildMaster);
     oldGuildMaster->ChangeRank(trans, _GetLowestRankId());
+    _InvalidateRosterCache();
 
     SendEventNewLeader(newGuildMaster, oldGuildMaster, isSelfPromote);
 
@@ -1569,6 +1594,8 @@ void Guild::HandleSetMemberNote(WorldSession* session, std::string_view note, Ob
         else
             member->SetOfficerNote(note);
 
+        _InvalidateRosterCache();
+
         WorldPackets::Guild::GuildMemberUpdateNote updateNote;
         updateNote.Member = guid;
         updateNote.IsPublic = isPublic;
@@ -1850,6 +1877,7 @@ void Guild::HandleUpdateMemberRank(WorldSession* session, ObjectGuid guid, bool
 
         CharacterDatabaseTransaction trans(nullptr);
         member->ChangeRank(trans, newRankId);
+        _InvalidateRosterCache();
         _LogEvent(demote ? GUILD_EVENT_LOG_DEMOTE_PLAYER : GUILD_EVENT_LOG_PROMOTE_PLAYER, player->GetGUID().GetCounter(), member->GetGUID().GetCounter(), AsUnderlyingType(newRankId));
         //_BroadcastEvent(demote ? GE_DEMOTION : GE_PROMOTION, ObjectGuid::Empty, player->GetName().c_str(), name.c_str(), _GetRankName(newRankId).c_str());
     }
@@ -2095,6 +2123,7 @@ void Guild::HandleMemberLogout(WorldSession* session)
         member->SetStats(player);
         member->UpdateLogoutTime();
         member->ResetFlags();
+        _InvalidateRosterCache();
     }
 
     SendEventPresenceChanged(session, false, true);
@@ -2291,6 +2320,7 @@ void Guild::SendLoginInfo(WorldSession* session)
 
     member->SetStats(player);
     member->AddFlag(GUILDMEMBER_STATUS_ONLINE);
+    _InvalidateRosterCache();
 }
 
 void Guild::SendEventAwayChanged(ObjectGuid const& memberGuid, bool afk, bool dnd)
@@ -2620,7 +2650,8 @@ bool Guild::Validate()
         _SetLeader(trans, *leader);
 
     // Check config if multiple guildmasters are allowed
-    if (!sConfigMgr->GetBoolDefault("Guild.AllowMultipleGuildMaster", false))
+    static Trinity::ConfigValue<bool> const AllowMultipleGuildMaster("Guild.AllowMultipleGuildMaster", false);
+    if (!AllowMultipleGuildMaster)
         for (auto& [guid, member] : m_members)
             if (member.GetRankId() == GuildRankId::GuildMaster && !member.IsSamePlayer(m_leaderGuid))
                 member.ChangeRank(trans, GetRankInfo(GuildRankOrder(1))->GetId());
@@ -2794,6 +2825,7 @@ bool Guild::AddMember(CharacterDatabaseTransaction trans, ObjectGuid guid, Optio
     member.SaveToDB(trans);
 
     _UpdateAccountsNumber();
+    _InvalidateRosterCache();
     _LogEvent(GUILD_EVENT_LOG_JOIN_GUILD, lowguid);
 
     WorldPackets::Guild::GuildEventPlayerJoined joinNotificationPacket;
@@ -2845,6 +2877,7 @@ void Guild::DeleteMember(CharacterDatabaseTransaction trans, ObjectGuid guid, bo
     sScriptMgr->OnGuildRemoveMember(this, guid, isDisbanding, isKicked);
 
     m_members.erase(guid);
+    _InvalidateRosterCache();
 
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     Player* player = ObjectAccessor::FindConnectedPlayer(guid);
@@ -2872,6 +2905,7 @@ bool Guild::ChangeMemberRank(CharacterDatabaseTransaction trans, ObjectGuid guid
         if (Member* member = GetMember(guid))
         {
             member->ChangeRank(trans, newRank);
+            _InvalidateRosterCache();
             return true;
         }
     }
@@ -3115,6 +3149,7 @@ void Guild::_SetLeader(CharacterDatabaseTransaction trans, Member& leader)
 
     m_leaderGuid = leader.GetGUID();
     leader.ChangeRank(trans, GuildRankId::GuildMaster);
+    _InvalidateRosterCache();
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_LEADER);
     stmt->setUInt64(0, m_leaderGuid.GetCounter());
@@ -3556,6 +3591,7 @@ void Guild::SendGuildRanksUpdate(ObjectGuid setterGuid, ObjectGuid targetGuid, G
 
     CharacterDatabaseTransaction trans;
     member->ChangeRank(trans, rank);
+    _InvalidateRosterCache();
 
     TC_LOG_DEBUG("network", "SMSG_GUILD_RANKS_UPDATE [Broadcast] Target: %s, Issuer: %s, RankId: %u",
         targetGuid.ToString().c_str(), setterGuid.ToString().c_str(), uint32(rank));
@@ -20,10 +20,13 @@
 
 #include "AchievementMgr.h"
 #include "DatabaseEnvFwd.h"
+#include "Duration.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
 #include "RaceMask.h"
 #include "SharedDefines.h"
+#include <array>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -63,6 +66,7 @@ enum GuildMisc
 };
 
 constexpr uint64 GUILD_BANK_MONEY_LIMIT = UI64LIT(100000000000);
+constexpr Seconds GUILD_ROSTER_CACHE_DURATION = 5s;
 
 enum GuildMemberData
 {
@@ -866,6 +870,10 @@ class TC_GAME_API Guild
         LogHolder<NewsLogEntry> m_newsLog;
         GuildAchievementMgr m_achievementMgr;
 
+        // serialized SMSG_GUILD_ROSTER, indexed by whether officer notes are included
+        std::array<std::unique_ptr<WorldPacket>, 2> m_rosterCache;
+        std::array<TimePoint, 2> m_rosterCacheExpireTime;
+
     private:
         inline uint8 _GetRanksSize() const { return uint8(m_ranks.size()); }
         RankInfo const* GetRankInfo(GuildRankId rankId) const;
@@ -911,6 +919,7 @@ class TC_GAME_API Guild
         bool _CreateRank(CharacterDatabaseTransaction trans, std::string_view name, uint32 rights);
         // Update account number when member added/removed from guild
         void _UpdateAccountsNumber();
+        void _InvalidateRosterCache();
         bool _IsLeader(Player* player) const;
         void _DeleteBankItems(CharacterDatabaseTransaction trans, bool removeItemsFromDB = false);
         bool _ModifyBankMoney(CharacterDatabaseTransaction trans, uint64 amount, bool add);
@@ -38,8 +38,7 @@ void WorldSession::HandleBattlePetRequestJournalLock(WorldPackets::BattlePet::Ba
 void WorldSession::HandleBattlePetSetBattleSlot(WorldPackets::BattlePet::BattlePetSetBattleSlot& battlePetSetBattleSlot)
 {
     if (BattlePets::BattlePet* pet = GetBattlePetMgr()->GetPet(battlePetSetBattleSlot.PetGuid))
-        if (WorldPackets::BattlePet::BattlePetSlot* slot = GetBattlePetMgr()->GetSlot(BattlePets::BattlePetSlot(battlePetSetBattleSlot.Slot)))
-            slot->Pet = pet->PacketInfo;
+        GetBattlePetMgr()->SetSlotPet(BattlePets::BattlePetSlot(battlePetSetBattleSlot.Slot), pet);
 }
 
 void WorldSession::HandleBattlePetModifyName(WorldPackets::BattlePet::BattlePetModifyName& battlePetModifyName)
@@ -105,8 +104,7 @@ void WorldSession::HandleBattlePetSetFlags(WorldPackets::BattlePet::BattlePetSet
         else // FLAGS_CONTROL_TYPE_REMOVE
             pet->PacketInfo.Flags &= ~battlePetSetFlags.Flags;
 
-        if (pet->SaveInfo != BattlePets::BATTLE_PET_NEW)
-            pet->SaveInfo = BattlePets::BATTLE_PET_CHANGED;
+        GetBattlePetMgr()->SetPetChanged(pet);
     }
 }
 
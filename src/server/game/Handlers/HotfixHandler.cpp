@@ -24,30 +24,23 @@
 #include "ObjectDefines.h"
 #include "Realm.h"
 #include "World.h"
+#include <array>
+#include <map>
 
 void WorldSession::HandleDBQueryBulk(WorldPackets::Hotfix::DBQueryBulk& dbQuery)
 {
-    DB2StorageBase const* store = sDB2Manager.GetStorage(dbQuery.TableHash);
     for (WorldPackets::Hotfix::DBQueryBulk::DBQueryRecord const& record : dbQuery.Queries)
     {
         WorldPackets::Hotfix::DBReply dbReply;
         dbReply.TableHash = dbQuery.TableHash;
         dbReply.RecordID = record.RecordID;
 
-        if (store && store->HasRecord(record.RecordID))
+        if (std::vector<uint8> const* recordData = sDB2Manager.GetSerializedHotfixRecord(dbQuery.TableHash, record.RecordID, GetSessionDbcLocale()))
         {
             dbReply.Status = DB2Manager::HotfixRecord::Status::Valid;
             dbReply.Timestamp = GameTime::GetGameTime();
-            store->WriteRecord(record.RecordID, GetSessionDbcLocale(), dbReply.Data);
-
-            if (std::vector<DB2Manager::HotfixOptionalData> const* optionalDataEntries = sDB2Manager.GetHotfixOptionalData(dbQuery.TableHash, record.RecordID, GetSessionDbcLocale()))
-            {
-                for (DB2Manager::HotfixOptionalData const& optionalData : *optionalDataEntries)
-                {
-                    dbReply.Data << uint32(optionalData.Key);
-                    dbReply.Data.append(optionalData.Data.data(), optionalData.Data.size());
-                }
-            }
+            if (!recordData->empty())
+                dbReply.Data.append(recordData->data(), recordData->size());
         }
         else
         {
@@ -64,8 +57,49 @@ void WorldSession::SendAvailableHotfixes()
     SendPacket(WorldPackets::Hotfix::AvailableHotfixes(realm.Id.GetAddress(), sDB2Manager.GetHotfixData()).Write());
 }
 
+namespace
+{
+    // Clients of the same build ask for the same hotfix set after every login, so whole responses are kept per locale.
+    // CMSG_HOTFIX_REQUEST is processed in World::UpdateSessions only, no locking needed
+    struct HotfixResponseCache
+    {
+        static constexpr std::size_t MaxResponsesPerLocale = 16;
+
+        uint32 Generation = 0;
+        std::array<std::map<std::vector<int32>, WorldPacket>, TOTAL_LOCALES> Responses;
+
+        WorldPacket const* Find(std::vector<int32> const& hotfixIds, LocaleConstant locale)
+        {
+            if (Generation != sDB2Manager.GetHotfixGeneration())
+            {
+                for (std::map<std::vector<int32>, WorldPacket>& responses : Responses)
+                    responses.clear();
+
+                Generation = sDB2Manager.GetHotfixGeneration();
+            }
+
+            return Trinity::Containers::MapGetValuePtr(Responses[locale], hotfixIds);
+        }
+
+        WorldPacket const* Store(std::vector<int32> const& hotfixIds, LocaleConstant locale, WorldPacket const& response)
+        {
+            // unusual request sets (partially updated client caches) should not grow this forever
+            if (Responses[locale].size() >= MaxResponsesPerLocale)
+                Responses[locale].clear();
+
+            return &Responses[locale].emplace(hotfixIds, response).first->second;
+        }
+    } HotfixResponses;
+}
+
 void WorldSession::HandleHotfixRequest(WorldPackets::Hotfix::HotfixRequest& hotfixQuery)
 {
+    if (WorldPacket const* cachedResponse = HotfixResponses.Find(hotfixQuery.Hotfixes, GetSessionDbcLocale()))
+    {
+        SendPacket(cachedResponse);
+        return;
+    }
+
     DB2Manager::HotfixContainer const& hotfixes = sDB2Manager.GetHotfixData();
     WorldPackets::Hotfix::HotfixConnect hotfixQueryResponse;
     hotfixQueryResponse.Hotfixes.reserve(hotfixQuery.Hotfixes.size());
@@ -81,22 +115,11 @@ void WorldSession::HandleHotfixRequest(WorldPackets::Hotfix::HotfixRequest& hotf
                 hotfixData.Record = hotfixRecord;
                 if (hotfixRecord.HotfixStatus == DB2Manager::HotfixRecord::Status::Valid)
                 {
-                    DB2StorageBase const* storage = sDB2Manager.GetStorage(hotfixRecord.TableHash);
-                    if (storage && storage->HasRecord(uint32(hotfixRecord.RecordID)))
+                    if (std::vector<uint8> const* recordData = sDB2Manager.GetSerializedHotfixRecord(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
                     {
-                        std::size_t pos = hotfixQueryResponse.HotfixContent.size();
-                        storage->WriteRecord(uint32(hotfixRecord.RecordID), GetSessionDbcLocale(), hotfixQueryResponse.HotfixContent);
-
-                        if (std::vector<DB2Manager::HotfixOptionalData> const* optionalDataEntries = sDB2Manager.GetHotfixOptionalData(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
-                        {
-                            for (DB2Manager::HotfixOptionalData const& optionalData : *optionalDataEntries)
-                            {
-                                hotfixQueryResponse.HotfixContent << uint32(optionalData.Key);
-                                hotfixQueryResponse.HotfixContent.append(optionalData.Data.data(), optionalData.Data.size());
-                            }
-                        }
-
-                        hotfixData.Size = hotfixQueryResponse.HotfixContent.size() - pos;
+                        hotfixData.Size = recordData->size();
+                        if (!recordData->empty())
+                            hotfixQueryResponse.HotfixContent.append(recordData->data(), recordData->size());
                     }
                     else if (std::vector<uint8> const* blobData = sDB2Manager.GetHotfixBlobData(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
                     {
@@ -105,11 +128,11 @@ void WorldSession::HandleHotfixRequest(WorldPackets::Hotfix::HotfixRequest& hotf
                     }
                     else
                         // Do not send Status::Valid when we don't have a hotfix blob for current locale
-                        hotfixData.Record.HotfixStatus = storage ? DB2Manager::HotfixRecord::Status::RecordRemoved : DB2Manager::HotfixRecord::Status::Invalid;
+                        hotfixData.Record.HotfixStatus = sDB2Manager.GetStorage(hotfixRecord.TableHash) ? DB2Manager::HotfixRecord::Status::RecordRemoved : DB2Manager::HotfixRecord::Status::Invalid;
                 }
             }
         }
     }
 
-    SendPacket(hotfixQueryResponse.Write());
+    SendPacket(HotfixResponses.Store(hotfixQuery.Hotfixes, GetSessionDbcLocale(), *hotfixQueryResponse.Write()));
 }
@@ -618,10 +618,18 @@ void WorldSession::SendListInventory(ObjectGuid vendorGuid)
 
     packet.Items.resize(rawItemCount);
 
+    // class and team restrictions of every slot checked at once, GMs see everything
+    std::vector<uint64> visibleSlots;
+    if (vendorItems && !_player->IsGameMaster())
+        vendorItems->GetSlotsVisibleTo(_player->GetClassMask(), _player->GetTeam(), visibleSlots);
+
     const float discountMod = _player->GetReputationPriceDiscount(vendor);
     uint8 count = 0;
     for (uint32 slot = 0; slot < rawItemCount; ++slot)
     {
+        if (!visibleSlots.empty() && !(visibleSlots[slot / 64] & (UI64LIT(1) << (slot % 64))))
+            continue;
+
         VendorItem const* vendorItem = vendorItems->GetItem(slot);
         if (!vendorItem)
             continue;
@@ -639,21 +647,10 @@ void WorldSession::SendListInventory(ObjectGuid vendorGuid)
                 continue;
 
             int32 leftInStock = !vendorItem->maxcount ? -1 : vendor->GetVendorItemCurrentCount(vendorItem);
-            if (!_player->IsGameMaster()) // ignore conditions if GM on
-            {
-                // Respect allowed class
-                if (!(itemTemplate->GetAllowableClass() & _player->GetClassMask()) && itemTemplate->GetBonding() == BIND_ON_ACQUIRE)
-                    continue;
-
-                // Only display items in vendor lists for the team the player is on
-                if ((itemTemplate->HasFlag(ITEM_FLAG2_FACTION_HORDE) && _player->GetTeam() == ALLIANCE) ||
-                    (itemTemplate->HasFlag(ITEM_FLAG2_FACTION_ALLIANCE) && _player->GetTeam() == HORDE))
-                    continue;
-
-                // Items sold out are not displayed in list
-                if (leftInStock == 0)
-                    continue;
-            }
+            // Items sold out are not displayed in list, ignored if GM on
+            // allowed class and team were already checked with visibleSlots
+            if (!_player->IsGameMaster() && leftInStock == 0)
+                continue;
 
             if (!sConditionMgr->IsObjectMeetingVendorItemConditions(vendor->GetEntry(), vendorItem->item, _player, vendor))
             {
@@ -880,6 +877,7 @@ void WorldSession::HandleWrapItem(WorldPackets::Item::WrapItem& packet)
     stmt->setUInt32(3, item->m_itemData->DynamicFlags);
     trans->Append(stmt);
 
+    uint32 oldEntry = item->GetEntry();
     item->SetEntry(gift->GetEntry());
 
     switch (item->GetEntry())
@@ -904,6 +902,8 @@ void WorldSession::HandleWrapItem(WorldPackets::Item::WrapItem& packet)
             break;
     }
 
+    _player->UpdateItemEntryIndex(item, oldEntry);
+
     item->SetGiftCreator(_player->GetGUID());
     item->SetItemFlags(ITEM_FIELD_FLAG_WRAPPED);
     item->SetState(ITEM_CHANGED, _player);
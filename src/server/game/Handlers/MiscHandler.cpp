@@ -142,15 +142,20 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
     WorldPackets::Who::WhoResponsePkt response;
     response.RequestID = whoRequest.RequestID;
 
-    WhoListInfoVector const& whoList = sWhoListStorageMgr->GetWhoList();
-    for (WhoListPlayerInfo const& target : whoList)
+    bool const canSeeOtherTeam = HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST);
+    bool const canSeeAllSecLevels = HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS);
+    uint32 const maxWho = sWorld->getIntConfig(CONFIG_MAX_WHO);
+
+    uint8 const minLevel = uint8(std::clamp<int32>(request.MinLevel, 0, STRONG_MAX_LEVEL));
+    uint8 const maxLevel = uint8(std::clamp<int32>(request.MaxLevel, 0, STRONG_MAX_LEVEL));
+    for (WhoListPlayerInfo const& target : sWhoListStorageMgr->GetWhoListInLevelRange(minLevel, maxLevel))
     {
         // player can see member of other team only if has RBAC_PERM_TWO_SIDE_WHO_LIST
-        if (target.GetTeam() != team && !HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
+        if (target.GetTeam() != team && !canSeeOtherTeam)
             continue;
 
         // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if has RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS
-        if (target.GetSecurity() > AccountTypes(gmLevelInWhoList) && !HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS))
+        if (target.GetSecurity() > AccountTypes(gmLevelInWhoList) && !canSeeAllSecLevels)
             continue;
 
         // check if target is globally visible for player
@@ -158,11 +163,6 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
             if (AccountMgr::IsPlayerAccount(_player->GetSession()->GetSecurity()) || target.GetSecurity() > _player->GetSession()->GetSecurity())
                 continue;
 
-        // check if target's level is in level range
-        uint8 lvl = target.GetLevel();
-        if (lvl < request.MinLevel || lvl > request.MaxLevel)
-            continue;
-
         // check if class matches classmask
         if (request.ClassFilter >= 0 && !(request.ClassFilter & (1 << target.GetClass())))
             continue;
@@ -229,7 +229,7 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
 
         // 50 is maximum player count sent to client - can be overridden
         // through config, but is unstable
-        if (response.Response.Entries.size() >= sWorld->getIntConfig(CONFIG_MAX_WHO))
+        if (response.Response.Entries.size() >= maxWho)
             break;
     }
 
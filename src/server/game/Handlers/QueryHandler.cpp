@@ -169,60 +169,33 @@ void WorldSession::HandleNpcTextQueryOpcode(WorldPackets::Query::QueryNPCText& p
 {
     TC_LOG_DEBUG("network", "WORLD: CMSG_NPC_TEXT_QUERY TextId: %u", packet.TextID);
 
-    NpcText const* npcText = sObjectMgr->GetNpcText(packet.TextID);
-
-    WorldPackets::Query::QueryNPCTextResponse response;
-    response.TextID = packet.TextID;
-
-    if (npcText)
+    if (sWorld->getBoolConfig(CONFIG_CACHE_DATA_QUERIES))
     {
-        for (uint8 i = 0; i < MAX_NPC_TEXT_OPTIONS; ++i)
+        if (WorldPacket const* queryData = sObjectMgr->GetNpcTextQueryData(packet.TextID))
         {
-            response.Probabilities[i] = npcText->Data[i].Probability;
-            response.BroadcastTextID[i] = npcText->Data[i].BroadcastTextID;
-            if (!response.Allow && npcText->Data[i].BroadcastTextID)
-                response.Allow = true;
+            SendPacket(queryData);
+            return;
         }
     }
 
-    if (!response.Allow)
-        TC_LOG_ERROR("sql.sql", "HandleNpcTextQueryOpcode: no BroadcastTextID found for text %u in `npc_text table`", packet.TextID);
-
-    SendPacket(response.Write());
+    WorldPacket response = sObjectMgr->BuildNpcTextQueryData(packet.TextID);
+    SendPacket(&response);
 }
 
 /// Only _static_ data is sent in this packet !!!
 void WorldSession::HandleQueryPageText(WorldPackets::Query::QueryPageText& packet)
 {
-    WorldPackets::Query::QueryPageTextResponse response;
-    response.PageTextID = packet.PageTextID;
-
-    uint32 pageID = packet.PageTextID;
-    while (pageID)
+    if (sWorld->getBoolConfig(CONFIG_CACHE_DATA_QUERIES))
     {
-        PageText const* pageText = sObjectMgr->GetPageText(pageID);
-        if (!pageText)
-            break;
-
-        WorldPackets::Query::QueryPageTextResponse::PageTextInfo page;
-        page.ID = pageID;
-        page.NextPageID = pageText->NextPageID;
-        page.Text = pageText->Text;
-        page.PlayerConditionID = pageText->PlayerConditionID;
-        page.Flags = pageText->Flags;
-
-        LocaleConstant locale = GetSessionDbLocaleIndex();
-        if (locale != LOCALE_enUS)
-            if (PageTextLocale const* pageTextLocale = sObjectMgr->GetPageTextLocale(pageID))
-                ObjectMgr::GetLocaleString(pageTextLocale->Text, locale, page.Text);
-
-        response.Pages.push_back(page);
-        pageID = pageText->NextPageID;
+        if (WorldPacket const* queryData = sObjectMgr->GetPageTextQueryData(packet.PageTextID, GetSessionDbLocaleIndex()))
+        {
+            SendPacket(queryData);
+            return;
+        }
     }
 
-    response.Allow = !response.Pages.empty();
-
-    SendPacket(response.Write());
+    WorldPacket response = sObjectMgr->BuildPageTextQueryData(packet.PageTextID, GetSessionDbLocaleIndex());
+    SendPacket(&response);
 }
 
 void WorldSession::HandleQueryCorpseTransport(WorldPackets::Query::QueryCorpseTransport& queryCorpseTransport)
@@ -228,8 +228,10 @@ void WorldSession::HandleOpenWrappedItemCallback(uint16 pos, ObjectGuid itemGuid
     uint32 entry = fields[0].GetUInt32();
     uint32 flags = fields[1].GetUInt32();
 
+    uint32 oldEntry = item->GetEntry();
     item->SetGiftCreator(ObjectGuid::Empty);
     item->SetEntry(entry);
+    GetPlayer()->UpdateItemEntryIndex(item, oldEntry);
     item->SetItemFlags(ItemFieldFlags(flags));
     item->SetMaxDurability(item->GetTemplate()->MaxDurability);
     item->SetState(ITEM_CHANGED, GetPlayer());
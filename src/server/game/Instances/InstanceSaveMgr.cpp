@@ -18,6 +18,7 @@
 #include "InstanceSaveMgr.h"
 #include "Common.h"
 #include "Config.h"
+#include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
 #include "GameTime.h"
@@ -68,6 +69,9 @@ void InstanceSaveManager::Unload()
 
         delete save;
     }
+
+    m_instanceSaveById.clear();
+    m_instanceIdsByMapDifficulty.clear();
 }
 
 /*
@@ -126,6 +130,7 @@ InstanceSave* InstanceSaveManager::AddInstanceSave(uint32 mapId, uint32 instance
         save->SaveToDB();
 
     m_instanceSaveById[instanceId] = save;
+    m_instanceIdsByMapDifficulty[MAKE_PAIR64(mapId, difficulty)].insert(instanceId);
     return save;
 }
 
@@ -176,6 +181,7 @@ void InstanceSaveManager::RemoveInstanceSave(uint32 InstanceId)
         }
 
         itr->second->SetToDelete(true);
+        _RemoveFromMapDifficultyIndex(itr->second);
         m_instanceSaveById.erase(itr);
     }
 }
@@ -601,6 +607,7 @@ void InstanceSaveManager::_ResetSave(InstanceSaveHashMap::iterator &itr)
 
     if (shouldDelete)
     {
+        _RemoveFromMapDifficultyIndex(itr->second);
         delete itr->second;
         itr = m_instanceSaveById.erase(itr);
     }
@@ -610,6 +617,17 @@ void InstanceSaveManager::_ResetSave(InstanceSaveHashMap::iterator &itr)
     lock_instLists = false;
 }
 
+void InstanceSaveManager::_RemoveFromMapDifficultyIndex(InstanceSave const* save)
+{
+    auto itr = m_instanceIdsByMapDifficulty.find(MAKE_PAIR64(save->GetMapId(), save->GetDifficultyID()));
+    if (itr == m_instanceIdsByMapDifficulty.end())
+        return;
+
+    itr->second.erase(save->GetInstanceId());
+    if (itr->second.empty())
+        m_instanceIdsByMapDifficulty.erase(itr);
+}
+
 void InstanceSaveManager::_ResetInstance(uint32 mapid, uint32 instanceId)
 {
     TC_LOG_DEBUG("maps", "InstanceSaveMgr::_ResetInstance %u, %u", mapid, instanceId);
@@ -683,12 +701,16 @@ void InstanceSaveManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, b
         CharacterDatabase.CommitTransaction(trans);
 
         // promote loaded binds to instances of the given map
-        for (InstanceSaveHashMap::iterator itr = m_instanceSaveById.begin(); itr != m_instanceSaveById.end();)
+        // ids are copied first, _ResetSave removes deleted saves from the index
+        std::vector<uint32> instanceIds;
+        if (std::unordered_set<uint32> const* saves = Trinity::Containers::MapGetValuePtr(m_instanceIdsByMapDifficulty, MAKE_PAIR64(mapid, difficulty)))
+            instanceIds.assign(saves->begin(), saves->end());
+
+        for (uint32 instanceId : instanceIds)
         {
-            if (itr->second->GetMapId() == mapid && itr->second->GetDifficultyID() == difficulty)
+            InstanceSaveHashMap::iterator itr = m_instanceSaveById.find(instanceId);
+            if (itr != m_instanceSaveById.end())
                 _ResetSave(itr);
-            else
-                ++itr;
         }
 
         SetResetTimeFor(mapid, difficulty, next_reset);
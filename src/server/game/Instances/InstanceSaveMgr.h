@@ -22,10 +22,12 @@
 #include <map>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
 #include "DBCEnums.h"
+#include "InstrumentedMutex.h"
 #include "ObjectDefines.h"
 
 struct InstanceTemplate;
@@ -84,7 +86,7 @@ class TC_GAME_API InstanceSave
            does not include the members of the group unless they have permanent saves */
         void AddPlayer(Player* player)
         {
-            std::lock_guard<std::mutex> lock(_playerListLock);
+            std::lock_guard<Trinity::InstrumentedMutex> lock(_playerListLock);
             m_playerList.push_back(player);
         }
 
@@ -145,7 +147,7 @@ class TC_GAME_API InstanceSave
         bool m_canReset;
         bool m_toDelete;
 
-        std::mutex _playerListLock;
+        Trinity::InstrumentedMutex _playerListLock{ "InstanceSave::_playerListLock" };
 };
 
 typedef std::unordered_map<uint64 /*PAIR64(map, difficulty)*/, time_t /*resetTime*/> ResetTimeByMapDifficultyMap;
@@ -160,6 +162,7 @@ class TC_GAME_API InstanceSaveManager
 
     public:
         typedef std::unordered_map<uint32 /*InstanceId*/, InstanceSave*> InstanceSaveHashMap;
+        typedef std::unordered_map<uint64 /*PAIR64(map, difficulty)*/, std::unordered_set<uint32 /*InstanceId*/>> InstanceIdsByMapDifficultyMap;
 
         static InstanceSaveManager* instance();
 
@@ -229,10 +232,13 @@ class TC_GAME_API InstanceSaveManager
         void _ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime);
         void _ResetInstance(uint32 mapid, uint32 instanceId);
         void _ResetSave(InstanceSaveHashMap::iterator &itr);
+        void _RemoveFromMapDifficultyIndex(InstanceSave const* save);
         // used during global instance resets
         bool lock_instLists;
         // fast lookup by instance id
         InstanceSaveHashMap m_instanceSaveById;
+        // saves of each map and difficulty, global resets only visit these instead of every loaded save
+        InstanceIdsByMapDifficultyMap m_instanceIdsByMapDifficulty;
         // fast lookup for reset times (always use existed functions for access/set)
         ResetTimeByMapDifficultyMap m_resetTimeByMapDifficulty;
         ResetTimeQueue m_resetTimeQueue;
@@ -74,7 +74,7 @@ void InstanceScript::SaveToDB()
     stmt->setString(1, data);
     stmt->setUInt32(2, _entranceId);
     stmt->setUInt32(3, instance->GetInstanceId());
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.ExecuteCoalesced(stmt, instance->GetInstanceId());
 }
 
 bool InstanceScript::IsEncounterInProgress() const
@@ -25,9 +25,11 @@
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "Random.h"
+#include "ResultSnapshotStore.h"
 #include "SpellInfo.h"
 #include "SpellMgr.h"
 #include "World.h"
+#include <limits>
 
 static Rates const qualityToRate[MAX_ITEM_QUALITY] =
 {
@@ -80,7 +82,7 @@ private:
 class LootTemplate::LootGroup                               // A set of loot definitions for items (refs are not allowed)
 {
     public:
-        LootGroup() { }
+        LootGroup() : CommonLootMode(0xFFFF) { }
         ~LootGroup();
 
         void AddEntry(LootStoreItem* item);                 // Adds an entry to the group (at loading stage)
@@ -100,7 +102,13 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+        // Built at loading, used to roll without filtering when no entry of the group can be invalid for the loot
+        std::vector<float> ExplicitlyChancedBounds;         // Running total of ExplicitlyChanced chances, infinite from the first 100% entry
+        std::vector<uint32> ItemIds;                        // Sorted item ids of all entries
+        uint16 CommonLootMode;                              // Loot mode bits shared by all entries
+
         LootStoreItem const* Roll(Loot& loot, uint16 lootMode) const;   // Rolls an item from the group, returns NULL if all miss their chances
+        bool CanHaveInvalidEntries(Loot const& loot, uint16 lootMode) const;
 
         // This class must never be copied - storing pointers
         LootGroup(LootGroup const&) = delete;
@@ -133,7 +141,8 @@ uint32 LootStore::LoadLootTable()
     Clear();
 
     //                                                  0     1            2               3         4         5             6
-    QueryResult result = WorldDatabase.PQuery("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM %s", GetName());
+    std::string query = Trinity::StringFormat("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM %s", GetName());
+    QueryResult result = sResultSnapshotStore->Query(WorldDatabase, query.c_str());
 
     if (!result)
         return 0;
@@ -370,39 +379,76 @@ LootTemplate::LootGroup::~LootGroup()
 void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
 {
     if (item->chance != 0)
+    {
+        float previous = ExplicitlyChancedBounds.empty() ? 0.0f : ExplicitlyChancedBounds.back();
+        ExplicitlyChancedBounds.push_back(item->chance >= 100.0f ? std::numeric_limits<float>::infinity() : previous + item->chance);
         ExplicitlyChanced.push_back(item);
+    }
     else
         EqualChanced.push_back(item);
+
+    ItemIds.insert(std::upper_bound(ItemIds.begin(), ItemIds.end(), item->itemid), item->itemid);
+    CommonLootMode &= item->lootmode;
+}
+
+// False when every entry is guaranteed to pass LootGroupInvalidSelector (all share a bit of lootMode and none is in the loot yet)
+bool LootTemplate::LootGroup::CanHaveInvalidEntries(Loot const& loot, uint16 lootMode) const
+{
+    if (!(CommonLootMode & lootMode))
+        return true;
+
+    for (LootItem const& item : loot.items)
+        if (std::binary_search(ItemIds.begin(), ItemIds.end(), item.itemid))
+            return true;
+
+    return false;
 }
 
 // Rolls an item from the group, returns NULL if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, uint16 lootMode) const
 {
-    LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    if (!CanHaveInvalidEntries(loot, lootMode))
+    {
+        if (!ExplicitlyChanced.empty())                     // First explicitly chanced entries are checked
+        {
+            float roll = (float)rand_chance();
+            auto bound = std::upper_bound(ExplicitlyChancedBounds.begin(), ExplicitlyChancedBounds.end(), roll);
+            if (bound != ExplicitlyChancedBounds.end())
+                return ExplicitlyChanced[std::distance(ExplicitlyChancedBounds.begin(), bound)];
+        }
+
+        if (!EqualChanced.empty())                          // If nothing selected yet - an item is taken from equal-chanced part
+            return Trinity::Containers::SelectRandomContainerElement(EqualChanced);
+
+        return nullptr;
+    }
+
+    LootGroupInvalidSelector isInvalid(loot, lootMode);
+    float roll = (float)rand_chance();
 
-    if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
+    for (LootStoreItem* item : ExplicitlyChanced)           // check each explicitly chanced entry in the template and modify its chance based on quality.
     {
-        float roll = (float)rand_chance();
+        if (isInvalid(item))
+            continue;
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
-        {
-            LootStoreItem* item = *itr;
-            if (item->chance >= 100.0f)
-                return item;
+        if (item->chance >= 100.0f)
+            return item;
 
-            roll -= item->chance;
-            if (roll < 0)
-                return item;
-        }
+        roll -= item->chance;
+        if (roll < 0)
+            return item;
     }
 
-    possibleLoot = EqualChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
-    if (!possibleLoot.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-        return Trinity::Containers::SelectRandomContainerElement(possibleLoot);
+    uint32 possibleCount = uint32(std::count_if(EqualChanced.begin(), EqualChanced.end(), [&isInvalid](LootStoreItem* item) { return !isInvalid(item); }));
+    if (!possibleCount)
+        return nullptr;                                     // Empty drop from the group
+
+    uint32 selected = urand(0, possibleCount - 1);
+    for (LootStoreItem* item : EqualChanced)
+        if (!isInvalid(item) && !selected--)
+            return item;
 
-    return nullptr;                                            // Empty drop from the group
+    return nullptr;
 }
 
 // True if group includes at least 1 quest drop entry
@@ -0,0 +1,122 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "GridPreloader.h"
+#include "Log.h"
+#include <cstdio>
+
+namespace
+{
+    void WarmFile(std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+            return;
+
+        char buffer[64 * 1024];
+        while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+            ;
+
+        fclose(file);
+    }
+}
+
+GridPreloadRequest::Terrain* GridPreloadRequest::FindTerrain(uint32 mapId)
+{
+    for (Terrain& terrain : Terrains)
+        if (terrain.MapId == mapId)
+            return &terrain;
+
+    return nullptr;
+}
+
+GridPreloader::~GridPreloader()
+{
+    Stop();
+}
+
+GridPreloader* GridPreloader::instance()
+{
+    static GridPreloader instance;
+    return &instance;
+}
+
+void GridPreloader::Start()
+{
+    if (IsEnabled())
+        return;
+
+    _worker = std::thread(&GridPreloader::WorkerThread, this);
+    TC_LOG_INFO("server.loading", "Started grid preloading thread");
+}
+
+void GridPreloader::Stop()
+{
+    if (!IsEnabled())
+        return;
+
+    _queue.Cancel();
+    _worker.join();
+}
+
+void GridPreloader::Submit(std::shared_ptr<GridPreloadRequest> request)
+{
+    _queue.Push(std::move(request));
+}
+
+void GridPreloader::Release(std::shared_ptr<GridMap> gridMap)
+{
+    if (!gridMap || !IsEnabled())
+        return;
+
+    // nothing waits for this request, the worker skips it and destroys it along with the grid map
+    std::shared_ptr<GridPreloadRequest> request = std::make_shared<GridPreloadRequest>();
+    request->Terrains.emplace_back();
+    request->Terrains.back().Grid = std::move(gridMap);
+    Submit(std::move(request));
+}
+
+void GridPreloader::WorkerThread()
+{
+    for (;;)
+    {
+        std::shared_ptr<GridPreloadRequest> request;
+
+        _queue.WaitAndPop(request);
+
+        if (!request)
+            return;
+
+        // nobody is waiting for this grid anymore
+        if (request.use_count() == 1)
+            continue;
+
+        for (GridPreloadRequest::Terrain& terrain : request->Terrains)
+        {
+            std::shared_ptr<GridMap> gridMap = std::make_shared<GridMap>();
+            terrain.Result = gridMap->loadData(terrain.FileName.c_str());
+            if (terrain.Result == GridMap::LoadResult::Ok)
+                terrain.Grid = std::move(gridMap);
+        }
+
+        for (std::string const& fileName : request->WarmFiles)
+            WarmFile(fileName);
+
+        request->Ready = true;
+    }
+}
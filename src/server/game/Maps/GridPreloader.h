@@ -0,0 +1,84 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _GRID_PRELOADER_H
+#define _GRID_PRELOADER_H
+
+#include "Define.h"
+#include "Map.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// terrain of one grid read ahead of a player walking or flying towards it
+struct GridPreloadRequest
+{
+    struct Terrain
+    {
+        uint32 MapId = 0;
+        std::string FileName;
+        std::shared_ptr<GridMap> Grid;
+        GridMap::LoadResult Result = GridMap::LoadResult::FileDoesNotExist;
+    };
+
+    // root terrain map followed by its child terrain maps, in Map::LoadMap order
+    std::vector<Terrain> Terrains;
+    // vmtile and mmtile files only read once to have them in the page cache, their managers are not thread safe
+    std::vector<std::string> WarmFiles;
+    uint32 QueueTime = 0;
+    std::atomic<bool> Ready{ false };
+
+    // only valid once Ready is set
+    Terrain* FindTerrain(uint32 mapId);
+};
+
+// Loads GridMap files and reads vmap/mmap tiles on a background thread
+// Staged grid maps are attached by Map::LoadMapAndVMap on the map thread once a grid is created
+// vmap and mmap tiles of unloaded grids are still unloaded by the map thread, only GridMap data is freed here
+class TC_GAME_API GridPreloader
+{
+    public:
+        static GridPreloader* instance();
+
+        void Start();
+        void Stop();
+
+        bool IsEnabled() const { return _worker.joinable(); }
+
+        void Submit(std::shared_ptr<GridPreloadRequest> request);
+
+        // drops the reference to terrain of an unloaded grid on the background thread
+        // so the map update doesn't pay for freeing it, released inline when the thread is not running
+        void Release(std::shared_ptr<GridMap> gridMap);
+
+    private:
+        GridPreloader() = default;
+        ~GridPreloader();
+
+        void WorkerThread();
+
+        ProducerConsumerQueue<std::shared_ptr<GridPreloadRequest>> _queue;
+        std::thread _worker;
+};
+
+#define sGridPreloader GridPreloader::instance()
+
+#endif
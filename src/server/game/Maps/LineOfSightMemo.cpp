@@ -0,0 +1,74 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LineOfSightMemo.h"
+#include "Hash.h"
+#include "IVMapManager.h"
+#include <algorithm>
+
+bool LineOfSightMemo::Key::operator==(Key const& right) const
+{
+    return Phases == right.Phases && std::equal(std::begin(Coords), std::end(Coords), std::begin(right.Coords))
+        && Checks == right.Checks && IgnoreFlags == right.IgnoreFlags;
+}
+
+std::size_t LineOfSightMemo::KeyHash::operator()(Key const& key) const
+{
+    std::size_t hashVal = 0;
+    Trinity::hash_combine(hashVal, key.Phases);
+    for (float coord : key.Coords)
+        Trinity::hash_combine(hashVal, coord);
+    Trinity::hash_combine(hashVal, key.Checks);
+    Trinity::hash_combine(hashVal, key.IgnoreFlags);
+    return hashVal;
+}
+
+LineOfSightMemo::Key LineOfSightMemo::MakeKey(PhaseShift const& phaseShift, VMAP::LineOfSightSegment const& segment, uint8 checks, uint32 ignoreFlags)
+{
+    return { &phaseShift, { segment.X1, segment.Y1, segment.Z1, segment.X2, segment.Y2, segment.Z2 }, checks, ignoreFlags };
+}
+
+bool LineOfSightMemo::Find(PhaseShift const& phaseShift, VMAP::LineOfSightSegment const& segment, uint8 checks, uint32 ignoreFlags, bool& inLineOfSight)
+{
+    auto itr = _results.find(MakeKey(phaseShift, segment, checks, ignoreFlags));
+    if (itr == _results.end())
+    {
+        ++_misses;
+        return false;
+    }
+
+    inLineOfSight = itr->second;
+    ++_hits;
+    return true;
+}
+
+void LineOfSightMemo::Store(PhaseShift const& phaseShift, VMAP::LineOfSightSegment const& segment, uint8 checks, uint32 ignoreFlags, bool inLineOfSight)
+{
+    if (_results.size() >= _capacity)
+        return;
+
+    _results.emplace(MakeKey(phaseShift, segment, checks, ignoreFlags), inLineOfSight);
+}
+
+void LineOfSightMemo::TakeStats(uint32& hits, uint32& misses)
+{
+    hits = _hits;
+    misses = _misses;
+    _hits = 0;
+    _misses = 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _LINE_OF_SIGHT_MEMO_H
+#define _LINE_OF_SIGHT_MEMO_H
+
+#include "Define.h"
+#include <unordered_map>
+
+class PhaseShift;
+
+namespace VMAP
+{
+    struct LineOfSightSegment;
+}
+
+// Line of sight results of a single map update, spell effects and chain jumps tend to ask for the same pairs repeatedly
+// Entries are keyed by the exact segment so anything that moved misses, the owner clears it every update
+class TC_GAME_API LineOfSightMemo
+{
+    public:
+        explicit LineOfSightMemo(std::size_t capacity) : _capacity(capacity), _hits(0), _misses(0) { }
+
+        bool Find(PhaseShift const& phaseShift, VMAP::LineOfSightSegment const& segment, uint8 checks, uint32 ignoreFlags, bool& inLineOfSight);
+        void Store(PhaseShift const& phaseShift, VMAP::LineOfSightSegment const& segment, uint8 checks, uint32 ignoreFlags, bool inLineOfSight);
+
+        void Clear() { _results.clear(); }
+
+        // hit and miss counts since the previous call
+        void TakeStats(uint32& hits, uint32& misses);
+
+    private:
+        struct Key
+        {
+            PhaseShift const* Phases;
+            float Coords[6];
+            uint8 Checks;
+            uint32 IgnoreFlags;
+
+            bool operator==(Key const& right) const;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(Key const& key) const;
+        };
+
+        static Key MakeKey(PhaseShift const& phaseShift, VMAP::LineOfSightSegment const& segment, uint8 checks, uint32 ignoreFlags);
+
+        std::size_t _capacity;
+        std::unordered_map<Key, bool, KeyHash> _results;
+        uint32 _hits;
+        uint32 _misses;
+};
+
+#endif
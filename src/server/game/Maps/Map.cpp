@@ -26,27 +26,34 @@
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
 #include "GameTime.h"
+#include "GridPreloader.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "GridStates.h"
 #include "Group.h"
+#include "HeapProfiler.h"
 #include "InstancePackets.h"
 #include "InstanceScenario.h"
 #include "InstanceScript.h"
+#include "LineOfSightMemo.h"
 #include "Log.h"
 #include "MapInstanced.h"
 #include "MapManager.h"
+#include "MemoryAccounting.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
 #include "MotionMaster.h"
+#include "MoveSpline.h"
 #include "ObjectAccessor.h"
 #include "ObjectGridLoader.h"
 #include "ObjectMgr.h"
+#include "PathCache.h"
 #include "Pet.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
+#include "TransientObjectPool.h"
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
@@ -57,11 +64,10 @@
 #include "WorldSession.h"
 #include <sstream>
 
-#include "Hacks/boost_1_74_fibonacci_heap.h"
-BOOST_1_74_FIBONACCI_HEAP_MSVC_COMPILE_FIX(RespawnListContainer::value_type)
-
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
+#define GRID_PRELOAD_EXPIRY     (30 * IN_MILLISECONDS)
+#define MAP_HEIGHT_PACK_LIMIT   512.0f                      // float height maps spanning less than this are kept as uint16 (accuracy 1/128 yard)
 #define MAX_CREATURE_ATTACK_RADIUS  (45.0f * sWorld->getRate(RATE_CREATURE_AGGRO))
 
 GridState* si_GridStates[MAX_GRID_STATE];
@@ -235,25 +241,37 @@ void Map::LoadVMap(int gx, int gy)
     }
 }
 
-void Map::LoadMap(int gx, int gy)
+void Map::LoadMap(int gx, int gy, GridPreloadRequest* preload /*= nullptr*/)
 {
-    LoadMapImpl(this, gx, gy);
+    LoadMapImpl(this, gx, gy, preload);
 
     for (Map* childBaseMap : *m_childTerrainMaps)
-        childBaseMap->LoadMap(gx, gy);
+        childBaseMap->LoadMap(gx, gy, preload);
 }
 
-void Map::LoadMapImpl(Map* map, int gx, int gy)
+void Map::LoadMapImpl(Map* map, int gx, int gy, GridPreloadRequest* preload)
 {
     if (map->GridMaps[gx][gy])
         return;
 
     // map file name
     std::string fileName = Trinity::StringFormat("%smaps/%04u_%02u_%02u.map", sWorld->GetDataPath().c_str(), map->GetId(), gx, gy);
-    TC_LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
-    // loading data
-    std::shared_ptr<GridMap> gridMap = std::make_shared<GridMap>();
-    GridMap::LoadResult gridMapLoadResult = gridMap->loadData(fileName.c_str());
+    std::shared_ptr<GridMap> gridMap;
+    GridMap::LoadResult gridMapLoadResult;
+    if (GridPreloadRequest::Terrain* terrain = preload ? preload->FindTerrain(map->GetId()) : nullptr)
+    {
+        TC_LOG_DEBUG("maps", "Using preloaded map %s", fileName.c_str());
+        gridMap = std::move(terrain->Grid);
+        gridMapLoadResult = terrain->Result;
+    }
+    else
+    {
+        TC_LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
+        // loading data
+        gridMap = std::make_shared<GridMap>();
+        gridMapLoadResult = gridMap->loadData(fileName.c_str());
+    }
+
     if (gridMapLoadResult == GridMap::LoadResult::Ok)
         map->GridMaps[gx][gy] = std::move(gridMap);
     else
@@ -286,12 +304,38 @@ void Map::UnloadMap(int gx, int gy)
 
 void Map::UnloadMapImpl(Map* map, int gx, int gy)
 {
-    map->GridMaps[gx][gy] = nullptr;
+    // freeing terrain data is left to the grid preloader thread
+    sGridPreloader->Release(std::move(map->GridMaps[gx][gy]));
+}
+
+void Map::PreloadAllTerrain()
+{
+    Map* terrainRoot = GetRootParentTerrainMap();
+    std::lock_guard<Trinity::InstrumentedMutex> lock(terrainRoot->_gridLock);
+
+    for (int32 gx = 0; gx < MAX_NUMBER_OF_GRIDS; ++gx)
+    {
+        for (int32 gy = 0; gy < MAX_NUMBER_OF_GRIDS; ++gy)
+        {
+            if (!terrainRoot->i_gridFileExists[gx * MAX_NUMBER_OF_GRIDS + gy])
+                continue;
+
+            if (!terrainRoot->GridMaps[gx][gy])
+                terrainRoot->LoadMapAndVMap(gx, gy);
+
+            // never released, unloading grids can't drop the reference count to 0 anymore
+            if (terrainRoot->GridMaps[gx][gy])
+                ++terrainRoot->GridMapReference[gx][gy];
+        }
+    }
+
+    _terrainPreloaded = true;
 }
 
 void Map::LoadMapAndVMap(int gx, int gy)
 {
-    LoadMap(gx, gy);
+    std::shared_ptr<GridPreloadRequest> preload = TakeGridPreload(gx, gy);
+    LoadMap(gx, gy, preload.get());
     // Only load the data for the base map
     if (this == m_parentMap)
     {
@@ -300,6 +344,126 @@ void Map::LoadMapAndVMap(int gx, int gy)
     }
 }
 
+void Map::PreloadGridsAhead(Player const* player)
+{
+    if (player->GetTransport())
+        return;
+
+    int32 lookAhead = int32(sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD));
+    float x = player->GetPositionX();
+    float y = player->GetPositionY();
+    float aheadX, aheadY;
+    if (!player->movespline->Finalized())
+    {
+        // taxi flights and other server controlled movement follow a known path
+        Movement::Location ahead = player->movespline->ComputePosition(lookAhead);
+        aheadX = ahead.x;
+        aheadY = ahead.y;
+    }
+    else if (player->HasUnitMovementFlag(MOVEMENTFLAG_FORWARD | MOVEMENTFLAG_BACKWARD))
+    {
+        float distance = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN) * lookAhead / IN_MILLISECONDS;
+        float angle = player->GetOrientation();
+        if (player->HasUnitMovementFlag(MOVEMENTFLAG_BACKWARD))
+            angle += float(M_PI);
+
+        aheadX = x + std::cos(angle) * distance;
+        aheadY = y + std::sin(angle) * distance;
+    }
+    else
+        return;
+
+    float dx = aheadX - x;
+    float dy = aheadY - y;
+    float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance < 1.0f)
+        return;
+
+    // grids get loaded once they enter visibility range, so look that much further than the predicted position
+    float reach = distance + GetVisibilityRange();
+    float step = SIZE_OF_GRIDS / 2;
+    uint32 steps = uint32(std::ceil(reach / step));
+    Map* rootParentTerrainMap = m_parentMap->GetRootParentTerrainMap();
+    for (uint32 i = 1; i <= steps; ++i)
+    {
+        float pointDist = std::min(i * step, reach);
+        GridCoord p = Trinity::ComputeGridCoord(x + dx / distance * pointDist, y + dy / distance * pointDist);
+        if (!p.IsCoordValid())
+            break;
+
+        int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+        int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+        if (!GridMaps[gx][gy])
+            rootParentTerrainMap->PreloadGrid(gx, gy);
+    }
+}
+
+void Map::PreloadGrid(int gx, int gy)
+{
+    {
+        // never wait for a map thread that is loading grids right now, the grid will be asked for again next update
+        std::unique_lock<Trinity::InstrumentedMutex> lock(_gridLock, std::try_to_lock);
+        if (!lock.owns_lock() || GridMaps[gx][gy])
+            return;
+    }
+
+    uint32 now = getMSTime();
+    uint32 key = gx * MAX_NUMBER_OF_GRIDS + gy;
+
+    std::lock_guard<std::mutex> lock(_gridPreloadLock);
+    for (auto itr = _gridPreloads.begin(); itr != _gridPreloads.end();)
+    {
+        // drop grids that players turned away from
+        if (getMSTimeDiff(itr->second->QueueTime, now) > GRID_PRELOAD_EXPIRY)
+            itr = _gridPreloads.erase(itr);
+        else
+            ++itr;
+    }
+
+    if (_gridPreloads.count(key))
+        return;
+
+    std::shared_ptr<GridPreloadRequest> request = std::make_shared<GridPreloadRequest>();
+    request->QueueTime = now;
+    AddGridPreloadTerrain(*request, gx, gy);
+
+    if (VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled())
+        request->WarmFiles.push_back(Trinity::StringFormat("%svmaps/%04u_%02u_%02u.vmtile", sWorld->GetDataPath().c_str(), GetId(), gy, gx));
+
+    if (DisableMgr::IsPathfindingEnabled(GetId()))
+        request->WarmFiles.push_back(Trinity::StringFormat("%smmaps/%04u%02i%02i.mmtile", sWorld->GetDataPath().c_str(), GetId(), gx, gy));
+
+    _gridPreloads[key] = request;
+    sGridPreloader->Submit(std::move(request));
+}
+
+void Map::AddGridPreloadTerrain(GridPreloadRequest& request, int gx, int gy) const
+{
+    GridPreloadRequest::Terrain& terrain = request.Terrains.emplace_back();
+    terrain.MapId = GetId();
+    terrain.FileName = Trinity::StringFormat("%smaps/%04u_%02u_%02u.map", sWorld->GetDataPath().c_str(), GetId(), gx, gy);
+
+    for (Map const* childBaseMap : *m_childTerrainMaps)
+        childBaseMap->AddGridPreloadTerrain(request, gx, gy);
+}
+
+std::shared_ptr<GridPreloadRequest> Map::TakeGridPreload(int gx, int gy)
+{
+    std::lock_guard<std::mutex> lock(_gridPreloadLock);
+    auto itr = _gridPreloads.find(gx * MAX_NUMBER_OF_GRIDS + gy);
+    if (itr == _gridPreloads.end())
+        return nullptr;
+
+    std::shared_ptr<GridPreloadRequest> request = std::move(itr->second);
+    _gridPreloads.erase(itr);
+
+    // still queued or being read, load the grid the usual way
+    if (!request->Ready)
+        return nullptr;
+
+    return request;
+}
+
 void Map::LoadAllCells()
 {
     for (uint32 cellX = 0; cellX < TOTAL_NUMBER_OF_CELLS_PER_MAP; cellX++)
@@ -329,9 +493,14 @@ i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(Inst
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
-i_gridExpiry(expiry),
-i_scriptLock(false), _respawnCheckTimer(0)
+i_gridExpiry(expiry), _gridUnloadBudget(0), _terrainPreloaded(false),
+i_scriptLock(false), _respawnCheckTimer(0), _updateCostEstimate(0), _lastUpdateWorker(std::numeric_limits<size_t>::max()), _pendingUpdateDiff(0)
 {
+    if (uint32 pathCacheSize = sWorld->getIntConfig(CONFIG_PATHFINDING_CACHE_SIZE))
+        _pathCache = std::make_unique<PathCache>(pathCacheSize);
+
+    _lineOfSightMemo = std::make_unique<LineOfSightMemo>(4096);
+
     if (_parent)
     {
         m_parentMap = _parent;
@@ -521,7 +690,7 @@ void Map::DeleteFromWorld(Transport* transport)
 
 void Map::EnsureGridCreated(GridCoord const& p)
 {
-    std::lock_guard<std::mutex> lock(_gridLock);
+    std::lock_guard<Trinity::InstrumentedMutex> lock(_gridLock);
     EnsureGridCreated_i(p);
 }
 
@@ -529,6 +698,7 @@ void Map::EnsureGridCreated(GridCoord const& p)
 //But object data is not loaded here
 void Map::EnsureGridCreated_i(GridCoord const& p)
 {
+    Trinity::HeapProfiler::Scope heapProfilerScope("grids");
     if (!getNGrid(p.x_coord, p.y_coord))
     {
         TC_LOG_DEBUG("maps", "Creating grid[%u, %u] for map %u instance %u", p.x_coord, p.y_coord, GetId(), i_InstanceId);
@@ -536,6 +706,17 @@ void Map::EnsureGridCreated_i(GridCoord const& p)
         NGridType* ngrid = new NGridType(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld->getBoolConfig(CONFIG_GRID_UNLOAD));
         setNGrid(ngrid, p.x_coord, p.y_coord);
 
+        // grid comes back within one expiry period of its last unload, keep it around longer this time
+        auto history = _gridUnloadHistory.find(ngrid->GetGridId());
+        if (history != _gridUnloadHistory.end())
+        {
+            uint8 maxScale = uint8(std::max(sWorld->getIntConfig(CONFIG_GRID_UNLOAD_MAX_EXPIRY_SCALE), 1u));
+            if (GameTime::GetGameTimeMS() - history->second.UnloadTime < uint32(i_gridExpiry))
+                ngrid->SetExpiryScale(std::min<uint8>(history->second.ExpiryScale * 2, maxScale));
+
+            _gridUnloadHistory.erase(history);
+        }
+
         // build a linkage between this map and NGridType
         buildNGridLinkage(ngrid);
 
@@ -549,7 +730,7 @@ void Map::EnsureGridCreated_i(GridCoord const& p)
         {
             Map* rootParentTerrainMap = m_parentMap->GetRootParentTerrainMap();
             // because LoadMapAndVMap is always entered using rootParentTerrainMap, we can only lock that once and not have to do it for every child map
-            std::unique_lock<std::mutex> lock(rootParentTerrainMap->_gridLock, std::defer_lock);
+            std::unique_lock<Trinity::InstrumentedMutex> lock(rootParentTerrainMap->_gridLock, std::defer_lock);
             if (this != rootParentTerrainMap)
                 lock.lock();
 
@@ -608,6 +789,7 @@ bool Map::EnsureGridLoaded(Cell const& cell)
 
 void Map::LoadGridObjects(NGridType* grid, Cell const& cell)
 {
+    Trinity::HeapProfiler::Scope heapProfilerScope("grids");
     ObjectGridLoader loader(*grid, this, cell);
     loader.LoadN();
 }
@@ -791,7 +973,7 @@ bool Map::IsGridLoaded(GridCoord const& p) const
     return (getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord));
 }
 
-void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
+void Map::MarkNearbyCellsOf(WorldObject const* obj)
 {
     // Check for valid position
     if (!obj->IsPositionValid())
@@ -811,7 +993,46 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
                 continue;
 
             markCell(cell_id);
-            CellCoord pair(x, y);
+            _markedCellIds.push_back(cell_id);
+        }
+    }
+}
+
+void Map::UpdateMarkedCells(TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
+{
+    TC_METRIC_TRACE_SCOPE("map_update_phase", TC_METRIC_TAG("phase", "Visit cells"), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+
+    auto stripeOf = [](uint32 cellId) { return (cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS; };
+
+    // split the active cell set into grid-aligned column stripes and walk every stripe row by row
+    // cells of one grid are then updated back to back instead of in the order players happened to mark them
+    std::sort(_markedCellIds.begin(), _markedCellIds.end(), [&stripeOf](uint32 left, uint32 right)
+    {
+        uint32 leftStripe = stripeOf(left);
+        uint32 rightStripe = stripeOf(right);
+        if (leftStripe != rightStripe)
+            return leftStripe < rightStripe;
+
+        return left < right;
+    });
+
+    _cellUpdateRegions.clear();
+    for (uint32 i = 0; i < _markedCellIds.size(); ++i)
+    {
+        if (_cellUpdateRegions.empty() || stripeOf(_markedCellIds[_cellUpdateRegions.back().first]) != stripeOf(_markedCellIds[i]))
+            _cellUpdateRegions.emplace_back(i, i);
+
+        _cellUpdateRegions.back().second = i + 1;
+    }
+
+    // object updates can reach into neighbouring cells (spells, AI, relocations) so regions are processed
+    // one after another; cross-cell relocations are already deferred to the Move*InMoveList phase
+    for (std::pair<uint32, uint32> const& region : _cellUpdateRegions)
+    {
+        for (uint32 i = region.first; i < region.second; ++i)
+        {
+            uint32 cellId = _markedCellIds[i];
+            CellCoord pair(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP);
             Cell cell(pair);
             cell.SetNoCreate();
             Visit(cell, gridVisitor);
@@ -835,19 +1056,37 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
     ++_zonePlayerCountMap[newZone];
 }
 
+uint32 Map::ConsumeUpdateDiff(uint32 diff)
+{
+    _pendingUpdateDiff += diff;
+
+    // sessions are updated from Map::Update, maps with players must never wait
+    if (!HavePlayers() && _pendingUpdateDiff < sWorld->getIntConfig(CONFIG_INTERVAL_MAPUPDATE_IDLE))
+        return 0;
+
+    uint32 updateDiff = _pendingUpdateDiff;
+    _pendingUpdateDiff = 0;
+    return updateDiff;
+}
+
 void Map::Update(uint32 t_diff)
 {
+    Trinity::HeapProfiler::Scope heapProfilerScope("maps");
     _dynamicTree.update(t_diff);
+    _lineOfSightMemo->Clear();
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* player = m_mapRefIter->GetSource();
-        if (player && player->IsInWorld())
+        TC_METRIC_TRACE_SCOPE("map_update_phase", TC_METRIC_TAG("phase", "Update sessions"), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            //player->Update(t_diff);
-            WorldSession* session = player->GetSession();
-            MapSessionFilter updater(session);
-            session->Update(t_diff, updater);
+            Player* player = m_mapRefIter->GetSource();
+            if (player && player->IsInWorld())
+            {
+                //player->Update(t_diff);
+                WorldSession* session = player->GetSession();
+                MapSessionFilter updater(session);
+                session->Update(t_diff, updater);
+            }
         }
     }
 
@@ -860,6 +1099,14 @@ void Map::Update(uint32 t_diff)
     else
         _respawnCheckTimer -= t_diff;
 
+    ProcessPvPCombatExpiry();
+
+    bool const refreshDistantCombatPartners = _distantCombatCheckTimer <= t_diff;
+    if (refreshDistantCombatPartners)
+        _distantCombatCheckTimer = uint32(m_VisibilityNotifyPeriod);
+    else
+        _distantCombatCheckTimer -= t_diff;
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -879,24 +1126,31 @@ void Map::Update(uint32 t_diff)
             continue;
 
         // update players at tick
-        player->Update(t_diff);
+        {
+            TC_METRIC_TRACE_SCOPE("map_update_phase", TC_METRIC_TAG("phase", "Update player"), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+            player->Update(t_diff);
+        }
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        MarkNearbyCellsOf(player);
+
+        if (sGridPreloader->IsEnabled())
+            PreloadGridsAhead(player);
 
         // If player is using far sight or mind vision, visit that object too
         if (WorldObject* viewPoint = player->GetViewpoint())
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+            MarkNearbyCellsOf(viewPoint);
 
         // Handle updates for creatures in combat with player and are more than 60 yards away
+        // the list is rebuilt once per visibility notify period or when combat with a new creature started
         if (player->IsInCombat())
         {
-            std::vector<Unit*> toVisit;
-            for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
-                if (Creature* unit = pair.second->GetOther(player)->ToCreature())
-                    if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        toVisit.push_back(unit);
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+            CombatManager& combatManager = player->GetCombatManager();
+            if (refreshDistantCombatPartners || combatManager.HasNewCombatPartners())
+                combatManager.RefreshDistantCombatPartners(GetVisibilityRange());
+
+            std::vector<Creature*> const& toVisit = combatManager.GetDistantCombatPartners();
+            for (std::size_t i = 0; i < toVisit.size(); ++i)
+                MarkNearbyCellsOf(toVisit[i]);
         }
 
         { // Update any creatures that own auras the player has applications of
@@ -908,7 +1162,7 @@ void Map::Update(uint32 t_diff)
                         toVisit.insert(caster);
             }
             for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+                MarkNearbyCellsOf(unit);
         }
 
         { // Update player's summons
@@ -922,7 +1176,7 @@ void Map::Update(uint32 t_diff)
                             toVisit.push_back(unit);
 
             for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+                MarkNearbyCellsOf(unit);
         }
     }
 
@@ -935,9 +1189,11 @@ void Map::Update(uint32 t_diff)
         if (!obj || !obj->IsInWorld())
             continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        MarkNearbyCellsOf(obj);
     }
 
+    UpdateMarkedCells(grid_object_update, world_object_update);
+
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
         WorldObject* obj = *_transportsUpdateIter;
@@ -972,15 +1228,22 @@ void Map::Update(uint32 t_diff)
     // update phase shift objects
     GetMultiPersonalPhaseTracker().Update(this, t_diff);
 
-    MoveAllCreaturesInMoveList();
-    MoveAllGameObjectsInMoveList();
-    MoveAllAreaTriggersInMoveList();
+    {
+        TC_METRIC_TRACE_SCOPE("map_update_phase", TC_METRIC_TAG("phase", "Relocate objects"), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+        MoveAllCreaturesInMoveList();
+        MoveAllGameObjectsInMoveList();
+        MoveAllAreaTriggersInMoveList();
+    }
 
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
         ProcessRelocationNotifies(t_diff);
 
     sScriptMgr->OnMapUpdate(this, t_diff);
 
+    TC_METRIC_VALUE("map_update_diff", uint64(t_diff),
+        TC_METRIC_TAG("map_id", std::to_string(GetId())),
+        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
     TC_METRIC_VALUE("map_creatures", uint64(GetObjectsStore().Size<Creature>()),
         TC_METRIC_TAG("map_id", std::to_string(GetId())),
         TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
@@ -988,22 +1251,59 @@ void Map::Update(uint32 t_diff)
     TC_METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         TC_METRIC_TAG("map_id", std::to_string(GetId())),
         TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    if (_pathCache)
+    {
+        uint32 pathCacheHits, pathCacheMisses;
+        _pathCache->TakeStats(pathCacheHits, pathCacheMisses);
+        if (pathCacheHits || pathCacheMisses)
+        {
+            TC_METRIC_VALUE("map_path_cache_hits", uint64(pathCacheHits),
+                TC_METRIC_TAG("map_id", std::to_string(GetId())),
+                TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+            TC_METRIC_VALUE("map_path_cache_misses", uint64(pathCacheMisses),
+                TC_METRIC_TAG("map_id", std::to_string(GetId())),
+                TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+        }
+    }
+
+    // results are only valid for the objects and gameobject states of this update
+    _lineOfSightMemo->Clear();
+
+    uint32 lineOfSightHits, lineOfSightMisses;
+    _lineOfSightMemo->TakeStats(lineOfSightHits, lineOfSightMisses);
+    if (lineOfSightHits || lineOfSightMisses)
+    {
+        TC_METRIC_VALUE("map_los_memo_hits", uint64(lineOfSightHits),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        TC_METRIC_VALUE("map_los_memo_misses", uint64(lineOfSightMisses),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
+
+    // spells, auras and summons freed in bursts during this update go back to the system allocator here
+    Trinity::TransientObjectPool::Instance().Trim();
 }
 
 struct ResetNotifier
 {
-    template<class T>inline void resetNotify(GridRefManager<T> &m)
+    template<class T>inline void resetNotify(GridObjectContainer<T> &m)
     {
-        for (typename GridRefManager<T>::iterator iter=m.begin(); iter != m.end(); ++iter)
+        for (typename GridObjectContainer<T>::iterator iter=m.begin(); iter != m.end(); ++iter)
             iter->GetSource()->ResetAllNotifies();
     }
-    template<class T> void Visit(GridRefManager<T> &) { }
+    template<class T> void Visit(GridObjectContainer<T> &) { }
     void Visit(CreatureMapType &m) { resetNotify<Creature>(m);}
     void Visit(PlayerMapType &m) { resetNotify<Player>(m);}
 };
 
 void Map::ProcessRelocationNotifies(const uint32 diff)
 {
+    TC_METRIC_TRACE_SCOPE("map_update_phase", TC_METRIC_TAG("phase", "Relocation notifies"), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
     {
         NGridType *grid = i->GetSource();
@@ -1207,6 +1507,7 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         AddToGrid(player, new_cell);
     }
 
+    player->UpdateGridPosition();
     player->UpdatePositionData();
     player->UpdateObjectVisibility(false);
 }
@@ -1233,6 +1534,7 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
     else
     {
         creature->Relocate(x, y, z, ang);
+        creature->UpdateGridPosition();
         if (creature->IsVehicle())
             creature->GetVehicleKit()->RelocatePassengers();
         creature->UpdateObjectVisibility(false);
@@ -1265,6 +1567,7 @@ void Map::GameObjectRelocation(GameObject* go, float x, float y, float z, float
     else
     {
         go->Relocate(x, y, z, orientation);
+        go->UpdateGridPosition();
         go->UpdateModelPosition();
         go->UpdatePositionData();
         go->UpdateObjectVisibility(false);
@@ -1296,6 +1599,7 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
     else
     {
         dynObj->Relocate(x, y, z, orientation);
+        dynObj->UpdateGridPosition();
         dynObj->UpdatePositionData();
         dynObj->UpdateObjectVisibility(false);
         RemoveDynamicObjectFromMoveList(dynObj);
@@ -1326,6 +1630,7 @@ void Map::AreaTriggerRelocation(AreaTrigger* at, float x, float y, float z, floa
     else
     {
         at->Relocate(x, y, z, orientation);
+        at->UpdateGridPosition();
         at->UpdateShape();
         at->UpdateObjectVisibility(false);
         RemoveAreaTriggerFromMoveList(at);
@@ -1434,6 +1739,7 @@ void Map::MoveAllCreaturesInMoveList()
         {
             // update pos
             c->Relocate(c->_newPosition);
+            c->UpdateGridPosition();
             if (c->IsVehicle())
                 c->GetVehicleKit()->RelocatePassengers();
             //CreatureRelocationNotify(c, new_cell, new_cell.cellCoord());
@@ -1491,6 +1797,7 @@ void Map::MoveAllGameObjectsInMoveList()
         {
             // update pos
             go->Relocate(go->_newPosition);
+            go->UpdateGridPosition();
             go->UpdateModelPosition();
             go->UpdatePositionData();
             go->UpdateObjectVisibility(false);
@@ -1537,6 +1844,7 @@ void Map::MoveAllDynamicObjectsInMoveList()
         {
             // update pos
             dynObj->Relocate(dynObj->_newPosition);
+            dynObj->UpdateGridPosition();
             dynObj->UpdatePositionData();
             dynObj->UpdateObjectVisibility(false);
         }
@@ -1576,6 +1884,7 @@ void Map::MoveAllAreaTriggersInMoveList()
         {
             // update pos
             at->Relocate(at->_newPosition);
+            at->UpdateGridPosition();
             at->UpdateShape();
             at->UpdateObjectVisibility(false);
         }
@@ -1698,6 +2007,7 @@ bool Map::CreatureRespawnRelocation(Creature* c, bool diffGridOnly)
     if (CreatureCellRelocation(c, resp_cell))
     {
         c->Relocate(resp_x, resp_y, resp_z, resp_o);
+        c->UpdateGridPosition();
         c->GetMotionMaster()->Initialize(); // prevent possible problems with default move generators
         //CreatureRelocationNotify(c, resp_cell, resp_cell.GetCellCoord());
         c->UpdatePositionData();
@@ -1726,6 +2036,7 @@ bool Map::GameObjectRespawnRelocation(GameObject* go, bool diffGridOnly)
     if (GameObjectCellRelocation(go, resp_cell))
     {
         go->Relocate(resp_x, resp_y, resp_z, resp_o);
+        go->UpdateGridPosition();
         go->UpdatePositionData();
         go->UpdateObjectVisibility(false);
         return true;
@@ -1790,6 +2101,13 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 
         ASSERT(i_objectsToRemove.empty());
 
+        if (!unloadAll)
+        {
+            _gridUnloadHistory[ngrid.GetGridId()] = { GameTime::GetGameTimeMS(), ngrid.GetExpiryScale() };
+            if (_gridUnloadBudget)
+                --_gridUnloadBudget;
+        }
+
         delete &ngrid;
         setNGrid(nullptr, x, y);
     }
@@ -1893,6 +2211,7 @@ GridMap::GridMap()
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
     _holes = nullptr;
+    _memoryUsage = 0;
 }
 
 GridMap::~GridMap()
@@ -1901,6 +2220,16 @@ GridMap::~GridMap()
 }
 
 GridMap::LoadResult GridMap::loadData(char const* filename)
+{
+    LoadResult result = loadFile(filename);
+
+    // arrays of partially loaded files are kept until unloadData as well
+    _memoryUsage = calculateMemoryUsage();
+    Trinity::MemoryAccounting::Allocated(Trinity::MemoryCategory::Terrain, _memoryUsage);
+    return result;
+}
+
+GridMap::LoadResult GridMap::loadFile(char const* filename)
 {
     // Unload old data if exist
     unloadData();
@@ -1959,6 +2288,9 @@ GridMap::LoadResult GridMap::loadData(char const* filename)
 
 void GridMap::unloadData()
 {
+    Trinity::MemoryAccounting::Released(Trinity::MemoryCategory::Terrain, _memoryUsage);
+    _memoryUsage = 0;
+
     delete[] _areaMap;
     delete[] m_V9;
     delete[] m_V8;
@@ -1978,6 +2310,37 @@ void GridMap::unloadData()
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
+std::size_t GridMap::calculateMemoryUsage() const
+{
+    std::size_t heightSize = 0;
+    if (_gridGetHeight == &GridMap::getHeightFromFloat)
+        heightSize = sizeof(float);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint16)
+        heightSize = sizeof(uint16);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint8)
+        heightSize = sizeof(uint8);
+
+    std::size_t usage = 0;
+    if (m_V9)
+        usage += 129 * 129 * heightSize;
+    if (m_V8)
+        usage += 128 * 128 * heightSize;
+    if (_minHeightPlanes)
+        usage += 8 * sizeof(G3D::Plane);
+    if (_areaMap)
+        usage += 16 * 16 * sizeof(uint16);
+    if (_liquidEntry)
+        usage += 16 * 16 * sizeof(uint16);
+    if (_liquidFlags)
+        usage += 16 * 16 * sizeof(map_liquidHeaderTypeFlags);
+    if (_liquidMap)
+        usage += uint32(_liquidWidth) * uint32(_liquidHeight) * sizeof(float);
+    if (_holes)
+        usage += 16 * 16 * 8 * sizeof(uint8);
+
+    return usage;
+}
+
 bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_areaHeader header;
@@ -2035,6 +2398,7 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
                 fread(m_V8, sizeof(float), 128*128, in) != 128*128)
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
+            packFloatHeights(header.gridMaxHeight);
         }
     }
     else
@@ -2085,6 +2449,33 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+void GridMap::packFloatHeights(float maxHeight)
+{
+    // same uint16 packing as the map extractor uses, but only if it stays well within GROUND_HEIGHT_TOLERANCE
+    float diff = maxHeight - _gridHeight;
+    if (diff <= 0.0f || diff > MAP_HEIGHT_PACK_LIMIT)
+        return;
+
+    auto inRange = [&](float height) { return height >= _gridHeight && height <= maxHeight; };
+    if (!std::all_of(m_V9, m_V9 + 129 * 129, inRange) || !std::all_of(m_V8, m_V8 + 128 * 128, inRange))
+        return;
+
+    float step = 65535 / diff;
+    uint16* packedV9 = new uint16[129 * 129];
+    uint16* packedV8 = new uint16[128 * 128];
+    for (uint32 i = 0; i < 129 * 129; ++i)
+        packedV9[i] = uint16((m_V9[i] - _gridHeight) * step + 0.5f);
+    for (uint32 i = 0; i < 128 * 128; ++i)
+        packedV8[i] = uint16((m_V8[i] - _gridHeight) * step + 0.5f);
+
+    delete[] m_V9;
+    delete[] m_V8;
+    m_uint16_V9 = packedV9;
+    m_uint16_V8 = packedV8;
+    _gridIntHeightMultiplier = diff / 65535;
+    _gridGetHeight = &GridMap::getHeightFromUint16;
+}
+
 bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
@@ -2578,11 +2969,50 @@ float Map::GetWaterOrGroundLevel(PhaseShift const& phaseShift, float x, float y,
 }
 
 float Map::GetStaticHeight(PhaseShift const& phaseShift, float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/)
+{
+    uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, this, x, y);
+    float gridHeight = VMAP_INVALID_HEIGHT_VALUE;
+    if (GridMap* gmap = GetGrid(terrainMapId, x, y))
+        gridHeight = gmap->getHeight(x, y);
+
+    return SelectStaticHeight(terrainMapId, gridHeight, x, y, z, checkVMap, maxSearchDist);
+}
+
+void Map::GetHeights(PhaseShift const& phaseShift, std::vector<Position>& positions, bool vmap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/)
+{
+    // terrain map and GridMap lookups (including the grid lock) are only done once per run of positions in the same grid
+    // both grid indexings are compared because they can disagree exactly on grid borders
+    GridCoord lastCoord(MAX_NUMBER_OF_GRIDS, MAX_NUMBER_OF_GRIDS);
+    int lastGx = -1;
+    int lastGy = -1;
+    uint32 terrainMapId = GetId();
+    GridMap* gmap = nullptr;
+    for (Position& pos : positions)
+    {
+        float x = pos.GetPositionX();
+        float y = pos.GetPositionY();
+        float z = pos.GetPositionZ();
+        GridCoord coord = Trinity::ComputeGridCoord(x, y);
+        int gx = (int)(CENTER_GRID_ID - x / SIZE_OF_GRIDS);
+        int gy = (int)(CENTER_GRID_ID - y / SIZE_OF_GRIDS);
+        if (coord != lastCoord || gx != lastGx || gy != lastGy)
+        {
+            terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, this, x, y);
+            gmap = GetGrid(terrainMapId, x, y);
+            lastCoord = coord;
+            lastGx = gx;
+            lastGy = gy;
+        }
+
+        float gridHeight = gmap ? gmap->getHeight(x, y) : VMAP_INVALID_HEIGHT_VALUE;
+        pos.m_positionZ = std::max<float>(SelectStaticHeight(terrainMapId, gridHeight, x, y, z, vmap, maxSearchDist), GetGameObjectFloor(phaseShift, x, y, z, maxSearchDist));
+    }
+}
+
+float Map::SelectStaticHeight(uint32 terrainMapId, float gridHeight, float x, float y, float z, bool checkVMap, float maxSearchDist)
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, this, x, y);
-    float gridHeight = GetGridHeight(phaseShift, x, y);
     if (G3D::fuzzyGe(z, gridHeight - GROUND_HEIGHT_TOLERANCE))
         mapHeight = gridHeight;
 
@@ -2981,13 +3411,66 @@ float Map::GetWaterLevel(PhaseShift const& phaseShift, float x, float y)
 
 bool Map::isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
+    VMAP::LineOfSightSegment segment(x1, y1, z1, x2, y2, z2);
+    bool inLineOfSight;
+    if (_lineOfSightMemo->Find(phaseShift, segment, checks, uint32(ignoreFlags), inLineOfSight))
+        return inLineOfSight;
+
+    inLineOfSight = true;
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
       && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(PhasingHandler::GetTerrainMapId(phaseShift, this, x1, y1), x1, y1, z1, x2, y2, z2, ignoreFlags))
-        return false;
-    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
+        inLineOfSight = false;
+    else if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
       && !_dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phaseShift))
-        return false;
-    return true;
+        inLineOfSight = false;
+
+    _lineOfSightMemo->Store(phaseShift, segment, checks, uint32(ignoreFlags), inLineOfSight);
+    return inLineOfSight;
+}
+
+void Map::isInLineOfSight(PhaseShift const& phaseShift, std::vector<VMAP::LineOfSightSegment>& segments, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    std::vector<VMAP::LineOfSightSegment> pending;
+    std::vector<std::size_t> pendingIndexes;
+    pending.reserve(segments.size());
+    pendingIndexes.reserve(segments.size());
+
+    Optional<uint32> terrainMapId;
+    for (std::size_t i = 0; i < segments.size(); ++i)
+    {
+        VMAP::LineOfSightSegment& segment = segments[i];
+        if (_lineOfSightMemo->Find(phaseShift, segment, checks, uint32(ignoreFlags), segment.InLineOfSight))
+            continue;
+
+        // segments starting across a terrain swap border can't share the map tree
+        uint32 segmentTerrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, this, segment.X1, segment.Y1);
+        if (terrainMapId && *terrainMapId != segmentTerrainMapId)
+        {
+            segment.InLineOfSight = isInLineOfSight(phaseShift, segment.X1, segment.Y1, segment.Z1, segment.X2, segment.Y2, segment.Z2, checks, ignoreFlags);
+            continue;
+        }
+
+        terrainMapId = segmentTerrainMapId;
+        pending.emplace_back(segment.X1, segment.Y1, segment.Z1, segment.X2, segment.Y2, segment.Z2);
+        pendingIndexes.push_back(i);
+    }
+
+    if (pending.empty())
+        return;
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(*terrainMapId, pending, ignoreFlags);
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+        for (VMAP::LineOfSightSegment& segment : pending)
+            if (segment.InLineOfSight)
+                segment.InLineOfSight = _dynamicTree.isInLineOfSight({ segment.X1, segment.Y1, segment.Z1 }, { segment.X2, segment.Y2, segment.Z2 }, phaseShift);
+
+    for (std::size_t i = 0; i < pending.size(); ++i)
+    {
+        segments[pendingIndexes[i]].InLineOfSight = pending[i].InLineOfSight;
+        _lineOfSightMemo->Store(phaseShift, pending[i], checks, uint32(ignoreFlags), pending[i].InLineOfSight);
+    }
 }
 
 bool Map::getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -3123,6 +3606,9 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
 
 void Map::SendObjectUpdates()
 {
+    Trinity::HeapProfiler::Scope heapProfilerScope("updatedata");
+    TC_METRIC_TRACE_SCOPE("map_update_phase", TC_METRIC_TAG("phase", "Send object updates"), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+
     UpdateDataMapType update_players;
 
     while (!_updateObjects.empty())
@@ -3133,12 +3619,12 @@ void Map::SendObjectUpdates()
         obj->BuildUpdate(update_players);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
+        // each receiver gets its own buffer, handed over to the socket without another copy
+        WorldPacket packet;
         iter->second.BuildPacket(&packet);
-        iter->first->SendDirectMessage(&packet);
-        packet.clear();                                     // clean the string
+        iter->first->SendDirectMessage(std::move(packet));
     }
 }
 
@@ -3398,9 +3884,38 @@ void Map::DoRespawn(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 gr
     }
 }
 
+void Map::SchedulePvPCombatExpiry(PvPCombatReference const* ref)
+{
+    TimePoint now = GameTime::Now();
+    Milliseconds delay = std::max(std::chrono::duration_cast<Milliseconds>(ref->GetExpireTime() - now), Milliseconds::zero());
+    _pvpCombatExpiry.Schedule({ ref->first->GetGUID(), ref->second->GetGUID(), ref }, now, delay);
+}
+
+void Map::ProcessPvPCombatExpiry()
+{
+    if (!_pvpCombatExpiry.PopDue(GameTime::Now(), _duePvPCombatExpiry))
+        return;
+
+    for (PvPCombatExpiry const& expiry : _duePvPCombatExpiry)
+        if (Unit* first = GetCombatUnit(expiry.First))
+            first->GetCombatManager().ProcessPvPCombatExpiry(expiry.Second, expiry.Reference);
+}
+
+Unit* Map::GetCombatUnit(ObjectGuid const& guid)
+{
+    if (guid.IsPlayer())
+        return GetPlayer(guid);
+
+    if (guid.IsPet())
+        return GetPet(guid);
+
+    return GetCreature(guid);
+}
+
 void Map::ProcessRespawns()
 {
     time_t now = GameTime::GetGameTime();
+    CharacterDatabaseTransaction trans; // rescheduled respawn times are saved together
     while (!_respawnTimes.empty())
     {
         RespawnInfo* next = _respawnTimes.top();
@@ -3424,9 +3939,14 @@ void Map::ProcessRespawns()
         {
             ASSERT(now < next->respawnTime); // infinite loop guard
             _respawnTimes.decrease(next->handle);
-            SaveRespawnInfoDB(*next);
+            if (!trans)
+                trans = CharacterDatabase.BeginTransaction();
+            SaveRespawnInfoDB(*next, trans);
         }
     }
+
+    if (trans)
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 void Map::ApplyDynamicModeRespawnScaling(WorldObject const* obj, ObjectGuid::LowType spawnId, uint32& respawnDelay, uint32 mode) const
@@ -3476,11 +3996,16 @@ void Map::ApplyDynamicModeRespawnScaling(WorldObject const* obj, ObjectGuid::Low
 bool Map::ShouldBeSpawnedOnGridLoad(SpawnObjectType type, ObjectGuid::LowType spawnId) const
 {
     ASSERT(SpawnData::TypeHasData(type));
+    return ShouldBeSpawnedOnGridLoad(ASSERT_NOTNULL(sObjectMgr->GetSpawnMetadata(type, spawnId)));
+}
+
+bool Map::ShouldBeSpawnedOnGridLoad(SpawnMetadata const* spawnData) const
+{
+    ASSERT(SpawnData::TypeHasData(spawnData->type));
     // check if the object is on its respawn timer
-    if (GetRespawnTime(type, spawnId))
+    if (GetRespawnTime(spawnData->type, spawnData->spawnId))
         return false;
 
-    SpawnMetadata const* spawnData = ASSERT_NOTNULL(sObjectMgr->GetSpawnMetadata(type, spawnId));
     // check if the object is part of a spawn group
     SpawnGroupTemplateData const* spawnGroup = ASSERT_NOTNULL(spawnData->spawnGroupData);
     if (!(spawnGroup->flags & SPAWNGROUP_FLAG_SYSTEM))
@@ -3667,6 +4192,10 @@ void Map::DelayedUpdate(uint32 t_diff)
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattlegroundOrArena())
     {
+        _gridUnloadBudget = sWorld->getIntConfig(CONFIG_GRID_UNLOAD_MAX_PER_UPDATE);
+        if (!_gridUnloadBudget)
+            _gridUnloadBudget = std::numeric_limits<uint32>::max();
+
         for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
         {
             NGridType *grid = i->GetSource();
@@ -3987,7 +4516,7 @@ bool InstanceMap::AddPlayerToMap(Player* player, bool initPlayer /*= true*/)
     // Is it needed?
 
     {
-        std::lock_guard<std::mutex> lock(_mapLock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_mapLock);
         // Check moved to void WorldSession::HandleMoveWorldportAckOpcode()
         //if (!CanEnter(player))
             //return false;
@@ -4294,6 +4823,9 @@ void InstanceMap::UnloadAll()
     }
 
     Map::UnloadAll();
+
+    // the instance data is read back when the instance is loaded again
+    CharacterDatabase.FlushCoalescedWrites(GetInstanceId());
 }
 
 void InstanceMap::SendResetWarnings(uint32 timeLeft) const
@@ -4471,7 +5003,7 @@ Map::EnterState BattlegroundMap::CannotEnter(Player* player)
 bool BattlegroundMap::AddPlayerToMap(Player* player, bool initPlayer /*= true*/)
 {
     {
-        std::lock_guard<std::mutex> lock(_mapLock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_mapLock);
         //Check moved to void WorldSession::HandleMoveWorldportAckOpcode()
         //if (!CanEnter(player))
             //return false;
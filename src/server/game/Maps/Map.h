@@ -25,6 +25,7 @@
 #include "DynamicTree.h"
 #include "GridDefines.h"
 #include "GridRefManager.h"
+#include "InstrumentedMutex.h"
 #include "MapDefines.h"
 #include "MapRefManager.h"
 #include "MPSCQueue.h"
@@ -34,27 +35,33 @@
 #include "SharedDefines.h"
 #include "SpawnData.h"
 #include "Timer.h"
-#include <boost/heap/fibonacci_heap.hpp>
+#include "TimingWheel.h"
+#include <boost/heap/d_ary_heap.hpp>
 #include <bitset>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 class Battleground;
 class BattlegroundMap;
 class CreatureGroup;
 class GameObjectModel;
+struct GridPreloadRequest;
 class Group;
 class InstanceMap;
 class InstanceSave;
 class InstanceScript;
 class InstanceScenario;
+class LineOfSightMemo;
 class MapInstanced;
 class Object;
+class PathCache;
 class PhaseShift;
 class Player;
+struct PvPCombatReference;
 class TempSummon;
 class Unit;
 class Weather;
@@ -70,6 +77,11 @@ struct SummonPropertiesEntry;
 class Transport;
 enum Difficulty : uint8;
 enum WeatherState : uint32;
+
+namespace VMAP
+{
+    struct LineOfSightSegment;
+}
 enum class ItemContext : uint8;
 
 namespace Trinity { struct ObjectUpdater; }
@@ -160,10 +172,15 @@ class TC_GAME_API GridMap
 
     uint8* _holes;
 
+    // bytes reported to MemoryAccounting for the arrays above
+    std::size_t _memoryUsage;
+
+    std::size_t calculateMemoryUsage() const;
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
     bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+    void packFloatHeights(float maxHeight);
     bool isHole(int row, int col) const;
 
     // Get height functions and pointers
@@ -193,6 +210,9 @@ public:
     float getMinHeight(float x, float y) const;
     float getLiquidLevel(float x, float y) const;
     ZLiquidStatus GetLiquidStatus(float x, float y, float z, Optional<map_liquidHeaderTypeFlags> ReqLiquidType, LiquidData* data = nullptr, float collisionHeight = 2.03128f); // DEFAULT_COLLISION_HEIGHT in Object.h
+
+private:
+    LoadResult loadFile(char const* filename);
 };
 
 #pragma pack(push, 1)
@@ -231,7 +251,8 @@ struct CompareRespawnInfo
     bool operator()(RespawnInfo const* a, RespawnInfo const* b) const;
 };
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
-typedef boost::heap::fibonacci_heap<RespawnInfo*, boost::heap::compare<CompareRespawnInfo>> RespawnListContainer;
+// 4-ary heap stored in one array, cheaper to maintain than a node based fibonacci heap for the large respawn queues of dynamic spawning
+typedef boost::heap::d_ary_heap<RespawnInfo*, boost::heap::arity<4>, boost::heap::mutable_<true>, boost::heap::compare<CompareRespawnInfo>> RespawnListContainer;
 typedef RespawnListContainer::handle_type RespawnListHandle;
 typedef std::unordered_map<ObjectGuid::LowType, RespawnInfo*> RespawnInfoMap;
 struct RespawnInfo
@@ -285,10 +306,26 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         template<class T> bool AddToMap(T *);
         template<class T> void RemoveFromMap(T *, bool);
 
-        void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
+        void MarkNearbyCellsOf(WorldObject const* obj);
+        void UpdateMarkedCells(TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(uint32);
 
+        // accumulates diff between updates, returns the diff to pass to Update or 0 when the map skips this tick
+        // maps without players only update every CONFIG_INTERVAL_MAPUPDATE_IDLE
+        uint32 ConsumeUpdateDiff(uint32 diff);
+
+        // moving average of Update() wall time in microseconds, MapUpdater uses it to start the most expensive maps first
+        uint32 GetUpdateCostEstimate() const { return _updateCostEstimate; }
+        void RecordUpdateCost(uint32 microseconds) { _updateCostEstimate = uint32((uint64(_updateCostEstimate) * 7 + microseconds) / 8); }
+        // MapUpdater worker that ran the last Update(), preferred for the next one
+        size_t GetLastUpdateWorker() const { return _lastUpdateWorker; }
+        void SetLastUpdateWorker(size_t workerIndex) { _lastUpdateWorker = workerIndex; }
+
+        // poly corridors shared by all PathGenerators moving on this map, nullptr when disabled
+        PathCache* GetPathCache() const { return _pathCache.get(); }
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
+        int32 GetVisibilityNotifyPeriod() const { return m_VisibilityNotifyPeriod; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
 
@@ -324,9 +361,12 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void ResetGridExpiry(NGridType &grid, float factor = 1) const
         {
-            grid.ResetTimeTracker(time_t(float(i_gridExpiry)*factor));
+            grid.ResetTimeTracker(time_t(float(i_gridExpiry) * factor * grid.GetExpiryScale()));
         }
 
+        // grids expiring in the same update are unloaded over several updates, see GridUnload.MaxPerUpdate
+        bool HasGridUnloadBudget() const { return _gridUnloadBudget != 0; }
+
         time_t GetGridExpiry() const { return i_gridExpiry; }
 
         bool HasChildMapGridFile(uint32 mapId, int32 gx, int32 gy) const;
@@ -338,6 +378,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void DiscoverGridMapFiles();
 
+        // loads terrain of every grid of the map and keeps it loaded for the lifetime of the server
+        void PreloadAllTerrain();
+        bool IsTerrainPreloaded() const { return _terrainPreloaded; }
+
         Map* GetRootParentTerrainMap();
         void AddChildTerrainMap(Map* map) { m_childTerrainMaps->push_back(map); map->m_parentTerrainMap = this; }
         void UnlinkAllChildTerrainMaps() { m_childTerrainMaps->clear(); }
@@ -416,7 +460,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void AddObjectToSwitchList(WorldObject* obj, bool on);
         virtual void DelayedUpdate(uint32 diff);
 
-        void resetMarkedCells() { marked_cells.reset(); }
+        void resetMarkedCells() { marked_cells.reset(); _markedCellIds.clear(); }
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
@@ -527,10 +571,15 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         float GetStaticHeight(PhaseShift const& phaseShift, Position const& pos, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return GetStaticHeight(phaseShift, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), checkVMap, maxSearchDist); }
         float GetHeight(PhaseShift const& phaseShift, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return std::max<float>(GetStaticHeight(phaseShift, x, y, z, vmap, maxSearchDist), GetGameObjectFloor(phaseShift, x, y, z, maxSearchDist)); }
         float GetHeight(PhaseShift const& phaseShift, Position const& pos, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return GetHeight(phaseShift, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), vmap, maxSearchDist); }
+        // GetHeight for many positions at once, the Z of every position is replaced by its height
+        void GetHeights(PhaseShift const& phaseShift, std::vector<Position>& positions, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
         bool isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // fills InLineOfSight of every segment, checking all of them against the same trees
+        void isInLineOfSight(PhaseShift const& phaseShift, std::vector<VMAP::LineOfSightSegment>& segments, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
         void Balance() { _dynamicTree.balance(); }
         void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); }
         void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); }
+        void UpdateGameObjectModel(GameObjectModel const& model) { _dynamicTree.update(model); }
         bool ContainsGameObjectModel(GameObjectModel const& model) const { return _dynamicTree.contains(model);}
         float GetGameObjectFloor(PhaseShift const& phaseShift, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
         {
@@ -614,12 +663,20 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
-        void LoadMap(int gx, int gy);
-        static void LoadMapImpl(Map* map, int gx, int gy);
+        void LoadMap(int gx, int gy, GridPreloadRequest* preload = nullptr);
+        static void LoadMapImpl(Map* map, int gx, int gy, GridPreloadRequest* preload);
         void UnloadMap(int gx, int gy);
         static void UnloadMapImpl(Map* map, int gx, int gy);
         void LoadMMap(int gx, int gy);
         GridMap* GetGrid(uint32 mapId, float x, float y);
+        float SelectStaticHeight(uint32 terrainMapId, float gridHeight, float x, float y, float z, bool checkVMap, float maxSearchDist);
+
+        // queues terrain of grids ahead of a moving player, called on the player's map
+        void PreloadGridsAhead(Player const* player);
+        // called on the root parent terrain map, gx and gy index GridMaps
+        void PreloadGrid(int gx, int gy);
+        void AddGridPreloadTerrain(GridPreloadRequest& request, int gx, int gy) const;
+        std::shared_ptr<GridPreloadRequest> TakeGridPreload(int gx, int gy);
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
@@ -674,14 +731,15 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
+        void ProcessScriptAction(ScriptAction const& step);
 
         void SendObjectUpdates();
 
     protected:
         virtual void LoadGridObjects(NGridType* grid, Cell const& cell);
 
-        std::mutex _mapLock;
-        std::mutex _gridLock;
+        Trinity::InstrumentedMutex _mapLock{ "Map::_mapLock" };
+        Trinity::InstrumentedMutex _gridLock{ "Map::_gridLock" };
 
         MapEntry const* i_mapEntry;
         Difficulty i_spawnMode;
@@ -717,6 +775,17 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         time_t i_gridExpiry;
 
+        struct GridUnloadHistory
+        {
+            uint32 UnloadTime;
+            uint8 ExpiryScale;
+        };
+
+        // grids unloaded after expiring, used to keep grids loaded longer when players keep coming back to them
+        std::unordered_map<uint32 /*gridId*/, GridUnloadHistory> _gridUnloadHistory;
+        uint32 _gridUnloadBudget;
+        bool _terrainPreloaded;
+
         //used for fast base_map (e.g. MapInstanced class object) search for
         //InstanceMaps and BattlegroundMaps...
         Map* m_parentMap;                                           // points to MapInstanced* or self (always same map id)
@@ -728,6 +797,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint16 GridMapReference[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         std::bitset<MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS> i_gridFileExists; // cache what grids are available for this map (not including parent/child maps)
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        std::vector<uint32> _markedCellIds;                         // cells queued for update this tick, in marking order
+        std::vector<std::pair<uint32, uint32>> _cellUpdateRegions;   // [begin, end) ranges of _markedCellIds, one per grid-aligned stripe
 
         //these functions used to process player/mob aggro reactions and
         //visibility calculations. Highly optimized for massive calculations
@@ -738,10 +809,28 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
 
-        typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
-        ScriptScheduleMap m_scriptSchedule;
+        // scripts are due with a 10ms resolution, anything further than ~5s away waits in the wheel overflow
+        Trinity::TimingWheel<ScriptAction> m_scriptSchedule;
+        std::vector<ScriptAction> m_dueScripts;
+
+        // PvP combat timeouts of the units on this map, see CombatManager.h
+        struct PvPCombatExpiry
+        {
+            ObjectGuid First;
+            ObjectGuid Second;
+            PvPCombatReference const* Reference = nullptr;  // only compared, the reference may already be deleted
+        };
+
+        void ProcessPvPCombatExpiry();
+        Unit* GetCombatUnit(ObjectGuid const& guid);
+
+        Trinity::TimingWheel<PvPCombatExpiry, 50, 128> _pvpCombatExpiry;
+        std::vector<PvPCombatExpiry> _duePvPCombatExpiry;
+        uint32 _distantCombatCheckTimer = 0;
 
     public:
+        void SchedulePvPCombatExpiry(PvPCombatReference const* ref);
+
         void ProcessRespawns();
         void ApplyDynamicModeRespawnScaling(WorldObject const* obj, ObjectGuid::LowType spawnId, uint32& respawnDelay, uint32 mode) const;
 
@@ -776,6 +865,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         size_t DespawnAll(SpawnObjectType type, ObjectGuid::LowType spawnId);
 
         bool ShouldBeSpawnedOnGridLoad(SpawnObjectType type, ObjectGuid::LowType spawnId) const;
+        bool ShouldBeSpawnedOnGridLoad(SpawnMetadata const* spawnData) const;
         template <typename T> bool ShouldBeSpawnedOnGridLoad(ObjectGuid::LowType spawnId) const { return ShouldBeSpawnedOnGridLoad(SpawnData::TypeFor<T>, spawnId); }
 
         SpawnGroupTemplateData const* GetSpawnGroupData(uint32 groupId) const;
@@ -861,6 +951,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_set<uint32> _toggledSpawnGroupIds;
 
         uint32 _respawnCheckTimer;
+        uint32 _updateCostEstimate;
+        size_t _lastUpdateWorker;
+        uint32 _pendingUpdateDiff;
+        std::unique_ptr<PathCache> _pathCache;
+        std::unique_ptr<LineOfSightMemo> _lineOfSightMemo;
+        std::mutex _gridPreloadLock;
+        std::unordered_map<uint32, std::shared_ptr<GridPreloadRequest>> _gridPreloads;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapBenchmark.h"
+#include "Creature.h"
+#include "Map.h"
+#include "Metric.h"
+#include "TemporarySummon.h"
+#include "Unit.h"
+#include <algorithm>
+#include <map>
+
+namespace
+{
+    // viewpoints walk at run speed on circles of different radius around the center
+    constexpr float VIEWPOINT_SPEED = 7.0f;
+    constexpr float VIEWPOINT_MIN_RADIUS = 50.0f;
+    constexpr float VIEWPOINT_RADIUS_STEP = 40.0f;
+    constexpr uint32 VIEWPOINT_RADIUS_COUNT = 8;
+
+    struct Viewpoint
+    {
+        ObjectGuid Guid;
+        float Radius;
+        float Angle;
+    };
+}
+
+bool MapBenchmark::Run(Map* map, Position const& center, uint32 viewpoints, uint32 ticks, MapBenchmarkResult& result, std::string& error)
+{
+    if (!sMetric->StartTrace(Hours(1), ""))
+    {
+        error = "a trace is already being recorded";
+        return false;
+    }
+
+    std::vector<Viewpoint> paths;
+    paths.reserve(viewpoints);
+    for (uint32 i = 0; i < viewpoints; ++i)
+    {
+        Viewpoint viewpoint;
+        viewpoint.Radius = VIEWPOINT_MIN_RADIUS + VIEWPOINT_RADIUS_STEP * float(i % VIEWPOINT_RADIUS_COUNT);
+        viewpoint.Angle = float(2 * M_PI) * float(i) / float(viewpoints);
+
+        Position pos(center.GetPositionX() + viewpoint.Radius * std::cos(viewpoint.Angle), center.GetPositionY() + viewpoint.Radius * std::sin(viewpoint.Angle),
+            center.GetPositionZ());
+        TempSummon* summon = map->SummonCreature(WORLD_TRIGGER, pos);
+        if (!summon)
+            continue;
+
+        summon->setActive(true);
+        viewpoint.Guid = summon->GetGUID();
+        paths.push_back(viewpoint);
+    }
+
+    std::vector<double> tickTimes;
+    tickTimes.reserve(ticks);
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        for (Viewpoint& viewpoint : paths)
+        {
+            Creature* creature = map->GetCreature(viewpoint.Guid);
+            if (!creature)
+                continue;
+
+            viewpoint.Angle += VIEWPOINT_SPEED * TICK_DIFF / IN_MILLISECONDS / viewpoint.Radius;
+            float x = center.GetPositionX() + viewpoint.Radius * std::cos(viewpoint.Angle);
+            float y = center.GetPositionY() + viewpoint.Radius * std::sin(viewpoint.Angle);
+            float z = center.GetPositionZ();
+            creature->UpdateGroundPositionZ(x, y, z);
+            map->CreatureRelocation(creature, x, y, z, Position::NormalizeOrientation(viewpoint.Angle + float(M_PI / 2)));
+        }
+
+        TimePoint start = std::chrono::steady_clock::now();
+        map->Update(TICK_DIFF);
+        map->DelayedUpdate(TICK_DIFF);
+        tickTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::vector<MetricTraceEvent> events = sMetric->CollectTrace();
+
+    for (Viewpoint const& viewpoint : paths)
+        if (Creature* creature = map->GetCreature(viewpoint.Guid))
+            creature->DespawnOrUnsummon();
+
+    result.Ticks = ticks;
+    result.Viewpoints = uint32(paths.size());
+    if (!tickTimes.empty())
+    {
+        for (double tickTime : tickTimes)
+            result.TotalMs += tickTime;
+
+        std::sort(tickTimes.begin(), tickTimes.end());
+        result.P50Ms = tickTimes[(tickTimes.size() - 1) / 2];
+        result.P95Ms = tickTimes[(tickTimes.size() - 1) * 95 / 100];
+        result.MaxMs = tickTimes.back();
+    }
+
+    std::map<std::string, double> phases;
+    std::string mapId = std::to_string(map->GetId());
+    for (MetricTraceEvent const& event : events)
+    {
+        if (event.Category != "map_update_phase")
+            continue;
+
+        std::string const* phase = nullptr;
+        bool sameMap = false;
+        for (MetricTag const& tag : event.Tags)
+        {
+            if (tag.first == "phase")
+                phase = &tag.second;
+            else if (tag.first == "map_id")
+                sameMap = tag.second == mapId;
+        }
+
+        if (phase && sameMap)
+            phases[*phase] += std::chrono::duration<double, std::milli>(event.End - event.Start).count();
+    }
+
+    result.PhaseTotalMs.assign(phases.begin(), phases.end());
+    return true;
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAPBENCHMARK_H
+#define TRINITY_MAPBENCHMARK_H
+
+#include "Define.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+class Map;
+struct Position;
+
+struct MapBenchmarkResult
+{
+    uint32 Ticks = 0;
+    uint32 Viewpoints = 0;
+    double TotalMs = 0.0;
+    double P50Ms = 0.0;
+    double P95Ms = 0.0;
+    double MaxMs = 0.0;
+    std::vector<std::pair<std::string, double>> PhaseTotalMs;
+};
+
+/// Runs Map::Update on its own with a fixed tick length and active viewpoints circling around center on scripted paths.
+/// Every run with the same arguments feeds the map the same input, so results can be compared between builds.
+/// Must be called from the world thread while maps are not being updated (console commands)
+namespace MapBenchmark
+{
+    constexpr uint32 TICK_DIFF = 50;
+
+    TC_GAME_API bool Run(Map* map, Position const& center, uint32 viewpoints, uint32 ticks, MapBenchmarkResult& result, std::string& error);
+}
+
+#endif // TRINITY_MAPBENCHMARK_H
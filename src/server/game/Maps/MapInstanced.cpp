@@ -66,10 +66,13 @@ void MapInstanced::Update(uint32 t)
         else
         {
             // update only here, because it may schedule some bad things before delete
-            if (sMapMgr->GetMapUpdater()->activated())
-                sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
-            else
-                i->second->Update(t);
+            if (uint32 diff = i->second->ConsumeUpdateDiff(t))
+            {
+                if (sMapMgr->GetMapUpdater()->activated())
+                    sMapMgr->GetMapUpdater()->schedule_update(*i->second, diff);
+                else
+                    i->second->Update(diff);
+            }
             ++i;
         }
     }
@@ -211,7 +214,7 @@ Map* MapInstanced::CreateInstanceForPlayer(uint32 mapId, Player* player, uint32
 InstanceMap* MapInstanced::CreateInstance(uint32 InstanceId, InstanceSave* save, Difficulty difficulty, TeamId team)
 {
     // load/create a map
-    std::lock_guard<std::mutex> lock(_mapLock);
+    std::lock_guard<Trinity::InstrumentedMutex> lock(_mapLock);
 
     // make sure we have a valid map id
     MapEntry const* entry = sMapStore.LookupEntry(GetId());
@@ -253,7 +256,7 @@ InstanceMap* MapInstanced::CreateInstance(uint32 InstanceId, InstanceSave* save,
 BattlegroundMap* MapInstanced::CreateBattleground(uint32 InstanceId, Battleground* bg)
 {
     // load/create a map
-    std::lock_guard<std::mutex> lock(_mapLock);
+    std::lock_guard<Trinity::InstrumentedMutex> lock(_mapLock);
 
     TC_LOG_DEBUG("maps", "MapInstanced::CreateBattleground: map bg %d for %d created.", InstanceId, GetId());
 
@@ -268,7 +271,7 @@ BattlegroundMap* MapInstanced::CreateBattleground(uint32 InstanceId, Battlegroun
 
 GarrisonMap* MapInstanced::CreateGarrison(uint32 instanceId, Player* owner)
 {
-    std::lock_guard<std::mutex> lock(_mapLock);
+    std::lock_guard<Trinity::InstrumentedMutex> lock(_mapLock);
 
     GarrisonMap* map = new GarrisonMap(GetId(), GetGridExpiry(), instanceId, this, owner->GetGUID());
     ASSERT(map->IsGarrison());
@@ -289,7 +292,8 @@ bool MapInstanced::DestroyInstance(InstancedMaps::iterator &itr)
 
     itr->second->UnloadAll();
     // should only unload VMaps if this is the last instance and grid unloading is enabled
-    if (m_InstancedMaps.size() <= 1 && sWorld->getBoolConfig(CONFIG_GRID_UNLOAD))
+    // terrain preloaded with InstanceMapPreloadTerrain stays loaded for the next instance
+    if (m_InstancedMaps.size() <= 1 && sWorld->getBoolConfig(CONFIG_GRID_UNLOAD) && !IsTerrainPreloaded())
     {
         VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(itr->second->GetId());
         MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(itr->second->GetId());
@@ -88,7 +88,7 @@ Map* MapManager::CreateBaseMap(uint32 id)
             return ASSERT_NOTNULL(map);
         }
 
-        std::lock_guard<std::mutex> lock(_mapsLock);
+        std::lock_guard<Trinity::InstrumentedMutex> lock(_mapsLock);
         map = CreateBaseMap_i(entry);
     }
 
@@ -243,10 +243,19 @@ void MapManager::Update(uint32 diff)
     MapMapType::iterator iter = i_maps.begin();
     for (; iter != i_maps.end(); ++iter)
     {
+        // instanced base maps always update, their instances are throttled individually in MapInstanced::Update
+        uint32 mapDiff = uint32(i_timer.GetCurrent());
+        if (!iter->second->Instanceable())
+        {
+            mapDiff = iter->second->ConsumeUpdateDiff(mapDiff);
+            if (!mapDiff)
+                continue;
+        }
+
         if (m_updater.activated())
-            m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
+            m_updater.schedule_update(*iter->second, mapDiff);
         else
-            iter->second->Update(uint32(i_timer.GetCurrent()));
+            iter->second->Update(mapDiff);
     }
     if (m_updater.activated())
         m_updater.wait();
@@ -301,7 +310,7 @@ void MapManager::UnloadAll()
 
 uint32 MapManager::GetNumInstances()
 {
-    std::lock_guard<std::mutex> lock(_mapsLock);
+    std::lock_guard<Trinity::InstrumentedMutex> lock(_mapsLock);
 
     uint32 ret = 0;
     for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
@@ -318,7 +327,7 @@ uint32 MapManager::GetNumInstances()
 
 uint32 MapManager::GetNumPlayersInInstances()
 {
-    std::lock_guard<std::mutex> lock(_mapsLock);
+    std::lock_guard<Trinity::InstrumentedMutex> lock(_mapsLock);
 
     uint32 ret = 0;
     for (MapMapType::iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
@@ -159,7 +159,7 @@ class TC_GAME_API MapManager
         MapManager(MapManager const&) = delete;
         MapManager& operator=(MapManager const&) = delete;
 
-        std::mutex _mapsLock;
+        Trinity::InstrumentedMutex _mapsLock{ "MapManager::_mapsLock" };
         uint32 i_gridCleanUpDelay;
         MapMapType i_maps;
         IntervalTimer i_timer;
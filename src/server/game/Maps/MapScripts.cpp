@@ -56,7 +56,7 @@ void Map::ScriptsStart(std::map<uint32, std::multimap<uint32, ScriptInfo>> const
         sa.ownerGUID  = ownerGUID;
 
         sa.script = &iter->second;
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(GameTime::GetGameTime() + iter->first), sa));
+        m_scriptSchedule.Schedule(sa, GameTime::Now(), Seconds(iter->first));
         if (iter->first == 0)
             immedScript = true;
 
@@ -86,7 +86,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGUID  = ownerGUID;
 
     sa.script = &script;
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(GameTime::GetGameTime() + delay), sa));
+    m_scriptSchedule.Schedule(sa, GameTime::Now(), Seconds(delay));
 
     sMapMgr->IncreaseScheduledScriptsCount();
 
@@ -316,586 +316,587 @@ void Map::ScriptsProcess()
     if (m_scriptSchedule.empty())
         return;
 
-    ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= GameTime::GetGameTime()))
+    ///- Process overdue queued scripts, in the order they were due
+    while (m_scriptSchedule.PopDue(GameTime::Now(), m_dueScripts))
     {
-        ScriptAction const& step = iter->second;
+        for (ScriptAction const& step : m_dueScripts)
+        {
+            ProcessScriptAction(step);
+            sMapMgr->DecreaseScheduledScriptCount();
+        }
+    }
+}
 
-        Object* source = nullptr;
-        if (!step.sourceGUID.IsEmpty())
+void Map::ProcessScriptAction(ScriptAction const& step)
+{
+    Object* source = nullptr;
+    if (!step.sourceGUID.IsEmpty())
+    {
+        switch (step.sourceGUID.GetHigh())
         {
-            switch (step.sourceGUID.GetHigh())
-            {
-                case HighGuid::Item: // as well as HIGHGUID_CONTAINER
-                    if (Player* player = GetPlayer(step.ownerGUID))
-                        source = player->GetItemByGuid(step.sourceGUID);
-                    break;
-                case HighGuid::Creature:
-                case HighGuid::Vehicle:
-                    source = GetCreature(step.sourceGUID);
-                    break;
-                case HighGuid::Pet:
-                    source = GetPet(step.sourceGUID);
-                    break;
-                case HighGuid::Player:
-                    source = GetPlayer(step.sourceGUID);
-                    break;
-                case HighGuid::GameObject:
-                case HighGuid::Transport:
-                    source = GetGameObject(step.sourceGUID);
-                    break;
-                case HighGuid::Corpse:
-                    source = GetCorpse(step.sourceGUID);
-                    break;
-                default:
-                    TC_LOG_ERROR("scripts", "%s source with unsupported high guid %s.",
-                        step.script->GetDebugInfo().c_str(), step.sourceGUID.ToString().c_str());
-                    break;
-            }
+            case HighGuid::Item: // as well as HIGHGUID_CONTAINER
+                if (Player* player = GetPlayer(step.ownerGUID))
+                    source = player->GetItemByGuid(step.sourceGUID);
+                break;
+            case HighGuid::Creature:
+            case HighGuid::Vehicle:
+                source = GetCreature(step.sourceGUID);
+                break;
+            case HighGuid::Pet:
+                source = GetPet(step.sourceGUID);
+                break;
+            case HighGuid::Player:
+                source = GetPlayer(step.sourceGUID);
+                break;
+            case HighGuid::GameObject:
+            case HighGuid::Transport:
+                source = GetGameObject(step.sourceGUID);
+                break;
+            case HighGuid::Corpse:
+                source = GetCorpse(step.sourceGUID);
+                break;
+            default:
+                TC_LOG_ERROR("scripts", "%s source with unsupported high guid %s.",
+                    step.script->GetDebugInfo().c_str(), step.sourceGUID.ToString().c_str());
+                break;
         }
+    }
 
-        WorldObject* target = nullptr;
-        if (!step.targetGUID.IsEmpty())
+    WorldObject* target = nullptr;
+    if (!step.targetGUID.IsEmpty())
+    {
+        switch (step.targetGUID.GetHigh())
         {
-            switch (step.targetGUID.GetHigh())
-            {
-                case HighGuid::Creature:
-                case HighGuid::Vehicle:
-                    target = GetCreature(step.targetGUID);
-                    break;
-                case HighGuid::Pet:
-                    target = GetPet(step.targetGUID);
-                    break;
-                case HighGuid::Player:
-                    target = GetPlayer(step.targetGUID);
-                    break;
-                case HighGuid::GameObject:
-                case HighGuid::Transport:
-                    target = GetGameObject(step.targetGUID);
-                    break;
-                case HighGuid::Corpse:
-                    target = GetCorpse(step.targetGUID);
-                    break;
-                default:
-                    TC_LOG_ERROR("scripts", "%s target with unsupported high guid %s.",
-                        step.script->GetDebugInfo().c_str(), step.targetGUID.ToString().c_str());
-                    break;
-            }
+            case HighGuid::Creature:
+            case HighGuid::Vehicle:
+                target = GetCreature(step.targetGUID);
+                break;
+            case HighGuid::Pet:
+                target = GetPet(step.targetGUID);
+                break;
+            case HighGuid::Player:
+                target = GetPlayer(step.targetGUID);
+                break;
+            case HighGuid::GameObject:
+            case HighGuid::Transport:
+                target = GetGameObject(step.targetGUID);
+                break;
+            case HighGuid::Corpse:
+                target = GetCorpse(step.targetGUID);
+                break;
+            default:
+                TC_LOG_ERROR("scripts", "%s target with unsupported high guid %s.",
+                    step.script->GetDebugInfo().c_str(), step.targetGUID.ToString().c_str());
+                break;
         }
+    }
 
-        switch (step.script->command)
+    switch (step.script->command)
+    {
+        case SCRIPT_COMMAND_TALK:
         {
-            case SCRIPT_COMMAND_TALK:
+            if (step.script->Talk.ChatType > CHAT_TYPE_BOSS_WHISPER)
             {
-                if (step.script->Talk.ChatType > CHAT_TYPE_BOSS_WHISPER)
+                TC_LOG_ERROR("scripts", "%s invalid chat type (%u) specified, skipping.", step.script->GetDebugInfo().c_str(), step.script->Talk.ChatType);
+                break;
+            }
+
+            if (step.script->Talk.Flags & SF_TALK_USE_PLAYER)
+                source = _GetScriptPlayerSourceOrTarget(source, target, step.script);
+            else
+                source = _GetScriptCreatureSourceOrTarget(source, target, step.script);
+
+            if (source)
+            {
+                Unit* sourceUnit = source->ToUnit();
+                if (!sourceUnit)
                 {
-                    TC_LOG_ERROR("scripts", "%s invalid chat type (%u) specified, skipping.", step.script->GetDebugInfo().c_str(), step.script->Talk.ChatType);
+                    TC_LOG_ERROR("scripts", "%s source object (%s) is not an unit, skipping.", step.script->GetDebugInfo().c_str(), source->GetGUID().ToString().c_str());
                     break;
                 }
 
-                if (step.script->Talk.Flags & SF_TALK_USE_PLAYER)
-                    source = _GetScriptPlayerSourceOrTarget(source, target, step.script);
-                else
-                    source = _GetScriptCreatureSourceOrTarget(source, target, step.script);
-
-                if (source)
+                switch (step.script->Talk.ChatType)
                 {
-                    Unit* sourceUnit = source->ToUnit();
-                    if (!sourceUnit)
-                    {
-                        TC_LOG_ERROR("scripts", "%s source object (%s) is not an unit, skipping.", step.script->GetDebugInfo().c_str(), source->GetGUID().ToString().c_str());
+                    case CHAT_TYPE_SAY:
+                        sourceUnit->Say(step.script->Talk.TextID, target);
                         break;
-                    }
-
-                    switch (step.script->Talk.ChatType)
+                    case CHAT_TYPE_YELL:
+                        sourceUnit->Yell(step.script->Talk.TextID, target);
+                        break;
+                    case CHAT_TYPE_TEXT_EMOTE:
+                    case CHAT_TYPE_BOSS_EMOTE:
+                        sourceUnit->TextEmote(step.script->Talk.TextID, target, step.script->Talk.ChatType == CHAT_TYPE_BOSS_EMOTE);
+                        break;
+                    case CHAT_TYPE_WHISPER:
+                    case CHAT_TYPE_BOSS_WHISPER:
                     {
-                        case CHAT_TYPE_SAY:
-                            sourceUnit->Say(step.script->Talk.TextID, target);
-                            break;
-                        case CHAT_TYPE_YELL:
-                            sourceUnit->Yell(step.script->Talk.TextID, target);
-                            break;
-                        case CHAT_TYPE_TEXT_EMOTE:
-                        case CHAT_TYPE_BOSS_EMOTE:
-                            sourceUnit->TextEmote(step.script->Talk.TextID, target, step.script->Talk.ChatType == CHAT_TYPE_BOSS_EMOTE);
-                            break;
-                        case CHAT_TYPE_WHISPER:
-                        case CHAT_TYPE_BOSS_WHISPER:
-                        {
-                            Player* receiver = target ? target->ToPlayer() : nullptr;
-                            if (!receiver)
-                                TC_LOG_ERROR("scripts", "%s attempt to whisper to non-player unit, skipping.", step.script->GetDebugInfo().c_str());
-                            else
-                                sourceUnit->Whisper(step.script->Talk.TextID, receiver, step.script->Talk.ChatType == CHAT_TYPE_BOSS_WHISPER);
-                            break;
-                        }
-                        default:
-                            break;                              // must be already checked at load
+                        Player* receiver = target ? target->ToPlayer() : nullptr;
+                        if (!receiver)
+                            TC_LOG_ERROR("scripts", "%s attempt to whisper to non-player unit, skipping.", step.script->GetDebugInfo().c_str());
+                        else
+                            sourceUnit->Whisper(step.script->Talk.TextID, receiver, step.script->Talk.ChatType == CHAT_TYPE_BOSS_WHISPER);
+                        break;
                     }
+                    default:
+                        break;                              // must be already checked at load
                 }
-                break;
             }
+            break;
+        }
 
-            case SCRIPT_COMMAND_EMOTE:
-                // Source or target must be Creature.
-                if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script))
+        case SCRIPT_COMMAND_EMOTE:
+            // Source or target must be Creature.
+            if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script))
+            {
+                if (step.script->Emote.Flags & SF_EMOTE_USE_STATE)
+                    cSource->SetEmoteState(Emote(step.script->Emote.EmoteID));
+                else
+                    cSource->HandleEmoteCommand(static_cast<Emote>(step.script->Emote.EmoteID));
+            }
+            break;
+
+        case SCRIPT_COMMAND_MOVE_TO:
+            // Source or target must be Creature.
+            if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script))
+            {
+                Unit* unit = (Unit*)cSource;
+                if (step.script->MoveTo.TravelTime != 0)
                 {
-                    if (step.script->Emote.Flags & SF_EMOTE_USE_STATE)
-                        cSource->SetEmoteState(Emote(step.script->Emote.EmoteID));
-                    else
-                        cSource->HandleEmoteCommand(static_cast<Emote>(step.script->Emote.EmoteID));
+                    float speed = unit->GetDistance(step.script->MoveTo.DestX, step.script->MoveTo.DestY, step.script->MoveTo.DestZ) / ((float)step.script->MoveTo.TravelTime * 0.001f);
+                    unit->MonsterMoveWithSpeed(step.script->MoveTo.DestX, step.script->MoveTo.DestY, step.script->MoveTo.DestZ, speed);
                 }
-                break;
+                else
+                    unit->NearTeleportTo(step.script->MoveTo.DestX, step.script->MoveTo.DestY, step.script->MoveTo.DestZ, unit->GetOrientation());
+            }
+            break;
 
-            case SCRIPT_COMMAND_MOVE_TO:
+        case SCRIPT_COMMAND_TELEPORT_TO:
+            if (step.script->TeleportTo.Flags & SF_TELEPORT_USE_CREATURE)
+            {
                 // Source or target must be Creature.
-                if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script))
-                {
-                    Unit* unit = (Unit*)cSource;
-                    if (step.script->MoveTo.TravelTime != 0)
-                    {
-                        float speed = unit->GetDistance(step.script->MoveTo.DestX, step.script->MoveTo.DestY, step.script->MoveTo.DestZ) / ((float)step.script->MoveTo.TravelTime * 0.001f);
-                        unit->MonsterMoveWithSpeed(step.script->MoveTo.DestX, step.script->MoveTo.DestY, step.script->MoveTo.DestZ, speed);
-                    }
-                    else
-                        unit->NearTeleportTo(step.script->MoveTo.DestX, step.script->MoveTo.DestY, step.script->MoveTo.DestZ, unit->GetOrientation());
-                }
-                break;
+                if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script, true))
+                    cSource->NearTeleportTo(step.script->TeleportTo.DestX, step.script->TeleportTo.DestY, step.script->TeleportTo.DestZ, step.script->TeleportTo.Orientation);
+            }
+            else
+            {
+                // Source or target must be Player.
+                if (Player* player = _GetScriptPlayerSourceOrTarget(source, target, step.script))
+                    player->TeleportTo(step.script->TeleportTo.MapID, step.script->TeleportTo.DestX, step.script->TeleportTo.DestY, step.script->TeleportTo.DestZ, step.script->TeleportTo.Orientation);
+            }
+            break;
 
-            case SCRIPT_COMMAND_TELEPORT_TO:
-                if (step.script->TeleportTo.Flags & SF_TELEPORT_USE_CREATURE)
-                {
-                    // Source or target must be Creature.
-                    if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script, true))
-                        cSource->NearTeleportTo(step.script->TeleportTo.DestX, step.script->TeleportTo.DestY, step.script->TeleportTo.DestZ, step.script->TeleportTo.Orientation);
-                }
-                else
-                {
-                    // Source or target must be Player.
-                    if (Player* player = _GetScriptPlayerSourceOrTarget(source, target, step.script))
-                        player->TeleportTo(step.script->TeleportTo.MapID, step.script->TeleportTo.DestX, step.script->TeleportTo.DestY, step.script->TeleportTo.DestZ, step.script->TeleportTo.Orientation);
-                }
+        case SCRIPT_COMMAND_QUEST_EXPLORED:
+        {
+            if (!source)
+            {
+                TC_LOG_ERROR("scripts", "%s source object is NULL.", step.script->GetDebugInfo().c_str());
                 break;
+            }
+            if (!target)
+            {
+                TC_LOG_ERROR("scripts", "%s target object is NULL.", step.script->GetDebugInfo().c_str());
+                break;
+            }
 
-            case SCRIPT_COMMAND_QUEST_EXPLORED:
+            // when script called for item spell casting then target == (unit or GO) and source is player
+            WorldObject* worldObject;
+            Player* player = target->ToPlayer();
+            if (player)
             {
-                if (!source)
+                if (source->GetTypeId() != TYPEID_UNIT && source->GetTypeId() != TYPEID_GAMEOBJECT && source->GetTypeId() != TYPEID_PLAYER)
                 {
-                    TC_LOG_ERROR("scripts", "%s source object is NULL.", step.script->GetDebugInfo().c_str());
+                    TC_LOG_ERROR("scripts", "%s source is not unit, gameobject or player %s, skipping.",
+                        step.script->GetDebugInfo().c_str(), source->GetGUID().ToString().c_str());
                     break;
                 }
-                if (!target)
-                {
-                    TC_LOG_ERROR("scripts", "%s target object is NULL.", step.script->GetDebugInfo().c_str());
-                    break;
-                }
-
-                // when script called for item spell casting then target == (unit or GO) and source is player
-                WorldObject* worldObject;
-                Player* player = target->ToPlayer();
+                worldObject = dynamic_cast<WorldObject*>(source);
+            }
+            else
+            {
+                player = source->ToPlayer();
                 if (player)
                 {
-                    if (source->GetTypeId() != TYPEID_UNIT && source->GetTypeId() != TYPEID_GAMEOBJECT && source->GetTypeId() != TYPEID_PLAYER)
+                    if (target->GetTypeId() != TYPEID_UNIT && target->GetTypeId() != TYPEID_GAMEOBJECT && target->GetTypeId() != TYPEID_PLAYER)
                     {
-                        TC_LOG_ERROR("scripts", "%s source is not unit, gameobject or player %s, skipping.",
-                            step.script->GetDebugInfo().c_str(), source->GetGUID().ToString().c_str());
+                        TC_LOG_ERROR("scripts", "%s target is not unit, gameobject or player %s, skipping.",
+                            step.script->GetDebugInfo().c_str(), target->GetGUID().ToString().c_str());
                         break;
                     }
-                    worldObject = dynamic_cast<WorldObject*>(source);
+                    worldObject = dynamic_cast<WorldObject*>(target);
                 }
                 else
                 {
-                    player = source->ToPlayer();
-                    if (player)
-                    {
-                        if (target->GetTypeId() != TYPEID_UNIT && target->GetTypeId() != TYPEID_GAMEOBJECT && target->GetTypeId() != TYPEID_PLAYER)
-                        {
-                            TC_LOG_ERROR("scripts", "%s target is not unit, gameobject or player %s, skipping.",
-                                step.script->GetDebugInfo().c_str(), target->GetGUID().ToString().c_str());
-                            break;
-                        }
-                        worldObject = dynamic_cast<WorldObject*>(target);
-                    }
-                    else
-                    {
-                        TC_LOG_ERROR("scripts", "%s neither source nor target is player (source: %s; target: %s), skipping.",
-                            step.script->GetDebugInfo().c_str(), source->GetGUID().ToString().c_str(),
-                            target->GetGUID().ToString().c_str());
-                        break;
-                    }
+                    TC_LOG_ERROR("scripts", "%s neither source nor target is player (source: %s; target: %s), skipping.",
+                        step.script->GetDebugInfo().c_str(), source->GetGUID().ToString().c_str(),
+                        target->GetGUID().ToString().c_str());
+                    break;
                 }
+            }
+
+            ASSERT(worldObject);
 
-                ASSERT(worldObject);
+            // quest id and flags checked at script loading
+            if ((worldObject->GetTypeId() != TYPEID_UNIT || ((Unit*)worldObject)->IsAlive()) &&
+                (step.script->QuestExplored.Distance == 0 || worldObject->IsWithinDistInMap(player, float(step.script->QuestExplored.Distance))))
+                player->AreaExploredOrEventHappens(step.script->QuestExplored.QuestID);
+            else
+                player->FailQuest(step.script->QuestExplored.QuestID);
 
-                // quest id and flags checked at script loading
-                if ((worldObject->GetTypeId() != TYPEID_UNIT || ((Unit*)worldObject)->IsAlive()) &&
-                    (step.script->QuestExplored.Distance == 0 || worldObject->IsWithinDistInMap(player, float(step.script->QuestExplored.Distance))))
-                    player->AreaExploredOrEventHappens(step.script->QuestExplored.QuestID);
+            break;
+        }
+
+        case SCRIPT_COMMAND_KILL_CREDIT:
+            // Source or target must be Player.
+            if (Player* player = _GetScriptPlayerSourceOrTarget(source, target, step.script))
+            {
+                if (step.script->KillCredit.Flags & SF_KILLCREDIT_REWARD_GROUP)
+                    player->RewardPlayerAndGroupAtEvent(step.script->KillCredit.CreatureEntry, player);
                 else
-                    player->FailQuest(step.script->QuestExplored.QuestID);
+                    player->KilledMonsterCredit(step.script->KillCredit.CreatureEntry);
+            }
+            break;
 
+        case SCRIPT_COMMAND_RESPAWN_GAMEOBJECT:
+            if (!step.script->RespawnGameobject.GOGuid)
+            {
+                TC_LOG_ERROR("scripts", "%s gameobject guid (datalong) is not specified.", step.script->GetDebugInfo().c_str());
                 break;
             }
 
-            case SCRIPT_COMMAND_KILL_CREDIT:
-                // Source or target must be Player.
-                if (Player* player = _GetScriptPlayerSourceOrTarget(source, target, step.script))
+            // Source or target must be WorldObject.
+            if (WorldObject* pSummoner = _GetScriptWorldObject(source, true, step.script))
+            {
+                GameObject* pGO = _FindGameObject(pSummoner, step.script->RespawnGameobject.GOGuid);
+                if (!pGO)
                 {
-                    if (step.script->KillCredit.Flags & SF_KILLCREDIT_REWARD_GROUP)
-                        player->RewardPlayerAndGroupAtEvent(step.script->KillCredit.CreatureEntry, player);
-                    else
-                        player->KilledMonsterCredit(step.script->KillCredit.CreatureEntry);
+                    TC_LOG_ERROR("scripts", "%s gameobject was not found (guid: %u).", step.script->GetDebugInfo().c_str(), step.script->RespawnGameobject.GOGuid);
+                    break;
                 }
-                break;
 
-            case SCRIPT_COMMAND_RESPAWN_GAMEOBJECT:
-                if (!step.script->RespawnGameobject.GOGuid)
+                if (pGO->GetGoType() == GAMEOBJECT_TYPE_FISHINGNODE ||
+                    pGO->GetGoType() == GAMEOBJECT_TYPE_DOOR        ||
+                    pGO->GetGoType() == GAMEOBJECT_TYPE_BUTTON      ||
+                    pGO->GetGoType() == GAMEOBJECT_TYPE_TRAP)
                 {
-                    TC_LOG_ERROR("scripts", "%s gameobject guid (datalong) is not specified.", step.script->GetDebugInfo().c_str());
+                    TC_LOG_ERROR("scripts", "%s can not be used with gameobject of type %u (guid: %u).",
+                        step.script->GetDebugInfo().c_str(), uint32(pGO->GetGoType()), step.script->RespawnGameobject.GOGuid);
                     break;
                 }
 
-                // Source or target must be WorldObject.
-                if (WorldObject* pSummoner = _GetScriptWorldObject(source, true, step.script))
+                // Check that GO is not spawned
+                if (!pGO->isSpawned())
                 {
-                    GameObject* pGO = _FindGameObject(pSummoner, step.script->RespawnGameobject.GOGuid);
-                    if (!pGO)
-                    {
-                        TC_LOG_ERROR("scripts", "%s gameobject was not found (guid: %u).", step.script->GetDebugInfo().c_str(), step.script->RespawnGameobject.GOGuid);
-                        break;
-                    }
-
-                    if (pGO->GetGoType() == GAMEOBJECT_TYPE_FISHINGNODE ||
-                        pGO->GetGoType() == GAMEOBJECT_TYPE_DOOR        ||
-                        pGO->GetGoType() == GAMEOBJECT_TYPE_BUTTON      ||
-                        pGO->GetGoType() == GAMEOBJECT_TYPE_TRAP)
-                    {
-                        TC_LOG_ERROR("scripts", "%s can not be used with gameobject of type %u (guid: %u).",
-                            step.script->GetDebugInfo().c_str(), uint32(pGO->GetGoType()), step.script->RespawnGameobject.GOGuid);
-                        break;
-                    }
-
-                    // Check that GO is not spawned
-                    if (!pGO->isSpawned())
-                    {
-                        int32 nTimeToDespawn = std::max(5, int32(step.script->RespawnGameobject.DespawnDelay));
-                        pGO->SetLootState(GO_READY);
-                        pGO->SetRespawnTime(nTimeToDespawn);
+                    int32 nTimeToDespawn = std::max(5, int32(step.script->RespawnGameobject.DespawnDelay));
+                    pGO->SetLootState(GO_READY);
+                    pGO->SetRespawnTime(nTimeToDespawn);
 
-                        pGO->GetMap()->AddToMap(pGO);
-                    }
+                    pGO->GetMap()->AddToMap(pGO);
                 }
-                break;
+            }
+            break;
 
-            case SCRIPT_COMMAND_TEMP_SUMMON_CREATURE:
+        case SCRIPT_COMMAND_TEMP_SUMMON_CREATURE:
+        {
+            // Source must be WorldObject.
+            if (WorldObject* pSummoner = _GetScriptWorldObject(source, true, step.script))
             {
-                // Source must be WorldObject.
-                if (WorldObject* pSummoner = _GetScriptWorldObject(source, true, step.script))
+                if (!step.script->TempSummonCreature.CreatureEntry)
+                    TC_LOG_ERROR("scripts", "%s creature entry (datalong) is not specified.", step.script->GetDebugInfo().c_str());
+                else
                 {
-                    if (!step.script->TempSummonCreature.CreatureEntry)
-                        TC_LOG_ERROR("scripts", "%s creature entry (datalong) is not specified.", step.script->GetDebugInfo().c_str());
-                    else
-                    {
-                        float x = step.script->TempSummonCreature.PosX;
-                        float y = step.script->TempSummonCreature.PosY;
-                        float z = step.script->TempSummonCreature.PosZ;
-                        float o = step.script->TempSummonCreature.Orientation;
+                    float x = step.script->TempSummonCreature.PosX;
+                    float y = step.script->TempSummonCreature.PosY;
+                    float z = step.script->TempSummonCreature.PosZ;
+                    float o = step.script->TempSummonCreature.Orientation;
 
-                        if (!pSummoner->SummonCreature(step.script->TempSummonCreature.CreatureEntry, x, y, z, o, TEMPSUMMON_TIMED_OR_DEAD_DESPAWN, Milliseconds(step.script->TempSummonCreature.DespawnDelay)))
-                            TC_LOG_ERROR("scripts", "%s creature was not spawned (entry: %u).", step.script->GetDebugInfo().c_str(), step.script->TempSummonCreature.CreatureEntry);
-                    }
+                    if (!pSummoner->SummonCreature(step.script->TempSummonCreature.CreatureEntry, x, y, z, o, TEMPSUMMON_TIMED_OR_DEAD_DESPAWN, Milliseconds(step.script->TempSummonCreature.DespawnDelay)))
+                        TC_LOG_ERROR("scripts", "%s creature was not spawned (entry: %u).", step.script->GetDebugInfo().c_str(), step.script->TempSummonCreature.CreatureEntry);
                 }
-                break;
             }
+            break;
+        }
 
-            case SCRIPT_COMMAND_OPEN_DOOR:
-            case SCRIPT_COMMAND_CLOSE_DOOR:
-                _ScriptProcessDoor(source, target, step.script);
-                break;
-
-            case SCRIPT_COMMAND_ACTIVATE_OBJECT:
-                // Source must be Unit.
-                if (Unit* unit = _GetScriptUnit(source, true, step.script))
-                {
-                    // Target must be GameObject.
-                    if (!target)
-                    {
-                        TC_LOG_ERROR("scripts", "%s target object is NULL.", step.script->GetDebugInfo().c_str());
-                        break;
-                    }
-
-                    if (target->GetTypeId() != TYPEID_GAMEOBJECT)
-                    {
-                        TC_LOG_ERROR("scripts", "%s target object is not gameobject %s, skipping.",
-                            step.script->GetDebugInfo().c_str(), target->GetGUID().ToString().c_str());
-                        break;
-                    }
-
-                    if (GameObject* pGO = target->ToGameObject())
-                        pGO->Use(unit);
-                }
-                break;
-
-            case SCRIPT_COMMAND_REMOVE_AURA:
-            {
-                // Source (datalong2 != 0) or target (datalong2 == 0) must be Unit.
-                bool bReverse = step.script->RemoveAura.Flags & SF_REMOVEAURA_REVERSE;
-                if (Unit* unit = _GetScriptUnit(bReverse ? source : target, bReverse, step.script))
-                    unit->RemoveAurasDueToSpell(step.script->RemoveAura.SpellID);
-                break;
-            }
+        case SCRIPT_COMMAND_OPEN_DOOR:
+        case SCRIPT_COMMAND_CLOSE_DOOR:
+            _ScriptProcessDoor(source, target, step.script);
+            break;
 
-            case SCRIPT_COMMAND_CAST_SPELL:
+        case SCRIPT_COMMAND_ACTIVATE_OBJECT:
+            // Source must be Unit.
+            if (Unit* unit = _GetScriptUnit(source, true, step.script))
             {
-                if (!source && !target)
-                {
-                    TC_LOG_ERROR("scripts", "%s source and target objects are NULL.", step.script->GetDebugInfo().c_str());
-                    break;
-                }
-
-                WorldObject* uSource = nullptr;
-                WorldObject* uTarget = nullptr;
-                // source/target cast spell at target/source (script->datalong2: 0: s->t 1: s->s 2: t->t 3: t->s)
-                switch (step.script->CastSpell.Flags)
-                {
-                    case SF_CASTSPELL_SOURCE_TO_TARGET: // source -> target
-                        uSource = dynamic_cast<WorldObject*>(source);
-                        uTarget = target;
-                        break;
-                    case SF_CASTSPELL_SOURCE_TO_SOURCE: // source -> source
-                        uSource = dynamic_cast<WorldObject*>(source);
-                        uTarget = uSource;
-                        break;
-                    case SF_CASTSPELL_TARGET_TO_TARGET: // target -> target
-                        uSource = target;
-                        uTarget = uSource;
-                        break;
-                    case SF_CASTSPELL_TARGET_TO_SOURCE: // target -> source
-                        uSource = target;
-                        uTarget = dynamic_cast<WorldObject*>(source);
-                        break;
-                    case SF_CASTSPELL_SEARCH_CREATURE: // source -> creature with entry
-                        uSource = dynamic_cast<WorldObject*>(source);
-                        uTarget = uSource ? uSource->FindNearestCreature(abs(step.script->CastSpell.CreatureEntry), step.script->CastSpell.SearchRadius) : nullptr;
-                        break;
-                }
-
-                if (!uSource)
+                // Target must be GameObject.
+                if (!target)
                 {
-                    TC_LOG_ERROR("scripts", "%s no source worldobject found for spell %u", step.script->GetDebugInfo().c_str(), step.script->CastSpell.SpellID);
+                    TC_LOG_ERROR("scripts", "%s target object is NULL.", step.script->GetDebugInfo().c_str());
                     break;
                 }
 
-                if (!uTarget)
+                if (target->GetTypeId() != TYPEID_GAMEOBJECT)
                 {
-                    TC_LOG_ERROR("scripts", "%s no target worldobject found for spell %u", step.script->GetDebugInfo().c_str(), step.script->CastSpell.SpellID);
+                    TC_LOG_ERROR("scripts", "%s target object is not gameobject %s, skipping.",
+                        step.script->GetDebugInfo().c_str(), target->GetGUID().ToString().c_str());
                     break;
                 }
 
-                bool triggered = (step.script->CastSpell.Flags != 4) ?
-                    step.script->CastSpell.CreatureEntry & SF_CASTSPELL_TRIGGERED :
-                    step.script->CastSpell.CreatureEntry < 0;
-                uSource->CastSpell(uTarget, step.script->CastSpell.SpellID, triggered);
-                break;
+                if (GameObject* pGO = target->ToGameObject())
+                    pGO->Use(unit);
             }
+            break;
 
-            case SCRIPT_COMMAND_PLAY_SOUND:
-                // Source must be WorldObject.
-                if (WorldObject* object = _GetScriptWorldObject(source, true, step.script))
-                {
-                    // PlaySound.Flags bitmask: 0/1=anyone/target
-                    Player* player = nullptr;
-                    if (step.script->PlaySound.Flags & SF_PLAYSOUND_TARGET_PLAYER)
-                    {
-                        // Target must be Player.
-                        player = _GetScriptPlayer(target, false, step.script);
-                        if (!target)
-                            break;
-                    }
+        case SCRIPT_COMMAND_REMOVE_AURA:
+        {
+            // Source (datalong2 != 0) or target (datalong2 == 0) must be Unit.
+            bool bReverse = step.script->RemoveAura.Flags & SF_REMOVEAURA_REVERSE;
+            if (Unit* unit = _GetScriptUnit(bReverse ? source : target, bReverse, step.script))
+                unit->RemoveAurasDueToSpell(step.script->RemoveAura.SpellID);
+            break;
+        }
 
-                    // PlaySound.Flags bitmask: 0/2=without/with distance dependent
-                    if (step.script->PlaySound.Flags & SF_PLAYSOUND_DISTANCE_SOUND)
-                        object->PlayDistanceSound(step.script->PlaySound.SoundID, player);
-                    else
-                        object->PlayDirectSound(step.script->PlaySound.SoundID, player);
-                }
+        case SCRIPT_COMMAND_CAST_SPELL:
+        {
+            if (!source && !target)
+            {
+                TC_LOG_ERROR("scripts", "%s source and target objects are NULL.", step.script->GetDebugInfo().c_str());
                 break;
+            }
 
-            case SCRIPT_COMMAND_CREATE_ITEM:
-                // Target or source must be Player.
-                if (Player* pReceiver = _GetScriptPlayerSourceOrTarget(source, target, step.script))
-                {
-                    ItemPosCountVec dest;
-                    InventoryResult msg = pReceiver->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, step.script->CreateItem.ItemEntry, step.script->CreateItem.Amount);
-                    if (msg == EQUIP_ERR_OK)
-                    {
-                        if (Item* item = pReceiver->StoreNewItem(dest, step.script->CreateItem.ItemEntry, true))
-                            pReceiver->SendNewItem(item, step.script->CreateItem.Amount, false, true);
-                    }
-                    else
-                        pReceiver->SendEquipError(msg, nullptr, nullptr, step.script->CreateItem.ItemEntry);
-                }
-                break;
+            WorldObject* uSource = nullptr;
+            WorldObject* uTarget = nullptr;
+            // source/target cast spell at target/source (script->datalong2: 0: s->t 1: s->s 2: t->t 3: t->s)
+            switch (step.script->CastSpell.Flags)
+            {
+                case SF_CASTSPELL_SOURCE_TO_TARGET: // source -> target
+                    uSource = dynamic_cast<WorldObject*>(source);
+                    uTarget = target;
+                    break;
+                case SF_CASTSPELL_SOURCE_TO_SOURCE: // source -> source
+                    uSource = dynamic_cast<WorldObject*>(source);
+                    uTarget = uSource;
+                    break;
+                case SF_CASTSPELL_TARGET_TO_TARGET: // target -> target
+                    uSource = target;
+                    uTarget = uSource;
+                    break;
+                case SF_CASTSPELL_TARGET_TO_SOURCE: // target -> source
+                    uSource = target;
+                    uTarget = dynamic_cast<WorldObject*>(source);
+                    break;
+                case SF_CASTSPELL_SEARCH_CREATURE: // source -> creature with entry
+                    uSource = dynamic_cast<WorldObject*>(source);
+                    uTarget = uSource ? uSource->FindNearestCreature(abs(step.script->CastSpell.CreatureEntry), step.script->CastSpell.SearchRadius) : nullptr;
+                    break;
+            }
 
-            case SCRIPT_COMMAND_DESPAWN_SELF:
-                // First try with target or source creature, then with target or source gameobject
-                if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script, true))
-                    cSource->DespawnOrUnsummon(Milliseconds(step.script->DespawnSelf.DespawnDelay));
-                else if (GameObject* goSource = _GetScriptGameObjectSourceOrTarget(source, target, step.script, true))
-                    goSource->DespawnOrUnsummon(Milliseconds(step.script->DespawnSelf.DespawnDelay));
+            if (!uSource)
+            {
+                TC_LOG_ERROR("scripts", "%s no source worldobject found for spell %u", step.script->GetDebugInfo().c_str(), step.script->CastSpell.SpellID);
                 break;
+            }
 
-            case SCRIPT_COMMAND_LOAD_PATH:
-                // Source must be Unit.
-                if (Unit* unit = _GetScriptUnit(source, true, step.script))
-                {
-                    if (!sWaypointMgr->GetPath(step.script->LoadPath.PathID))
-                        TC_LOG_ERROR("scripts", "%s source object has an invalid path (%u), skipping.", step.script->GetDebugInfo().c_str(), step.script->LoadPath.PathID);
-                    else
-                        unit->GetMotionMaster()->MovePath(step.script->LoadPath.PathID, step.script->LoadPath.IsRepeatable != 0);
-                }
+            if (!uTarget)
+            {
+                TC_LOG_ERROR("scripts", "%s no target worldobject found for spell %u", step.script->GetDebugInfo().c_str(), step.script->CastSpell.SpellID);
                 break;
+            }
 
-            case SCRIPT_COMMAND_CALLSCRIPT_TO_UNIT:
-            {
-                if (!step.script->CallScript.CreatureEntry)
-                {
-                    TC_LOG_ERROR("scripts", "%s creature entry is not specified, skipping.", step.script->GetDebugInfo().c_str());
-                    break;
-                }
-                if (!step.script->CallScript.ScriptID)
-                {
-                    TC_LOG_ERROR("scripts", "%s script id is not specified, skipping.", step.script->GetDebugInfo().c_str());
-                    break;
-                }
+            bool triggered = (step.script->CastSpell.Flags != 4) ?
+                step.script->CastSpell.CreatureEntry & SF_CASTSPELL_TRIGGERED :
+                step.script->CastSpell.CreatureEntry < 0;
+            uSource->CastSpell(uTarget, step.script->CastSpell.SpellID, triggered);
+            break;
+        }
 
-                Creature* cTarget = nullptr;
-                auto creatureBounds = _creatureBySpawnIdStore.equal_range(step.script->CallScript.CreatureEntry);
-                if (creatureBounds.first != creatureBounds.second)
+        case SCRIPT_COMMAND_PLAY_SOUND:
+            // Source must be WorldObject.
+            if (WorldObject* object = _GetScriptWorldObject(source, true, step.script))
+            {
+                // PlaySound.Flags bitmask: 0/1=anyone/target
+                Player* player = nullptr;
+                if (step.script->PlaySound.Flags & SF_PLAYSOUND_TARGET_PLAYER)
                 {
-                    // Prefer alive (last respawned) creature
-                    auto creatureItr = std::find_if(creatureBounds.first, creatureBounds.second, [](Map::CreatureBySpawnIdContainer::value_type const& pair)
-                    {
-                        return pair.second->IsAlive();
-                    });
-
-                    cTarget = creatureItr != creatureBounds.second ? creatureItr->second : creatureBounds.first->second;
+                    // Target must be Player.
+                    player = _GetScriptPlayer(target, false, step.script);
+                    if (!target)
+                        break;
                 }
 
-                if (!cTarget)
-                {
-                    TC_LOG_ERROR("scripts", "%s target was not found (entry: %u)", step.script->GetDebugInfo().c_str(), step.script->CallScript.CreatureEntry);
-                    break;
-                }
+                // PlaySound.Flags bitmask: 0/2=without/with distance dependent
+                if (step.script->PlaySound.Flags & SF_PLAYSOUND_DISTANCE_SOUND)
+                    object->PlayDistanceSound(step.script->PlaySound.SoundID, player);
+                else
+                    object->PlayDirectSound(step.script->PlaySound.SoundID, player);
+            }
+            break;
 
-                //Lets choose our ScriptMap map
-                ScriptMapMap* datamap = GetScriptsMapByType(ScriptsType(step.script->CallScript.ScriptType));
-                //if no scriptmap present...
-                if (!datamap)
+        case SCRIPT_COMMAND_CREATE_ITEM:
+            // Target or source must be Player.
+            if (Player* pReceiver = _GetScriptPlayerSourceOrTarget(source, target, step.script))
+            {
+                ItemPosCountVec dest;
+                InventoryResult msg = pReceiver->CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, step.script->CreateItem.ItemEntry, step.script->CreateItem.Amount);
+                if (msg == EQUIP_ERR_OK)
                 {
-                    TC_LOG_ERROR("scripts", "%s unknown scriptmap (%u) specified, skipping.", step.script->GetDebugInfo().c_str(), step.script->CallScript.ScriptType);
-                    break;
+                    if (Item* item = pReceiver->StoreNewItem(dest, step.script->CreateItem.ItemEntry, true))
+                        pReceiver->SendNewItem(item, step.script->CreateItem.Amount, false, true);
                 }
+                else
+                    pReceiver->SendEquipError(msg, nullptr, nullptr, step.script->CreateItem.ItemEntry);
+            }
+            break;
+
+        case SCRIPT_COMMAND_DESPAWN_SELF:
+            // First try with target or source creature, then with target or source gameobject
+            if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script, true))
+                cSource->DespawnOrUnsummon(Milliseconds(step.script->DespawnSelf.DespawnDelay));
+            else if (GameObject* goSource = _GetScriptGameObjectSourceOrTarget(source, target, step.script, true))
+                goSource->DespawnOrUnsummon(Milliseconds(step.script->DespawnSelf.DespawnDelay));
+            break;
+
+        case SCRIPT_COMMAND_LOAD_PATH:
+            // Source must be Unit.
+            if (Unit* unit = _GetScriptUnit(source, true, step.script))
+            {
+                if (!sWaypointMgr->GetPath(step.script->LoadPath.PathID))
+                    TC_LOG_ERROR("scripts", "%s source object has an invalid path (%u), skipping.", step.script->GetDebugInfo().c_str(), step.script->LoadPath.PathID);
+                else
+                    unit->GetMotionMaster()->MovePath(step.script->LoadPath.PathID, step.script->LoadPath.IsRepeatable != 0);
+            }
+            break;
 
-                // Insert script into schedule but do not start it
-                ScriptsStart(*datamap, step.script->CallScript.ScriptID, cTarget, nullptr);
+        case SCRIPT_COMMAND_CALLSCRIPT_TO_UNIT:
+        {
+            if (!step.script->CallScript.CreatureEntry)
+            {
+                TC_LOG_ERROR("scripts", "%s creature entry is not specified, skipping.", step.script->GetDebugInfo().c_str());
                 break;
             }
-
-            case SCRIPT_COMMAND_KILL:
-                // Source or target must be Creature.
-                if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script))
-                {
-                    if (cSource->isDead())
-                        TC_LOG_ERROR("scripts", "%s creature is already dead %s",
-                            step.script->GetDebugInfo().c_str(), cSource->GetGUID().ToString().c_str());
-                    else
-                    {
-                        cSource->setDeathState(JUST_DIED);
-                        if (step.script->Kill.RemoveCorpse == 1)
-                            cSource->RemoveCorpse();
-                    }
-                }
+            if (!step.script->CallScript.ScriptID)
+            {
+                TC_LOG_ERROR("scripts", "%s script id is not specified, skipping.", step.script->GetDebugInfo().c_str());
                 break;
+            }
 
-            case SCRIPT_COMMAND_ORIENTATION:
-                // Source must be Unit.
-                if (Unit* sourceUnit = _GetScriptUnit(source, true, step.script))
+            Creature* cTarget = nullptr;
+            auto creatureBounds = _creatureBySpawnIdStore.equal_range(step.script->CallScript.CreatureEntry);
+            if (creatureBounds.first != creatureBounds.second)
+            {
+                // Prefer alive (last respawned) creature
+                auto creatureItr = std::find_if(creatureBounds.first, creatureBounds.second, [](Map::CreatureBySpawnIdContainer::value_type const& pair)
                 {
-                    if (step.script->Orientation.Flags & SF_ORIENTATION_FACE_TARGET)
-                    {
-                        // Target must be Unit.
-                        Unit* targetUnit = _GetScriptUnit(target, false, step.script);
-                        if (!targetUnit)
-                            break;
+                    return pair.second->IsAlive();
+                });
 
-                        sourceUnit->SetFacingToObject(targetUnit);
-                    }
-                    else
-                        sourceUnit->SetFacingTo(step.script->Orientation.Orientation);
-                }
-                break;
-
-            case SCRIPT_COMMAND_EQUIP:
-                // Source must be Creature.
-                if (Creature* cSource = _GetScriptCreature(source, true, step.script))
-                    cSource->LoadEquipment(step.script->Equip.EquipmentID);
-                break;
+                cTarget = creatureItr != creatureBounds.second ? creatureItr->second : creatureBounds.first->second;
+            }
 
-            case SCRIPT_COMMAND_MODEL:
-                // Source must be Creature.
-                if (Creature* cSource = _GetScriptCreature(source, true, step.script))
-                    cSource->SetDisplayId(step.script->Model.ModelID);
+            if (!cTarget)
+            {
+                TC_LOG_ERROR("scripts", "%s target was not found (entry: %u)", step.script->GetDebugInfo().c_str(), step.script->CallScript.CreatureEntry);
                 break;
+            }
 
-            case SCRIPT_COMMAND_CLOSE_GOSSIP:
-                // Source must be Player.
-                if (Player* player = _GetScriptPlayer(source, true, step.script))
-                    player->PlayerTalkClass->SendCloseGossip();
+            //Lets choose our ScriptMap map
+            ScriptMapMap* datamap = GetScriptsMapByType(ScriptsType(step.script->CallScript.ScriptType));
+            //if no scriptmap present...
+            if (!datamap)
+            {
+                TC_LOG_ERROR("scripts", "%s unknown scriptmap (%u) specified, skipping.", step.script->GetDebugInfo().c_str(), step.script->CallScript.ScriptType);
                 break;
+            }
 
-            case SCRIPT_COMMAND_PLAYMOVIE:
-                // Source must be Player.
-                if (Player* player = _GetScriptPlayer(source, true, step.script))
-                    player->SendMovieStart(step.script->PlayMovie.MovieID);
-                break;
+            // Insert script into schedule but do not start it
+            ScriptsStart(*datamap, step.script->CallScript.ScriptID, cTarget, nullptr);
+            break;
+        }
 
-            case SCRIPT_COMMAND_MOVEMENT:
-                // Source must be Creature.
-                if (Creature* cSource = _GetScriptCreature(source, true, step.script))
+        case SCRIPT_COMMAND_KILL:
+            // Source or target must be Creature.
+            if (Creature* cSource = _GetScriptCreatureSourceOrTarget(source, target, step.script))
+            {
+                if (cSource->isDead())
+                    TC_LOG_ERROR("scripts", "%s creature is already dead %s",
+                        step.script->GetDebugInfo().c_str(), cSource->GetGUID().ToString().c_str());
+                else
                 {
-                    if (!cSource->IsAlive())
-                        return;
+                    cSource->setDeathState(JUST_DIED);
+                    if (step.script->Kill.RemoveCorpse == 1)
+                        cSource->RemoveCorpse();
+                }
+            }
+            break;
 
-                    cSource->GetMotionMaster()->MoveIdle();
+        case SCRIPT_COMMAND_ORIENTATION:
+            // Source must be Unit.
+            if (Unit* sourceUnit = _GetScriptUnit(source, true, step.script))
+            {
+                if (step.script->Orientation.Flags & SF_ORIENTATION_FACE_TARGET)
+                {
+                    // Target must be Unit.
+                    Unit* targetUnit = _GetScriptUnit(target, false, step.script);
+                    if (!targetUnit)
+                        break;
 
-                    switch (step.script->Movement.MovementType)
-                    {
-                        case RANDOM_MOTION_TYPE:
-                            cSource->GetMotionMaster()->MoveRandom((float)step.script->Movement.MovementDistance);
-                            break;
-                        case WAYPOINT_MOTION_TYPE:
-                            cSource->GetMotionMaster()->MovePath(step.script->Movement.Path, false);
-                            break;
-                    }
+                    sourceUnit->SetFacingToObject(targetUnit);
                 }
-                break;
+                else
+                    sourceUnit->SetFacingTo(step.script->Orientation.Orientation);
+            }
+            break;
+
+        case SCRIPT_COMMAND_EQUIP:
+            // Source must be Creature.
+            if (Creature* cSource = _GetScriptCreature(source, true, step.script))
+                cSource->LoadEquipment(step.script->Equip.EquipmentID);
+            break;
+
+        case SCRIPT_COMMAND_MODEL:
+            // Source must be Creature.
+            if (Creature* cSource = _GetScriptCreature(source, true, step.script))
+                cSource->SetDisplayId(step.script->Model.ModelID);
+            break;
+
+        case SCRIPT_COMMAND_CLOSE_GOSSIP:
+            // Source must be Player.
+            if (Player* player = _GetScriptPlayer(source, true, step.script))
+                player->PlayerTalkClass->SendCloseGossip();
+            break;
+
+        case SCRIPT_COMMAND_PLAYMOVIE:
+            // Source must be Player.
+            if (Player* player = _GetScriptPlayer(source, true, step.script))
+                player->SendMovieStart(step.script->PlayMovie.MovieID);
+            break;
+
+        case SCRIPT_COMMAND_MOVEMENT:
+            // Source must be Creature.
+            if (Creature* cSource = _GetScriptCreature(source, true, step.script))
+            {
+                if (!cSource->IsAlive())
+                    return;
 
-            case SCRIPT_COMMAND_PLAY_ANIMKIT:
-                // Source must be Creature.
-                if (Creature* cSource = _GetScriptCreature(source, true, step.script))
-                    cSource->PlayOneShotAnimKitId(step.script->PlayAnimKit.AnimKitID);
-                break;
+                cSource->GetMotionMaster()->MoveIdle();
 
-            default:
-                TC_LOG_ERROR("scripts", "Unknown script command %s.", step.script->GetDebugInfo().c_str());
-                break;
-        }
+                switch (step.script->Movement.MovementType)
+                {
+                    case RANDOM_MOTION_TYPE:
+                        cSource->GetMotionMaster()->MoveRandom((float)step.script->Movement.MovementDistance);
+                        break;
+                    case WAYPOINT_MOTION_TYPE:
+                        cSource->GetMotionMaster()->MovePath(step.script->Movement.Path, false);
+                        break;
+                }
+            }
+            break;
 
-        m_scriptSchedule.erase(iter);
-        iter = m_scriptSchedule.begin();
-        sMapMgr->DecreaseScheduledScriptCount();
+        case SCRIPT_COMMAND_PLAY_ANIMKIT:
+            // Source must be Creature.
+            if (Creature* cSource = _GetScriptCreature(source, true, step.script))
+                cSource->PlayOneShotAnimKitId(step.script->PlayAnimKit.AnimKitID);
+            break;
+
+        default:
+            TC_LOG_ERROR("scripts", "Unknown script command %s.", step.script->GetDebugInfo().c_str());
+            break;
     }
 }
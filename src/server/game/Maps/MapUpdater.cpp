@@ -19,10 +19,13 @@
 #include "DatabaseEnv.h"
 #include "Map.h"
 #include "Metric.h"
+#include "ProcessPriority.h"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <mutex>
 
-
 class MapUpdateRequest
 {
     private:
@@ -30,27 +33,51 @@ class MapUpdateRequest
         Map& m_map;
         MapUpdater& m_updater;
         uint32 m_diff;
+        uint64 m_cost;
 
     public:
 
         MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+            : m_map(m), m_updater(u), m_diff(d), m_cost(uint64(m.GetUpdateCostEstimate()) + 1)
         {
         }
 
-        void call()
+        uint64 GetCost() const { return m_cost; }
+        Map& GetMap() const { return m_map; }
+
+        void call(size_t workerIndex)
         {
-            TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
-            m_map.Update (m_diff);
+            m_map.SetLastUpdateWorker(workerIndex);
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            {
+                TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+                m_map.Update (m_diff);
+            }
+            m_map.RecordUpdateCost(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
             m_updater.update_finished();
         }
 };
 
+namespace
+{
+    struct MapUpdateRequestCostCompare
+    {
+        bool operator()(MapUpdateRequest const* left, MapUpdateRequest const* right) const
+        {
+            return left->GetCost() < right->GetCost();
+        }
+    };
+}
+
 void MapUpdater::activate(size_t num_threads)
 {
+    for (size_t i = 0; i < num_threads; ++i)
+        _queues.push_back(std::make_unique<WorkerQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -60,12 +87,23 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_workLock);
+        _workCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
     {
         thread.join();
     }
+
+    for (std::unique_ptr<WorkerQueue>& queue : _queues)
+    {
+        for (MapUpdateRequest* request : queue->Requests)
+            delete request;
+
+        queue->Requests.clear();
+    }
 }
 
 void MapUpdater::wait()
@@ -80,11 +118,58 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        ++pending_requests;
+    }
+
+    MapUpdateRequest* request = new MapUpdateRequest(map, *this, diff);
 
-    ++pending_requests;
+    // assign to the worker with the least outstanding work, rotating the starting point so ties spread evenly
+    // the worker that updated the map last time is kept while it is within one request of that (its grids are still in that processor's cache)
+    size_t queueCount = _queues.size();
+    size_t lastWorker = map.GetLastUpdateWorker();
+    size_t first = _nextQueue++ % queueCount;
+    WorkerQueue* target = nullptr;
+    while (true)
+    {
+        uint64 lowestCost = std::numeric_limits<uint64>::max();
+        for (size_t i = 0; i < queueCount; ++i)
+        {
+            WorkerQueue* queue = _queues[(first + i) % queueCount].get();
+            std::lock_guard<std::mutex> lock(queue->Lock);
+            if (queue->PendingCost < lowestCost)
+            {
+                lowestCost = queue->PendingCost;
+                target = queue;
+            }
+        }
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff));
+        if (lastWorker < queueCount && _queues[lastWorker].get() != target)
+        {
+            WorkerQueue* previous = _queues[lastWorker].get();
+            std::lock_guard<std::mutex> lock(previous->Lock);
+            if (previous->PendingCost <= lowestCost + request->GetCost())
+            {
+                target = previous;
+                lowestCost = previous->PendingCost;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(target->Lock);
+        // load changed while we were looking at other queues, pick again
+        if (target->PendingCost != lowestCost)
+            continue;
+
+        target->Requests.push_back(request);
+        std::push_heap(target->Requests.begin(), target->Requests.end(), MapUpdateRequestCostCompare());
+        target->PendingCost += request->GetCost();
+        ++_queuedRequests;
+        break;
+    }
+
+    std::lock_guard<std::mutex> lock(_workLock);
+    _workCondition.notify_one();
 }
 
 bool MapUpdater::activated()
@@ -101,8 +186,59 @@ void MapUpdater::update_finished()
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+MapUpdateRequest* MapUpdater::pop_request(size_t workerIndex)
+{
+    auto takeMostExpensive = [this](WorkerQueue* queue) -> MapUpdateRequest*
+    {
+        if (queue->Requests.empty())
+            return nullptr;
+
+        std::pop_heap(queue->Requests.begin(), queue->Requests.end(), MapUpdateRequestCostCompare());
+        MapUpdateRequest* request = queue->Requests.back();
+        queue->Requests.pop_back();
+        queue->PendingCost -= request->GetCost();
+        --_queuedRequests;
+        return request;
+    };
+
+    {
+        WorkerQueue* own = _queues[workerIndex].get();
+        std::lock_guard<std::mutex> lock(own->Lock);
+        if (MapUpdateRequest* request = takeMostExpensive(own))
+            return request;
+    }
+
+    // own queue is drained, steal the most expensive map from the busiest worker
+    while (_queuedRequests > 0)
+    {
+        WorkerQueue* victim = nullptr;
+        uint64 highestCost = 0;
+        for (size_t i = 1; i < _queues.size(); ++i)
+        {
+            WorkerQueue* queue = _queues[(workerIndex + i) % _queues.size()].get();
+            std::lock_guard<std::mutex> lock(queue->Lock);
+            if (queue->PendingCost > highestCost)
+            {
+                highestCost = queue->PendingCost;
+                victim = queue;
+            }
+        }
+
+        if (!victim)
+            break;
+
+        std::lock_guard<std::mutex> lock(victim->Lock);
+        if (MapUpdateRequest* request = takeMostExpensive(victim))
+            return request;
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::WorkerThread(size_t workerIndex)
 {
+    SetCurrentThreadAffinity("ThreadAffinity.MapUpdate");
+
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
@@ -110,14 +246,20 @@ void MapUpdater::WorkerThread()
 
     while (1)
     {
-        MapUpdateRequest* request = nullptr;
+        MapUpdateRequest* request = pop_request(workerIndex);
+        if (!request)
+        {
+            std::unique_lock<std::mutex> lock(_workLock);
+            while (_queuedRequests == 0 && !_cancelationToken)
+                _workCondition.wait(lock);
 
-        _queue.WaitAndPop(request);
+            if (_cancelationToken && _queuedRequests == 0)
+                return;
 
-        if (_cancelationToken)
-            return;
+            continue;
+        }
 
-        request->call();
+        request->call(workerIndex);
 
         delete request;
     }
@@ -19,10 +19,12 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <condition_variable>
-#include "ProducerConsumerQueue.h"
+#include <vector>
 
 class MapUpdateRequest;
 class Map;
@@ -31,7 +33,7 @@ class TC_GAME_API MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _queuedRequests(0), _nextQueue(0), pending_requests(0) {}
         ~MapUpdater() { };
 
         friend class MapUpdateRequest;
@@ -48,18 +50,36 @@ class TC_GAME_API MapUpdater
 
     private:
 
-        ProducerConsumerQueue<MapUpdateRequest*> _queue;
+        // every worker owns a queue ordered by expected update cost (most expensive first)
+        // idle workers steal from the queue with the most outstanding work
+        struct WorkerQueue
+        {
+            WorkerQueue() : PendingCost(0) { }
+
+            std::mutex Lock;
+            std::vector<MapUpdateRequest*> Requests;
+            uint64 PendingCost;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
+        std::mutex _workLock;
+        std::condition_variable _workCondition;
+        std::atomic<size_t> _queuedRequests;
+        std::atomic<size_t> _nextQueue;
+
         std::mutex _lock;
         std::condition_variable _condition;
         size_t pending_requests;
 
         void update_finished();
 
-        void WorkerThread();
+        MapUpdateRequest* pop_request(size_t workerIndex);
+
+        void WorkerThread(size_t workerIndex);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
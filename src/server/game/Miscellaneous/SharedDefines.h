@@ -2416,6 +2416,8 @@ enum AuraStateType
     AURA_STATE_WOUND_HEALTH_35_80           = 24            //   T |
 };
 
+#define MAX_AURA_STATE 25
+
 #define PER_CASTER_AURA_STATE_MASK (\
     (1<<(AURA_STATE_RAID_ENCOUNTER_2-1))|(1<<(AURA_STATE_ROGUE_POISONED-1)))
 
@@ -863,20 +863,26 @@ void MotionMaster::MoveCirclePath(float x, float y, float z, float radius, bool
     // add the owner's current position as starting point as it gets removed after entering the cycle
     init.Path().push_back(G3D::Vector3(_owner->GetPositionX(), _owner->GetPositionY(), _owner->GetPositionZ()));
 
-    for (uint8 i = 0; i < stepCount; angle += step, ++i)
-    {
-        G3D::Vector3 point;
-        point.x = x + radius * cosf(angle);
-        point.y = y + radius * sinf(angle);
+    // same search height as WorldObject::GetMapHeight
+    float searchZ = z;
+    if (!_owner->IsFlying() && z != MAX_HEIGHT)
+        searchZ += _owner->GetCollisionHeight();
 
-        if (_owner->IsFlying())
-            point.z = z;
-        else
-            point.z = _owner->GetMapHeight(point.x, point.y, z) + _owner->GetHoverOffset();
+    std::vector<Position> points;
+    points.reserve(stepCount);
+    for (uint8 i = 0; i < stepCount; angle += step, ++i)
+        points.emplace_back(x + radius * cosf(angle), y + radius * sinf(angle), searchZ);
 
-        init.Path().push_back(point);
+    if (!_owner->IsFlying())
+    {
+        _owner->GetMap()->GetHeights(_owner->GetPhaseShift(), points);
+        for (Position& point : points)
+            point.m_positionZ += _owner->GetHoverOffset();
     }
 
+    for (Position const& point : points)
+        init.Path().emplace_back(point.GetPositionX(), point.GetPositionY(), point.GetPositionZ());
+
     if (_owner->IsFlying())
     {
         init.SetFly();
@@ -1054,10 +1060,10 @@ void MotionMaster::MovePath(uint32 pathId, bool repeatable)
     Add(new WaypointMovementGenerator<Creature>(pathId, repeatable), MOTION_SLOT_DEFAULT);
 }
 
-void MotionMaster::MovePath(WaypointPath& path, bool repeatable)
+void MotionMaster::MovePath(WaypointPath const& path, bool repeatable, bool followWalkState/* = false*/)
 {
     TC_LOG_DEBUG("movement.motionmaster", "MotionMaster::MovePath: '%s', starts moving over path Id: %u (repeatable: %s)", _owner->GetGUID().ToString().c_str(), path.id, repeatable ? "YES" : "NO");
-    Add(new WaypointMovementGenerator<Creature>(path, repeatable), MOTION_SLOT_DEFAULT);
+    Add(new WaypointMovementGenerator<Creature>(path, repeatable, followWalkState), MOTION_SLOT_DEFAULT);
 }
 
 void MotionMaster::MoveRotate(uint32 id, uint32 time, RotateDirection direction)
@@ -24,6 +24,7 @@
 #include "MovementDefines.h"
 #include "MovementGenerator.h"
 #include "SharedDefines.h"
+#include "TransientObjectPool.h"
 #include <deque>
 #include <functional>
 #include <set>
@@ -114,6 +115,8 @@ class TC_GAME_API MotionMaster
         explicit MotionMaster(Unit* unit);
         ~MotionMaster();
 
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
         void Initialize();
         void InitializeDefault();
         void AddToWorld();
@@ -190,7 +193,7 @@ class TC_GAME_API MotionMaster
         void MoveTaxiFlight(uint32 path, uint32 pathnode);
         void MoveDistract(uint32 time, float orientation);
         void MovePath(uint32 pathId, bool repeatable);
-        void MovePath(WaypointPath& path, bool repeatable);
+        void MovePath(WaypointPath const& path, bool repeatable, bool followWalkState = false);
         void MoveRotate(uint32 id, uint32 time, RotateDirection direction);
         void MoveFormation(Unit* leader, float range, float angle, uint32 point1, uint32 point2);
 
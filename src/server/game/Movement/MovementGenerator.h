@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "FactoryHolder.h"
 #include "ObjectRegistry.h"
+#include "TransientObjectPool.h"
 
 class Creature;
 class Unit;
@@ -49,6 +50,8 @@ class TC_GAME_API MovementGenerator
         MovementGenerator() : Mode(0), Priority(0), Flags(MOVEMENTGENERATOR_FLAG_NONE), BaseUnitState(0) { }
         virtual ~MovementGenerator();
 
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
         // on top first update
         virtual void Initialize(Unit*) = 0;
         // on top reassign
@@ -193,6 +193,13 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
             if (owner->IsHovering())
                 owner->UpdateAllowedPositionZ(x, y, z);
 
+            // the corridor search runs on the path workers, evaluate the target again once it is done
+            if (moveToward && _path->PrepareAsyncPath(x, y, z))
+            {
+                _lastTargetPosition.reset();
+                return true;
+            }
+
             bool success = _path->CalculatePath(x, y, z, owner->CanFly());
             if (!success || (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
             {
@@ -164,8 +164,12 @@ void FormationMovementGenerator::LaunchMovement(Creature* owner, Unit* target)
         // Calculate travel distance to get a 1650ms result
         float travelDist = velocity * 1.65f;
 
-        // Move destination ahead...
-        target->MovePositionToFirstCollision(dest, travelDist, relativeAngle);
+        // Move destination ahead, shared by all members when following the leader of our formation...
+        CreatureGroup* formation = target->GetTypeId() == TYPEID_UNIT ? target->ToCreature()->GetFormation() : nullptr;
+        if (formation && formation->IsLeader(target->ToCreature()))
+            dest = formation->GetPredictedLeaderPosition(travelDist, relativeAngle);
+        else
+            target->MovePositionToFirstCollision(dest, travelDist, relativeAngle);
         // ... and apply formation shape
         target->MovePositionToFirstCollision(dest, _range, _angle + relativeAngle);
 
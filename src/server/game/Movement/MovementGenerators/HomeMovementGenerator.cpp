@@ -23,10 +23,11 @@
 #include "MovementDefines.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
+#include "PathGenerator.h"
 #include "Vehicle.h"
 
 template<class T>
-HomeMovementGenerator<T>::HomeMovementGenerator()
+HomeMovementGenerator<T>::HomeMovementGenerator() : _pathPending(false)
 {
     this->Mode = MOTION_MODE_DEFAULT;
     this->Priority = MOTION_PRIORITY_NORMAL;
@@ -74,7 +75,20 @@ void HomeMovementGenerator<Creature>::SetTargetLocation(Creature* owner)
      */
 
     owner->UpdateAllowedPositionZ(destination.m_positionX, destination.m_positionY, destination.m_positionZ);
-    init.MoveTo(PositionToVector3(destination));
+
+    if (!_path)
+        _path = std::make_unique<PathGenerator>(owner);
+
+    // the corridor search runs on the path workers, DoUpdate launches the spline once it is done
+    _pathPending = _path->PrepareAsyncPath(destination.m_positionX, destination.m_positionY, destination.m_positionZ);
+    if (_pathPending)
+        return;
+
+    bool result = _path->CalculatePath(destination.m_positionX, destination.m_positionY, destination.m_positionZ);
+    if (result && !(_path->GetPathType() & PATHFIND_NOPATH))
+        init.MovebyPath(_path->GetPath());
+    else
+        init.MoveTo(PositionToVector3(destination), false);
     init.SetFacing(destination.GetOrientation());
     init.SetWalk(false);
     init.Launch();
@@ -114,6 +128,12 @@ bool HomeMovementGenerator<T>::DoUpdate(T*, uint32)
 template<>
 bool HomeMovementGenerator<Creature>::DoUpdate(Creature* owner, uint32 /*diff*/)
 {
+    if (_pathPending && !HasFlag(MOVEMENTGENERATOR_FLAG_INTERRUPTED))
+    {
+        SetTargetLocation(owner);
+        return true;
+    }
+
     if (HasFlag(MOVEMENTGENERATOR_FLAG_INTERRUPTED) || owner->movespline->Finalized())
     {
         AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
@@ -19,6 +19,9 @@
 #define TRINITY_HOMEMOVEMENTGENERATOR_H
 
 #include "MovementGenerator.h"
+#include <memory>
+
+class PathGenerator;
 
 template <class T>
 class HomeMovementGenerator : public MovementGeneratorMedium< T, HomeMovementGenerator<T> >
@@ -36,6 +39,9 @@ class HomeMovementGenerator : public MovementGeneratorMedium< T, HomeMovementGen
 
     private:
         void SetTargetLocation(T*);
+
+        std::unique_ptr<PathGenerator> _path;
+        bool _pathPending;
 };
 
 #endif
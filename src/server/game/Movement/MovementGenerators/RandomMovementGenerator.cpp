@@ -91,6 +91,7 @@ void RandomMovementGenerator<Creature>::DoInitialize(Creature* owner)
 
     _timer.Reset(0);
     _path = nullptr;
+    _pendingDestination.reset();
 }
 
 template<class T>
@@ -122,16 +123,24 @@ void RandomMovementGenerator<Creature>::SetRandomLocation(Creature* owner)
     }
 
     Position position(_reference);
-    float distance = frand(0.f, _wanderDistance);
-    float angle = frand(0.f, float(M_PI * 2));
-    owner->MovePositionToFirstCollision(position, distance, angle);
-
-    // Check if the destination is in LOS
-    if (!owner->IsWithinLOS(position.GetPositionX(), position.GetPositionY(), position.GetPositionZ()))
+    if (_pendingDestination)
     {
-        // Retry later on
-        _timer.Reset(200);
-        return;
+        position = *_pendingDestination;
+        _pendingDestination.reset();
+    }
+    else
+    {
+        float distance = frand(0.f, _wanderDistance);
+        float angle = frand(0.f, float(M_PI * 2));
+        owner->MovePositionToFirstCollision(position, distance, angle);
+
+        // Check if the destination is in LOS
+        if (!owner->IsWithinLOS(position.GetPositionX(), position.GetPositionY(), position.GetPositionZ()))
+        {
+            // Retry later on
+            _timer.Reset(200);
+            return;
+        }
     }
 
     if (!_path)
@@ -140,6 +149,14 @@ void RandomMovementGenerator<Creature>::SetRandomLocation(Creature* owner)
         _path->SetPathLengthLimit(30.0f);
     }
 
+    // the corridor search runs on the path workers, keep the destination until it is done
+    if (_path->PrepareAsyncPath(position.GetPositionX(), position.GetPositionY(), position.GetPositionZ()))
+    {
+        _pendingDestination = position;
+        _timer.Reset(50);
+        return;
+    }
+
     bool result = _path->CalculatePath(position.GetPositionX(), position.GetPositionY(), position.GetPositionZ());
     // PATHFIND_FARFROMPOLY shouldn't be checked as creatures in water are most likely far from poly
     if (!result || (_path->GetPathType() & PATHFIND_NOPATH)
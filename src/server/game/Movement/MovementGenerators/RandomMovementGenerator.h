@@ -19,6 +19,7 @@
 #define TRINITY_RANDOMMOTIONGENERATOR_H
 
 #include "MovementGenerator.h"
+#include "Optional.h"
 #include "Position.h"
 #include "Timer.h"
 
@@ -49,6 +50,7 @@ class RandomMovementGenerator : public MovementGeneratorMedium<T, RandomMovement
         std::unique_ptr<PathGenerator> _path;
         TimeTracker _timer;
         Position _reference;
+        Optional<Position> _pendingDestination;
         float _wanderDistance;
         uint8 _wanderSteps;
 };
@@ -29,7 +29,7 @@
 #include "WaypointManager.h"
 #include <sstream>
 
-WaypointMovementGenerator<Creature>::WaypointMovementGenerator(uint32 pathId, bool repeating) : _nextMoveTime(0), _pathId(pathId), _repeating(repeating), _loadedFromDB(true)
+WaypointMovementGenerator<Creature>::WaypointMovementGenerator(uint32 pathId, bool repeating) : _nextMoveTime(0), _pathId(pathId), _repeating(repeating), _loadedFromDB(true), _followWalkState(false)
 {
     Mode = MOTION_MODE_DEFAULT;
     Priority = MOTION_PRIORITY_NORMAL;
@@ -37,7 +37,7 @@ WaypointMovementGenerator<Creature>::WaypointMovementGenerator(uint32 pathId, bo
     BaseUnitState = UNIT_STATE_ROAMING;
 }
 
-WaypointMovementGenerator<Creature>::WaypointMovementGenerator(WaypointPath& path, bool repeating) : _nextMoveTime(0), _pathId(0), _repeating(repeating), _loadedFromDB(false)
+WaypointMovementGenerator<Creature>::WaypointMovementGenerator(WaypointPath const& path, bool repeating, bool followWalkState) : _nextMoveTime(0), _pathId(0), _repeating(repeating), _loadedFromDB(false), _followWalkState(followWalkState)
 {
     _path = &path;
 
@@ -358,10 +358,10 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature* owner, bool relaun
             init.SetAnimation(AnimTier::Hover);
             break;
         case WAYPOINT_MOVE_TYPE_RUN:
-            init.SetWalk(false);
+            init.SetWalk(_followWalkState && owner->IsWalking());
             break;
         case WAYPOINT_MOVE_TYPE_WALK:
-            init.SetWalk(true);
+            init.SetWalk(!_followWalkState || owner->IsWalking());
             break;
         default:
             break;
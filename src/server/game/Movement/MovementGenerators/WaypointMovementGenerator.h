@@ -34,7 +34,8 @@ class WaypointMovementGenerator<Creature> : public MovementGeneratorMedium<Creat
 {
     public:
         explicit WaypointMovementGenerator(uint32 pathId = 0, bool repeating = true);
-        explicit WaypointMovementGenerator(WaypointPath& path, bool repeating = true);
+        // followWalkState: walk or run as the owner currently does instead of using the move type of the nodes
+        explicit WaypointMovementGenerator(WaypointPath const& path, bool repeating = true, bool followWalkState = false);
         ~WaypointMovementGenerator() { _path = nullptr; }
 
         MovementGeneratorType GetMovementGeneratorType() const override;
@@ -72,6 +73,7 @@ class WaypointMovementGenerator<Creature> : public MovementGeneratorMedium<Creat
         uint32 _pathId;
         bool _repeating;
         bool _loadedFromDB;
+        bool _followWalkState;
 };
 
 #endif
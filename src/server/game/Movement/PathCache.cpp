@@ -0,0 +1,90 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PathCache.h"
+#include "Hash.h"
+#include <algorithm>
+
+std::size_t PathCacheKeyHash::operator()(PathCacheKey const& key) const
+{
+    std::size_t hashVal = 0;
+    Trinity::hash_combine(hashVal, key.TerrainMapId);
+    Trinity::hash_combine(hashVal, key.StartPoly);
+    Trinity::hash_combine(hashVal, key.EndPoly);
+    Trinity::hash_combine(hashVal, key.IncludeFlags);
+    Trinity::hash_combine(hashVal, key.ExcludeFlags);
+    return hashVal;
+}
+
+bool PathCache::Find(PathCacheKey const& key, uint32 tileGeneration, dtPolyRef* path, uint32* pathLength, uint32 maxPathLength)
+{
+    auto itr = _index.find(key);
+    if (itr == _index.end())
+    {
+        ++_misses;
+        return false;
+    }
+
+    EntryList::iterator entry = itr->second;
+    if (entry->TileGeneration != tileGeneration || entry->Path.size() > maxPathLength)
+    {
+        // tiles were loaded or unloaded since, poly refs may point to removed tiles
+        _index.erase(itr);
+        _entries.erase(entry);
+        ++_misses;
+        return false;
+    }
+
+    _entries.splice(_entries.begin(), _entries, entry);
+    std::copy(entry->Path.begin(), entry->Path.end(), path);
+    *pathLength = uint32(entry->Path.size());
+    ++_hits;
+    return true;
+}
+
+void PathCache::Store(PathCacheKey const& key, uint32 tileGeneration, dtPolyRef const* path, uint32 pathLength)
+{
+    if (!_capacity || !pathLength)
+        return;
+
+    auto itr = _index.find(key);
+    if (itr != _index.end())
+    {
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        itr->second->TileGeneration = tileGeneration;
+        itr->second->Path.assign(path, path + pathLength);
+        return;
+    }
+
+    if (_entries.size() >= _capacity)
+    {
+        _index.erase(_entries.back().Key);
+        _entries.pop_back();
+    }
+
+    _entries.push_front({ key, tileGeneration, std::vector<dtPolyRef>(path, path + pathLength) });
+    _index.emplace(key, _entries.begin());
+}
+
+void PathCache::TakeStats(uint32& hits, uint32& misses)
+{
+    hits = _hits;
+    misses = _misses;
+    _hits = 0;
+    _misses = 0;
+}
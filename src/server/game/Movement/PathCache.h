@@ -0,0 +1,81 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _PATH_CACHE_H
+#define _PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+struct PathCacheKey
+{
+    uint32 TerrainMapId;
+    dtPolyRef StartPoly;
+    dtPolyRef EndPoly;
+    uint16 IncludeFlags;
+    uint16 ExcludeFlags;
+
+    bool operator==(PathCacheKey const& right) const
+    {
+        return TerrainMapId == right.TerrainMapId && StartPoly == right.StartPoly && EndPoly == right.EndPoly
+            && IncludeFlags == right.IncludeFlags && ExcludeFlags == right.ExcludeFlags;
+    }
+};
+
+struct PathCacheKeyHash
+{
+    std::size_t operator()(PathCacheKey const& key) const;
+};
+
+// Bounded LRU cache of poly corridors found by dtNavMeshQuery::findPath, owned by a single map
+// Entries remember the mmap tile generation they were built with and are dropped once tiles change
+class TC_GAME_API PathCache
+{
+    public:
+        explicit PathCache(std::size_t capacity) : _capacity(capacity), _hits(0), _misses(0) { }
+
+        // copies the cached corridor into path, at most maxPathLength polys
+        bool Find(PathCacheKey const& key, uint32 tileGeneration, dtPolyRef* path, uint32* pathLength, uint32 maxPathLength);
+        void Store(PathCacheKey const& key, uint32 tileGeneration, dtPolyRef const* path, uint32 pathLength);
+
+        std::size_t GetSize() const { return _entries.size(); }
+
+        // hit and miss counts since the previous call
+        void TakeStats(uint32& hits, uint32& misses);
+
+    private:
+        struct Entry
+        {
+            PathCacheKey Key;
+            uint32 TileGeneration;
+            std::vector<dtPolyRef> Path;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        std::size_t _capacity;
+        EntryList _entries;     // most recently used first
+        std::unordered_map<PathCacheKey, EntryList::iterator, PathCacheKeyHash> _index;
+        uint32 _hits;
+        uint32 _misses;
+};
+
+#endif
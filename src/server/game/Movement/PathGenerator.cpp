@@ -25,25 +25,27 @@
 #include "MMapManager.h"
 #include "Map.h"
 #include "Metric.h"
+#include "PathCache.h"
+#include "PathWorkerPool.h"
 #include "PhasingHandler.h"
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
-    _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
+    _endPosition(G3D::Vector3::zero()), _source(owner), _terrainMapId(0), _navMesh(nullptr),
     _navMeshQuery(nullptr)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::PathGenerator for %s", _source->GetGUID().ToString().c_str());
 
-    uint32 mapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMap(), _source->GetPositionX(), _source->GetPositionY());
+    _terrainMapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMap(), _source->GetPositionX(), _source->GetPositionY());
     if (DisableMgr::IsPathfindingEnabled(_source->GetMapId()))
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
+        _navMesh = mmap->GetNavMesh(_terrainMapId);
+        _navMeshQuery = mmap->GetNavMeshQuery(_terrainMapId);
     }
 
     CreateFilter();
@@ -74,6 +76,10 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::CalculatePath() for %s", _source->GetGUID().ToString().c_str());
 
+    // queries are owned by the updating thread, which may differ between map updates
+    if (_navMesh)
+        _navMeshQuery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(_terrainMapId);
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
@@ -91,6 +97,65 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     return true;
 }
 
+bool PathGenerator::PrepareAsyncPath(float destX, float destY, float destZ)
+{
+    if (_asyncRequest)
+    {
+        if (!_asyncRequest->Ready)
+            return true;
+
+        std::shared_ptr<AsyncPathRequest> request = std::move(_asyncRequest);
+
+        // poly refs are only valid for the tiles they were found on
+        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+        if (!request->PolyRefs.empty() && request->TileGeneration == mmap->GetTileGeneration(_terrainMapId))
+        {
+            _polyLength = std::min<uint32>(uint32(request->PolyRefs.size()), MAX_PATH_LENGTH);
+            memcpy(_pathPolyRefs, request->PolyRefs.data(), _polyLength * sizeof(dtPolyRef));
+        }
+
+        return false;
+    }
+
+    if (!sPathWorkerPool->IsEnabled() || _useRaycast || !_navMesh)
+        return false;
+
+    _navMeshQuery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(_terrainMapId);
+    if (!_navMeshQuery)
+        return false;
+
+    Unit const* sourceUnit = _source->ToUnit();
+    if (sourceUnit && sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING))
+        return false;
+
+    float x, y, z;
+    _source->GetPosition(x, y, z);
+
+    if (!Trinity::IsValidMapCoord(destX, destY, destZ) || !Trinity::IsValidMapCoord(x, y, z))
+        return false;
+
+    if (!HaveTile(G3D::Vector3(x, y, z)) || !HaveTile(G3D::Vector3(destX, destY, destZ)))
+        return false;
+
+    // still on the current corridor, BuildPolyPath only has to adjust it
+    float startPoint[VERTEX_SIZE] = { y, z, x };
+    if (GetPathPolyByPosition(_pathPolyRefs, _polyLength, startPoint) != INVALID_POLYREF)
+        return false;
+
+    UpdateFilter();
+
+    std::shared_ptr<AsyncPathRequest> request = std::make_shared<AsyncPathRequest>();
+    request->TerrainMapId = _terrainMapId;
+    dtVcopy(request->StartPoint, startPoint);
+    dtVset(request->EndPoint, destY, destZ, destX);
+    request->IncludeFlags = _filter.getIncludeFlags();
+    request->ExcludeFlags = _filter.getExcludeFlags();
+
+    _asyncRequest = request;
+    sPathWorkerPool->Submit(std::move(request));
+    return true;
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -495,17 +560,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
             }
         }
         else
-        {
-            dtResult = _navMeshQuery->findPath(
-                            startPoly,          // start polygon
-                            endPoly,            // end polygon
-                            startPoint,         // start position
-                            endPoint,           // end position
-                            &_filter,           // polygon search filter
-                            _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
-                            MAX_PATH_LENGTH);   // max number of polygons in output path
-        }
+            dtResult = FindPolyPath(startPoly, endPoly, startPoint, endPoint);
 
         if (!_polyLength || dtStatusFailed(dtResult))
         {
@@ -529,6 +584,36 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathGenerator::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint)
+{
+    // creatures following the same routes ask for the same corridors over and over, reuse them until mmap tiles change
+    PathCache* cache = _source->GetMap()->GetPathCache();
+    PathCacheKey key = { _terrainMapId, startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags() };
+    uint32 tileGeneration = 0;
+    if (cache)
+    {
+        tileGeneration = MMAP::MMapFactory::createOrGetMMapManager()->GetTileGeneration(_terrainMapId);
+        if (cache->Find(key, tileGeneration, _pathPolyRefs, &_polyLength, MAX_PATH_LENGTH))
+            return DT_SUCCESS;
+    }
+
+    dtStatus dtResult = _navMeshQuery->findPath(
+                    startPoly,          // start polygon
+                    endPoly,            // end polygon
+                    startPoint,         // start position
+                    endPoint,           // end position
+                    &_filter,           // polygon search filter
+                    _pathPolyRefs,      // [out] path
+                    (int*)&_polyLength,
+                    MAX_PATH_LENGTH);   // max number of polygons in output path
+
+    // partial corridors depend on how far the search got, only keep complete ones
+    if (cache && dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT))
+        cache->Store(key, tileGeneration, _pathPolyRefs, _polyLength);
+
+    return dtResult;
+}
+
 void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PathWorkerPool.h"
+#include "DetourNavMeshQuery.h"
+#include "Log.h"
+#include "MMapFactory.h"
+#include "MMapManager.h"
+#include "PathGenerator.h"
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace
+{
+    struct WorkerNavMeshQuery
+    {
+        WorkerNavMeshQuery() : NavMesh(nullptr), Query(nullptr) { }
+        ~WorkerNavMeshQuery()
+        {
+            if (Query)
+                dtFreeNavMeshQuery(Query);
+        }
+
+        WorkerNavMeshQuery(WorkerNavMeshQuery const&) = delete;
+        WorkerNavMeshQuery& operator=(WorkerNavMeshQuery const&) = delete;
+
+        dtNavMesh const* NavMesh;
+        dtNavMeshQuery* Query;
+    };
+
+    dtPolyRef FindNearestPoly(dtNavMeshQuery const* query, dtQueryFilter const* filter, float const* point)
+    {
+        // same search boxes as PathGenerator::GetPolyByLocation
+        float extents[VERTEX_SIZE] = { 3.0f, 5.0f, 3.0f };
+        float closestPoint[VERTEX_SIZE] = { 0.0f, 0.0f, 0.0f };
+        dtPolyRef polyRef = INVALID_POLYREF;
+        if (dtStatusSucceed(query->findNearestPoly(point, extents, filter, &polyRef, closestPoint)) && polyRef != INVALID_POLYREF)
+            return polyRef;
+
+        extents[1] = 50.0f;
+        if (dtStatusSucceed(query->findNearestPoly(point, extents, filter, &polyRef, closestPoint)))
+            return polyRef;
+
+        return INVALID_POLYREF;
+    }
+
+    void FindCorridor(AsyncPathRequest& request, std::unordered_map<uint32, WorkerNavMeshQuery>& queries)
+    {
+        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+        std::shared_lock<std::shared_mutex> lock(mmap->GetNavMeshLock());
+
+        dtNavMesh const* navMesh = mmap->GetNavMesh(request.TerrainMapId);
+        if (!navMesh)
+            return;
+
+        WorkerNavMeshQuery& workerQuery = queries[request.TerrainMapId];
+        if (workerQuery.NavMesh != navMesh)
+        {
+            if (!workerQuery.Query)
+                workerQuery.Query = dtAllocNavMeshQuery();
+
+            if (dtStatusFailed(workerQuery.Query->init(navMesh, 1024)))
+            {
+                TC_LOG_ERROR("maps.mmaps", "PathWorkerPool: Failed to initialize dtNavMeshQuery for mapId %04u", request.TerrainMapId);
+                workerQuery.NavMesh = nullptr;
+                return;
+            }
+
+            workerQuery.NavMesh = navMesh;
+        }
+
+        dtQueryFilter filter;
+        filter.setIncludeFlags(request.IncludeFlags);
+        filter.setExcludeFlags(request.ExcludeFlags);
+
+        dtPolyRef startPoly = FindNearestPoly(workerQuery.Query, &filter, request.StartPoint);
+        dtPolyRef endPoly = FindNearestPoly(workerQuery.Query, &filter, request.EndPoint);
+        if (startPoly == INVALID_POLYREF || endPoly == INVALID_POLYREF)
+            return;
+
+        request.PolyRefs.resize(MAX_PATH_LENGTH);
+        int polyLength = 0;
+        dtStatus result = workerQuery.Query->findPath(startPoly, endPoly, request.StartPoint, request.EndPoint, &filter,
+            request.PolyRefs.data(), &polyLength, MAX_PATH_LENGTH);
+
+        if (dtStatusFailed(result))
+            polyLength = 0;
+
+        request.PolyRefs.resize(polyLength);
+        request.TileGeneration = mmap->GetTileGeneration(request.TerrainMapId);
+    }
+}
+
+PathWorkerPool::~PathWorkerPool()
+{
+    Stop();
+}
+
+PathWorkerPool* PathWorkerPool::instance()
+{
+    static PathWorkerPool instance;
+    return &instance;
+}
+
+void PathWorkerPool::Start(uint32 threadCount)
+{
+    for (uint32 i = 0; i < threadCount; ++i)
+        _workers.emplace_back(&PathWorkerPool::WorkerThread, this);
+
+    if (threadCount)
+        TC_LOG_INFO("server.loading", "Started %u asynchronous pathfinding worker threads", threadCount);
+}
+
+void PathWorkerPool::Stop()
+{
+    if (_workers.empty())
+        return;
+
+    _queue.Cancel();
+
+    for (std::thread& worker : _workers)
+        worker.join();
+
+    _workers.clear();
+}
+
+void PathWorkerPool::Submit(std::shared_ptr<AsyncPathRequest> request)
+{
+    _queue.Push(std::move(request));
+}
+
+void PathWorkerPool::WorkerThread()
+{
+    std::unordered_map<uint32, WorkerNavMeshQuery> queries;
+
+    for (;;)
+    {
+        std::shared_ptr<AsyncPathRequest> request;
+
+        _queue.WaitAndPop(request);
+
+        if (!request)
+            return;
+
+        FindCorridor(*request, queries);
+        request->Ready = true;
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _PATH_WORKER_POOL_H
+#define _PATH_WORKER_POOL_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// poly corridor search handed to the path workers, everything is in detour (y, z, x) space
+struct AsyncPathRequest
+{
+    uint32 TerrainMapId = 0;
+    float StartPoint[3] = { };
+    float EndPoint[3] = { };
+    uint16 IncludeFlags = 0;
+    uint16 ExcludeFlags = 0;
+
+    // written by the worker before Ready is set, empty if no corridor was found
+    std::vector<dtPolyRef> PolyRefs;
+    uint32 TileGeneration = 0;
+    std::atomic<bool> Ready{ false };
+};
+
+// Runs dtNavMeshQuery::findPath for movement generators outside of map updates
+// Every worker owns its dtNavMeshQuery objects, navmeshes are read under MMapManager::GetNavMeshLock
+class TC_GAME_API PathWorkerPool
+{
+    public:
+        static PathWorkerPool* instance();
+
+        void Start(uint32 threadCount);
+        void Stop();
+
+        bool IsEnabled() const { return !_workers.empty(); }
+
+        void Submit(std::shared_ptr<AsyncPathRequest> request);
+
+    private:
+        PathWorkerPool() = default;
+        ~PathWorkerPool();
+
+        void WorkerThread();
+
+        ProducerConsumerQueue<std::shared_ptr<AsyncPathRequest>> _queue;
+        std::vector<std::thread> _workers;
+};
+
+#define sPathWorkerPool PathWorkerPool::instance()
+
+#endif
@@ -120,7 +120,8 @@ void SplineBase::EvaluateLinear(index_type index, float u, Vector3& result) cons
 void SplineBase::EvaluateCatmullRom( index_type index, float t, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
-    C_Evaluate(&points[index - 1], t, s_catmullRomCoeffs, result);
+    Vector3 const* c = &coefficients[(index - index_lo) * 4];
+    result = ((c[0] * t + c[1]) * t + c[2]) * t + c[3];
 }
 
 void SplineBase::EvaluateBezier3(index_type index, float t, Vector3& result) const
@@ -139,7 +140,8 @@ void SplineBase::EvaluateDerivativeLinear(index_type index, float, Vector3& resu
 void SplineBase::EvaluateDerivativeCatmullRom(index_type index, float t, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
-    C_Evaluate_Derivative(&points[index - 1], t, s_catmullRomCoeffs, result);
+    Vector3 const* c = &coefficients[(index - index_lo) * 4];
+    result = (c[0] * (3.f * t) + c[1] * 2.f) * t + c[2];
 }
 
 void SplineBase::EvaluateDerivativeBezier3(index_type index, float t, Vector3& result) const
@@ -160,14 +162,13 @@ float SplineBase::SegLengthCatmullRom(index_type index) const
     ASSERT(index >= index_lo && index < index_hi);
 
     Vector3 curPos, nextPos;
-    const Vector3 * p = &points[index - 1];
-    curPos = nextPos = p[1];
+    curPos = nextPos = points[index];
 
     index_type i = 1;
     float length = 0;
     while (i <= STEPS_PER_SEGMENT)
     {
-        C_Evaluate(p, float(i) / float(STEPS_PER_SEGMENT), s_catmullRomCoeffs, nextPos);
+        EvaluateCatmullRom(index, float(i) / float(STEPS_PER_SEGMENT), nextPos);
         length += (nextPos - curPos).length();
         curPos = nextPos;
         ++i;
@@ -205,6 +206,7 @@ void SplineBase::init_spline(const Vector3 * controls, index_type count, Evaluat
     initialOrientation = orientation;
 
     (this->*initializers[m_mode])(controls, count, 0);
+    InitCoefficients();
 }
 
 void SplineBase::init_cyclic_spline(const Vector3 * controls, index_type count, EvaluationMode m, index_type cyclic_point, float orientation)
@@ -214,6 +216,7 @@ void SplineBase::init_cyclic_spline(const Vector3 * controls, index_type count,
     initialOrientation = orientation;
 
     (this->*initializers[m_mode])(controls, count, cyclic_point);
+    InitCoefficients();
 }
 
 void SplineBase::InitLinear(Vector3 const* controls, index_type count, index_type cyclic_point)
@@ -282,11 +285,30 @@ void SplineBase::InitBezier3(Vector3 const* controls, index_type count, index_ty
     //mov_assert(points.size() % 3 == 0);
 }
 
+void SplineBase::InitCoefficients()
+{
+    coefficients.clear();
+    if (m_mode != ModeCatmullrom)
+        return;
+
+    // expands C_Evaluate for each segment: weights = (u^3, u^2, u, 1) * matrix, so the coefficient of u^(3-row) is sum(matrix[row][col] * point[col])
+    coefficients.resize((index_hi - index_lo) * 4);
+    for (index_type index = index_lo; index < index_hi; ++index)
+    {
+        Vector3 const* p = &points[index - 1];
+        Vector3* c = &coefficients[(index - index_lo) * 4];
+        for (int row = 0; row < 4; ++row)
+            c[row] = p[0] * s_catmullRomCoeffs[row][0] + p[1] * s_catmullRomCoeffs[row][1]
+                   + p[2] * s_catmullRomCoeffs[row][2] + p[3] * s_catmullRomCoeffs[row][3];
+    }
+}
+
 void SplineBase::clear()
 {
     index_lo = 0;
     index_hi = 0;
     points.clear();
+    coefficients.clear();
 }
 
 std::string SplineBase::ToString() const
@@ -21,6 +21,7 @@
 #include "MovementTypedefs.h"
 #include "Errors.h"
 #include <G3D/Vector3.h>
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -43,6 +44,7 @@ public:
 
 protected:
     ControlArray points;
+    ControlArray coefficients;  // a, b, c, d of a*u^3 + b*u^2 + c*u + d for each Catmull-Rom segment, computed once at init
 
     index_type index_lo;
     index_type index_hi;
@@ -84,6 +86,8 @@ protected:
     typedef void (SplineBase::*InitMethtod)(Vector3 const*, index_type, index_type);
     static InitMethtod initializers[ModesEnd];
 
+    void InitCoefficients();
+
     void UninitializedSplineEvaluationMethod(index_type, float, Vector3&) const { ABORT(); }
     float UninitializedSplineSegLenghtMethod(index_type) const { ABORT(); return 0.0f; }
     void UninitializedSplineInitMethod(Vector3 const*, index_type, index_type) { ABORT(); }
@@ -125,6 +129,7 @@ public:
     template<class Init> inline void init_spline_custom(Init& initializer)
     {
         initializer(m_mode, cyclic, points, index_lo, index_hi);
+        InitCoefficients();
     }
 
     void clear();
@@ -19,6 +19,7 @@
 #include "DatabaseEnv.h"
 #include "GridDefines.h"
 #include "MapManager.h"
+#include "ResultSnapshotStore.h"
 #include "Log.h"
 
 void WaypointMgr::Load()
@@ -26,7 +27,7 @@ void WaypointMgr::Load()
     uint32 oldMSTime = getMSTime();
 
     //                                                0    1         2           3          4            5           6        7      8           9
-    QueryResult result = WorldDatabase.Query("SELECT id, point, position_x, position_y, position_z, orientation, move_type, delay, action, action_chance FROM waypoint_data ORDER BY id, point");
+    QueryResult result = sResultSnapshotStore->Query(WorldDatabase, "SELECT id, point, position_x, position_y, position_z, orientation, move_type, delay, action, action_chance FROM waypoint_data ORDER BY id, point");
 
     if (!result)
     {
@@ -35,6 +36,7 @@ void WaypointMgr::Load()
     }
 
     uint32 count = 0;
+    WaypointPath* path = nullptr; // rows are ordered by path id
 
     do
     {
@@ -66,9 +68,13 @@ void WaypointMgr::Load()
         waypoint.eventId = fields[8].GetUInt32();
         waypoint.eventChance = fields[9].GetInt16();
 
-        WaypointPath& path = _waypointStore[pathId];
-        path.id = pathId;
-        path.nodes.push_back(std::move(waypoint));
+        if (!path || path->id != pathId)
+        {
+            path = &_waypointStore[pathId];
+            path->id = pathId;
+        }
+
+        path->nodes.push_back(std::move(waypoint));
         ++count;
     }
     while (result->NextRow());
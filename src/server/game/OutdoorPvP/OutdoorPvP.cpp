@@ -30,6 +30,7 @@
 #include "OutdoorPvPMgr.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include "WorldStatePackets.h"
 
 class DefenseMessageBuilder
 {
@@ -274,18 +275,18 @@ bool OPvPCapturePoint::Update(uint32 diff)
         }
     }
 
-    std::list<Player*> players;
+    std::vector<Player*> players;
+    players.reserve(m_activePlayers[0].size() + m_activePlayers[1].size());
     Trinity::AnyPlayerInObjectRangeCheck checker(m_capturePoint, radius);
     Trinity::PlayerListSearcher<Trinity::AnyPlayerInObjectRangeCheck> searcher(m_capturePoint, players, checker);
     Cell::VisitWorldObjects(m_capturePoint, searcher, radius);
 
-    for (std::list<Player*>::iterator itr = players.begin(); itr != players.end(); ++itr)
+    for (Player* const player : players)
     {
-        Player* const player = *itr;
         if (player->IsOutdoorPvPActive())
         {
             if (m_activePlayers[player->GetTeamId()].insert(player->GetGUID()).second)
-                HandlePlayerEnter(*itr);
+                HandlePlayerEnter(player);
         }
     }
 
@@ -387,12 +388,18 @@ void OutdoorPvP::SendUpdateWorldState(uint32 field, uint32 value)
 
 void OPvPCapturePoint::SendUpdateWorldState(uint32 field, uint32 value)
 {
+    // serialized once for everyone in the area
+    WorldPackets::WorldState::UpdateWorldState worldstate;
+    worldstate.VariableID = field;
+    worldstate.Value = value;
+    WorldPacket const* packet = worldstate.Write();
+
     for (uint32 team = 0; team < 2; ++team)
     {
         // send to all players present in the area
         for (GuidSet::iterator itr = m_activePlayers[team].begin(); itr != m_activePlayers[team].end(); ++itr)
             if (Player* const player = ObjectAccessor::FindPlayer(*itr))
-                player->SendUpdateWorldState(field, value);
+                player->SendDirectMessage(packet);
     }
 }
 
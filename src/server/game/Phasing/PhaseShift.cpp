@@ -25,6 +25,9 @@ bool PhaseShift::AddPhase(uint32 phaseId, PhaseFlags flags, std::vector<Conditio
     if (areaConditions)
         insertResult.first->AreaConditions = areaConditions;
 
+    if (insertResult.second)
+        UpdatePhaseMask();
+
     return insertResult.second;
 }
 
@@ -35,7 +38,11 @@ PhaseShift::EraseResult<PhaseShift::PhaseContainer> PhaseShift::RemovePhase(uint
     {
         ModifyPhasesReferences(itr, -1);
         if (!itr->References)
-            return { Phases.erase(itr), true };
+        {
+            itr = Phases.erase(itr);
+            UpdatePhaseMask();
+            return { itr, true };
+        }
         return { itr, false };
     }
     return { Phases.end(), false };
@@ -91,6 +98,7 @@ void PhaseShift::ClearPhases()
     Flags &= PhaseShiftFlags::AlwaysVisible | PhaseShiftFlags::Inverse;
     PersonalGuid.Clear();
     Phases.clear();
+    PhaseMask = 0;
     NonCosmeticReferences = 0;
     CosmeticReferences = 0;
     PersonalReferences = 0;
@@ -113,6 +121,9 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
 
     if (!Flags.HasFlag(PhaseShiftFlags::Inverse) && !other.Flags.HasFlag(PhaseShiftFlags::Inverse))
     {
+        if (!(PhaseMask & other.PhaseMask))
+            return false;
+
         ObjectGuid ownerGuid = PersonalGuid;
         ObjectGuid otherPersonalGuid = other.PersonalGuid;
         return Trinity::Containers::Intersects(Phases.begin(), Phases.end(), other.Phases.begin(), other.Phases.end(),
@@ -171,6 +182,13 @@ void PhaseShift::ModifyPhasesReferences(PhaseContainer::iterator itr, int32 refe
     }
 }
 
+void PhaseShift::UpdatePhaseMask()
+{
+    PhaseMask = 0;
+    for (PhaseRef const& phaseRef : Phases)
+        PhaseMask |= UI64LIT(1) << (phaseRef.Id % 64);
+}
+
 void PhaseShift::UpdateUnphasedFlag()
 {
     EnumFlag<PhaseShiftFlags> unphasedFlag = !Flags.HasFlag(PhaseShiftFlags::Inverse) ? PhaseShiftFlags::Unphased : PhaseShiftFlags::InverseUnphased;
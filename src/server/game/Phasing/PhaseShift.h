@@ -120,12 +120,14 @@ protected:
     UiMapPhaseIdContainer UiMapPhaseIds;
 
     void ModifyPhasesReferences(PhaseContainer::iterator itr, int32 references);
+    void UpdatePhaseMask();
     void UpdateUnphasedFlag();
     void UpdatePersonalGuid();
     int32 NonCosmeticReferences = 0;
     int32 CosmeticReferences = 0;
     int32 PersonalReferences = 0;
     int32 DefaultReferences = 0;
+    uint64 PhaseMask = 0;   // bit (id % 64) set for every phase in Phases, lets CanSee reject phase shifts without common phase ids cheaply
     bool IsDbPhaseShift = false;
 };
 
@@ -379,6 +379,7 @@ void PhasingHandler::OnConditionChange(WorldObject* object)
         else
             ++itr;
     }
+    phaseShift.UpdatePhaseMask();
 
     for (auto itr = suppressedPhaseShift.Phases.begin(); itr != suppressedPhaseShift.Phases.end();)
     {
@@ -391,6 +392,7 @@ void PhasingHandler::OnConditionChange(WorldObject* object)
         else
             ++itr;
     }
+    suppressedPhaseShift.UpdatePhaseMask();
 
     for (auto itr = phaseShift.VisibleMapIds.begin(); itr != phaseShift.VisibleMapIds.end();)
     {
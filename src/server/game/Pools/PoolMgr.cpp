@@ -119,6 +119,14 @@ void PoolGroup<T>::AddEntry(PoolObject& poolitem, uint32 maxentries)
         ExplicitlyChanced.push_back(poolitem);
     else
         EqualChanced.push_back(poolitem);
+
+    MemberGuids.insert(std::upper_bound(MemberGuids.begin(), MemberGuids.end(), poolitem.guid), poolitem.guid);
+}
+
+template <class T>
+bool PoolGroup<T>::IsMember(uint64 guid) const
+{
+    return std::binary_search(MemberGuids.begin(), MemberGuids.end(), guid);
 }
 
 // Method to check the chances are proper in this object pool
@@ -142,6 +150,17 @@ bool PoolGroup<T>::CheckPool() const
 template<class T>
 void PoolGroup<T>::DespawnObject(ActivePoolData& spawns, uint64 guid, bool alwaysDeleteRespawnTime)
 {
+    // single object despawn (respawn of another pool member), no need to walk the whole pool
+    if (guid && !alwaysDeleteRespawnTime)
+    {
+        if (IsMember(guid) && spawns.IsActiveObject<T>(guid))
+        {
+            Despawn1Object(guid);
+            spawns.RemoveObject<T>(guid, poolId);
+        }
+        return;
+    }
+
     for (size_t i=0; i < EqualChanced.size(); ++i)
     {
         // if spawned
@@ -257,6 +276,10 @@ void PoolGroup<Pool>::RemoveOneRelation(uint32 child_pool_id)
             break;
         }
     }
+
+    auto member = std::lower_bound(MemberGuids.begin(), MemberGuids.end(), uint64(child_pool_id));
+    if (member != MemberGuids.end() && *member == child_pool_id)
+        MemberGuids.erase(member);
 }
 
 template <class T>
@@ -293,7 +316,7 @@ void PoolGroup<T>::SpawnObject(ActivePoolData& spawns, uint32 limit, uint64 trig
             }
         }
 
-        if (!EqualChanced.empty() && rolledObjects.empty())
+        if (!EqualChanced.empty() && rolledObjects.empty() && !RollEqualChanced(spawns, count, rolledObjects))
         {
             std::copy_if(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(rolledObjects), [/*triggerFrom, */&spawns](PoolObject const& object)
             {
@@ -324,6 +347,36 @@ void PoolGroup<T>::SpawnObject(ActivePoolData& spawns, uint32 limit, uint64 trig
         DespawnObject(spawns, triggerFrom);
 }
 
+// Picks count distinct not spawned equal chanced objects by drawing random members
+// Large pools (mining nodes, herbs) have few spawned members compared to their size so few draws are rejected,
+// returns false without touching rolledObjects when too many draws failed, the caller then filters the whole list
+template <class T>
+bool PoolGroup<T>::RollEqualChanced(ActivePoolData const& spawns, uint32 count, PoolObjectList& rolledObjects) const
+{
+    uint32 size = uint32(EqualChanced.size());
+    if (count * 4 > size)
+        return false;
+
+    std::vector<uint32> picked;
+    picked.reserve(count);
+    for (uint32 attempts = count * 8 + 8; attempts && picked.size() < count; --attempts)
+    {
+        uint32 index = urand(0, size - 1);
+        if (spawns.IsActiveObject<T>(EqualChanced[index].guid) || std::find(picked.begin(), picked.end(), index) != picked.end())
+            continue;
+
+        picked.push_back(index);
+    }
+
+    if (picked.size() < count)
+        return false;
+
+    for (uint32 index : picked)
+        rolledObjects.push_back(EqualChanced[index]);
+
+    return true;
+}
+
 // Method that is actualy doing the spawn job on 1 creature
 template <>
 void PoolGroup<Creature>::Spawn1Object(PoolObject* obj)
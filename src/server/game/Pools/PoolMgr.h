@@ -23,6 +23,7 @@
 #include <map>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class Creature;
@@ -45,8 +46,8 @@ class Pool                                                  // for Pool of Pool
 {
 };
 
-typedef std::set<uint64> ActivePoolObjects;
-typedef std::map<uint64, uint32> ActivePoolPools;
+typedef std::unordered_set<uint64> ActivePoolObjects;
+typedef std::unordered_map<uint64, uint32> ActivePoolPools;
 
 class TC_GAME_API ActivePoolData
 {
@@ -94,9 +95,13 @@ class TC_GAME_API PoolGroup
         }
         uint32 GetPoolId() const { return poolId; }
     private:
+        bool IsMember(uint64 guid) const;
+        bool RollEqualChanced(ActivePoolData const& spawns, uint32 count, PoolObjectList& rolledObjects) const;
+
         uint32 poolId;
         PoolObjectList ExplicitlyChanced;
         PoolObjectList EqualChanced;
+        std::vector<uint64> MemberGuids;                    // sorted guids of both lists
 };
 
 class TC_GAME_API PoolMgr
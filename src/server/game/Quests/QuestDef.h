@@ -458,6 +458,28 @@ struct QuestObjective
         }
         return false;
     }
+
+    // objective types progressed by one-off credit events (kills, uses, area triggers) that change no other player state
+    static constexpr bool IsProgressedByCreditOnly(QuestObjectiveType type)
+    {
+        switch (type)
+        {
+            case QUEST_OBJECTIVE_MONSTER:
+            case QUEST_OBJECTIVE_GAMEOBJECT:
+            case QUEST_OBJECTIVE_TALKTO:
+            case QUEST_OBJECTIVE_PLAYERKILLS:
+            case QUEST_OBJECTIVE_AREATRIGGER:
+            case QUEST_OBJECTIVE_WINPETBATTLEAGAINSTNPC:
+            case QUEST_OBJECTIVE_DEFEATBATTLEPET:
+            case QUEST_OBJECTIVE_WINPVPPETBATTLES:
+            case QUEST_OBJECTIVE_AREA_TRIGGER_ENTER:
+            case QUEST_OBJECTIVE_AREA_TRIGGER_EXIT:
+                return true;
+            default:
+                break;
+        }
+        return false;
+    }
 };
 
 using QuestObjectives = std::vector<QuestObjective>;
@@ -321,9 +321,9 @@ std::vector<WorldPackets::Achievement::CriteriaProgress> Scenario::GetCriteriasP
     return criteriasProgress;
 }
 
-CriteriaList const& Scenario::GetCriteriaByType(CriteriaType type, uint32 /*asset*/) const
+CriteriaList const& Scenario::GetCriteriaByType(CriteriaType type, uint32 asset) const
 {
-    return sCriteriaMgr->GetScenarioCriteriaByType(type);
+    return sCriteriaMgr->GetScenarioCriteriaByType(type, asset);
 }
 
 void Scenario::SendBootPlayer(Player* player)
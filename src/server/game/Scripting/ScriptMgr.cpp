@@ -1147,6 +1147,44 @@ private:
     ScriptStoreType _scripts;
 };
 
+// Map scripts are looked up by map id on every map update, keep them indexed
+// instead of scanning every registered script (there is one per dungeon)
+template<typename ScriptType>
+class MapScriptIndex
+{
+public:
+    static MapScriptIndex* Instance()
+    {
+        static MapScriptIndex instance;
+        return &instance;
+    }
+
+    // must be called whenever scripts are added to or removed from the registry
+    void Rebuild()
+    {
+        _scriptsByMapId.clear();
+        for (auto const& [key, script] : ScriptRegistry<ScriptType>::Instance()->GetScripts())
+            if (MapEntry const* entry = script->GetEntry())
+                _scriptsByMapId.emplace(entry->ID, script.get());
+    }
+
+    ScriptType* GetScript(uint32 mapId) const
+    {
+        auto itr = _scriptsByMapId.find(mapId);
+        return itr != _scriptsByMapId.end() ? itr->second : nullptr;
+    }
+
+private:
+    std::unordered_map<uint32, ScriptType*> _scriptsByMapId;
+};
+
+static void RebuildMapScriptIndexes()
+{
+    MapScriptIndex<WorldMapScript>::Instance()->Rebuild();
+    MapScriptIndex<InstanceMapScript>::Instance()->Rebuild();
+    MapScriptIndex<BattlegroundMapScript>::Instance()->Rebuild();
+}
+
 // Utility macros to refer to the script registry.
 #define SCR_REG_MAP(T) ScriptRegistry<T>::ScriptStoreType
 #define SCR_REG_ITR(T) ScriptRegistry<T>::ScriptStoreIteratorType
@@ -1281,6 +1319,8 @@ void ScriptMgr::SwapScriptContext(bool initialize)
 {
     sScriptRegistryCompositum->SwapContext(initialize);
     _currentContext.clear();
+
+    RebuildMapScriptIndexes();
 }
 
 std::string const& ScriptMgr::GetNameOfStaticContext()
@@ -1292,6 +1332,8 @@ std::string const& ScriptMgr::GetNameOfStaticContext()
 void ScriptMgr::ReleaseScriptContext(std::string const& context)
 {
     sScriptRegistryCompositum->ReleaseContext(context);
+
+    RebuildMapScriptIndexes();
 }
 
 std::shared_ptr<ModuleReference>
@@ -1313,6 +1355,8 @@ void ScriptMgr::Unload()
 {
     sScriptRegistryCompositum->Unload();
 
+    RebuildMapScriptIndexes();
+
     UnitAI::AISpellInfo.clear();
 }
 
@@ -1483,20 +1527,14 @@ void ScriptMgr::OnGroupRateCalculation(float& rate, uint32 count, bool isRaid)
     FOREACH_SCRIPT(FormulaScript)->OnGroupRateCalculation(rate, count, isRaid);
 }
 
-#define SCR_MAP_BGN(M, V, I, E, C, T) \
+#define SCR_MAP_BGN(M, V, I, T) \
     if (V->GetEntry() && V->GetEntry()->T()) \
     { \
-        FOR_SCRIPTS(M, I, E) \
-        { \
-            MapEntry const* C = I->second->GetEntry(); \
-            if (!C) \
-                continue; \
-            if (C->ID == V->GetId()) \
-            {
+        if (M* I = MapScriptIndex<M>::Instance()->GetScript(V->GetId())) \
+        {
 
 #define SCR_MAP_END \
-                return; \
-            } \
+            return; \
         } \
     }
 
@@ -1504,16 +1542,16 @@ void ScriptMgr::OnCreateMap(Map* map)
 {
     ASSERT(map);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-        itr->second->OnCreate(map);
+    SCR_MAP_BGN(WorldMapScript, map, script, IsWorldMap);
+        script->OnCreate(map);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-        itr->second->OnCreate((InstanceMap*)map);
+    SCR_MAP_BGN(InstanceMapScript, map, script, IsDungeon);
+        script->OnCreate((InstanceMap*)map);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-        itr->second->OnCreate((BattlegroundMap*)map);
+    SCR_MAP_BGN(BattlegroundMapScript, map, script, IsBattleground);
+        script->OnCreate((BattlegroundMap*)map);
     SCR_MAP_END;
 }
 
@@ -1521,16 +1559,16 @@ void ScriptMgr::OnDestroyMap(Map* map)
 {
     ASSERT(map);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-        itr->second->OnDestroy(map);
+    SCR_MAP_BGN(WorldMapScript, map, script, IsWorldMap);
+        script->OnDestroy(map);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-        itr->second->OnDestroy((InstanceMap*)map);
+    SCR_MAP_BGN(InstanceMapScript, map, script, IsDungeon);
+        script->OnDestroy((InstanceMap*)map);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-        itr->second->OnDestroy((BattlegroundMap*)map);
+    SCR_MAP_BGN(BattlegroundMapScript, map, script, IsBattleground);
+        script->OnDestroy((BattlegroundMap*)map);
     SCR_MAP_END;
 }
 
@@ -1539,16 +1577,16 @@ void ScriptMgr::OnLoadGridMap(Map* map, GridMap* gmap, uint32 gx, uint32 gy)
     ASSERT(map);
     ASSERT(gmap);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-        itr->second->OnLoadGridMap(map, gmap, gx, gy);
+    SCR_MAP_BGN(WorldMapScript, map, script, IsWorldMap);
+        script->OnLoadGridMap(map, gmap, gx, gy);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-        itr->second->OnLoadGridMap((InstanceMap*)map, gmap, gx, gy);
+    SCR_MAP_BGN(InstanceMapScript, map, script, IsDungeon);
+        script->OnLoadGridMap((InstanceMap*)map, gmap, gx, gy);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-        itr->second->OnLoadGridMap((BattlegroundMap*)map, gmap, gx, gy);
+    SCR_MAP_BGN(BattlegroundMapScript, map, script, IsBattleground);
+        script->OnLoadGridMap((BattlegroundMap*)map, gmap, gx, gy);
     SCR_MAP_END;
 }
 
@@ -1557,16 +1595,16 @@ void ScriptMgr::OnUnloadGridMap(Map* map, GridMap* gmap, uint32 gx, uint32 gy)
     ASSERT(map);
     ASSERT(gmap);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-        itr->second->OnUnloadGridMap(map, gmap, gx, gy);
+    SCR_MAP_BGN(WorldMapScript, map, script, IsWorldMap);
+        script->OnUnloadGridMap(map, gmap, gx, gy);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-        itr->second->OnUnloadGridMap((InstanceMap*)map, gmap, gx, gy);
+    SCR_MAP_BGN(InstanceMapScript, map, script, IsDungeon);
+        script->OnUnloadGridMap((InstanceMap*)map, gmap, gx, gy);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-        itr->second->OnUnloadGridMap((BattlegroundMap*)map, gmap, gx, gy);
+    SCR_MAP_BGN(BattlegroundMapScript, map, script, IsBattleground);
+        script->OnUnloadGridMap((BattlegroundMap*)map, gmap, gx, gy);
     SCR_MAP_END;
 }
 
@@ -1577,16 +1615,16 @@ void ScriptMgr::OnPlayerEnterMap(Map* map, Player* player)
 
     FOREACH_SCRIPT(PlayerScript)->OnMapChanged(player);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-        itr->second->OnPlayerEnter(map, player);
+    SCR_MAP_BGN(WorldMapScript, map, script, IsWorldMap);
+        script->OnPlayerEnter(map, player);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-        itr->second->OnPlayerEnter((InstanceMap*)map, player);
+    SCR_MAP_BGN(InstanceMapScript, map, script, IsDungeon);
+        script->OnPlayerEnter((InstanceMap*)map, player);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-        itr->second->OnPlayerEnter((BattlegroundMap*)map, player);
+    SCR_MAP_BGN(BattlegroundMapScript, map, script, IsBattleground);
+        script->OnPlayerEnter((BattlegroundMap*)map, player);
     SCR_MAP_END;
 }
 
@@ -1595,16 +1633,16 @@ void ScriptMgr::OnPlayerLeaveMap(Map* map, Player* player)
     ASSERT(map);
     ASSERT(player);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-        itr->second->OnPlayerLeave(map, player);
+    SCR_MAP_BGN(WorldMapScript, map, script, IsWorldMap);
+        script->OnPlayerLeave(map, player);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-        itr->second->OnPlayerLeave((InstanceMap*)map, player);
+    SCR_MAP_BGN(InstanceMapScript, map, script, IsDungeon);
+        script->OnPlayerLeave((InstanceMap*)map, player);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-        itr->second->OnPlayerLeave((BattlegroundMap*)map, player);
+    SCR_MAP_BGN(BattlegroundMapScript, map, script, IsBattleground);
+        script->OnPlayerLeave((BattlegroundMap*)map, player);
     SCR_MAP_END;
 }
 
@@ -1612,16 +1650,16 @@ void ScriptMgr::OnMapUpdate(Map* map, uint32 diff)
 {
     ASSERT(map);
 
-    SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
-        itr->second->OnUpdate(map, diff);
+    SCR_MAP_BGN(WorldMapScript, map, script, IsWorldMap);
+        script->OnUpdate(map, diff);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
-        itr->second->OnUpdate((InstanceMap*)map, diff);
+    SCR_MAP_BGN(InstanceMapScript, map, script, IsDungeon);
+        script->OnUpdate((InstanceMap*)map, diff);
     SCR_MAP_END;
 
-    SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
-        itr->second->OnUpdate((BattlegroundMap*)map, diff);
+    SCR_MAP_BGN(BattlegroundMapScript, map, script, IsBattleground);
+        script->OnUpdate((BattlegroundMap*)map, diff);
     SCR_MAP_END;
 }
 
@@ -461,6 +461,9 @@ class HotSwapScriptReloadMgr final
         BuildJobType type_;
         // The async process result of the current job
         std::shared_ptr<Trinity::AsyncProcessResult> async_result_;
+        // Is true when the result of the job should be dropped because
+        // sources of the module were changed while it was running
+        bool terminate_early_;
 
     public:
         explicit BuildJob(std::string script_module_name, std::string script_module_project_name,
@@ -468,7 +471,7 @@ class HotSwapScriptReloadMgr final
             : script_module_name_(std::move(script_module_name)),
               script_module_project_name_(std::move(script_module_project_name)),
               script_module_build_directive_(std::move(script_module_build_directive)),
-              start_time_(getMSTime()), type_(BuildJobType::BUILD_JOB_NONE) { }
+              start_time_(getMSTime()), type_(BuildJobType::BUILD_JOB_NONE), terminate_early_(false) { }
 
         bool IsValid() const
         {
@@ -485,6 +488,10 @@ class HotSwapScriptReloadMgr final
 
         BuildJobType GetType() const { return type_; }
 
+        bool IsTerminatingEarly() const { return terminate_early_; }
+
+        void SetTerminatingEarly() { terminate_early_ = true; }
+
         std::shared_ptr<Trinity::AsyncProcessResult> const& GetProcess() const
         {
             ASSERT(async_result_, "Tried to access an empty process handle!");
@@ -545,7 +552,7 @@ public:
     HotSwapScriptReloadMgr()
         : _libraryWatcher(-1), _unique_library_name_counter(0),
           _last_time_library_changed(0), _last_time_sources_changed(0),
-          _last_time_user_informed(0), terminate_early(false) { }
+          _last_time_user_informed(0) { }
 
     virtual ~HotSwapScriptReloadMgr()
     {
@@ -659,12 +666,14 @@ public:
             _libraryWatcher = -1;
         }
 
-        // If a build is in progress cancel it
-        if (_build_job)
-        {
-            _build_job->GetProcess()->Terminate();
-            _build_job.reset();
-        }
+        // If builds are in progress cancel them
+        for (BuildJob& job : _build_jobs)
+            job.GetProcess()->Terminate();
+
+        _build_jobs.clear();
+
+        // Wait for modules which are still being prepared
+        _prepared_script_modules.clear();
 
         // Release all strong references to script modules
         // to trigger unload actions as early as possible,
@@ -823,8 +832,12 @@ private:
 
     /// Called periodically on the worldserver tick to process all
     /// load/unload/reload requests of shared libraries.
+    /// Libraries are copied and opened on a worker thread, the tick only
+    /// exchanges the scripts of the old and new module once it is ready.
     void DispatchModuleChanges()
     {
+        DispatchPreparedScriptModules();
+
         // When there are no libraries to change return
         if (_libraries_changed.empty())
             return;
@@ -833,35 +846,64 @@ private:
         if (GetMSTimeDiffToNow(_last_time_library_changed) < 500)
             return;
 
-        for (auto const& path : _libraries_changed)
+        for (auto itr = _libraries_changed.begin(); itr != _libraries_changed.end();)
         {
+            fs::path const path = *itr;
+
+            // Wait until the previous version of the library was swapped in
+            if (_prepared_script_modules.find(path) != _prepared_script_modules.end())
+            {
+                ++itr;
+                continue;
+            }
+
             bool const is_running =
                 _running_script_module_names.find(path) != _running_script_module_names.end();
 
             bool const exists = fs::exists(path);
 
-            if (is_running)
+            if (exists)
             {
-                if (exists)
-                    ProcessReloadScriptModule(path);
-                else
-                    ProcessUnloadScriptModule(path);
+                TC_LOG_TRACE("scripts.hotswap", ">> Preparing script module \"%s\" asynchronously...",
+                    path.filename().generic_string().c_str());
+
+                _prepared_script_modules.emplace(path, std::async(std::launch::async,
+                    &HotSwapScriptReloadMgr::PrepareScriptModule, path, GenerateUniquePathForLibraryInCache(path)));
             }
-            else if (exists)
-                ProcessLoadScriptModule(path);
-        }
+            else if (is_running)
+                ProcessUnloadScriptModule(path);
 
-        _libraries_changed.clear();
+            itr = _libraries_changed.erase(itr);
+        }
     }
 
-    void ProcessLoadScriptModule(fs::path const& path, bool swap_context = true)
+    /// Swaps in the script modules which finished loading on their worker thread
+    void DispatchPreparedScriptModules()
     {
-        ASSERT(_running_script_module_names.find(path) == _running_script_module_names.end(),
-               "Can't load a module which is running already!");
+        for (auto itr = _prepared_script_modules.begin(); itr != _prepared_script_modules.end();)
+        {
+            if (itr->second.wait_for(0s) != std::future_status::ready)
+            {
+                ++itr;
+                continue;
+            }
 
-        // Copy the shared library into a cache
-        auto cache_path = GenerateUniquePathForLibraryInCache(path);
+            fs::path const path = itr->first;
+            std::shared_ptr<ScriptModule> module = itr->second.get();
+            itr = _prepared_script_modules.erase(itr);
 
+            if (_running_script_module_names.find(path) != _running_script_module_names.end())
+                ProcessUnloadScriptModule(path, false);
+
+            ProcessRegisterScriptModule(path, std::move(module));
+        }
+    }
+
+    /// Copies the shared library into the cache and opens it,
+    /// doesn't touch the script registry so it's safe to call from any thread.
+    static std::shared_ptr<ScriptModule> PrepareScriptModule(fs::path const& path, fs::path const& cache_path)
+    {
+        // Copy the shared library into a cache
         {
             boost::system::error_code code;
             fs::copy_file(path, cache_path, fs::copy_option::fail_if_exists, code);
@@ -876,7 +918,7 @@ private:
                 // to start the core without scripts
                 std::this_thread::sleep_for(std::chrono::seconds(5));
                 ABORT();
-                return;
+                return nullptr;
             }
 
             TC_LOG_TRACE("scripts.hotswap", ">> Copied the shared library \"%s\" to \"%s\" for caching.",
@@ -893,15 +935,28 @@ private:
             // to start the core without scripts
             std::this_thread::sleep_for(std::chrono::seconds(5));
             ABORT();
-            return;
+            return nullptr;
         }
 
+        return *module;
+    }
+
+    void ProcessLoadScriptModule(fs::path const& path, bool swap_context = true)
+    {
+        ProcessRegisterScriptModule(path, PrepareScriptModule(path, GenerateUniquePathForLibraryInCache(path)), swap_context);
+    }
+
+    void ProcessRegisterScriptModule(fs::path const& path, std::shared_ptr<ScriptModule> module, bool swap_context = true)
+    {
+        ASSERT(_running_script_module_names.find(path) == _running_script_module_names.end(),
+               "Can't load a module which is running already!");
+
         // Limit the git revision hash to 7 characters.
-        std::string module_revision((*module)->GetScriptModuleRevisionHash());
+        std::string module_revision(module->GetScriptModuleRevisionHash());
         if (module_revision.size() >= 7)
             module_revision = module_revision.substr(0, 7);
 
-        std::string const module_name = (*module)->GetScriptModule();
+        std::string const module_name = module->GetScriptModule();
         TC_LOG_INFO("scripts.hotswap", ">> Loaded script module \"%s\" (\"%s\" - %s).",
             path.filename().generic_string().c_str(), module_name.c_str(), module_revision.c_str());
 
@@ -942,26 +997,20 @@ private:
             module_name);
 
         // Store the module
-        _known_modules_build_directives.insert(std::make_pair(module_name, (*module)->GetBuildDirective()));
+        _known_modules_build_directives.insert(std::make_pair(module_name, module->GetBuildDirective()));
         _running_script_modules.insert(std::make_pair(module_name,
-            std::make_pair(*module, std::move(listener))));
+            std::make_pair(module, std::move(listener))));
         _running_script_module_names.insert(std::make_pair(path, module_name));
 
         // Process the script loading after the module was registered correctly (#17557).
         sScriptMgr->SetScriptContext(module_name);
-        (*module)->AddScripts();
+        module->AddScripts();
         TC_LOG_TRACE("scripts.hotswap", ">> Registered all scripts of module %s.", module_name.c_str());
 
         if (swap_context)
             sScriptMgr->SwapScriptContext();
     }
 
-    void ProcessReloadScriptModule(fs::path const& path)
-    {
-        ProcessUnloadScriptModule(path, false);
-        ProcessLoadScriptModule(path);
-    }
-
     void ProcessUnloadScriptModule(fs::path const& path, bool finish = true)
     {
         auto const itr = _running_script_module_names.find(path);
@@ -1003,46 +1052,45 @@ private:
     }
 
     /// Called periodically on the worldserver tick to process all recompile
-    /// requests. This method invokes one build or install job at the time
+    /// requests. This method invokes up to HotSwap.MaxParallelBuilds build or
+    /// install jobs at the time, each of them for a different module.
     void DispatchRunningBuildJobs()
     {
-        if (_build_job)
+        for (auto itr = _build_jobs.begin(); itr != _build_jobs.end();)
         {
             // Terminate the current build job when an associated source was changed
             // while compiling and the terminate early option is enabled.
             if (sWorld->getBoolConfig(CONFIG_HOTSWAP_EARLY_TERMINATION_ENABLED))
             {
-                if (!terminate_early && _sources_changed.find(_build_job->GetModuleName()) != _sources_changed.end())
+                if (!itr->IsTerminatingEarly() && _sources_changed.find(itr->GetModuleName()) != _sources_changed.end())
                 {
                     /*
                     FIXME: Currently crashes the server
                     TC_LOG_INFO("scripts.hotswap", "Terminating the running build of module \"%s\"...",
-                                _build_job->GetModuleName().c_str());
-
-                    _build_job->GetProcess()->Terminate();
-                    _build_job.reset();
+                                itr->GetModuleName().c_str());
 
-                    // Continue with the default execution path
-                    DispatchRunningBuildJobs();
-                    return;
+                    itr->GetProcess()->Terminate();
                     */
 
-                    terminate_early = true;
-                    return;
+                    itr->SetTerminatingEarly();
+                    ++itr;
+                    continue;
                 }
             }
 
-            // Wait for the current build job to finish, if the job finishes in time
-            // evaluate it and continue with the next one.
-            if (_build_job->GetProcess()->GetFutureResult().
-                    wait_for(0s) == std::future_status::ready)
-                ProcessReadyBuildJob();
-            else
-                return; // Return when the job didn't finish in time
+            // Wait for the job to finish, if the job finishes in time
+            // evaluate it and continue with the next step of it.
+            if (itr->GetProcess()->GetFutureResult().
+                    wait_for(0s) != std::future_status::ready)
+            {
+                ++itr;
+                continue;
+            }
 
-            // Skip this cycle when the previous job scheduled a new one
-            if (_build_job)
-                return;
+            if (ProcessReadyBuildJob(*itr))
+                itr = _build_jobs.erase(itr);
+            else
+                ++itr;
         }
 
         // Avoid burst updates through waiting for a short time after changes
@@ -1070,87 +1118,108 @@ private:
             return;
         }
 
-        // Find all source files of a changed script module and removes
-        // it from the changed source list, invoke the build afterwards.
-        bool rebuild_buildfiles;
-        auto module_name = [&]
+        // CMake reruns recreate the build files of every module, nothing else runs meanwhile
+        if (std::any_of(_build_jobs.begin(), _build_jobs.end(), [](BuildJob const& job) { return job.GetType() == BuildJobType::BUILD_JOB_RERUN_CMAKE; }))
+            return;
+
+        while (_build_jobs.size() < sWorld->getIntConfig(CONFIG_HOTSWAP_MAX_PARALLEL_BUILDS))
         {
-            auto itr = _sources_changed.begin();
-            auto name = itr->first;
-            rebuild_buildfiles = !itr->second.empty();
+            // Modules changed while being built wait for their running job
+            auto itr = std::find_if(_sources_changed.begin(), _sources_changed.end(), [&](decltype(_sources_changed)::value_type const& entry)
+            {
+                return std::none_of(_build_jobs.begin(), _build_jobs.end(), [&](BuildJob const& job) { return job.GetModuleName() == entry.first; });
+            });
 
-            if (sLog->ShouldLog("scripts.hotswap", LogLevel::LOG_LEVEL_TRACE))
-                for (auto const& entry : itr->second)
-                {
-                    TC_LOG_TRACE("scripts.hotswap", "Source file %s was %s.",
-                        entry.first.generic_string().c_str(),
-                        ((entry.second == ChangeStateRequest::CHANGE_REQUEST_ADDED) ?
-                            "added" : "removed"));
-                }
+            if (itr == _sources_changed.end())
+                return;
 
-            _sources_changed.erase(itr);
-            return name;
-        }();
+            bool const rebuild_buildfiles = !itr->second.empty();
+            bool const rerun_cmake = rebuild_buildfiles
+                && sWorld->getBoolConfig(CONFIG_HOTSWAP_BUILD_FILE_RECREATION_ENABLED);
 
-        // Erase the added delete history all modules when we
-        // invoke a cmake rebuild since we add all
-        // added files of other modules to the build as well
-        if (rebuild_buildfiles)
-        {
-            for (auto& entry : _sources_changed)
-                entry.second.clear();
-        }
+            // Wait for the running jobs before recreating the build files
+            if (rerun_cmake && !_build_jobs.empty())
+                return;
 
-        ASSERT(!module_name.empty(),
-               "The current module name is invalid!");
+            // Find all source files of a changed script module and removes
+            // it from the changed source list, invoke the build afterwards.
+            auto module_name = [&]
+            {
+                auto name = itr->first;
 
-        TC_LOG_INFO("scripts.hotswap", "Recompiling Module \"%s\"...",
-            module_name.c_str());
+                if (sLog->ShouldLog("scripts.hotswap", LogLevel::LOG_LEVEL_TRACE))
+                    for (auto const& entry : itr->second)
+                    {
+                        TC_LOG_TRACE("scripts.hotswap", "Source file %s was %s.",
+                            entry.first.generic_string().c_str(),
+                            ((entry.second == ChangeStateRequest::CHANGE_REQUEST_ADDED) ?
+                                "added" : "removed"));
+                    }
 
-        // Calculate the project name of the script module
-        auto project_name = CalculateScriptModuleProjectName(module_name);
+                _sources_changed.erase(itr);
+                return name;
+            }();
 
-        // Find the best build directive for the module
-        auto build_directive = [&] () -> std::string
-        {
-            auto directive = sConfigMgr->GetStringDefault("HotSwap.ReCompilerBuildType", "");
-            if (!directive.empty())
-                return directive;
-
-            auto const itr = _known_modules_build_directives.find(module_name);
-            if (itr != _known_modules_build_directives.end())
-                return itr->second;
-            else // If no build directive of the module was found use the one from the game library
-                return _BUILD_DIRECTIVE;
-        }();
-
-        // Initiate the new build job
-        _build_job = BuildJob(std::move(module_name),
-            std::move(project_name), std::move(build_directive));
-
-        // Rerun CMake when we need to recreate the build files
-        if (rebuild_buildfiles
-            && sWorld->getBoolConfig(CONFIG_HOTSWAP_BUILD_FILE_RECREATION_ENABLED))
-            DoRerunCMake();
-        else
-            DoCompileCurrentProcessedModule();
+            // Erase the added delete history all modules when we
+            // invoke a cmake rebuild since we add all
+            // added files of other modules to the build as well
+            if (rebuild_buildfiles)
+            {
+                for (auto& entry : _sources_changed)
+                    entry.second.clear();
+            }
+
+            ASSERT(!module_name.empty(),
+                   "The current module name is invalid!");
+
+            TC_LOG_INFO("scripts.hotswap", "Recompiling Module \"%s\"...",
+                module_name.c_str());
+
+            // Calculate the project name of the script module
+            auto project_name = CalculateScriptModuleProjectName(module_name);
+
+            // Find the best build directive for the module
+            auto build_directive = [&] () -> std::string
+            {
+                auto directive = sConfigMgr->GetStringDefault("HotSwap.ReCompilerBuildType", "");
+                if (!directive.empty())
+                    return directive;
+
+                auto const itr = _known_modules_build_directives.find(module_name);
+                if (itr != _known_modules_build_directives.end())
+                    return itr->second;
+                else // If no build directive of the module was found use the one from the game library
+                    return _BUILD_DIRECTIVE;
+            }();
+
+            // Initiate the new build job
+            BuildJob& job = _build_jobs.emplace_back(std::move(module_name),
+                std::move(project_name), std::move(build_directive));
+
+            // Rerun CMake when we need to recreate the build files
+            if (rerun_cmake)
+            {
+                DoRerunCMake(job);
+                return;
+            }
+
+            DoCompileProcessedModule(job);
+        }
     }
 
-    void ProcessReadyBuildJob()
+    /// Evaluates a finished step of the given job and starts its next step,
+    /// returns true when the job is done.
+    bool ProcessReadyBuildJob(BuildJob& job)
     {
-        ASSERT(_build_job->IsValid(), "Invalid build job!");
+        ASSERT(job.IsValid(), "Invalid build job!");
 
         // Retrieve the result
-        auto const error = _build_job->GetProcess()->GetFutureResult().get();
+        auto const error = job.GetProcess()->GetFutureResult().get();
 
-        if (terminate_early)
-        {
-            _build_job.reset();
-            terminate_early = false;
-            return;
-        }
+        if (job.IsTerminatingEarly())
+            return true;
 
-        switch (_build_job->GetType())
+        switch (job.GetType())
         {
             case BuildJobType::BUILD_JOB_RERUN_CMAKE:
             {
@@ -1166,8 +1235,8 @@ private:
                                 BuiltInConfig::GetBuildDirectory().c_str());
                 }
                 // Continue with building the changes sources
-                DoCompileCurrentProcessedModule();
-                return;
+                DoCompileProcessedModule(job);
+                return false;
             }
             case BuildJobType::BUILD_JOB_COMPILE:
             {
@@ -1178,22 +1247,22 @@ private:
                         // Continue with the installation when it's enabled
                         TC_LOG_INFO("scripts.hotswap",
                                     ">> Successfully build module %s, continue with installing...",
-                                    _build_job->GetModuleName().c_str());
+                                    job.GetModuleName().c_str());
 
-                        DoInstallCurrentProcessedModule();
-                        return;
+                        DoInstallProcessedModule(job);
+                        return false;
                     }
 
                     // Skip the installation because it's disabled in config
                     TC_LOG_INFO("scripts.hotswap",
                         ">> Successfully build module %s, skipped the installation.",
-                        _build_job->GetModuleName().c_str());
+                        job.GetModuleName().c_str());
                 }
                 else // Build wasn't successful
                 {
                     TC_LOG_ERROR("scripts.hotswap",
                         ">> The build of module %s failed! See the log for details.",
-                        _build_job->GetModuleName().c_str());
+                        job.GetModuleName().c_str());
                 }
                 break;
             }
@@ -1203,15 +1272,15 @@ private:
                 {
                     // Installation was successful
                     TC_LOG_INFO("scripts.hotswap", ">> Successfully installed module %s in %us",
-                        _build_job->GetModuleName().c_str(),
-                        _build_job->GetTimeFromStart() / IN_MILLISECONDS);
+                        job.GetModuleName().c_str(),
+                        job.GetTimeFromStart() / IN_MILLISECONDS);
                 }
                 else
                 {
                     // Installation wasn't successful
                     TC_LOG_INFO("scripts.hotswap",
                         ">> The installation of module %s failed! See the log for details.",
-                        _build_job->GetModuleName().c_str());
+                        job.GetModuleName().c_str());
                 }
                 break;
             }
@@ -1219,48 +1288,42 @@ private:
                 break;
         }
 
-        // Clear the current job
-        _build_job.reset();
+        return true;
     }
 
     /// Reruns CMake asynchronously over the build directory
-    void DoRerunCMake()
+    void DoRerunCMake(BuildJob& job)
     {
-        ASSERT(_build_job, "There isn't any active build job!");
-
         TC_LOG_INFO("scripts.hotswap", "Rerunning CMake because there were sources added or removed...");
 
-        _build_job->UpdateCurrentJob(BuildJobType::BUILD_JOB_RERUN_CMAKE,
+        job.UpdateCurrentJob(BuildJobType::BUILD_JOB_RERUN_CMAKE,
             InvokeAsyncCMakeCommand(BuiltInConfig::GetBuildDirectory()));
     }
 
-    /// Invokes a new build of the current active module job
-    void DoCompileCurrentProcessedModule()
+    /// Invokes a new build of the module of the given job,
+    /// the build tool only recompiles the changed sources of it
+    void DoCompileProcessedModule(BuildJob& job)
     {
-        ASSERT(_build_job, "There isn't any active build job!");
-
         TC_LOG_INFO("scripts.hotswap", "Starting asynchronous build job for module %s...",
-                    _build_job->GetModuleName().c_str());
+                    job.GetModuleName().c_str());
 
-        _build_job->UpdateCurrentJob(BuildJobType::BUILD_JOB_COMPILE,
+        job.UpdateCurrentJob(BuildJobType::BUILD_JOB_COMPILE,
             InvokeAsyncCMakeCommand(
                 "--build", BuiltInConfig::GetBuildDirectory(),
-                "--target", _build_job->GetProjectName(),
-                "--config", _build_job->GetBuildDirective()));
+                "--target", job.GetProjectName(),
+                "--config", job.GetBuildDirective()));
     }
 
-    /// Invokes a new asynchronous install of the current active module job
-    void DoInstallCurrentProcessedModule()
+    /// Invokes a new asynchronous install of the module of the given job
+    void DoInstallProcessedModule(BuildJob& job)
     {
-        ASSERT(_build_job, "There isn't any active build job!");
-
         TC_LOG_INFO("scripts.hotswap", "Starting asynchronous install job for module %s...",
-                    _build_job->GetModuleName().c_str());
+                    job.GetModuleName().c_str());
 
-        _build_job->UpdateCurrentJob(BuildJobType::BUILD_JOB_INSTALL,
+        job.UpdateCurrentJob(BuildJobType::BUILD_JOB_INSTALL,
             InvokeAsyncCMakeCommand(
-                "-DCOMPONENT=" + _build_job->GetProjectName(),
-                "-DBUILD_TYPE=" + _build_job->GetBuildDirective(),
+                "-DCOMPONENT=" + job.GetProjectName(),
+                "-DBUILD_TYPE=" + job.GetBuildDirective(),
                 "-P", fs::absolute("cmake_install.cmake",
                     BuiltInConfig::GetBuildDirectory()).generic_string()));
     }
@@ -1424,12 +1487,12 @@ private:
     // Tracks the last timestamp the user was informed about a certain repeating event.
     uint32 _last_time_user_informed;
 
-    // Represents the current build job which is in progress
-    Optional<BuildJob> _build_job;
+    // Build jobs which are in progress, at most one per module
+    std::vector<BuildJob> _build_jobs;
 
-    // Is true when the build job dispatcher should stop after
-    // the current job has finished
-    bool terminate_early;
+    // Shared libraries which are copied and opened on a worker thread,
+    // swapped in on the next tick after they are ready
+    std::unordered_map<fs::path, std::future<std::shared_ptr<ScriptModule>>> _prepared_script_modules;
 
     // The path to the tc_scripts temporary cache
     fs::path temporary_cache_path_;
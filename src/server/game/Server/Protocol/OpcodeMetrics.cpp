@@ -0,0 +1,124 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeMetrics.h"
+#include "Opcodes.h"
+#include <map>
+#include <string>
+
+void OpcodeMetrics::OpcodeStats::Merge(OpcodeStats const& other)
+{
+    Count += other.Count;
+    Bytes += other.Bytes;
+    TotalMicroseconds += other.TotalMicroseconds;
+    for (std::size_t i = 0; i < LatencyBucketCount; ++i)
+        LatencyBuckets[i] += other.LatencyBuckets[i];
+}
+
+OpcodeMetrics* OpcodeMetrics::instance()
+{
+    static OpcodeMetrics instance;
+    return &instance;
+}
+
+std::size_t OpcodeMetrics::GetLatencyBucket(uint64 microseconds)
+{
+    std::size_t bucket = 0;
+    while (microseconds && bucket < LatencyBucketCount - 1)
+    {
+        microseconds >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+OpcodeMetrics::Shard& OpcodeMetrics::GetThreadShard()
+{
+    // shards are owned by _shards and outlive the threads that created them
+    thread_local Shard* shard = nullptr;
+    if (!shard)
+    {
+        std::lock_guard<std::mutex> lock(_shardsLock);
+        _shards.push_back(std::make_unique<Shard>());
+        shard = _shards.back().get();
+    }
+
+    return *shard;
+}
+
+void OpcodeMetrics::Record(OpcodeClient opcode, std::size_t packetSize, std::chrono::steady_clock::duration elapsed)
+{
+    uint64 microseconds = uint64(std::chrono::duration_cast<Microseconds>(elapsed).count());
+
+    Shard& shard = GetThreadShard();
+    // only contended while Flush() is swapping this shard out
+    std::lock_guard<std::mutex> lock(shard.Lock);
+    OpcodeStats& stats = shard.Stats[uint16(opcode)];
+    ++stats.Count;
+    stats.Bytes += packetSize;
+    stats.TotalMicroseconds += microseconds;
+    ++stats.LatencyBuckets[GetLatencyBucket(microseconds)];
+}
+
+void OpcodeMetrics::Flush()
+{
+    std::map<uint16, OpcodeStats> merged;
+    {
+        std::lock_guard<std::mutex> lock(_shardsLock);
+        for (std::unique_ptr<Shard> const& shard : _shards)
+        {
+            std::unordered_map<uint16, OpcodeStats> stats;
+            {
+                std::lock_guard<std::mutex> shardLock(shard->Lock);
+                stats.swap(shard->Stats);
+            }
+
+            for (std::pair<uint16 const, OpcodeStats> const& opcodeStats : stats)
+                merged[opcodeStats.first].Merge(opcodeStats.second);
+        }
+    }
+
+    if (!sMetric->IsEnabled())
+        return;
+
+    // inclusive integer bounds matching GetLatencyBucket: bucket N ends at 2^N - 1 us
+    static std::vector<int64> const latencyBounds = []()
+    {
+        std::vector<int64> bounds;
+        for (std::size_t i = 0; i < LatencyBucketCount - 1; ++i)
+            bounds.push_back((int64(1) << i) - 1);
+        return bounds;
+    }();
+
+    for (std::pair<uint16 const, OpcodeStats> const& opcodeStats : merged)
+    {
+        ClientOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeClient>(opcodeStats.first)];
+        std::string opcodeName = handler ? handler->Name : std::to_string(opcodeStats.first);
+        OpcodeStats const& stats = opcodeStats.second;
+
+        sMetric->GetCounter("opcode_handler_count", { TC_METRIC_TAG("opcode", opcodeName) }).Increment(stats.Count);
+        sMetric->GetCounter("opcode_handler_bytes", { TC_METRIC_TAG("opcode", opcodeName) }).Increment(stats.Bytes);
+
+        MetricHistogram& latency = sMetric->GetHistogram("opcode_handler_latency", latencyBounds, { TC_METRIC_TAG("opcode", opcodeName) });
+        for (std::size_t i = 0; i < LatencyBucketCount; ++i)
+            if (stats.LatencyBuckets[i])
+                latency.AddBucketCount(i, stats.LatencyBuckets[i]);
+
+        latency.AddSum(int64(stats.TotalMicroseconds));
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_OPCODEMETRICS_H
+#define TRINITY_OPCODEMETRICS_H
+
+#include "Define.h"
+#include "Duration.h"
+#include "Metric.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+enum OpcodeClient : uint16;
+
+/// Per opcode handler call counts, payload bytes and log2 bucketed latencies.
+/// Samples are recorded into a shard owned by the calling thread and merged by Flush() into the sMetric registry
+class TC_GAME_API OpcodeMetrics
+{
+public:
+    /// bucket 0 holds calls under 1us, bucket N holds calls in [2^(N-1), 2^N) us, the last bucket is unbounded
+    static constexpr std::size_t LatencyBucketCount = 21;
+
+    struct OpcodeStats
+    {
+        uint64 Count = 0;
+        uint64 Bytes = 0;
+        uint64 TotalMicroseconds = 0;
+        std::array<uint64, LatencyBucketCount> LatencyBuckets = { };
+
+        void Merge(OpcodeStats const& other);
+    };
+
+    static OpcodeMetrics* instance();
+
+    void Record(OpcodeClient opcode, std::size_t packetSize, std::chrono::steady_clock::duration elapsed);
+
+    /// Merges all thread shards into the registered sMetric counters and histograms, called periodically from the world thread
+    void Flush();
+
+    static std::size_t GetLatencyBucket(uint64 microseconds);
+
+private:
+    struct Shard
+    {
+        std::mutex Lock;
+        std::unordered_map<uint16, OpcodeStats> Stats;
+    };
+
+    OpcodeMetrics() = default;
+    ~OpcodeMetrics() = default;
+
+    Shard& GetThreadShard();
+
+    std::mutex _shardsLock;
+    std::vector<std::unique_ptr<Shard>> _shards;
+};
+
+#define sOpcodeMetrics OpcodeMetrics::instance()
+
+#if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
+#define TC_METRIC_OPCODE_TIMER(opcode, packetSize) ((void)0)
+#else
+#define TC_METRIC_OPCODE_TIMER(opcode, packetSize)                                                               \
+        MetricStopWatch TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch(                     \
+            [metricOpcode = (opcode), metricPacketSize = std::size_t(packetSize)](TimePoint start)              \
+        {                                                                                                        \
+            if (sMetric->IsEnabled())                                                                            \
+                sOpcodeMetrics->Record(metricOpcode, metricPacketSize, std::chrono::steady_clock::now() - start); \
+        });
+#endif
+
+#endif // TRINITY_OPCODEMETRICS_H
@@ -19,10 +19,13 @@
 #include "Config.h"
 #include "GameTime.h"
 #include "IpAddress.h"
+#include "Log.h"
 #include "Realm.h"
 #include "Timer.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <algorithm>
+#include <atomic>
 
 #pragma pack(push, 1)
 
@@ -60,13 +63,115 @@ struct PacketHeader
 
 #pragma pack(pop)
 
-PacketLog::PacketLog() : _file(nullptr)
+struct PacketRingBuffer
+{
+    explicit PacketRingBuffer(std::size_t capacity) : Data(capacity), Head(0), Tail(0), InUse(true) { }
+
+    // records are a uint32 size followed by the PacketHeader and the payload, wrapping around the end of Data
+    void Write(PacketHeader const& header, uint8 const* payload, std::size_t payloadSize)
+    {
+        uint32 size = uint32(sizeof(header) + payloadSize);
+
+        std::lock_guard<std::mutex> lock(Lock);
+        while (Head + sizeof(size) + size - Tail > Data.size())
+        {
+            uint32 oldestSize;
+            Read(Tail, &oldestSize, sizeof(oldestSize));
+            Tail += sizeof(oldestSize) + oldestSize;
+        }
+
+        Put(Head, &size, sizeof(size));
+        Put(Head + sizeof(size), &header, sizeof(header));
+        Put(Head + sizeof(size) + sizeof(header), payload, payloadSize);
+        Head += sizeof(size) + size;
+    }
+
+    // appends the records that arrived since sinceTicks as (arrival ticks, header + payload)
+    void Copy(uint32 sinceTicks, uint32 window, std::vector<std::pair<uint32, std::vector<uint8>>>& records)
+    {
+        std::lock_guard<std::mutex> lock(Lock);
+        for (uint64 position = Tail; position < Head;)
+        {
+            uint32 size;
+            PacketHeader header;
+            Read(position, &size, sizeof(size));
+            Read(position + sizeof(size), &header, sizeof(header));
+            if (getMSTimeDiff(sinceTicks, header.ArrivalTicks) <= window)
+            {
+                std::vector<uint8> record(size);
+                Read(position + sizeof(size), record.data(), size);
+                records.emplace_back(header.ArrivalTicks, std::move(record));
+            }
+
+            position += sizeof(size) + size;
+        }
+    }
+
+    void Put(uint64 position, void const* source, std::size_t size)
+    {
+        std::size_t offset = std::size_t(position % Data.size());
+        std::size_t first = std::min(size, Data.size() - offset);
+        memcpy(&Data[offset], source, first);
+        memcpy(Data.data(), static_cast<uint8 const*>(source) + first, size - first);
+    }
+
+    void Read(uint64 position, void* destination, std::size_t size) const
+    {
+        std::size_t offset = std::size_t(position % Data.size());
+        std::size_t first = std::min(size, Data.size() - offset);
+        memcpy(destination, &Data[offset], first);
+        memcpy(static_cast<uint8*>(destination) + first, Data.data(), size - first);
+    }
+
+    std::mutex Lock;
+    std::vector<uint8> Data;
+    uint64 Head;                // bytes written since the buffer was created
+    uint64 Tail;                // position of the oldest record
+    std::atomic<bool> InUse;    // owned by a running thread
+};
+
+namespace
+{
+    LogHeader MakeLogHeader(uint32 startUnixtime, uint32 startTicks)
+    {
+        LogHeader header;
+        header.Signature[0] = 'P'; header.Signature[1] = 'K'; header.Signature[2] = 'T';
+        header.FormatVersion = 0x0301;
+        header.SnifferId = 'T';
+        header.Build = realm.Build;
+        header.Locale[0] = 'e'; header.Locale[1] = 'n'; header.Locale[2] = 'U'; header.Locale[3] = 'S';
+        std::memset(header.SessionKey, 0, sizeof(header.SessionKey));
+        header.SniffStartUnixtime = startUnixtime;
+        header.SniffStartTicks = startTicks;
+        header.OptionalDataSize = 0;
+        return header;
+    }
+
+    // releases the ring buffer of a thread for reuse when the thread exits
+    struct ThreadRingBuffer
+    {
+        ~ThreadRingBuffer()
+        {
+            if (Buffer)
+                Buffer->InUse = false;
+        }
+
+        PacketRingBuffer* Buffer = nullptr;
+    };
+
+    thread_local ThreadRingBuffer CurrentThreadRingBuffer;
+}
+
+PacketLog::PacketLog() : _file(nullptr), _ringBufferSize(0), _ringBufferPayloads(true)
 {
     std::call_once(_initializeFlag, &PacketLog::Initialize, this);
 }
 
 PacketLog::~PacketLog()
 {
+    if (_dumpTask.valid())
+        _dumpTask.wait();
+
     if (_file)
         fclose(_file);
 
@@ -92,28 +197,19 @@ void PacketLog::Initialize()
     {
         _file = fopen((logsDir + logname).c_str(), "wb");
 
-        if (CanLogPacket())
+        if (_file)
         {
-            LogHeader header;
-            header.Signature[0] = 'P'; header.Signature[1] = 'K'; header.Signature[2] = 'T';
-            header.FormatVersion = 0x0301;
-            header.SnifferId = 'T';
-            header.Build = realm.Build;
-            header.Locale[0] = 'e'; header.Locale[1] = 'n'; header.Locale[2] = 'U'; header.Locale[3] = 'S';
-            std::memset(header.SessionKey, 0, sizeof(header.SessionKey));
-            header.SniffStartUnixtime = GameTime::GetGameTime();
-            header.SniffStartTicks = getMSTime();
-            header.OptionalDataSize = 0;
-
+            LogHeader header = MakeLogHeader(GameTime::GetGameTime(), getMSTime());
             fwrite(&header, sizeof(header), 1, _file);
         }
     }
+
+    _ringBufferSize = std::size_t(sConfigMgr->GetIntDefault("PacketLog.RingBufferSize", 512)) * 1024;
+    _ringBufferPayloads = sConfigMgr->GetBoolDefault("PacketLog.RingBufferPayloads", true);
 }
 
 void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType)
 {
-    std::lock_guard<std::mutex> lock(_logPacketLock);
-
     PacketHeader header;
     header.Direction = direction == CLIENT_TO_SERVER ? 0x47534d43 : 0x47534d53;
     header.ConnectionId = connectionType;
@@ -140,14 +236,92 @@ void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost:
     header.Length = size + sizeof(header.Opcode);
     header.Opcode = packet.GetOpcode();
 
+    uint8 const* data = packet.contents();
+    if (direction == CLIENT_TO_SERVER)
+        data += 2;
+
+    if (_ringBufferSize)
+    {
+        // payloads are truncated to keep a few records in the smallest buffers, Length is adjusted so the dump stays parsable
+        std::size_t ringSize = _ringBufferPayloads ? std::min(size, _ringBufferSize / 4) : 0;
+        PacketHeader ringHeader = header;
+        ringHeader.Length = ringSize + sizeof(header.Opcode);
+        GetThreadRingBuffer()->Write(ringHeader, data, ringSize);
+    }
+
+    if (!_file)
+        return;
+
+    std::lock_guard<std::mutex> lock(_logPacketLock);
     fwrite(&header, sizeof(header), 1, _file);
     if (size)
-    {
-        uint8 const* data = packet.contents();
-        if (direction == CLIENT_TO_SERVER)
-            data += 2;
         fwrite(data, 1, size, _file);
-    }
 
     fflush(_file);
 }
+
+PacketRingBuffer* PacketLog::GetThreadRingBuffer()
+{
+    if (CurrentThreadRingBuffer.Buffer)
+        return CurrentThreadRingBuffer.Buffer;
+
+    std::lock_guard<std::mutex> lock(_ringBuffersLock);
+    for (std::unique_ptr<PacketRingBuffer>& buffer : _ringBuffers)
+    {
+        bool inUse = false;
+        if (buffer->InUse.compare_exchange_strong(inUse, true))
+        {
+            CurrentThreadRingBuffer.Buffer = buffer.get();
+            return buffer.get();
+        }
+    }
+
+    _ringBuffers.push_back(std::make_unique<PacketRingBuffer>(_ringBufferSize));
+    CurrentThreadRingBuffer.Buffer = _ringBuffers.back().get();
+    return CurrentThreadRingBuffer.Buffer;
+}
+
+bool PacketLog::DumpRecentPackets(std::string const& fileName, uint32 seconds)
+{
+    if (!_ringBufferSize)
+        return false;
+
+    std::lock_guard<std::mutex> dumpLock(_dumpLock);
+    if (_dumpTask.valid() && _dumpTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    uint32 window = seconds * IN_MILLISECONDS;
+    uint32 sinceTicks = getMSTime() - window;
+
+    std::vector<std::pair<uint32, std::vector<uint8>>> records;
+    {
+        std::lock_guard<std::mutex> lock(_ringBuffersLock);
+        for (std::unique_ptr<PacketRingBuffer>& buffer : _ringBuffers)
+            buffer->Copy(sinceTicks, window, records);
+    }
+
+    std::stable_sort(records.begin(), records.end(), [sinceTicks](std::pair<uint32, std::vector<uint8>> const& left, std::pair<uint32, std::vector<uint8>> const& right)
+    {
+        return getMSTimeDiff(sinceTicks, left.first) < getMSTimeDiff(sinceTicks, right.first);
+    });
+
+    LogHeader header = MakeLogHeader(uint32(GameTime::GetGameTime()) - seconds, sinceTicks);
+    _dumpTask = std::async(std::launch::async, [fileName, header, records = std::move(records)]()
+    {
+        FILE* file = fopen(fileName.c_str(), "wb");
+        if (!file)
+        {
+            TC_LOG_ERROR("network", "PacketLog::DumpRecentPackets: Could not open %s for writing", fileName.c_str());
+            return;
+        }
+
+        fwrite(&header, sizeof(header), 1, file);
+        for (std::pair<uint32, std::vector<uint8>> const& record : records)
+            fwrite(record.second.data(), 1, record.second.size(), file);
+
+        fclose(file);
+        TC_LOG_INFO("network", "PacketLog::DumpRecentPackets: Wrote %u packets to %s", uint32(records.size()), fileName.c_str());
+    });
+
+    return true;
+}
@@ -19,7 +19,10 @@
 #define TRINITY_PACKETLOG_H
 
 #include "Common.h"
+#include <future>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 enum Direction
 {
@@ -28,6 +31,7 @@ enum Direction
 };
 
 class WorldPacket;
+struct PacketRingBuffer;
 enum ConnectionType : int8;
 
 namespace boost
@@ -53,11 +57,29 @@ class TC_GAME_API PacketLog
         static PacketLog* instance();
 
         void Initialize();
-        bool CanLogPacket() const { return (_file != nullptr); }
+        bool CanLogPacket() const { return _file != nullptr || _ringBufferSize != 0; }
         void LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType);
 
+        bool IsRingBufferEnabled() const { return _ringBufferSize != 0; }
+
+        /// Writes the packets recorded in the ring buffers during the last `seconds` to fileName (PKT format) from a background thread.
+        /// Fails when the ring buffers are disabled or the previous dump is still being written
+        bool DumpRecentPackets(std::string const& fileName, uint32 seconds);
+
     private:
+        /// Ring buffer of the calling thread, recycled from exited threads
+        PacketRingBuffer* GetThreadRingBuffer();
+
         FILE* _file;
+
+        /// Every thread sending or receiving packets records them into its own ring buffer (PacketLog.RingBufferSize),
+        /// its lock is only contended while a dump copies it
+        std::vector<std::unique_ptr<PacketRingBuffer>> _ringBuffers;
+        std::mutex _ringBuffersLock;
+        std::size_t _ringBufferSize;
+        bool _ringBufferPayloads;
+        std::future<void> _dumpTask;
+        std::mutex _dumpLock;
 };
 
 #define sPacketLog PacketLog::instance()
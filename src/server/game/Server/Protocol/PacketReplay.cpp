@@ -0,0 +1,197 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketReplay.h"
+#include "ByteBuffer.h"
+#include "Chat.h"
+#include "EventProcessor.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "Player.h"
+#include "UpdateTime.h"
+#include "WorldSession.h"
+#include <array>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    constexpr uint32 PKT_DIRECTION_CLIENT_TO_SERVER = 0x47534d43;   // "CMSG"
+    constexpr std::size_t PKT_SESSION_KEY_SIZE = 40;
+
+    bool CanReplay(uint32 opcode)
+    {
+        if (opcode >= NUM_OPCODE_HANDLERS)
+            return false;
+
+        switch (opcode)
+        {
+            // handled by WorldSocket or would end the session being replayed into
+            case CMSG_AUTH_SESSION:
+            case CMSG_AUTH_CONTINUED_SESSION:
+            case CMSG_PING:
+            case CMSG_KEEP_ALIVE:
+            case CMSG_LOG_DISCONNECT:
+            case CMSG_ENABLE_NAGLE:
+            case CMSG_CONNECT_TO_FAILED:
+            case CMSG_ENTER_ENCRYPTED_MODE_ACK:
+            case CMSG_LOGOUT_REQUEST:
+                return false;
+            default:
+                break;
+        }
+
+        ClientOpcodeHandler const* handler = opcodeTable[OpcodeClient(opcode)];
+        if (!handler)
+            return false;
+
+        switch (handler->Status)
+        {
+            case STATUS_LOGGEDIN:
+            case STATUS_TRANSFER:
+            case STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    class PacketReplayEvent : public BasicEvent
+    {
+    public:
+        PacketReplayEvent(Player* player, std::vector<PacketReplayRecord>&& packets, uint32 speedPct)
+            : _player(player), _packets(std::move(packets)), _speedPct(speedPct), _nextPacket(0), _startTime(0) { }
+
+        bool Execute(uint64 eventTime, uint32 /*updateTime*/) override
+        {
+            if (!_startTime)
+                _startTime = eventTime;
+
+            uint64 elapsed = (eventTime - _startTime) * _speedPct / 100;
+            for (; _nextPacket < _packets.size() && _packets[_nextPacket].Time <= elapsed; ++_nextPacket)
+            {
+                PacketReplayRecord& record = _packets[_nextPacket];
+                WorldPacket packet(record.Opcode, record.Data.size(), ConnectionType(record.ConnectionType));
+                if (!record.Data.empty())
+                    packet.append(record.Data.data(), record.Data.size());
+
+                _player->GetSession()->QueuePacket(new ReceivedPacket(std::move(packet)));
+            }
+
+            if (_nextPacket < _packets.size())
+            {
+                uint64 delay = (_packets[_nextPacket].Time - elapsed) * 100 / _speedPct;
+                _player->m_Events.AddEvent(this, Milliseconds(eventTime + std::max<uint64>(delay, 1)));
+                return false;
+            }
+
+            ChatHandler(_player->GetSession()).PSendSysMessage("Packet replay finished: %u packets. World update time p50 %u ms, p95 %u ms, p99 %u ms",
+                uint32(_packets.size()), sWorldUpdateTime.GetUpdateTimePercentile(50), sWorldUpdateTime.GetUpdateTimePercentile(95),
+                sWorldUpdateTime.GetUpdateTimePercentile(99));
+            return true;
+        }
+
+    private:
+        Player* _player;
+        std::vector<PacketReplayRecord> _packets;
+        uint32 _speedPct;
+        std::size_t _nextPacket;
+        uint64 _startTime;
+    };
+}
+
+bool PacketReplay::LoadFile(std::string const& fileName, std::vector<PacketReplayRecord>& packets, std::string& error)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        error = "cannot open file";
+        return false;
+    }
+
+    std::vector<uint8> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteBuffer buffer(0, ByteBuffer::Reserve{});
+    buffer.append(content.data(), content.size());
+
+    try
+    {
+        // PKT 3.1 header, see PacketLog::Initialize
+        std::array<uint8, 3> signature;
+        buffer.read(signature);
+        uint16 formatVersion = buffer.read<uint16>();
+        if (signature != std::array<uint8, 3>{ 'P', 'K', 'T' } || formatVersion != 0x0301)
+        {
+            error = "not a PKT 3.1 file";
+            return false;
+        }
+
+        buffer.read_skip<uint8>();                  // SnifferId
+        buffer.read_skip<uint32>();                 // Build
+        buffer.read_skip(4);                        // Locale
+        buffer.read_skip(PKT_SESSION_KEY_SIZE);
+        buffer.read_skip<uint32>();                 // SniffStartUnixtime
+        buffer.read_skip<uint32>();                 // SniffStartTicks
+        buffer.read_skip(buffer.read<uint32>());    // OptionalData
+
+        Optional<uint32> firstTicks;
+        while (buffer.rpos() < buffer.size())
+        {
+            uint32 direction = buffer.read<uint32>();
+            uint32 connectionId = buffer.read<uint32>();
+            uint32 arrivalTicks = buffer.read<uint32>();
+            uint32 optionalDataSize = buffer.read<uint32>();
+            uint32 length = buffer.read<uint32>();
+            buffer.read_skip(optionalDataSize);
+            uint32 opcode = buffer.read<uint32>();
+            if (length < sizeof(opcode))
+            {
+                error = "invalid packet length";
+                return false;
+            }
+
+            std::size_t dataSize = length - sizeof(opcode);
+            if (direction == PKT_DIRECTION_CLIENT_TO_SERVER && CanReplay(opcode))
+            {
+                if (!firstTicks)
+                    firstTicks = arrivalTicks;
+
+                PacketReplayRecord& record = packets.emplace_back();
+                record.Time = arrivalTicks - *firstTicks;
+                record.Opcode = opcode;
+                record.ConnectionType = connectionId;
+                record.Data.resize(dataSize);
+                if (dataSize)
+                    buffer.read(record.Data.data(), dataSize);
+            }
+            else
+                buffer.read_skip(dataSize);
+        }
+    }
+    catch (ByteBufferException const&)
+    {
+        error = "truncated file";
+        return false;
+    }
+
+    return true;
+}
+
+void PacketReplay::Start(Player* player, std::vector<PacketReplayRecord> packets, uint32 speedPct)
+{
+    TC_LOG_INFO("misc", "PacketReplay::Start: replaying %u packets into %s at %u%% speed", uint32(packets.size()), player->GetName().c_str(), speedPct);
+    player->m_Events.AddEventAtOffset(new PacketReplayEvent(player, std::move(packets), std::max(speedPct, 1u)), 1ms);
+}
@@ -0,0 +1,47 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PACKETREPLAY_H
+#define TRINITY_PACKETREPLAY_H
+
+#include "Define.h"
+#include <string>
+#include <vector>
+
+class Player;
+
+struct PacketReplayRecord
+{
+    uint32 Time;                // milliseconds since the first replayed packet
+    uint32 Opcode;
+    uint32 ConnectionType;
+    std::vector<uint8> Data;
+};
+
+/// Replays client packets recorded by PacketLog (PacketLogFile) against a logged in player.
+/// Packets are queued into the player's session at their recorded offsets and go through the regular handlers,
+/// so recordings must come from the same character for guid based packets (movement, casts) to be accepted
+namespace PacketReplay
+{
+    /// Reads all client to server packets that can be replayed in world (login and socket level opcodes are skipped)
+    TC_GAME_API bool LoadFile(std::string const& fileName, std::vector<PacketReplayRecord>& packets, std::string& error);
+
+    /// speedPct scales the recorded delays, 200 replays twice as fast
+    TC_GAME_API void Start(Player* player, std::vector<PacketReplayRecord> packets, uint32 speedPct);
+}
+
+#endif // TRINITY_PACKETREPLAY_H
@@ -41,6 +41,7 @@
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "ObjectMgr.h"
+#include "OpcodeMetrics.h"
 #include "OutdoorPvPMgr.h"
 #include "PacketUtilities.h"
 #include "Player.h"
@@ -177,8 +178,13 @@ WorldSession::~WorldSession()
     delete _RBACData;
 
     ///- empty incoming packet queue
-    WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
+    for (WorldPacket* packet : _recvPending)
+        delete packet;
+
+    _recvPending.clear();
+
+    ReceivedPacket* packet = nullptr;
+    while (_recvQueue.Dequeue(packet))
         delete packet;
 
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
@@ -212,16 +218,36 @@ std::string WorldSession::GetPlayerInfo() const
 
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+{
+    ConnectionType conIdx;
+    if (!PrepareSendPacket(packet, forced, conIdx))
+        return;
+
+    m_Socket[conIdx]->SendPacket(*packet);
+}
+
+/// Send a packet to the client, handing its buffer over to the socket instead of copying it
+void WorldSession::SendPacket(WorldPacket&& packet, bool forced /*= false*/)
+{
+    ConnectionType conIdx;
+    if (!PrepareSendPacket(&packet, forced, conIdx))
+        return;
+
+    m_Socket[conIdx]->SendPacket(std::move(packet));
+}
+
+/// Validate an outgoing packet and select the connection it is sent on
+bool WorldSession::PrepareSendPacket(WorldPacket const* packet, bool forced, ConnectionType& conIdx)
 {
     if (packet->GetOpcode() == NULL_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of NULL_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
     else if (packet->GetOpcode() == UNKNOWN_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of UNKNOWN_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     ServerOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeServer>(packet->GetOpcode())];
@@ -229,11 +255,11 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     if (!handler)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of opcode %u with non existing handler to %s", packet->GetOpcode(), GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     // Default connection index defined in Opcodes.cpp table
-    ConnectionType conIdx = handler->ConnectionIndex;
+    conIdx = handler->ConnectionIndex;
 
     // Override connection index
     if (packet->GetConnection() != CONNECTION_TYPE_DEFAULT)
@@ -241,7 +267,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (packet->GetConnection() != CONNECTION_TYPE_INSTANCE && IsInstanceOnlyOpcode(packet->GetOpcode()))
         {
             TC_LOG_ERROR("network.opcode", "Prevented sending of instance only opcode %u with connection type %u to %s", packet->GetOpcode(), uint32(packet->GetConnection()), GetPlayerInfo().c_str());
-            return;
+            return false;
         }
 
         conIdx = packet->GetConnection();
@@ -250,7 +276,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     if (!m_Socket[conIdx])
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of %s to non existent socket %u to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str(), uint32(conIdx), GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     if (!forced)
@@ -258,7 +284,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (handler->Status == STATUS_UNHANDLED)
         {
             TC_LOG_ERROR("network.opcode", "Prevented sending disabled opcode %s to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str(), GetPlayerInfo().c_str());
-            return;
+            return false;
         }
     }
 
@@ -299,13 +325,28 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     sScriptMgr->OnPacketSend(this, *packet);
 
     TC_LOG_TRACE("network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())).c_str());
-    m_Socket[conIdx]->SendPacket(*packet);
+    return true;
 }
 
 /// Add an incoming packet to the queue
-void WorldSession::QueuePacket(WorldPacket* new_packet)
+void WorldSession::QueuePacket(ReceivedPacket* new_packet)
+{
+    _recvQueue.Enqueue(new_packet);
+}
+
+/// Take the next packet accepted by the filter, stops at the first packet that must be processed by another updater
+bool WorldSession::NextReceivedPacket(WorldPacket*& packet, PacketFilter& updater)
 {
-    _recvQueue.add(new_packet);
+    ReceivedPacket* received = nullptr;
+    while (_recvQueue.Dequeue(received))
+        _recvPending.push_back(received);
+
+    if (_recvPending.empty() || !updater.Process(_recvPending.front()))
+        return false;
+
+    packet = _recvPending.front();
+    _recvPending.pop_front();
+    return true;
 }
 
 /// Logging helper for unexpected opcodes
@@ -344,11 +385,12 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     uint32 processedPackets = 0;
     time_t currentTime = GameTime::GetGameTime();
 
-    while (m_Socket[CONNECTION_TYPE_REALM] && _recvQueue.next(packet, updater))
+    while (m_Socket[CONNECTION_TYPE_REALM] && NextReceivedPacket(packet, updater))
     {
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
         TC_METRIC_DETAILED_TIMER("worldsession_update_opcode_time", TC_METRIC_TAG("opcode", opHandle->Name));
+        TC_METRIC_OPCODE_TIMER(opcode, packet->size());
 
         try
         {
@@ -470,7 +512,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     TC_METRIC_VALUE("processed_packets", processedPackets);
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    _recvPending.insert(_recvPending.begin(), requeuePackets.begin(), requeuePackets.end());
 
     if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
     {
@@ -28,7 +28,7 @@
 #include "DatabaseEnvFwd.h"
 #include "Duration.h"
 #include "IteratorPair.h"
-#include "LockedQueue.h"
+#include "MPSCQueue.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
 #include "Packet.h"
@@ -36,6 +36,7 @@
 #include "SharedDefines.h"
 #include <boost/circular_buffer.hpp>
 #include <array>
+#include <deque>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -899,6 +900,18 @@ enum TutorialsFlag : uint8
     TUTORIALS_FLAG_LOADED_FROM_DB = 0x02
 };
 
+// incoming packet carrying the link used by WorldSession's lock free receive queue
+class ReceivedPacket : public WorldPacket
+{
+public:
+    explicit ReceivedPacket(WorldPacket&& packet) : WorldPacket(std::move(packet))
+    {
+        SessionQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    std::atomic<ReceivedPacket*> SessionQueueLink;
+};
+
 //class to deal with packet processing
 //allows to determine if next packet is safe to be processed
 class PacketFilter
@@ -965,6 +978,7 @@ class TC_GAME_API WorldSession
         bool IsAddonRegistered(std::string_view prefix) const;
 
         void SendPacket(WorldPacket const* packet, bool forced = false);
+        void SendPacket(WorldPacket&& packet, bool forced = false);
         void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) { m_Socket[CONNECTION_TYPE_INSTANCE] = sock; }
 
         void SendNotification(char const* format, ...) ATTR_PRINTF(2, 3);
@@ -1036,7 +1050,7 @@ class TC_GAME_API WorldSession
         // May kick player on false depending on world config (handler should abort)
         bool DisallowHyperlinksAndMaybeKick(std::string const& str);
 
-        void QueuePacket(WorldPacket* new_packet);
+        void QueuePacket(ReceivedPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
 
         /// Handle the authentication waiting queue (to be completed)
@@ -1837,6 +1851,7 @@ class TC_GAME_API WorldSession
 
     private:
         void ProcessQueryCallbacks();
+        bool PrepareSendPacket(WorldPacket const* packet, bool forced, ConnectionType& conIdx);
 
         QueryCallbackProcessor _queryProcessor;
         AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
@@ -1881,6 +1896,8 @@ class TC_GAME_API WorldSession
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char *reason);
 
+        bool NextReceivedPacket(WorldPacket*& packet, PacketFilter& updater);
+
         // EnumData helpers
         bool IsLegitCharacterForAccount(ObjectGuid lowGUID)
         {
@@ -1929,7 +1946,10 @@ class TC_GAME_API WorldSession
         bool _filterAddonMessages;
         uint32 recruiterId;
         bool isRecruiter;
-        LockedQueue<WorldPacket*> _recvQueue;
+        // filled by network threads, only drained by the thread currently updating the session (World::UpdateSessions or Map::Update)
+        MPSCQueue<ReceivedPacket, &ReceivedPacket::SessionQueueLink> _recvQueue;
+        // packets moved out of _recvQueue but not processed yet, in arrival order - owned by the updating thread
+        std::deque<WorldPacket*> _recvPending;
         rbac::RBACData* _RBACData;
         uint32 expireTime;
         bool forceExit;
@@ -24,8 +24,10 @@
 #include "DatabaseEnv.h"
 #include "Errors.h"
 #include "GameTime.h"
+#include "IpBanCache.h"
 #include "HMAC.h"
 #include "IPLocation.h"
+#include "ObjectGuid.h"
 #include "PacketLog.h"
 #include "RealmList.h"
 #include "RBAC.h"
@@ -35,6 +37,8 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include <cstddef>
+#include <set>
 #include <zlib.h>
 
 #pragma pack(push, 1)
@@ -53,6 +57,8 @@ using boost::asio::ip::tcp;
 std::string const WorldSocket::ServerConnectionInitialize("WORLD OF WARCRAFT CONNECTION - SERVER TO CLIENT - V2");
 std::string const WorldSocket::ClientConnectionInitialize("WORLD OF WARCRAFT CONNECTION - CLIENT TO SERVER - V2");
 uint32 const WorldSocket::MinSizeForCompression = 0x400;
+std::size_t const WorldSocket::MaxPooledPackets = 64;
+std::size_t const WorldSocket::MaxPooledPacketCapacity = 0x1000;
 
 uint8 const WorldSocket::AuthCheckSeed[16] = { 0xC5, 0xC6, 0x98, 0x95, 0x76, 0x3F, 0x1D, 0xCD, 0xB6, 0xA1, 0x37, 0x28, 0xB3, 0x12, 0xFF, 0x8A };
 uint8 const WorldSocket::SessionKeySeed[16] = { 0x58, 0xCB, 0xCF, 0x40, 0xFE, 0x2E, 0xCE, 0xA6, 0x5A, 0x90, 0xB8, 0x01, 0x68, 0x6C, 0x28, 0x0B };
@@ -61,7 +67,8 @@ uint8 const WorldSocket::EncryptionKeySeed[16] = { 0xE9, 0x75, 0x3C, 0x50, 0x90,
 
 WorldSocket::WorldSocket(tcp::socket&& socket) : Socket(std::move(socket)),
     _type(CONNECTION_TYPE_REALM), _key(0), _OverSpeedPings(0),
-    _worldSession(nullptr), _authed(false), _canRequestHotfixes(true), _sendBufferSize(4096), _compressionStream(nullptr)
+    _worldSession(nullptr), _authed(false), _canRequestHotfixes(true), _bufferQueueBytes(0),
+    _congestionThreshold(0), _maxQueuedBytes(0), _congested(false), _sendBufferSize(4096), _compressionStream(nullptr)
 {
     Trinity::Crypto::GetRandomBytes(_serverChallenge);
     _sessionKey.fill(0);
@@ -71,6 +78,9 @@ WorldSocket::WorldSocket(tcp::socket&& socket) : Socket(std::move(socket)),
 
 WorldSocket::~WorldSocket()
 {
+    for (EncryptablePacket* packet : _packetPool)
+        delete packet;
+
     if (_compressionStream)
     {
         deflateEnd(_compressionStream);
@@ -81,6 +91,12 @@ WorldSocket::~WorldSocket()
 void WorldSocket::Start()
 {
     std::string ip_address = GetRemoteIpAddress().to_string();
+    if (sIpBanCache->IsEnabled())
+    {
+        HandleIpBanCheck(sIpBanCache->IsBanned(ip_address));
+        return;
+    }
+
     LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_INFO);
     stmt->setString(0, ip_address);
 
@@ -89,9 +105,9 @@ void WorldSocket::Start()
 
 void WorldSocket::CheckIpCallback(PreparedQueryResult result)
 {
+    bool banned = false;
     if (result)
     {
-        bool banned = false;
         do
         {
             Field* fields = result->Fetch();
@@ -99,13 +115,18 @@ void WorldSocket::CheckIpCallback(PreparedQueryResult result)
                 banned = true;
 
         } while (result->NextRow());
+    }
 
-        if (banned)
-        {
-            TC_LOG_ERROR("network", "WorldSocket::CheckIpCallback: Sent Auth Response (IP %s banned).", GetRemoteIpAddress().to_string().c_str());
-            DelayedCloseSocket();
-            return;
-        }
+    HandleIpBanCheck(banned);
+}
+
+void WorldSocket::HandleIpBanCheck(bool banned)
+{
+    if (banned)
+    {
+        TC_LOG_ERROR("network", "WorldSocket::HandleIpBanCheck: Sent Auth Response (IP %s banned).", GetRemoteIpAddress().to_string().c_str());
+        DelayedCloseSocket();
+        return;
     }
 
     _packetBuffer.Resize(ClientConnectionInitialize.length() + 1);
@@ -199,40 +220,146 @@ void WorldSocket::InitializeHandler(boost::system::error_code error, std::size_t
 }
 
 bool WorldSocket::Update()
+{
+    if (_maxQueuedBytes && GetQueuedBytes() > _maxQueuedBytes)
+    {
+        TC_LOG_ERROR("network", "WorldSocket::Update: %s has %u unsent bytes (limit %u), closing connection",
+            GetRemoteIpAddress().to_string().c_str(), uint32(GetQueuedBytes()), uint32(_maxQueuedBytes));
+        return false;
+    }
+
+    // While the client is not keeping up new packets stay unencrypted in _bufferQueue,
+    // once the backlog is gone stale state in there is coalesced before sending
+    if (_congestionThreshold && GetWriteQueueSize() >= _congestionThreshold)
+        _congested = true;
+    else if (!SendQueuedPackets(std::exchange(_congested, false)))
+        return false;
+
+    if (!BaseSocket::Update())
+        return false;
+
+    _queryProcessor.ProcessReadyCallbacks();
+
+    return true;
+}
+
+bool WorldSocket::SendQueuedPackets(bool coalesce)
 {
     EncryptablePacket* queued;
-    MessageBuffer buffer(_sendBufferSize);
     while (_bufferQueue.Dequeue(queued))
     {
+        _bufferQueueBytes -= queued->size();
+        _sendQueue.push_back(queued);
+    }
+
+    if (coalesce)
+        CoalesceSendQueue();
+
+    auto abort = [this](std::size_t index)
+    {
+        for (; index < _sendQueue.size(); ++index)
+            if (_sendQueue[index])
+                ReleasePacket(_sendQueue[index]);
+
+        _sendQueue.clear();
+        return false;
+    };
+
+    MessageBuffer buffer = MessageBuffer::FromPool(_sendBufferSize);
+    for (std::size_t i = 0; i < _sendQueue.size(); ++i)
+    {
+        queued = _sendQueue[i];
+        if (!queued)
+            continue;
+
         uint32 packetSize = queued->size();
         if (packetSize > MinSizeForCompression && queued->NeedsEncryption())
             packetSize = compressBound(packetSize) + sizeof(CompressedWorldPacket);
 
         if (buffer.GetRemainingSpace() < packetSize + sizeof(PacketHeader))
         {
+            if (!EncryptPendingPackets())
+                return abort(i);
+
             QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
+            buffer = MessageBuffer::FromPool(_sendBufferSize);
         }
 
         if (buffer.GetRemainingSpace() >= packetSize + sizeof(PacketHeader))
             WritePacketToBuffer(*queued, buffer);
         else    // single packet larger than 4096 bytes
         {
-            MessageBuffer packetBuffer(packetSize + sizeof(PacketHeader));
+            MessageBuffer packetBuffer = MessageBuffer::FromPool(packetSize + sizeof(PacketHeader));
             WritePacketToBuffer(*queued, packetBuffer);
+            if (!EncryptPendingPackets())
+                return abort(i);
+
             QueuePacket(std::move(packetBuffer));
         }
 
-        delete queued;
+        ReleasePacket(queued);
     }
 
+    _sendQueue.clear();
+
+    if (!EncryptPendingPackets())
+        return false;
+
     if (buffer.GetActiveSize() > 0)
         QueuePacket(std::move(buffer));
+    else
+        buffer.ReturnToPool();
 
-    if (!BaseSocket::Update())
-        return false;
+    return true;
+}
 
-    _queryProcessor.ProcessReadyCallbacks();
+void WorldSocket::CoalesceSendQueue()
+{
+    std::set<std::pair<uint16, ObjectGuid>> newestUpdates;
+    uint32 dropped = 0;
+    for (auto itr = _sendQueue.rbegin(); itr != _sendQueue.rend(); ++itr)
+    {
+        EncryptablePacket* packet = *itr;
+        switch (packet->GetOpcode())
+        {
+            case SMSG_HEALTH_UPDATE:
+            case SMSG_MOVE_UPDATE:
+                break;
+            default:
+                continue;
+        }
+
+        // both start with the guid of the unit they describe
+        ObjectGuid guid;
+        packet->rpos(0);
+        *packet >> guid;
+        packet->rpos(0);
+
+        if (!newestUpdates.emplace(packet->GetOpcode(), guid).second)
+        {
+            ReleasePacket(packet);
+            *itr = nullptr;
+            ++dropped;
+        }
+    }
+
+    if (dropped)
+        TC_LOG_DEBUG("network", "WorldSocket::CoalesceSendQueue: %s dropped %u superseded packets after congestion", GetRemoteIpAddress().to_string().c_str(), dropped);
+}
+
+bool WorldSocket::EncryptPendingPackets()
+{
+    if (_pendingEncryption.empty())
+        return true;
+
+    bool encrypted = _authCrypt.EncryptSend(_pendingEncryption.data(), _pendingEncryption.size());
+    _pendingEncryption.clear();
+    if (!encrypted)
+    {
+        TC_LOG_ERROR("network", "WorldSocket::EncryptPendingPackets(): failed to encrypt packets for client %s", GetRemoteIpAddress().to_string().c_str());
+        CloseSocket();
+        return false;
+    }
 
     return true;
 }
@@ -491,7 +618,7 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
             _worldSession->ResetTimeOutTime(false);
 
             // Copy the packet to the heap before enqueuing
-            _worldSession->QueuePacket(new WorldPacket(std::move(packet)));
+            _worldSession->QueuePacket(new ReceivedPacket(std::move(packet)));
             break;
         }
     }
@@ -526,7 +653,59 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
 
-    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+    _bufferQueueBytes += packet.size();
+    _bufferQueue.Enqueue(AcquirePacket(packet));
+}
+
+void WorldSocket::SendPacket(WorldPacket&& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
+
+    _bufferQueueBytes += packet.size();
+    _bufferQueue.Enqueue(AcquirePacket(std::move(packet)));
+}
+
+template<typename PacketType>
+EncryptablePacket* WorldSocket::AcquirePacket(PacketType&& packet)
+{
+    EncryptablePacket* pooled = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_packetPoolLock);
+        if (!_packetPool.empty())
+        {
+            pooled = _packetPool.back();
+            _packetPool.pop_back();
+        }
+    }
+
+    if (!pooled)
+        return new EncryptablePacket(std::forward<PacketType>(packet), _authCrypt.IsInitialized());
+
+    pooled->Reset(std::forward<PacketType>(packet), _authCrypt.IsInitialized());
+    return pooled;
+}
+
+void WorldSocket::ReleasePacket(EncryptablePacket* packet)
+{
+    // don't let a single large packet pin its buffer for the lifetime of the connection
+    packet->clear();
+    if (packet->capacity() > MaxPooledPacketCapacity)
+        packet->shrink_to_fit();
+
+    {
+        std::lock_guard<std::mutex> lock(_packetPoolLock);
+        if (_packetPool.size() < MaxPooledPackets)
+        {
+            _packetPool.push_back(packet);
+            return;
+        }
+    }
+
+    delete packet;
 }
 
 void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
@@ -566,11 +745,12 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     memcpy(dataPos, &opcode, sizeof(opcode));
     packetSize += 2 /*opcode*/;
 
+    // the tag is filled in by EncryptPendingPackets, together with the other packets of this update
     PacketHeader header;
     header.Size = packetSize;
-    _authCrypt.EncryptSend(dataPos, header.Size, header.Tag);
-
     memcpy(headerPos, &header, sizeof(PacketHeader));
+
+    _pendingEncryption.push_back({ dataPos, packetSize, headerPos + offsetof(PacketHeader, Tag) });
 }
 
 uint32 WorldSocket::CompressPacket(uint8* buffer, WorldPacket const& packet)
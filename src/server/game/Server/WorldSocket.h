@@ -28,9 +28,11 @@
 #include "WorldPacketCrypt.h"
 #include "MPSCQueue.h"
 #include <array>
+#include <atomic>
 #include <boost/asio/ip/tcp.hpp>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 typedef struct z_stream_s z_stream;
 class EncryptablePacket;
@@ -47,6 +49,26 @@ public:
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    EncryptablePacket(WorldPacket&& packet, bool encrypt) : WorldPacket(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    /// reuses this packet (and its buffer capacity) for another outgoing packet
+    void Reset(WorldPacket const& packet, bool encrypt)
+    {
+        WorldPacket::operator=(packet);
+        _encrypt = encrypt;
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    void Reset(WorldPacket&& packet, bool encrypt)
+    {
+        WorldPacket::operator=(std::move(packet));
+        _encrypt = encrypt;
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
     bool NeedsEncryption() const { return _encrypt; }
 
     std::atomic<EncryptablePacket*> SocketQueueLink;
@@ -89,6 +111,8 @@ class TC_GAME_API WorldSocket : public Socket<WorldSocket>
     static std::string const ServerConnectionInitialize;
     static std::string const ClientConnectionInitialize;
     static uint32 const MinSizeForCompression;
+    static std::size_t const MaxPooledPackets;
+    static std::size_t const MaxPooledPacketCapacity;
 
     static uint8 const AuthCheckSeed[16];
     static uint8 const SessionKeySeed[16];
@@ -108,12 +132,22 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(WorldPacket&& packet);
 
     ConnectionType GetConnectionType() const { return _type; }
 
     void SendAuthResponseError(uint32 code);
     void SetWorldSession(WorldSession* session);
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
+    /// congestionThreshold: unsent bytes above which new packets are held back and coalesced, 0 disables
+    /// maxQueuedBytes: unsent bytes (including held back packets) above which the connection is dropped, 0 disables
+    void SetWriteQueueLimits(std::size_t congestionThreshold, std::size_t maxQueuedBytes)
+    {
+        _congestionThreshold = congestionThreshold;
+        _maxQueuedBytes = maxQueuedBytes;
+    }
+
+    std::size_t GetQueuedBytes() const { return BaseSocket::GetQueuedBytes() + _bufferQueueBytes; }
 
 protected:
     void OnClose() override;
@@ -130,6 +164,7 @@ protected:
     ReadDataHandlerResult ReadDataHandler();
 private:
     void CheckIpCallback(PreparedQueryResult result);
+    void HandleIpBanCheck(bool banned);
     void InitializeHandler(boost::system::error_code error, std::size_t transferedBytes);
 
     /// writes network.opcode log
@@ -137,9 +172,19 @@ private:
     void LogOpcodeText(OpcodeClient opcode, std::unique_lock<std::mutex> const& guard) const;
     /// sends and logs network.opcode without accessing WorldSession
     void SendPacketAndLogOpcode(WorldPacket const& packet);
+    bool SendQueuedPackets(bool coalesce);
+    /// drops health and movement updates that are superseded by a newer one for the same unit in _sendQueue
+    void CoalesceSendQueue();
     void WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
+    /// encrypts all packets written since the last call, must be done before their buffer is queued
+    bool EncryptPendingPackets();
     uint32 CompressPacket(uint8* buffer, WorldPacket const& packet);
 
+    /// packets in _bufferQueue are recycled instead of being allocated for every SendPacket call
+    template<typename PacketType>
+    EncryptablePacket* AcquirePacket(PacketType&& packet);
+    void ReleasePacket(EncryptablePacket* packet);
+
     void HandleSendAuthSession();
     void HandleAuthSession(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession);
     void HandleAuthSessionCallback(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession, PreparedQueryResult result);
@@ -169,6 +214,14 @@ private:
     MessageBuffer _headerBuffer;
     MessageBuffer _packetBuffer;
     MPSCQueue<EncryptablePacket, &EncryptablePacket::SocketQueueLink> _bufferQueue;
+    std::atomic<std::size_t> _bufferQueueBytes;
+    std::vector<EncryptablePacket*> _sendQueue;
+    std::mutex _packetPoolLock;
+    std::vector<EncryptablePacket*> _packetPool;
+    std::size_t _congestionThreshold;
+    std::size_t _maxQueuedBytes;
+    bool _congested;
+    std::vector<WorldPacketCrypt::SendRequest> _pendingEncryption;
     std::size_t _sendBufferSize;
 
     z_stream* _compressionStream;
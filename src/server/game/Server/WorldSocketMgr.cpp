@@ -33,6 +33,8 @@ public:
     void SocketAdded(std::shared_ptr<WorldSocket> sock) override
     {
         sock->SetSendBufferSize(sWorldSocketMgr.GetApplicationSendBufferSize());
+        sock->SetMaxGatheredWriteBuffers(sWorldSocketMgr.GetMaxGatheredWriteBuffers());
+        sock->SetWriteQueueLimits(sWorldSocketMgr.GetCongestionThreshold(), sWorldSocketMgr.GetMaxQueuedBytes());
         sScriptMgr->OnSocketOpen(sock);
     }
 
@@ -42,7 +44,8 @@ public:
     }
 };
 
-WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true)
+WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536),
+    _socketMaxGatheredWriteBuffers(DEFAULT_MAX_GATHERED_WRITE_BUFFERS), _socketCongestionThreshold(0), _socketMaxQueuedBytes(0), _tcpNoDelay(true)
 {
 }
 
@@ -75,6 +78,20 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
         return false;
     }
 
+    _socketMaxGatheredWriteBuffers = sConfigMgr->GetIntDefault("Network.MaxGatheredWriteBuffers", DEFAULT_MAX_GATHERED_WRITE_BUFFERS);
+
+    if (_socketMaxGatheredWriteBuffers <= 0)
+    {
+        TC_LOG_ERROR("misc", "Network.MaxGatheredWriteBuffers is wrong in your config file");
+        return false;
+    }
+
+    _socketCongestionThreshold = std::max(sConfigMgr->GetIntDefault("Network.CongestionThreshold", 262144), 0);
+    _socketMaxQueuedBytes = std::max(sConfigMgr->GetIntDefault("Network.MaxQueuedBytes", 0), 0);
+
+    SetAcceptorPerThread(sConfigMgr->GetBoolDefault("Network.AcceptorPerThread", false));
+    SetLoadAwareThreadSelection(sConfigMgr->GetBoolDefault("Network.LoadAwareThreadSelection", false));
+
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
@@ -100,7 +117,7 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
 
     _instanceAcceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
 
-    _acceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
+    AsyncAcceptWithCallback<&OnSocketAccept>();
     _instanceAcceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
 
     sScriptMgr->OnNetworkStart();
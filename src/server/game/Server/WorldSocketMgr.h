@@ -47,6 +47,9 @@ public:
     void OnSocketOpen(tcp::socket&& sock, uint32 threadIndex) override;
 
     std::size_t GetApplicationSendBufferSize() const { return _socketApplicationSendBufferSize; }
+    std::size_t GetMaxGatheredWriteBuffers() const { return _socketMaxGatheredWriteBuffers; }
+    std::size_t GetCongestionThreshold() const { return _socketCongestionThreshold; }
+    std::size_t GetMaxQueuedBytes() const { return _socketMaxQueuedBytes; }
 
 protected:
     WorldSocketMgr();
@@ -63,6 +66,9 @@ private:
     AsyncAcceptor* _instanceAcceptor;
     int32 _socketSystemSendBufferSize;
     int32 _socketApplicationSendBufferSize;
+    int32 _socketMaxGatheredWriteBuffers;
+    int32 _socketCongestionThreshold;
+    int32 _socketMaxQueuedBytes;
     bool _tcpNoDelay;
 };
 
@@ -850,6 +850,17 @@ void AuraEffect::CalculateSpellMod()
     GetBase()->CallScriptEffectCalcSpellModHandlers(this, m_spellmod);
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    // amount is summed up in cached aura modifiers of every target this effect is applied to
+    if (_amount != amount)
+        for (auto const& [guid, aurApp] : GetBase()->GetApplicationMap())
+            aurApp->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+
+    _amount = amount;
+    m_canBeRecalculated = false;
+}
+
 void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply, AuraEffect const* triggeredBy /* = nullptr */)
 {
     // Reapply if amount change
@@ -3366,6 +3377,7 @@ void AuraEffect::HandleAuraModStat(AuraApplication const* aurApp, uint8 mode, bo
     if (std::abs(spellGroupVal) >= std::abs(GetAmount()))
         return;
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         // -1 or -2 is all stats (misc < -2 checked in function beginning)
@@ -3383,6 +3395,7 @@ void AuraEffect::HandleAuraModStat(AuraApplication const* aurApp, uint8 mode, bo
                 target->UpdateStatBuffMod(Stats(i));
         }
     }
+    target->EndStatUpdateBatch();
 }
 
 void AuraEffect::HandleModPercentStat(AuraApplication const* aurApp, uint8 mode, bool apply) const
@@ -3402,6 +3415,7 @@ void AuraEffect::HandleModPercentStat(AuraApplication const* aurApp, uint8 mode,
     if (target->GetTypeId() != TYPEID_PLAYER)
         return;
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if (GetMiscValue() == i || GetMiscValue() == -1)
@@ -3420,6 +3434,7 @@ void AuraEffect::HandleModPercentStat(AuraApplication const* aurApp, uint8 mode,
             }
         }
     }
+    target->EndStatUpdateBatch();
 }
 
 void AuraEffect::HandleModSpellDamagePercentFromStat(AuraApplication const* aurApp, uint8 mode, bool /*apply*/) const
@@ -3492,6 +3507,7 @@ void AuraEffect::HandleModTotalPercentStat(AuraApplication const* aurApp, uint8
     if (target->getDeathState() == CORPSE)
         zeroHealth = (target->GetHealth() == 0);
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if (GetMiscValueB() & 1 << i || !GetMiscValueB()) // 0 is also used for all stats
@@ -3511,6 +3527,7 @@ void AuraEffect::HandleModTotalPercentStat(AuraApplication const* aurApp, uint8
                 target->UpdateStatBuffMod(Stats(i));
         }
     }
+    target->EndStatUpdateBatch();
 
     // recalculate current HP/MP after applying aura modifications (only for spells with SPELL_ATTR0_ABILITY 0x00000010 flag)
     // this check is total bullshit i think
@@ -3571,6 +3588,7 @@ void AuraEffect::HandleModStatBonusPercent(AuraApplication const* aurApp, uint8
     if (target->GetTypeId() != TYPEID_PLAYER)
         return;
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if (GetMiscValue() == i || GetMiscValue() == -1)
@@ -3579,6 +3597,7 @@ void AuraEffect::HandleModStatBonusPercent(AuraApplication const* aurApp, uint8
             target->UpdateStatBuffMod(Stats(i));
         }
     }
+    target->EndStatUpdateBatch();
 }
 
 void AuraEffect::HandleOverrideSpellPowerByAttackPower(AuraApplication const* aurApp, uint8 mode, bool apply) const
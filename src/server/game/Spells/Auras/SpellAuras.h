@@ -20,6 +20,7 @@
 
 #include "SpellAuraDefines.h"
 #include "SpellInfo.h"
+#include "TransientObjectPool.h"
 #include <typeinfo>
 
 class SpellInfo;
@@ -134,6 +135,8 @@ class TC_GAME_API Aura
         void SaveCasterInfo(Unit* caster);
         virtual ~Aura();
 
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
         SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
         uint32 GetId() const{ return GetSpellInfo()->Id; }
         Difficulty GetCastDifficulty() const { return m_castDifficulty; }
@@ -510,6 +510,47 @@ protected:
     Spell* m_Spell;
 };
 
+namespace
+{
+    // Target containers of destroyed spells are kept per thread and handed to the next spells created on it,
+    // so spells hitting a few targets (periodic triggers, channel ticks) do not allocate them every cast
+    constexpr std::size_t MaxCachedTargetContainers = 64;
+    constexpr std::size_t MaxCachedTargetContainerCapacity = 32;
+
+    template<class TargetInfoType>
+    std::vector<std::vector<TargetInfoType>>& GetTargetContainerCache()
+    {
+        static thread_local std::vector<std::vector<TargetInfoType>> cache;
+        return cache;
+    }
+
+    template<class TargetInfoType>
+    void AcquireTargetContainer(std::vector<TargetInfoType>& container)
+    {
+        std::vector<std::vector<TargetInfoType>>& cache = GetTargetContainerCache<TargetInfoType>();
+        if (cache.empty())
+            return;
+
+        container = std::move(cache.back());
+        cache.pop_back();
+    }
+
+    template<class TargetInfoType>
+    void ReleaseTargetContainer(std::vector<TargetInfoType>& container)
+    {
+        // large AoE containers are not kept, they would hold their memory forever
+        if (!container.capacity() || container.capacity() > MaxCachedTargetContainerCapacity)
+            return;
+
+        std::vector<std::vector<TargetInfoType>>& cache = GetTargetContainerCache<TargetInfoType>();
+        if (cache.size() >= MaxCachedTargetContainers)
+            return;
+
+        container.clear();
+        cache.push_back(std::move(container));
+    }
+}
+
 Spell::Spell(WorldObject* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID /*= ObjectGuid::Empty*/,
     ObjectGuid originalCastId /*= ObjectGuid::Empty*/) :
 m_spellInfo(info), m_caster((info->HasAttribute(SPELL_ATTR6_CAST_BY_CHARMER) && caster->GetCharmerOrOwner()) ? caster->GetCharmerOrOwner() : caster),
@@ -615,6 +656,11 @@ m_spellValue(new SpellValue(m_spellInfo, caster)), _spellEvent(nullptr)
         && !m_spellInfo->HasAttribute(SPELL_ATTR1_CANT_BE_REFLECTED) && !m_spellInfo->HasAttribute(SPELL_ATTR0_UNAFFECTED_BY_INVULNERABILITY)
         && !m_spellInfo->IsPassive();
 
+    AcquireTargetContainer(m_UniqueTargetInfo);
+    AcquireTargetContainer(m_UniqueGOTargetInfo);
+    AcquireTargetContainer(m_UniqueItemInfo);
+    AcquireTargetContainer(m_UniqueCorpseTargetInfo);
+
     CleanupTargetList();
 
     for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
@@ -642,6 +688,11 @@ Spell::~Spell()
         ASSERT(m_caster->ToPlayer()->m_spellModTakingSpell != this);
 
     delete m_spellValue;
+
+    ReleaseTargetContainer(m_UniqueTargetInfo);
+    ReleaseTargetContainer(m_UniqueGOTargetInfo);
+    ReleaseTargetContainer(m_UniqueItemInfo);
+    ReleaseTargetContainer(m_UniqueCorpseTargetInfo);
 }
 
 void Spell::InitExplicitTargets(SpellCastTargets const& targets)
@@ -1997,10 +2048,6 @@ void Spell::SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject*
         x = pos->GetPositionX();
         y = pos->GetPositionY();
 
-        CellCoord p(Trinity::ComputeCellCoord(x, y));
-        Cell cell(p);
-        cell.SetNoCreate();
-
         Map* map = referer->GetMap();
 
         if (searchInWorld)
@@ -2094,17 +2141,29 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
         // get unit with highest hp deficit in dist
         if (isChainHeal)
         {
-            uint32 maxHPDeficit = 0;
+            // every unit in jump range is a candidate, check their line of sight as one batch
+            std::vector<std::list<WorldObject*>::iterator> candidates;
+            std::vector<WorldObject const*> candidateObjects;
             for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
             {
-                if (Unit* unit = (*itr)->ToUnit())
+                if ((*itr)->IsUnit() && target->IsWithinDist(*itr, jumpRadius))
                 {
-                    uint32 deficit = unit->GetMaxHealth() - unit->GetHealth();
-                    if ((deficit > maxHPDeficit || foundItr == tempTargets.end()) && target->IsWithinDist(unit, jumpRadius) && target->IsWithinLOSInMap(unit, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2))
-                    {
-                        foundItr = itr;
-                        maxHPDeficit = deficit;
-                    }
+                    candidates.push_back(itr);
+                    candidateObjects.push_back(*itr);
+                }
+            }
+
+            std::vector<bool> inLineOfSight = target->IsWithinLOSInMap(candidateObjects, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2);
+
+            uint32 maxHPDeficit = 0;
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                Unit* unit = (*candidates[i])->ToUnit();
+                uint32 deficit = unit->GetMaxHealth() - unit->GetHealth();
+                if ((deficit > maxHPDeficit || foundItr == tempTargets.end()) && inLineOfSight[i])
+                {
+                    foundItr = candidates[i];
+                    maxHPDeficit = deficit;
                 }
             }
         }
@@ -8721,21 +8780,19 @@ WorldObjectSpellAreaTargetCheck::WorldObjectSpellAreaTargetCheck(float range, Po
     WorldObject* referer, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList, SpellTargetObjectTypes objectType)
     : WorldObjectSpellTargetCheck(caster, referer, spellInfo, selectionType, condList, objectType), _range(range), _position(position) { }
 
+bool WorldObjectSpellAreaTargetCheck::IsInArea(WorldObject* target) const
+{
+    // isInRange including the dimension of the GO
+    if (GameObject* gameObjectTarget = target->ToGameObject())
+        return gameObjectTarget->IsInRange(_position->GetPositionX(), _position->GetPositionY(), _position->GetPositionZ(), _range);
+
+    return target->IsWithinDist2d(_position, _range) && std::abs(target->GetPositionZ() - _position->GetPositionZ()) <= _range;
+}
+
 bool WorldObjectSpellAreaTargetCheck::operator()(WorldObject* target) const
 {
-    if (target->ToGameObject())
-    {
-        // isInRange including the dimension of the GO
-        bool isInRange = target->ToGameObject()->IsInRange(_position->GetPositionX(), _position->GetPositionY(), _position->GetPositionZ(), _range);
-        if (!isInRange)
-            return false;
-    }
-    else
-    {
-        bool isInsideCylinder = target->IsWithinDist2d(_position, _range) && std::abs(target->GetPositionZ() - _position->GetPositionZ()) <= _range;
-        if (!isInsideCylinder)
-            return false;
-    }
+    if (!IsInArea(target))
+        return false;
 
     return WorldObjectSpellTargetCheck::operator ()(target);
 }
@@ -8746,6 +8803,10 @@ WorldObjectSpellConeTargetCheck::WorldObjectSpellConeTargetCheck(Position const&
 
 bool WorldObjectSpellConeTargetCheck::operator()(WorldObject* target) const
 {
+    // most candidates from the visited cells are outside of the radius, reject them before any angle math
+    if (!IsInArea(target))
+        return false;
+
     if (_spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_BACK))
     {
         if (_coneSrc.HasInArc(-std::abs(_coneAngle), target))
@@ -8764,7 +8825,7 @@ bool WorldObjectSpellConeTargetCheck::operator()(WorldObject* target) const
             if (_coneSrc.HasInArc(_coneAngle, target) != G3D::fuzzyGe(_coneAngle, 0.f))
                 return false;
     }
-    return WorldObjectSpellAreaTargetCheck::operator ()(target);
+    return WorldObjectSpellTargetCheck::operator ()(target);
 }
 
 WorldObjectSpellTrajTargetCheck::WorldObjectSpellTrajTargetCheck(float range, Position const* position, WorldObject* caster, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList, SpellTargetObjectTypes objectType)
@@ -8772,11 +8833,11 @@ WorldObjectSpellTrajTargetCheck::WorldObjectSpellTrajTargetCheck(float range, Po
 
 bool WorldObjectSpellTrajTargetCheck::operator()(WorldObject* target) const
 {
-    // return all targets on missile trajectory (0 - size of a missile)
-    if (!_caster->HasInLine(target, target->GetCombatReach(), TRAJECTORY_MISSILE_SIZE))
+    if (target->GetExactDist2dSq(_position) > _range * _range)
         return false;
 
-    if (target->GetExactDist2d(_position) > _range)
+    // return all targets on missile trajectory (0 - size of a missile)
+    if (!_caster->HasInLine(target, target->GetCombatReach(), TRAJECTORY_MISSILE_SIZE))
         return false;
 
     return WorldObjectSpellTargetCheck::operator ()(target);
@@ -151,7 +151,7 @@ void SpellHistory::LoadFromDB(PreparedQueryResult cooldownsResult, PreparedQuery
             {
                 _spellCooldowns[spellId] = cooldown;
                 if (cooldown.CategoryId)
-                    _categoryCooldowns[cooldown.CategoryId] = &_spellCooldowns[spellId];
+                    _categoryCooldowns[cooldown.CategoryId] = spellId;
             }
 
         } while (cooldownsResult->NextRow());
@@ -176,6 +176,9 @@ void SpellHistory::SaveToDB(CharacterDatabaseTransaction trans)
 {
     using StatementInfo = PersistenceHelper<OwnerType>;
 
+    // entries that already expired would only be erased again by the first Update() after loading
+    Clock::time_point now = GameTime::GetTime<Clock>();
+
     uint8 index = 0;
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(StatementInfo::CooldownsDeleteStatement);
     StatementInfo::SetIdentifier(stmt, index++, _owner);
@@ -183,7 +186,7 @@ void SpellHistory::SaveToDB(CharacterDatabaseTransaction trans)
 
     for (auto const& p : _spellCooldowns)
     {
-        if (!p.second.OnHold)
+        if (!p.second.OnHold && p.second.CooldownEnd >= now)
         {
             index = 0;
             stmt = CharacterDatabase.GetPreparedStatement(StatementInfo::CooldownsInsertStatement);
@@ -201,6 +204,9 @@ void SpellHistory::SaveToDB(CharacterDatabaseTransaction trans)
     {
         for (ChargeEntry const& charge : p.second)
         {
+            if (charge.RechargeEnd <= now)
+                continue;
+
             index = 0;
             stmt = CharacterDatabase.GetPreparedStatement(StatementInfo::ChargesInsertStatement);
             StatementInfo::SetIdentifier(stmt, index++, _owner);
@@ -215,7 +221,8 @@ void SpellHistory::Update()
     Clock::time_point now = GameTime::GetTime<Clock>();
     for (auto itr = _categoryCooldowns.begin(); itr != _categoryCooldowns.end();)
     {
-        if (itr->second->CategoryEnd < now)
+        CooldownEntry const* cooldownEntry = GetCategoryCooldown(itr);
+        if (!cooldownEntry || cooldownEntry->CategoryEnd < now)
             itr = _categoryCooldowns.erase(itr);
         else
             ++itr;
@@ -231,9 +238,11 @@ void SpellHistory::Update()
 
     for (auto& p : _categoryCharges)
     {
-        std::deque<ChargeEntry>& chargeRefreshTimes = p.second;
-        while (!chargeRefreshTimes.empty() && chargeRefreshTimes.front().RechargeEnd <= now)
-            chargeRefreshTimes.pop_front();
+        ChargeEntryCollection& chargeRefreshTimes = p.second;
+        chargeRefreshTimes.erase(chargeRefreshTimes.begin(), std::find_if(chargeRefreshTimes.begin(), chargeRefreshTimes.end(), [now](ChargeEntry const& charge)
+        {
+            return charge.RechargeEnd > now;
+        }));
     }
 }
 
@@ -533,12 +542,13 @@ void SpellHistory::SendCooldownEvent(SpellInfo const* spellInfo, uint32 itemId /
         GetCooldownDurations(spellInfo, itemId, nullptr, &category, nullptr);
 
         auto categoryItr = _categoryCooldowns.find(category);
-        if (categoryItr != _categoryCooldowns.end() && categoryItr->second->SpellId != spellInfo->Id)
+        if (categoryItr != _categoryCooldowns.end() && categoryItr->second != spellInfo->Id)
         {
-            player->SendDirectMessage(WorldPackets::Spells::CooldownEvent(player != _owner, categoryItr->second->SpellId).Write());
+            uint32 categorySpellId = categoryItr->second;
+            player->SendDirectMessage(WorldPackets::Spells::CooldownEvent(player != _owner, categorySpellId).Write());
 
             if (startCooldown)
-                StartCooldown(sSpellMgr->AssertSpellInfo(categoryItr->second->SpellId, _owner->GetMap()->GetDifficultyID()), itemId, spell);
+                StartCooldown(sSpellMgr->AssertSpellInfo(categorySpellId, _owner->GetMap()->GetDifficultyID()), itemId, spell);
         }
 
         player->SendDirectMessage(WorldPackets::Spells::CooldownEvent(player != _owner, spellInfo->Id).Write());
@@ -563,7 +573,7 @@ void SpellHistory::AddCooldown(uint32 spellId, uint32 itemId, Clock::time_point
         cooldownEntry.OnHold = onHold;
 
         if (categoryId)
-            _categoryCooldowns[categoryId] = &cooldownEntry;
+            _categoryCooldowns[categoryId] = spellId;
     }
 }
 
@@ -690,10 +700,11 @@ SpellHistory::Duration SpellHistory::GetRemainingCooldown(SpellInfo const* spell
     else
     {
         auto catItr = _categoryCooldowns.find(spellInfo->GetCategory());
-        if (catItr == _categoryCooldowns.end())
+        CooldownEntry const* cooldownEntry = catItr != _categoryCooldowns.end() ? GetCategoryCooldown(catItr) : nullptr;
+        if (!cooldownEntry)
             return Duration::zero();
 
-        end = catItr->second->CategoryEnd;
+        end = cooldownEntry->CategoryEnd;
     }
 
     Clock::time_point now = GameTime::GetTime<Clock>();
@@ -708,10 +719,11 @@ SpellHistory::Duration SpellHistory::GetRemainingCategoryCooldown(uint32 categor
 {
     Clock::time_point end;
     auto catItr = _categoryCooldowns.find(categoryId);
-    if (catItr == _categoryCooldowns.end())
+    CooldownEntry const* cooldownEntry = catItr != _categoryCooldowns.end() ? GetCategoryCooldown(catItr) : nullptr;
+    if (!cooldownEntry)
         return Duration::zero();
 
-    end = catItr->second->CategoryEnd;
+    end = cooldownEntry->CategoryEnd;
 
     Clock::time_point now = GameTime::GetTime<Clock>();
     if (end < now)
@@ -802,7 +814,7 @@ bool SpellHistory::ConsumeCharge(uint32 chargeCategoryId)
     if (chargeRecovery > 0 && GetMaxCharges(chargeCategoryId) > 0)
     {
         Clock::time_point recoveryStart;
-        std::deque<ChargeEntry>& charges = _categoryCharges[chargeCategoryId];
+        ChargeEntryCollection& charges = _categoryCharges[chargeCategoryId];
         if (charges.empty())
             recoveryStart = GameTime::GetTime<Clock>();
         else
@@ -833,8 +845,11 @@ void SpellHistory::ModifyChargeRecoveryTime(uint32 chargeCategoryId, Duration co
         entry.RechargeEnd += cooldownMod;
     }
 
-    while (!itr->second.empty() && itr->second.front().RechargeEnd < now)
-        itr->second.pop_front();
+    ChargeEntryCollection& charges = itr->second;
+    charges.erase(charges.begin(), std::find_if(charges.begin(), charges.end(), [now](ChargeEntry const& charge)
+    {
+        return charge.RechargeEnd >= now;
+    }));
 
     SendSetSpellCharges(chargeCategoryId, itr->second);
 }
@@ -23,9 +23,9 @@
 #include "Duration.h"
 #include "GameTime.h"
 #include "Optional.h"
-#include <deque>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 #include <vector>
-#include <unordered_map>
 
 class Item;
 class Player;
@@ -69,11 +69,13 @@ public:
         Clock::time_point RechargeEnd;
     };
 
-    using ChargeEntryCollection = std::deque<ChargeEntry>;
-    using CooldownStorageType = std::unordered_map<uint32 /*spellId*/, CooldownEntry>;
-    using CategoryCooldownStorageType = std::unordered_map<uint32 /*categoryId*/, CooldownEntry*>;
-    using ChargeStorageType = std::unordered_map<uint32 /*categoryId*/, ChargeEntryCollection>;
-    using GlobalCooldownStorageType = std::unordered_map<uint32 /*categoryId*/, Clock::time_point>;
+    // Units rarely have more than a handful of active cooldowns, sorted vectors are both smaller and faster to search than hash maps here
+    // Inserting or erasing invalidates iterators and references to other elements, store keys instead of pointers
+    using ChargeEntryCollection = boost::container::small_vector<ChargeEntry, 3>;
+    using CooldownStorageType = boost::container::flat_map<uint32 /*spellId*/, CooldownEntry>;
+    using CategoryCooldownStorageType = boost::container::flat_map<uint32 /*categoryId*/, uint32 /*spellId*/>;
+    using ChargeStorageType = boost::container::flat_map<uint32 /*categoryId*/, ChargeEntryCollection>;
+    using GlobalCooldownStorageType = boost::container::flat_map<uint32 /*categoryId*/, Clock::time_point>;
 
     explicit SpellHistory(Unit* owner) : _owner(owner), _schoolLockouts() { }
 
@@ -161,6 +163,12 @@ private:
     Player* GetPlayerOwner() const;
     void ModifySpellCooldown(uint32 spellId, Duration cooldownMod, bool withoutCategoryCooldown = false);
     void SendClearCooldowns(std::vector<int32> const& cooldowns) const;
+    CooldownEntry const* GetCategoryCooldown(CategoryCooldownStorageType::const_iterator itr) const
+    {
+        auto spellItr = _spellCooldowns.find(itr->second);
+        return spellItr != _spellCooldowns.end() ? &spellItr->second : nullptr;
+    }
+
     CooldownStorageType::iterator EraseCooldown(CooldownStorageType::iterator itr)
     {
         _categoryCooldowns.erase(itr->second.CategoryId);
@@ -60,6 +60,25 @@ namespace
         >
     > mSpellInfoMap;
 
+    // dense spell id lookup in front of mSpellInfoMap, most spells have no difficulty specific data
+    // and would otherwise need one hash lookup per step of the difficulty fallback chain
+    std::vector<SpellInfo const*> mSpellInfoDefaultById;
+    std::vector<bool> mSpellInfoHasDifficultyData;
+
+    void IndexSpellInfo(SpellInfo const* spellInfo)
+    {
+        if (spellInfo->Id >= mSpellInfoDefaultById.size())
+        {
+            mSpellInfoDefaultById.resize(spellInfo->Id + 1, nullptr);
+            mSpellInfoHasDifficultyData.resize(spellInfo->Id + 1, false);
+        }
+
+        if (spellInfo->Difficulty == DIFFICULTY_NONE)
+            mSpellInfoDefaultById[spellInfo->Id] = spellInfo;
+        else
+            mSpellInfoHasDifficultyData[spellInfo->Id] = true;
+    }
+
     class ServersideSpellName
     {
     public:
@@ -96,6 +115,7 @@ namespace
     std::vector<ServersideSpellName> mServersideSpellNames;
 
     std::unordered_map<std::pair<uint32, Difficulty>, SpellProcEntry> mSpellProcMap;
+    uint32 mSpellProcMapGeneration = 0;
 }
 
 PetFamilySpellsStore sPetFamilySpellsStore;
@@ -398,6 +418,10 @@ void SpellMgr::GetSetOfSpellsInSpellGroup(SpellGroup group_id, std::set<uint32>&
 
 bool SpellMgr::AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, uint32 auraType, int32 amount, std::map<SpellGroup, int32>& groups) const
 {
+    // called for every aura effect summed by Unit::GetTotalAuraModifier, skip group lookups when no such groups are loaded
+    if (mSpellSameEffectStack.empty())
+        return false;
+
     uint32 spellId = spellInfo->GetFirstRankSpell()->Id;
     auto spellGroupBounds = GetSpellSpellGroupMapBounds(spellId);
     // Find group with SPELL_GROUP_STACK_RULE_EXCLUSIVE_SAME_EFFECT if it belongs to one
@@ -507,6 +531,11 @@ SpellProcEntry const* SpellMgr::GetSpellProcEntry(SpellInfo const* spellInfo) co
     return nullptr;
 }
 
+uint32 SpellMgr::GetSpellProcsGeneration() const
+{
+    return mSpellProcMapGeneration;
+}
+
 bool SpellMgr::CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo)
 {
     // proc type doesn't match
@@ -673,6 +702,13 @@ SpellAreaForAreaMapBounds SpellMgr::GetSpellAreaForAreaMapBounds(uint32 area_id)
 
 SpellInfo const* SpellMgr::GetSpellInfo(uint32 spellId, Difficulty difficulty) const
 {
+    if (spellId >= mSpellInfoDefaultById.size())
+        return nullptr;
+
+    // every difficulty fallback chain ends at DIFFICULTY_NONE
+    if (!mSpellInfoHasDifficultyData[spellId])
+        return difficulty == DIFFICULTY_NONE || sDifficultyStore.HasRecord(difficulty) ? mSpellInfoDefaultById[spellId] : nullptr;
+
     auto itr = mSpellInfoMap.find(boost::make_tuple(spellId, difficulty));
     if (itr != mSpellInfoMap.end())
         return &*itr;
@@ -1477,6 +1513,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++mSpellProcMapGeneration;                         // invalidates proc indexes of all units
 
     //                                                     0           1                2                 3                 4                 5                 6
     QueryResult result = WorldDatabase.Query("SELECT SpellId, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, SpellFamilyMask3, "
@@ -2621,7 +2658,7 @@ void SpellMgr::LoadSpellInfoStore()
             } while (difficultyEntry);
         }
 
-        mSpellInfoMap.emplace(spellNameEntry, data.first.second, data.second);
+        IndexSpellInfo(&*mSpellInfoMap.emplace(spellNameEntry, data.first.second, data.second).first);
     }
 
     TC_LOG_INFO("server.loading", ">> Loaded SpellInfo store in %u ms", GetMSTimeDiffToNow(oldMSTime));
@@ -2630,6 +2667,8 @@ void SpellMgr::LoadSpellInfoStore()
 void SpellMgr::UnloadSpellInfoStore()
 {
     mSpellInfoMap.clear();
+    mSpellInfoDefaultById.clear();
+    mSpellInfoHasDifficultyData.clear();
     mServersideSpellNames.clear();
 }
 
@@ -2799,6 +2838,7 @@ void SpellMgr::LoadSpellInfoServerside()
             mServersideSpellNames.emplace_back(spellId, fields[61].GetString());
 
             SpellInfo& spellInfo = const_cast<SpellInfo&>(*mSpellInfoMap.emplace(&mServersideSpellNames.back().Name, difficulty, spellEffects[{ spellId, difficulty }]).first);
+            IndexSpellInfo(&spellInfo);
             spellInfo.CategoryId = fields[2].GetUInt32();
             spellInfo.Dispel = fields[3].GetUInt32();
             spellInfo.Mechanic = fields[4].GetUInt32();
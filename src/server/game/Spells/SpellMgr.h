@@ -690,6 +690,8 @@ class TC_GAME_API SpellMgr
 
         // Spell proc table
         SpellProcEntry const* GetSpellProcEntry(SpellInfo const* spellInfo) const;
+        // changes every time spell_proc is (re)loaded
+        uint32 GetSpellProcsGeneration() const;
         static bool CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo);
 
         // Spell threat table
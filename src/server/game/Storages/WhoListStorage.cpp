@@ -35,34 +35,77 @@ void WhoListStorageMgr::Update()
     _whoListStorage.clear();
     _whoListStorage.reserve(sWorld->GetPlayerCount()+1);
 
+    std::unordered_map<ObjectGuid, std::pair<std::string, std::wstring>> widePlayerNames;
+    widePlayerNames.reserve(_widePlayerNames.size());
+    std::unordered_map<ObjectGuid::LowType, std::wstring> wideGuildNames;
+
     HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
     for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->second->FindMap() || itr->second->GetSession()->PlayerLoading())
+        Player* player = itr->second;
+        if (!player->FindMap() || player->GetSession()->PlayerLoading())
             continue;
 
-        std::string playerName = itr->second->GetName();
+        std::string const& playerName = player->GetName();
         std::wstring widePlayerName;
-        if (!Utf8toWStr(playerName, widePlayerName))
-            continue;
-
-        wstrToLower(widePlayerName);
-
-        std::string guildName = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wideGuildName;
-        if (!Utf8toWStr(guildName, wideGuildName))
-            continue;
+        auto cachedName = _widePlayerNames.find(player->GetGUID());
+        if (cachedName != _widePlayerNames.end() && cachedName->second.first == playerName)
+            widePlayerName = std::move(cachedName->second.second);
+        else
+        {
+            if (!Utf8toWStr(playerName, widePlayerName))
+                continue;
 
-        wstrToLower(wideGuildName);
+            wstrToLower(widePlayerName);
+        }
 
-        Guild* guild = itr->second->GetGuild();
+        std::string guildName;
         ObjectGuid guildGuid;
-
-        if (guild)
+        auto wideGuildName = wideGuildNames.end();
+        if (Guild* guild = player->GetGuild())
+        {
+            guildName = guild->GetName();
             guildGuid = guild->GetGUID();
+            wideGuildName = wideGuildNames.find(guild->GetId());
+            if (wideGuildName == wideGuildNames.end())
+            {
+                std::wstring name;
+                if (!Utf8toWStr(guildName, name))
+                    continue;
+
+                wstrToLower(name);
+                wideGuildName = wideGuildNames.emplace(guild->GetId(), std::move(name)).first;
+            }
+        }
 
-        _whoListStorage.emplace_back(itr->second->GetGUID(), itr->second->GetTeam(), itr->second->GetSession()->GetSecurity(), itr->second->GetLevel(),
-            itr->second->GetClass(), itr->second->GetRace(), itr->second->GetZoneId(), itr->second->GetNativeGender(), itr->second->IsVisible(),
-            itr->second->IsGameMaster(), widePlayerName, wideGuildName, playerName, guildName, guildGuid);
+        _whoListStorage.emplace_back(player->GetGUID(), player->GetTeam(), player->GetSession()->GetSecurity(), player->GetLevel(),
+            player->GetClass(), player->GetRace(), player->GetZoneId(), player->GetNativeGender(), player->IsVisible(),
+            player->IsGameMaster(), widePlayerName, wideGuildName != wideGuildNames.end() ? wideGuildName->second : std::wstring(),
+            playerName, guildName, guildGuid);
+
+        widePlayerNames.emplace(player->GetGUID(), std::make_pair(playerName, std::move(widePlayerName)));
     }
+
+    _widePlayerNames = std::move(widePlayerNames);
+
+    std::stable_sort(_whoListStorage.begin(), _whoListStorage.end(), [](WhoListPlayerInfo const& left, WhoListPlayerInfo const& right)
+    {
+        return left.GetLevel() < right.GetLevel();
+    });
+}
+
+Trinity::IteratorPair<WhoListInfoVector::const_iterator> WhoListStorageMgr::GetWhoListInLevelRange(uint8 minLevel, uint8 maxLevel) const
+{
+    if (minLevel > maxLevel)
+        return { _whoListStorage.end(), _whoListStorage.end() };
+
+    auto first = std::lower_bound(_whoListStorage.begin(), _whoListStorage.end(), minLevel, [](WhoListPlayerInfo const& info, uint8 level)
+    {
+        return info.GetLevel() < level;
+    });
+    auto last = std::upper_bound(first, _whoListStorage.end(), maxLevel, [](uint8 level, WhoListPlayerInfo const& info)
+    {
+        return level < info.GetLevel();
+    });
+    return { first, last };
 }
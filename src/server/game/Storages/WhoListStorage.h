@@ -19,7 +19,9 @@
 #define _WHOLISTSTORAGE_H
 
 #include "Common.h"
+#include "IteratorPair.h"
 #include "ObjectGuid.h"
+#include <unordered_map>
 
 class WhoListPlayerInfo
 {
@@ -77,8 +79,14 @@ public:
     void Update();
     WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
 
+    // entries are kept sorted by level
+    Trinity::IteratorPair<WhoListInfoVector::const_iterator> GetWhoListInLevelRange(uint8 minLevel, uint8 maxLevel) const;
+
 protected:
     WhoListInfoVector _whoListStorage;
+
+    // lowercased wide names from the previous update, keyed by the name they were built from
+    std::unordered_map<ObjectGuid, std::pair<std::string, std::wstring>> _widePlayerNames;
 };
 
 #define sWhoListStorageMgr WhoListStorageMgr::instance()
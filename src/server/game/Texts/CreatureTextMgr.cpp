@@ -188,62 +188,64 @@ uint32 CreatureTextMgr::SendChat(Creature* source, uint8 textGroup, WorldObject
 
     CreatureTextGroup const& textGroupContainer = itr->second;  //has all texts in the group
     CreatureTextRepeatIds repeatGroup = source->GetTextRepeatGroup(textGroup);//has all textIDs from the group that were already said
-    CreatureTextGroup tempGroup;//will use this to talk after sorting repeatGroup
+    std::vector<CreatureTextEntry const*> tempGroup;//will use this to talk after sorting repeatGroup, pointers to not copy the texts
+    tempGroup.reserve(textGroupContainer.size());
 
     for (CreatureTextGroup::const_iterator giter = textGroupContainer.begin(); giter != textGroupContainer.end(); ++giter)
         if (std::find(repeatGroup.begin(), repeatGroup.end(), giter->id) == repeatGroup.end())
-            tempGroup.push_back(*giter);
+            tempGroup.push_back(&*giter);
 
     if (tempGroup.empty())
     {
         source->ClearTextRepeatGroup(textGroup);
-        tempGroup = textGroupContainer;
+        for (CreatureTextEntry const& text : textGroupContainer)
+            tempGroup.push_back(&text);
     }
 
-    auto iter = Trinity::Containers::SelectRandomWeightedContainerElement(tempGroup, [](CreatureTextEntry const& t) -> double
+    CreatureTextEntry const* text = *Trinity::Containers::SelectRandomWeightedContainerElement(tempGroup, [](CreatureTextEntry const* t) -> double
     {
-        return t.probability;
+        return t->probability;
     });
 
-    ChatMsg finalType = (msgType == CHAT_MSG_ADDON) ? iter->type : msgType;
-    Language finalLang = (language == LANG_ADDON) ? iter->lang : language;
-    uint32 finalSound = iter->sound;
-    SoundKitPlayType finalPlayType = iter->SoundPlayType;
+    ChatMsg finalType = (msgType == CHAT_MSG_ADDON) ? text->type : msgType;
+    Language finalLang = (language == LANG_ADDON) ? text->lang : language;
+    uint32 finalSound = text->sound;
+    SoundKitPlayType finalPlayType = text->SoundPlayType;
     if (sound)
     {
         finalSound = sound;
         finalPlayType = playType;
     }
-    else if (BroadcastTextEntry const* bct = sBroadcastTextStore.LookupEntry(iter->BroadcastTextId))
+    else if (BroadcastTextEntry const* bct = sBroadcastTextStore.LookupEntry(text->BroadcastTextId))
         if (uint32 broadcastTextSoundId = bct->SoundKitID[source->GetGender() == GENDER_FEMALE ? 1 : 0])
             finalSound = broadcastTextSoundId;
 
     if (range == TEXT_RANGE_NORMAL)
-        range = iter->TextRange;
+        range = text->TextRange;
 
     if (finalSound)
-        SendSound(source, finalSound, finalType, whisperTarget, range, team, gmOnly, iter->BroadcastTextId, finalPlayType);
+        SendSound(source, finalSound, finalType, whisperTarget, range, team, gmOnly, text->BroadcastTextId, finalPlayType);
 
     Unit* finalSource = source;
     if (srcPlr)
         finalSource = srcPlr;
 
-    if (iter->emote)
-        SendEmote(finalSource, iter->emote);
+    if (text->emote)
+        SendEmote(finalSource, text->emote);
 
     if (srcPlr)
     {
-        Trinity::CreatureTextTextBuilder builder(source, finalSource, finalSource->GetGender(), finalType, iter->groupId, iter->id, finalLang, whisperTarget);
+        Trinity::CreatureTextTextBuilder builder(source, finalSource, finalSource->GetGender(), finalType, text->groupId, text->id, finalLang, whisperTarget);
         SendChatPacket(finalSource, builder, finalType, whisperTarget, range, team, gmOnly);
     }
     else
     {
-        Trinity::CreatureTextTextBuilder builder(finalSource, finalSource, finalSource->GetGender(), finalType, iter->groupId, iter->id, finalLang, whisperTarget);
+        Trinity::CreatureTextTextBuilder builder(finalSource, finalSource, finalSource->GetGender(), finalType, text->groupId, text->id, finalLang, whisperTarget);
         SendChatPacket(finalSource, builder, finalType, whisperTarget, range, team, gmOnly);
     }
 
-    source->SetTextRepeatId(textGroup, iter->id);
-    return iter->duration;
+    source->SetTextRepeatId(textGroup, text->id);
+    return text->duration;
 }
 
 float CreatureTextMgr::GetRangeForChatType(ChatMsg msgType)
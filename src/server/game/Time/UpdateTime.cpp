@@ -19,13 +19,17 @@
 #include "Timer.h"
 #include "Config.h"
 #include "Log.h"
+#include <algorithm>
+#include <vector>
 
 // create instance
 WorldUpdateTime sWorldUpdateTime;
 
-UpdateTime::UpdateTime()
+UpdateTime::UpdateTime() : _updateTimeHistoryCount(0)
 {
     _lastUpdateTime = 0;
+    for (std::atomic<uint32>& updateTime : _updateTimeHistory)
+        updateTime.store(0, std::memory_order_relaxed);
 }
 
 uint32 UpdateTime::GetLastUpdateTime() const
@@ -33,7 +37,26 @@ uint32 UpdateTime::GetLastUpdateTime() const
     return _lastUpdateTime;
 }
 
+uint32 UpdateTime::GetUpdateTimePercentile(uint32 percentile) const
+{
+    std::size_t count = std::min<std::size_t>(_updateTimeHistoryCount.load(std::memory_order_acquire), UpdateTimeHistorySize);
+    if (!count)
+        return 0;
+
+    std::vector<uint32> updateTimes(count);
+    for (std::size_t i = 0; i < count; ++i)
+        updateTimes[i] = _updateTimeHistory[i].load(std::memory_order_relaxed);
+
+    auto nth = updateTimes.begin() + (count - 1) * std::min(percentile, 100u) / 100;
+    std::nth_element(updateTimes.begin(), nth, updateTimes.end());
+    return *nth;
+}
+
 void UpdateTime::UpdateWithDiff(uint32 diff)
 {
     _lastUpdateTime = diff;
+
+    uint32 count = _updateTimeHistoryCount.load(std::memory_order_relaxed);
+    _updateTimeHistory[count % UpdateTimeHistorySize].store(diff, std::memory_order_relaxed);
+    _updateTimeHistoryCount.store(count + 1, std::memory_order_release);
 }
@@ -19,11 +19,15 @@
 #define __UPDATETIME_H
 
 #include "Define.h"
+#include <array>
+#include <atomic>
 
 class TC_GAME_API UpdateTime
 {
     public:
         uint32 GetLastUpdateTime() const;
+        /// percentile (0-100) of the last UpdateTimeHistorySize update times
+        uint32 GetUpdateTimePercentile(uint32 percentile) const;
 
         void UpdateWithDiff(uint32 diff);
 
@@ -31,7 +35,11 @@ class TC_GAME_API UpdateTime
         UpdateTime();
 
     private:
+        static constexpr std::size_t UpdateTimeHistorySize = 500;
+
         uint32 _lastUpdateTime;
+        std::array<std::atomic<uint32>, UpdateTimeHistorySize> _updateTimeHistory;
+        std::atomic<uint32> _updateTimeHistoryCount;
 };
 
 class TC_GAME_API WorldUpdateTime : public UpdateTime
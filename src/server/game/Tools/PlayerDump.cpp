@@ -151,16 +151,25 @@ DumpTable const DumpTables[] =
 uint32 const DUMP_TABLE_COUNT = std::extent<decltype(DumpTables)>::value;
 
 // helper class to dump sql queries to a printable string
+// Collects dump lines in memory or, when given a file, writes them out right away so that dumping
+// a character with a large inventory and mailbox does not build the whole dump in memory first
 class StringTransaction
 {
     public:
-        StringTransaction() : _buf() { }
+        StringTransaction() : _buf(), _file(nullptr) { }
+        explicit StringTransaction(FILE* file) : _buf(), _file(file) { }
 
-        void Append(char const* sql)
+        void Append(std::string const& sql)
         {
-            std::ostringstream oss;
-            oss << sql << '\n';
-            _buf += oss.str();
+            if (_file)
+            {
+                fwrite(sql.data(), 1, sql.length(), _file);
+                fputc('\n', _file);
+                return;
+            }
+
+            _buf += sql;
+            _buf += '\n';
         }
 
         char const* GetBuffer() const
@@ -170,6 +179,7 @@ class StringTransaction
 
     private:
         std::string _buf;
+        FILE* _file;
 };
 
 // dynamic data, loaded at startup
@@ -607,49 +617,54 @@ inline void AppendTableDump(StringTransaction& trans, TableStruct const& tableSt
     if (!result)
         return;
 
-    do
+    // column list is the same for every row
+    std::string insertPrefix = "INSERT INTO `" + tableStruct.TableName + "` (";
+    for (auto itr = tableStruct.TableFields.begin(); itr != tableStruct.TableFields.end();)
     {
-        std::ostringstream ss;
-        ss << "INSERT INTO `" << tableStruct.TableName << "` (";
-        for (auto itr = tableStruct.TableFields.begin(); itr != tableStruct.TableFields.end();)
-        {
-            ss << '`' << itr->FieldName << '`';
-            ++itr;
+        insertPrefix += '`' + itr->FieldName + '`';
+        ++itr;
 
-            if (itr != tableStruct.TableFields.end())
-                ss << ", ";
-        }
-        ss << ") VALUES (";
+        if (itr != tableStruct.TableFields.end())
+            insertPrefix += ", ";
+    }
+    insertPrefix += ") VALUES (";
 
-        uint32 const fieldSize = uint32(tableStruct.TableFields.size());
+    uint32 const fieldSize = uint32(tableStruct.TableFields.size());
+    std::string line;
+    do
+    {
+        line = insertPrefix;
         Field* fields = result->Fetch();
 
         for (uint32 i = 0; i < fieldSize;)
         {
             if (fields[i].IsNull())
-                ss << "'NULL'";
+                line += "'NULL'";
             else
             {
                 if (!tableStruct.TableFields[i].IsBinaryField)
                 {
                     std::string s(fields[i].GetString());
                     CharacterDatabase.EscapeString(s);
-                    ss << '\'' << s << '\'';
+                    line += '\'';
+                    line += s;
+                    line += '\'';
                 }
                 else
                 {
                     std::vector<uint8> b(fields[i].GetBinary());
-                    ss << "0x" << ByteArrayToHexStr(b);
+                    line += "0x";
+                    line += ByteArrayToHexStr(b);
                 }
             }
 
             ++i;
             if (i != fieldSize)
-                ss << ", ";
+                line += ", ";
         }
-        ss << ");";
+        line += ");";
 
-        trans.Append(ss.str().c_str());
+        trans.Append(line);
     } while (result->NextRow());
 }
 
@@ -788,27 +803,36 @@ bool PlayerDumpWriter::AppendTable(StringTransaction& trans, ObjectGuid::LowType
     return true;
 }
 
-bool PlayerDumpWriter::GetDump(ObjectGuid::LowType guid, std::string& dump)
-{
-    dump =  "IMPORTANT NOTE: THIS DUMPFILE IS MADE FOR USE WITH THE 'PDUMP' COMMAND ONLY - EITHER THROUGH INGAME CHAT OR ON CONSOLE!\n";
-    dump += "IMPORTANT NOTE: DO NOT apply it directly - it will irreversibly DAMAGE and CORRUPT your database! You have been warned!\n\n";
-
-    StringTransaction trans;
+static char const DumpHeader[] =
+    "IMPORTANT NOTE: THIS DUMPFILE IS MADE FOR USE WITH THE 'PDUMP' COMMAND ONLY - EITHER THROUGH INGAME CHAT OR ON CONSOLE!\n"
+    "IMPORTANT NOTE: DO NOT apply it directly - it will irreversibly DAMAGE and CORRUPT your database! You have been warned!\n\n";
 
+bool PlayerDumpWriter::AppendTables(StringTransaction& trans, ObjectGuid::LowType guid)
+{
     // collect guids
     PopulateGuids(guid);
     for (uint32 i = 0; i < DUMP_TABLE_COUNT; ++i)
         if (!AppendTable(trans, guid, CharacterTables[i], DumpTables[i]))
             return false;
 
-    dump += trans.GetBuffer();
-
     /// @todo Add instance/group..
     /// @todo Add a dump level option to skip some non-important tables
 
     return true;
 }
 
+bool PlayerDumpWriter::GetDump(ObjectGuid::LowType guid, std::string& dump)
+{
+    dump = DumpHeader;
+
+    StringTransaction trans;
+    if (!AppendTables(trans, guid))
+        return false;
+
+    dump += trans.GetBuffer();
+    return true;
+}
+
 DumpReturn PlayerDumpWriter::WriteDump(std::string const& file, ObjectGuid::LowType guid)
 {
     if (sWorld->getBoolConfig(CONFIG_PDUMP_NO_PATHS))
@@ -826,13 +850,14 @@ DumpReturn PlayerDumpWriter::WriteDump(std::string const& file, ObjectGuid::LowT
     if (!fout)
         return DUMP_FILE_OPEN_ERROR;
 
-    DumpReturn ret = DUMP_SUCCESS;
-    std::string dump;
-    if (!GetDump(guid, dump))
-        ret = DUMP_CHARACTER_DELETED;
+    // rows are written as they are read, the character row comes first so a deleted character leaves only the header
+    fputs(DumpHeader, fout.get());
+
+    StringTransaction trans(fout.get());
+    if (!AppendTables(trans, guid))
+        return DUMP_CHARACTER_DELETED;
 
-    fprintf(fout.get(), "%s", dump.c_str());
-    return ret;
+    return DUMP_SUCCESS;
 }
 
 // Reading - High-level functions
@@ -847,6 +872,60 @@ inline void FixNULLfields(std::string& line)
     }
 }
 
+// Merges consecutive single row INSERTs into the same table into multi row INSERTs, a character with a full
+// inventory, mailbox and collections has thousands of rows and each one would otherwise be a separate statement
+class InsertBatch
+{
+    public:
+        explicit InsertBatch(CharacterDatabaseTransaction trans) : _trans(std::move(trans)) { }
+
+        void Append(std::string const& line)
+        {
+            static std::string const ValuesString(") VALUES (");
+            std::string::size_type valuesPos = line.find(ValuesString);
+            std::string::size_type valuesEnd = line.rfind(')');
+            if (valuesPos == std::string::npos || valuesEnd == std::string::npos || valuesEnd < valuesPos + ValuesString.length())
+            {
+                Flush();
+                _trans->Append(line.c_str());
+                return;
+            }
+
+            std::string::size_type prefixLength = valuesPos + ValuesString.length() - 1;
+            std::string::size_type valuesLength = valuesEnd + 1 - prefixLength;
+            if (!_statement.empty())
+            {
+                if (_prefixLength == prefixLength && _statement.length() + valuesLength < MAX_QUERY_LEN
+                    && _statement.compare(0, prefixLength, line, 0, prefixLength) == 0)
+                {
+                    _statement += ", ";
+                    _statement.append(line, prefixLength, valuesLength);
+                    return;
+                }
+
+                Flush();
+            }
+
+            _prefixLength = prefixLength;
+            _statement.assign(line, 0, valuesEnd + 1);
+        }
+
+        void Flush()
+        {
+            if (_statement.empty())
+                return;
+
+            _statement += ';';
+            _trans->Append(_statement.c_str());
+            _statement.clear();
+        }
+
+    private:
+        CharacterDatabaseTransaction _trans;
+        std::string _statement;
+        std::string::size_type _prefixLength = 0;
+};
+
 DumpReturn PlayerDumpReader::LoadDump(std::string const& file, uint32 account, std::string name, ObjectGuid::LowType guid)
 {
     uint32 charcount = AccountMgr::GetCharactersCount(account);
@@ -917,6 +996,7 @@ DumpReturn PlayerDumpReader::LoadDump(std::string const& file, uint32 account, s
     size_t lineNumber = 0;
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    InsertBatch batch(trans);
     while (!feof(fin.get()))
     {
         if (!fgets(buf, BUFFER_SIZE, fin.get()))
@@ -1044,9 +1124,10 @@ DumpReturn PlayerDumpReader::LoadDump(std::string const& file, uint32 account, s
 
         FixNULLfields(line);
 
-        trans->Append(line.c_str());
+        batch.Append(line);
     }
 
+    batch.Flush();
     CharacterDatabase.CommitTransaction(trans);
 
     // in case of name conflict player has to rename at login anyway
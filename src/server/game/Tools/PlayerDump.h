@@ -94,6 +94,7 @@ class TC_GAME_API PlayerDumpWriter : public PlayerDump
         DumpReturn WriteDump(std::string const& file, ObjectGuid::LowType guid);
 
     private:
+        bool AppendTables(StringTransaction& trans, ObjectGuid::LowType guid);
         bool AppendTable(StringTransaction& trans, ObjectGuid::LowType guid, TableStruct const& tableStruct, DumpTable const& dumpTable);
         void PopulateGuids(ObjectGuid::LowType guid);
 
@@ -22,6 +22,7 @@
 #include "Opcodes.h"
 #include "ByteBuffer.h"
 #include "GameTime.h"
+#include "Random.h"
 #include "World.h"
 #include "Util.h"
 #include "Warden.h"
@@ -33,7 +34,7 @@
 
 #include <charconv>
 
-Warden::Warden() : _session(nullptr), _checkTimer(10 * IN_MILLISECONDS), _clientResponseTimer(0),
+Warden::Warden() : _session(nullptr), _checkTimer(urand(10 * IN_MILLISECONDS, 15 * IN_MILLISECONDS)), _clientResponseTimer(0),
                    _dataSent(false), _initialized(false)
 {
 }
@@ -525,8 +525,9 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
     }
 
     // Set hold off timer, minimum timer should at least be 1 second
-    uint32 holdOff = sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF);
-    _checkTimer = (holdOff < 1 ? 1 : holdOff) * IN_MILLISECONDS;
+    // spread by up to a quarter so that sessions logged in together do not keep requesting checks in the same update
+    uint32 holdOff = std::max<uint32>(sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF), 1) * IN_MILLISECONDS;
+    _checkTimer = holdOff + urand(0, holdOff / 4);
 }
 
 size_t WardenWin::DEBUG_ForceSpecificChecks(std::vector<uint16> const& checks)
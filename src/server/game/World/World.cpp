@@ -44,6 +44,7 @@
 #include "CreatureAIRegistry.h"
 #include "CreatureGroups.h"
 #include "CreatureTextMgr.h"
+#include "CryptoHash.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
 #include "DisableMgr.h"
@@ -54,43 +55,55 @@
 #include "GarrisonMgr.h"
 #include "GitRevision.h"
 #include "GridNotifiersImpl.h"
+#include "GridPreloader.h"
 #include "GroupMgr.h"
 #include "GuildMgr.h"
+#include "HeapProfiler.h"
 #include "InstanceSaveMgr.h"
+#include "InstrumentedMutex.h"
+#include "IpBanCache.h"
 #include "IPLocation.h"
 #include "Language.h"
 #include "LanguageMgr.h"
 #include "LFGMgr.h"
+#include "LoadingProfiler.h"
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "LootMgr.h"
 #include "M2Stores.h"
 #include "MapManager.h"
 #include "Memory.h"
+#include "MemoryAccounting.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
+#include "PacketLog.h"
+#include "PathWorkerPool.h"
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
 #include "PoolMgr.h"
 #include "QuestPools.h"
 #include "Realm.h"
+#include "ResultSnapshotStore.h"
 #include "ScenarioMgr.h"
 #include "ScriptMgr.h"
 #include "ScriptReloadMgr.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "SpellMgr.h"
+#include "StringConvert.h"
 #include "SmartScriptMgr.h"
 #include "SupportMgr.h"
+#include "TaskGraph.h"
 #include "TaxiPathGraph.h"
 #include "TransportMgr.h"
 #include "Unit.h"
 #include "UpdateTime.h"
+#include "Util.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
 #include "WardenCheckMgr.h"
@@ -99,9 +112,37 @@
 #include "WhoListStorage.h"
 #include "WorldSession.h"
 #include "WorldSocket.h"
+#include "WorldSocketMgr.h"
 
 #include <boost/algorithm/string.hpp>
 
+namespace
+{
+    // measures one housekeeping task, adds its duration to the budget used by the current world update
+    class HousekeepingTask
+    {
+    public:
+        HousekeepingTask(uint32& timeUsed, char const* name) : _timeUsed(timeUsed), _name(name), _startTime(getMSTime()) { }
+        ~HousekeepingTask()
+        {
+            uint32 elapsed = GetMSTimeDiffToNow(_startTime);
+            _timeUsed += elapsed;
+
+            uint32 budget = sWorld->getIntConfig(CONFIG_HOUSEKEEPING_TICK_BUDGET);
+            if (budget && elapsed > budget)
+                TC_LOG_WARN("misc", "World::Update: housekeeping task '%s' took %u ms, exceeding the tick budget of %u ms on its own", _name, elapsed, budget);
+        }
+
+        HousekeepingTask(HousekeepingTask const&) = delete;
+        HousekeepingTask& operator=(HousekeepingTask const&) = delete;
+
+    private:
+        uint32& _timeUsed;
+        char const* _name;
+        uint32 _startTime;
+    };
+}
+
 TC_GAME_API std::atomic<bool> World::m_stopEvent(false);
 TC_GAME_API uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
 
@@ -141,6 +182,8 @@ World::World()
 
     mail_timer = 0;
     mail_timer_expires = 0;
+    _housekeepingTimeUsed = 0;
+    _lastLagPacketDump = 0;
 
     m_isClosed = false;
 
@@ -176,6 +219,9 @@ World::~World()
     while (cliCmdQueue.next(command))
         delete command;
 
+    sPathWorkerPool->Stop();
+    sGridPreloader->Stop();
+
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 
@@ -542,8 +588,6 @@ void World::LoadConfigSettings(bool reload)
 
             return;
         }
-        sLog->LoadFromConfig();
-        sMetric->LoadFromConfigs();
     }
 
     m_defaultDbcLocale = LocaleConstant(sConfigMgr->GetIntDefault("DBC.Locale", 0));
@@ -756,6 +800,7 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "Auction.TaintedSearchDelay (%i) must be between 100 and 10000. Using default of 3s", m_int_configs[CONFIG_AUCTION_SEARCH_DELAY]);
         m_int_configs[CONFIG_AUCTION_TAINTED_SEARCH_DELAY] = 3000;
     }
+    m_int_configs[CONFIG_AUCTION_MAX_EXPIRED_PER_UPDATE] = sConfigMgr->GetIntDefault("Auction.MaxExpiredPerUpdate", 500);
     m_int_configs[CONFIG_CHAT_CHANNEL_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Channel", 1);
     m_int_configs[CONFIG_CHAT_WHISPER_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Whisper", 1);
     m_int_configs[CONFIG_CHAT_EMOTE_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Emote", 1);
@@ -801,6 +846,23 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetGridCleanUpDelay(m_int_configs[CONFIG_INTERVAL_GRIDCLEAN]);
 
+    m_int_configs[CONFIG_GRID_UNLOAD_MAX_PER_UPDATE] = sConfigMgr->GetIntDefault("GridUnload.MaxPerUpdate", 2);
+    m_int_configs[CONFIG_GRID_UNLOAD_MAX_EXPIRY_SCALE] = sConfigMgr->GetIntDefault("GridUnload.MaxExpiryScale", 4);
+    if (m_int_configs[CONFIG_GRID_UNLOAD_MAX_EXPIRY_SCALE] < 1 || m_int_configs[CONFIG_GRID_UNLOAD_MAX_EXPIRY_SCALE] > 64)
+    {
+        TC_LOG_ERROR("server.loading", "GridUnload.MaxExpiryScale (%u) must be in range 1..64. Using default (4).", m_int_configs[CONFIG_GRID_UNLOAD_MAX_EXPIRY_SCALE]);
+        m_int_configs[CONFIG_GRID_UNLOAD_MAX_EXPIRY_SCALE] = 4;
+    }
+
+    if (reload)
+    {
+        uint32 val = sConfigMgr->GetIntDefault("GridPreloadLookAhead", 0);
+        if (val != m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD])
+            TC_LOG_ERROR("server.loading", "GridPreloadLookAhead option can't be changed at worldserver.conf reload, using current value (%u).", m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD]);
+    }
+    else
+        m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD] = sConfigMgr->GetIntDefault("GridPreloadLookAhead", 0);
+
     m_int_configs[CONFIG_INTERVAL_MAPUPDATE] = sConfigMgr->GetIntDefault("MapUpdateInterval", 10);
     if (m_int_configs[CONFIG_INTERVAL_MAPUPDATE] < MIN_MAP_UPDATE_DELAY)
     {
@@ -810,6 +872,8 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetMapUpdateInterval(m_int_configs[CONFIG_INTERVAL_MAPUPDATE]);
 
+    m_int_configs[CONFIG_INTERVAL_MAPUPDATE_IDLE] = sConfigMgr->GetIntDefault("MapUpdateInterval.Idle", 200);
+
     m_int_configs[CONFIG_INTERVAL_CHANGEWEATHER] = sConfigMgr->GetIntDefault("ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (reload)
@@ -1181,6 +1245,9 @@ void World::LoadConfigSettings(bool reload)
     TC_LOG_INFO("server.loading", "Will clear `logs` table of entries older than %i seconds every %u minutes.",
         m_int_configs[CONFIG_LOGDB_CLEARTIME], m_int_configs[CONFIG_LOGDB_CLEARINTERVAL]);
 
+    m_int_configs[CONFIG_HOUSEKEEPING_TICK_BUDGET] = sConfigMgr->GetIntDefault("HousekeepingTickBudget", 20);
+    m_int_configs[CONFIG_PACKET_LOG_LAG_DUMP_THRESHOLD] = sConfigMgr->GetIntDefault("PacketLog.LagDumpThreshold", 0);
+
     m_int_configs[CONFIG_SKILL_CHANCE_ORANGE] = sConfigMgr->GetIntDefault("SkillChance.Orange", 100);
     m_int_configs[CONFIG_SKILL_CHANCE_YELLOW] = sConfigMgr->GetIntDefault("SkillChance.Yellow", 75);
     m_int_configs[CONFIG_SKILL_CHANCE_GREEN]  = sConfigMgr->GetIntDefault("SkillChance.Green", 25);
@@ -1296,6 +1363,7 @@ void World::LoadConfigSettings(bool reload)
     m_float_configs[CONFIG_LISTEN_RANGE_SAY]       = sConfigMgr->GetFloatDefault("ListenRange.Say", 25.0f);
     m_float_configs[CONFIG_LISTEN_RANGE_TEXTEMOTE] = sConfigMgr->GetFloatDefault("ListenRange.TextEmote", 25.0f);
     m_float_configs[CONFIG_LISTEN_RANGE_YELL]      = sConfigMgr->GetFloatDefault("ListenRange.Yell", 300.0f);
+    m_float_configs[CONFIG_LISTEN_RANGE_COMBAT_LOG] = sConfigMgr->GetFloatDefault("ListenRange.CombatLog", 0.0f);
 
     m_bool_configs[CONFIG_BATTLEGROUND_CAST_DESERTER]                = sConfigMgr->GetBoolDefault("Battleground.CastDeserter", true);
     m_bool_configs[CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE]       = sConfigMgr->GetBoolDefault("Battleground.QueueAnnouncer.Enable", false);
@@ -1335,6 +1403,13 @@ void World::LoadConfigSettings(bool reload)
 
     m_int_configs[CONFIG_CREATURE_PICKPOCKET_REFILL] = sConfigMgr->GetIntDefault("Creature.PickPocketRefillDelay", 10 * MINUTE);
     m_int_configs[CONFIG_CREATURE_STOP_FOR_PLAYER] = sConfigMgr->GetIntDefault("Creature.MovingStopTimeForPlayer", 3 * MINUTE * IN_MILLISECONDS);
+    m_int_configs[CONFIG_CREATURE_LOW_UPDATE_RATE_INTERVAL] = sConfigMgr->GetIntDefault("Creature.LowUpdateRate.Interval", 0);
+    m_float_configs[CONFIG_CREATURE_LOW_UPDATE_RATE_DISTANCE] = sConfigMgr->GetFloatDefault("Creature.LowUpdateRate.Distance", 100.0f);
+    if (m_float_configs[CONFIG_CREATURE_LOW_UPDATE_RATE_DISTANCE] < 0.0f)
+    {
+        TC_LOG_ERROR("server.loading", "Creature.LowUpdateRate.Distance (%f) must be >= 0. Using 100.0 instead.", m_float_configs[CONFIG_CREATURE_LOW_UPDATE_RATE_DISTANCE]);
+        m_float_configs[CONFIG_CREATURE_LOW_UPDATE_RATE_DISTANCE] = 100.0f;
+    }
 
     if (int32 clientCacheId = sConfigMgr->GetIntDefault("ClientCacheVersion", 0))
     {
@@ -1495,6 +1570,15 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", true);
+    m_int_configs[CONFIG_PATHFINDING_CACHE_SIZE] = sConfigMgr->GetIntDefault("mmap.pathCacheSize", 512);
+    if (reload)
+    {
+        uint32 val = sConfigMgr->GetIntDefault("mmap.asyncPathWorkers", 0);
+        if (val != m_int_configs[CONFIG_PATHFINDING_ASYNC_WORKERS])
+            TC_LOG_ERROR("server.loading", "mmap.asyncPathWorkers option can't be changed at worldserver.conf reload, using current value (%u).", m_int_configs[CONFIG_PATHFINDING_ASYNC_WORKERS]);
+    }
+    else
+        m_int_configs[CONFIG_PATHFINDING_ASYNC_WORKERS] = sConfigMgr->GetIntDefault("mmap.asyncPathWorkers", 0);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", false);
@@ -1531,6 +1615,7 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = sConfigMgr->GetIntDefault("Startup.LoaderThreads", 4);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1583,6 +1668,7 @@ void World::LoadConfigSettings(bool reload)
 
     // MySQL ping time interval
     m_int_configs[CONFIG_DB_PING_INTERVAL] = sConfigMgr->GetIntDefault("MaxPingTime", 30);
+    m_int_configs[CONFIG_DB_COALESCE_WINDOW] = sConfigMgr->GetIntDefault("Database.CoalesceWindow", 1000);
 
     // Guild save interval
     m_int_configs[CONFIG_GUILD_SAVE_INTERVAL] = sConfigMgr->GetIntDefault("Guild.SaveInterval", 15);
@@ -1648,6 +1734,7 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_HOTSWAP_BUILD_FILE_RECREATION_ENABLED] = sConfigMgr->GetBoolDefault("HotSwap.EnableBuildFileRecreation", true);
     m_bool_configs[CONFIG_HOTSWAP_INSTALL_ENABLED] = sConfigMgr->GetBoolDefault("HotSwap.EnableInstall", true);
     m_bool_configs[CONFIG_HOTSWAP_PREFIX_CORRECTION_ENABLED] = sConfigMgr->GetBoolDefault("HotSwap.EnablePrefixCorrection", true);
+    m_int_configs[CONFIG_HOTSWAP_MAX_PARALLEL_BUILDS] = std::max<int32>(sConfigMgr->GetIntDefault("HotSwap.MaxParallelBuilds", 1), 1);
 
     // prevent character rename on character customization
     m_bool_configs[CONFIG_PREVENT_RENAME_CUSTOMIZATION] = sConfigMgr->GetBoolDefault("PreventRenameCharacterOnCustomization", false);
@@ -1658,6 +1745,8 @@ void World::LoadConfigSettings(bool reload)
     // Allow to cache data queries
     m_bool_configs[CONFIG_CACHE_DATA_QUERIES] = sConfigMgr->GetBoolDefault("CacheDataQueries", true);
 
+    m_bool_configs[CONFIG_LOADING_PROFILE] = sConfigMgr->GetBoolDefault("LoadingProfile", false);
+
     // Check Invalid Position
     m_bool_configs[CONFIG_CREATURE_CHECK_INVALID_POSITION] = sConfigMgr->GetBoolDefault("Creature.CheckInvalidPosition", false);
     m_bool_configs[CONFIG_GAME_OBJECT_CHECK_INVALID_POSITION] = sConfigMgr->GetBoolDefault("GameObject.CheckInvalidPosition", false);
@@ -1677,12 +1766,47 @@ void World::LoadConfigSettings(bool reload)
 }
 
 /// Initialize the World
+void World::InitializeWorldDatabaseSnapshots()
+{
+    std::string snapshotsDir = sConfigMgr->GetStringDefault("SnapshotsDir", "");
+    if (snapshotsDir.empty())
+        return;
+
+    // snapshots are only valid as long as no new world database update was applied
+    QueryResult result = WorldDatabase.Query("SELECT name, hash FROM updates ORDER BY name");
+    if (!result)
+    {
+        TC_LOG_ERROR("server.loading", "World database `updates` table is empty, world database snapshots are disabled.");
+        return;
+    }
+
+    Trinity::Crypto::SHA1 versionKey;
+    do
+    {
+        Field* fields = result->Fetch();
+        versionKey.UpdateData(fields[0].GetStringView());
+        versionKey.UpdateData(fields[1].GetStringView());
+    } while (result->NextRow());
+    versionKey.Finalize();
+
+    sResultSnapshotStore->Initialize(snapshotsDir, ByteArrayToHexStr(versionKey.GetDigest()));
+    TC_LOG_INFO("server.loading", "Using world database snapshots from %s", snapshotsDir.c_str());
+}
+
+// logs the start of a startup step, the loading profile attributes the time until the next step to it
+static void LogLoadingStep(char const* message)
+{
+    TC_LOG_INFO("server.loading", "%s", message);
+    Trinity::LoadingProfiler::Step(message);
+}
+
 void World::SetInitialWorldSettings()
 {
     sLog->SetRealmId(realm.Id.Realm);
 
     ///- Server startup begin
     uint32 startupBegin = getMSTime();
+    Trinity::LoadingProfiler::Begin("startup");
 
     ///- Initialize the random number generator
     srand((unsigned int)GameTime::GetGameTime());
@@ -1704,6 +1828,9 @@ void World::SetInitialWorldSettings()
     ///- Init highest guids before any table loading to prevent using not initialized guids in some code.
     sObjectMgr->SetHighestGuids();
 
+    ///- Serve large world tables from snapshots written by a previous start with the same applied world database updates
+    InitializeWorldDatabaseSnapshots();
+
     ///- Check the existence of the map files for all races' startup areas.
     if (!MapManager::ExistMapAndVMap(0, -6240.32f, 331.033f)
         || !MapManager::ExistMapAndVMap(0, -8949.95f, -132.493f)
@@ -1727,7 +1854,7 @@ void World::SetInitialWorldSettings()
 
     ///- Loading strings. Getting no records means core load has to be canceled because no error message can be output.
 
-    TC_LOG_INFO("server.loading", "Loading Trinity strings...");
+    LogLoadingStep("Loading Trinity strings...");
     if (!sObjectMgr->LoadTrinityStrings())
         exit(1);                                            // Error message displayed in function already
 
@@ -1740,7 +1867,7 @@ void World::SetInitialWorldSettings()
 
     LoginDatabase.PExecute("UPDATE realmlist SET icon = %u, timezone = %u WHERE id = '%d'", server_type, realm_zone, realm.Id.Realm);      // One-time query
 
-    TC_LOG_INFO("server.loading", "Initialize data stores...");
+    LogLoadingStep("Initialize data stores...");
     ///- Load DB2s
     m_availableDbcLocaleMask = sDB2Manager.LoadStores(m_dataPath, m_defaultDbcLocale);
     if (!(m_availableDbcLocaleMask & (1 << m_defaultDbcLocale)))
@@ -1790,488 +1917,528 @@ void World::SetInitialWorldSettings()
     MMAP::MMapManager* mmmgr = MMAP::MMapFactory::createOrGetMMapManager();
     mmmgr->InitializeThreadUnsafe(mapData);
 
+    if (getBoolConfig(CONFIG_ENABLE_MMAPS))
+        sPathWorkerPool->Start(getIntConfig(CONFIG_PATHFINDING_ASYNC_WORKERS));
+
+    // also frees terrain of unloaded grids
+    if (getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD) || getBoolConfig(CONFIG_GRID_UNLOAD))
+        sGridPreloader->Start();
+
     ///- Initialize static helper structures
     AIRegistry::Initialize();
 
-    TC_LOG_INFO("server.loading", "Initializing PlayerDump tables...");
+    LogLoadingStep("Initializing PlayerDump tables...");
     PlayerDump::InitializeTables();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo store...");
+    LogLoadingStep("Loading SpellInfo store...");
     sSpellMgr->LoadSpellInfoStore();
 
-    TC_LOG_INFO("server.loading", "Loading serverside spells...");
+    LogLoadingStep("Loading serverside spells...");
     sSpellMgr->LoadSpellInfoServerside();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo corrections...");
+    LogLoadingStep("Loading SpellInfo corrections...");
     sSpellMgr->LoadSpellInfoCorrections();
 
-    TC_LOG_INFO("server.loading", "Loading SkillLineAbilityMultiMap Data...");
+    LogLoadingStep("Loading SkillLineAbilityMultiMap Data...");
     sSpellMgr->LoadSkillLineAbilityMap();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo custom attributes...");
+    LogLoadingStep("Loading SpellInfo custom attributes...");
     sSpellMgr->LoadSpellInfoCustomAttributes();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo diminishing infos...");
+    LogLoadingStep("Loading SpellInfo diminishing infos...");
     sSpellMgr->LoadSpellInfoDiminishing();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo immunity infos...");
+    LogLoadingStep("Loading SpellInfo immunity infos...");
     sSpellMgr->LoadSpellInfoImmunities();
 
-    TC_LOG_INFO("server.loading", "Loading PetFamilySpellsStore Data...");
+    LogLoadingStep("Loading PetFamilySpellsStore Data...");
     sSpellMgr->LoadPetFamilySpellsStore();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Totem models...");
+    LogLoadingStep("Loading Spell Totem models...");
     sSpellMgr->LoadSpellTotemModel();
 
-    TC_LOG_INFO("server.loading", "Loading languages...");  // must be after LoadSpellInfoStore and LoadSkillLineAbilityMap
+    LogLoadingStep("Loading languages...");  // must be after LoadSpellInfoStore and LoadSkillLineAbilityMap
     sLanguageMgr->LoadLanguages();
 
-    TC_LOG_INFO("server.loading", "Loading languages words...");
+    LogLoadingStep("Loading languages words...");
     sLanguageMgr->LoadLanguagesWords();
 
-    TC_LOG_INFO("server.loading", "Loading GameObject models...");
+    LogLoadingStep("Loading GameObject models...");
     LoadGameObjectModelList(m_dataPath);
 
-    TC_LOG_INFO("server.loading", "Loading Instance Template...");
+    LogLoadingStep("Loading Instance Template...");
     sObjectMgr->LoadInstanceTemplate();
 
     // Must be called before `respawn` data
-    TC_LOG_INFO("server.loading", "Loading instances...");
+    LogLoadingStep("Loading instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    TC_LOG_INFO("server.loading", "Loading Localization strings...");
+    LogLoadingStep("Loading Localization strings...");
     uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadQuestTemplateLocale();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadQuestObjectivesLocale();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    {
+        // every locale table is stored in its own container, all of them can be loaded at once
+        Trinity::TaskGraph localeLoaders;
+        localeLoaders.AddTask("creature_template_locale", [] { sObjectMgr->LoadCreatureLocales(); });
+        localeLoaders.AddTask("gameobject_template_locale", [] { sObjectMgr->LoadGameObjectLocales(); });
+        localeLoaders.AddTask("quest_template_locale", [] { sObjectMgr->LoadQuestTemplateLocale(); });
+        localeLoaders.AddTask("quest_offer_reward_locale", [] { sObjectMgr->LoadQuestOfferRewardLocale(); });
+        localeLoaders.AddTask("quest_request_items_locale", [] { sObjectMgr->LoadQuestRequestItemsLocale(); });
+        localeLoaders.AddTask("quest_objectives_locale", [] { sObjectMgr->LoadQuestObjectivesLocale(); });
+        localeLoaders.AddTask("page_text_locale", [] { sObjectMgr->LoadPageTextLocales(); });
+        localeLoaders.AddTask("gossip_menu_option_locale", [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        localeLoaders.AddTask("points_of_interest_locale", [] { sObjectMgr->LoadPointOfInterestLocales(); });
+        localeLoaders.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
     TC_LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
 
-    TC_LOG_INFO("server.loading", "Loading Account Roles and Permissions...");
+    LogLoadingStep("Loading Account Roles and Permissions...");
     sAccountMgr->LoadRBAC();
 
-    TC_LOG_INFO("server.loading", "Loading Page Texts...");
+    LogLoadingStep("Loading Page Texts...");
     sObjectMgr->LoadPageTexts();
 
-    TC_LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
+    LogLoadingStep("Loading Game Object Templates...");         // must be after LoadPageTexts
     sObjectMgr->LoadGameObjectTemplate();
 
-    TC_LOG_INFO("server.loading", "Loading Game Object template addons...");
+    LogLoadingStep("Loading Game Object template addons...");
     sObjectMgr->LoadGameObjectTemplateAddons();
 
-    TC_LOG_INFO("server.loading", "Loading Transport templates...");
+    LogLoadingStep("Loading Transport templates...");
     sTransportMgr->LoadTransportTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading Transport animations and rotations...");
+    LogLoadingStep("Loading Transport animations and rotations...");
     sTransportMgr->LoadTransportAnimationAndRotation();
 
-    TC_LOG_INFO("server.loading", "Loading Transport spawns...");
+    LogLoadingStep("Loading Transport spawns...");
     sTransportMgr->LoadTransportSpawns();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
+    LogLoadingStep("Loading Spell Rank Data...");
     sSpellMgr->LoadSpellRanks();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
+    LogLoadingStep("Loading Spell Required Data...");
     sSpellMgr->LoadSpellRequired();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Group types...");
+    LogLoadingStep("Loading Spell Group types...");
     sSpellMgr->LoadSpellGroups();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Skills...");
+    LogLoadingStep("Loading Spell Learn Skills...");
     sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo SpellSpecific and AuraState...");
+    LogLoadingStep("Loading SpellInfo SpellSpecific and AuraState...");
     sSpellMgr->LoadSpellInfoSpellSpecificAndAuraState();         // must be after LoadSpellRanks
 
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Spells...");
+    LogLoadingStep("Loading Spell Learn Spells...");
     sSpellMgr->LoadSpellLearnSpells();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
+    LogLoadingStep("Loading Spell Proc conditions and data...");
     sSpellMgr->LoadSpellProcs();
 
-    TC_LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
+    LogLoadingStep("Loading Aggro Spells Definitions...");
     sSpellMgr->LoadSpellThreats();
 
-    TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
+    LogLoadingStep("Loading Spell Group Stack Rules...");
     sSpellMgr->LoadSpellGroupStackRules();
 
-    TC_LOG_INFO("server.loading", "Loading NPC Texts...");
+    LogLoadingStep("Loading NPC Texts...");
     sObjectMgr->LoadNPCText();
 
-    TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
+    LogLoadingStep("Loading Enchant Spells Proc datas...");
     sSpellMgr->LoadSpellEnchantProcData();
 
-    TC_LOG_INFO("server.loading", "Loading Random item bonus list definitions...");
+    LogLoadingStep("Loading Random item bonus list definitions...");
     LoadItemRandomBonusListTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading Disables");                         // must be before loading quests and items
+    LogLoadingStep("Loading Disables");                         // must be before loading quests and items
     DisableMgr::LoadDisables();
 
-    TC_LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+    LogLoadingStep("Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
     sObjectMgr->LoadItemTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading Item set names...");                // must be after LoadItemPrototypes
+    LogLoadingStep("Loading Item set names...");                // must be after LoadItemPrototypes
     sObjectMgr->LoadItemTemplateAddon();
 
     TC_LOG_INFO("misc", "Loading Item Scripts...");                 // must be after LoadItemPrototypes
     sObjectMgr->LoadItemScriptNames();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
+    LogLoadingStep("Loading Creature Model Based Info Data...");
     sObjectMgr->LoadCreatureModelInfo();
 
-    TC_LOG_INFO("server.loading", "Loading Creature templates...");
+    LogLoadingStep("Loading Creature templates...");
     sObjectMgr->LoadCreatureTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading Equipment templates...");           // must be after LoadCreatureTemplates
+    LogLoadingStep("Loading Equipment templates...");           // must be after LoadCreatureTemplates
     sObjectMgr->LoadEquipmentTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading Creature template addons...");
+    LogLoadingStep("Loading Creature template addons...");
     sObjectMgr->LoadCreatureTemplateAddons();
 
-    TC_LOG_INFO("server.loading", "Loading Creature template scaling...");
+    LogLoadingStep("Loading Creature template scaling...");
     sObjectMgr->LoadCreatureScalingData();
 
-    TC_LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
+    LogLoadingStep("Loading Reputation Reward Rates...");
     sObjectMgr->LoadReputationRewardRate();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
+    LogLoadingStep("Loading Creature Reputation OnKill Data...");
     sObjectMgr->LoadReputationOnKill();
 
-    TC_LOG_INFO("server.loading", "Loading Reputation Spillover Data...");
+    LogLoadingStep("Loading Reputation Spillover Data...");
     sObjectMgr->LoadReputationSpilloverTemplate();
 
-    TC_LOG_INFO("server.loading", "Loading Points Of Interest Data...");
+    LogLoadingStep("Loading Points Of Interest Data...");
     sObjectMgr->LoadPointsOfInterest();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Base Stats...");
+    LogLoadingStep("Loading Creature Base Stats...");
     sObjectMgr->LoadCreatureClassLevelStats();
 
-    TC_LOG_INFO("server.loading", "Loading Spawn Group Templates...");
+    LogLoadingStep("Loading Spawn Group Templates...");
     sObjectMgr->LoadSpawnGroupTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading instance spawn groups...");
+    LogLoadingStep("Loading instance spawn groups...");
     sObjectMgr->LoadInstanceSpawnGroups();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Data...");
+    LogLoadingStep("Loading Creature Data...");
     sObjectMgr->LoadCreatures();
 
-    TC_LOG_INFO("server.loading", "Loading Temporary Summon Data...");
+    LogLoadingStep("Loading Temporary Summon Data...");
     sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
 
-    TC_LOG_INFO("server.loading", "Loading pet levelup spells...");
+    LogLoadingStep("Loading pet levelup spells...");
     sSpellMgr->LoadPetLevelupSpellMap();
 
-    TC_LOG_INFO("server.loading", "Loading pet default spells additional to levelup spells...");
+    LogLoadingStep("Loading pet default spells additional to levelup spells...");
     sSpellMgr->LoadPetDefaultSpells();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Addon Data...");
+    LogLoadingStep("Loading Creature Addon Data...");
     sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
 
-    TC_LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
+    LogLoadingStep("Loading Creature Movement Overrides...");
     sObjectMgr->LoadCreatureMovementOverrides();                 // must be after LoadCreatures()
 
-    TC_LOG_INFO("server.loading", "Loading Gameobject Data...");
+    LogLoadingStep("Loading Gameobject Data...");
     sObjectMgr->LoadGameObjects();
 
-    TC_LOG_INFO("server.loading", "Loading Spawn Group Data...");
+    LogLoadingStep("Loading Spawn Group Data...");
     sObjectMgr->LoadSpawnGroups();
 
-    TC_LOG_INFO("server.loading", "Loading GameObject Addon Data...");
+    LogLoadingStep("Loading GameObject Addon Data...");
     sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjects()
 
-    TC_LOG_INFO("server.loading", "Loading GameObject faction and flags overrides...");
+    LogLoadingStep("Loading GameObject faction and flags overrides...");
     sObjectMgr->LoadGameObjectOverrides();                       // must be after LoadGameObjects()
 
-    TC_LOG_INFO("server.loading", "Loading GameObject Quest Items...");
+    LogLoadingStep("Loading GameObject Quest Items...");
     sObjectMgr->LoadGameObjectQuestItems();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Quest Items...");
+    LogLoadingStep("Loading Creature Quest Items...");
     sObjectMgr->LoadCreatureQuestItems();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
+    LogLoadingStep("Loading Creature Linked Respawn...");
     sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
 
-    TC_LOG_INFO("server.loading", "Loading Weather Data...");
+    LogLoadingStep("Loading Weather Data...");
     WeatherMgr::LoadWeatherData();
 
-    TC_LOG_INFO("server.loading", "Loading Quests...");
+    LogLoadingStep("Loading Quests...");
     sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, items, gameobject tables
 
-    TC_LOG_INFO("server.loading", "Checking Quest Disables");
+    LogLoadingStep("Checking Quest Disables");
     DisableMgr::CheckQuestDisables();                           // must be after loading quests
 
-    TC_LOG_INFO("server.loading", "Loading Quest POI");
+    LogLoadingStep("Loading Quest POI");
     sObjectMgr->LoadQuestPOI();
 
-    TC_LOG_INFO("server.loading", "Loading Quests Starters and Enders...");
+    LogLoadingStep("Loading Quests Starters and Enders...");
     sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
 
-    TC_LOG_INFO("server.loading", "Loading Quest Greetings...");
+    LogLoadingStep("Loading Quest Greetings...");
     sObjectMgr->LoadQuestGreetings();
     sObjectMgr->LoadQuestGreetingLocales();
 
-    TC_LOG_INFO("server.loading", "Loading Objects Pooling Data...");
+    LogLoadingStep("Loading Objects Pooling Data...");
     sPoolMgr->LoadFromDB();
-    TC_LOG_INFO("server.loading", "Loading Quest Pooling Data...");
+    LogLoadingStep("Loading Quest Pooling Data...");
     sQuestPoolMgr->LoadFromDB();                                // must be after quest templates
 
-    TC_LOG_INFO("server.loading", "Loading Game Event Data...");               // must be after loading pools fully
+    LogLoadingStep("Loading Game Event Data...");               // must be after loading pools fully
     sGameEventMgr->LoadFromDB();
 
-    TC_LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
+    LogLoadingStep("Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
     sObjectMgr->LoadNPCSpellClickSpells();
 
-    TC_LOG_INFO("server.loading", "Loading Vehicle Templates...");
+    LogLoadingStep("Loading Vehicle Templates...");
     sObjectMgr->LoadVehicleTemplate();                          // must be after LoadCreatureTemplates()
 
-    TC_LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
+    LogLoadingStep("Loading Vehicle Template Accessories...");
     sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
 
-    TC_LOG_INFO("server.loading", "Loading Vehicle Accessories...");
+    LogLoadingStep("Loading Vehicle Accessories...");
     sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
 
-    TC_LOG_INFO("server.loading", "Loading Vehicle Seat Addon Data...");
+    LogLoadingStep("Loading Vehicle Seat Addon Data...");
     sObjectMgr->LoadVehicleSeatAddon();                         // must be after loading DBC
 
-    TC_LOG_INFO("server.loading", "Loading SpellArea Data...");                // must be after quest load
+    LogLoadingStep("Loading SpellArea Data...");                // must be after quest load
     sSpellMgr->LoadSpellAreas();
 
-    TC_LOG_INFO("server.loading", "Loading World locations...");
+    LogLoadingStep("Loading World locations...");
     sObjectMgr->LoadWorldSafeLocs();                            // must be before LoadAreaTriggerTeleports and LoadGraveyardZones
 
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger definitions...");
+    LogLoadingStep("Loading AreaTrigger definitions...");
     sObjectMgr->LoadAreaTriggerTeleports();
 
-    TC_LOG_INFO("server.loading", "Loading Access Requirements...");
+    LogLoadingStep("Loading Access Requirements...");
     sObjectMgr->LoadAccessRequirements();                        // must be after item template load
 
-    TC_LOG_INFO("server.loading", "Loading Quest Area Triggers...");
+    LogLoadingStep("Loading Quest Area Triggers...");
     sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
 
-    TC_LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
+    LogLoadingStep("Loading Tavern Area Triggers...");
     sObjectMgr->LoadTavernAreaTriggers();
 
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger script names...");
+    LogLoadingStep("Loading AreaTrigger script names...");
     sObjectMgr->LoadAreaTriggerScripts();
 
-    TC_LOG_INFO("server.loading", "Loading LFG entrance positions..."); // Must be after areatriggers
+    LogLoadingStep("Loading LFG entrance positions..."); // Must be after areatriggers
     sLFGMgr->LoadLFGDungeons();
 
-    TC_LOG_INFO("server.loading", "Loading Dungeon boss data...");
+    LogLoadingStep("Loading Dungeon boss data...");
     sObjectMgr->LoadInstanceEncounters();
 
-    TC_LOG_INFO("server.loading", "Loading LFG rewards...");
+    LogLoadingStep("Loading LFG rewards...");
     sLFGMgr->LoadRewards();
 
-    TC_LOG_INFO("server.loading", "Loading Graveyard-zone links...");
+    LogLoadingStep("Loading Graveyard-zone links...");
     sObjectMgr->LoadGraveyardZones();
 
-    TC_LOG_INFO("server.loading", "Loading spell pet auras...");
+    LogLoadingStep("Loading spell pet auras...");
     sSpellMgr->LoadSpellPetAuras();
 
-    TC_LOG_INFO("server.loading", "Loading Spell target coordinates...");
+    LogLoadingStep("Loading Spell target coordinates...");
     sSpellMgr->LoadSpellTargetPositions();
 
-    TC_LOG_INFO("server.loading", "Loading linked spells...");
+    LogLoadingStep("Loading linked spells...");
     sSpellMgr->LoadSpellLinked();
 
-    TC_LOG_INFO("server.loading", "Loading Scenes Templates..."); // must be before LoadPlayerInfo
+    LogLoadingStep("Loading Scenes Templates..."); // must be before LoadPlayerInfo
     sObjectMgr->LoadSceneTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading Player Create Data...");
+    LogLoadingStep("Loading Player Create Data...");
     sObjectMgr->LoadPlayerInfo();
 
-    TC_LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
+    LogLoadingStep("Loading Exploration BaseXP Data...");
     sObjectMgr->LoadExplorationBaseXP();
 
-    TC_LOG_INFO("server.loading", "Loading Pet Name Parts...");
+    LogLoadingStep("Loading Pet Name Parts...");
     sObjectMgr->LoadPetNames();
 
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger Templates...");
+    LogLoadingStep("Loading AreaTrigger Templates...");
     sAreaTriggerDataStore->LoadAreaTriggerTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger Spawns...");
+    LogLoadingStep("Loading AreaTrigger Spawns...");
     sAreaTriggerDataStore->LoadAreaTriggerSpawns();
 
-    TC_LOG_INFO("server.loading", "Loading Conversation Templates...");
+    LogLoadingStep("Loading Conversation Templates...");
     sConversationDataStore->LoadConversationTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading Player Choices...");
+    LogLoadingStep("Loading Player Choices...");
     sObjectMgr->LoadPlayerChoices();
 
-    TC_LOG_INFO("server.loading", "Loading Player Choices Locales...");
+    LogLoadingStep("Loading Player Choices Locales...");
     sObjectMgr->LoadPlayerChoicesLocale();
 
-    TC_LOG_INFO("server.loading", "Loading Jump Charge Params...");
+    LogLoadingStep("Loading Jump Charge Params...");
     sObjectMgr->LoadJumpChargeParams();
 
     CharacterDatabaseCleaner::CleanDatabase();
 
-    TC_LOG_INFO("server.loading", "Loading the max pet number...");
+    LogLoadingStep("Loading the max pet number...");
     sObjectMgr->LoadPetNumber();
 
-    TC_LOG_INFO("server.loading", "Loading pet level stats...");
+    LogLoadingStep("Loading pet level stats...");
     sObjectMgr->LoadPetLevelInfo();
 
-    TC_LOG_INFO("server.loading", "Loading Player level dependent mail rewards...");
+    LogLoadingStep("Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    TC_LOG_INFO("server.loading", "Loading skill tier info...");
-    sObjectMgr->LoadSkillTiers();
+    {
+        // Loot tables, reference loot must be last because it validates references of all other stores
+        // Skill tables only read spell, item and db2 data that is already loaded at this point
+        Trinity::TaskGraph lootAndSkillLoaders;
+        Trinity::TaskGraph::TaskId lootCreature = lootAndSkillLoaders.AddTask("creature_loot_template", LoadLootTemplates_Creature);
+        Trinity::TaskGraph::TaskId lootFishing = lootAndSkillLoaders.AddTask("fishing_loot_template", LoadLootTemplates_Fishing);
+        Trinity::TaskGraph::TaskId lootGameobject = lootAndSkillLoaders.AddTask("gameobject_loot_template", LoadLootTemplates_Gameobject);
+        Trinity::TaskGraph::TaskId lootItem = lootAndSkillLoaders.AddTask("item_loot_template", LoadLootTemplates_Item);
+        Trinity::TaskGraph::TaskId lootMail = lootAndSkillLoaders.AddTask("mail_loot_template", LoadLootTemplates_Mail);
+        Trinity::TaskGraph::TaskId lootMilling = lootAndSkillLoaders.AddTask("milling_loot_template", LoadLootTemplates_Milling);
+        Trinity::TaskGraph::TaskId lootPickpocketing = lootAndSkillLoaders.AddTask("pickpocketing_loot_template", LoadLootTemplates_Pickpocketing);
+        Trinity::TaskGraph::TaskId lootSkinning = lootAndSkillLoaders.AddTask("skinning_loot_template", LoadLootTemplates_Skinning);
+        Trinity::TaskGraph::TaskId lootDisenchant = lootAndSkillLoaders.AddTask("disenchant_loot_template", LoadLootTemplates_Disenchant);
+        Trinity::TaskGraph::TaskId lootProspecting = lootAndSkillLoaders.AddTask("prospecting_loot_template", LoadLootTemplates_Prospecting);
+        Trinity::TaskGraph::TaskId lootSpell = lootAndSkillLoaders.AddTask("spell_loot_template", LoadLootTemplates_Spell);
+        lootAndSkillLoaders.AddTask("reference_loot_template", LoadLootTemplates_Reference,
+            { lootCreature, lootFishing, lootGameobject, lootItem, lootMail, lootMilling, lootPickpocketing, lootSkinning, lootDisenchant, lootProspecting, lootSpell });
+
+        lootAndSkillLoaders.AddTask("skill_discovery_template", []
+        {
+            LogLoadingStep("Loading Skill Discovery Table...");
+            LoadSkillDiscoveryTable();
+        });
+        lootAndSkillLoaders.AddTask("skill_extra_item_template", []
+        {
+            LogLoadingStep("Loading Skill Extra Item Table...");
+            LoadSkillExtraItemTable();
+        });
+        lootAndSkillLoaders.AddTask("skill_perfect_item_template", []
+        {
+            LogLoadingStep("Loading Skill Perfection Data Table...");
+            LoadSkillPerfectItemTable();
+        });
+        lootAndSkillLoaders.AddTask("skill_fishing_base_level", []
+        {
+            LogLoadingStep("Loading Skill Fishing base level requirements...");
+            sObjectMgr->LoadFishingBaseSkillLevel();
+        });
+        lootAndSkillLoaders.AddTask("skill_tiers", []
+        {
+            LogLoadingStep("Loading skill tier info...");
+            sObjectMgr->LoadSkillTiers();
+        });
+        lootAndSkillLoaders.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    }
 
-    TC_LOG_INFO("server.loading", "Loading Criteria Modifier trees...");
+    LogLoadingStep("Loading Criteria Modifier trees...");
     sCriteriaMgr->LoadCriteriaModifiersTree();
-    TC_LOG_INFO("server.loading", "Loading Criteria Lists...");
+    LogLoadingStep("Loading Criteria Lists...");
     sCriteriaMgr->LoadCriteriaList();
-    TC_LOG_INFO("server.loading", "Loading Criteria Data...");
+    LogLoadingStep("Loading Criteria Data...");
     sCriteriaMgr->LoadCriteriaData();
-    TC_LOG_INFO("server.loading", "Loading Achievements...");
+    LogLoadingStep("Loading Achievements...");
     sAchievementMgr->LoadAchievementReferenceList();
-    TC_LOG_INFO("server.loading", "Loading Achievements Scripts...");
+    LogLoadingStep("Loading Achievements Scripts...");
     sAchievementMgr->LoadAchievementScripts();
-    TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
+    LogLoadingStep("Loading Achievement Rewards...");
     sAchievementMgr->LoadRewards();
-    TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
+    LogLoadingStep("Loading Achievement Reward Locales...");
     sAchievementMgr->LoadRewardLocales();
-    TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
+    LogLoadingStep("Loading Completed Achievements...");
     sAchievementMgr->LoadCompletedAchievements();
 
     // Load before guilds and arena teams
-    TC_LOG_INFO("server.loading", "Loading character cache store...");
+    LogLoadingStep("Loading character cache store...");
     sCharacterCache->LoadCharacterCacheStorage();
 
     ///- Load dynamic data tables from the database
-    TC_LOG_INFO("server.loading", "Loading Auctions...");
+    LogLoadingStep("Loading Auctions...");
     sAuctionMgr->LoadAuctions();
 
     if (m_bool_configs[CONFIG_BLACKMARKET_ENABLED])
     {
-        TC_LOG_INFO("server.loading", "Loading Black Market Templates...");
+        LogLoadingStep("Loading Black Market Templates...");
         sBlackMarketMgr->LoadTemplates();
 
-        TC_LOG_INFO("server.loading", "Loading Black Market Auctions...");
+        LogLoadingStep("Loading Black Market Auctions...");
         sBlackMarketMgr->LoadAuctions();
     }
 
-    TC_LOG_INFO("server.loading", "Loading Guild rewards...");
+    LogLoadingStep("Loading Guild rewards...");
     sGuildMgr->LoadGuildRewards();
 
-    TC_LOG_INFO("server.loading", "Loading Guilds...");
+    LogLoadingStep("Loading Guilds...");
     sGuildMgr->LoadGuilds();
 
-    TC_LOG_INFO("server.loading", "Loading ArenaTeams...");
+    LogLoadingStep("Loading ArenaTeams...");
     sArenaTeamMgr->LoadArenaTeams();
 
-    TC_LOG_INFO("server.loading", "Loading Groups...");
+    LogLoadingStep("Loading Groups...");
     sGroupMgr->LoadGroups();
 
-    TC_LOG_INFO("server.loading", "Loading ReservedNames...");
+    LogLoadingStep("Loading ReservedNames...");
     sObjectMgr->LoadReservedPlayersNames();
 
-    TC_LOG_INFO("server.loading", "Loading GameObjects for quests...");
+    LogLoadingStep("Loading GameObjects for quests...");
     sObjectMgr->LoadGameObjectForQuests();
 
-    TC_LOG_INFO("server.loading", "Loading BattleMasters...");
+    LogLoadingStep("Loading BattleMasters...");
     sBattlegroundMgr->LoadBattleMastersEntry();                 // must be after load CreatureTemplate
 
-    TC_LOG_INFO("server.loading", "Loading GameTeleports...");
+    LogLoadingStep("Loading GameTeleports...");
     sObjectMgr->LoadGameTele();
 
-    TC_LOG_INFO("server.loading", "Loading Trainers...");
+    LogLoadingStep("Loading Trainers...");
     sObjectMgr->LoadTrainers();                                 // must be after load CreatureTemplate
 
-    TC_LOG_INFO("server.loading", "Loading Gossip menu...");
+    LogLoadingStep("Loading Gossip menu...");
     sObjectMgr->LoadGossipMenu();
 
-    TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
+    LogLoadingStep("Loading Gossip menu options...");
     sObjectMgr->LoadGossipMenuItems();
 
-    TC_LOG_INFO("server.loading", "Loading Creature trainers...");
+    LogLoadingStep("Loading Creature trainers...");
     sObjectMgr->LoadCreatureTrainers();                         // must be after LoadGossipMenuItems
 
-    TC_LOG_INFO("server.loading", "Loading Vendors...");
+    LogLoadingStep("Loading Vendors...");
     sObjectMgr->LoadVendors();                                  // must be after load CreatureTemplate and ItemTemplate
 
-    TC_LOG_INFO("server.loading", "Loading Waypoints...");
+    LogLoadingStep("Loading Waypoints...");
     sWaypointMgr->Load();
 
-    TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
+    LogLoadingStep("Loading SmartAI Waypoints...");
     sSmartWaypointMgr->LoadFromDB();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Formations...");
+    LogLoadingStep("Loading Creature Formations...");
     sFormationMgr->LoadCreatureFormations();
 
-    TC_LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
+    LogLoadingStep("Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
 
     sObjectMgr->LoadPhases();
 
-    TC_LOG_INFO("server.loading", "Loading Conditions...");
+    LogLoadingStep("Loading Conditions...");
     sConditionMgr->LoadConditions();
 
-    TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
+    LogLoadingStep("Loading faction change achievement pairs...");
     sObjectMgr->LoadFactionChangeAchievements();
 
-    TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
+    LogLoadingStep("Loading faction change spell pairs...");
     sObjectMgr->LoadFactionChangeSpells();
 
-    TC_LOG_INFO("server.loading", "Loading faction change quest pairs...");
+    LogLoadingStep("Loading faction change quest pairs...");
     sObjectMgr->LoadFactionChangeQuests();
 
-    TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
+    LogLoadingStep("Loading faction change item pairs...");
     sObjectMgr->LoadFactionChangeItems();
 
-    TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
+    LogLoadingStep("Loading faction change reputation pairs...");
     sObjectMgr->LoadFactionChangeReputations();
 
-    TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
+    LogLoadingStep("Loading faction change title pairs...");
     sObjectMgr->LoadFactionChangeTitles();
 
-    TC_LOG_INFO("server.loading", "Loading mount definitions...");
+    LogLoadingStep("Loading mount definitions...");
     CollectionMgr::LoadMountDefinitions();
 
-    TC_LOG_INFO("server.loading", "Loading GM bugs...");
+    LogLoadingStep("Loading GM bugs...");
     sSupportMgr->LoadBugTickets();
 
-    TC_LOG_INFO("server.loading", "Loading GM complaints...");
+    LogLoadingStep("Loading GM complaints...");
     sSupportMgr->LoadComplaintTickets();
 
-    TC_LOG_INFO("server.loading", "Loading GM suggestions...");
+    LogLoadingStep("Loading GM suggestions...");
     sSupportMgr->LoadSuggestionTickets();
 
     /*TC_LOG_INFO("server.loading", "Loading GM surveys...");
     sSupportMgr->LoadSurveys();*/
 
-    TC_LOG_INFO("server.loading", "Loading garrison info...");
+    LogLoadingStep("Loading garrison info...");
     sGarrisonMgr.Initialize();
 
     ///- Handle outdated emails (delete/return)
-    TC_LOG_INFO("server.loading", "Returning old mails...");
+    LogLoadingStep("Returning old mails...");
     sObjectMgr->ReturnOrDeleteOldMails(false);
 
-    TC_LOG_INFO("server.loading", "Loading Autobroadcasts...");
+    LogLoadingStep("Loading Autobroadcasts...");
     LoadAutobroadcasts();
 
     ///- Load and initialize scripts
@@ -2279,45 +2446,48 @@ void World::SetInitialWorldSettings()
     sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
     sObjectMgr->LoadWaypointScripts();
 
-    TC_LOG_INFO("server.loading", "Loading spell script names...");
+    LogLoadingStep("Loading spell script names...");
     sObjectMgr->LoadSpellScriptNames();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Texts...");
+    LogLoadingStep("Loading Creature Texts...");
     sCreatureTextMgr->LoadCreatureTexts();
 
-    TC_LOG_INFO("server.loading", "Loading Creature Text Locales...");
+    LogLoadingStep("Loading Creature Text Locales...");
     sCreatureTextMgr->LoadCreatureTextLocales();
 
-    TC_LOG_INFO("server.loading", "Initializing Scripts...");
+    LogLoadingStep("Initializing Scripts...");
     sScriptMgr->Initialize();
     sScriptMgr->OnConfigLoad(false);                                // must be done after the ScriptMgr has been properly initialized
 
-    TC_LOG_INFO("server.loading", "Validating spell scripts...");
+    LogLoadingStep("Validating spell scripts...");
     sObjectMgr->ValidateSpellScripts();
 
-    TC_LOG_INFO("server.loading", "Loading SmartAI scripts...");
+    LogLoadingStep("Loading SmartAI scripts...");
     sSmartScriptMgr->LoadSmartAIFromDB();
 
-    TC_LOG_INFO("server.loading", "Loading Calendar data...");
+    LogLoadingStep("Loading Calendar data...");
     sCalendarMgr->LoadFromDB();
 
-    TC_LOG_INFO("server.loading", "Loading Petitions...");
+    LogLoadingStep("Loading Petitions...");
     sPetitionMgr->LoadPetitions();
 
-    TC_LOG_INFO("server.loading", "Loading Signatures...");
+    LogLoadingStep("Loading Signatures...");
     sPetitionMgr->LoadSignatures();
 
-    TC_LOG_INFO("server.loading", "Loading Item loot...");
+    LogLoadingStep("Loading Item loot...");
     sLootItemStorage->LoadStorageFromDB();
 
-    TC_LOG_INFO("server.loading", "Initialize query data...");
+    LogLoadingStep("Initialize query data...");
     sObjectMgr->InitializeQueriesData(QUERY_DATA_ALL);
 
-    TC_LOG_INFO("server.loading", "Initialize commands...");
+    LogLoadingStep("Initialize commands...");
     ChatHandler::InitializeCommandTable();
 
+    ///- Reloads must always see live data
+    sResultSnapshotStore->Close();
+
     ///- Initialize game time and timers
-    TC_LOG_INFO("server.loading", "Initialize game time and timers");
+    LogLoadingStep("Initialize game time and timers");
     GameTime::UpdateGameTimers();
 
     LoginDatabase.PExecute("INSERT INTO uptime (realmid, starttime, uptime, revision) VALUES(%u, %u, 0, '%s')",
@@ -2339,6 +2509,9 @@ void World::SetInitialWorldSettings()
 
     m_timers[WUPDATE_PINGDB].SetInterval(getIntConfig(CONFIG_DB_PING_INTERVAL)*MINUTE*IN_MILLISECONDS);    // Mysql ping time in minutes
 
+    m_timers[WUPDATE_COALESCED_WRITES].SetInterval(getIntConfig(CONFIG_DB_COALESCE_WINDOW));
+    CharacterDatabase.SetCoalescedWritesEnabled(getIntConfig(CONFIG_DB_COALESCE_WINDOW) != 0);
+
     m_timers[WUPDATE_GUILDSAVE].SetInterval(getIntConfig(CONFIG_GUILD_SAVE_INTERVAL) * MINUTE * IN_MILLISECONDS);
 
     m_timers[WUPDATE_BLACKMARKET].SetInterval(10 * IN_MILLISECONDS);
@@ -2365,92 +2538,92 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Mail timer set to: " UI64FMTD ", mail return is called every " UI64FMTD " minutes", uint64(mail_timer), uint64(mail_timer_expires));
 
     ///- Initialize MapManager
-    TC_LOG_INFO("server.loading", "Starting Map System");
+    LogLoadingStep("Starting Map System");
     sMapMgr->Initialize();
 
-    TC_LOG_INFO("server.loading", "Starting Game Event system...");
+    LogLoadingStep("Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
 
     // Delete all characters which have been deleted X days before
     Player::DeleteOldCharacters();
 
-    TC_LOG_INFO("server.loading", "Initialize AuctionHouseBot...");
+    LogLoadingStep("Initialize AuctionHouseBot...");
     sAuctionBot->Initialize();
 
-    TC_LOG_INFO("server.loading", "Initializing chat channels...");
+    LogLoadingStep("Initializing chat channels...");
     ChannelMgr::LoadFromDB();
 
-    TC_LOG_INFO("server.loading", "Initializing Opcodes...");
+    LogLoadingStep("Initializing Opcodes...");
     opcodeTable.Initialize();
     WorldPackets::Auth::ConnectTo::InitializeEncryption();
 
-    TC_LOG_INFO("server.loading", "Starting Arena Season...");
+    LogLoadingStep("Starting Arena Season...");
     sGameEventMgr->StartArenaSeason();
 
     sSupportMgr->Initialize();
 
     ///- Initialize Battlegrounds
-    TC_LOG_INFO("server.loading", "Starting Battleground System");
+    LogLoadingStep("Starting Battleground System");
     sBattlegroundMgr->LoadBattlegroundTemplates();
 
     ///- Initialize outdoor pvp
-    TC_LOG_INFO("server.loading", "Starting Outdoor PvP System");
+    LogLoadingStep("Starting Outdoor PvP System");
     sOutdoorPvPMgr->InitOutdoorPvP();
 
     ///- Initialize Battlefield
-    TC_LOG_INFO("server.loading", "Starting Battlefield System");
+    LogLoadingStep("Starting Battlefield System");
     sBattlefieldMgr->InitBattlefield();
 
-    TC_LOG_INFO("server.loading", "Loading Transports...");
+    LogLoadingStep("Loading Transports...");
     sTransportMgr->SpawnContinentTransports();
 
     ///- Initialize Warden
-    TC_LOG_INFO("server.loading", "Loading Warden Checks...");
+    LogLoadingStep("Loading Warden Checks...");
     sWardenCheckMgr->LoadWardenChecks();
 
-    TC_LOG_INFO("server.loading", "Loading Warden Action Overrides...");
+    LogLoadingStep("Loading Warden Action Overrides...");
     sWardenCheckMgr->LoadWardenOverrides();
 
-    TC_LOG_INFO("server.loading", "Deleting expired bans...");
+    LogLoadingStep("Deleting expired bans...");
     LoginDatabase.Execute("DELETE FROM ip_banned WHERE unbandate <= UNIX_TIMESTAMP() AND unbandate<>bandate");      // One-time query
 
-    TC_LOG_INFO("server.loading", "Initializing quest reset times...");
+    LogLoadingStep("Initializing quest reset times...");
     InitQuestResetTimes();
     CheckScheduledResetTimes();
 
-    TC_LOG_INFO("server.loading", "Calculate random battleground reset time...");
+    LogLoadingStep("Calculate random battleground reset time...");
     InitRandomBGResetTime();
 
-    TC_LOG_INFO("server.loading", "Calculate deletion of old calendar events time...");
+    LogLoadingStep("Calculate deletion of old calendar events time...");
     InitCalendarOldEventsDeletionTime();
 
-    TC_LOG_INFO("server.loading", "Calculate guild limitation(s) reset time...");
+    LogLoadingStep("Calculate guild limitation(s) reset time...");
     InitGuildResetTime();
 
-    TC_LOG_INFO("server.loading", "Calculate next currency reset time...");
+    LogLoadingStep("Calculate next currency reset time...");
     InitCurrencyResetTime();
 
-    TC_LOG_INFO("server.loading", "Loading race and class expansion requirements...");
+    LogLoadingStep("Loading race and class expansion requirements...");
     sObjectMgr->LoadRaceAndClassExpansionRequirements();
 
-    TC_LOG_INFO("server.loading", "Loading character templates...");
+    LogLoadingStep("Loading character templates...");
     sCharacterTemplateDataStore->LoadCharacterTemplates();
 
-    TC_LOG_INFO("server.loading", "Loading realm names...");
+    LogLoadingStep("Loading realm names...");
     sObjectMgr->LoadRealmNames();
 
-    TC_LOG_INFO("server.loading", "Loading battle pets info...");
+    LogLoadingStep("Loading battle pets info...");
     BattlePets::BattlePetMgr::Initialize();
 
-    TC_LOG_INFO("server.loading", "Loading scenarios");
+    LogLoadingStep("Loading scenarios");
     sScenarioMgr->LoadDB2Data();
     sScenarioMgr->LoadDBData();
 
-    TC_LOG_INFO("server.loading", "Loading scenario poi data");
+    LogLoadingStep("Loading scenario poi data");
     sScenarioMgr->LoadScenarioPOI();
 
-    TC_LOG_INFO("server.loading", "Loading phase names...");
+    LogLoadingStep("Loading phase names...");
     sObjectMgr->LoadPhaseNames();
 
     // Preload all cells, if required for the base maps
@@ -2466,6 +2639,24 @@ void World::SetInitialWorldSettings()
         });
     }
 
+    // Preload terrain of instanced maps listed in config, new instances of them don't read terrain from disk anymore
+    std::string preloadTerrainMapIds = sConfigMgr->GetStringDefault("InstanceMapPreloadTerrain", "");
+    for (std::string_view mapIdStr : Trinity::Tokenize(preloadTerrainMapIds, ' ', false))
+    {
+        Optional<uint32> mapId = Trinity::StringTo<uint32>(mapIdStr);
+        MapEntry const* mapEntry = mapId ? sMapStore.LookupEntry(*mapId) : nullptr;
+        if (!mapEntry || !mapEntry->Instanceable())
+        {
+            TC_LOG_ERROR("server.loading", "InstanceMapPreloadTerrain: '%s' is not an instanceable map id, skipped.", std::string(mapIdStr).c_str());
+            continue;
+        }
+
+        TC_LOG_INFO("server.loading", "Pre-loading terrain for instanced map %u", *mapId);
+        sMapMgr->CreateBaseMap(*mapId)->PreloadAllTerrain();
+    }
+
+    Trinity::LoadingProfiler::End(getBoolConfig(CONFIG_LOADING_PROFILE));
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
 
     TC_LOG_INFO("server.worldserver", "World initialized in %u minutes %u seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000));
@@ -2522,6 +2713,18 @@ void World::Update(uint32 diff)
 
     sWorldUpdateTime.UpdateWithDiff(diff);
 
+    ///- Keep the packets that led to a lag spike, at most every 5 minutes
+    uint32 lagDumpThreshold = getIntConfig(CONFIG_PACKET_LOG_LAG_DUMP_THRESHOLD);
+    if (lagDumpThreshold && diff >= lagDumpThreshold && currentGameTime >= _lastLagPacketDump + 5 * MINUTE && sPacketLog->IsRingBufferEnabled())
+    {
+        _lastLagPacketDump = currentGameTime;
+        std::string fileName = sLog->GetLogsDir() + Trinity::StringFormat("lag_%s.pkt", TimeToTimestampStr(currentGameTime).c_str());
+        if (sPacketLog->DumpRecentPackets(fileName, 30))
+            TC_LOG_WARN("server.worldserver", "World update took %u ms, writing the packets of the last 30 seconds to %s", diff, fileName.c_str());
+    }
+
+    _housekeepingTimeUsed = 0;
+
     ///- Update the different timers
     for (int i = 0; i < WUPDATE_COUNT; ++i)
     {
@@ -2532,9 +2735,10 @@ void World::Update(uint32 diff)
     }
 
     ///- Update Who List Storage
-    if (m_timers[WUPDATE_WHO_LIST].Passed())
+    if (IsHousekeepingDue(WUPDATE_WHO_LIST))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update who list"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Update who list");
         m_timers[WUPDATE_WHO_LIST].Reset();
         sWhoListStorageMgr->Update();
     }
@@ -2584,9 +2788,10 @@ void World::Update(uint32 diff)
     }
 
     /// <ul><li> Handle auctions when the timer has passed
-    if (m_timers[WUPDATE_AUCTIONS].Passed())
+    if (IsHousekeepingDue(WUPDATE_AUCTIONS))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update expired auctions"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Update expired auctions");
         m_timers[WUPDATE_AUCTIONS].Reset();
 
         ///- Update mails (return old mails with item, or delete them)
@@ -2601,17 +2806,19 @@ void World::Update(uint32 diff)
         sAuctionMgr->Update();
     }
 
-    if (m_timers[WUPDATE_AUCTIONS_PENDING].Passed())
+    if (IsHousekeepingDue(WUPDATE_AUCTIONS_PENDING))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending auctions"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Update pending auctions");
         m_timers[WUPDATE_AUCTIONS_PENDING].Reset();
 
         sAuctionMgr->UpdatePendingAuctions();
     }
 
-    if (m_timers[WUPDATE_BLACKMARKET].Passed())
+    if (IsHousekeepingDue(WUPDATE_BLACKMARKET))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending black market auctions"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Update pending black market auctions");
         m_timers[WUPDATE_BLACKMARKET].Reset();
 
         ///- Update blackmarket, refresh auctions if necessary
@@ -2630,9 +2837,10 @@ void World::Update(uint32 diff)
     }
 
     /// <li> Handle AHBot operations
-    if (m_timers[WUPDATE_AHBOT].Passed())
+    if (IsHousekeepingDue(WUPDATE_AHBOT))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update AHBot"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Update AHBot");
         sAuctionBot->Update();
         m_timers[WUPDATE_AHBOT].Reset();
     }
@@ -2655,9 +2863,10 @@ void World::Update(uint32 diff)
     }
 
     /// <li> Update uptime table
-    if (m_timers[WUPDATE_UPTIME].Passed())
+    if (IsHousekeepingDue(WUPDATE_UPTIME))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update uptime"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Update uptime");
         uint32 tmpDiff = GameTime::GetUptime();
         uint32 maxOnlinePlayers = GetMaxPlayerCount();
 
@@ -2676,9 +2885,10 @@ void World::Update(uint32 diff)
     /// <li> Clean logs table
     if (sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME) > 0) // if not enabled, ignore the timer
     {
-        if (m_timers[WUPDATE_CLEANDB].Passed())
+        if (IsHousekeepingDue(WUPDATE_CLEANDB))
         {
             TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Clean logs table"));
+            HousekeepingTask task(_housekeepingTimeUsed, "Clean logs table");
             m_timers[WUPDATE_CLEANDB].Reset();
 
             LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
@@ -2700,9 +2910,10 @@ void World::Update(uint32 diff)
 
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
-        if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
+        if (IsHousekeepingDue(WUPDATE_AUTOBROADCAST))
         {
             TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Send autobroadcast"));
+            HousekeepingTask task(_housekeepingTimeUsed, "Send autobroadcast");
             m_timers[WUPDATE_AUTOBROADCAST].Reset();
             SendAutoBroadcast();
         }
@@ -2724,9 +2935,10 @@ void World::Update(uint32 diff)
     }
 
     ///- Delete all characters which have been deleted X days before
-    if (m_timers[WUPDATE_DELETECHARS].Passed())
+    if (IsHousekeepingDue(WUPDATE_DELETECHARS))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Delete old characters"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Delete old characters");
         m_timers[WUPDATE_DELETECHARS].Reset();
         Player::DeleteOldCharacters();
     }
@@ -2748,9 +2960,10 @@ void World::Update(uint32 diff)
     }
 
     ///- Erase corpses once every 20 minutes
-    if (m_timers[WUPDATE_CORPSES].Passed())
+    if (IsHousekeepingDue(WUPDATE_CORPSES))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Remove old corpses"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Remove old corpses");
         m_timers[WUPDATE_CORPSES].Reset();
         sMapMgr->DoForAllMaps([](Map* map)
         {
@@ -2779,9 +2992,17 @@ void World::Update(uint32 diff)
         WorldDatabase.KeepAlive();
     }
 
-    if (m_timers[WUPDATE_GUILDSAVE].Passed())
+    ///- Write the single row updates buffered since the last flush
+    if (m_timers[WUPDATE_COALESCED_WRITES].Passed())
+    {
+        m_timers[WUPDATE_COALESCED_WRITES].Reset();
+        CharacterDatabase.FlushCoalescedWrites();
+    }
+
+    if (IsHousekeepingDue(WUPDATE_GUILDSAVE))
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Save guilds"));
+        HousekeepingTask task(_housekeepingTimeUsed, "Save guilds");
         m_timers[WUPDATE_GUILDSAVE].Reset();
         sGuildMgr->SaveGuilds();
     }
@@ -2818,9 +3039,28 @@ void World::Update(uint32 diff)
         // Stats logger update
         sMetric->Update();
         TC_METRIC_VALUE("update_time_diff", diff);
+        TC_METRIC_VALUE("network_queued_bytes", sWorldSocketMgr.GetQueuedBytes());
+        UpdateMemoryAccounting();
+        Trinity::LockProfiler::UpdateMetrics();
     }
 }
 
+bool World::IsHousekeepingDue(WorldTimers timer)
+{
+    if (!m_timers[timer].Passed())
+        return false;
+
+    // the first task of an update always runs, a budget smaller than a single task must not stall housekeeping
+    uint32 budget = getIntConfig(CONFIG_HOUSEKEEPING_TICK_BUDGET);
+    if (budget && _housekeepingTimeUsed >= budget)
+    {
+        TC_LOG_DEBUG("misc", "World::Update: tick budget of %u ms used up (%u ms), housekeeping timer %u postponed to the next update", budget, _housekeepingTimeUsed, uint32(timer));
+        return false;
+    }
+
+    return true;
+}
+
 void World::ForceGameEventUpdate()
 {
     m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
@@ -2832,16 +3072,18 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uint32 team)
 {
-    SessionMap::const_iterator itr;
-    for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+    std::lock_guard<std::mutex> lock(_sessionsByZoneLock);
+    for (auto const& [zoneId, sessions] : _sessionsByZone)
     {
-        if (itr->second &&
-            itr->second->GetPlayer() &&
-            itr->second->GetPlayer()->IsInWorld() &&
-            itr->second != self &&
-            (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
+        for (WorldSession* session : sessions)
         {
-            itr->second->SendPacket(packet);
+            if (session != self &&
+                session->GetPlayer() &&
+                session->GetPlayer()->IsInWorld() &&
+                (team == 0 || session->GetPlayer()->GetTeam() == team))
+            {
+                session->SendPacket(packet);
+            }
         }
     }
 }
@@ -2849,21 +3091,24 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, uin
 /// Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self, uint32 team)
 {
-    for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+    std::lock_guard<std::mutex> lock(_sessionsByZoneLock);
+    for (auto const& [zoneId, sessions] : _sessionsByZone)
     {
-        // check if session and can receive global GM Messages and its not self
-        WorldSession* session = itr->second;
-        if (!session || session == self || !session->HasPermission(rbac::RBAC_PERM_RECEIVE_GLOBAL_GM_TEXTMESSAGE))
-            continue;
-
-        // Player should be in world
-        Player* player = session->GetPlayer();
-        if (!player || !player->IsInWorld())
-            continue;
-
-        // Send only to same team, if team is given
-        if (!team || player->GetTeam() == team)
-            session->SendPacket(packet);
+        for (WorldSession* session : sessions)
+        {
+            // check if session can receive global GM Messages and its not self
+            if (session == self || !session->HasPermission(rbac::RBAC_PERM_RECEIVE_GLOBAL_GM_TEXTMESSAGE))
+                continue;
+
+            // Player should be in world
+            Player* player = session->GetPlayer();
+            if (!player || !player->IsInWorld())
+                continue;
+
+            // Send only to same team, if team is given
+            if (!team || player->GetTeam() == team)
+                session->SendPacket(packet);
+        }
     }
 }
 
@@ -2995,18 +3240,20 @@ void World::SendGlobalText(char const* text, WorldSession* self)
 bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession* self, uint32 team)
 {
     bool foundPlayerToSend = false;
-    SessionMap::const_iterator itr;
 
-    for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+    std::lock_guard<std::mutex> lock(_sessionsByZoneLock);
+    auto itr = _sessionsByZone.find(zone);
+    if (itr == _sessionsByZone.end())
+        return false;
+
+    for (WorldSession* session : itr->second)
     {
-        if (itr->second &&
-            itr->second->GetPlayer() &&
-            itr->second->GetPlayer()->IsInWorld() &&
-            itr->second->GetPlayer()->GetZoneId() == zone &&
-            itr->second != self &&
-            (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
+        if (session != self &&
+            session->GetPlayer() &&
+            session->GetPlayer()->IsInWorld() &&
+            (team == 0 || session->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            session->SendPacket(packet);
             foundPlayerToSend = true;
         }
     }
@@ -3014,6 +3261,34 @@ bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession
     return foundPlayerToSend;
 }
 
+void World::UpdateSessionZone(WorldSession* session, uint32 oldZone, uint32 newZone)
+{
+    if (oldZone == newZone)
+        return;
+
+    std::lock_guard<std::mutex> lock(_sessionsByZoneLock);
+    if (oldZone != MAP_INVALID_ZONE)
+    {
+        auto itr = _sessionsByZone.find(oldZone);
+        if (itr != _sessionsByZone.end())
+        {
+            std::vector<WorldSession*>& sessions = itr->second;
+            auto sessionItr = std::find(sessions.begin(), sessions.end(), session);
+            if (sessionItr != sessions.end())
+            {
+                *sessionItr = sessions.back();
+                sessions.pop_back();
+            }
+
+            if (sessions.empty())
+                _sessionsByZone.erase(itr);
+        }
+    }
+
+    if (newZone != MAP_INVALID_ZONE)
+        _sessionsByZone[newZone].push_back(session);
+}
+
 /// Send a System Message to all players in the zone (except self if mentioned)
 void World::SendZoneText(uint32 zone, char const* text, WorldSession* self, uint32 team)
 {
@@ -3072,6 +3347,7 @@ BanReturn World::BanAccount(BanMode mode, std::string const& nameOrIP, uint32 du
             stmt->setString(2, author);
             stmt->setString(3, reason);
             LoginDatabase.Execute(stmt);
+            sIpBanCache->AddBan(nameOrIP, duration_secs);
             break;
         }
         case BAN_ACCOUNT:
@@ -3143,6 +3419,7 @@ bool World::RemoveBanAccount(BanMode mode, std::string const& nameOrIP)
         stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_IP_NOT_BANNED);
         stmt->setString(0, nameOrIP);
         LoginDatabase.Execute(stmt);
+        sIpBanCache->RemoveBan(nameOrIP);
     }
     else
     {
@@ -3340,6 +3617,7 @@ void World::SendServerMessage(ServerMessageType messageID, std::string stringPar
 
 void World::UpdateSessions(uint32 diff)
 {
+    Trinity::HeapProfiler::Scope heapProfilerScope("sessions");
     std::pair<std::weak_ptr<WorldSocket>, uint64> linkInfo;
     while (_linkSocketQueue.next(linkInfo))
         ProcessLinkInstanceSocket(std::move(linkInfo));
@@ -3355,6 +3633,9 @@ void World::UpdateSessions(uint32 diff)
     }
 
     ///- Then send an update signal to remaining ones
+    /// Thread-safe packets of players in world are already handled by MapSessionFilter in Map::Update
+    /// on the map update threads; this pass only runs thread-unsafe handlers, logout, Warden and
+    /// socket cleanup, which touch global state and must stay serialized on the world thread.
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
         next = itr;
@@ -3833,7 +4114,7 @@ void World::setWorldState(uint32 index, uint32 value)
         stmt->setUInt32(0, uint32(value));
         stmt->setUInt32(1, index);
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.ExecuteCoalesced(stmt, index);
     }
     else
     {
@@ -3855,9 +4136,23 @@ uint32 World::getWorldState(uint32 index) const
 
 void World::ProcessQueryCallbacks()
 {
+    Trinity::HeapProfiler::Scope heapProfilerScope("database");
     _queryProcessor.ProcessReadyCallbacks();
 }
 
+void World::UpdateMemoryAccounting()
+{
+    using Trinity::MemoryAccounting;
+    using Trinity::MemoryCategory;
+
+    MemoryAccounting::Set(MemoryCategory::ObjectMgr, sObjectMgr->GetMemoryUsage());
+    MemoryAccounting::Set(MemoryCategory::AuctionHouse, sAuctionMgr->GetMemoryUsage());
+    MemoryAccounting::Set(MemoryCategory::Sessions, m_sessions.size() * sizeof(WorldSession)
+        + MemoryAccounting::EstimateNodeContainer(m_sessions) + sWorldSocketMgr.GetQueuedBytes());
+
+    MemoryAccounting::UpdateMetrics();
+}
+
 void World::ReloadRBAC()
 {
     // Passive reload, we mark the data as invalidated and next time a permission is checked it will be reloaded
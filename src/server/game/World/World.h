@@ -94,6 +94,7 @@ enum WorldTimers
     WUPDATE_CHECK_FILECHANGES,
     WUPDATE_WHO_LIST,
     WUPDATE_CHANNEL_SAVE,
+    WUPDATE_COALESCED_WRITES,
     WUPDATE_COUNT
 };
 
@@ -195,6 +196,7 @@ enum WorldBoolConfigs
     CONFIG_RESPAWN_DYNAMIC_ESCORTNPC,
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
     CONFIG_CHARACTER_CREATING_DISABLE_ALLIED_RACE_ACHIEVEMENT_REQUIREMENT,
+    CONFIG_LOADING_PROFILE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -206,6 +208,7 @@ enum WorldFloatConfigs
     CONFIG_LISTEN_RANGE_SAY,
     CONFIG_LISTEN_RANGE_TEXTEMOTE,
     CONFIG_LISTEN_RANGE_YELL,
+    CONFIG_LISTEN_RANGE_COMBAT_LOG,
     CONFIG_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS,
     CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS,
     CONFIG_THREAT_RADIUS,
@@ -222,6 +225,7 @@ enum WorldFloatConfigs
     CONFIG_CALL_TO_ARMS_5_PCT,
     CONFIG_CALL_TO_ARMS_10_PCT,
     CONFIG_CALL_TO_ARMS_20_PCT,
+    CONFIG_CREATURE_LOW_UPDATE_RATE_DISTANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -230,7 +234,11 @@ enum WorldIntConfigs
     CONFIG_COMPRESSION = 0,
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_GRIDCLEAN,
+    CONFIG_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_GRID_UNLOAD_MAX_PER_UPDATE,
+    CONFIG_GRID_UNLOAD_MAX_EXPIRY_SCALE,
     CONFIG_INTERVAL_MAPUPDATE,
+    CONFIG_INTERVAL_MAPUPDATE_IDLE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
     CONFIG_PORT_WORLD,
@@ -345,6 +353,9 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_PATHFINDING_CACHE_SIZE,
+    CONFIG_PATHFINDING_ASYNC_WORKERS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -364,6 +375,7 @@ enum WorldIntConfigs
     CONFIG_AUTOBROADCAST_INTERVAL,
     CONFIG_MAX_RESULTS_LOOKUP_COMMANDS,
     CONFIG_DB_PING_INTERVAL,
+    CONFIG_DB_COALESCE_WINDOW,
     CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION,
     CONFIG_PRESERVE_CUSTOM_CHANNEL_INTERVAL,
     CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS,
@@ -403,6 +415,7 @@ enum WorldIntConfigs
     CONFIG_BG_REWARD_WINNER_CONQUEST_LAST,
     CONFIG_CREATURE_PICKPOCKET_REFILL,
     CONFIG_CREATURE_STOP_FOR_PLAYER,
+    CONFIG_CREATURE_LOW_UPDATE_RATE_INTERVAL,
     CONFIG_AHBOT_UPDATE_INTERVAL,
     CONFIG_FEATURE_SYSTEM_CHARACTER_UNDELETE_COOLDOWN,
     CONFIG_CHARTER_COST_GUILD,
@@ -414,6 +427,7 @@ enum WorldIntConfigs
     CONFIG_AUCTION_REPLICATE_DELAY,
     CONFIG_AUCTION_SEARCH_DELAY,
     CONFIG_AUCTION_TAINTED_SEARCH_DELAY,
+    CONFIG_AUCTION_MAX_EXPIRED_PER_UPDATE,
     CONFIG_TALENTS_INSPECTING,
     CONFIG_RESPAWN_MINCHECKINTERVALMS,
     CONFIG_RESPAWN_DYNAMICMODE,
@@ -427,6 +441,9 @@ enum WorldIntConfigs
     CONFIG_BLACKMARKET_MAXAUCTIONS,
     CONFIG_BLACKMARKET_UPDATE_PERIOD,
     CONFIG_FACTION_BALANCE_LEVEL_CHECK_DIFF,
+    CONFIG_HOUSEKEEPING_TICK_BUDGET,
+    CONFIG_PACKET_LOG_LAG_DUMP_THRESHOLD,
+    CONFIG_HOTSWAP_MAX_PARALLEL_BUILDS,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -671,6 +688,7 @@ class TC_GAME_API World
         }
 
         void SetInitialWorldSettings();
+        void InitializeWorldDatabaseSnapshots();
         void LoadConfigSettings(bool reload = false);
 
         void SendWorldText(uint32 string_id, ...);
@@ -682,6 +700,9 @@ class TC_GAME_API World
         bool SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession* self = nullptr, uint32 team = 0);
         void SendZoneText(uint32 zone, const char *text, WorldSession* self = nullptr, uint32 team = 0);
 
+        // keeps the sessions of players in world indexed by zone for the broadcasts above, called from Player::UpdateZone (map threads)
+        void UpdateSessionZone(WorldSession* session, uint32 oldZone, uint32 newZone);
+
         /// Are we in the middle of a shutdown?
         bool IsShuttingDown() const { return m_ShutdownTimer > 0; }
         uint32 GetShutDownTimeLeft() const { return m_ShutdownTimer; }
@@ -840,12 +861,18 @@ class TC_GAME_API World
         bool m_isClosed;
 
         IntervalTimer m_timers[WUPDATE_COUNT];
+        // timer driven housekeeping shares CONFIG_HOUSEKEEPING_TICK_BUDGET per update, passed timers that do not fit stay passed until a later update
+        bool IsHousekeepingDue(WorldTimers timer);
+        uint32 _housekeepingTimeUsed;
+        time_t _lastLagPacketDump;
         time_t mail_timer;
         time_t mail_timer_expires;
         time_t blackmarket_timer;
 
         SessionMap m_sessions;
         std::unordered_multimap<ObjectGuid, WorldSession*> m_sessionsByBnetGuid;
+        std::unordered_map<uint32 /*zoneId*/, std::vector<WorldSession*>> _sessionsByZone;
+        std::mutex _sessionsByZoneLock;
         typedef std::unordered_map<uint32, time_t> DisconnectMap;
         DisconnectMap m_disconnects;
         uint32 m_maxActiveSessionCount;
@@ -914,6 +941,9 @@ class TC_GAME_API World
 
         void ProcessQueryCallbacks();
 
+        // refreshes the estimated Trinity::MemoryAccounting categories and exports all of them as metrics
+        void UpdateMemoryAccounting();
+
         void SendGuidWarning();
         void DoGuidWarningRestart();
         void DoGuidAlertRestart();
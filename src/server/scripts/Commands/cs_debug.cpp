@@ -36,6 +36,7 @@ EndScriptData */
 #include "GameTime.h"
 #include "GossipDef.h"
 #include "GridNotifiersImpl.h"
+#include "HeapProfiler.h"
 #include "InstanceScript.h"
 #include "Language.h"
 #include "Log.h"
@@ -44,6 +45,7 @@ EndScriptData */
 #include "MovementPackets.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "PacketReplay.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
 #include "QuestPools.h"
@@ -51,6 +53,7 @@ EndScriptData */
 #include "SpellMgr.h"
 #include "SpellPackets.h"
 #include "Transport.h"
+#include "Util.h"
 #include "Warden.h"
 #include "World.h"
 #include "WorldSession.h"
@@ -103,6 +106,12 @@ public:
         {
             { "force",         rbac::RBAC_PERM_COMMAND_DEBUG,                    true,  &HandleDebugWardenForce,        "" }
         };
+        static std::vector<ChatCommand> debugHeapProfileCommandTable =
+        {
+            { "start",         rbac::RBAC_PERM_COMMAND_DEBUG,                    true,  &HandleDebugHeapProfileStartCommand, "" },
+            { "dump",          rbac::RBAC_PERM_COMMAND_DEBUG,                    true,  &HandleDebugHeapProfileDumpCommand,  "" },
+            { "stop",          rbac::RBAC_PERM_COMMAND_DEBUG,                    true,  &HandleDebugHeapProfileStopCommand,  "" },
+        };
         static std::vector<ChatCommand> debugCommandTable =
         {
             { "threat",        rbac::RBAC_PERM_COMMAND_DEBUG_THREAT,        false, &HandleDebugThreatListCommand,       "" },
@@ -139,7 +148,9 @@ public:
             { "guidlimits",    rbac::RBAC_PERM_COMMAND_DEBUG,               true,  &HandleDebugGuidLimitsCommand,       "" },
             { "objectcount",   rbac::RBAC_PERM_COMMAND_DEBUG,               true,  &HandleDebugObjectCountCommand,      "" },
             { "questreset",    rbac::RBAC_PERM_COMMAND_DEBUG_QUESTRESET,    true,  &HandleDebugQuestResetCommand,       "" },
+            { "replay",        rbac::RBAC_PERM_COMMAND_DEBUG,               false, &HandleDebugReplayCommand,           "" },
             { "warden",        rbac::RBAC_PERM_COMMAND_DEBUG,               true,  nullptr,                             "", debugWardenCommandTable },
+            { "heapprofile",   rbac::RBAC_PERM_COMMAND_DEBUG,               true,  nullptr,                             "", debugHeapProfileCommandTable },
             { "personalclone", rbac::RBAC_PERM_COMMAND_DEBUG,               false, &HandleDebugBecomePersonalClone,     "" }
         };
         static std::vector<ChatCommand> commandTable =
@@ -206,7 +217,7 @@ public:
         }
 
         // Dump camera locations
-        if (std::vector<FlyByCamera> const* flyByCameras = GetFlyByCameras(cineSeq->Camera[0]))
+        if (std::shared_ptr<FlyByCameraCollection const> flyByCameras = GetFlyByCameras(cineSeq->Camera[0]))
         {
             handler->PSendSysMessage("Waypoints for sequence %u, camera %u", cinematicId, cineSeq->Camera[0]);
             uint32 count = 1;
@@ -1604,6 +1615,91 @@ public:
         return true;
     }
 
+    // Syntax: .debug replay <file> [speed%]
+    // Replays client packets of a PacketLogFile recording (relative to LogsDir) into the selected player's session
+    static bool HandleDebugReplayCommand(ChatHandler* handler, std::string fileName, Optional<uint32> speedPct)
+    {
+        Player* player = handler->getSelectedPlayerOrSelf();
+        if (!player)
+        {
+            handler->SendSysMessage(LANG_NO_CHAR_SELECTED);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        std::vector<PacketReplayRecord> packets;
+        std::string error;
+        if (!PacketReplay::LoadFile(sLog->GetLogsDir() + fileName, packets, error))
+        {
+            handler->PSendSysMessage("Could not load packet log %s: %s", fileName.c_str(), error.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Replaying %u packets into %s, total recorded time %u ms", uint32(packets.size()), player->GetName().c_str(),
+            packets.empty() ? 0 : packets.back().Time);
+        PacketReplay::Start(player, std::move(packets), speedPct.value_or(100));
+        return true;
+    }
+
+    // Syntax: .debug heapprofile start [sample interval in KiB]
+    static bool HandleDebugHeapProfileStartCommand(ChatHandler* handler, Optional<uint32> sampleKiB)
+    {
+        uint32 sampleInterval = sampleKiB ? *sampleKiB * 1024 : Trinity::HeapProfiler::DefaultSampleInterval;
+
+        std::string error;
+        if (!Trinity::HeapProfiler::Start(sampleInterval, sLog->GetLogsDir() + "heapprofile", error))
+        {
+            handler->PSendSysMessage("Could not start heap profiling: %s", error.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Heap profiling started using %s", Trinity::HeapProfiler::GetBackendName(Trinity::HeapProfiler::GetRunningBackend()));
+        return true;
+    }
+
+    // Syntax: .debug heapprofile dump [filename]
+    // Writes the profile of the allocations still alive (relative to LogsDir), tcmalloc names the file itself
+    static bool HandleDebugHeapProfileDumpCommand(ChatHandler* handler, Optional<std::string> fileName)
+    {
+        std::string path = sLog->GetLogsDir() + fileName.value_or(Trinity::StringFormat("heapprofile_%s.txt", TimeToTimestampStr(GameTime::GetGameTime()).c_str()));
+
+        std::string error;
+        if (!Trinity::HeapProfiler::Dump(path, error))
+        {
+            handler->PSendSysMessage("Could not dump heap profile: %s", error.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (Trinity::HeapProfiler::GetRunningBackend() == Trinity::HeapProfiler::Backend::Tcmalloc)
+        {
+            handler->PSendSysMessage("Heap profile written next to %sheapprofile", sLog->GetLogsDir().c_str());
+            return true;
+        }
+
+        handler->PSendSysMessage("Heap profile written to %s", path.c_str());
+        for (Trinity::HeapProfiler::TagStats const& stats : Trinity::HeapProfiler::GetSampledStats())
+            handler->PSendSysMessage("  %s: ~%.2f MiB in ~" UI64FMTD " allocations", stats.Tag, stats.Bytes / (1024.0 * 1024.0), stats.Allocations);
+
+        return true;
+    }
+
+    static bool HandleDebugHeapProfileStopCommand(ChatHandler* handler)
+    {
+        if (Trinity::HeapProfiler::GetRunningBackend() == Trinity::HeapProfiler::Backend::None)
+        {
+            handler->SendSysMessage("Heap profiling is not running.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        Trinity::HeapProfiler::Stop();
+        handler->SendSysMessage("Heap profiling stopped.");
+        return true;
+    }
+
     static bool HandleDebugGuidLimitsCommand(ChatHandler* handler, Optional<uint32> mapId)
     {
         if (mapId)
@@ -37,6 +37,7 @@ EndScriptData */
 #include "ItemEnchantmentMgr.h"
 #include "Language.h"
 #include "LFGMgr.h"
+#include "LoadingProfiler.h"
 #include "Log.h"
 #include "LootMgr.h"
 #include "MapManager.h"
@@ -186,34 +187,48 @@ public:
 
     static bool HandleReloadAllCommand(ChatHandler* handler, char const* /*args*/)
     {
-        HandleReloadSkillFishingBaseLevelCommand(handler, "");
-
-        HandleReloadAllAchievementCommand(handler, "");
-        HandleReloadAllAreaCommand(handler, "");
-        HandleReloadAllLootCommand(handler, "");
-        HandleReloadAllNpcCommand(handler, "");
-        HandleReloadAllQuestCommand(handler, "");
-        HandleReloadAllSpellCommand(handler, "");
-        HandleReloadAllItemCommand(handler, "");
-        HandleReloadAllGossipsCommand(handler, "");
-        HandleReloadAllLocalesCommand(handler, "");
-
-        HandleReloadAccessRequirementCommand(handler, "");
-        HandleReloadMailLevelRewardCommand(handler, "");
-        HandleReloadCommandCommand(handler, "");
-        HandleReloadReservedNameCommand(handler, "");
-        HandleReloadTrinityStringCommand(handler, "");
-        HandleReloadGameTeleCommand(handler, "");
-
-        HandleReloadCreatureMovementOverrideCommand(handler, "");
+        bool profiled = Trinity::LoadingProfiler::Begin("reload_all");
+
+        // every part is a step of the loading profile
+        auto reload = [handler](char const* step, bool(*reloadHandler)(ChatHandler*, char const*))
+        {
+            Trinity::LoadingProfiler::Step(step);
+            reloadHandler(handler, "");
+        };
+
+        reload("skill_fishing_base_level", &HandleReloadSkillFishingBaseLevelCommand);
+
+        reload("all_achievement", &HandleReloadAllAchievementCommand);
+        reload("all_area", &HandleReloadAllAreaCommand);
+        reload("all_loot", &HandleReloadAllLootCommand);
+        reload("all_npc", &HandleReloadAllNpcCommand);
+        reload("all_quest", &HandleReloadAllQuestCommand);
+        reload("all_spell", &HandleReloadAllSpellCommand);
+        reload("all_item", &HandleReloadAllItemCommand);
+        reload("all_gossips", &HandleReloadAllGossipsCommand);
+        reload("all_locales", &HandleReloadAllLocalesCommand);
+
+        reload("access_requirement", &HandleReloadAccessRequirementCommand);
+        reload("mail_level_reward", &HandleReloadMailLevelRewardCommand);
+        reload("command", &HandleReloadCommandCommand);
+        reload("reserved_name", &HandleReloadReservedNameCommand);
+        reload("trinity_string", &HandleReloadTrinityStringCommand);
+        reload("game_tele", &HandleReloadGameTeleCommand);
+
+        reload("creature_movement_override", &HandleReloadCreatureMovementOverrideCommand);
+        Trinity::LoadingProfiler::Step("creature_summon_groups");
         HandleReloadCreatureSummonGroupsCommand(handler);
 
-        HandleReloadVehicleAccessoryCommand(handler, "");
-        HandleReloadVehicleTemplateAccessoryCommand(handler, "");
+        reload("vehicle_accessory", &HandleReloadVehicleAccessoryCommand);
+        reload("vehicle_template_accessory", &HandleReloadVehicleTemplateAccessoryCommand);
+
+        reload("autobroadcast", &HandleReloadAutobroadcastCommand);
+        reload("battleground_template", &HandleReloadBattlegroundTemplate);
+        reload("character_template", &HandleReloadCharacterTemplate);
+
+        if (profiled)
+            Trinity::LoadingProfiler::End(sWorld->getBoolConfig(CONFIG_LOADING_PROFILE));
 
-        HandleReloadAutobroadcastCommand(handler, "");
-        HandleReloadBattlegroundTemplate(handler, "");
-        HandleReloadCharacterTemplate(handler, "");
         return true;
     }
 
@@ -880,6 +895,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Page Text...");
         sObjectMgr->LoadPageTexts();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_PAGE_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `page_text` reloaded.");
         return true;
     }
@@ -1027,6 +1043,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Creature Template Locale...");
         sObjectMgr->LoadCreatureLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_CREATURES);
         handler->SendGlobalGMSysMessage("DB table `creature_template_locale` reloaded.");
         return true;
     }
@@ -1043,6 +1060,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Gameobject Template Locale... ");
         sObjectMgr->LoadGameObjectLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_GAMEOBJECTS);
         handler->SendGlobalGMSysMessage("DB table `gameobject_template_locale` reloaded.");
         return true;
     }
@@ -1059,6 +1077,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Page Text Locale... ");
         sObjectMgr->LoadPageTextLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_PAGE_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `page_text_locale` reloaded.");
         return true;
     }
@@ -1079,6 +1098,7 @@ public:
         sObjectMgr->LoadQuestGreetingLocales();
         sObjectMgr->LoadQuestOfferRewardLocale();
         sObjectMgr->LoadQuestRequestItemsLocale();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_QUESTS);
         handler->SendGlobalGMSysMessage("DB table `quest_template_locale` reloaded.");
         handler->SendGlobalGMSysMessage("DB table `quest_objectives_locale` reloaded.");
         handler->SendGlobalGMSysMessage("DB table `quest_greeting_locale` reloaded.");
@@ -27,12 +27,19 @@ EndScriptData */
 #include "Config.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
+#include "DB2Stores.h"
 #include "GameTime.h"
 #include "GitRevision.h"
+#include "InstrumentedMutex.h"
 #include "Language.h"
 #include "Log.h"
+#include "MapBenchmark.h"
+#include "MapManager.h"
+#include "MemoryAccounting.h"
+#include "Metric.h"
 #include "MySQLThreading.h"
 #include "ObjectAccessor.h"
+#include "PacketLog.h"
 #include "Player.h"
 #include "RBAC.h"
 #include "Realm.h"
@@ -92,16 +99,22 @@ public:
         static std::vector<ChatCommand> serverCommandTable =
         {
             { "corpses",      rbac::RBAC_PERM_COMMAND_SERVER_CORPSES,      true, &HandleServerCorpsesCommand, "" },
+            { "dbstats",      rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerDBStatsCommand, "" },
             { "debug",        rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerDebugCommand,   "" },
             { "exit",         rbac::RBAC_PERM_COMMAND_SERVER_EXIT,         true, &HandleServerExitCommand,    "" },
             { "idlerestart",  rbac::RBAC_PERM_COMMAND_SERVER_IDLERESTART,  true, nullptr,                     "", serverIdleRestartCommandTable },
             { "idleshutdown", rbac::RBAC_PERM_COMMAND_SERVER_IDLESHUTDOWN, true, nullptr,                     "", serverIdleShutdownCommandTable },
             { "info",         rbac::RBAC_PERM_COMMAND_SERVER_INFO,         true, &HandleServerInfoCommand,    "" },
+            { "locks",        rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerLocksCommand,   "" },
+            { "mapbench",     rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerMapBenchCommand, "" },
+            { "memory",       rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerMemoryCommand,  "" },
             { "motd",         rbac::RBAC_PERM_COMMAND_SERVER_MOTD,         true, &HandleServerMotdCommand,    "" },
+            { "packetdump",   rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerPacketDumpCommand, "" },
             { "plimit",       rbac::RBAC_PERM_COMMAND_SERVER_PLIMIT,       true, &HandleServerPLimitCommand,  "" },
             { "restart",      rbac::RBAC_PERM_COMMAND_SERVER_RESTART,      true, nullptr,                     "", serverRestartCommandTable },
             { "shutdown",     rbac::RBAC_PERM_COMMAND_SERVER_SHUTDOWN,     true, nullptr,                     "", serverShutdownCommandTable },
             { "set",          rbac::RBAC_PERM_COMMAND_SERVER_SET,          true, nullptr,                     "", serverSetCommandTable },
+            { "trace",        rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerTraceCommand,   "" },
         };
 
         static std::vector<ChatCommand> commandTable =
@@ -118,6 +131,184 @@ public:
         return true;
     }
 
+    template <class T>
+    static void SendDatabaseStats(ChatHandler* handler, DatabaseWorkerPool<T>& database, uint32 limit)
+    {
+        SQLExecutionStatsData queueWait = database.GetQueueWaitStats();
+        handler->PSendSysMessage("%s: %u queued, %" PRIu64 " async operations waited avg %" PRIu64 " us, max %" PRIu64 " us, %" PRIu64 " writes coalesced",
+            database.GetDatabaseName(), uint32(database.GetQueueSize()), queueWait.Count,
+            queueWait.Count ? queueWait.TotalMicroseconds / queueWait.Count : 0, queueWait.MaxMicroseconds, database.GetCoalescedWriteCount());
+
+        std::vector<SQLExecutionStatsData> stats = database.GetStatementStats();
+        std::vector<uint32> indexes;
+        for (uint32 i = 0; i < stats.size(); ++i)
+            if (stats[i].Count)
+                indexes.push_back(i);
+
+        std::sort(indexes.begin(), indexes.end(), [&stats](uint32 left, uint32 right)
+        {
+            return stats[left].TotalMicroseconds > stats[right].TotalMicroseconds;
+        });
+
+        if (indexes.size() > limit)
+            indexes.resize(limit);
+
+        for (uint32 index : indexes)
+        {
+            SQLExecutionStatsData const& statement = stats[index];
+            handler->PSendSysMessage("  #%u: %" PRIu64 " calls, avg %" PRIu64 " us, max %" PRIu64 " us, %" PRIu64 " rows - %s",
+                index, statement.Count, statement.TotalMicroseconds / statement.Count, statement.MaxMicroseconds, statement.Rows,
+                database.GetPreparedStatementString(index).c_str());
+        }
+    }
+
+    // Show prepared statements that took the most time in total, per database
+    static bool HandleServerDBStatsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 limit = 5;
+        if (*args)
+            limit = uint32(atoi(args));
+
+        SendDatabaseStats(handler, LoginDatabase, limit);
+        SendDatabaseStats(handler, WorldDatabase, limit);
+        SendDatabaseStats(handler, CharacterDatabase, limit);
+        return true;
+    }
+
+    // Syntax: .server mapbench <mapId> <x> <y> <z> [viewpoints] [ticks]
+    // Console only, maps must not be updating while the benchmark ticks one of them
+    static bool HandleServerMapBenchCommand(ChatHandler* handler, uint32 mapId, float x, float y, float z, Optional<uint32> viewpoints, Optional<uint32> ticks)
+    {
+        if (handler->GetSession())
+        {
+            handler->SendSysMessage("This command can only be used from the console.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        MapEntry const* mapEntry = sMapStore.LookupEntry(mapId);
+        if (!mapEntry || mapEntry->Instanceable())
+        {
+            handler->PSendSysMessage("Map %u is not a world map.", mapId);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        MapBenchmarkResult result;
+        std::string error;
+        if (!MapBenchmark::Run(sMapMgr->CreateBaseMap(mapId), Position(x, y, z), viewpoints.value_or(20), ticks.value_or(200), result, error))
+        {
+            handler->PSendSysMessage("Map benchmark failed: %s", error.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Map %u: %u ticks of %u ms with %u viewpoints, total %.2f ms, p50 %.3f ms, p95 %.3f ms, max %.3f ms",
+            mapId, result.Ticks, MapBenchmark::TICK_DIFF, result.Viewpoints, result.TotalMs, result.P50Ms, result.P95Ms, result.MaxMs);
+        for (std::pair<std::string, double> const& phase : result.PhaseTotalMs)
+            handler->PSendSysMessage("  %s: %.2f ms total, %.3f ms per tick", phase.first.c_str(), phase.second, result.Ticks ? phase.second / result.Ticks : 0.0);
+        return true;
+    }
+
+    // Show memory used by the big consumers as counted by MemoryAccounting, estimated categories are refreshed every world update
+    static bool HandleServerMemoryCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        int64 total = 0;
+        for (uint8 i = 0; i < uint8(Trinity::MemoryCategory::Max); ++i)
+        {
+            Trinity::MemoryCategory category = Trinity::MemoryCategory(i);
+            int64 bytes = Trinity::MemoryAccounting::GetBytes(category);
+            handler->PSendSysMessage("  %s: %.2f MiB", Trinity::MemoryAccounting::GetName(category), bytes / (1024.0 * 1024.0));
+            total += bytes;
+        }
+
+        handler->PSendSysMessage("Accounted memory: %.2f MiB", total / (1024.0 * 1024.0));
+        return true;
+    }
+
+    // Syntax: .server locks [reset]
+    // Show contention of the instrumented mutexes since startup or the last reset, needs a build with WITH_LOCK_PROFILING
+    static bool HandleServerLocksCommand(ChatHandler* handler, Optional<EXACT_SEQUENCE("reset")> reset)
+    {
+        if (!Trinity::LockProfiler::IsEnabled())
+        {
+            handler->SendSysMessage("Lock profiling is not available, the server was built without WITH_LOCK_PROFILING.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (reset)
+        {
+            Trinity::LockProfiler::Reset();
+            handler->SendSysMessage("Lock statistics reset.");
+            return true;
+        }
+
+        for (Trinity::LockProfiler::Stats const& stats : Trinity::LockProfiler::GetStats())
+        {
+            handler->PSendSysMessage("  %s: " UI64FMTD " acquisitions, " UI64FMTD " contended (%.2f%%), wait %.3f ms total / %.3f ms max, held %.3f ms",
+                stats.Name.c_str(), stats.Acquisitions, stats.Contentions, stats.Acquisitions ? stats.Contentions * 100.0 / stats.Acquisitions : 0.0,
+                stats.WaitTime / 1000000.0, stats.MaxWaitTime / 1000000.0, stats.HoldTime / 1000000.0);
+        }
+
+        return true;
+    }
+
+    // Syntax: .server packetdump [seconds] [filename]
+    // Write the packets kept in the PacketLog ring buffers during the last seconds (default 60) to LogsDir
+    static bool HandleServerPacketDumpCommand(ChatHandler* handler, Optional<uint32> seconds, Optional<std::string> fileName)
+    {
+        if (!sPacketLog->IsRingBufferEnabled())
+        {
+            handler->SendSysMessage("Packet ring buffers are disabled (PacketLog.RingBufferSize).");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        std::string path = sLog->GetLogsDir() + fileName.value_or(Trinity::StringFormat("packets_%s.pkt", TimeToTimestampStr(GameTime::GetGameTime()).c_str()));
+        if (!sPacketLog->DumpRecentPackets(path, seconds.value_or(60)))
+        {
+            handler->SendSysMessage("A packet dump is still being written.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Writing packets of the last %u seconds to %s", seconds.value_or(60), path.c_str());
+        return true;
+    }
+
+    // Syntax: .server trace [seconds] [filename]
+    // Records world and map update scopes and writes them as a Chrome trace (chrome://tracing, ui.perfetto.dev) to the logs directory
+    static bool HandleServerTraceCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 seconds = 5;
+        std::string fileName = Trinity::StringFormat("trace_%s.json", TimeToTimestampStr(GameTime::GetGameTime()).c_str());
+
+        if (char* secondsStr = strtok((char*)args, " "))
+            seconds = std::min(uint32(atoi(secondsStr)), 60u);
+
+        if (char* fileNameStr = strtok(nullptr, " "))
+            fileName = fileNameStr;
+
+        if (!seconds)
+        {
+            handler->SendSysMessage(LANG_BAD_VALUE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        fileName = sLog->GetLogsDir() + fileName;
+        if (!sMetric->StartTrace(Seconds(seconds), fileName))
+        {
+            handler->SendSysMessage("A trace is already being recorded.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Recording trace for %u seconds, it will be written to %s", seconds, fileName.c_str());
+        return true;
+    }
+
     static bool HandleServerDebugCommand(ChatHandler* handler, char const* /*args*/)
     {
         uint16 worldPort = uint16(sWorld->getIntConfig(CONFIG_PORT_WORLD));
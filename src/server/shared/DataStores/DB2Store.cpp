@@ -36,6 +36,17 @@ DB2StorageBase::~DB2StorageBase()
         delete[] strings;
 }
 
+std::size_t DB2StorageBase::GetMemoryUsage() const
+{
+    std::size_t recordSize = _loadInfo->Meta->GetRecordSize();
+    std::size_t usage = _indexTableSize * sizeof(char*);
+    for (uint32 i = 0; i < _indexTableSize; ++i)
+        if (HasRecord(i))
+            usage += recordSize;
+
+    return usage;
+}
+
 void DB2StorageBase::WriteRecordData(char const* entry, LocaleConstant locale, ByteBuffer& buffer) const
 {
     if (!_loadInfo->Meta->HasIndexFieldInData())
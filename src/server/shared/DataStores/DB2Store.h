@@ -44,6 +44,9 @@ public:
     uint32 GetFieldCount() const { return _fieldCount; }
     DB2LoadInfo const* GetLoadInfo() const { return _loadInfo; }
 
+    /// index table and one record per existing entry, strings are not included
+    std::size_t GetMemoryUsage() const;
+
     virtual void Load(std::string const& path, LocaleConstant locale) = 0;
     virtual void LoadStringsFrom(std::string const& path, LocaleConstant locale) = 0;
     virtual void LoadFromDB() = 0;
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IpBanCache.h"
+#include "DatabaseEnv.h"
+#include "DeadlineTimer.h"
+#include "IoContext.h"
+#include "Log.h"
+#include <mutex>
+
+IpBanCache::IpBanCache() : _updateInterval(0)
+{
+}
+
+IpBanCache::~IpBanCache() = default;
+
+IpBanCache* IpBanCache::Instance()
+{
+    static IpBanCache instance;
+    return &instance;
+}
+
+void IpBanCache::Initialize(Trinity::Asio::IoContext& ioContext, uint32 updateInterval)
+{
+    _updateInterval = updateInterval;
+    if (!_updateInterval)
+        return;
+
+    _updateTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
+    UpdateBans(boost::system::error_code());
+}
+
+void IpBanCache::Close()
+{
+    if (_updateTimer)
+        _updateTimer->cancel();
+}
+
+bool IpBanCache::IsBanned(std::string const& ip) const
+{
+    std::shared_lock<std::shared_mutex> lock(_bansMutex);
+    auto itr = _bans.find(ip);
+    if (itr == _bans.end())
+        return false;
+
+    return !itr->second || itr->second > time(nullptr);
+}
+
+void IpBanCache::AddBan(std::string const& ip, uint32 duration)
+{
+    if (!IsEnabled())
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(_bansMutex);
+    _bans[ip] = duration ? time(nullptr) + duration : 0;
+}
+
+void IpBanCache::RemoveBan(std::string const& ip)
+{
+    if (!IsEnabled())
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(_bansMutex);
+    _bans.erase(ip);
+}
+
+void IpBanCache::UpdateBans(boost::system::error_code const& error)
+{
+    if (error)
+        return;
+
+    TC_LOG_DEBUG("server", "Updating ip ban cache...");
+
+    std::unordered_map<std::string, time_t> bans;
+    if (PreparedQueryResult result = LoginDatabase.Query(LoginDatabase.GetPreparedStatement(LOGIN_SEL_IP_BANNED_ALL)))
+    {
+        bans.reserve(result->GetRowCount());
+        do
+        {
+            Field* fields = result->Fetch();
+            uint32 banDate = fields[1].GetUInt32();
+            uint32 unbanDate = fields[2].GetUInt32();
+            bans[fields[0].GetString()] = banDate != unbanDate ? time_t(unbanDate) : 0;
+        } while (result->NextRow());
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(_bansMutex);
+        _bans.swap(bans);
+    }
+
+    _updateTimer->expires_from_now(boost::posix_time::seconds(_updateInterval));
+    _updateTimer->async_wait(std::bind(&IpBanCache::UpdateBans, this, std::placeholders::_1));
+}
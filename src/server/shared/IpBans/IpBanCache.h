@@ -0,0 +1,69 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IpBanCache_h__
+#define IpBanCache_h__
+
+#include "Define.h"
+#include "AsioHacksFwd.h"
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace boost
+{
+    namespace system
+    {
+        class error_code;
+    }
+}
+
+/// In memory copy of the ip_banned table, lets sockets check bans on accept without a database query
+class TC_SHARED_API IpBanCache
+{
+public:
+    static IpBanCache* Instance();
+
+    ~IpBanCache();
+
+    // updateInterval is in seconds, 0 disables the cache and bans have to be checked in the database
+    void Initialize(Trinity::Asio::IoContext& ioContext, uint32 updateInterval);
+    void Close();
+
+    bool IsEnabled() const { return _updateInterval != 0; }
+    bool IsBanned(std::string const& ip) const;
+
+    // keeps bans issued or lifted by this process visible before the next reload, duration 0 is a permanent ban
+    void AddBan(std::string const& ip, uint32 duration);
+    void RemoveBan(std::string const& ip);
+
+private:
+    IpBanCache();
+
+    void UpdateBans(boost::system::error_code const& error);
+
+    uint32 _updateInterval;
+    std::unique_ptr<Trinity::Asio::DeadlineTimer> _updateTimer;
+
+    mutable std::shared_mutex _bansMutex;
+    std::unordered_map<std::string, time_t> _bans;  // unban time, 0 for permanent bans
+};
+
+#define sIpBanCache IpBanCache::Instance()
+
+#endif // IpBanCache_h__
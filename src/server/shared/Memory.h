@@ -19,16 +19,29 @@
 #define _MEMORY_H
 
 #include "DetourAlloc.h"
+#include "MemoryAccounting.h"
+#include <cstddef>
+
+// every block starts with its size so dtCustomFree can account it, padded to keep the returned memory aligned
+static constexpr std::size_t DT_CUSTOM_ALLOC_HEADER_SIZE = alignof(std::max_align_t);
 
 //  memory management
 inline void* dtCustomAlloc(size_t size, dtAllocHint /*hint*/)
 {
-    return (void*)new unsigned char[size];
+    unsigned char* block = new unsigned char[size + DT_CUSTOM_ALLOC_HEADER_SIZE];
+    *reinterpret_cast<size_t*>(block) = size;
+    Trinity::MemoryAccounting::Allocated(Trinity::MemoryCategory::MMaps, size);
+    return block + DT_CUSTOM_ALLOC_HEADER_SIZE;
 }
 
 inline void dtCustomFree(void* ptr)
 {
-    delete [] (unsigned char*)ptr;
+    if (!ptr)
+        return;
+
+    unsigned char* block = static_cast<unsigned char*>(ptr) - DT_CUSTOM_ALLOC_HEADER_SIZE;
+    Trinity::MemoryAccounting::Released(Trinity::MemoryCategory::MMaps, *reinterpret_cast<size_t*>(block));
+    delete [] block;
 }
 
 #endif
@@ -33,14 +33,21 @@ using boost::asio::ip::tcp;
 #define TRINITY_MAX_LISTEN_CONNECTIONS boost::asio::socket_base::max_connections
 #endif
 
+// only linux spreads incoming connections across all sockets bound with SO_REUSEPORT
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX && defined(SO_REUSEPORT)
+#define TRINITY_ACCEPTOR_REUSE_PORT
+#endif
+
 class AsyncAcceptor
 {
 public:
     typedef void(*AcceptCallback)(tcp::socket&& newSocket, uint32 threadIndex);
 
-    AsyncAcceptor(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port) :
+    /// threadIndex is passed to the accept callback when no socket factory is set,
+    /// ioContext must then be the one of that network thread
+    AsyncAcceptor(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, uint32 threadIndex = 0) :
         _acceptor(ioContext), _endpoint(Trinity::Net::make_address(bindIp), port),
-        _socket(ioContext), _closed(false), _socketFactory(std::bind(&AsyncAcceptor::DefeaultSocketFactory, this))
+        _socket(ioContext), _closed(false), _threadIndex(threadIndex), _socketFactory(std::bind(&AsyncAcceptor::DefeaultSocketFactory, this))
     {
     }
 
@@ -74,7 +81,8 @@ public:
         });
     }
 
-    bool Bind()
+    /// reusePort allows several acceptors to listen on the same endpoint, the kernel distributes connections between them
+    bool Bind(bool reusePort = false)
     {
         boost::system::error_code errorCode;
         _acceptor.open(_endpoint.protocol(), errorCode);
@@ -93,6 +101,21 @@ public:
         }
 #endif
 
+        if (reusePort)
+        {
+#ifdef TRINITY_ACCEPTOR_REUSE_PORT
+            _acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true), errorCode);
+            if (errorCode)
+            {
+                TC_LOG_INFO("network", "Failed to set SO_REUSEPORT option on acceptor %s", errorCode.message().c_str());
+                return false;
+            }
+#else
+            TC_LOG_INFO("network", "SO_REUSEPORT is not supported on this platform");
+            return false;
+#endif
+        }
+
         _acceptor.bind(_endpoint, errorCode);
         if (errorCode)
         {
@@ -122,12 +145,13 @@ public:
     void SetSocketFactory(std::function<std::pair<tcp::socket*, uint32>()> func) { _socketFactory = func; }
 
 private:
-    std::pair<tcp::socket*, uint32> DefeaultSocketFactory() { return std::make_pair(&_socket, 0); }
+    std::pair<tcp::socket*, uint32> DefeaultSocketFactory() { return std::make_pair(&_socket, _threadIndex); }
 
     tcp::acceptor _acceptor;
     tcp::endpoint _endpoint;
     tcp::socket _socket;
     std::atomic<bool> _closed;
+    uint32 _threadIndex;
     std::function<std::pair<tcp::socket*, uint32>()> _socketFactory;
 };
 
@@ -23,10 +23,13 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "ProcessPriority.h"
 #include "Timer.h"
+#include "Util.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -38,8 +41,8 @@ template<class SocketType>
 class NetworkThread
 {
 public:
-    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
-        _acceptSocket(_ioContext), _updateTimer(_ioContext)
+    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _loadPermille(0), _bytesPerSecond(0),
+        _queuedBytes(0), _transferredBytes(0), _lastLoadSampleCpuTime(0), _ioContext(1), _acceptSocket(_ioContext), _updateTimer(_ioContext)
     {
     }
 
@@ -82,6 +85,23 @@ public:
         return _connections;
     }
 
+    /// Share of the last second this thread spent on the cpu (smoothed), 0 - 1000
+    uint32 GetLoadPermille() const
+    {
+        return _loadPermille;
+    }
+
+    uint32 GetBytesPerSecond() const
+    {
+        return _bytesPerSecond;
+    }
+
+    /// Bytes waiting to be sent by all sockets of this thread as of the last update
+    uint64 GetQueuedBytes() const
+    {
+        return _queuedBytes;
+    }
+
     virtual void AddSocket(std::shared_ptr<SocketType> sock)
     {
         std::lock_guard<std::mutex> lock(_newSocketsLock);
@@ -93,6 +113,8 @@ public:
 
     tcp::socket* GetSocketForAccept() { return &_acceptSocket; }
 
+    Trinity::Asio::IoContext& GetIoContext() { return _ioContext; }
+
 protected:
     virtual void SocketAdded(std::shared_ptr<SocketType> /*sock*/) { }
     virtual void SocketRemoved(std::shared_ptr<SocketType> /*sock*/) { }
@@ -121,6 +143,10 @@ protected:
     void Run()
     {
         TC_LOG_DEBUG("misc", "Network Thread Starting");
+        SetCurrentThreadAffinity("ThreadAffinity.Network");
+
+        _lastLoadSampleTime = std::chrono::steady_clock::now();
+        _lastLoadSampleCpuTime = GetCurrentThreadCpuTime();
 
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
@@ -141,8 +167,11 @@ protected:
 
         AddNewSockets();
 
-        _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [this](std::shared_ptr<SocketType> sock)
+        uint64 queuedBytes = 0;
+        _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [this, &queuedBytes](std::shared_ptr<SocketType> sock)
         {
+            this->_transferredBytes += sock->TakeTransferredBytes();
+
             if (!sock->Update())
             {
                 if (sock->IsOpen())
@@ -154,8 +183,30 @@ protected:
                 return true;
             }
 
+            queuedBytes += sock->GetQueuedBytes();
             return false;
         }), _sockets.end());
+
+        _queuedBytes = queuedBytes;
+        SampleLoad();
+    }
+
+    void SampleLoad()
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        uint64 wallTime = std::chrono::duration_cast<std::chrono::microseconds>(now - _lastLoadSampleTime).count();
+        if (wallTime < 1000000)
+            return;
+
+        uint64 cpuTime = GetCurrentThreadCpuTime();
+        uint32 load = uint32(std::min<uint64>((cpuTime - _lastLoadSampleCpuTime) * 1000 / wallTime, 1000));
+
+        _loadPermille = (_loadPermille + load) / 2;
+        _bytesPerSecond = uint32(std::min<uint64>(_transferredBytes * 1000000 / wallTime, std::numeric_limits<uint32>::max()));
+
+        _lastLoadSampleTime = now;
+        _lastLoadSampleCpuTime = cpuTime;
+        _transferredBytes = 0;
     }
 
 private:
@@ -166,6 +217,13 @@ private:
 
     std::thread* _thread;
 
+    std::atomic<uint32> _loadPermille;
+    std::atomic<uint32> _bytesPerSecond;
+    std::atomic<uint64> _queuedBytes;
+    uint64 _transferredBytes;
+    std::chrono::steady_clock::time_point _lastLoadSampleTime;
+    uint64 _lastLoadSampleCpuTime;
+
     SocketContainer _sockets;
 
     std::mutex _newSocketsLock;
@@ -20,17 +20,23 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <algorithm>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <boost/asio/ip/tcp.hpp>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
-#ifdef BOOST_ASIO_HAS_IOCP
+#define DEFAULT_MAX_GATHERED_WRITE_BUFFERS 16
+// completion based backends (windows iocp, linux io_uring) get real buffers handed to async_write_some
+// instead of waiting for writability and calling write_some
+#if defined(BOOST_ASIO_HAS_IOCP) || defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
 #define TC_SOCKET_USE_IOCP
 #endif
 
@@ -66,7 +72,8 @@ class Socket : public std::enable_shared_from_this<T>
 {
 public:
     explicit Socket(tcp::socket&& socket) : _socket(std::move(socket)), _remoteAddress(_socket.remote_endpoint().address()),
-        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false)
+        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false),
+        _maxGatheredWriteBuffers(DEFAULT_MAX_GATHERED_WRITE_BUFFERS), _transferredBytes(0), _writeQueueBytes(0)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
     }
@@ -130,7 +137,8 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueueBytes += buffer.GetActiveSize();
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -158,6 +166,16 @@ public:
 
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
+    /// Maximum number of queued buffers sent with a single (vectored) write call
+    void SetMaxGatheredWriteBuffers(std::size_t count) { _maxGatheredWriteBuffers = std::max<std::size_t>(count, 1); }
+
+    /// Bytes received and sent since the previous call, used by NetworkThread for load tracking
+    std::size_t TakeTransferredBytes() { return std::exchange(_transferredBytes, 0); }
+
+    /// Bytes queued for sending that the kernel has not accepted yet
+    std::size_t GetWriteQueueSize() const { return _writeQueueBytes; }
+    std::size_t GetQueuedBytes() const { return GetWriteQueueSize(); }
+
 protected:
     virtual void OnClose() { }
 
@@ -171,8 +189,8 @@ protected:
         _isWritingAsync = true;
 
 #ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T, Stream>::WriteHandler,
+        GatherWriteBuffers();
+        _socket.async_write_some(_gatheredWriteBuffers, std::bind(&Socket<T, Stream>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T, Stream>::WriteHandlerWrapper,
@@ -197,6 +215,49 @@ protected:
     }
 
 private:
+    void PopWriteQueue()
+    {
+        _writeQueueBytes -= _writeQueue.front().GetActiveSize();
+        _writeQueue.front().ReturnToPool();
+        _writeQueue.pop_front();
+    }
+
+    /// Fills _gatheredWriteBuffers with the front of the write queue, returns total byte count
+    std::size_t GatherWriteBuffers()
+    {
+        _gatheredWriteBuffers.clear();
+        std::size_t bytes = 0;
+        for (MessageBuffer& buffer : _writeQueue)
+        {
+            if (_gatheredWriteBuffers.size() >= _maxGatheredWriteBuffers)
+                break;
+
+            _gatheredWriteBuffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            bytes += buffer.GetActiveSize();
+        }
+
+        return bytes;
+    }
+
+    /// Removes fully written buffers from the queue and advances the first partially written one
+    void ConsumeWrittenBytes(std::size_t bytes)
+    {
+        _transferredBytes += bytes;
+        while (bytes && !_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            if (bytes < buffer.GetActiveSize())
+            {
+                buffer.ReadCompleted(bytes);
+                _writeQueueBytes -= bytes;
+                return;
+            }
+
+            bytes -= buffer.GetActiveSize();
+            PopWriteQueue();
+        }
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, size_t transferredBytes)
     {
         if (error)
@@ -205,6 +266,7 @@ private:
             return;
         }
 
+        _transferredBytes += transferredBytes;
         _readBuffer.WriteCompleted(transferredBytes);
         ReadHandler();
     }
@@ -216,9 +278,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            ConsumeWrittenBytes(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -242,37 +302,35 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = GatherWriteBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_gatheredWriteBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent < bytesToSend) // now n > 0
         {
-            queuedMessage.ReadCompleted(bytesSent);
+            ConsumeWrittenBytes(bytesSent);
             return AsyncProcessQueue();
         }
 
-        _writeQueue.pop();
+        ConsumeWrittenBytes(bytesSent);
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -286,12 +344,16 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
+    std::vector<boost::asio::const_buffer> _gatheredWriteBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
 
     bool _isWritingAsync;
+    std::size_t _maxGatheredWriteBuffers;
+    std::size_t _transferredBytes;
+    std::size_t _writeQueueBytes;
 };
 
 #endif // __SOCKET_H__
@@ -23,6 +23,7 @@
 #include "NetworkThread.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <memory>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
@@ -32,48 +33,39 @@ class SocketMgr
 public:
     virtual ~SocketMgr()
     {
-        ASSERT(!_threads && !_acceptor && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
+        ASSERT(!_threads && !_acceptor && _threadAcceptors.empty() && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
     }
 
     virtual bool StartNetwork(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount)
     {
         ASSERT(threadCount > 0);
 
-        AsyncAcceptor* acceptor = nullptr;
-        try
-        {
-            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
-        }
-        catch (boost::system::system_error const& err)
-        {
-            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork (%s:%u): %s", bindIp.c_str(), port, err.what());
-            return false;
-        }
-
-        if (!acceptor->Bind())
-        {
-            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
-            delete acceptor;
-            return false;
-        }
-
-        _acceptor = acceptor;
         _threadCount = threadCount;
         _threads = CreateThreads();
 
         ASSERT(_threads);
 
+        if (!(_acceptorPerThread ? CreateThreadAcceptors(bindIp, port) : CreateAcceptor(ioContext, bindIp, port)))
+        {
+            delete[] _threads;
+            _threads = nullptr;
+            _threadCount = 0;
+            return false;
+        }
+
         for (int32 i = 0; i < _threadCount; ++i)
             _threads[i].Start();
 
-        _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
-
         return true;
     }
 
     virtual void StopNetwork()
     {
-        _acceptor->Close();
+        if (_acceptor)
+            _acceptor->Close();
+
+        for (AsyncAcceptor* acceptor : _threadAcceptors)
+            acceptor->Close();
 
         if (_threadCount != 0)
             for (int32 i = 0; i < _threadCount; ++i)
@@ -83,6 +75,9 @@ public:
 
         delete _acceptor;
         _acceptor = nullptr;
+        for (AsyncAcceptor* acceptor : _threadAcceptors)
+            delete acceptor;
+        _threadAcceptors.clear();
         delete[] _threads;
         _threads = nullptr;
         _threadCount = 0;
@@ -112,6 +107,15 @@ public:
 
     int32 GetNetworkThreadCount() const { return _threadCount; }
 
+    uint64 GetQueuedBytes() const
+    {
+        uint64 queuedBytes = 0;
+        for (int32 i = 0; i < _threadCount; ++i)
+            queuedBytes += _threads[i].GetQueuedBytes();
+
+        return queuedBytes;
+    }
+
     uint32 SelectThreadWithMinConnections() const
     {
         uint32 min = 0;
@@ -123,22 +127,123 @@ public:
         return min;
     }
 
+    /// Weighs connection count by measured cpu load, a thread busy with raids counts heavier than one holding idle players
+    uint32 SelectThreadWithMinLoad() const
+    {
+        auto weight = [this](int32 index)
+        {
+            return uint64(_threads[index].GetConnectionCount() + 1) * (1000 + _threads[index].GetLoadPermille());
+        };
+
+        uint32 min = 0;
+        uint64 minWeight = weight(0);
+
+        for (int32 i = 1; i < _threadCount; ++i)
+        {
+            uint64 threadWeight = weight(i);
+            if (threadWeight < minWeight)
+            {
+                min = i;
+                minWeight = threadWeight;
+            }
+        }
+
+        return min;
+    }
+
     std::pair<tcp::socket*, uint32> GetSocketForAccept()
     {
-        uint32 threadIndex = SelectThreadWithMinConnections();
+        uint32 threadIndex = _loadAwareThreadSelection ? SelectThreadWithMinLoad() : SelectThreadWithMinConnections();
         return std::make_pair(_threads[threadIndex].GetSocketForAccept(), threadIndex);
     }
 
 protected:
-    SocketMgr() : _acceptor(nullptr), _threads(nullptr), _threadCount(0)
+    SocketMgr() : _acceptor(nullptr), _threads(nullptr), _threadCount(0), _acceptorPerThread(false), _loadAwareThreadSelection(false)
     {
     }
 
     virtual NetworkThread<SocketType>* CreateThreads() const = 0;
 
+    /// Starts accepting on the listening socket(s) created by StartNetwork
+    template<AsyncAcceptor::AcceptCallback acceptCallback>
+    void AsyncAcceptWithCallback()
+    {
+        if (_acceptor)
+            _acceptor->AsyncAcceptWithCallback<acceptCallback>();
+
+        for (AsyncAcceptor* acceptor : _threadAcceptors)
+            acceptor->AsyncAcceptWithCallback<acceptCallback>();
+    }
+
+    /// Must be set before StartNetwork. Every network thread gets its own SO_REUSEPORT listening socket
+    /// and keeps the connections it accepted instead of going through SelectThreadWithMinConnections
+    void SetAcceptorPerThread(bool enable) { _acceptorPerThread = enable; }
+
+    /// Place new connections using SelectThreadWithMinLoad instead of SelectThreadWithMinConnections
+    void SetLoadAwareThreadSelection(bool enable) { _loadAwareThreadSelection = enable; }
+
     AsyncAcceptor* _acceptor;
+    std::vector<AsyncAcceptor*> _threadAcceptors;
     NetworkThread<SocketType>* _threads;
     int32 _threadCount;
+    bool _acceptorPerThread;
+    bool _loadAwareThreadSelection;
+
+private:
+    bool CreateAcceptor(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port)
+    {
+        AsyncAcceptor* acceptor = nullptr;
+        try
+        {
+            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
+        }
+        catch (boost::system::system_error const& err)
+        {
+            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork (%s:%u): %s", bindIp.c_str(), port, err.what());
+            return false;
+        }
+
+        if (!acceptor->Bind())
+        {
+            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
+            delete acceptor;
+            return false;
+        }
+
+        _acceptor = acceptor;
+        _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
+        return true;
+    }
+
+    bool CreateThreadAcceptors(std::string const& bindIp, uint16 port)
+    {
+        for (int32 i = 0; i < _threadCount; ++i)
+        {
+            AsyncAcceptor* acceptor = nullptr;
+            try
+            {
+                acceptor = new AsyncAcceptor(_threads[i].GetIoContext(), bindIp, port, i);
+            }
+            catch (boost::system::system_error const& err)
+            {
+                TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork (%s:%u): %s", bindIp.c_str(), port, err.what());
+            }
+
+            if (!acceptor || !acceptor->Bind(true))
+            {
+                TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor for network thread %d", i);
+                delete acceptor;
+                for (AsyncAcceptor* created : _threadAcceptors)
+                    delete created;
+                _threadAcceptors.clear();
+                return false;
+            }
+
+            _threadAcceptors.push_back(acceptor);
+        }
+
+        return true;
+    }
 };
 
 #endif // SocketMgr_h__
@@ -115,6 +115,45 @@ void ByteBuffer::append(uint8 const* src, size_t cnt)
     FlushBits();
 
     size_t const newSize = _wpos + cnt;
+    EnsureStorageSize(newSize);
+    std::memcpy(&_storage[_wpos], src, cnt);
+    _wpos = newSize;
+}
+
+void ByteBuffer::WriteBits(uint32 const* values, std::size_t count, int32 bits)
+{
+    ASSERT(bits <= 32);
+    if (!count || bits <= 0)
+        return;
+
+    ASSERT(size() < 10000000);
+
+    // bits of the pending byte are carried over into the accumulator, completed bytes are stored directly
+    uint64 pending = _curbitval >> _bitpos;
+    std::size_t pendingBits = 8 - _bitpos;
+    std::size_t const completedBytes = (pendingBits + count * bits) / 8;
+    EnsureStorageSize(_wpos + completedBytes);
+
+    uint64 const mask = (UI64LIT(1) << bits) - 1;
+    uint8* dest = _storage.data() + _wpos;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pending = (pending << bits) | (values[i] & mask);
+        pendingBits += bits;
+        while (pendingBits >= 8)
+        {
+            pendingBits -= 8;
+            *dest++ = uint8(pending >> pendingBits);
+        }
+    }
+
+    _wpos += completedBytes;
+    _bitpos = 8 - pendingBits;
+    _curbitval = pendingBits ? uint8(pending << _bitpos) : 0;
+}
+
+void ByteBuffer::EnsureStorageSize(size_t newSize)
+{
     if (_storage.capacity() < newSize) // custom memory allocation rules
     {
         if (newSize < 100)
@@ -129,8 +168,6 @@ void ByteBuffer::append(uint8 const* src, size_t cnt)
 
     if (_storage.size() < newSize)
         _storage.resize(newSize);
-    std::memcpy(&_storage[_wpos], src, cnt);
-    _wpos = newSize;
 }
 
 void ByteBuffer::AppendPackedTime(time_t time)
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "ByteConverter.h"
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -200,18 +201,46 @@ class TC_SHARED_API ByteBuffer
             return ((_curbitval >> (7-_bitpos)) & 1) != 0;
         }
 
+        // same output as calling WriteBit for each bit, but fills the pending byte as many bits at a time as fit in it
         void WriteBits(std::size_t value, int32 bits)
         {
-            for (int32 i = bits - 1; i >= 0; --i)
-                WriteBit((value >> i) & 1);
+            while (bits > 0)
+            {
+                int32 count = std::min<int32>(bits, int32(_bitpos));
+                bits -= count;
+                _bitpos -= count;
+                _curbitval |= uint8(((value >> bits) & ((1u << count) - 1)) << _bitpos);
+
+                if (_bitpos == 0)
+                {
+                    _bitpos = 8;
+                    append((uint8 *)&_curbitval, sizeof(_curbitval));
+                    _curbitval = 0;
+                }
+            }
         }
 
+        // writes count values of bits each (up to 32), grows the storage only once for all of them
+        void WriteBits(uint32 const* values, std::size_t count, int32 bits);
+
         uint32 ReadBits(int32 bits)
         {
             uint32 value = 0;
-            for (int32 i = bits - 1; i >= 0; --i)
-                if (ReadBit())
-                    value |= (1 << (i));
+            while (bits > 0)
+            {
+                // _bitpos is the index of the last bit read from _curbitval, 8 when no byte was started
+                if (_bitpos >= 7)
+                {
+                    _curbitval = read<uint8>();
+                    _bitpos = 8;
+                }
+
+                std::size_t available = _bitpos == 8 ? 8 : 7 - _bitpos;
+                int32 count = std::min<int32>(bits, int32(available));
+                bits -= count;
+                value = (value << count) | ((_curbitval >> (available - count)) & ((1u << count) - 1));
+                _bitpos = 8 - (available - count) - 1;
+            }
 
             return value;
         }
@@ -530,6 +559,7 @@ class TC_SHARED_API ByteBuffer
         }
 
         size_t size() const { return _storage.size(); }
+        size_t capacity() const { return _storage.capacity(); }
         bool empty() const { return _storage.empty(); }
 
         void resize(size_t newsize)
@@ -629,6 +659,9 @@ class TC_SHARED_API ByteBuffer
         void hexlike() const;
 
     protected:
+        // grows _storage to hold newSize bytes using the same reservation steps for every writer
+        void EnsureStorageSize(size_t newSize);
+
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
         std::vector<uint8> _storage;
@@ -31,6 +31,32 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <zlib.h>
 
+namespace
+{
+    bool IsSameAddress(std::unique_ptr<boost::asio::ip::address> const& left, std::unique_ptr<boost::asio::ip::address> const& right)
+    {
+        if (!left || !right)
+            return !left && !right;
+
+        return *left == *right;
+    }
+
+    bool IsSameRealm(Realm const& left, Realm const& right)
+    {
+        return left.Build == right.Build
+            && left.Name == right.Name
+            && left.Type == right.Type
+            && left.Flags == right.Flags
+            && left.Timezone == right.Timezone
+            && left.AllowedSecurityLevel == right.AllowedSecurityLevel
+            && left.PopulationLevel == right.PopulationLevel
+            && left.Port == right.Port
+            && IsSameAddress(left.ExternalAddress, right.ExternalAddress)
+            && IsSameAddress(left.LocalAddress, right.LocalAddress)
+            && IsSameAddress(left.LocalSubnetMask, right.LocalSubnetMask);
+    }
+}
+
 RealmList::RealmList() : _updateInterval(0)
 {
 }
@@ -207,11 +233,29 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     for (auto itr = existingRealms.begin(); itr != existingRealms.end(); ++itr)
         TC_LOG_INFO("realmlist", "Removed realm \"%s\".", itr->second.c_str());
 
+    bool changed = newRealms.size() != _realms.size() || newSubRegions != _subRegions;
+    if (!changed)
+    {
+        for (auto newItr = newRealms.begin(), oldItr = _realms.begin(); newItr != newRealms.end(); ++newItr, ++oldItr)
+        {
+            if (newItr->first.GetAddress() != oldItr->first.GetAddress() || !IsSameRealm(newItr->second, oldItr->second))
+            {
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    // keep serving the cached realm lists (and the Realm pointers handed out) while nothing changed
+    if (changed)
     {
         std::unique_lock<std::shared_mutex> lock(_realmsMutex);
 
         _subRegions.swap(newSubRegions);
         _realms.swap(newRealms);
+
+        std::lock_guard<std::mutex> cacheLock(_realmListCacheMutex);
+        _realmListCache.clear();
     }
 
     if (_updateInterval)
@@ -312,48 +356,65 @@ std::vector<uint8> RealmList::GetRealmEntryJSON(Battlenet::RealmHandle const& id
 
 std::vector<uint8> RealmList::GetRealmList(uint32 build, std::string const& subRegion) const
 {
-    JSON::RealmList::RealmListUpdates realmList;
+    std::shared_lock<std::shared_mutex> lock(_realmsMutex);
+    std::pair<uint32, std::string> key(build, subRegion);
+
     {
-        std::shared_lock<std::shared_mutex> lock(_realmsMutex);
-        for (auto const& realm : _realms)
-        {
-            if (realm.second.Id.GetSubRegionAddress() != subRegion)
-                continue;
+        std::lock_guard<std::mutex> cacheLock(_realmListCacheMutex);
+        auto itr = _realmListCache.find(key);
+        if (itr != _realmListCache.end())
+            return itr->second;
+    }
 
-            uint32 flag = realm.second.Flags;
-            if (realm.second.Build != build)
-                flag |= REALM_FLAG_VERSION_MISMATCH;
+    // built under the shared lock so UpdateRealms cannot clear the cache before this entry is stored
+    std::vector<uint8> compressed = BuildRealmList(build, subRegion);
 
-            JSON::RealmList::RealmState* state = realmList.add_updates();
-            state->mutable_update()->set_wowrealmaddress(realm.second.Id.GetAddress());
-            state->mutable_update()->set_cfgtimezonesid(1);
-            state->mutable_update()->set_populationstate((realm.second.Flags & REALM_FLAG_OFFLINE) ? 0u : std::max(uint32(realm.second.PopulationLevel), 1u));
-            state->mutable_update()->set_cfgcategoriesid(realm.second.Timezone);
+    std::lock_guard<std::mutex> cacheLock(_realmListCacheMutex);
+    _realmListCache.emplace(std::move(key), compressed);
+    return compressed;
+}
 
-            JSON::RealmList::ClientVersion* version = state->mutable_update()->mutable_version();
-            if (RealmBuildInfo const* buildInfo = GetBuildInfo(realm.second.Build))
-            {
-                version->set_versionmajor(buildInfo->MajorVersion);
-                version->set_versionminor(buildInfo->MinorVersion);
-                version->set_versionrevision(buildInfo->BugfixVersion);
-                version->set_versionbuild(buildInfo->Build);
-            }
-            else
-            {
-                version->set_versionmajor(6);
-                version->set_versionminor(2);
-                version->set_versionrevision(4);
-                version->set_versionbuild(realm.second.Build);
-            }
+std::vector<uint8> RealmList::BuildRealmList(uint32 build, std::string const& subRegion) const
+{
+    JSON::RealmList::RealmListUpdates realmList;
+    for (auto const& realm : _realms)
+    {
+        if (realm.second.Id.GetSubRegionAddress() != subRegion)
+            continue;
+
+        uint32 flag = realm.second.Flags;
+        if (realm.second.Build != build)
+            flag |= REALM_FLAG_VERSION_MISMATCH;
 
-            state->mutable_update()->set_cfgrealmsid(realm.second.Id.Realm);
-            state->mutable_update()->set_flags(flag);
-            state->mutable_update()->set_name(realm.second.Name);
-            state->mutable_update()->set_cfgconfigsid(realm.second.GetConfigId());
-            state->mutable_update()->set_cfglanguagesid(1);
+        JSON::RealmList::RealmState* state = realmList.add_updates();
+        state->mutable_update()->set_wowrealmaddress(realm.second.Id.GetAddress());
+        state->mutable_update()->set_cfgtimezonesid(1);
+        state->mutable_update()->set_populationstate((realm.second.Flags & REALM_FLAG_OFFLINE) ? 0u : std::max(uint32(realm.second.PopulationLevel), 1u));
+        state->mutable_update()->set_cfgcategoriesid(realm.second.Timezone);
 
-            state->set_deleting(false);
+        JSON::RealmList::ClientVersion* version = state->mutable_update()->mutable_version();
+        if (RealmBuildInfo const* buildInfo = GetBuildInfo(realm.second.Build))
+        {
+            version->set_versionmajor(buildInfo->MajorVersion);
+            version->set_versionminor(buildInfo->MinorVersion);
+            version->set_versionrevision(buildInfo->BugfixVersion);
+            version->set_versionbuild(buildInfo->Build);
+        }
+        else
+        {
+            version->set_versionmajor(6);
+            version->set_versionminor(2);
+            version->set_versionrevision(4);
+            version->set_versionbuild(realm.second.Build);
         }
+
+        state->mutable_update()->set_cfgrealmsid(realm.second.Id.Realm);
+        state->mutable_update()->set_flags(flag);
+        state->mutable_update()->set_name(realm.second.Name);
+        state->mutable_update()->set_cfgconfigsid(realm.second.GetConfigId());
+        state->mutable_update()->set_cfglanguagesid(1);
+
+        state->set_deleting(false);
     }
 
     std::string json = "JSONRealmListUpdates:" + JSON::Serialize(realmList);
@@ -22,6 +22,7 @@
 #include "Realm.h"
 #include <array>
 #include <map>
+#include <mutex>
 #include <shared_mutex>
 #include <vector>
 #include <unordered_set>
@@ -99,11 +100,17 @@ private:
     void UpdateRealm(Realm& realm, Battlenet::RealmHandle const& id, uint32 build, std::string const& name,
         boost::asio::ip::address&& address, boost::asio::ip::address&& localAddr, boost::asio::ip::address&& localSubmask,
         uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population);
+    std::vector<uint8> BuildRealmList(uint32 build, std::string const& subRegion) const;
 
     std::vector<RealmBuildInfo> _builds;
     mutable std::shared_mutex _realmsMutex;
     RealmMap _realms;
     std::unordered_set<std::string> _subRegions;
+
+    // compressed JSONRealmListUpdates by build and subregion, cleared whenever _realms changes
+    mutable std::mutex _realmListCacheMutex;
+    mutable std::map<std::pair<uint32, std::string>, std::vector<uint8>> _realmListCache;
+
     uint32 _updateInterval;
     std::unique_ptr<Trinity::Asio::DeadlineTimer> _updateTimer;
     std::unique_ptr<Trinity::Asio::Resolver> _resolver;
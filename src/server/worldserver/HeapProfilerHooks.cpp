@@ -0,0 +1,117 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HeapProfiler.h"
+#include <cstdlib>
+#include <new>
+
+// Replacements of the global allocation functions reporting to Trinity::HeapProfiler, so that .debug heapprofile can
+// sample allocations when the allocator has no profiler of its own. When profiling is stopped this costs one relaxed
+// load per allocation and one per release. Over-aligned allocations keep the default implementation.
+
+namespace
+{
+    void* Allocate(std::size_t size)
+    {
+        if (!size)
+            size = 1;
+
+        void* ptr;
+        while (!(ptr = std::malloc(size)))
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                return nullptr;
+
+            handler();
+        }
+
+        Trinity::HeapProfiler::OnAllocation(ptr, size);
+        return ptr;
+    }
+
+    void Release(void* ptr)
+    {
+        Trinity::HeapProfiler::OnRelease(ptr);
+        std::free(ptr);
+    }
+
+    struct HeapProfilerHooksRegistration
+    {
+        HeapProfilerHooksRegistration() { Trinity::HeapProfiler::SetSamplingHooksInstalled(); }
+    } const Registration;
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = Allocate(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    try
+    {
+        return Allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    Release(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    Release(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+    Release(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept
+{
+    Release(ptr);
+}
+
+void operator delete(void* ptr, std::nothrow_t const&) noexcept
+{
+    Release(ptr);
+}
+
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept
+{
+    Release(ptr);
+}
@@ -33,10 +33,12 @@
 #include "GitRevision.h"
 #include "InstanceSaveMgr.h"
 #include "IoContext.h"
+#include "IpBanCache.h"
 #include "MapManager.h"
 #include "Metric.h"
 #include "MySQLThreading.h"
 #include "ObjectAccessor.h"
+#include "OpcodeMetrics.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvP/OutdoorPvPMgr.h"
 #include "ProcessPriority.h"
@@ -276,11 +278,20 @@ extern int main(int argc, char** argv)
 
     std::shared_ptr<void> sRealmListHandle(nullptr, [](void*) { sRealmList->Close(); });
 
+    sIpBanCache->Initialize(*ioContext, sConfigMgr->GetIntDefault("IpBanCacheUpdateDelay", 60));
+
+    std::shared_ptr<void> sIpBanCacheHandle(nullptr, [](void*) { sIpBanCache->Close(); });
+
     LoadRealmInfo();
 
     sMetric->Initialize(realm.Name, *ioContext, []()
     {
-        TC_METRIC_VALUE("online_players", sWorld->GetPlayerCount());
+        static MetricGauge& onlinePlayers = sMetric->GetGauge("online_players");
+        onlinePlayers.Set(sWorld->GetPlayerCount());
+        sOpcodeMetrics->Flush();
+        LoginDatabase.ReportStatistics();
+        WorldDatabase.ReportStatistics();
+        CharacterDatabase.ReportStatistics();
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -138,7 +138,8 @@ bool RASession::CheckAccessLevel(const std::string& user)
 
     Field* fields = result->Fetch();
 
-    if (fields[1].GetUInt8() < sConfigMgr->GetIntDefault("Ra.MinLevel", SEC_ADMINISTRATOR))
+    static Trinity::ConfigValue<int32> const MinLevel("Ra.MinLevel", SEC_ADMINISTRATOR);
+    if (fields[1].GetUInt8() < MinLevel)
     {
         TC_LOG_INFO("commands.ra", "User %s has no privilege to login", user.c_str());
         return false;
@@ -29,11 +29,13 @@
 #include <CascLib.h>
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <atomic>
 #include <bitset>
 #include <cstdio>
 #include <deque>
 #include <fstream>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <cstdlib>
 #include <cstring>
@@ -109,6 +111,8 @@ uint32 CONF_Locale = 0;
 
 char const* CONF_Product = "wow";
 
+uint32 CONF_Threads = std::thread::hardware_concurrency();
+
 #define CASC_LOCALES_COUNT 17
 
 char const* CascLocaleNames[CASC_LOCALES_COUNT] =
@@ -161,6 +165,7 @@ void Usage(char const* prg)
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
         "-l dbc locale\n"\
         "-p which installed product to open (wow/wowt/wow_beta)\n"\
+        "-t number of map tiles converted at the same time - standard: number of cores\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"\n", prg, prg);
     exit(1);
 }
@@ -175,6 +180,7 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // l - dbc locale
+        // t - thread count
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -225,6 +231,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc)                            // all ok
+                    CONF_Threads = std::max(1, atoi(arg[c++ + 1]));
+                else
+                    Usage(arg[0]);
+                break;
             case 'h':
                 Usage(arg[0]);
                 break;
@@ -400,24 +412,24 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per worker thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-map_liquidHeaderTypeFlags liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local map_liquidHeaderTypeFlags liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 LiquidVertexFormatType adt_MH2O::GetLiquidVertexFormat(adt_liquid_instance const* liquidInstance) const
 {
@@ -933,70 +945,80 @@ bool ConvertADT(ChunkedFile& adt, std::string const& mapName, std::string const&
     }
 
     // Ok all data prepared - store it
-    std::ofstream outFile(outputPath, std::ofstream::out | std::ofstream::binary);
-    if (!outFile)
+    // the whole file is assembled in memory and written with a single call
+    std::vector<char> fileData;
+    fileData.reserve(sizeof(map) + map.areaMapSize + map.heightMapSize + map.liquidMapSize + map.holesSize);
+    auto write = [&fileData](void const* data, std::size_t size)
     {
-        printf("Can't create the output file '%s'\n", outputPath.c_str());
-        return false;
-    }
+        char const* bytes = reinterpret_cast<char const*>(data);
+        fileData.insert(fileData.end(), bytes, bytes + size);
+    };
 
-    outFile.write(reinterpret_cast<char const*>(&map), sizeof(map));
+    write(&map, sizeof(map));
     // Store area data
-    outFile.write(reinterpret_cast<char const*>(&areaHeader), sizeof(areaHeader));
+    write(&areaHeader, sizeof(areaHeader));
     if (!areaHeader.flags.HasFlag(map_areaHeaderFlags::NoArea))
-        outFile.write(reinterpret_cast<char const*>(area_ids), sizeof(area_ids));
+        write(area_ids, sizeof(area_ids));
 
     // Store height data
-    outFile.write(reinterpret_cast<char const*>(&heightHeader), sizeof(heightHeader));
+    write(&heightHeader, sizeof(heightHeader));
     if (!heightHeader.flags.HasFlag(map_heightHeaderFlags::NoHeight))
     {
         if (heightHeader.flags.HasFlag(map_heightHeaderFlags::HeightAsInt16))
         {
-            outFile.write(reinterpret_cast<char const*>(uint16_V9), sizeof(uint16_V9));
-            outFile.write(reinterpret_cast<char const*>(uint16_V8), sizeof(uint16_V8));
+            write(uint16_V9, sizeof(uint16_V9));
+            write(uint16_V8, sizeof(uint16_V8));
         }
         else if (heightHeader.flags.HasFlag(map_heightHeaderFlags::HeightAsInt8))
         {
-            outFile.write(reinterpret_cast<char const*>(uint8_V9), sizeof(uint8_V9));
-            outFile.write(reinterpret_cast<char const*>(uint8_V8), sizeof(uint8_V8));
+            write(uint8_V9, sizeof(uint8_V9));
+            write(uint8_V8, sizeof(uint8_V8));
         }
         else
         {
-            outFile.write(reinterpret_cast<char const*>(V9), sizeof(V9));
-            outFile.write(reinterpret_cast<char const*>(V8), sizeof(V8));
+            write(V9, sizeof(V9));
+            write(V8, sizeof(V8));
         }
     }
 
     if (heightHeader.flags.HasFlag(map_heightHeaderFlags::HasFlightBounds))
     {
-        outFile.write(reinterpret_cast<char*>(flight_box_max), sizeof(flight_box_max));
-        outFile.write(reinterpret_cast<char*>(flight_box_min), sizeof(flight_box_min));
+        write(flight_box_max, sizeof(flight_box_max));
+        write(flight_box_min, sizeof(flight_box_min));
     }
 
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
-        outFile.write(reinterpret_cast<char const*>(&liquidHeader), sizeof(liquidHeader));
+        write(&liquidHeader, sizeof(liquidHeader));
         if (!liquidHeader.flags.HasFlag(map_liquidHeaderFlags::NoType))
         {
-            outFile.write(reinterpret_cast<char const*>(liquid_entry), sizeof(liquid_entry));
-            outFile.write(reinterpret_cast<char const*>(liquid_flags), sizeof(liquid_flags));
+            write(liquid_entry, sizeof(liquid_entry));
+            write(liquid_flags, sizeof(liquid_flags));
         }
 
         if (!liquidHeader.flags.HasFlag(map_liquidHeaderFlags::NoHeight))
         {
             for (int y = 0; y < liquidHeader.height; y++)
-                outFile.write(reinterpret_cast<char const*>(&liquid_height[y + liquidHeader.offsetY][liquidHeader.offsetX]), sizeof(float) * liquidHeader.width);
+                write(&liquid_height[y + liquidHeader.offsetY][liquidHeader.offsetX], sizeof(float) * liquidHeader.width);
         }
     }
 
     // store hole data
     if (hasHoles)
-        outFile.write(reinterpret_cast<char const*>(holes), map.holesSize);
+        write(holes, map.holesSize);
 
-    outFile.close();
+    FILE* output = fopen(outputPath.c_str(), "wb");
+    if (!output)
+    {
+        printf("Can't create the output file '%s'\n", outputPath.c_str());
+        return false;
+    }
 
-    return true;
+    bool success = fwrite(fileData.data(), 1, fileData.size(), output) == fileData.size();
+    fclose(output);
+
+    return success;
 }
 
 bool ConvertADT(std::string const& fileName, std::string const& mapName, std::string const& outputPath, int gx, int gy, uint32 build, bool ignoreDeepWater)
@@ -1048,8 +1070,6 @@ bool IsDeepWaterIgnored(uint32 mapId, uint32 x, uint32 y)
 
 void ExtractMaps(uint32 build)
 {
-    std::string outputFileName;
-
     printf("Extracting maps...\n");
 
     ReadMapDBC();
@@ -1060,50 +1080,94 @@ void ExtractMaps(uint32 build)
 
     CreateDir(output_path / "maps");
 
-    printf("Convert map files\n");
+    struct TileToExtract
+    {
+        std::size_t MapIndex = 0;
+        uint32 X = 0;
+        uint32 Y = 0;
+        uint32 FileDataId = 0;
+        std::string StoragePath;
+        bool Converted = false;
+    };
+
+    // collect the tiles of all maps first so that small instances do not leave worker threads idle
+    std::vector<TileToExtract> tiles;
+    std::vector<std::bitset<(WDT_MAP_SIZE) * (WDT_MAP_SIZE)>> existingTiles(map_ids.size());
     for (std::size_t z = 0; z < map_ids.size(); ++z)
     {
-        printf("Extract %s (" SZFMTD "/" SZFMTD ")                  \n", map_ids[z].Name.c_str(), z + 1, map_ids.size());
         // Loadup map grid data
         ChunkedFile wdt;
-        std::bitset<(WDT_MAP_SIZE) * (WDT_MAP_SIZE)> existingTiles;
-        if (wdt.loadFile(CascStorage, map_ids[z].WdtFileDataId, Trinity::StringFormat("WDT for map %u", map_ids[z].Id), false))
+        if (!wdt.loadFile(CascStorage, map_ids[z].WdtFileDataId, Trinity::StringFormat("WDT for map %u", map_ids[z].Id), false))
+            continue;
+
+        FileChunk* mphd = wdt.GetChunk("MPHD");
+        FileChunk* main = wdt.GetChunk("MAIN");
+        FileChunk* maid = wdt.GetChunk("MAID");
+        for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
         {
-            FileChunk* mphd = wdt.GetChunk("MPHD");
-            FileChunk* main = wdt.GetChunk("MAIN");
-            FileChunk* maid = wdt.GetChunk("MAID");
-            for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
+            for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
             {
-                for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
-                {
-                    if (!(main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
-                        continue;
-
-                    outputFileName = Trinity::StringFormat("%s/maps/%04u_%02u_%02u.map", output_path.string().c_str(), map_ids[z].Id, y, x);
-                    bool ignoreDeepWater = IsDeepWaterIgnored(map_ids[z].Id, y, x);
-                    if (mphd && mphd->As<wdt_MPHD>()->flags & 0x200)
-                    {
-                        existingTiles[y * WDT_MAP_SIZE + x] = ConvertADT(maid->As<wdt_MAID>()->adt_files[y][x].rootADT, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
-                    }
-                    else
-                    {
-                        std::string storagePath = Trinity::StringFormat(R"(World\Maps\%s\%s_%u_%u.adt)", map_ids[z].Directory.c_str(), map_ids[z].Directory.c_str(), x, y);
-                        existingTiles[y * WDT_MAP_SIZE + x] = ConvertADT(storagePath, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
-                    }
-                }
+                if (!(main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
+                    continue;
 
-                // draw progress bar
-                if (PrintProgress)
-                    printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
+                tiles.emplace_back();
+                TileToExtract& tile = tiles.back();
+                tile.MapIndex = z;
+                tile.X = x;
+                tile.Y = y;
+                if (mphd && mphd->As<wdt_MPHD>()->flags & 0x200)
+                    tile.FileDataId = maid->As<wdt_MAID>()->adt_files[y][x].rootADT;
+                else
+                    tile.StoragePath = Trinity::StringFormat(R"(World\Maps\%s\%s_%u_%u.adt)", map_ids[z].Directory.c_str(), map_ids[z].Directory.c_str(), x, y);
             }
         }
+    }
+
+    printf("Convert map files (" SZFMTD " tiles in " SZFMTD " maps) using %u threads\n", tiles.size(), map_ids.size(), CONF_Threads);
+
+    std::atomic<std::size_t> nextTile(0);
+    std::atomic<std::size_t> tilesDone(0);
+    auto worker = [&]()
+    {
+        for (std::size_t i = nextTile++; i < tiles.size(); i = nextTile++)
+        {
+            TileToExtract& tile = tiles[i];
+            MapEntry const& mapEntry = map_ids[tile.MapIndex];
+            std::string outputFileName = Trinity::StringFormat("%s/maps/%04u_%02u_%02u.map", output_path.string().c_str(), mapEntry.Id, tile.Y, tile.X);
+            bool ignoreDeepWater = IsDeepWaterIgnored(mapEntry.Id, tile.Y, tile.X);
+            // bits of one map are shared between threads, they are only set once all workers are joined
+            tile.Converted = tile.FileDataId
+                ? ConvertADT(tile.FileDataId, mapEntry.Name, outputFileName, tile.Y, tile.X, build, ignoreDeepWater)
+                : ConvertADT(tile.StoragePath, mapEntry.Name, outputFileName, tile.Y, tile.X, build, ignoreDeepWater);
+
+            std::size_t done = ++tilesDone;
+            // draw progress bar
+            if (PrintProgress && (done % 64 == 0 || done == tiles.size()))
+                printf("Processing........................%u%%\r", uint32(100 * done / tiles.size()));
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < std::min<std::size_t>(CONF_Threads, tiles.size()); ++i)
+        workers.emplace_back(worker);
 
+    worker();
+
+    for (std::thread& thread : workers)
+        thread.join();
+
+    for (TileToExtract const& tile : tiles)
+        if (tile.Converted)
+            existingTiles[tile.MapIndex][tile.Y * WDT_MAP_SIZE + tile.X] = true;
+
+    for (std::size_t z = 0; z < map_ids.size(); ++z)
+    {
         if (FILE* tileList = fopen(Trinity::StringFormat("%s/maps/%04u.tilelist", output_path.string().c_str(), map_ids[z].Id).c_str(), "wb"))
         {
             fwrite(MapMagic.data(), 1, MapMagic.size(), tileList);
             fwrite(&MapVersionMagic, 1, sizeof(MapVersionMagic), tileList);
             fwrite(&build, sizeof(build), 1, tileList);
-            fwrite(existingTiles.to_string().c_str(), 1, existingTiles.size(), tileList);
+            fwrite(existingTiles[z].to_string().c_str(), 1, existingTiles[z].size(), tileList);
             fclose(tileList);
         }
     }
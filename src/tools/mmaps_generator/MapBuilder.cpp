@@ -22,13 +22,106 @@
 #include "ModelInstance.h"
 #include "PathCommon.h"
 #include "StringFormat.h"
+#include "VMapManager2.h"
 #include <DetourCommon.h>
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
+#include <algorithm>
 #include <climits>
 
 namespace MMAP
 {
+    static void hashBytes(uint64& hash, void const* data, std::size_t size)
+    {
+        // 64 bit FNV-1a
+        uint8 const* bytes = static_cast<uint8 const*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= UI64LIT(0x100000001b3);
+        }
+    }
+
+    static void hashFile(uint64& hash, std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+
+        // missing files still change the hash, a tile must be rebuilt when one of its inputs appears or disappears
+        uint8 exists = file ? 1 : 0;
+        hashBytes(hash, fileName.c_str(), fileName.length());
+        hashBytes(hash, &exists, sizeof(exists));
+        if (!file)
+            return;
+
+        std::vector<char> buffer(0x10000);
+        std::size_t count;
+        while ((count = fread(buffer.data(), 1, buffer.size(), file)) > 0)
+            hashBytes(hash, buffer.data(), count);
+
+        fclose(file);
+    }
+
+    static uint64 getFileSize(std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+            return 0;
+
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fclose(file);
+        return size > 0 ? uint64(size) : 0;
+    }
+
+    static bool fileExists(std::string const& fileName)
+    {
+        if (FILE* file = fopen(fileName.c_str(), "rb"))
+        {
+            fclose(file);
+            return true;
+        }
+
+        return false;
+    }
+
+    // resolves the terrain tile the same way TerrainBuilder::loadMap does, falling back to parent maps
+    // lookup without inserting, called concurrently from the tile builder threads
+    static int32 getParentMapId(int32 mapID)
+    {
+        if (MapEntry const* map = Trinity::Containers::MapGetValuePtr(sMapStore, uint32(mapID)))
+            return map->ParentMapID;
+
+        return -1;
+    }
+
+    static std::string getMapTileFileName(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        std::string fileName = Trinity::StringFormat("maps/%04u_%02u_%02u.map", mapID, tileY, tileX);
+        int32 parentMapId = getParentMapId(mapID);
+        while (!fileExists(fileName) && parentMapId != -1)
+        {
+            fileName = Trinity::StringFormat("maps/%04d_%02u_%02u.map", parentMapId, tileY, tileX);
+            parentMapId = getParentMapId(parentMapId);
+        }
+
+        return fileName;
+    }
+
+    // resolves the vmap tile the same way StaticMapTree::OpenMapTileFile does, falling back to parent maps
+    static std::string getVMapTileFileName(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        // TileBuilder::buildTile passes swapped coordinates to TerrainBuilder::loadVMap, keep them in sync
+        std::string fileName = "vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX);
+        int32 parentMapId = getParentMapId(mapID);
+        while (!fileExists(fileName) && parentMapId != -1)
+        {
+            fileName = "vmaps/" + StaticMapTree::getTileFileName(parentMapId, tileY, tileX);
+            parentMapId = getParentMapId(parentMapId);
+        }
+
+        return fileName;
+    }
+
     TileBuilder::TileBuilder(MapBuilder* mapBuilder, bool skipLiquid, bool bigBaseUnit, bool debugOutput) :
         m_bigBaseUnit(bigBaseUnit),
         m_debugOutput(debugOutput),
@@ -241,9 +334,10 @@ namespace MMAP
             m_tileBuilders.push_back(new TileBuilder(this, m_skipLiquid, m_bigBaseUnit, m_debugOutput));
         }
 
+        std::vector<TileInfo> tileInfos;
         if (mapID)
         {
-            buildMap(*mapID);
+            buildMap(*mapID, tileInfos);
         }
         else
         {
@@ -251,10 +345,19 @@ namespace MMAP
             for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
             {
                 if (!shouldSkipMap(it->m_mapId))
-                    buildMap(it->m_mapId);
+                    buildMap(it->m_mapId, tileInfos);
             }
         }
 
+        // start with the most expensive tiles so that a few large tiles are not left running alone at the end
+        std::stable_sort(tileInfos.begin(), tileInfos.end(), [](TileInfo const& left, TileInfo const& right)
+        {
+            return left.m_estimatedCost > right.m_estimatedCost;
+        });
+
+        for (TileInfo const& tileInfo : tileInfos)
+            _queue.Push(tileInfo);
+
         while (!_queue.Empty())
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -422,7 +525,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
+    void MapBuilder::buildMap(uint32 mapID, std::vector<TileInfo>& tileInfos)
     {
         std::set<uint32>* tiles = getTileList(mapID);
 
@@ -452,17 +555,25 @@ namespace MMAP
                 tileInfo.m_tileX = tileX;
                 tileInfo.m_tileY = tileY;
                 memcpy(&tileInfo.m_navMeshParams, navMesh->getParams(), sizeof(dtNavMeshParams));
-                _queue.Push(tileInfo);
+                tileInfo.m_estimatedCost = getTileCost(mapID, tileX, tileY);
+                tileInfos.push_back(tileInfo);
             }
 
             dtFreeNavMesh(navMesh);
         }
     }
 
+    uint64 MapBuilder::getTileCost(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        // model geometry dominates build time, terrain is roughly the same for every tile
+        return getFileSize(getMapTileFileName(mapID, tileX, tileY)) + getFileSize(getVMapTileFileName(mapID, tileX, tileY));
+    }
+
     /**************************************************************************/
     void TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
-        if(shouldSkipTile(mapID, tileX, tileY))
+        uint64 inputHash = getTileInputHash(mapID, tileX, tileY, navMesh);
+        if (shouldSkipTile(mapID, tileX, tileY, inputHash))
         {
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
@@ -481,6 +592,7 @@ namespace MMAP
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
         {
+            writeTileInputHash(mapID, tileX, tileY, inputHash, false);
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
         }
@@ -496,6 +608,7 @@ namespace MMAP
 
         if (!allVerts.size())
         {
+            writeTileInputHash(mapID, tileX, tileY, inputHash, false);
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
         }
@@ -506,8 +619,10 @@ namespace MMAP
 
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_mapBuilder->m_offMeshFilePath);
 
-        // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        // build navmesh tile, failures are not recorded so that the tile is retried on the next run
+        TileBuildResult result = buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        if (result != TileBuildResult::Failed)
+            writeTileInputHash(mapID, tileX, tileY, inputHash, result == TileBuildResult::Written);
 
         ++m_mapBuilder->m_totalTilesProcessed;
     }
@@ -598,7 +713,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void TileBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    TileBuildResult TileBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
         dtNavMesh* navMesh)
     {
@@ -765,7 +880,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TileBuildResult::Failed;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -776,7 +891,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return TileBuildResult::Failed;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -836,6 +951,7 @@ namespace MMAP
         // will hold final navmesh
         unsigned char* navData = nullptr;
         int navDataSize = 0;
+        TileBuildResult result = TileBuildResult::Failed;
 
         do
         {
@@ -858,6 +974,7 @@ namespace MMAP
 
                 // message is an annoyance
                 //printf("%sNo vertices to build tile!              \n", tileString.c_str());
+                result = TileBuildResult::Empty;
                 break;
             }
             if (!params.polyCount || !params.polys ||
@@ -867,6 +984,7 @@ namespace MMAP
                 // keep in mind that we do output those into debug info
                 // drop tiles with only exact count - some tiles may have geometry while having less tiles
                 printf("%s No polygons to build on tile!              \n", tileString.c_str());
+                result = TileBuildResult::Empty;
                 break;
             }
             if (!params.detailMeshes || !params.detailVerts || !params.detailTris)
@@ -925,6 +1043,7 @@ namespace MMAP
 
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, nullptr, nullptr);
+            result = TileBuildResult::Written;
         }
         while (false);
 
@@ -941,6 +1060,8 @@ namespace MMAP
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return result;
     }
 
     /**************************************************************************/
@@ -1036,16 +1157,32 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const
+    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash) const
     {
         char fileName[255];
-        sprintf(fileName, "mmaps/%04u%02i%02i.mmtile", mapID, tileY, tileX);
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmtile.hash", mapID, tileY, tileX);
         FILE* file = fopen(fileName, "rb");
         if (!file)
             return false;
 
+        uint64 storedHash = 0;
+        uint32 hasTile = 0;
+        int count = fscanf(file, "%" SCNx64 " %u", &storedHash, &hasTile);
+        fclose(file);
+        if (count != 2 || storedHash != inputHash)
+            return false;
+
+        // inputs did not change and produced no geometry last time
+        if (!hasTile)
+            return true;
+
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmtile", mapID, tileY, tileX);
+        file = fopen(fileName, "rb");
+        if (!file)
+            return false;
+
         MmapTileHeader header;
-        int count = fread(&header, sizeof(MmapTileHeader), 1, file);
+        count = fread(&header, sizeof(MmapTileHeader), 1, file);
         fclose(file);
         if (count != 1)
             return false;
@@ -1059,6 +1196,74 @@ namespace MMAP
         return true;
     }
 
+    uint64 TileBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh const* navMesh) const
+    {
+        uint64 hash = UI64LIT(0xcbf29ce484222325);
+
+        // generator settings and format versions
+        uint32 versions[] = { MMAP_VERSION, uint32(DT_NAVMESH_VERSION) };
+        hashBytes(hash, versions, sizeof(versions));
+        bool flags[] = { m_mapBuilder->m_skipLiquid, m_bigBaseUnit, m_mapBuilder->m_maxWalkableAngle.has_value(), m_mapBuilder->m_maxWalkableAngleNotSteep.has_value() };
+        hashBytes(hash, flags, sizeof(flags));
+        float walkableAngles[] = { m_mapBuilder->m_maxWalkableAngle.value_or(0.0f), m_mapBuilder->m_maxWalkableAngleNotSteep.value_or(0.0f) };
+        hashBytes(hash, walkableAngles, sizeof(walkableAngles));
+        hashBytes(hash, navMesh->getParams(), sizeof(dtNavMeshParams));
+
+        // terrain, neighbour tiles contribute their borders
+        hashFile(hash, getMapTileFileName(mapID, tileX, tileY));
+        hashFile(hash, getMapTileFileName(mapID, tileX + 1, tileY));
+        hashFile(hash, getMapTileFileName(mapID, tileX - 1, tileY));
+        hashFile(hash, getMapTileFileName(mapID, tileX, tileY + 1));
+        hashFile(hash, getMapTileFileName(mapID, tileX, tileY - 1));
+
+        // models
+        hashFile(hash, "vmaps/" + VMapManager2::getMapFileName(mapID));
+        hashFile(hash, getVMapTileFileName(mapID, tileX, tileY));
+
+        // only the offmesh connections of this tile
+        if (char const* offMeshFilePath = m_mapBuilder->m_offMeshFilePath)
+        {
+            if (FILE* file = fopen(offMeshFilePath, "rb"))
+            {
+                char buf[512];
+                while (fgets(buf, sizeof(buf), file))
+                {
+                    uint32 mid, tx, ty;
+                    if (sscanf(buf, "%u %u,%u", &mid, &tx, &ty) == 3 && mid == mapID && tx == tileX && ty == tileY)
+                        hashBytes(hash, buf, strlen(buf));
+                }
+
+                fclose(file);
+            }
+        }
+
+        return hash;
+    }
+
+    void TileBuilder::writeTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash, bool hasTile) const
+    {
+        char fileName[255];
+        if (!hasTile)
+        {
+            // tile used to have geometry, remove it so that the server does not keep loading stale data
+            sprintf(fileName, "mmaps/%04u%02i%02i.mmtile", mapID, tileY, tileX);
+            remove(fileName);
+        }
+
+        sprintf(fileName, "mmaps/%04u%02i%02i.mmtile.hash", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "wb");
+        if (!file)
+        {
+            char message[1024];
+            sprintf(message, "[Map %04u] Failed to open %s for writing!\n", mapID, fileName);
+            perror(message);
+            return;
+        }
+
+        fprintf(file, "%016" PRIx64 " %u\n", inputHash, hasTile ? 1u : 0u);
+        fclose(file);
+    }
+
     rcConfig MapBuilder::GetMapSpecificConfig(uint32 mapID, float bmin[3], float bmax[3], const TileConfig &tileConfig) const
     {
         rcConfig config;
@@ -96,12 +96,21 @@ namespace MMAP
 
     struct TileInfo
     {
-        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams() {}
+        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams(), m_estimatedCost(0) {}
 
         uint32 m_mapId;
         uint32 m_tileX;
         uint32 m_tileY;
         dtNavMeshParams m_navMeshParams;
+        // size of the tile input files, used to queue the most expensive tiles first
+        uint64 m_estimatedCost;
+    };
+
+    enum class TileBuildResult
+    {
+        Written,
+        Empty,      // inputs produce no navmesh geometry
+        Failed
     };
 
     // ToDo: move this to its own file. For now it will stay here to keep the changes to a minimum, especially in the cpp file
@@ -122,7 +131,7 @@ namespace MMAP
 
             void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
             // move map building
-            void buildMoveMapTile(uint32 mapID,
+            TileBuildResult buildMoveMapTile(uint32 mapID,
                 uint32 tileX,
                 uint32 tileY,
                 MeshData& meshData,
@@ -130,7 +139,11 @@ namespace MMAP
                 float bmax[3],
                 dtNavMesh* navMesh);
 
-            bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const;
+            bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash) const;
+
+            // hash of everything the tile is generated from: terrain of the tile and its neighbours, vmap tile, offmesh connections and generator settings
+            uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh const* navMesh) const;
+            void writeTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash, bool hasTile) const;
 
         private:
             bool m_bigBaseUnit;
@@ -171,8 +184,9 @@ namespace MMAP
             void buildMaps(Optional<uint32> mapID);
 
         private:
-            // builds all mmap tiles for the specified map id (ignores skip settings)
-            void buildMap(uint32 mapID);
+            // queues all mmap tiles for the specified map id (ignores skip settings)
+            void buildMap(uint32 mapID, std::vector<TileInfo>& tileInfos);
+            uint64 getTileCost(uint32 mapID, uint32 tileX, uint32 tileY) const;
             // detect maps and tiles
             void discoverTiles();
             std::set<uint32>* getTileList(uint32 mapID);
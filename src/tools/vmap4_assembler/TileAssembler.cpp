@@ -21,9 +21,12 @@
 #include "StringFormat.h"
 #include "VMapDefinitions.h"
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <set>
 #include <sstream>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -46,8 +49,8 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
-        : iDestDir(pDestDirName), iSrcDir(pSrcDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, unsigned int threads)
+        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iThreads(std::max(1u, threads))
     {
         boost::filesystem::create_directory(iDestDir);
     }
@@ -56,132 +59,170 @@ namespace VMAP
     {
     }
 
+    template<typename Work>
+    void TileAssembler::runParallel(std::size_t count, Work work) const
+    {
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]()
+        {
+            for (std::size_t i = next++; i < count; i = next++)
+                work(i);
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < std::min<std::size_t>(iThreads, count); ++i)
+            workers.emplace_back(worker);
+
+        worker();
+
+        for (std::thread& thread : workers)
+            thread.join();
+    }
+
     bool TileAssembler::convertWorld2()
     {
-        bool success = readMapSpawns();
-        if (!success)
+        if (!readMapSpawns())
             return false;
 
-        float constexpr invTileSize = 1.0f / 533.33333f;
+        printf("Using %u threads to assemble vmaps\n", iThreads);
 
         // export Map data
-        while (!mapData.empty())
+        std::atomic<bool> success(true);
+        runParallel(mapData.size(), [&](std::size_t i)
         {
-            MapSpawns data = std::move(mapData.front());
-            mapData.pop_front();
-
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            mapSpawns.reserve(data.UniqueEntries.size());
-            printf("Calculating model bounds for map %u...\n", data.MapId);
-            for (auto entry = data.UniqueEntries.begin(); entry != data.UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, they're not used for LoS but are needed for pathfinding
-                if (entry->second.flags & MOD_M2)
-                    if (!calculateTransformedBound(entry->second))
-                        continue;
-
-                mapSpawns.push_back(&entry->second);
-                spawnedModelFiles.insert(entry->second.name);
-
-                std::map<uint32, std::set<TileSpawn>>& tileEntries = (entry->second.flags & MOD_PARENT_SPAWN) ? data.ParentTileEntries : data.TileEntries;
-
-                G3D::AABox const& bounds = entry->second.iBound;
-                G3D::Vector2int16 low(int16(bounds.low().x * invTileSize), int16(bounds.low().y * invTileSize));
-                G3D::Vector2int16 high(int16(bounds.high().x * invTileSize), int16(bounds.high().y * invTileSize));
-                for (int x = low.x; x <= high.x; ++x)
-                    for (int y = low.y; y <= high.y; ++y)
-                        tileEntries[StaticMapTree::packTileID(x, y)].emplace(entry->second.ID, entry->second.flags);
-            }
+            if (success && !convertMap(mapData[i]))
+                success = false;
+        });
 
-            printf("Creating map tree for map %u...\n", data.MapId);
-            BIH pTree;
+        mapData.clear();
 
-            try
-            {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
-            }
-            catch (std::exception& e)
-            {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
-                return false;
-            }
+        if (!success)
+            return false;
 
-            // ===> possibly move this code to StaticMapTree class
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        runParallel(modelFiles.size(), [&](std::size_t i)
+        {
+            if (!success)
+                return;
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << data.MapId << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+            printf("Converting %s\n", modelFiles[i].c_str());
+            if (!convertRawFile(modelFiles[i]))
             {
+                printf("error converting %s\n", modelFiles[i].c_str());
                 success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
             }
+        });
 
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-
-            // spawn id to index map
-            uint32 mapSpawnsSize = mapSpawns.size();
-            if (success && fwrite("SIDX", 4, 1, mapfile) != 1) success = false;
-            if (success && fwrite(&mapSpawnsSize, sizeof(uint32), 1, mapfile) != 1) success = false;
-            for (uint32 i = 0; i < mapSpawnsSize; ++i)
-            {
-                if (success && fwrite(&mapSpawns[i]->ID, sizeof(uint32), 1, mapfile) != 1) success = false;
-            }
+        return success;
+    }
+
+    bool TileAssembler::convertMap(MapSpawns& data)
+    {
+        bool success = true;
+        float constexpr invTileSize = 1.0f / 533.33333f;
 
-            fclose(mapfile);
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        std::set<std::string> modelFiles;
+        mapSpawns.reserve(data.UniqueEntries.size());
+        printf("Calculating model bounds for map %u...\n", data.MapId);
+        for (auto entry = data.UniqueEntries.begin(); entry != data.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, they're not used for LoS but are needed for pathfinding
+            if (entry->second.flags & MOD_M2)
+                if (!calculateTransformedBound(entry->second))
+                    continue;
+
+            mapSpawns.push_back(&entry->second);
+            modelFiles.insert(entry->second.name);
+
+            std::map<uint32, std::set<TileSpawn>>& tileEntries = (entry->second.flags & MOD_PARENT_SPAWN) ? data.ParentTileEntries : data.TileEntries;
+
+            G3D::AABox const& bounds = entry->second.iBound;
+            G3D::Vector2int16 low(int16(bounds.low().x * invTileSize), int16(bounds.low().y * invTileSize));
+            G3D::Vector2int16 high(int16(bounds.high().x * invTileSize), int16(bounds.high().y * invTileSize));
+            for (int x = low.x; x <= high.x; ++x)
+                for (int y = low.y; y <= high.y; ++y)
+                    tileEntries[StaticMapTree::packTileID(x, y)].emplace(entry->second.ID, entry->second.flags);
+        }
 
-            // <====
+        printf("Creating map tree for map %u...\n", data.MapId);
+        BIH pTree;
 
-            // write map tile files, similar to ADT files, only with extra BIH tree node info
-            for (auto tileItr = data.TileEntries.begin(); tileItr != data.TileEntries.end(); ++tileItr)
-            {
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tileItr->first, x, y);
-                std::string tileFileName = Trinity::StringFormat("%s/%04u_%02u_%02u.vmtile", iDestDir.c_str(), data.MapId, y, x);
-                if (FILE* tileFile = fopen(tileFileName.c_str(), "wb"))
-                {
-                    std::set<TileSpawn> const& parentTileEntries = data.ParentTileEntries[tileItr->first];
-
-                    uint32 nSpawns = tileItr->second.size() + parentTileEntries.size();
-
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tileFile) != 8) success = false;
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tileFile) != 1) success = false;
-                    // write tile spawns
-                    for (auto spawnItr = tileItr->second.begin(); spawnItr != tileItr->second.end() && success; ++spawnItr)
-                        success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[spawnItr->Id]);
-
-                    for (auto spawnItr = parentTileEntries.begin(); spawnItr != parentTileEntries.end() && success; ++spawnItr)
-                        success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[spawnItr->Id]);
-
-                    fclose(tileFile);
-                }
-            }
+        try
+        {
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build for map %u\n", e.what(), data.MapId);
+            return false;
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::string const& spawnedModelFile : spawnedModelFiles)
+        // ===> possibly move this code to StaticMapTree class
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << data.MapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
+
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+
+        // spawn id to index map
+        uint32 mapSpawnsSize = mapSpawns.size();
+        if (success && fwrite("SIDX", 4, 1, mapfile) != 1) success = false;
+        if (success && fwrite(&mapSpawnsSize, sizeof(uint32), 1, mapfile) != 1) success = false;
+        for (uint32 i = 0; i < mapSpawnsSize; ++i)
+        {
+            if (success && fwrite(&mapSpawns[i]->ID, sizeof(uint32), 1, mapfile) != 1) success = false;
+        }
+
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BIH tree node info
+        for (auto tileItr = data.TileEntries.begin(); tileItr != data.TileEntries.end(); ++tileItr)
         {
-            std::cout << "Converting " << spawnedModelFile << std::endl;
-            if (!convertRawFile(spawnedModelFile))
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tileItr->first, x, y);
+            std::string tileFileName = Trinity::StringFormat("%s/%04u_%02u_%02u.vmtile", iDestDir.c_str(), data.MapId, y, x);
+            if (FILE* tileFile = fopen(tileFileName.c_str(), "wb"))
             {
-                std::cout << "error converting " << spawnedModelFile << std::endl;
-                success = false;
-                break;
+                std::set<TileSpawn> const& parentTileEntries = data.ParentTileEntries[tileItr->first];
+
+                uint32 nSpawns = tileItr->second.size() + parentTileEntries.size();
+
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tileFile) != 8) success = false;
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tileFile) != 1) success = false;
+                // write tile spawns
+                for (auto spawnItr = tileItr->second.begin(); spawnItr != tileItr->second.end() && success; ++spawnItr)
+                    success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[spawnItr->Id]);
+
+                for (auto spawnItr = parentTileEntries.begin(); spawnItr != parentTileEntries.end() && success; ++spawnItr)
+                    success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[spawnItr->Id]);
+
+                fclose(tileFile);
             }
         }
 
+        std::lock_guard<std::mutex> lock(spawnedModelFilesLock);
+        spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
         return success;
     }
 
@@ -228,28 +269,49 @@ namespace VMAP
         return success;
     }
 
-    bool TileAssembler::calculateTransformedBound(ModelSpawn &spawn)
+    Optional<AABox> TileAssembler::getModelBounds(std::string const& modelName)
     {
+        {
+            std::lock_guard<std::mutex> lock(modelBoundsLock);
+            auto itr = modelBounds.find(modelName);
+            if (itr != modelBounds.end())
+                return itr->second;
+        }
+
         std::string modelFilename(iSrcDir);
         modelFilename.push_back('/');
-        modelFilename.append(spawn.name);
+        modelFilename.append(modelName);
+
+        Optional<AABox> bounds;
+        WorldModel_Raw raw_model;
+        if (raw_model.Read(modelFilename.c_str()) && !raw_model.groupsArray.empty())
+        {
+            if (raw_model.groupsArray.size() != 1)
+                printf("Warning: '%s' does not seem to be a M2 model!\n", modelFilename.c_str());
+
+            bounds = raw_model.groupsArray[0].bounds;
+        }
+
+        // two threads may read the same model at once, both get the same result
+        std::lock_guard<std::mutex> lock(modelBoundsLock);
+        modelBounds.emplace(modelName, bounds);
+        return bounds;
+    }
+
+    bool TileAssembler::calculateTransformedBound(ModelSpawn &spawn)
+    {
+        Optional<AABox> bounds = getModelBounds(spawn.name);
+        if (!bounds)
+            return false;
 
         ModelPosition modelPosition;
         modelPosition.iDir = spawn.iRot;
         modelPosition.iScale = spawn.iScale;
         modelPosition.init();
 
-        WorldModel_Raw raw_model;
-        if (!raw_model.Read(modelFilename.c_str()))
-            return false;
-
-        uint32 groups = raw_model.groupsArray.size();
-        if (groups != 1)
-            printf("Warning: '%s' does not seem to be a M2 model!\n", modelFilename.c_str());
-
         AABox rotated_bounds;
         for (int i = 0; i < 8; ++i)
-            rotated_bounds.merge(modelPosition.transform(raw_model.groupsArray[0].bounds.corner(i)));
+            rotated_bounds.merge(modelPosition.transform(bounds->corner(i)));
 
         spawn.iBound = rotated_bounds + spawn.iPos;
         spawn.flags |= MOD_HAS_BOUND;
@@ -22,9 +22,12 @@
 #include <G3D/Matrix3.h>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 
 #include "ModelInstance.h"
+#include "Optional.h"
 #include "WorldModel.h"
 
 namespace VMAP
@@ -107,15 +110,25 @@ namespace VMAP
         private:
             std::string iDestDir;
             std::string iSrcDir;
+            unsigned int iThreads;
             MapData mapData;
+            std::mutex spawnedModelFilesLock;
             std::set<std::string> spawnedModelFiles;
+            // raw bounds of M2 models, shared by all spawns of the same model
+            std::mutex modelBoundsLock;
+            std::unordered_map<std::string, Optional<G3D::AABox>> modelBounds;
+
+            template<typename Work>
+            void runParallel(std::size_t count, Work work) const;
 
         public:
-            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, unsigned int threads);
             virtual ~TileAssembler();
 
             bool convertWorld2();
+            bool convertMap(MapSpawns& data);
             bool readMapSpawns();
+            Optional<G3D::AABox> getModelBounds(std::string const& modelName);
             bool calculateTransformedBound(ModelSpawn &spawn);
             void exportGameobjectModels();
 
@@ -97,23 +97,15 @@ ADTFile::ADTFile(uint32 fileDataId, std::string const& description, bool cache)
     dirfileCache = nullptr;
 }
 
-bool ADTFile::init(uint32 map_num, uint32 originalMapId)
+bool ADTFile::init(uint32 map_num, uint32 originalMapId, FILE* dirfile)
 {
     if (dirfileCache)
-        return initFromCache(map_num, originalMapId);
+        return initFromCache(map_num, originalMapId, dirfile);
 
     if (_file.isEof())
         return false;
 
     uint32 size;
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE* dirfile = fopen(dirname.c_str(), "ab");
-    if(!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     if (cacheable)
         dirfileCache = new std::vector<ADTOutputCache>();
 
@@ -210,14 +202,14 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
                     if (!(mapObjDef.Flags & 0x8))
                     {
                         MapObject::Extract(mapObjDef, WmoInstanceNames[mapObjDef.Id].c_str(), false, map_num, originalMapId, dirfile, dirfileCache);
-                        Doodad::ExtractSet(WmoDoodads[WmoInstanceNames[mapObjDef.Id]], mapObjDef, false, map_num, originalMapId, dirfile, dirfileCache);
+                        Doodad::ExtractSet(GetWmoDoodads(WmoInstanceNames[mapObjDef.Id]), mapObjDef, false, map_num, originalMapId, dirfile, dirfileCache);
                     }
                     else
                     {
                         std::string fileName = Trinity::StringFormat("FILE%08X.xxx", mapObjDef.Id);
                         ExtractSingleWmo(fileName);
                         MapObject::Extract(mapObjDef, fileName.c_str(), false, map_num, originalMapId, dirfile, dirfileCache);
-                        Doodad::ExtractSet(WmoDoodads[fileName], mapObjDef, false, map_num, originalMapId, dirfile, dirfileCache);
+                        Doodad::ExtractSet(GetWmoDoodads(fileName), mapObjDef, false, map_num, originalMapId, dirfile, dirfileCache);
                     }
                 }
 
@@ -230,23 +222,11 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
     }
 
     _file.close();
-    fclose(dirfile);
     return true;
 }
 
-bool ADTFile::initFromCache(uint32 map_num, uint32 originalMapId)
+bool ADTFile::initFromCache(uint32 map_num, uint32 originalMapId, FILE* dirfile) const
 {
-    if (dirfileCache->empty())
-        return true;
-
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE* dirfile = fopen(dirname.c_str(), "ab");
-    if (!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     for (ADTOutputCache const& cached : *dirfileCache)
     {
         fwrite(&map_num, sizeof(uint32), 1, dirfile);
@@ -257,7 +237,6 @@ bool ADTFile::initFromCache(uint32 map_num, uint32 originalMapId)
         fwrite(cached.Data.data(), cached.Data.size(), 1, dirfile);
     }
 
-    fclose(dirfile);
     return true;
 }
 
@@ -68,8 +68,8 @@ public:
     ~ADTFile();
     std::vector<std::string> WmoInstanceNames;
     std::vector<std::string> ModelInstanceNames;
-    bool init(uint32 map_num, uint32 originalMapId);
-    bool initFromCache(uint32 map_num, uint32 originalMapId);
+    bool init(uint32 map_num, uint32 originalMapId, FILE* dirfile);
+    bool initFromCache(uint32 map_num, uint32 originalMapId, FILE* dirfile) const;
 };
 
 char const* GetPlainName(char const* FileName);
@@ -48,14 +48,18 @@ bool ExtractSingleModel(std::string& fname)
     output += "/";
     output += name;
 
-    if (FileExists(output.c_str()))
-        return true;
+    bool result = true;
+    if (!ClaimModelExtraction(output, result))
+        return result;
 
-    Model mdl(originalName);
-    if (!mdl.open())
-        return false;
+    if (!FileExists(output.c_str()))
+    {
+        Model mdl(originalName);
+        result = mdl.open() && mdl.ConvertToVMAPModel(output.c_str());
+    }
 
-    return mdl.ConvertToVMAPModel(output.c_str());
+    FinishModelExtraction(output, result);
+    return result;
 }
 
 extern std::shared_ptr<CASC::Storage> CascStorage;
@@ -103,6 +107,16 @@ void ExtractGameobjectModels()
 
     fwrite(VMAP::RAW_VMAP_MAGIC, 1, 8, model_list);
 
+    struct GameObjectModel
+    {
+        uint32 DisplayId = 0;
+        std::string FileName;
+        uint8 IsWmo = 0;
+        bool Extracted = false;
+    };
+
+    std::vector<GameObjectModel> models;
+    models.reserve(db2.GetRecordCount());
     for (uint32 rec = 0; rec < db2.GetRecordCount(); ++rec)
     {
         DB2Record record = db2.GetRecord(rec);
@@ -113,32 +127,40 @@ void ExtractGameobjectModels()
         if (!fileId)
             continue;
 
-        std::string fileName = Trinity::StringFormat("FILE%08X.xxx", fileId);
-        bool result = false;
+        models.emplace_back();
+        models.back().DisplayId = record.GetId();
+        models.back().FileName = Trinity::StringFormat("FILE%08X.xxx", fileId);
+    }
+
+    // models are converted concurrently, the list is written afterwards to keep it in db2 order
+    ParallelFor(models.size(), [&models](std::size_t i)
+    {
+        GameObjectModel& model = models[i];
         uint32 header;
-        if (!GetHeaderMagic(fileName, &header))
-            continue;
+        if (!GetHeaderMagic(model.FileName, &header))
+            return;
 
-        uint8 isWmo = 0;
         if (!memcmp(&header, "REVM", 4))
         {
-            isWmo = 1;
-            result = ExtractSingleWmo(fileName);
+            model.IsWmo = 1;
+            model.Extracted = ExtractSingleWmo(model.FileName);
         }
         else if (!memcmp(&header, "MD20", 4) || !memcmp(&header, "MD21", 4))
-            result = ExtractSingleModel(fileName);
+            model.Extracted = ExtractSingleModel(model.FileName);
         else
-            ABORT_MSG("%s header: %d - %c%c%c%c", fileName.c_str(), header, (header >> 24) & 0xFF, (header >> 16) & 0xFF, (header >> 8) & 0xFF, header & 0xFF);
+            ABORT_MSG("%s header: %d - %c%c%c%c", model.FileName.c_str(), header, (header >> 24) & 0xFF, (header >> 16) & 0xFF, (header >> 8) & 0xFF, header & 0xFF);
+    });
 
-        if (result)
-        {
-            uint32 displayId = record.GetId();
-            uint32 path_length = fileName.length();
-            fwrite(&displayId, sizeof(uint32), 1, model_list);
-            fwrite(&isWmo, sizeof(uint8), 1, model_list);
-            fwrite(&path_length, sizeof(uint32), 1, model_list);
-            fwrite(fileName.c_str(), sizeof(char), path_length, model_list);
-        }
+    for (GameObjectModel const& model : models)
+    {
+        if (!model.Extracted)
+            continue;
+
+        uint32 path_length = model.FileName.length();
+        fwrite(&model.DisplayId, sizeof(uint32), 1, model_list);
+        fwrite(&model.IsWmo, sizeof(uint8), 1, model_list);
+        fwrite(&path_length, sizeof(uint32), 1, model_list);
+        fwrite(model.FileName.c_str(), sizeof(char), path_length, model_list);
     }
 
     fclose(model_list);
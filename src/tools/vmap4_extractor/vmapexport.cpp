@@ -28,10 +28,15 @@
 #include "wmo.h"
 #include <CascLib.h>
 #include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <list>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -62,8 +67,21 @@ std::unordered_set<uint32> maps_that_are_parents;
 boost::filesystem::path input_path;
 bool preciseVectorData = false;
 char const* CascProduct = "wow";
+unsigned int threads = std::thread::hardware_concurrency();
+std::mutex WmoDoodadsLock;
 std::unordered_map<std::string, WMODoodadData> WmoDoodads;
 
+// output files claimed by a worker thread, other threads requesting the same file wait for its result
+struct ModelExtractionState
+{
+    bool Done = false;
+    bool Result = false;
+};
+
+std::mutex ExtractedModelsLock;
+std::condition_variable ExtractedModelsCondition;
+std::unordered_map<std::string, ModelExtractionState> ExtractedModels;
+
 // Constants
 
 char const* szWorkDirWmo = "./Buildings";
@@ -138,48 +156,79 @@ uint32 GetInstalledLocalesMask()
     return 0;
 }
 
+std::mutex uniqueObjectIdsLock;
 std::map<std::pair<uint32, uint16>, uint32> uniqueObjectIds;
 
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId)
 {
+    std::lock_guard<std::mutex> lock(uniqueObjectIdsLock);
     return uniqueObjectIds.emplace(std::make_pair(clientId, clientDoodadId), uniqueObjectIds.size() + 1).first->second;
 }
 
-// Local testing functions
-bool FileExists(char const* file)
+WMODoodadData& GetWmoDoodads(std::string const& wmoName)
 {
-    if (FILE* n = fopen(file, "rb"))
-    {
-        fclose(n);
+    // references to unordered_map elements stay valid when other threads insert
+    std::lock_guard<std::mutex> lock(WmoDoodadsLock);
+    return WmoDoodads[wmoName];
+}
+
+bool ClaimModelExtraction(std::string const& localFile, bool& result)
+{
+    std::unique_lock<std::mutex> lock(ExtractedModelsLock);
+    auto itr = ExtractedModels.emplace(std::piecewise_construct, std::forward_as_tuple(localFile), std::forward_as_tuple());
+    if (itr.second)
         return true;
-    }
+
+    ModelExtractionState const& state = itr.first->second;
+    ExtractedModelsCondition.wait(lock, [&state] { return state.Done; });
+    result = state.Result;
     return false;
 }
 
-bool ExtractSingleWmo(std::string& fname)
+void FinishModelExtraction(std::string const& localFile, bool result)
 {
-    // Copy files from archive
-    std::string originalName = fname;
+    {
+        std::lock_guard<std::mutex> lock(ExtractedModelsLock);
+        ModelExtractionState& state = ExtractedModels[localFile];
+        state.Done = true;
+        state.Result = result;
+    }
 
-    char szLocalFile[1024];
-    char* plain_name = GetPlainName(&fname[0]);
-    NormalizeFileName(plain_name, strlen(plain_name));
-    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
+    ExtractedModelsCondition.notify_all();
+}
 
-    if (FileExists(szLocalFile))
-        return true;
+void ParallelFor(std::size_t count, std::function<void(std::size_t)> const& work)
+{
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]()
+    {
+        for (std::size_t i = next++; i < count; i = next++)
+            work(i);
+    };
 
-    int p = 0;
-    // Select root wmo files
-    char const* rchr = strrchr(plain_name, '_');
-    if (rchr != nullptr)
-        for (int i = 0; i < 4; ++i)
-            if (isdigit(rchr[i]))
-                p++;
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < std::min<std::size_t>(threads, count); ++i)
+        workers.emplace_back(worker);
 
-    if (p == 3)
+    worker();
+
+    for (std::thread& thread : workers)
+        thread.join();
+}
+
+// Local testing functions
+bool FileExists(char const* file)
+{
+    if (FILE* n = fopen(file, "rb"))
+    {
+        fclose(n);
         return true;
+    }
+    return false;
+}
 
+static bool ConvertSingleWmo(std::string const& originalName, char const* plain_name, char const* szLocalFile)
+{
     bool file_ok = true;
     WMORoot froot(originalName);
     if (!froot.open())
@@ -194,7 +243,7 @@ bool ExtractSingleWmo(std::string& fname)
         return false;
     }
     froot.ConvertToVMAPRootWmo(output);
-    WMODoodadData& doodads = WmoDoodads[plain_name];
+    WMODoodadData& doodads = GetWmoDoodads(plain_name);
     std::swap(doodads, froot.DoodadData);
     int Wmo_nVertices = 0;
     uint32 groupCount = 0;
@@ -240,41 +289,86 @@ bool ExtractSingleWmo(std::string& fname)
     return true;
 }
 
+bool ExtractSingleWmo(std::string& fname)
+{
+    // Copy files from archive
+    std::string originalName = fname;
+
+    char szLocalFile[1024];
+    char* plain_name = GetPlainName(&fname[0]);
+    NormalizeFileName(plain_name, strlen(plain_name));
+    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
+
+    int p = 0;
+    // Select root wmo files
+    char const* rchr = strrchr(plain_name, '_');
+    if (rchr != nullptr)
+        for (int i = 0; i < 4; ++i)
+            if (isdigit(rchr[i]))
+                p++;
+
+    if (p == 3)
+        return true;
+
+    // callers read the doodad sets right after this returns, so wait for another thread converting the same file
+    bool result = true;
+    if (!ClaimModelExtraction(szLocalFile, result))
+        return result;
+
+    if (!FileExists(szLocalFile))
+        result = ConvertSingleWmo(originalName, plain_name, szLocalFile);
+
+    FinishModelExtraction(szLocalFile, result);
+    return result;
+}
+
+std::string GetMapDirFileName(uint32 mapId)
+{
+    return Trinity::StringFormat("%s/dir_bin_%04u.tmp", szWorkDirWmo, mapId);
+}
+
 void ParsMapFiles()
 {
+    std::mutex wdtsLock;
     std::unordered_map<uint32, WDTFile> wdts;
-    auto getWDT = [&wdts](uint32 mapId) -> WDTFile*
+    auto getWDT = [&](uint32 mapId) -> WDTFile*
     {
+        std::lock_guard<std::mutex> lock(wdtsLock);
         auto itr = wdts.find(mapId);
-        if (itr == wdts.end())
+        return itr != wdts.end() ? &itr->second : nullptr;
+    };
+
+    // each map writes its spawns to its own file, they are merged into dir_bin in map_ids order once all maps are done
+    auto processMap = [&](MapEntry const& mapEntry)
+    {
+        std::unique_lock<std::mutex> lock(wdtsLock);
+        std::string description = Trinity::StringFormat("WDT for map %u - %s (FileDataID %u)", mapEntry.Id, mapEntry.Name.c_str(), mapEntry.WdtFileDataId);
+        auto itr = wdts.emplace(std::piecewise_construct, std::forward_as_tuple(mapEntry.Id), std::forward_as_tuple(mapEntry.WdtFileDataId, description, mapEntry.Directory, maps_that_are_parents.count(mapEntry.Id) > 0));
+        lock.unlock();
+        if (!itr.second)
+            return;
+
+        std::string dirname = GetMapDirFileName(mapEntry.Id);
+        FILE* dirfile = fopen(dirname.c_str(), "wb");
+        if (!dirfile)
         {
-            auto mapEntryItr = std::find_if(map_ids.begin(), map_ids.end(), [mapId](MapEntry const& mapEntry) { return mapEntry.Id == mapId; });
-            if (mapEntryItr == map_ids.end())
-                return nullptr;
-
-            uint32 fileDataId = mapEntryItr->WdtFileDataId;
-            if (!fileDataId)
-                return nullptr;
-
-            std::string description = Trinity::StringFormat("WDT for map %u - %s (FileDataID %u)", mapId, mapEntryItr->Name.c_str(), fileDataId);
-            std::string directory = mapEntryItr->Directory;
-            itr = wdts.emplace(std::piecewise_construct, std::forward_as_tuple(mapId), std::forward_as_tuple(fileDataId, description, std::move(directory), maps_that_are_parents.count(mapId) > 0)).first;
-            if (!itr->second.init(mapId))
-            {
-                wdts.erase(itr);
-                return nullptr;
-            }
+            printf("Can't open dirfile!'%s'\n", dirname.c_str());
+            return;
         }
 
-        return &itr->second;
-    };
+        WDTFile* WDT = &itr.first->second;
+        if (!WDT->init(mapEntry.Id, dirfile))
+        {
+            WDT = nullptr;
+            lock.lock();
+            wdts.erase(itr.first);
+            lock.unlock();
+        }
 
-    for (MapEntry const& mapEntry : map_ids)
-    {
-        if (WDTFile* WDT = getWDT(mapEntry.Id))
+        if (WDT)
         {
+            // parents are finished in an earlier wave, their cached ADTs are only read from here
             WDTFile* parentWDT = mapEntry.ParentMapID >= 0 ? getWDT(mapEntry.ParentMapID) : nullptr;
-            printf("Processing Map %u\n[", mapEntry.Id);
             for (int32 x = 0; x < 64; ++x)
             {
                 for (int32 y = 0; y < 64; ++y)
@@ -282,24 +376,77 @@ void ParsMapFiles()
                     bool success = false;
                     if (ADTFile* ADT = WDT->GetMap(x, y))
                     {
-                        success = ADT->init(mapEntry.Id, mapEntry.Id);
+                        success = ADT->init(mapEntry.Id, mapEntry.Id, dirfile);
                         WDT->FreeADT(ADT);
                     }
                     if (!success && parentWDT)
                     {
                         if (ADTFile* ADT = parentWDT->GetMap(x, y))
                         {
-                            ADT->init(mapEntry.Id, mapEntry.ParentMapID);
+                            ADT->init(mapEntry.Id, mapEntry.ParentMapID, dirfile);
                             parentWDT->FreeADT(ADT);
                         }
                     }
                 }
-                printf("#");
-                fflush(stdout);
             }
-            printf("]\n");
+            printf("Processed Map %u\n", mapEntry.Id);
         }
+
+        fclose(dirfile);
+    };
+
+    // maps reuse the ADTs cached by their parent map, so a map is only started after its parent has finished
+    std::unordered_set<uint32> pendingMapIds;
+    for (MapEntry const& mapEntry : map_ids)
+        pendingMapIds.insert(mapEntry.Id);
+
+    std::vector<MapEntry const*> pending;
+    for (MapEntry const& mapEntry : map_ids)
+        pending.push_back(&mapEntry);
+
+    printf("Using %u threads to extract maps\n", threads);
+    while (!pending.empty())
+    {
+        std::vector<MapEntry const*> wave;
+        for (MapEntry const* mapEntry : pending)
+            if (mapEntry->ParentMapID < 0 || mapEntry->ParentMapID == int16(mapEntry->Id) || !pendingMapIds.count(mapEntry->ParentMapID))
+                wave.push_back(mapEntry);
+
+        // circular parent references, break the cycle by processing one map on its own
+        if (wave.empty())
+            wave.push_back(pending.front());
+
+        ParallelFor(wave.size(), [&](std::size_t i) { processMap(*wave[i]); });
+
+        for (MapEntry const* mapEntry : wave)
+            pendingMapIds.erase(mapEntry->Id);
+
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&](MapEntry const* mapEntry) { return !pendingMapIds.count(mapEntry->Id); }), pending.end());
     }
+
+    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
+    FILE* dirfile = fopen(dirname.c_str(), "ab");
+    if (!dirfile)
+    {
+        printf("Can't open dirfile!'%s'\n", dirname.c_str());
+        return;
+    }
+
+    std::vector<char> buffer(1 << 16);
+    for (MapEntry const& mapEntry : map_ids)
+    {
+        std::string mapDirName = GetMapDirFileName(mapEntry.Id);
+        if (FILE* mapDirFile = fopen(mapDirName.c_str(), "rb"))
+        {
+            while (std::size_t read = fread(buffer.data(), 1, buffer.size(), mapDirFile))
+                fwrite(buffer.data(), 1, read, dirfile);
+
+            fclose(mapDirFile);
+            remove(mapDirName.c_str());
+        }
+    }
+
+    fclose(dirfile);
 }
 
 bool processArgv(int argc, char ** argv, const char *versionString)
@@ -340,6 +487,13 @@ bool processArgv(int argc, char ** argv, const char *versionString)
             else
                 result = false;
         }
+        else if (strcmp("--threads", argv[i]) == 0)
+        {
+            if (i + 1 < argc)
+                threads = static_cast<unsigned int>(std::max(0, atoi(argv[++i])));
+            else
+                result = false;
+        }
         else
         {
             result = false;
@@ -350,14 +504,16 @@ bool processArgv(int argc, char ** argv, const char *versionString)
     if (!result)
     {
         printf("Extract %s.\n",versionString);
-        printf("%s [-?][-s][-l][-d <path>][-p <product>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-p <product>][--threads <count>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
         printf("   -p <product>: which installed product to open (wow/wowt/wow_beta)\n");
+        printf("   --threads <count>: number of maps and models extracted at the same time (default: number of cores)\n");
         printf("   -? : This message.\n");
     }
 
+    threads = std::max(1u, threads);
     return result;
 }
 
@@ -19,8 +19,8 @@
 #define VMAPEXPORT_H
 
 #include "Define.h"
+#include <functional>
 #include <string>
-#include <unordered_map>
 
 enum ModelFlags
 {
@@ -32,12 +32,21 @@ enum ModelFlags
 struct WMODoodadData;
 
 extern const char * szWorkDirWmo;
-extern std::unordered_map<std::string, WMODoodadData> WmoDoodads;
+
+// doodad sets of an extracted wmo, thread safe
+WMODoodadData& GetWmoDoodads(std::string const& wmoName);
 
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId);
 
+// calls work(i) for every i in [0, count) on the configured number of worker threads and waits for all of them to finish
+void ParallelFor(std::size_t count, std::function<void(std::size_t)> const& work);
+
 bool FileExists(const char * file);
 
+// returns true if the calling thread should extract the file, otherwise waits until the thread extracting it is done and returns its result in result
+bool ClaimModelExtraction(std::string const& localFile, bool& result);
+void FinishModelExtraction(std::string const& localFile, bool result);
+
 bool ExtractSingleWmo(std::string& fname);
 bool ExtractSingleModel(std::string& fname);
 
@@ -41,7 +41,7 @@ WDTFile::WDTFile(uint32 fileDataId, std::string const& description, std::string
 
 WDTFile::~WDTFile() = default;
 
-bool WDTFile::init(uint32 mapId)
+bool WDTFile::init(uint32 mapId, FILE* dirfile)
 {
     if (_file.isEof())
         return false;
@@ -49,14 +49,6 @@ bool WDTFile::init(uint32 mapId)
     char fourcc[5];
     uint32 size;
 
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE* dirfile = fopen(dirname.c_str(), "ab");
-    if (!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     while (!_file.isEof())
     {
         _file.read(fourcc,4);
@@ -118,14 +110,14 @@ bool WDTFile::init(uint32 mapId)
                     if (!(mapObjDef.Flags & 0x8))
                     {
                         MapObject::Extract(mapObjDef, _wmoNames[mapObjDef.Id].c_str(), true, mapId, mapId, dirfile, nullptr);
-                        Doodad::ExtractSet(WmoDoodads[_wmoNames[mapObjDef.Id]], mapObjDef, true, mapId, mapId, dirfile, nullptr);
+                        Doodad::ExtractSet(GetWmoDoodads(_wmoNames[mapObjDef.Id]), mapObjDef, true, mapId, mapId, dirfile, nullptr);
                     }
                     else
                     {
                         std::string fileName = Trinity::StringFormat("FILE%08X.xxx", mapObjDef.Id);
                         ExtractSingleWmo(fileName);
                         MapObject::Extract(mapObjDef, fileName.c_str(), true, mapId, mapId, dirfile, nullptr);
-                        Doodad::ExtractSet(WmoDoodads[fileName], mapObjDef, true, mapId, mapId, dirfile, nullptr);
+                        Doodad::ExtractSet(GetWmoDoodads(fileName), mapObjDef, true, mapId, mapId, dirfile, nullptr);
                     }
                 }
             }
@@ -134,7 +126,6 @@ bool WDTFile::init(uint32 mapId)
     }
 
     _file.close();
-    fclose(dirfile);
     return true;
 }
 
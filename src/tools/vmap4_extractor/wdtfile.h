@@ -72,7 +72,7 @@ class WDTFile
 public:
     WDTFile(uint32 fileDataId, std::string const& description, std::string mapName, bool cache);
     ~WDTFile();
-    bool init(uint32 mapId);
+    bool init(uint32 mapId, FILE* dirfile);
 
     ADTFile* GetMap(int32 x, int32 y);
     void FreeADT(ADTFile* adt);
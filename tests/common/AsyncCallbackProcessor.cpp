@@ -0,0 +1,104 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tc_catch2.h"
+
+#include "AsyncCallbackProcessor.h"
+
+namespace
+{
+struct TestCallback
+{
+    TestCallback(bool* ready, int* invocations, std::shared_ptr<AsyncCompletionSignal> signal)
+        : Ready(ready), Invocations(invocations), Signal(std::move(signal)) { }
+
+    bool InvokeIfReady()
+    {
+        ++*Invocations;
+        return *Ready;
+    }
+
+    void SetCompletionListener(AsyncCompletionListener const& listener)
+    {
+        if (Signal)
+            Signal->Listen(listener);
+    }
+
+    bool HasCompletionSignal() const { return Signal != nullptr; }
+
+    bool* Ready;
+    int* Invocations;
+    std::shared_ptr<AsyncCompletionSignal> Signal;
+};
+}
+
+TEST_CASE("AsyncCallbackProcessor only looks at callbacks after a completion", "[AsyncCallbackProcessor]")
+{
+    bool ready = false;
+    int invocations = 0;
+    std::shared_ptr<AsyncCompletionSignal> signal = std::make_shared<AsyncCompletionSignal>();
+
+    AsyncCallbackProcessor<TestCallback> processor;
+    processor.AddCallback(TestCallback(&ready, &invocations, signal));
+
+    processor.ProcessReadyCallbacks();
+    processor.ProcessReadyCallbacks();
+    REQUIRE(invocations == 0);
+
+    ready = true;
+    signal->Notify();
+    processor.ProcessReadyCallbacks();
+    REQUIRE(invocations == 1);
+
+    processor.ProcessReadyCallbacks();
+    REQUIRE(invocations == 1);
+}
+
+TEST_CASE("AsyncCallbackProcessor picks up results that arrived before the callback was added", "[AsyncCallbackProcessor]")
+{
+    bool ready = true;
+    int invocations = 0;
+    std::shared_ptr<AsyncCompletionSignal> signal = std::make_shared<AsyncCompletionSignal>();
+    signal->Notify();
+
+    AsyncCallbackProcessor<TestCallback> processor;
+    processor.AddCallback(TestCallback(&ready, &invocations, signal));
+    processor.ProcessReadyCallbacks();
+    REQUIRE(invocations == 1);
+}
+
+TEST_CASE("AsyncCallbackProcessor keeps polling callbacks without a signal", "[AsyncCallbackProcessor]")
+{
+    bool ready = false;
+    int invocations = 0;
+
+    AsyncCallbackProcessor<TestCallback> processor;
+    processor.AddCallback(TestCallback(&ready, &invocations, nullptr));
+
+    // the first pass needs a wakeup, from then on the unsignalled callback keeps the processor awake
+    std::shared_ptr<AsyncCompletionSignal> signal = std::make_shared<AsyncCompletionSignal>();
+    bool otherReady = true;
+    int otherInvocations = 0;
+    signal->Notify();
+    processor.AddCallback(TestCallback(&otherReady, &otherInvocations, signal));
+
+    processor.ProcessReadyCallbacks();
+    processor.ProcessReadyCallbacks();
+    REQUIRE(invocations == 2);
+    REQUIRE(otherInvocations == 1);
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tc_catch2.h"
+
+#include "BoundingIntervalHierarchyWrapper.h"
+#include <set>
+#include <vector>
+
+namespace
+{
+    struct TestBox
+    {
+        G3D::AABox Bounds;
+    };
+
+    struct TestBoxBounds
+    {
+        static void getBounds(TestBox const& box, G3D::AABox& out) { out = box.Bounds; }
+        static void getBounds2(TestBox const* box, G3D::AABox& out) { out = box->Bounds; }
+    };
+
+    struct PointHits
+    {
+        // the hierarchy only returns candidates whose leaves contain the point
+        void operator()(G3D::Vector3 const& point, TestBox const& box)
+        {
+            if (box.Bounds.contains(point))
+                Hits.insert(&box);
+        }
+
+        std::set<TestBox const*> Hits;
+    };
+
+    std::set<TestBox const*> FindAt(BIHWrap<TestBox, TestBoxBounds>& tree, G3D::Vector3 const& point)
+    {
+        PointHits callback;
+        tree.intersectPoint(point, callback);
+        return callback.Hits;
+    }
+
+    G3D::AABox UnitBoxAt(float x, float y)
+    {
+        return G3D::AABox(G3D::Vector3(x, y, 0.0f), G3D::Vector3(x + 1.0f, y + 1.0f, 1.0f));
+    }
+}
+
+TEST_CASE("BIHWrap refits moved objects", "[BIH]")
+{
+    std::vector<TestBox> boxes(20);
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+        boxes[i].Bounds = UnitBoxAt(float(i) * 4.0f, 0.0f);
+
+    BIHWrap<TestBox, TestBoxBounds> tree;
+    for (TestBox const& box : boxes)
+        tree.insert(box);
+
+    REQUIRE(FindAt(tree, G3D::Vector3(40.5f, 0.5f, 0.5f)) == std::set<TestBox const*>({ &boxes[10] }));
+
+    SECTION("small moves keep every object reachable")
+    {
+        boxes[10].Bounds = UnitBoxAt(41.0f, 0.5f);
+        tree.update(boxes[10]);
+
+        REQUIRE(FindAt(tree, G3D::Vector3(41.75f, 1.25f, 0.5f)) == std::set<TestBox const*>({ &boxes[10] }));
+        REQUIRE(FindAt(tree, G3D::Vector3(40.25f, 0.25f, 0.5f)).empty());
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+            if (i != 10)
+                REQUIRE(FindAt(tree, G3D::Vector3(float(i) * 4.0f + 0.5f, 0.5f, 0.5f)) == std::set<TestBox const*>({ &boxes[i] }));
+    }
+
+    SECTION("objects moved across the tree are still found")
+    {
+        boxes[0].Bounds = UnitBoxAt(100.0f, 50.0f);
+        tree.update(boxes[0]);
+
+        REQUIRE(FindAt(tree, G3D::Vector3(100.5f, 50.5f, 0.5f)) == std::set<TestBox const*>({ &boxes[0] }));
+        REQUIRE(FindAt(tree, G3D::Vector3(0.5f, 0.5f, 0.5f)).empty());
+        REQUIRE(FindAt(tree, G3D::Vector3(76.5f, 0.5f, 0.5f)) == std::set<TestBox const*>({ &boxes[19] }));
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include <vector>
+
+namespace
+{
+    // reference encoding, one WriteBit call per bit
+    void WriteBitByBit(ByteBuffer& buffer, uint32 value, int32 bits)
+    {
+        for (int32 i = bits - 1; i >= 0; --i)
+            buffer.WriteBit((value >> i) & 1);
+    }
+
+    std::vector<uint8> Bytes(ByteBuffer const& buffer)
+    {
+        return buffer.empty() ? std::vector<uint8>() : std::vector<uint8>(buffer.contents(), buffer.contents() + buffer.size());
+    }
+}
+
+TEST_CASE("ByteBuffer bit packing", "[ByteBuffer]")
+{
+    std::vector<uint32> const values = { 0xDEADBEEF, 0x1, 0x7F, 0xFFFFFFFF, 0x12345678, 0x0, 0x5A };
+
+    SECTION("WriteBits matches writing bit by bit")
+    {
+        for (int32 bits : { 1, 3, 7, 8, 13, 32 })
+        {
+            ByteBuffer packed, reference;
+            packed.WriteBit(true);
+            reference.WriteBit(true);
+            for (uint32 value : values)
+            {
+                packed.WriteBits(value, bits);
+                WriteBitByBit(reference, value, bits);
+            }
+
+            packed.FlushBits();
+            reference.FlushBits();
+            REQUIRE(Bytes(packed) == Bytes(reference));
+        }
+    }
+
+    SECTION("Bulk WriteBits matches single WriteBits")
+    {
+        for (int32 bits : { 1, 5, 8, 17, 32 })
+        {
+            for (int32 leadingBits = 0; leadingBits < 8; ++leadingBits)
+            {
+                ByteBuffer bulk, single;
+                bulk.WriteBits(0x55, leadingBits);
+                single.WriteBits(0x55, leadingBits);
+
+                bulk.WriteBits(values.data(), values.size(), bits);
+                for (uint32 value : values)
+                    single.WriteBits(value, bits);
+
+                REQUIRE(bulk.HasUnfinishedBitPack() == single.HasUnfinishedBitPack());
+                bulk.FlushBits();
+                single.FlushBits();
+                REQUIRE(Bytes(bulk) == Bytes(single));
+            }
+        }
+    }
+
+    SECTION("ReadBits returns what WriteBits wrote")
+    {
+        ByteBuffer buffer;
+        buffer.WriteBit(false);
+        for (uint32 value : values)
+            buffer.WriteBits(value, 32);
+        buffer.WriteBits(values.data(), values.size(), 11);
+        buffer.FlushBits();
+        buffer << uint32(42);
+
+        REQUIRE_FALSE(buffer.ReadBit());
+        for (uint32 value : values)
+            REQUIRE(buffer.ReadBits(32) == value);
+        for (uint32 value : values)
+            REQUIRE(buffer.ReadBits(11) == (value & 0x7FF));
+        REQUIRE(buffer.read<uint32>() == 42);
+    }
+}
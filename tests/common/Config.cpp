@@ -0,0 +1,79 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Config.h"
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+
+namespace
+{
+    std::string WriteConfig(std::string const& contents)
+    {
+        boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("tc_config_%%%%%%%%.conf");
+        std::ofstream file(path.string());
+        file << "[test]\n" << contents;
+        return path.string();
+    }
+}
+
+TEST_CASE("ConfigValue", "[Config]")
+{
+    std::string fileName = WriteConfig("Test.Bool = 1\nTest.Int = 42\nTest.Float = 1.5\nTest.String = \"abc\"\n");
+
+    std::string error;
+    REQUIRE(sConfigMgr->LoadInitial(fileName, {}, error));
+
+    SECTION("Values are parsed on registration when the config is already loaded")
+    {
+        Trinity::ConfigValue<bool> boolValue("Test.Bool", false);
+        Trinity::ConfigValue<int32> intValue("Test.Int", 0);
+        Trinity::ConfigValue<float> floatValue("Test.Float", 0.0f);
+        Trinity::ConfigValue<std::string> stringValue("Test.String", "");
+        Trinity::ConfigValue<int32> missingValue("Test.Missing", 7);
+
+        REQUIRE(boolValue);
+        REQUIRE(intValue == 42);
+        REQUIRE(floatValue == 1.5f);
+        REQUIRE(stringValue.Get() == "abc");
+        REQUIRE(missingValue == 7);
+    }
+
+    SECTION("Reload refreshes values before notifying listeners")
+    {
+        Trinity::ConfigValue<int32> intValue("Test.Int", 0);
+
+        int32 seenByListener = 0;
+        sConfigMgr->AddReloadListener("test", [&]() { seenByListener = intValue; });
+
+        std::ofstream(fileName) << "[test]\nTest.Int = 10\n";
+
+        std::vector<std::string> errors;
+        REQUIRE(sConfigMgr->Reload(errors));
+        REQUIRE(intValue == 10);
+        REQUIRE(seenByListener == 10);
+
+        sConfigMgr->RemoveReloadListener("test");
+        std::ofstream(fileName) << "[test]\nTest.Int = 20\n";
+        REQUIRE(sConfigMgr->Reload(errors));
+        REQUIRE(intValue == 20);
+        REQUIRE(seenByListener == 10);
+    }
+
+    boost::filesystem::remove(fileName);
+}
@@ -376,6 +376,22 @@ TEST_CASE("Delay grouped events", "[EventMap]")
     REQUIRE(eventMap.GetTimeUntilEvent(EVENT_3) == 4s);
 }
 
+TEST_CASE("Events with equal time execute in scheduling order", "[EventMap]")
+{
+    EventMap eventMap;
+    eventMap.ScheduleEvent(EVENT_2, 1s);
+    eventMap.ScheduleEvent(EVENT_1, 1s);
+    eventMap.ScheduleEvent(EVENT_3, 500ms);
+
+    eventMap.Update(1000);
+
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_3);
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_2);
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_1);
+    REQUIRE(eventMap.ExecuteEvent() == 0);
+    REQUIRE(eventMap.Empty());
+}
+
 TEST_CASE("Reset map", "[EventMap]")
 {
     EventMap eventMap;
@@ -0,0 +1,119 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tc_catch2.h"
+
+#include "EventProcessor.h"
+#include <vector>
+
+namespace
+{
+    class RecordingEvent : public BasicEvent
+    {
+    public:
+        RecordingEvent(std::vector<int>& log, int id, bool deletable = true) : _log(log), _id(id), _deletable(deletable) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            _log.push_back(_id);
+            return true;
+        }
+
+        void Abort(uint64 /*e_time*/) override { _log.push_back(-_id); }
+
+        bool IsDeletable() const override { return _deletable; }
+
+    private:
+        std::vector<int>& _log;
+        int _id;
+        bool _deletable;
+    };
+}
+
+TEST_CASE("Events execute in time order", "[EventProcessor]")
+{
+    std::vector<int> log;
+    EventProcessor events;
+
+    events.AddEventAtOffset(new RecordingEvent(log, 3), 300ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 1), 100ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 2), 200ms);
+
+    events.Update(150);
+    REQUIRE(log == std::vector<int>{ 1 });
+
+    events.Update(150);
+    REQUIRE(log == std::vector<int>{ 1, 2, 3 });
+    REQUIRE(events.GetEvents().empty());
+}
+
+TEST_CASE("Events with equal time execute in the order they were added", "[EventProcessor]")
+{
+    std::vector<int> log;
+    EventProcessor events;
+
+    for (int i = 1; i <= 10; ++i)
+        events.AddEventAtOffset(new RecordingEvent(log, i), 50ms);
+
+    events.Update(50);
+    REQUIRE(log == std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+}
+
+TEST_CASE("ModifyEventTime reschedules an event", "[EventProcessor]")
+{
+    std::vector<int> log;
+    EventProcessor events;
+
+    RecordingEvent* late = new RecordingEvent(log, 1);
+    events.AddEventAtOffset(late, 500ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 2), 200ms);
+
+    events.ModifyEventTime(late, events.CalculateTime(100ms));
+
+    events.Update(100);
+    REQUIRE(log == std::vector<int>{ 1 });
+
+    events.Update(100);
+    REQUIRE(log == std::vector<int>{ 1, 2 });
+}
+
+TEST_CASE("KillAllEvents aborts events", "[EventProcessor]")
+{
+    std::vector<int> log;
+    EventProcessor events;
+
+    events.AddEventAtOffset(new RecordingEvent(log, 1), 100ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 2, false), 100ms);
+
+    SECTION("Non deletable events are kept when not forced")
+    {
+        events.KillAllEvents(false);
+        REQUIRE(log == std::vector<int>{ -1, -2 });
+        REQUIRE(events.GetEvents().size() == 1);
+
+        events.KillAllEvents(true);
+        REQUIRE(events.GetEvents().empty());
+    }
+
+    SECTION("Forced kill removes everything")
+    {
+        events.KillAllEvents(true);
+        REQUIRE(log == std::vector<int>{ -1, -2 });
+        REQUIRE(events.GetEvents().empty());
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "HeapProfiler.h"
+
+TEST_CASE("HeapProfiler sampling", "[HeapProfiler]")
+{
+    // the test binary does not replace operator new, allocations are reported by hand
+    Trinity::HeapProfiler::SetSamplingHooksInstalled();
+    if (Trinity::HeapProfiler::GetAvailableBackend() != Trinity::HeapProfiler::Backend::Sampling)
+        return;
+
+    std::string error;
+    REQUIRE(Trinity::HeapProfiler::Start(4096, "", error));
+    REQUIRE_FALSE(Trinity::HeapProfiler::Start(4096, "", error));
+
+    alignas(16) static uint8 block[16];
+    uint32 const size = 1024 * 1024;
+
+    SECTION("Large allocations are sampled and attributed to the current scope")
+    {
+        {
+            Trinity::HeapProfiler::Scope scope("test");
+            Trinity::HeapProfiler::OnAllocation(block, size);
+        }
+
+        std::vector<Trinity::HeapProfiler::TagStats> stats = Trinity::HeapProfiler::GetSampledStats();
+        REQUIRE(stats.size() == 1);
+        REQUIRE(std::string(stats[0].Tag) == "test");
+        REQUIRE(stats[0].Bytes == size);
+        REQUIRE(stats[0].Allocations == 1);
+
+        Trinity::HeapProfiler::OnRelease(block);
+        REQUIRE(Trinity::HeapProfiler::GetSampledStats().empty());
+    }
+
+    SECTION("Samples are dropped when profiling stops")
+    {
+        Trinity::HeapProfiler::OnAllocation(block, size);
+        REQUIRE(Trinity::HeapProfiler::GetSampledStats().size() == 1);
+
+        Trinity::HeapProfiler::Stop();
+        REQUIRE(Trinity::HeapProfiler::GetSampledStats().empty());
+
+        Trinity::HeapProfiler::OnAllocation(block, size);
+        REQUIRE(Trinity::HeapProfiler::GetSampledStats().empty());
+    }
+
+    Trinity::HeapProfiler::Stop();
+    REQUIRE(Trinity::HeapProfiler::GetRunningBackend() == Trinity::HeapProfiler::Backend::None);
+}
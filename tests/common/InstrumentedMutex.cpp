@@ -0,0 +1,78 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "InstrumentedMutex.h"
+#include <algorithm>
+
+namespace
+{
+    Trinity::LockProfiler::Stats FindStats(char const* name)
+    {
+        std::vector<Trinity::LockProfiler::Stats> stats = Trinity::LockProfiler::GetStats();
+        auto itr = std::find_if(stats.begin(), stats.end(), [name](Trinity::LockProfiler::Stats const& entry) { return entry.Name == name; });
+        REQUIRE(itr != stats.end());
+        return *itr;
+    }
+}
+
+TEST_CASE("InstrumentedMutex", "[InstrumentedMutex]")
+{
+    Trinity::InstrumentedMutex mutex("InstrumentedMutexTest");
+    Trinity::InstrumentedSharedMutex sharedMutex("InstrumentedSharedMutexTest");
+
+    SECTION("Works with the standard lock types")
+    {
+        {
+            std::lock_guard<Trinity::InstrumentedMutex> lock(mutex);
+            REQUIRE_FALSE(mutex.try_lock());
+        }
+
+        {
+            std::shared_lock<Trinity::InstrumentedSharedMutex> lock(sharedMutex);
+            REQUIRE(sharedMutex.try_lock_shared());
+            sharedMutex.unlock_shared();
+            REQUIRE_FALSE(sharedMutex.try_lock());
+        }
+
+        std::unique_lock<Trinity::InstrumentedSharedMutex> lock(sharedMutex);
+        REQUIRE(lock.owns_lock());
+    }
+
+    SECTION("Acquisitions and failed try_lock calls are counted")
+    {
+        if (!Trinity::LockProfiler::IsEnabled())
+        {
+            REQUIRE(Trinity::LockProfiler::GetStats().empty());
+            return;
+        }
+
+        Trinity::LockProfiler::Reset();
+        mutex.lock();
+        REQUIRE_FALSE(mutex.try_lock());
+        mutex.unlock();
+
+        Trinity::LockProfiler::Stats stats = FindStats("InstrumentedMutexTest");
+        REQUIRE(stats.Acquisitions == 1);
+        REQUIRE(stats.Contentions == 1);
+        REQUIRE(stats.WaitTime == 0);
+
+        Trinity::LockProfiler::Reset();
+        REQUIRE(FindStats("InstrumentedMutexTest").Acquisitions == 0);
+    }
+}
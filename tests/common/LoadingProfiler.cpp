@@ -0,0 +1,58 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "LoadingProfiler.h"
+
+using Trinity::LoadingProfiler;
+
+TEST_CASE("LoadingProfiler", "[LoadingProfiler]")
+{
+    SECTION("Steps are recorded until the phase ends")
+    {
+        REQUIRE(LoadingProfiler::Begin("test"));
+        LoadingProfiler::Step("first");
+        LoadingProfiler::Step("second");
+
+        std::vector<LoadingProfiler::StepInfo> steps = LoadingProfiler::End(false);
+        REQUIRE(steps.size() == 2);
+        REQUIRE(steps[0].Duration >= steps[1].Duration);
+    }
+
+    SECTION("Steps outside of a phase are ignored")
+    {
+        LoadingProfiler::Step("ignored");
+        REQUIRE(LoadingProfiler::End(false).empty());
+    }
+
+    SECTION("Nested phases are merged into the outer one")
+    {
+        REQUIRE(LoadingProfiler::Begin("outer"));
+        REQUIRE_FALSE(LoadingProfiler::Begin("inner"));
+        LoadingProfiler::Step("step");
+
+        REQUIRE(LoadingProfiler::End(false).size() == 1);
+    }
+
+    SECTION("Step names are escaped in the json report")
+    {
+        std::vector<LoadingProfiler::StepInfo> steps = { { "Loading \"quoted\" table...", Milliseconds(5), 64 } };
+        REQUIRE(LoadingProfiler::ToJson("test", Milliseconds(10), steps) ==
+            "{\"phase\":\"test\",\"total_ms\":10,\"steps\":[{\"name\":\"Loading \\\"quoted\\\" table...\",\"ms\":5,\"accounted_bytes\":64}]}\n");
+    }
+}
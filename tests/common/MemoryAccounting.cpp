@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MemoryAccounting.h"
+#include <map>
+#include <string>
+
+using Trinity::MemoryAccounting;
+using Trinity::MemoryCategory;
+
+TEST_CASE("MemoryAccounting", "[MemoryAccounting]")
+{
+    SECTION("Allocations are counted until released")
+    {
+        int64 before = MemoryAccounting::GetBytes(MemoryCategory::Terrain);
+
+        MemoryAccounting::Allocated(MemoryCategory::Terrain, 1024);
+        MemoryAccounting::Allocated(MemoryCategory::Terrain, 512);
+        REQUIRE(MemoryAccounting::GetBytes(MemoryCategory::Terrain) == before + 1536);
+
+        MemoryAccounting::Released(MemoryCategory::Terrain, 1024);
+        REQUIRE(MemoryAccounting::GetBytes(MemoryCategory::Terrain) == before + 512);
+
+        MemoryAccounting::Released(MemoryCategory::Terrain, 512);
+        REQUIRE(MemoryAccounting::GetBytes(MemoryCategory::Terrain) == before);
+    }
+
+    SECTION("Categories are independent")
+    {
+        int64 before = MemoryAccounting::GetBytes(MemoryCategory::VMaps);
+
+        MemoryAccounting::Set(MemoryCategory::AuctionHouse, 4096);
+        REQUIRE(MemoryAccounting::GetBytes(MemoryCategory::AuctionHouse) == 4096);
+        REQUIRE(MemoryAccounting::GetBytes(MemoryCategory::VMaps) == before);
+    }
+
+    SECTION("Node container estimates grow with the number of entries")
+    {
+        std::map<uint32, std::string> container;
+        REQUIRE(MemoryAccounting::EstimateNodeContainer(container) == 0);
+
+        container[1] = "a";
+        container[2] = "b";
+        REQUIRE(MemoryAccounting::EstimateNodeContainer(container) >= 2 * sizeof(std::pair<uint32 const, std::string>));
+    }
+
+    SECTION("Every category has a name")
+    {
+        for (uint8 i = 0; i < uint8(MemoryCategory::Max); ++i)
+            REQUIRE(std::string(MemoryAccounting::GetName(MemoryCategory(i))) != "unknown");
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Containers.h"
+#include "IteratorPair.h"
+#include "SortedIndex.h"
+#include <string>
+
+TEST_CASE("SortedIndex", "[SortedIndex]")
+{
+    Trinity::SortedIndex<uint32, std::string> index;
+
+    SECTION("Empty index finds nothing")
+    {
+        index.Build();
+        REQUIRE(index.empty());
+        REQUIRE(index.find(1) == index.end());
+    }
+
+    SECTION("Lookups find the value of their key")
+    {
+        index.emplace(30, "c");
+        index.emplace(10, "a");
+        index.emplace(20, "b");
+        index.Build();
+
+        REQUIRE(index.size() == 3);
+        REQUIRE(index.find(10)->second == "a");
+        REQUIRE(index.find(20)->second == "b");
+        REQUIRE(index.find(30)->second == "c");
+        REQUIRE(index.find(15) == index.end());
+        REQUIRE(index.find(40) == index.end());
+        REQUIRE(*Trinity::Containers::MapGetValuePtr(index, 20) == "b");
+        REQUIRE(Trinity::Containers::MapGetValuePtr(index, 25) == nullptr);
+    }
+
+    SECTION("The value inserted last wins for duplicate keys")
+    {
+        index.emplace(1, "first");
+        index.emplace(2, "other");
+        index.emplace(1, "second");
+        index.emplace(1, "third");
+        index.Build();
+
+        REQUIRE(index.size() == 2);
+        REQUIRE(index.find(1)->second == "third");
+        REQUIRE(index.find(2)->second == "other");
+    }
+}
+
+TEST_CASE("SortedMultiIndex", "[SortedIndex]")
+{
+    Trinity::SortedMultiIndex<uint32, uint32> index;
+    index.insert({ 5, 1 });
+    index.insert({ 3, 2 });
+    index.insert({ 5, 3 });
+    index.insert({ 7, 4 });
+    index.insert({ 5, 5 });
+    index.Build();
+
+    SECTION("Values of a key are returned in insertion order")
+    {
+        std::vector<uint32> values;
+        for (std::pair<uint32, uint32> const& entry : Trinity::Containers::MapEqualRange(index, 5))
+            values.push_back(entry.second);
+
+        REQUIRE(values == std::vector<uint32>{ 1, 3, 5 });
+        REQUIRE(index.count(5) == 3);
+    }
+
+    SECTION("Missing keys have empty ranges")
+    {
+        auto range = index.equal_range(4);
+        REQUIRE(range.first == range.second);
+        REQUIRE(index.count(8) == 0);
+        REQUIRE(index.count(7) == 1);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "StringFormat.h"
+#include <cstring>
+
+TEST_CASE("StringFormatTo", "[StringFormat]")
+{
+    Trinity::FormatBuffer buffer;
+
+    SECTION("Matches StringFormat")
+    {
+        std::string name = "Thrall";
+        REQUIRE(std::string(Trinity::StringFormatTo(buffer, "DELETE FROM characters WHERE guid = %u AND name = '%s'", 42u, name))
+            == Trinity::StringFormat("DELETE FROM characters WHERE guid = %u AND name = '%s'", 42u, name));
+    }
+
+    SECTION("Reusing the buffer replaces the previous result")
+    {
+        Trinity::StringFormatTo(buffer, "%s", std::string(100, 'a'));
+        REQUIRE(std::strcmp(Trinity::StringFormatTo(buffer, "%d", 7), "7") == 0);
+    }
+
+    SECTION("Results longer than the inline storage are complete")
+    {
+        std::string longText(2000, 'x');
+        REQUIRE(std::string(Trinity::StringFormatTo(buffer, "%s.", longText)) == longText + '.');
+    }
+
+    SECTION("Format errors are reported in the result")
+    {
+        REQUIRE(std::string(Trinity::StringFormatTo(buffer, "%d %d", 1)).find("An error occurred formatting string") == 0);
+    }
+}
+
+TEST_CASE("FormatTo", "[StringFormat]")
+{
+    Trinity::FormatBuffer buffer;
+    REQUIRE(std::strcmp(Trinity::FormatTo(buffer, FMT_STRING("{} of {}"), 3, "five"), "3 of five") == 0);
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TaskGraph.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+TEST_CASE("TaskGraph runs tasks in insertion order on one thread", "[TaskGraph]")
+{
+    std::vector<int> order;
+    Trinity::TaskGraph graph;
+    graph.AddTask("first", [&] { order.push_back(1); });
+    graph.AddTask("second", [&] { order.push_back(2); });
+    graph.AddTask("third", [&] { order.push_back(3); });
+    graph.Run(1);
+
+    REQUIRE(order == std::vector<int>({ 1, 2, 3 }));
+}
+
+TEST_CASE("TaskGraph respects dependencies", "[TaskGraph]")
+{
+    std::mutex lock;
+    std::vector<int> order;
+    auto record = [&](int value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        order.push_back(value);
+    };
+
+    Trinity::TaskGraph graph;
+    Trinity::TaskGraph::TaskId a = graph.AddTask("a", [&] { record(1); });
+    Trinity::TaskGraph::TaskId b = graph.AddTask("b", [&] { record(2); });
+    Trinity::TaskGraph::TaskId c = graph.AddTask("c", [&] { record(3); }, { a, b });
+    graph.AddTask("d", [&] { record(4); }, { c });
+    graph.Run(4);
+
+    REQUIRE(order.size() == 4);
+    REQUIRE(order[2] == 3);
+    REQUIRE(order[3] == 4);
+}
+
+TEST_CASE("TaskGraph runs every task exactly once", "[TaskGraph]")
+{
+    std::atomic<uint32> counter(0);
+    Trinity::TaskGraph graph;
+    for (uint32 i = 0; i < 100; ++i)
+        graph.AddTask("task", [&] { ++counter; });
+    graph.Run(8);
+
+    REQUIRE(counter == 100);
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TimingWheel.h"
+
+TEST_CASE("TimingWheel", "[TimingWheel]")
+{
+    Trinity::TimingWheel<uint32> wheel;
+    std::vector<uint32> due;
+    TimePoint now = TimePoint() + Hours(1);
+
+    SECTION("Empty wheel has nothing due")
+    {
+        REQUIRE(wheel.empty());
+        REQUIRE_FALSE(wheel.PopDue(now, due));
+        REQUIRE(due.empty());
+    }
+
+    SECTION("Elements are returned once due, ordered by due time then scheduling order")
+    {
+        wheel.Schedule(1, now, Seconds(2));
+        wheel.Schedule(2, now, Seconds(0));
+        wheel.Schedule(3, now, Seconds(1));
+        wheel.Schedule(4, now, Seconds(0));
+        REQUIRE(wheel.size() == 4);
+
+        REQUIRE(wheel.PopDue(now, due));
+        REQUIRE(due == std::vector<uint32>{ 2, 4 });
+
+        REQUIRE_FALSE(wheel.PopDue(now + Milliseconds(999), due));
+
+        REQUIRE(wheel.PopDue(now + Seconds(5), due));
+        REQUIRE(due == std::vector<uint32>{ 3, 1 });
+        REQUIRE(wheel.empty());
+    }
+
+    SECTION("Elements further than one revolution away are kept until due")
+    {
+        wheel.Schedule(1, now, Minutes(10));
+        wheel.Schedule(2, now, Seconds(30));
+
+        TimePoint time = now;
+        std::vector<uint32> popped;
+        while (time < now + Minutes(11))
+        {
+            time += Milliseconds(50);
+            if (wheel.PopDue(time, due))
+            {
+                for (uint32 value : due)
+                {
+                    popped.push_back(value);
+                    REQUIRE(time >= now + (value == 1 ? Minutes(10) : Seconds(30)));
+                    REQUIRE(time < now + (value == 1 ? Minutes(10) : Seconds(30)) + Milliseconds(50));
+                }
+            }
+        }
+
+        REQUIRE(popped == std::vector<uint32>{ 2, 1 });
+    }
+
+    SECTION("Elements scheduled while processing are due in the same update")
+    {
+        wheel.Schedule(1, now, Seconds(0));
+        REQUIRE(wheel.PopDue(now, due));
+        wheel.Schedule(2, now, Seconds(0));
+        wheel.Schedule(3, now, Seconds(1));
+        REQUIRE(wheel.PopDue(now, due));
+        REQUIRE(due == std::vector<uint32>{ 2 });
+        REQUIRE(wheel.size() == 1);
+    }
+
+    SECTION("A late update returns everything that became due meanwhile")
+    {
+        for (uint32 i = 0; i < 100; ++i)
+            wheel.Schedule(i, now, Milliseconds(100 * (99 - i)));
+
+        REQUIRE(wheel.PopDue(now + Hours(1), due));
+        REQUIRE(due.size() == 100);
+        REQUIRE(std::is_sorted(due.rbegin(), due.rend()));
+        REQUIRE(wheel.empty());
+    }
+}
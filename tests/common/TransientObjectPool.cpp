@@ -0,0 +1,101 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TransientObjectPool.h"
+#include <array>
+
+namespace
+{
+    struct PooledBase
+    {
+        virtual ~PooledBase() = default;
+
+        TRINITY_TRANSIENT_OBJECT_POOL_ALLOCATED
+
+        uint32 Value = 0;
+    };
+
+    struct PooledDerived : PooledBase
+    {
+        std::array<uint8, 200> Payload = { };
+    };
+
+    struct PooledLarge : PooledBase
+    {
+        std::array<uint8, 20 * 1024> Payload = { };
+    };
+}
+
+TEST_CASE("TransientObjectPool", "[TransientObjectPool]")
+{
+    SECTION("Released blocks are reused for the same size class")
+    {
+        PooledBase* first = new PooledBase();
+        void* block = first;
+        delete first;
+
+        PooledBase* second = new PooledBase();
+        REQUIRE(static_cast<void*>(second) == block);
+        delete second;
+    }
+
+    SECTION("Derived objects are returned to their own size class")
+    {
+        PooledBase* derived = new PooledDerived();
+        void* block = derived;
+        delete derived;
+
+        PooledBase* base = new PooledBase();
+        REQUIRE(static_cast<void*>(base) != block);
+
+        PooledBase* derivedAgain = new PooledDerived();
+        REQUIRE(static_cast<void*>(derivedAgain) == block);
+
+        delete base;
+        delete derivedAgain;
+    }
+
+    SECTION("Objects the size of a creature are pooled")
+    {
+        PooledBase* large = new PooledLarge();
+        void* block = large;
+        delete large;
+
+        PooledBase* largeAgain = new PooledLarge();
+        REQUIRE(static_cast<void*>(largeAgain) == block);
+        delete largeAgain;
+    }
+
+    SECTION("Trim keeps at most RetainedPerClass blocks")
+    {
+        std::vector<PooledBase*> objects;
+        for (std::size_t i = 0; i < Trinity::TransientObjectPool::RetainedPerClass + 16; ++i)
+            objects.push_back(new PooledBase());
+
+        for (PooledBase* object : objects)
+            delete object;
+
+        Trinity::TransientObjectPool::Instance().Trim();
+
+        // reused blocks come back in reverse order of release, the oldest ones were trimmed
+        PooledBase* reused = new PooledBase();
+        REQUIRE(static_cast<void*>(reused) == static_cast<void*>(objects[Trinity::TransientObjectPool::RetainedPerClass - 1]));
+        delete reused;
+    }
+}
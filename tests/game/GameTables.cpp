@@ -0,0 +1,58 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GameTables.h"
+
+TEST_CASE("GameTable class columns", "[GameTables]")
+{
+    SECTION("Class columns map to the matching field")
+    {
+        GtBaseMPEntry row;
+        row.Warrior = 1.0f;
+        row.Paladin = 2.0f;
+        row.Mage = 8.0f;
+        row.DemonHunter = 12.0f;
+
+        REQUIRE(GetGameTableColumnForClass(&row, CLASS_NONE) == 0.0f);
+        REQUIRE(GetGameTableColumnForClass(&row, CLASS_WARRIOR) == 1.0f);
+        REQUIRE(GetGameTableColumnForClass(&row, CLASS_PALADIN) == 2.0f);
+        REQUIRE(GetGameTableColumnForClass(&row, CLASS_MAGE) == 8.0f);
+        REQUIRE(GetGameTableColumnForClass(&row, CLASS_DEMON_HUNTER) == 12.0f);
+        REQUIRE(GetGameTableColumnForClass(&row, MAX_CLASSES) == 0.0f);
+        REQUIRE(GetGameTableColumnForClass(&row, -1) == 0.0f);
+    }
+
+    SECTION("Spell scaling accepts the negative item columns")
+    {
+        GtSpellScalingEntry row;
+        row.Druid = 11.0f;
+        row.Item = 100.0f;
+        row.Consumable = 200.0f;
+        row.DamageSecondary = 900.0f;
+
+        REQUIRE(GetSpellScalingColumnForClass(&row, CLASS_DRUID) == 11.0f);
+        REQUIRE(GetSpellScalingColumnForClass(&row, -1) == 100.0f);
+        REQUIRE(GetSpellScalingColumnForClass(&row, -7) == 100.0f);
+        REQUIRE(GetSpellScalingColumnForClass(&row, -2) == 200.0f);
+        REQUIRE(GetSpellScalingColumnForClass(&row, -9) == 900.0f);
+        REQUIRE(GetSpellScalingColumnForClass(&row, -10) == 0.0f);
+        REQUIRE(GetSpellScalingColumnForClass(&row, CLASS_NONE) == 0.0f);
+        REQUIRE(GetSpellScalingColumnForClass(&row, MAX_CLASSES) == 0.0f);
+    }
+}
@@ -0,0 +1,182 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_DENSE_GRID_STORAGE
+#define TRINITY_DENSE_GRID_STORAGE
+#endif
+
+#include "tc_catch2.h"
+
+#include "GridObjectContainer.h"
+#include <memory>
+#include <set>
+
+namespace
+{
+    struct TestObject
+    {
+        explicit TestObject(uint32 id, float x = 0.0f, float y = 0.0f) : Id(id), X(x), Y(y) { }
+
+        void AddToGrid(DenseGridRefManager<TestObject>& container) { Reference.link(&container, this); }
+        void RemoveFromGrid() { Reference.unlink(); }
+
+        float GetPositionX() const { return X; }
+        float GetPositionY() const { return Y; }
+        float GetCombatReach() const { return 0.0f; }
+
+        uint32 Id;
+        float X;
+        float Y;
+        DenseGridReference<TestObject> Reference;
+    };
+
+    std::set<uint32> Collect(DenseGridRefManager<TestObject>& container)
+    {
+        std::set<uint32> ids;
+        for (DenseGridRefManager<TestObject>::iterator itr = container.begin(); itr != container.end(); ++itr)
+            ids.insert(itr->GetSource()->Id);
+
+        return ids;
+    }
+
+    std::set<uint32> Collect(DenseGridRefManager<TestObject>& container, GridSearchArea const& area)
+    {
+        GridSearchAreaScope scope(&area);
+
+        std::set<uint32> ids;
+        for (DenseGridRefManager<TestObject>::iterator itr = Trinity::SearchBegin(container); itr != container.end(); ++itr)
+            ids.insert(itr->GetSource()->Id);
+
+        return ids;
+    }
+}
+
+TEST_CASE("DenseGridRefManager", "[Grids]")
+{
+    DenseGridRefManager<TestObject> container;
+    TestObject first(1), second(2), third(3);
+
+    first.AddToGrid(container);
+    second.AddToGrid(container);
+    third.AddToGrid(container);
+
+    REQUIRE(container.getSize() == 3);
+    REQUIRE(Collect(container) == std::set<uint32>{ 1, 2, 3 });
+
+    SECTION("Removing an object keeps the remaining ones reachable")
+    {
+        first.RemoveFromGrid();
+        REQUIRE_FALSE(first.Reference.isValid());
+        REQUIRE(container.getSize() == 2);
+        REQUIRE(Collect(container) == std::set<uint32>{ 2, 3 });
+
+        // the object moved into the freed slot must still be removable
+        third.RemoveFromGrid();
+        REQUIRE(Collect(container) == std::set<uint32>{ 2 });
+    }
+
+    SECTION("Objects unlink themselves when destroyed")
+    {
+        {
+            TestObject temporary(4);
+            temporary.AddToGrid(container);
+            REQUIRE(container.getSize() == 4);
+        }
+
+        REQUIRE(Collect(container) == std::set<uint32>{ 1, 2, 3 });
+    }
+
+    SECTION("Iteration ends when the current object removes itself")
+    {
+        uint32 visited = 0;
+        for (DenseGridRefManager<TestObject>::iterator itr = container.begin(); itr != container.end(); ++itr)
+        {
+            ++visited;
+            if (itr->GetSource() == &third)
+                third.RemoveFromGrid();
+        }
+
+        REQUIRE(visited <= 3);
+        REQUIRE(container.getSize() == 2);
+    }
+
+    SECTION("References are invalidated when the container is destroyed")
+    {
+        TestObject outlived(5);
+        {
+            DenseGridRefManager<TestObject> temporary;
+            outlived.AddToGrid(temporary);
+            REQUIRE(outlived.Reference.isValid());
+        }
+
+        REQUIRE_FALSE(outlived.Reference.isValid());
+    }
+
+    first.RemoveFromGrid();
+    second.RemoveFromGrid();
+    third.RemoveFromGrid();
+}
+
+TEST_CASE("DenseGridRefManager search area", "[Grids]")
+{
+    float const farAway = 20.0f + GridSearchArea::StalePositionMargin;
+
+    DenseGridRefManager<TestObject> container;
+    TestObject near(1, 5.0f, 5.0f), far(2, farAway, farAway), moving(3, farAway, 0.0f);
+
+    near.AddToGrid(container);
+    far.AddToGrid(container);
+    moving.AddToGrid(container);
+
+    GridSearchArea area{ 0.0f, 0.0f, 10.0f };
+
+    SECTION("Objects out of the search area are skipped")
+    {
+        REQUIRE(Collect(container, area) == std::set<uint32>{ 1 });
+        REQUIRE(Collect(container) == std::set<uint32>{ 1, 2, 3 });
+    }
+
+    SECTION("Searches only see moves after the mirrored position is refreshed")
+    {
+        moving.X = 1.0f;
+        REQUIRE(Collect(container, area) == std::set<uint32>{ 1 });
+
+        moving.Reference.updatePosition();
+        REQUIRE(Collect(container, area) == std::set<uint32>{ 1, 3 });
+    }
+
+    SECTION("Mirrored positions follow objects moved into a freed slot")
+    {
+        near.RemoveFromGrid();
+        REQUIRE(Collect(container, area).empty());
+
+        far.RemoveFromGrid();
+        moving.X = 1.0f;
+        moving.Reference.updatePosition();
+        REQUIRE(Collect(container, area) == std::set<uint32>{ 3 });
+    }
+
+    SECTION("The search area is restored when the scope ends")
+    {
+        {
+            GridSearchAreaScope scope(&area);
+            REQUIRE(GridSearchArea::Current() == &area);
+        }
+
+        REQUIRE(GridSearchArea::Current() == nullptr);
+    }
+}
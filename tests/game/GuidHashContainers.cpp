@@ -0,0 +1,162 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GuidHashContainers.h"
+#include <set>
+
+namespace
+{
+    ObjectGuid MakeGuid(uint64 counter, uint64 high = UI64LIT(0x2C00000000000000))
+    {
+        ObjectGuid guid;
+        guid.SetRawValue(high, counter);
+        return guid;
+    }
+
+    std::set<ObjectGuid> Collect(Trinity::GuidHashSet const& set)
+    {
+        return std::set<ObjectGuid>(set.begin(), set.end());
+    }
+}
+
+TEST_CASE("GuidHashSet", "[GuidHashContainers]")
+{
+    Trinity::GuidHashSet set;
+
+    SECTION("Empty set finds nothing")
+    {
+        REQUIRE(set.empty());
+        REQUIRE(set.begin() == set.end());
+        REQUIRE(set.count(MakeGuid(1)) == 0);
+        REQUIRE(set.erase(MakeGuid(1)) == 0);
+    }
+
+    SECTION("Inserted guids are found until erased")
+    {
+        REQUIRE(set.insert(MakeGuid(1)).second);
+        REQUIRE(set.insert(MakeGuid(2)).second);
+        REQUIRE_FALSE(set.insert(MakeGuid(1)).second);
+        REQUIRE(set.size() == 2);
+
+        REQUIRE(set.count(MakeGuid(1)) == 1);
+        REQUIRE(set.find(MakeGuid(2)) != set.end());
+        REQUIRE(set.find(MakeGuid(3)) == set.end());
+
+        REQUIRE(set.erase(MakeGuid(1)) == 1);
+        REQUIRE(set.count(MakeGuid(1)) == 0);
+        REQUIRE(set.count(MakeGuid(2)) == 1);
+        REQUIRE(set.size() == 1);
+    }
+
+    SECTION("Guids differing only in the high part are distinct")
+    {
+        set.insert(MakeGuid(1, 1));
+        set.insert(MakeGuid(1, 2));
+        REQUIRE(set.size() == 2);
+        REQUIRE(Collect(set) == std::set<ObjectGuid>{ MakeGuid(1, 1), MakeGuid(1, 2) });
+    }
+
+    SECTION("Growing and erasing keeps every remaining guid reachable")
+    {
+        for (uint64 i = 0; i < 1000; ++i)
+            set.insert(MakeGuid(i));
+
+        for (uint64 i = 0; i < 1000; i += 2)
+            set.erase(MakeGuid(i));
+
+        // reuses the tombstones left by erase
+        for (uint64 i = 1000; i < 1500; ++i)
+            set.insert(MakeGuid(i));
+
+        REQUIRE(set.size() == 1000);
+        for (uint64 i = 0; i < 1500; ++i)
+            REQUIRE(set.count(MakeGuid(i)) == uint32(i >= 1000 || (i & 1)));
+    }
+
+    SECTION("Erasing through iterators visits every element once")
+    {
+        for (uint64 i = 0; i < 100; ++i)
+            set.insert(MakeGuid(i));
+
+        uint32 visited = 0;
+        for (auto itr = set.begin(); itr != set.end();)
+        {
+            ++visited;
+            if (itr->GetCounter() % 3 == 0)
+                itr = set.erase(itr);
+            else
+                ++itr;
+        }
+
+        REQUIRE(visited == 100);
+        REQUIRE(set.size() == 66);
+    }
+
+    SECTION("Clear removes everything")
+    {
+        for (uint64 i = 0; i < 100; ++i)
+            set.insert(MakeGuid(i));
+
+        set.clear();
+        REQUIRE(set.empty());
+        REQUIRE(set.begin() == set.end());
+        REQUIRE(set.count(MakeGuid(5)) == 0);
+    }
+}
+
+TEST_CASE("GuidHashMap", "[GuidHashContainers]")
+{
+    Trinity::GuidHashMap<uint32*> map;
+    uint32 values[3] = { 10, 20, 30 };
+
+    SECTION("operator[] inserts and updates")
+    {
+        map[MakeGuid(1)] = &values[0];
+        map[MakeGuid(2)] = &values[1];
+        map[MakeGuid(1)] = &values[2];
+
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.find(MakeGuid(1))->second == &values[2]);
+        REQUIRE(map[MakeGuid(3)] == nullptr);
+        REQUIRE(map.size() == 3);
+    }
+
+    SECTION("emplace does not overwrite")
+    {
+        REQUIRE(map.emplace(MakeGuid(1), &values[0]).second);
+        REQUIRE_FALSE(map.emplace(MakeGuid(1), &values[1]).second);
+        REQUIRE(map.find(MakeGuid(1))->second == &values[0]);
+    }
+
+    SECTION("Iteration exposes keys and values")
+    {
+        for (uint32 i = 0; i < 3; ++i)
+            map[MakeGuid(i)] = &values[i];
+
+        Trinity::GuidHashMap<uint32*> const& constMap = map;
+        uint32 sum = 0;
+        for (auto const& [guid, value] : constMap)
+        {
+            REQUIRE(*value == (guid.GetCounter() + 1) * 10);
+            sum += *value;
+        }
+
+        REQUIRE(sum == 60);
+    }
+}
@@ -90,3 +90,31 @@ TEST_CASE("|Hachievement validation", "[Hyperlinks]")
 
     REQUIRE(true  == CheckAllLinks("|cffffff00|Hachievement:4298:Player-0-000000FD:1:12:20:12:0:0:0:0|h[Heroico: Prueba del Campe\xc3\xb3n]|h|r"));
 }
+
+TEST_CASE("Control sequences outside of links", "[Hyperlinks]")
+{
+    sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 1);
+
+    REQUIRE(true  == CheckAllLinks("Plain text without any pipes"));
+    REQUIRE(true  == CheckAllLinks("Escaped || pipes ||||"));
+    REQUIRE(true  == CheckAllLinks("|||cffffffff|Htele:1|h[Stormwind]|h|r||"));
+    REQUIRE(false == CheckAllLinks("Trailing pipe |"));
+    REQUIRE(false == CheckAllLinks("Stray |r reset"));
+    REQUIRE(false == CheckAllLinks("Stray |Htele:1|h[Stormwind]|h link without color"));
+    REQUIRE(false == CheckAllLinks("Texture |TInterface\\Icons\\Temp:0|t"));
+}
+
+TEST_CASE("Repeated link validation", "[Hyperlinks]")
+{
+    UnitTestDataLoader::LoadItemTemplates();
+    sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 1);
+
+    // the second check of the same link is answered from the cache of valid links
+    for (uint32 i = 0; i < 2; ++i)
+        REQUIRE(true == CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r"));
+
+    // links differing from a cached one in any part are still validated
+    REQUIRE(false == CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+    REQUIRE(false == CheckAllLinks("WTS |cffa335ee|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r"));
+    REQUIRE(false == CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r |cffffffff|Hitem:6948:-1:::::::60:::::|h[Hearthstone]|h|r"));
+}
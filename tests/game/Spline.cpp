@@ -0,0 +1,97 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Spline.h"
+
+using Movement::SplineBase;
+
+namespace
+{
+    std::vector<G3D::Vector3> const Path =
+    {
+        { 0.0f, 0.0f, 0.0f },
+        { 10.0f, 5.0f, 1.0f },
+        { 20.0f, -5.0f, 2.0f },
+        { 35.0f, 0.0f, 0.0f },
+        { 40.0f, 10.0f, -3.0f }
+    };
+
+    // reference Catmull-Rom evaluation of segment [p1, p2]
+    G3D::Vector3 CatmullRom(G3D::Vector3 const* p, float t)
+    {
+        float t2 = t * t;
+        float t3 = t2 * t;
+        return ((p[1] * 2.0f) + (p[2] - p[0]) * t + (p[0] * 2.0f - p[1] * 5.0f + p[2] * 4.0f - p[3]) * t2 + (p[1] * 3.0f - p[0] - p[2] * 3.0f + p[3]) * t3) * 0.5f;
+    }
+
+    bool Near(G3D::Vector3 const& left, G3D::Vector3 const& right)
+    {
+        return (left - right).length() < 0.001f;
+    }
+}
+
+TEST_CASE("Catmull-Rom spline evaluation", "[Spline]")
+{
+    Movement::Spline<double> spline;
+    spline.init_spline(Path.data(), int32(Path.size()), SplineBase::ModeCatmullrom);
+    spline.initLengths();
+
+    SECTION("Segments pass through their control points")
+    {
+        for (int32 i = spline.first(); i < spline.last(); ++i)
+        {
+            G3D::Vector3 start, end;
+            spline.evaluate_percent(i, 0.0f, start);
+            spline.evaluate_percent(i, 1.0f, end);
+            REQUIRE(Near(start, spline.getPoint(i)));
+            REQUIRE(Near(end, spline.getPoint(i + 1)));
+        }
+    }
+
+    SECTION("Positions and derivatives match the Catmull-Rom formula")
+    {
+        for (int32 i = spline.first(); i < spline.last(); ++i)
+        {
+            for (float t : { 0.1f, 0.25f, 0.5f, 0.9f })
+            {
+                G3D::Vector3 position;
+                spline.evaluate_percent(i, t, position);
+                REQUIRE(Near(position, CatmullRom(&spline.getPoints()[i - 1], t)));
+
+                float const step = 0.0005f;
+                G3D::Vector3 derivative;
+                spline.evaluate_derivative(i, t, derivative);
+                G3D::Vector3 numeric = (CatmullRom(&spline.getPoints()[i - 1], t + step) - CatmullRom(&spline.getPoints()[i - 1], t - step)) / (2.0f * step);
+                REQUIRE((derivative - numeric).length() < 0.05f);
+            }
+        }
+    }
+
+    SECTION("Length lookup finds the segment containing the distance")
+    {
+        for (int32 i = spline.first(); i < spline.last(); ++i)
+        {
+            double middle = (spline.length(i) + spline.length(i + 1)) / 2.0;
+            REQUIRE(spline.computeIndexInBounds(float(middle / spline.length())) == i);
+        }
+
+        REQUIRE(spline.computeIndexInBounds(0.0f) == spline.first());
+        REQUIRE(spline.computeIndexInBounds(1.0f) == spline.last() - 1);
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "UpdateMask.h"
+#include <vector>
+
+namespace
+{
+    template<uint32 Bits>
+    std::vector<uint32> CollectSetBits(UpdateMask<Bits> const& mask, uint32 first, uint32 count)
+    {
+        std::vector<uint32> bits;
+        mask.ForEachSetBit(first, count, [&](uint32 index) { bits.push_back(index); });
+        return bits;
+    }
+}
+
+TEST_CASE("UpdateMask::ForEachSetBit", "[UpdateMask]")
+{
+    UpdateMask<100> mask;
+
+    SECTION("Empty mask visits nothing")
+    {
+        REQUIRE(CollectSetBits(mask, 0, 100).empty());
+    }
+
+    SECTION("Bits are reported relative to the first bit of the range, lowest first")
+    {
+        mask.Set(3);
+        mask.Set(31);
+        mask.Set(32);
+        mask.Set(70);
+        mask.Set(99);
+
+        REQUIRE(CollectSetBits(mask, 0, 100) == std::vector<uint32>{ 3, 31, 32, 70, 99 });
+        REQUIRE(CollectSetBits(mask, 31, 40) == std::vector<uint32>{ 0, 1, 39 });
+    }
+
+    SECTION("Bits outside of the range are ignored")
+    {
+        mask.SetAll();
+
+        REQUIRE(CollectSetBits(mask, 30, 4) == std::vector<uint32>{ 0, 1, 2, 3 });
+        REQUIRE(CollectSetBits(mask, 96, 4) == std::vector<uint32>{ 0, 1, 2, 3 });
+        REQUIRE(CollectSetBits(mask, 64, 0).empty());
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "BoundingIntervalHierarchyWrapper.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct TestBox
+    {
+        G3D::AABox Bounds;
+
+        bool intersectRay(G3D::Ray const& ray, float& distance, bool /*stopAtFirstHit*/) const
+        {
+            float hit = ray.intersectionTime(Bounds);
+            if (hit >= distance)
+                return false;
+
+            distance = hit;
+            return true;
+        }
+    };
+
+    struct TestBoxBounds
+    {
+        static void getBounds(TestBox const& box, G3D::AABox& out) { out = box.Bounds; }
+        static void getBounds2(TestBox const* box, G3D::AABox& out) { out = box->Bounds; }
+    };
+
+    struct RayHit
+    {
+        bool operator()(G3D::Ray const& ray, TestBox const& box, float& distance)
+        {
+            if (box.intersectRay(ray, distance, true))
+                Hit = true;
+            return Hit;
+        }
+
+        bool Hit = false;
+    };
+}
+
+TEST_CASE("BIH ray intersection", "[BIH]")
+{
+    // 4096 one yard boxes scattered over a 500 yard square, roughly the density of a busy map tile
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(0.0f, 500.0f);
+    std::vector<TestBox> boxes(4096);
+    for (TestBox& box : boxes)
+    {
+        G3D::Vector3 low(position(rng), position(rng), position(rng) / 10.0f);
+        box.Bounds = G3D::AABox(low, low + G3D::Vector3(1.0f, 1.0f, 1.0f));
+    }
+
+    BIHWrap<TestBox, TestBoxBounds> tree;
+    for (TestBox const& box : boxes)
+        tree.insert(box);
+    tree.balance();
+
+    std::vector<G3D::Ray> rays;
+    for (uint32 i = 0; i < 256; ++i)
+    {
+        G3D::Vector3 start(position(rng), position(rng), 2.0f);
+        G3D::Vector3 end(position(rng), position(rng), 2.0f);
+        rays.push_back(G3D::Ray::fromOriginAndDirection(start, (end - start).direction()));
+    }
+
+    BENCHMARK("256 rays, 100 yards")
+    {
+        uint32 hits = 0;
+        for (G3D::Ray const& ray : rays)
+        {
+            RayHit callback;
+            float distance = 100.0f;
+            tree.intersectRay(ray, callback, distance);
+            hits += callback.Hit;
+        }
+        return hits;
+    };
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include <vector>
+
+TEST_CASE("ByteBuffer append and read", "[ByteBuffer]")
+{
+    BENCHMARK("append 1000 uint32")
+    {
+        ByteBuffer buffer;
+        for (uint32 i = 0; i < 1000; ++i)
+            buffer << i;
+        return buffer.size();
+    };
+
+    BENCHMARK("append 1000 packed bits")
+    {
+        ByteBuffer buffer;
+        for (uint32 i = 0; i < 1000; ++i)
+            buffer.WriteBits(i, 7);
+        buffer.FlushBits();
+        return buffer.size();
+    };
+
+    BENCHMARK("append 1000 32 bit blocks unaligned")
+    {
+        ByteBuffer buffer;
+        buffer.WriteBit(true);
+        for (uint32 i = 0; i < 1000; ++i)
+            buffer.WriteBits(i, 32);
+        buffer.FlushBits();
+        return buffer.size();
+    };
+
+    std::vector<uint32> blocks(1000);
+    for (uint32 i = 0; i < 1000; ++i)
+        blocks[i] = i * 2654435761u;
+
+    BENCHMARK("append 1000 32 bit blocks unaligned, bulk")
+    {
+        ByteBuffer buffer;
+        buffer.WriteBit(true);
+        buffer.WriteBits(blocks.data(), blocks.size(), 32);
+        buffer.FlushBits();
+        return buffer.size();
+    };
+
+    BENCHMARK("append 100 strings")
+    {
+        ByteBuffer buffer;
+        for (uint32 i = 0; i < 100; ++i)
+            buffer << "Lorem ipsum dolor sit amet";
+        return buffer.size();
+    };
+
+    ByteBuffer filled;
+    for (uint32 i = 0; i < 1000; ++i)
+        filled << i;
+
+    BENCHMARK("read 1000 uint32")
+    {
+        filled.rpos(0);
+        uint32 sum = 0;
+        for (uint32 i = 0; i < 1000; ++i)
+            sum += filled.read<uint32>();
+        return sum;
+    };
+
+    BENCHMARK("read 1000 packed bits")
+    {
+        filled.rpos(0);
+        filled.ResetBitPos();
+        uint32 sum = 0;
+        for (uint32 i = 0; i < 1000; ++i)
+            sum += filled.ReadBits(7);
+        return sum;
+    };
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "EventProcessor.h"
+
+namespace
+{
+    class NoopEvent : public BasicEvent
+    {
+    public:
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override { return true; }
+    };
+}
+
+TEST_CASE("EventProcessor scheduling", "[EventProcessor]")
+{
+    BENCHMARK("add and execute 1000 events")
+    {
+        EventProcessor events;
+        for (uint32 i = 0; i < 1000; ++i)
+            events.AddEventAtOffset(new NoopEvent(), Milliseconds(i % 100));
+        events.Update(100);
+        return events.GetEvents().size();
+    };
+
+    BENCHMARK_ADVANCED("update with 1000 pending events")(Catch::Benchmark::Chronometer meter)
+    {
+        EventProcessor events;
+        for (uint32 i = 0; i < 1000; ++i)
+            events.AddEventAtOffset(new NoopEvent(), 1h);
+
+        meter.measure([&events] { events.Update(1); });
+    };
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Define.h"
+#include "MPSCQueue.h"
+#include "ProducerConsumerQueue.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 ItemsPerProducer = 10000;
+    constexpr uint32 ProducerCount = 4;
+
+    struct QueueItem
+    {
+        uint32 Value;
+    };
+
+    template <typename Push, typename Pop>
+    uint64 RunProducers(Push push, Pop pop)
+    {
+        std::vector<std::thread> producers;
+        for (uint32 p = 0; p < ProducerCount; ++p)
+            producers.emplace_back([&push]
+            {
+                for (uint32 i = 0; i < ItemsPerProducer; ++i)
+                    push(i);
+            });
+
+        uint64 sum = 0;
+        uint32 received = 0;
+        while (received < ItemsPerProducer * ProducerCount)
+        {
+            uint32 value;
+            if (pop(value))
+            {
+                sum += value;
+                ++received;
+            }
+        }
+
+        for (std::thread& producer : producers)
+            producer.join();
+
+        return sum;
+    }
+}
+
+TEST_CASE("MPSCQueue throughput", "[MPSCQueue]")
+{
+    BENCHMARK("single thread enqueue and dequeue 10000")
+    {
+        MPSCQueue<QueueItem> queue;
+        std::vector<QueueItem> items(ItemsPerProducer);
+        for (QueueItem& item : items)
+            queue.Enqueue(&item);
+
+        QueueItem* result;
+        uint32 count = 0;
+        while (queue.Dequeue(result))
+            ++count;
+        return count;
+    };
+
+    BENCHMARK("4 producers, 1 consumer")
+    {
+        MPSCQueue<QueueItem> queue;
+        std::vector<QueueItem> items(ItemsPerProducer, { 1 });
+        return RunProducers([&](uint32 i) { queue.Enqueue(&items[i]); }, [&](uint32& value)
+        {
+            QueueItem* result;
+            if (!queue.Dequeue(result))
+                return false;
+            value = result->Value;
+            return true;
+        });
+    };
+}
+
+TEST_CASE("ProducerConsumerQueue throughput", "[ProducerConsumerQueue]")
+{
+    BENCHMARK("4 producers, 1 consumer")
+    {
+        ProducerConsumerQueue<uint32> queue;
+        return RunProducers([&](uint32 i) { queue.Push(i); }, [&](uint32& value) { return queue.Pop(value); });
+    };
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "WorldPacketCrypt.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    // a send buffer full of small movement sized packets, laid out like WorldSocket::Update writes them
+    struct SendBuffer
+    {
+        SendBuffer(uint32 packetCount, uint32 packetSize) : Data(packetCount * (packetSize + sizeof(Trinity::Crypto::AES::Tag)))
+        {
+            uint8* pos = Data.data();
+            for (uint32 i = 0; i < packetCount; ++i)
+            {
+                Requests.push_back({ pos + sizeof(Trinity::Crypto::AES::Tag), packetSize, pos });
+                pos += packetSize + sizeof(Trinity::Crypto::AES::Tag);
+            }
+        }
+
+        std::vector<uint8> Data;
+        std::vector<WorldPacketCrypt::SendRequest> Requests;
+    };
+
+    Trinity::Crypto::AES::Key const Key = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF };
+}
+
+TEST_CASE("WorldPacketCrypt encryption", "[WorldPacketCrypt]")
+{
+    for (uint32 packetSize : { 32u, 256u, 4096u })
+    {
+        WorldPacketCrypt crypt;
+        crypt.Init(Key);
+        SendBuffer buffer(64, packetSize);
+
+        BENCHMARK("64 packets of " + std::to_string(packetSize) + " bytes, one call per packet")
+        {
+            bool ok = true;
+            for (WorldPacketCrypt::SendRequest const& request : buffer.Requests)
+                ok &= crypt.EncryptSend(request.Data, request.Length, *reinterpret_cast<Trinity::Crypto::AES::Tag*>(request.Tag));
+            return ok;
+        };
+
+        BENCHMARK("64 packets of " + std::to_string(packetSize) + " bytes, batched")
+        {
+            return crypt.EncryptSend(buffer.Requests.data(), buffer.Requests.size());
+        };
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Chat.h"
+#include "ChatCommand.h"
+
+using namespace Trinity::ChatCommands;
+
+namespace
+{
+    struct DummyChatHandler : ChatHandler
+    {
+        DummyChatHandler() : ChatHandler(nullptr) {}
+        void SendSysMessage(std::string_view, bool) override {}
+        char const* GetTrinityString(uint32) const override { return ""; }
+        bool isAvailable(ChatCommand const&) const override { return true; }
+
+        using ChatHandler::ExecuteCommandInTable;
+    };
+
+    bool HandleNoArgs(ChatHandler*) { return true; }
+    bool HandleNumbers(ChatHandler*, uint32, float, Optional<uint32>) { return true; }
+    bool HandleStrings(ChatHandler*, std::string_view, Tail) { return true; }
+}
+
+TEST_CASE("Chat command lookup", "[ChatCommand]")
+{
+    std::vector<ChatCommand> childCommands;
+    for (char const* name : { "add", "additem", "addset", "delete", "list", "info", "modify", "reload", "set", "setskill" })
+        childCommands.emplace_back(name, 0, true, &HandleNoArgs, "");
+
+    std::vector<ChatCommand> commandTable;
+    for (char const* name : { "account", "ahbot", "character", "cheat", "debug", "gobject", "guild", "instance", "learn", "lookup", "modify", "npc", "reload", "server", "tele" })
+        commandTable.emplace_back(name, 0, true, nullptr, "", childCommands);
+
+    DummyChatHandler handler;
+
+    BENCHMARK("exact command")
+    {
+        return handler.ExecuteCommandInTable(commandTable, "reload set", "");
+    };
+
+    BENCHMARK("abbreviated command")
+    {
+        return handler.ExecuteCommandInTable(commandTable, "rel sets", "");
+    };
+}
+
+TEST_CASE("Chat command argument parsing", "[ChatCommand]")
+{
+    DummyChatHandler handler;
+    ChatCommand numbers("", 0, true, &HandleNumbers, "");
+    ChatCommand strings("", 0, true, &HandleStrings, "");
+
+    BENCHMARK("numeric arguments")
+    {
+        return numbers(&handler, "123456 0.5 42");
+    };
+
+    BENCHMARK("string arguments")
+    {
+        return strings(&handler, "Playername some trailing text for the tail argument");
+    };
+}
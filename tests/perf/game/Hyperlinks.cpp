@@ -0,0 +1,50 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Hyperlinks.h"
+#include "World.h"
+
+using namespace Trinity::Hyperlinks;
+
+TEST_CASE("Chat hyperlink validation", "[Hyperlinks]")
+{
+    sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 1);
+
+    // tele links need no data stores to validate
+    std::string const link = "|cffffffff|Htele:1|h[Stormwind]|h|r";
+    std::string const plain = "LFM heroic dungeon, need tank and healer, whisper me || no pugs please";
+    std::string tradeSpam = "WTS";
+    for (uint32 i = 0; i < 8; ++i)
+        tradeSpam += ' ' + link;
+
+    BENCHMARK("plain message")
+    {
+        return CheckAllLinks(plain);
+    };
+
+    BENCHMARK("message with 8 links")
+    {
+        return CheckAllLinks(tradeSpam);
+    };
+
+    BENCHMARK("parse single link")
+    {
+        return bool(ParseSingleHyperlink(link));
+    };
+}
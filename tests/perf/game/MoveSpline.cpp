@@ -0,0 +1,60 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MoveSpline.h"
+#include "MoveSplineInitArgs.h"
+
+namespace
+{
+    Movement::MoveSplineInitArgs MakePath(uint32 points)
+    {
+        Movement::MoveSplineInitArgs args(points);
+        for (uint32 i = 0; i < points; ++i)
+            args.path.emplace_back(float(i) * 5.0f, float(i % 2) * 3.0f, 0.0f);
+        args.velocity = 7.0f;
+        args.HasVelocity = true;
+        return args;
+    }
+}
+
+TEST_CASE("MoveSpline evaluation", "[MoveSpline]")
+{
+    Movement::MoveSplineInitArgs args = MakePath(32);
+
+    BENCHMARK("initialize 32 point path")
+    {
+        Movement::MoveSpline spline;
+        spline.Initialize(args);
+        return spline.Duration();
+    };
+
+    BENCHMARK_ADVANCED("update and compute position")(Catch::Benchmark::Chronometer meter)
+    {
+        Movement::MoveSpline spline;
+        spline.Initialize(args);
+
+        meter.measure([&spline, &args]
+        {
+            if (spline.Finalized())
+                spline.Initialize(args);
+            spline.updateState(50);
+            return spline.ComputePosition().x;
+        });
+    };
+}
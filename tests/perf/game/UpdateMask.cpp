@@ -0,0 +1,91 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include "UpdateMask.h"
+
+namespace
+{
+    // same layout as the generated UpdateFields code: the mask of used blocks followed by every used block
+    template <uint32 Bits>
+    void WriteMask(UpdateMask<Bits> const& mask, ByteBuffer& data)
+    {
+        for (uint32 i = 0; i < UpdateMask<Bits>::BlocksMaskCount; ++i)
+            data << uint32(mask.GetBlocksMask(i));
+
+        for (uint32 i = 0; i < UpdateMask<Bits>::BlockCount; ++i)
+            if (mask.GetBlocksMask(i / 32) & (1u << (i % 32)))
+                data << uint32(mask.GetBlock(i));
+    }
+}
+
+TEST_CASE("UpdateMask serialization", "[UpdateMask]")
+{
+    BENCHMARK("set 16 bits of 1024")
+    {
+        UpdateMask<1024> mask;
+        for (uint32 i = 0; i < 1024; i += 64)
+            mask.Set(i);
+        return mask.IsAnySet();
+    };
+
+    UpdateMask<1024> sparse;
+    for (uint32 i = 0; i < 1024; i += 64)
+        sparse.Set(i);
+
+    UpdateMask<1024> full;
+    full.SetAll();
+
+    BENCHMARK("write sparse mask")
+    {
+        ByteBuffer data;
+        WriteMask(sparse, data);
+        return data.size();
+    };
+
+    BENCHMARK("write full mask")
+    {
+        ByteBuffer data;
+        WriteMask(full, data);
+        return data.size();
+    };
+
+    BENCHMARK("visit set bits of sparse mask")
+    {
+        uint32 sum = 0;
+        sparse.ForEachSetBit(0, 1024, [&](uint32 index) { sum += index; });
+        return sum;
+    };
+
+    BENCHMARK("test every bit of sparse mask")
+    {
+        uint32 sum = 0;
+        for (uint32 i = 0; i < 1024; ++i)
+            if (sparse[i])
+                sum += i;
+        return sum;
+    };
+
+    BENCHMARK("merge and test masks")
+    {
+        UpdateMask<1024> merged = sparse;
+        merged &= full;
+        return merged.IsAnySet();
+    };
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include <iomanip>
+
+namespace
+{
+    // Writes one object per benchmark so runs can be diffed between builds, use with --reporter json
+    class JsonBenchmarkReporter : public Catch::StreamingReporterBase<JsonBenchmarkReporter>
+    {
+    public:
+        explicit JsonBenchmarkReporter(Catch::ReporterConfig const& config) : StreamingReporterBase(config), _first(true) { }
+
+        static std::string getDescription() { return "Reports benchmark results as JSON"; }
+
+        void testRunStarting(Catch::TestRunInfo const& testRunInfo) override
+        {
+            StreamingReporterBase::testRunStarting(testRunInfo);
+            stream << "{\"benchmarks\":[";
+        }
+
+        void assertionStarting(Catch::AssertionInfo const& /*assertionInfo*/) override { }
+        bool assertionEnded(Catch::AssertionStats const& /*assertionStats*/) override { return true; }
+
+        void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override
+        {
+            if (!_first)
+                stream << ',';
+            _first = false;
+
+            stream << "\n{\"test_case\":";
+            WriteString(currentTestCaseInfo->name);
+            stream << ",\"name\":";
+            WriteString(stats.info.name);
+            stream << std::setprecision(10)
+                << ",\"samples\":" << stats.info.samples
+                << ",\"iterations\":" << stats.info.iterations
+                << ",\"mean_ns\":" << stats.mean.point.count()
+                << ",\"mean_lower_ns\":" << stats.mean.lower_bound.count()
+                << ",\"mean_upper_ns\":" << stats.mean.upper_bound.count()
+                << ",\"std_dev_ns\":" << stats.standardDeviation.point.count()
+                << ",\"outlier_variance\":" << stats.outlierVariance
+                << '}';
+        }
+
+        void testRunEnded(Catch::TestRunStats const& testRunStats) override
+        {
+            stream << "\n]}" << std::endl;
+            StreamingReporterBase::testRunEnded(testRunStats);
+        }
+
+    private:
+        void WriteString(std::string const& value)
+        {
+            stream << '"';
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\';
+                stream << c;
+            }
+            stream << '"';
+        }
+
+        bool _first;
+    };
+}
+
+CATCH_REGISTER_REPORTER("json", JsonBenchmarkReporter)